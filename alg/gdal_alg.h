@@ -218,6 +218,8 @@ GDALCreateApproxTransformer( GDALTransformerFunc pfnRawTransformer,
                              void *pRawTransformerArg, double dfMaxError );
 void CPL_DLL GDALApproxTransformerOwnsSubtransformer( void *pCBData, 
                                                       int bOwnFlag );
+void CPL_DLL GDALApproxTransformerSetGridCache( void *pCBData,
+                                                int nCellSize );
 void CPL_DLL GDALDestroyApproxTransformer( void *pApproxArg );
 int  CPL_DLL GDALApproxTransform(
     void *pTransformArg, int bDstToSrc, int nPointCount,
@@ -36,6 +36,7 @@
 #include "cpl_string.h"
 #include "cpl_atomic_ops.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 
 CPL_CVSID("$Id$");
 
@@ -191,12 +192,10 @@ void *GDALCreateTPSTransformerInt( int nGCPCount, const GDAL_GCP *pasGCPList,
     if( nThreads > 1 )
     {
         /* Compute direct and reverse transforms in parallel */
-        void* hThread = CPLCreateJoinableThread(GDALTPSComputeForwardInThread, psInfo);
+        CPLJobGroup* psJobGroup = CPLCreateJobGroup();
+        CPLSubmitJob(psJobGroup, GDALTPSComputeForwardInThread, psInfo);
         psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
-        if( hThread != NULL )
-            CPLJoinThread(hThread);
-        else
-            psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
+        CPLDestroyJobGroup(psJobGroup);
     }
     else
     {
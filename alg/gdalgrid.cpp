@@ -34,6 +34,7 @@
 #include <float.h>
 #include <limits.h>
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdalgrid_priv.h"
 
 #ifdef HAVE_SSE_AT_COMPILE_TIME
@@ -1507,7 +1508,6 @@ struct _GDALGridJob
     int               (*pfnProgress)(GDALGridJob* psJob);
     GDALDataType        eType;
 
-    void           *hThread;
     volatile int   *pnCounter;
     volatile int   *pbStop;
     void           *hCond;
@@ -1919,6 +1919,9 @@ GDALGridCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
         nThreads = 128;
     if (nThreads >= (int)nYSize / 2)
         nThreads = (int)nYSize / 2;
+    /* Do not wait for nested jobs from a job of the worker thread pool */
+    if (CPLIsWorkerThread())
+        nThreads = 1;
 
     volatile int nCounter = 0;
     volatile int bStop = FALSE;
@@ -1948,7 +1951,6 @@ GDALGridCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
     sJob.pbStop = &bStop;
     sJob.hCond = NULL;
     sJob.hCondMutex = NULL;
-    sJob.hThread = NULL;
 
     if( nThreads > 1 )
     {
@@ -1979,14 +1981,16 @@ GDALGridCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
         sJob.pfnProgress = GDALGridProgressMultiThread;
 
 /* -------------------------------------------------------------------- */
-/*      Start threads.                                                  */
+/*      Submit jobs to the worker thread pool.                          */
 /* -------------------------------------------------------------------- */
+        CPLJobGroup *psJobGroup = CPLCreateJobGroup();
+
         for(i = 0; i < nThreads && !bStop; i++)
         {
             memcpy(&pasJobs[i], &sJob, sizeof(GDALGridJob));
             pasJobs[i].nYStart = i;
-            pasJobs[i].hThread = CPLCreateJoinableThread( GDALGridJobProcess,
-                                                          (void*) &pasJobs[i] );
+            CPLSubmitJob( psJobGroup, GDALGridJobProcess,
+                          (void*) &pasJobs[i] );
         }
 
 /* -------------------------------------------------------------------- */
@@ -2008,18 +2012,14 @@ GDALGridCreate( GDALGridAlgorithm eAlgorithm, const void *poOptions,
             CPLAcquireMutex(sJob.hCondMutex, 1.0);
         }
 
-        /* Release mutex before joining threads, otherwise they will dead-lock */
-        /* forever in GDALGridProgressMultiThread() */
+        /* Release mutex before waiting for the jobs, otherwise they will */
+        /* dead-lock forever in GDALGridProgressMultiThread() */
         CPLReleaseMutex(sJob.hCondMutex);
 
 /* -------------------------------------------------------------------- */
-/*      Wait for all threads to complete and finish.                    */
+/*      Wait for all jobs to complete and finish.                       */
 /* -------------------------------------------------------------------- */
-        for(i=0;i<nThreads;i++)
-        {
-            if( pasJobs[i].hThread )
-                CPLJoinThread(pasJobs[i].hThread);
-        }
+        CPLDestroyJobGroup(psJobGroup);
 
         CPLFree(pasJobs);
         CPLDestroyCond(sJob.hCond);
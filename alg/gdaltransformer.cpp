@@ -37,6 +37,7 @@
 #include "gdal_alg_priv.h"
 #include "cpl_list.h"
 #include "cpl_multiproc.h"
+#include <map>
 
 CPL_CVSID("$Id$");
 CPL_C_START
@@ -2447,6 +2448,89 @@ GDALDeserializeReprojectionTransformer( CPLXMLNode *psTree )
 /* ==================================================================== */
 /************************************************************************/
 
+/************************************************************************/
+/*                            GDALApproxGrid                            */
+/*                                                                      */
+/*      Hierarchical grid of exactly transformed points of the          */
+/*      destination pixel/line space.  Each cell is bilinearly          */
+/*      interpolated from its corners if the error at the middle of     */
+/*      its edges and at its center is within the maximum error,        */
+/*      otherwise it is split into four cells, down to cells of         */
+/*      APPROX_GRID_MIN_CELL_SIZE pixels whose points are transformed   */
+/*      exactly.  The grid is shared by all the clones of an            */
+/*      approximate transformer, so the per thread clones of the warp   */
+/*      kernel and the successive chunks of a warp operation reuse the  */
+/*      points already computed.  The memory used by the grid is       */
+/*      limited by the GDAL_APPROX_GRID_CACHE_MAX configuration option. */
+/************************************************************************/
+
+#define APPROX_GRID_MIN_CELL_SIZE  2
+#define APPROX_GRID_MAX_CELL_SIZE  65536
+#define APPROX_GRID_DEFAULT_MAX_MEMORY  "4194304"
+
+#define AGC_INTERPOLATE            0
+#define AGC_SPLIT                  1
+#define AGC_EXACT                  2
+
+class GDALApproxGridKey
+{
+  public:
+    int nLevel;
+    int nX;
+    int nY;
+
+    GDALApproxGridKey( int nLevelIn, int nXIn, int nYIn ) :
+        nLevel(nLevelIn), nX(nXIn), nY(nYIn) {}
+
+    bool operator< ( const GDALApproxGridKey& oOther ) const
+    {
+        if( nY != oOther.nY )
+            return nY < oOther.nY;
+        if( nX != oOther.nX )
+            return nX < oOther.nX;
+        return nLevel < oOther.nLevel;
+    }
+};
+
+typedef struct
+{
+    double dfX;
+    double dfY;
+    double dfZ;
+    int    bSuccess;
+} GDALApproxGridNode;
+
+typedef struct
+{
+    int    nStatus;
+    /* Corners in top-left, top-right, bottom-left, bottom-right order */
+    double adfX[4];
+    double adfY[4];
+    double adfZ[4];
+} GDALApproxGridCell;
+
+typedef struct
+{
+    void   *hMutex;
+    int     nRefCount;
+
+    int     nCellSize;      /* size of the cells of level 0, in pixels */
+    int     nMaxLevel;
+
+    /* Nodes are keyed by their pixel/line position (nLevel is 0) */
+    std::map<GDALApproxGridKey, GDALApproxGridNode> oMapNodes;
+    std::map<GDALApproxGridKey, GDALApproxGridCell> oMapCells;
+
+    GIntBig nMaxMemory;     /* in bytes */
+} GDALApproxGrid;
+
+/* Approximate memory used by an entry of the maps, including the */
+/* red-black tree node (color and three pointers) */
+#define APPROX_GRID_NODE_ENTRY_SIZE \
+    (sizeof(GDALApproxGridKey) + sizeof(GDALApproxGridNode) + 4 * sizeof(void*))
+#define APPROX_GRID_CELL_ENTRY_SIZE \
+    (sizeof(GDALApproxGridKey) + sizeof(GDALApproxGridCell) + 4 * sizeof(void*))
+
 typedef struct 
 {
     GDALTransformerInfo sTI;
@@ -2456,8 +2540,341 @@ typedef struct
     double	      dfMaxError;
 
     int               bOwnSubtransformer;
+
+    GDALApproxGrid   *psGrid;
 } ApproxTransformInfo;
 
+/************************************************************************/
+/*                       GDALApproxGridReference()                      */
+/************************************************************************/
+
+static void GDALApproxGridReference( GDALApproxGrid *psGrid )
+
+{
+    CPLAcquireMutex( psGrid->hMutex, 1000.0 );
+    psGrid->nRefCount ++;
+    CPLReleaseMutex( psGrid->hMutex );
+}
+
+/************************************************************************/
+/*                      GDALApproxGridDereference()                     */
+/************************************************************************/
+
+static void GDALApproxGridDereference( GDALApproxGrid *psGrid )
+
+{
+    CPLAcquireMutex( psGrid->hMutex, 1000.0 );
+    int nRefCount = --psGrid->nRefCount;
+    CPLReleaseMutex( psGrid->hMutex );
+
+    if( nRefCount == 0 )
+    {
+        CPLDestroyMutex( psGrid->hMutex );
+        delete psGrid;
+    }
+}
+
+/************************************************************************/
+/*                     GDALApproxGridEvaluateCell()                     */
+/*                                                                      */
+/*      Compute the status of a cell that is not in the grid yet, and   */
+/*      add it to the grid.                                             */
+/************************************************************************/
+
+static int GDALApproxGridEvaluateCell( ApproxTransformInfo *psATInfo,
+                                       int nLevel, int nCellX, int nCellY,
+                                       GDALApproxGridCell *psCell )
+
+{
+    GDALApproxGrid *psGrid = psATInfo->psGrid;
+    const int nSize = psGrid->nCellSize >> nLevel;
+    const int nHalf = nSize / 2;
+    const int nX0 = nCellX * nSize;
+    const int nY0 = nCellY * nSize;
+
+/* -------------------------------------------------------------------- */
+/*      The four corners, then the middle of the top, left, right and   */
+/*      bottom edges, then the center.  The check points are the        */
+/*      corners of the cells of the next level.                         */
+/* -------------------------------------------------------------------- */
+    const int anNodeX[9] = { nX0, nX0 + nSize, nX0, nX0 + nSize,
+                             nX0 + nHalf, nX0, nX0 + nSize, nX0 + nHalf,
+                             nX0 + nHalf };
+    const int anNodeY[9] = { nY0, nY0, nY0 + nSize, nY0 + nSize,
+                             nY0, nY0 + nHalf, nY0 + nHalf, nY0 + nSize,
+                             nY0 + nHalf };
+    GDALApproxGridNode asNodes[9];
+    double adfX[9], adfY[9], adfZ[9];
+    int    anSuccess[9], anMissing[9];
+    int    nMissing = 0, i;
+
+    CPLAcquireMutex( psGrid->hMutex, 1000.0 );
+    for( i = 0; i < 9; i++ )
+    {
+        std::map<GDALApproxGridKey, GDALApproxGridNode>::iterator oIter =
+            psGrid->oMapNodes.find( GDALApproxGridKey(0, anNodeX[i],
+                                                      anNodeY[i]) );
+        if( oIter != psGrid->oMapNodes.end() )
+            asNodes[i] = oIter->second;
+        else
+        {
+            adfX[nMissing] = anNodeX[i];
+            adfY[nMissing] = anNodeY[i];
+            adfZ[nMissing] = 0.0;
+            anMissing[nMissing++] = i;
+        }
+    }
+    CPLReleaseMutex( psGrid->hMutex );
+
+/* -------------------------------------------------------------------- */
+/*      Transform the missing nodes outside of the lock, so that the    */
+/*      other threads can go on interpolating.                          */
+/* -------------------------------------------------------------------- */
+    if( nMissing > 0 )
+    {
+        if( !psATInfo->pfnBaseTransformer( psATInfo->pBaseCBData, TRUE,
+                                           nMissing, adfX, adfY, adfZ,
+                                           anSuccess ) )
+        {
+            for( i = 0; i < nMissing; i++ )
+                anSuccess[i] = FALSE;
+        }
+
+        for( i = 0; i < nMissing; i++ )
+        {
+            GDALApproxGridNode *psNode = asNodes + anMissing[i];
+            psNode->dfX = adfX[i];
+            psNode->dfY = adfY[i];
+            psNode->dfZ = adfZ[i];
+            psNode->bSuccess = anSuccess[i];
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Is the error at the check points acceptable relative to an      */
+/*      interpolation from the corners?                                 */
+/* -------------------------------------------------------------------- */
+    int bInterpolate = TRUE;
+    for( i = 0; i < 9 && bInterpolate; i++ )
+        bInterpolate = asNodes[i].bSuccess;
+
+    if( bInterpolate )
+    {
+        static const int anFirst[5] = { 0, 0, 1, 2, 0 };
+        static const int anSecond[5] = { 1, 2, 3, 3, 3 };
+
+        for( i = 0; i < 5 && bInterpolate; i++ )
+        {
+            const GDALApproxGridNode &sA = asNodes[anFirst[i]];
+            const GDALApproxGridNode &sB = asNodes[anSecond[i]];
+            double dfX, dfY;
+
+            if( i < 4 )
+            {
+                dfX = (sA.dfX + sB.dfX) * 0.5;
+                dfY = (sA.dfY + sB.dfY) * 0.5;
+            }
+            else
+            {
+                dfX = (asNodes[0].dfX + asNodes[1].dfX
+                       + asNodes[2].dfX + asNodes[3].dfX) * 0.25;
+                dfY = (asNodes[0].dfY + asNodes[1].dfY
+                       + asNodes[2].dfY + asNodes[3].dfY) * 0.25;
+            }
+
+            double dfError = fabs(dfX - asNodes[4 + i].dfX)
+                + fabs(dfY - asNodes[4 + i].dfY);
+            if( !(dfError <= psATInfo->dfMaxError) )
+                bInterpolate = FALSE;
+        }
+    }
+
+    if( bInterpolate )
+        psCell->nStatus = AGC_INTERPOLATE;
+    else if( nLevel < psGrid->nMaxLevel )
+        psCell->nStatus = AGC_SPLIT;
+    else
+        psCell->nStatus = AGC_EXACT;
+
+    for( i = 0; i < 4; i++ )
+    {
+        psCell->adfX[i] = asNodes[i].dfX;
+        psCell->adfY[i] = asNodes[i].dfY;
+        psCell->adfZ[i] = asNodes[i].dfZ;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Record the new nodes and the cell.  If the grid grew too        */
+/*      large, just restart from an empty one.                          */
+/* -------------------------------------------------------------------- */
+    CPLAcquireMutex( psGrid->hMutex, 1000.0 );
+    if( (GIntBig) (psGrid->oMapNodes.size() + nMissing)
+            * APPROX_GRID_NODE_ENTRY_SIZE
+        + (GIntBig) (psGrid->oMapCells.size() + 1)
+            * APPROX_GRID_CELL_ENTRY_SIZE > psGrid->nMaxMemory )
+    {
+        psGrid->oMapNodes.clear();
+        psGrid->oMapCells.clear();
+    }
+    for( i = 0; i < nMissing; i++ )
+    {
+        psGrid->oMapNodes[GDALApproxGridKey(0, anNodeX[anMissing[i]],
+                                            anNodeY[anMissing[i]])] =
+            asNodes[anMissing[i]];
+    }
+    psGrid->oMapCells[GDALApproxGridKey(nLevel, nCellX, nCellY)] = *psCell;
+    CPLReleaseMutex( psGrid->hMutex );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                       GDALApproxGridFindCell()                       */
+/*                                                                      */
+/*      Find the cell, not split, that contains a point, computing it   */
+/*      if needed.                                                      */
+/************************************************************************/
+
+static void GDALApproxGridFindCell( ApproxTransformInfo *psATInfo,
+                                    double dfX, double dfY,
+                                    GDALApproxGridCell *psCell,
+                                    double *pdfCellX0, double *pdfCellY0,
+                                    double *pdfCellSize )
+
+{
+    GDALApproxGrid *psGrid = psATInfo->psGrid;
+
+    for( int nLevel = 0; TRUE; nLevel++ )
+    {
+        const int nSize = psGrid->nCellSize >> nLevel;
+        const int nCellX = (int) floor( dfX / nSize );
+        const int nCellY = (int) floor( dfY / nSize );
+
+        CPLAcquireMutex( psGrid->hMutex, 1000.0 );
+        std::map<GDALApproxGridKey, GDALApproxGridCell>::iterator oIter =
+            psGrid->oMapCells.find( GDALApproxGridKey(nLevel, nCellX,
+                                                      nCellY) );
+        int bFound = ( oIter != psGrid->oMapCells.end() );
+        if( bFound )
+            *psCell = oIter->second;
+        CPLReleaseMutex( psGrid->hMutex );
+
+        if( !bFound )
+            GDALApproxGridEvaluateCell( psATInfo, nLevel, nCellX, nCellY,
+                                        psCell );
+
+        if( psCell->nStatus != AGC_SPLIT )
+        {
+            *pdfCellX0 = (double) nCellX * nSize;
+            *pdfCellY0 = (double) nCellY * nSize;
+            *pdfCellSize = nSize;
+            return;
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALApproxTransformWithGrid()                    */
+/************************************************************************/
+
+static int GDALApproxTransformWithGrid( ApproxTransformInfo *psATInfo,
+                                        int nPoints, double *x, double *y,
+                                        double *z, int *panSuccess )
+
+{
+    GDALApproxGridCell sCell;
+    double dfCellX0 = 0.0, dfCellY0 = 0.0, dfCellSize = 0.0;
+    int    bHaveCell = FALSE;
+    int   *panExact = NULL;
+    int    nExact = 0, i;
+
+    for( i = 0; i < nPoints; i++ )
+    {
+        const double dfX = x[i], dfY = y[i];
+
+/* -------------------------------------------------------------------- */
+/*      Consecutive points generally fall in the same cell, so only     */
+/*      look for a new one when leaving the current cell.               */
+/* -------------------------------------------------------------------- */
+        if( !bHaveCell
+            || !(dfX >= dfCellX0 && dfX < dfCellX0 + dfCellSize
+                 && dfY >= dfCellY0 && dfY < dfCellY0 + dfCellSize) )
+        {
+            /* Also catches NaN, and positions whose cells would not be */
+            /* indexable. */
+            if( !(fabs(dfX) < 1e9 && fabs(dfY) < 1e9) )
+                bHaveCell = FALSE;
+            else
+            {
+                GDALApproxGridFindCell( psATInfo, dfX, dfY, &sCell,
+                                        &dfCellX0, &dfCellY0, &dfCellSize );
+                bHaveCell = TRUE;
+            }
+        }
+
+        if( !bHaveCell || sCell.nStatus != AGC_INTERPOLATE )
+        {
+            if( panExact == NULL )
+                panExact = (int *) CPLMalloc( sizeof(int) * nPoints );
+            panExact[nExact++] = i;
+            continue;
+        }
+
+        const double dfU = (dfX - dfCellX0) / dfCellSize;
+        const double dfV = (dfY - dfCellY0) / dfCellSize;
+        const double dfW0 = (1.0 - dfU) * (1.0 - dfV);
+        const double dfW1 = dfU * (1.0 - dfV);
+        const double dfW2 = (1.0 - dfU) * dfV;
+        const double dfW3 = dfU * dfV;
+
+        x[i] = dfW0 * sCell.adfX[0] + dfW1 * sCell.adfX[1]
+            + dfW2 * sCell.adfX[2] + dfW3 * sCell.adfX[3];
+        y[i] = dfW0 * sCell.adfY[0] + dfW1 * sCell.adfY[1]
+            + dfW2 * sCell.adfY[2] + dfW3 * sCell.adfY[3];
+        z[i] = dfW0 * sCell.adfZ[0] + dfW1 * sCell.adfZ[1]
+            + dfW2 * sCell.adfZ[2] + dfW3 * sCell.adfZ[3];
+        panSuccess[i] = TRUE;
+    }
+
+    if( nExact == 0 )
+        return TRUE;
+
+/* -------------------------------------------------------------------- */
+/*      Transform exactly, in a single call, the points that could      */
+/*      not be interpolated.                                            */
+/* -------------------------------------------------------------------- */
+    double *padfXYZ = (double *) CPLMalloc( sizeof(double) * 3 * nExact );
+    int    *panExactSuccess = (int *) CPLMalloc( sizeof(int) * nExact );
+    double *padfX = padfXYZ;
+    double *padfY = padfXYZ + nExact;
+    double *padfZ = padfXYZ + 2 * nExact;
+
+    for( i = 0; i < nExact; i++ )
+    {
+        padfX[i] = x[panExact[i]];
+        padfY[i] = y[panExact[i]];
+        padfZ[i] = z[panExact[i]];
+    }
+
+    int bSuccess =
+        psATInfo->pfnBaseTransformer( psATInfo->pBaseCBData, TRUE, nExact,
+                                      padfX, padfY, padfZ, panExactSuccess );
+
+    for( i = 0; i < nExact; i++ )
+    {
+        x[panExact[i]] = padfX[i];
+        y[panExact[i]] = padfY[i];
+        z[panExact[i]] = padfZ[i];
+        panSuccess[panExact[i]] = bSuccess && panExactSuccess[i];
+    }
+
+    CPLFree( padfXYZ );
+    CPLFree( panExactSuccess );
+    CPLFree( panExact );
+
+    return bSuccess;
+}
+
 /************************************************************************/
 /*                    GDALCloneApproxTransformer()                      */
 /************************************************************************/
@@ -2484,6 +2901,10 @@ void* GDALCloneApproxTransformer( void *hTransformArg )
     }
     psClonedInfo->bOwnSubtransformer = TRUE;
 
+    /* The clones share the grid of transformed points */
+    if( psClonedInfo->psGrid != NULL )
+        GDALApproxGridReference( psClonedInfo->psGrid );
+
     return psClonedInfo;
 }
 
@@ -2576,6 +2997,7 @@ void *GDALCreateApproxTransformer( GDALTransformerFunc pfnBaseTransformer,
     psATInfo->pBaseCBData = pBaseTransformArg;
     psATInfo->dfMaxError = dfMaxError;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->psGrid = NULL;
 
     strcpy( psATInfo->sTI.szSignature, "GTI" );
     psATInfo->sTI.pszClassName = "GDALApproxTransformer";
@@ -2598,6 +3020,86 @@ void GDALApproxTransformerOwnsSubtransformer( void *pCBData, int bOwnFlag )
     psATInfo->bOwnSubtransformer = bOwnFlag;
 }
 
+/************************************************************************/
+/*                  GDALApproxTransformerSetGridCache()                 */
+/************************************************************************/
+
+/**
+ * Enable or disable the grid cache of an approximating transformer.
+ *
+ * When enabled, destination to source transformations are no longer
+ * approximated along each set of points passed in, but by bilinear 
+ * interpolation within the cells of a grid of exactly transformed points
+ * of the destination pixel/line space.  Cells whose interpolation error, 
+ * measured at the middle of their edges and at their center, exceeds the
+ * maximum error of the transformer are recursively split into four, down to 
+ * cells of two pixels whose points are transformed exactly.
+ *
+ * The grid is computed lazily and kept for the lifetime of the transformer, 
+ * and is shared with its clones, so that the points are computed only once
+ * whatever the number of chunks, bands and threads of a warp operation.  
+ * GDALWarpOperation enables it when the APPROX_GRID_CELL_SIZE warping
+ * option is set.
+ *
+ * The memory used by the grid is limited to the value, in bytes, of the
+ * GDAL_APPROX_GRID_CACHE_MAX configuration option (4 MB by default).  When
+ * the limit is reached, the grid is emptied and computed again as needed.
+ *
+ * The grid assumes that the base transformer is not modified afterwards.
+ *
+ * @param pCBData callback data returned by GDALCreateApproxTransformer().
+ * @param nCellSize size in pixels of the largest cells of the grid, rounded
+ * up to a power of two, or 0 to disable the grid cache.
+ *
+ * @since GDAL 2.0
+ */
+
+void GDALApproxTransformerSetGridCache( void *pCBData, int nCellSize )
+
+{
+    VALIDATE_POINTER0( pCBData, "GDALApproxTransformerSetGridCache" );
+
+    ApproxTransformInfo	*psATInfo = (ApproxTransformInfo *) pCBData;
+
+    if( nCellSize > 0 )
+    {
+        int nRoundedCellSize = APPROX_GRID_MIN_CELL_SIZE * 2;
+        while( nRoundedCellSize < nCellSize
+               && nRoundedCellSize < APPROX_GRID_MAX_CELL_SIZE )
+            nRoundedCellSize *= 2;
+
+        /* Keep the points already computed */
+        if( psATInfo->psGrid != NULL
+            && psATInfo->psGrid->nCellSize == nRoundedCellSize )
+            return;
+
+        nCellSize = nRoundedCellSize;
+    }
+
+    if( psATInfo->psGrid != NULL )
+    {
+        GDALApproxGridDereference( psATInfo->psGrid );
+        psATInfo->psGrid = NULL;
+    }
+
+    if( nCellSize <= 0 )
+        return;
+
+    GDALApproxGrid *psGrid = new GDALApproxGrid;
+    psGrid->hMutex = CPLCreateMutex();
+    CPLReleaseMutex( psGrid->hMutex );
+    psGrid->nRefCount = 1;
+    psGrid->nCellSize = nCellSize;
+    psGrid->nMaxLevel = 0;
+    while( (nCellSize >> psGrid->nMaxLevel) > APPROX_GRID_MIN_CELL_SIZE )
+        psGrid->nMaxLevel ++;
+    psGrid->nMaxMemory = CPLAtoGIntBig(
+        CPLGetConfigOption( "GDAL_APPROX_GRID_CACHE_MAX",
+                            APPROX_GRID_DEFAULT_MAX_MEMORY ) );
+
+    psATInfo->psGrid = psGrid;
+}
+
 /************************************************************************/
 /*                    GDALDestroyApproxTransformer()                    */
 /************************************************************************/
@@ -2621,6 +3123,9 @@ void GDALDestroyApproxTransformer( void * pCBData )
     if( psATInfo->bOwnSubtransformer ) 
         GDALDestroyTransformer( psATInfo->pBaseCBData );
 
+    if( psATInfo->psGrid != NULL )
+        GDALApproxGridDereference( psATInfo->psGrid );
+
     CPLFree( pCBData );
 }
 
@@ -2645,6 +3150,10 @@ int GDALApproxTransform( void *pCBData, int bDstToSrc, int nPoints,
     double x2[3], y2[3], z2[3], dfDeltaX, dfDeltaY, dfError, dfDist, dfDeltaZ;
     int nMiddle, anSuccess2[3], i, bSuccess;
 
+    if( bDstToSrc && psATInfo->psGrid != NULL && psATInfo->dfMaxError > 0.0 )
+        return GDALApproxTransformWithGrid( psATInfo, nPoints, x, y, z,
+                                            panSuccess );
+
     nMiddle = (nPoints-1)/2;
 
 /* -------------------------------------------------------------------- */
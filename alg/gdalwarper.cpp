@@ -842,6 +842,16 @@ GDALWarpDstAlphaMasker( void *pMaskFuncArg, int nBandCount, GDALDataType eType,
  * - NUM_THREADS: (GDAL >= 1.10) Can be set to a numeric value or ALL_CPUS to
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.
+ *
+ * - APPROX_GRID_CELL_SIZE: (GDAL >= 2.0) When the transformer is 
+ * GDALApproxTransform(), the size in pixels of the largest cells of the grid
+ * of exactly transformed points within which the destination to source 
+ * transformation is interpolated.  Cells are split as needed to honour the 
+ * maximum error of the approximating transformer.  The grid is computed once
+ * and shared by all chunks and threads.  256 is a sensible value.  The default
+ * is 0: the transformation is approximated along each scanline.  The memory
+ * used by the grid is limited by the GDAL_APPROX_GRID_CACHE_MAX configuration
+ * option, in bytes (4 MB by default).
  */
 
 /************************************************************************/
@@ -36,6 +36,15 @@
 #include "gdalwarpkernel_opencl.h"
 #include "cpl_atomic_ops.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
+
+/* SSE2 is always available on x86_64, and on x86 when the compiler is */
+/* allowed to use it, so there is no need for a runtime check. */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_SSE2_WARP_KERNELS
+#include <emmintrin.h>
+#endif
 
 CPL_CVSID("$Id$");
 
@@ -62,16 +71,20 @@ static CPLErr GWKOpenCLCase( GDALWarpKernel * );
 
 static CPLErr GWKGeneralCase( GDALWarpKernel * );
 static CPLErr GWKNearestNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKBilinearNoMasksByte( GDALWarpKernel *poWK );
-static CPLErr GWKCubicNoMasksByte( GDALWarpKernel *poWK );
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyByte( GDALWarpKernel *poWK );
+static CPLErr GWKCubicNoMasksOrBandValidOnlyByte( GDALWarpKernel *poWK );
 static CPLErr GWKCubicSplineNoMasksByte( GDALWarpKernel *poWK );
 static CPLErr GWKNearestByte( GDALWarpKernel *poWK );
 static CPLErr GWKNearestNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKBilinearNoMasksShort( GDALWarpKernel *poWK );
-static CPLErr GWKCubicNoMasksShort( GDALWarpKernel *poWK );
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyShort( GDALWarpKernel *poWK );
+static CPLErr GWKCubicNoMasksOrBandValidOnlyShort( GDALWarpKernel *poWK );
 static CPLErr GWKCubicSplineNoMasksShort( GDALWarpKernel *poWK );
 static CPLErr GWKNearestShort( GDALWarpKernel *poWK );
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyUShort( GDALWarpKernel *poWK );
+static CPLErr GWKCubicNoMasksOrBandValidOnlyUShort( GDALWarpKernel *poWK );
 static CPLErr GWKNearestNoMasksFloat( GDALWarpKernel *poWK );
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyFloat( GDALWarpKernel *poWK );
+static CPLErr GWKCubicNoMasksOrBandValidOnlyFloat( GDALWarpKernel *poWK );
 static CPLErr GWKNearestFloat( GDALWarpKernel *poWK );
 static CPLErr GWKAverageOrMode( GDALWarpKernel * );
 
@@ -83,7 +96,6 @@ typedef struct _GWKJobStruct GWKJobStruct;
 
 struct _GWKJobStruct
 {
-    void           *hThread;
     GDALWarpKernel *poWK;
     int             iYMin;
     int             iYMax;
@@ -149,7 +161,6 @@ static CPLErr GWKGenericMonoThread( GDALWarpKernel *poWK,
     sThreadJob.pbStop = &bStop;
     sThreadJob.hCond = NULL;
     sThreadJob.hCondMutex = NULL;
-    sThreadJob.hThread = NULL;
     sThreadJob.pfnProgress = GWKProgressMonoThread;
     sThreadJob.pTransformerArg = poWK->pTransformerArg;
 
@@ -195,6 +206,9 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
         nThreads = 128;
     if (nThreads >= nDstYSize / 2)
         nThreads = nDstYSize / 2;
+    /* Do not wait for nested jobs from a job of the worker thread pool */
+    if (CPLIsWorkerThread())
+        nThreads = 1;
 
     if (nThreads <= 1)
     {
@@ -259,8 +273,10 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
         volatile int nCounter = 0;
 
 /* -------------------------------------------------------------------- */
-/*      Lannch worker threads                                           */
+/*      Submit jobs to the worker thread pool.                          */
 /* -------------------------------------------------------------------- */
+        CPLJobGroup *psJobGroup = CPLCreateJobGroup();
+
         for(i=0;i<nThreads;i++)
         {
             pasThreadJob[i].poWK = poWK;
@@ -271,8 +287,7 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
             pasThreadJob[i].hCond = hCond;
             pasThreadJob[i].hCondMutex = hCondMutex;
             pasThreadJob[i].pfnProgress = GWKProgressThread;
-            pasThreadJob[i].hThread = CPLCreateJoinableThread( pfnFunc,
-                                                  (void*) &pasThreadJob[i] );
+            CPLSubmitJob( psJobGroup, pfnFunc, (void*) &pasThreadJob[i] );
         }
 
 /* -------------------------------------------------------------------- */
@@ -292,16 +307,17 @@ static CPLErr GWKRun( GDALWarpKernel *poWK,
             }
         }
 
-        /* Release mutex before joining threads, otherwise they will dead-lock */
-        /* forever in GWKProgressThread() */
+        /* Release mutex before waiting for the jobs, otherwise they will */
+        /* dead-lock forever in GWKProgressThread() */
         CPLReleaseMutex(hCondMutex);
 
 /* -------------------------------------------------------------------- */
-/*      Wait for all threads to complete and finish.                    */
+/*      Wait for all jobs to complete and finish.                       */
 /* -------------------------------------------------------------------- */
+        CPLDestroyJobGroup(psJobGroup);
+
         for(i=0;i<nThreads;i++)
         {
-            CPLJoinThread(pasThreadJob[i].hThread);
             GDALDestroyTransformer(pasThreadJob[i].pTransformerArg);
         }
 
@@ -858,21 +874,17 @@ CPLErr GDALWarpKernel::PerformWarp()
 
     if( eWorkingDataType == GDT_Byte
         && eResample == GRA_Bilinear
-        && papanBandSrcValid == NULL
         && panUnifiedSrcValid == NULL
         && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
         && pafDstDensity == NULL )
-        return GWKBilinearNoMasksByte( this );
+        return GWKBilinearNoMasksOrBandValidOnlyByte( this );
 
     if( eWorkingDataType == GDT_Byte
         && eResample == GRA_Cubic
-        && papanBandSrcValid == NULL
         && panUnifiedSrcValid == NULL
         && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
         && pafDstDensity == NULL )
-        return GWKCubicNoMasksByte( this );
+        return GWKCubicNoMasksOrBandValidOnlyByte( this );
 
     if( eWorkingDataType == GDT_Byte
         && eResample == GRA_CubicSpline
@@ -898,12 +910,10 @@ CPLErr GDALWarpKernel::PerformWarp()
 
     if( (eWorkingDataType == GDT_Int16 )
         && eResample == GRA_Cubic
-        && papanBandSrcValid == NULL
         && panUnifiedSrcValid == NULL
         && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
         && pafDstDensity == NULL )
-        return GWKCubicNoMasksShort( this );
+        return GWKCubicNoMasksOrBandValidOnlyShort( this );
 
     if( (eWorkingDataType == GDT_Int16 )
         && eResample == GRA_CubicSpline
@@ -916,12 +926,24 @@ CPLErr GDALWarpKernel::PerformWarp()
 
     if( (eWorkingDataType == GDT_Int16 )
         && eResample == GRA_Bilinear
-        && papanBandSrcValid == NULL
         && panUnifiedSrcValid == NULL
         && pafUnifiedSrcDensity == NULL
-        && panDstValid == NULL
         && pafDstDensity == NULL )
-        return GWKBilinearNoMasksShort( this );
+        return GWKBilinearNoMasksOrBandValidOnlyShort( this );
+
+    if( eWorkingDataType == GDT_UInt16
+        && eResample == GRA_Bilinear
+        && panUnifiedSrcValid == NULL
+        && pafUnifiedSrcDensity == NULL
+        && pafDstDensity == NULL )
+        return GWKBilinearNoMasksOrBandValidOnlyUShort( this );
+
+    if( eWorkingDataType == GDT_UInt16
+        && eResample == GRA_Cubic
+        && panUnifiedSrcValid == NULL
+        && pafUnifiedSrcDensity == NULL
+        && pafDstDensity == NULL )
+        return GWKCubicNoMasksOrBandValidOnlyUShort( this );
 
     if( (eWorkingDataType == GDT_Int16 || eWorkingDataType == GDT_UInt16)
         && eResample == GRA_NearestNeighbour )
@@ -936,6 +958,20 @@ CPLErr GDALWarpKernel::PerformWarp()
         && pafDstDensity == NULL )
         return GWKNearestNoMasksFloat( this );
 
+    if( eWorkingDataType == GDT_Float32
+        && eResample == GRA_Bilinear
+        && panUnifiedSrcValid == NULL
+        && pafUnifiedSrcDensity == NULL
+        && pafDstDensity == NULL )
+        return GWKBilinearNoMasksOrBandValidOnlyFloat( this );
+
+    if( eWorkingDataType == GDT_Float32
+        && eResample == GRA_Cubic
+        && panUnifiedSrcValid == NULL
+        && pafUnifiedSrcDensity == NULL
+        && pafDstDensity == NULL )
+        return GWKCubicNoMasksOrBandValidOnlyFloat( this );
+
     if( eWorkingDataType == GDT_Float32
         && eResample == GRA_NearestNeighbour )
         return GWKNearestFloat( this );
@@ -1840,182 +1876,241 @@ static int GWKBilinearResample( GDALWarpKernel *poWK, int iBand,
     }
 }
 
-static int GWKBilinearResampleNoMasksByte( GDALWarpKernel *poWK, int iBand, 
-                                           double dfSrcX, double dfSrcY,
-                                           GByte *pbValue )
+/************************************************************************/
+/*                          GWKClampValueT()                            */
+/*                                                                      */
+/*      Round and clamp an interpolated value to the range of the       */
+/*      working data type.                                              */
+/************************************************************************/
+
+template<class T> static T GWKClampValueT( double dfValue );
 
+template<> inline GByte GWKClampValueT<GByte>( double dfValue )
 {
-    double  dfAccumulator = 0.0;
-    double  dfAccumulatorDivisor = 0.0;
+    if ( dfValue < 0.0 )
+        return 0;
+    else if ( dfValue > 255.0 )
+        return 255;
+    else
+        return (GByte)(0.5 + dfValue);
+}
 
-    int     iSrcX = (int) floor(dfSrcX - 0.5);
-    int     iSrcY = (int) floor(dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
-    double  dfRatioX = 1.5 - (dfSrcX - iSrcX);
-    double  dfRatioY = 1.5 - (dfSrcY - iSrcY);
+template<> inline GInt16 GWKClampValueT<GInt16>( double dfValue )
+{
+    if ( dfValue < -32768.0 )
+        return -32768;
+    else if ( dfValue > 32767.0 )
+        return 32767;
+    else
+        return (GInt16)floor(0.5 + dfValue);
+}
 
-    // Upper Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
-    {
-        double dfMult = dfRatioX * dfRatioY;
+template<> inline GUInt16 GWKClampValueT<GUInt16>( double dfValue )
+{
+    if ( dfValue < 0.0 )
+        return 0;
+    else if ( dfValue > 65535.0 )
+        return 65535;
+    else
+        return (GUInt16)(0.5 + dfValue);
+}
 
-        dfAccumulatorDivisor += dfMult;
+template<> inline float GWKClampValueT<float>( double dfValue )
+{
+    return (float)dfValue;
+}
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset] * dfMult;
-    }
-        
-    // Upper Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
-    {
-        double dfMult = (1.0-dfRatioX) * dfRatioY;
+#ifdef HAVE_SSE2_WARP_KERNELS
 
-        dfAccumulatorDivisor += dfMult;
+/************************************************************************/
+/*                         GWKLoad2Samples()                            */
+/*                                                                      */
+/*      Load 2 consecutive source samples as doubles into a register,   */
+/*      without reading past them.                                      */
+/************************************************************************/
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+1] * dfMult;
-    }
-        
-    // Lower Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
-    {
-        double dfMult = (1.0-dfRatioX) * (1.0-dfRatioY);
+static inline __m128d GWKLoad2Samples( const GByte* pSrc )
+{
+    GUInt16 nSamples;
+    memcpy( &nSamples, pSrc, 2 );
+    const __m128i xmm_zero = _mm_setzero_si128();
+    __m128i xmm = _mm_cvtsi32_si128( nSamples );
+    xmm = _mm_unpacklo_epi16( _mm_unpacklo_epi8( xmm, xmm_zero ), xmm_zero );
+    return _mm_cvtepi32_pd( xmm );
+}
 
-        dfAccumulatorDivisor += dfMult;
+static inline __m128d GWKLoad2Samples( const GInt16* pSrc )
+{
+    GInt32 nSamples;
+    memcpy( &nSamples, pSrc, 4 );
+    __m128i xmm = _mm_cvtsi32_si128( nSamples );
+    /* Sign extension to 32 bit */
+    xmm = _mm_srai_epi32( _mm_unpacklo_epi16( xmm, xmm ), 16 );
+    return _mm_cvtepi32_pd( xmm );
+}
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+1+poWK->nSrcXSize]
-            * dfMult;
-    }
-        
-    // Lower Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
-    {
-        double dfMult = dfRatioX * (1.0-dfRatioY);
+static inline __m128d GWKLoad2Samples( const GUInt16* pSrc )
+{
+    GInt32 nSamples;
+    memcpy( &nSamples, pSrc, 4 );
+    __m128i xmm = _mm_cvtsi32_si128( nSamples );
+    xmm = _mm_unpacklo_epi16( xmm, _mm_setzero_si128() );
+    return _mm_cvtepi32_pd( xmm );
+}
 
-        dfAccumulatorDivisor += dfMult;
+static inline __m128d GWKLoad2Samples( const float* pSrc )
+{
+    __m128i xmm = _mm_loadl_epi64( (const __m128i*) pSrc );
+    return _mm_cvtps_pd( _mm_castsi128_ps( xmm ) );
+}
 
-        dfAccumulator +=
-            (double)poWK->papabySrcImage[iBand][iSrcOffset+poWK->nSrcXSize]
-            * dfMult;
-    }
+/************************************************************************/
+/*                         GWKLoad4Samples()                            */
+/*                                                                      */
+/*      Load 4 consecutive source samples as doubles into 2 registers.  */
+/************************************************************************/
 
-/* -------------------------------------------------------------------- */
-/*      Return result.                                                  */
-/* -------------------------------------------------------------------- */
-    double      dfValue;
+static inline void GWKLoad4Samples( const GByte* pSrc,
+                                    __m128d& xmm_lo, __m128d& xmm_hi )
+{
+    GInt32 nSamples;
+    memcpy( &nSamples, pSrc, 4 );
+    const __m128i xmm_zero = _mm_setzero_si128();
+    __m128i xmm = _mm_cvtsi32_si128( nSamples );
+    xmm = _mm_unpacklo_epi16( _mm_unpacklo_epi8( xmm, xmm_zero ), xmm_zero );
+    xmm_lo = _mm_cvtepi32_pd( xmm );
+    xmm_hi = _mm_cvtepi32_pd( _mm_srli_si128( xmm, 8 ) );
+}
 
-    if( dfAccumulatorDivisor < 0.00001 )
-    {
-        *pbValue = 0;
-        return FALSE;
-    }
-    else if( dfAccumulatorDivisor == 1.0 )
-    {
-        dfValue = dfAccumulator;
-    }
-    else
-    {
-        dfValue = dfAccumulator / dfAccumulatorDivisor;
-    }
+static inline void GWKLoad4Samples( const GInt16* pSrc,
+                                    __m128d& xmm_lo, __m128d& xmm_hi )
+{
+    __m128i xmm = _mm_loadl_epi64( (const __m128i*) pSrc );
+    /* Sign extension to 32 bit */
+    xmm = _mm_srai_epi32( _mm_unpacklo_epi16( xmm, xmm ), 16 );
+    xmm_lo = _mm_cvtepi32_pd( xmm );
+    xmm_hi = _mm_cvtepi32_pd( _mm_srli_si128( xmm, 8 ) );
+}
 
-    if ( dfValue < 0.0 )
-        *pbValue = 0;
-    else if ( dfValue > 255.0 )
-        *pbValue = 255;
-    else
-        *pbValue = (GByte)(0.5 + dfValue);
-    
-    return TRUE;
+static inline void GWKLoad4Samples( const GUInt16* pSrc,
+                                    __m128d& xmm_lo, __m128d& xmm_hi )
+{
+    __m128i xmm = _mm_loadl_epi64( (const __m128i*) pSrc );
+    xmm = _mm_unpacklo_epi16( xmm, _mm_setzero_si128() );
+    xmm_lo = _mm_cvtepi32_pd( xmm );
+    xmm_hi = _mm_cvtepi32_pd( _mm_srli_si128( xmm, 8 ) );
+}
+
+static inline void GWKLoad4Samples( const float* pSrc,
+                                    __m128d& xmm_lo, __m128d& xmm_hi )
+{
+    __m128 xmm = _mm_loadu_ps( pSrc );
+    xmm_lo = _mm_cvtps_pd( xmm );
+    xmm_hi = _mm_cvtps_pd( _mm_movehl_ps( xmm, xmm ) );
 }
 
-static int GWKBilinearResampleNoMasksShort( GDALWarpKernel *poWK, int iBand, 
-                                            double dfSrcX, double dfSrcY,
-                                            GInt16 *piValue )
+#endif /* HAVE_SSE2_WARP_KERNELS */
+
+/************************************************************************/
+/*                   GWKBilinearResampleNoMasksT()                      */
+/*                                                                      */
+/*      Bilinear resampling of a real band without any mask, one pixel  */
+/*      at a time. GWKResampleNoMasksOrBandValidOnlyThread() only uses  */
+/*      it on the border of the source window.                          */
+/************************************************************************/
+
+template<class T>
+static int GWKBilinearResampleNoMasksT( GDALWarpKernel *poWK, int iBand,
+                                        double dfSrcX, double dfSrcY,
+                                        T *pValue )
 
 {
     double  dfAccumulator = 0.0;
     double  dfAccumulatorDivisor = 0.0;
 
+    int     nSrcXSize = poWK->nSrcXSize;
+    int     nSrcYSize = poWK->nSrcYSize;
     int     iSrcX = (int) floor(dfSrcX - 0.5);
     int     iSrcY = (int) floor(dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
+    int     iSrcOffset = iSrcX + iSrcY * nSrcXSize;
     double  dfRatioX = 1.5 - (dfSrcX - iSrcX);
     double  dfRatioY = 1.5 - (dfSrcY - iSrcY);
+    const T* pSrc = (const T *)poWK->papabySrcImage[iBand];
+
+    if( iSrcX >= 0 && iSrcX + 1 < nSrcXSize
+        && iSrcY >= 0 && iSrcY + 1 < nSrcYSize )
+    {
+        *pValue = GWKClampValueT<T>(
+            ( (double)pSrc[iSrcOffset] * dfRatioX
+              + (double)pSrc[iSrcOffset + 1] * (1.0-dfRatioX) ) * dfRatioY
+            + ( (double)pSrc[iSrcOffset + nSrcXSize] * dfRatioX
+              + (double)pSrc[iSrcOffset + nSrcXSize + 1] * (1.0-dfRatioX) )
+              * (1.0-dfRatioY) );
+        return TRUE;
+    }
 
     // Upper Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
+    if( iSrcX >= 0 && iSrcX < nSrcXSize
+        && iSrcY >= 0 && iSrcY < nSrcYSize )
     {
         double dfMult = dfRatioX * dfRatioY;
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset]
-            * dfMult;
+        dfAccumulator += (double)pSrc[iSrcOffset] * dfMult;
     }
         
     // Upper Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY >= 0 && iSrcY < poWK->nSrcYSize )
+    if( iSrcX+1 >= 0 && iSrcX+1 < nSrcXSize
+        && iSrcY >= 0 && iSrcY < nSrcYSize )
     {
         double dfMult = (1.0-dfRatioX) * dfRatioY;
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+1] * dfMult;
+        dfAccumulator += (double)pSrc[iSrcOffset + 1] * dfMult;
     }
         
     // Lower Right Pixel
-    if( iSrcX+1 >= 0 && iSrcX+1 < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
+    if( iSrcX+1 >= 0 && iSrcX+1 < nSrcXSize
+        && iSrcY+1 >= 0 && iSrcY+1 < nSrcYSize )
     {
         double dfMult = (1.0-dfRatioX) * (1.0-dfRatioY);
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+1+poWK->nSrcXSize]
-            * dfMult;
+        dfAccumulator += (double)pSrc[iSrcOffset + 1 + nSrcXSize] * dfMult;
     }
         
     // Lower Left Pixel
-    if( iSrcX >= 0 && iSrcX < poWK->nSrcXSize
-        && iSrcY+1 >= 0 && iSrcY+1 < poWK->nSrcYSize )
+    if( iSrcX >= 0 && iSrcX < nSrcXSize
+        && iSrcY+1 >= 0 && iSrcY+1 < nSrcYSize )
     {
         double dfMult = dfRatioX * (1.0-dfRatioY);
 
         dfAccumulatorDivisor += dfMult;
 
-        dfAccumulator +=
-            (double)((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset+poWK->nSrcXSize]
-            * dfMult;
+        dfAccumulator += (double)pSrc[iSrcOffset + nSrcXSize] * dfMult;
     }
 
 /* -------------------------------------------------------------------- */
 /*      Return result.                                                  */
 /* -------------------------------------------------------------------- */
-    if( dfAccumulatorDivisor == 1.0 )
+    if( dfAccumulatorDivisor < 0.00001 )
     {
-        *piValue = (GInt16)(0.5 + dfAccumulator);
-        return TRUE;
+        *pValue = 0;
+        return FALSE;
     }
-    else if( dfAccumulatorDivisor < 0.00001 )
+    else if( dfAccumulatorDivisor == 1.0 )
     {
-        *piValue = 0;
-        return FALSE;
+        *pValue = GWKClampValueT<T>( dfAccumulator );
     }
     else
     {
-        *piValue = (GInt16)(0.5 + dfAccumulator / dfAccumulatorDivisor);
-        return TRUE;
+        *pValue = GWKClampValueT<T>( dfAccumulator / dfAccumulatorDivisor );
     }
+
+    return TRUE;
 }
 
 /************************************************************************/
@@ -2094,150 +2189,379 @@ static int GWKCubicResample( GDALWarpKernel *poWK, int iBand,
     return TRUE;
 }
 
-static int GWKCubicResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
-                                        double dfSrcX, double dfSrcY,
-                                        GByte *pbValue )
+/************************************************************************/
+/*                      GWKCubicComputeWeights()                        */
+/*                                                                      */
+/*      The CubicConvolution() polynomial expanded into the weights of  */
+/*      the 4 source samples, for a fractional offset in [0,1[.         */
+/************************************************************************/
 
+static inline void GWKCubicComputeWeights( double dfDelta, double adfWeights[4] )
 {
-    int     iSrcX = (int) (dfSrcX - 0.5);
-    int     iSrcY = (int) (dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
-    double  dfDeltaX = dfSrcX - 0.5 - iSrcX;
-    double  dfDeltaY = dfSrcY - 0.5 - iSrcY;
-    double  dfDeltaX2 = dfDeltaX * dfDeltaX;
-    double  dfDeltaY2 = dfDeltaY * dfDeltaY;
-    double  dfDeltaX3 = dfDeltaX2 * dfDeltaX;
-    double  dfDeltaY3 = dfDeltaY2 * dfDeltaY;
-    double  adfValue[4];
-    int     i;
+    double dfDelta2 = dfDelta * dfDelta;
+    double dfDelta3 = dfDelta2 * dfDelta;
 
-    // Get the bilinear interpolation at the image borders
-    if ( iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize
-         || iSrcY - 1 < 0 || iSrcY + 2 >= poWK->nSrcYSize )
-        return GWKBilinearResampleNoMasksByte( poWK, iBand, dfSrcX, dfSrcY,
-                                               pbValue);
+    adfWeights[0] = -0.5 * dfDelta + dfDelta2 - 0.5 * dfDelta3;
+    adfWeights[1] = 1.0 - 2.5 * dfDelta2 + 1.5 * dfDelta3;
+    adfWeights[2] = 0.5 * dfDelta + 2.0 * dfDelta2 - 1.5 * dfDelta3;
+    adfWeights[3] = -0.5 * dfDelta2 + 0.5 * dfDelta3;
+}
 
-    for ( i = -1; i < 3; i++ )
-    {
-        int     iOffset = iSrcOffset + i * poWK->nSrcXSize;
+#ifdef HAVE_SSE2_WARP_KERNELS
 
-        adfValue[i + 1] = CubicConvolution(dfDeltaX, dfDeltaX2, dfDeltaX3,
-                            (double)poWK->papabySrcImage[iBand][iOffset - 1],
-                            (double)poWK->papabySrcImage[iBand][iOffset],
-                            (double)poWK->papabySrcImage[iBand][iOffset + 1],
-                            (double)poWK->papabySrcImage[iBand][iOffset + 2]);
-    }
+/* Same computation as above, for 2 offsets at once */
+static inline void GWKCubicComputeWeights( __m128d xmm_delta,
+                                           __m128d axmm_weights[4] )
+{
+    const __m128d xmm_delta2 = _mm_mul_pd( xmm_delta, xmm_delta );
+    const __m128d xmm_delta3 = _mm_mul_pd( xmm_delta2, xmm_delta );
+    const __m128d xmm_half = _mm_set1_pd( 0.5 );
+    const __m128d xmm_one_and_half = _mm_set1_pd( 1.5 );
+
+    axmm_weights[0] = _mm_sub_pd(
+        _mm_add_pd( _mm_mul_pd( _mm_set1_pd( -0.5 ), xmm_delta ), xmm_delta2 ),
+        _mm_mul_pd( xmm_half, xmm_delta3 ) );
+    axmm_weights[1] = _mm_add_pd(
+        _mm_sub_pd( _mm_set1_pd( 1.0 ),
+                    _mm_mul_pd( _mm_set1_pd( 2.5 ), xmm_delta2 ) ),
+        _mm_mul_pd( xmm_one_and_half, xmm_delta3 ) );
+    axmm_weights[2] = _mm_sub_pd(
+        _mm_add_pd( _mm_mul_pd( xmm_half, xmm_delta ),
+                    _mm_mul_pd( _mm_set1_pd( 2.0 ), xmm_delta2 ) ),
+        _mm_mul_pd( xmm_one_and_half, xmm_delta3 ) );
+    axmm_weights[3] = _mm_add_pd(
+        _mm_mul_pd( _mm_set1_pd( -0.5 ), xmm_delta2 ),
+        _mm_mul_pd( xmm_half, xmm_delta3 ) );
+}
 
-    double dfValue = CubicConvolution(dfDeltaY, dfDeltaY2, dfDeltaY3,
-                        adfValue[0], adfValue[1], adfValue[2], adfValue[3]);
+#endif /* HAVE_SSE2_WARP_KERNELS */
 
-    if ( dfValue < 0.0 )
-        *pbValue = 0;
-    else if ( dfValue > 255.0 )
-        *pbValue = 255;
+/************************************************************************/
+/*                        GWKAvoidNoDataT()                             */
+/*                                                                      */
+/*      Same as GWKSetPixelValue(): do not write the destination        */
+/*      nodata value of integer data types for a valid pixel.          */
+/************************************************************************/
+
+template<class T> static inline T GWKAvoidIntegerNoDataT( T nValue,
+                                                          double dfNoData,
+                                                          T nMinValue )
+{
+    if( (double)nValue != dfNoData )
+        return nValue;
+    else if( nValue == nMinValue )
+        return (T)(nValue + 1);
     else
-        *pbValue = (GByte)(0.5 + dfValue);
-    
-    return TRUE;
+        return (T)(nValue - 1);
 }
 
-static int GWKCubicResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
-                                         double dfSrcX, double dfSrcY,
-                                         GInt16 *piValue )
+template<class T> static inline T GWKAvoidNoDataT( T nValue, double dfNoData );
 
+template<> inline GByte GWKAvoidNoDataT<GByte>( GByte nValue, double dfNoData )
 {
-    int     iSrcX = (int) (dfSrcX - 0.5);
-    int     iSrcY = (int) (dfSrcY - 0.5);
-    int     iSrcOffset = iSrcX + iSrcY * poWK->nSrcXSize;
-    double  dfDeltaX = dfSrcX - 0.5 - iSrcX;
-    double  dfDeltaY = dfSrcY - 0.5 - iSrcY;
-    double  dfDeltaX2 = dfDeltaX * dfDeltaX;
-    double  dfDeltaY2 = dfDeltaY * dfDeltaY;
-    double  dfDeltaX3 = dfDeltaX2 * dfDeltaX;
-    double  dfDeltaY3 = dfDeltaY2 * dfDeltaY;
-    double  adfValue[4];
-    int     i;
+    return GWKAvoidIntegerNoDataT<GByte>( nValue, dfNoData, 0 );
+}
 
-    // Get the bilinear interpolation at the image borders
-    if ( iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize
-         || iSrcY - 1 < 0 || iSrcY + 2 >= poWK->nSrcYSize )
-        return GWKBilinearResampleNoMasksShort( poWK, iBand, dfSrcX, dfSrcY,
-                                                piValue);
+template<> inline GInt16 GWKAvoidNoDataT<GInt16>( GInt16 nValue, double dfNoData )
+{
+    return GWKAvoidIntegerNoDataT<GInt16>( nValue, dfNoData, -32768 );
+}
 
-    for ( i = -1; i < 3; i++ )
-    {
-        int     iOffset = iSrcOffset + i * poWK->nSrcXSize;
+template<> inline GUInt16 GWKAvoidNoDataT<GUInt16>( GUInt16 nValue, double dfNoData )
+{
+    return GWKAvoidIntegerNoDataT<GUInt16>( nValue, dfNoData, 0 );
+}
 
-        adfValue[i + 1] =CubicConvolution(dfDeltaX, dfDeltaX2, dfDeltaX3,
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset - 1],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset + 1],
-                (double)((GInt16 *)poWK->papabySrcImage[iBand])[iOffset + 2]);
-    }
+template<> inline float GWKAvoidNoDataT<float>( float fValue, double )
+{
+    return fValue;
+}
 
-    double dfValue = CubicConvolution(
-        dfDeltaY, dfDeltaY2, dfDeltaY3,
-        adfValue[0], adfValue[1], adfValue[2], adfValue[3]);
-    
-    if ( dfValue < -32768.0 )
-        *piValue = -32768;
-    else if ( dfValue > 32767.0 )
-        *piValue = 32767;
+/************************************************************************/
+/*                         GWKStoreValueT()                             */
+/************************************************************************/
+
+template<class T>
+static inline void GWKStoreValueT( T* pDst, double dfValue,
+                                   const double* pdfDstNoData )
+{
+    if( pdfDstNoData == NULL )
+        *pDst = GWKClampValueT<T>( dfValue );
     else
-        *piValue = (GInt16)floor(0.5 + dfValue);
-    
-    return TRUE;
+        *pDst = GWKAvoidNoDataT<T>( GWKClampValueT<T>( dfValue ),
+                                    *pdfDstNoData );
 }
 
-
 /************************************************************************/
-/*                          GWKLanczosSinc()                            */
+/*                        GWKResampleRowStruct                          */
+/*                                                                      */
+/*      Destination pixels of a scanline whose resampling               */
+/*      neighbourhood is entirely inside the source window, with the    */
+/*      offset of the top left sample of this neighbourhood and the     */
+/*      fractional part of their source coordinates.                    */
 /************************************************************************/
 
-/*
- * Lanczos windowed sinc interpolation kernel with radius r.
- *        /
- *        | sinc(x) * sinc(x/r), if |x| < r
- * L(x) = | 1, if x = 0                     ,
- *        | 0, otherwise
- *        \
- *
- * where sinc(x) = sin(PI * x) / (PI * x).
- */
-
-#define GWK_PI 3.14159265358979323846
+typedef struct _GWKResampleRowStruct GWKResampleRowStruct;
 
-static double GWKLanczosSinc( double dfX, double dfR )
+struct _GWKResampleRowStruct
 {
-    if ( dfX == 0.0 )
-        return 1.0;
+    int     nCount;
+    int    *panDstX;
+    int    *panSrcOffset;
+    double *padfDeltaX;
+    double *padfDeltaY;
+};
 
-    const double dfPIX = GWK_PI * dfX;
-    const double dfPIXoverR = dfPIX / dfR;
-    const double dfPIX2overR = dfPIX * dfPIXoverR;
-    return sin(dfPIX) * sin(dfPIXoverR) / dfPIX2overR;
+static void GWKResampleRowAlloc( GWKResampleRowStruct* psRow, int nSize )
+{
+    psRow->nCount = 0;
+    psRow->panDstX = (int *) CPLMalloc(sizeof(int) * nSize);
+    psRow->panSrcOffset = (int *) CPLMalloc(sizeof(int) * nSize);
+    psRow->padfDeltaX = (double *) CPLMalloc(sizeof(double) * nSize);
+    psRow->padfDeltaY = (double *) CPLMalloc(sizeof(double) * nSize);
 }
 
-//#undef GWK_PI
+static void GWKResampleRowFree( GWKResampleRowStruct* psRow )
+{
+    CPLFree( psRow->panDstX );
+    CPLFree( psRow->panSrcOffset );
+    CPLFree( psRow->padfDeltaX );
+    CPLFree( psRow->padfDeltaY );
+}
 
 /************************************************************************/
-/*                           GWKBSpline()                               */
+/*                   GWKBilinearResampleRowNoMasksT()                   */
+/*                                                                      */
+/*      Bilinear resampling of the pixels of a scanline whose 2x2       */
+/*      neighbourhood is inside the source window. With SSE2, 2         */
+/*      destination pixels are computed per iteration: each row of a    */
+/*      neighbourhood is a single 2 sample load, the rows are blended   */
+/*      per pixel, and the columns of both pixels are then blended      */
+/*      together.                                                       */
 /************************************************************************/
 
-static double GWKBSpline( double x )
+template<class T>
+static void GWKBilinearResampleRowNoMasksT( const T* pSrc, int nSrcXSize,
+                                            const GWKResampleRowStruct* psRow,
+                                            T* pDstLine,
+                                            const double* pdfDstNoData )
+
 {
-    double xp2 = x + 2.0;
-    double xp1 = x + 1.0;
-    double xm1 = x - 1.0;
-    
-    // This will most likely be used, so we'll compute it ahead of time to
-    // avoid stalling the processor
-    double xp2c = xp2 * xp2 * xp2;
-    
-    // Note that the test is computed only if it is needed
-    return (((xp2 > 0.0)?((xp1 > 0.0)?((x > 0.0)?((xm1 > 0.0)?
-                                                  -4.0 * xm1*xm1*xm1:0.0) +
-                                       6.0 * x*x*x:0.0) +
+    const int* panSrcOffset = psRow->panSrcOffset;
+    const double* padfDeltaX = psRow->padfDeltaX;
+    const double* padfDeltaY = psRow->padfDeltaY;
+    int i = 0;
+
+#ifdef HAVE_SSE2_WARP_KERNELS
+    const __m128d xmm_one = _mm_set1_pd( 1.0 );
+
+    for( ; i + 1 < psRow->nCount; i += 2 )
+    {
+        const T* pSrc0 = pSrc + panSrcOffset[i];
+        const T* pSrc1 = pSrc + panSrcOffset[i + 1];
+        const __m128d xmm_dx = _mm_loadu_pd( padfDeltaX + i );
+        const __m128d xmm_dy = _mm_loadu_pd( padfDeltaY + i );
+        const __m128d xmm_dy_top = _mm_sub_pd( xmm_one, xmm_dy );
+
+        /* Left and right columns of each pixel, blended vertically */
+        const __m128d xmm_cols0 = _mm_add_pd(
+            _mm_mul_pd( GWKLoad2Samples( pSrc0 ),
+                        _mm_unpacklo_pd( xmm_dy_top, xmm_dy_top ) ),
+            _mm_mul_pd( GWKLoad2Samples( pSrc0 + nSrcXSize ),
+                        _mm_unpacklo_pd( xmm_dy, xmm_dy ) ) );
+        const __m128d xmm_cols1 = _mm_add_pd(
+            _mm_mul_pd( GWKLoad2Samples( pSrc1 ),
+                        _mm_unpackhi_pd( xmm_dy_top, xmm_dy_top ) ),
+            _mm_mul_pd( GWKLoad2Samples( pSrc1 + nSrcXSize ),
+                        _mm_unpackhi_pd( xmm_dy, xmm_dy ) ) );
+
+        /* Left columns of both pixels, then right columns */
+        const __m128d xmm_value = _mm_add_pd(
+            _mm_mul_pd( _mm_unpacklo_pd( xmm_cols0, xmm_cols1 ),
+                        _mm_sub_pd( xmm_one, xmm_dx ) ),
+            _mm_mul_pd( _mm_unpackhi_pd( xmm_cols0, xmm_cols1 ), xmm_dx ) );
+
+        double adfValue[2];
+        _mm_storeu_pd( adfValue, xmm_value );
+        GWKStoreValueT( pDstLine + psRow->panDstX[i], adfValue[0],
+                        pdfDstNoData );
+        GWKStoreValueT( pDstLine + psRow->panDstX[i + 1], adfValue[1],
+                        pdfDstNoData );
+    }
+#endif
+
+    /* Same operations, in the same order, one pixel at a time */
+    for( ; i < psRow->nCount; i++ )
+    {
+        const T* pSrcPixel = pSrc + panSrcOffset[i];
+        const double dfDeltaX = padfDeltaX[i];
+        const double dfDeltaY = padfDeltaY[i];
+        const double dfLeft = (double)pSrcPixel[0] * (1.0 - dfDeltaY)
+            + (double)pSrcPixel[nSrcXSize] * dfDeltaY;
+        const double dfRight = (double)pSrcPixel[1] * (1.0 - dfDeltaY)
+            + (double)pSrcPixel[nSrcXSize + 1] * dfDeltaY;
+
+        GWKStoreValueT( pDstLine + psRow->panDstX[i],
+                        dfLeft * (1.0 - dfDeltaX) + dfRight * dfDeltaX,
+                        pdfDstNoData );
+    }
+}
+
+/************************************************************************/
+/*                    GWKCubicResampleRowNoMasksT()                     */
+/*                                                                      */
+/*      Cubic convolution of the pixels of a scanline whose 4x4         */
+/*      neighbourhood is inside the source window. With SSE2, 2         */
+/*      destination pixels are computed per iteration: their weights    */
+/*      are evaluated together, each row of a neighbourhood is a        */
+/*      single 4 sample load, the rows are combined per pixel, and the  */
+/*      4 columns of both pixels are then combined together.            */
+/************************************************************************/
+
+template<class T>
+static void GWKCubicResampleRowNoMasksT( const T* pSrc, int nSrcXSize,
+                                         const GWKResampleRowStruct* psRow,
+                                         T* pDstLine,
+                                         const double* pdfDstNoData )
+
+{
+    const int* panSrcOffset = psRow->panSrcOffset;
+    int i = 0;
+
+#ifdef HAVE_SSE2_WARP_KERNELS
+    for( ; i + 1 < psRow->nCount; i += 2 )
+    {
+        const T* pSrc0 = pSrc + panSrcOffset[i];
+        const T* pSrc1 = pSrc + panSrcOffset[i + 1];
+        __m128d axmm_wx[4], axmm_wy[4];
+
+        GWKCubicComputeWeights( _mm_loadu_pd( psRow->padfDeltaX + i ),
+                                axmm_wx );
+        GWKCubicComputeWeights( _mm_loadu_pd( psRow->padfDeltaY + i ),
+                                axmm_wy );
+
+        /* Columns 0-1 and 2-3 of each pixel, combined vertically */
+        __m128d xmm_cols01_0 = _mm_setzero_pd();
+        __m128d xmm_cols23_0 = _mm_setzero_pd();
+        __m128d xmm_cols01_1 = _mm_setzero_pd();
+        __m128d xmm_cols23_1 = _mm_setzero_pd();
+
+        for( int j = 0; j < 4; j++ )
+        {
+            const __m128d xmm_wy0 = _mm_unpacklo_pd( axmm_wy[j], axmm_wy[j] );
+            const __m128d xmm_wy1 = _mm_unpackhi_pd( axmm_wy[j], axmm_wy[j] );
+            __m128d xmm_lo, xmm_hi;
+
+            GWKLoad4Samples( pSrc0 + j * nSrcXSize, xmm_lo, xmm_hi );
+            xmm_cols01_0 = _mm_add_pd( xmm_cols01_0,
+                                       _mm_mul_pd( xmm_lo, xmm_wy0 ) );
+            xmm_cols23_0 = _mm_add_pd( xmm_cols23_0,
+                                       _mm_mul_pd( xmm_hi, xmm_wy0 ) );
+
+            GWKLoad4Samples( pSrc1 + j * nSrcXSize, xmm_lo, xmm_hi );
+            xmm_cols01_1 = _mm_add_pd( xmm_cols01_1,
+                                       _mm_mul_pd( xmm_lo, xmm_wy1 ) );
+            xmm_cols23_1 = _mm_add_pd( xmm_cols23_1,
+                                       _mm_mul_pd( xmm_hi, xmm_wy1 ) );
+        }
+
+        /* Column k of both pixels, weighted by their k-th weight */
+        __m128d xmm_value =
+            _mm_mul_pd( _mm_unpacklo_pd( xmm_cols01_0, xmm_cols01_1 ),
+                        axmm_wx[0] );
+        xmm_value = _mm_add_pd( xmm_value,
+            _mm_mul_pd( _mm_unpackhi_pd( xmm_cols01_0, xmm_cols01_1 ),
+                        axmm_wx[1] ) );
+        xmm_value = _mm_add_pd( xmm_value,
+            _mm_mul_pd( _mm_unpacklo_pd( xmm_cols23_0, xmm_cols23_1 ),
+                        axmm_wx[2] ) );
+        xmm_value = _mm_add_pd( xmm_value,
+            _mm_mul_pd( _mm_unpackhi_pd( xmm_cols23_0, xmm_cols23_1 ),
+                        axmm_wx[3] ) );
+
+        double adfValue[2];
+        _mm_storeu_pd( adfValue, xmm_value );
+        GWKStoreValueT( pDstLine + psRow->panDstX[i], adfValue[0],
+                        pdfDstNoData );
+        GWKStoreValueT( pDstLine + psRow->panDstX[i + 1], adfValue[1],
+                        pdfDstNoData );
+    }
+#endif
+
+    /* Same operations, in the same order, one pixel at a time */
+    for( ; i < psRow->nCount; i++ )
+    {
+        const T* pSrcPixel = pSrc + panSrcOffset[i];
+        double adfWeightsX[4], adfWeightsY[4], adfCols[4];
+
+        GWKCubicComputeWeights( psRow->padfDeltaX[i], adfWeightsX );
+        GWKCubicComputeWeights( psRow->padfDeltaY[i], adfWeightsY );
+
+        for( int k = 0; k < 4; k++ )
+        {
+            adfCols[k] = 0.0;
+            for( int j = 0; j < 4; j++ )
+                adfCols[k] += (double)pSrcPixel[j * nSrcXSize + k]
+                    * adfWeightsY[j];
+        }
+
+        GWKStoreValueT( pDstLine + psRow->panDstX[i],
+                        adfCols[0] * adfWeightsX[0]
+                        + adfCols[1] * adfWeightsX[1]
+                        + adfCols[2] * adfWeightsX[2]
+                        + adfCols[3] * adfWeightsX[3],
+                        pdfDstNoData );
+    }
+}
+
+/************************************************************************/
+/*                          GWKLanczosSinc()                            */
+/************************************************************************/
+
+/*
+ * Lanczos windowed sinc interpolation kernel with radius r.
+ *        /
+ *        | sinc(x) * sinc(x/r), if |x| < r
+ * L(x) = | 1, if x = 0                     ,
+ *        | 0, otherwise
+ *        \
+ *
+ * where sinc(x) = sin(PI * x) / (PI * x).
+ */
+
+#define GWK_PI 3.14159265358979323846
+
+static double GWKLanczosSinc( double dfX, double dfR )
+{
+    if ( dfX == 0.0 )
+        return 1.0;
+
+    const double dfPIX = GWK_PI * dfX;
+    const double dfPIXoverR = dfPIX / dfR;
+    const double dfPIX2overR = dfPIX * dfPIXoverR;
+    return sin(dfPIX) * sin(dfPIXoverR) / dfPIX2overR;
+}
+
+//#undef GWK_PI
+
+/************************************************************************/
+/*                           GWKBSpline()                               */
+/************************************************************************/
+
+static double GWKBSpline( double x )
+{
+    double xp2 = x + 2.0;
+    double xp1 = x + 1.0;
+    double xm1 = x - 1.0;
+    
+    // This will most likely be used, so we'll compute it ahead of time to
+    // avoid stalling the processor
+    double xp2c = xp2 * xp2 * xp2;
+    
+    // Note that the test is computed only if it is needed
+    return (((xp2 > 0.0)?((xp1 > 0.0)?((x > 0.0)?((xm1 > 0.0)?
+                                                  -4.0 * xm1*xm1*xm1:0.0) +
+                                       6.0 * x*x*x:0.0) +
                           -4.0 * xp1*xp1*xp1:0.0) +
              xp2c:0.0) ) * 0.166666666666666666666;
 }
@@ -2868,7 +3192,7 @@ static int GWKCubicSplineResampleNoMasksByte( GDALWarpKernel *poWK, int iBand,
     // Politely refusing to process invalid coordinates or obscenely small image
     if ( iSrcX >= nSrcXSize || iSrcY >= nSrcYSize
          || nXRadius > nSrcXSize || nYRadius > nSrcYSize )
-        return GWKBilinearResampleNoMasksByte( poWK, iBand, dfSrcX, dfSrcY, pbValue);
+        return GWKBilinearResampleNoMasksT( poWK, iBand, dfSrcX, dfSrcY, pbValue);
 
     // Loop over all rows in the kernel
     int     j, jC;
@@ -2957,7 +3281,7 @@ static int GWKCubicSplineResampleNoMasksShort( GDALWarpKernel *poWK, int iBand,
     // Politely refusing to process invalid coordinates or obscenely small image
     if ( iSrcX >= nSrcXSize || iSrcY >= nSrcYSize
          || nXRadius > nSrcXSize || nYRadius > nSrcYSize )
-        return GWKBilinearResampleNoMasksShort( poWK, iBand, dfSrcX, dfSrcY, piValue);
+        return GWKBilinearResampleNoMasksT( poWK, iBand, dfSrcX, dfSrcY, piValue);
 
     // Loop over all pixels in the kernel
     int     j, jC;
@@ -3557,21 +3881,18 @@ static void GWKGeneralCaseThread( void* pData)
 }
 
 /************************************************************************/
-/*                       GWKNearestNoMasksByte()                        */
+/*                      GWKNearestNoMasksThread()                       */
 /*                                                                      */
-/*      Case for 8bit input data with nearest neighbour resampling      */
-/*      without concerning about masking. Should be as fast as          */
-/*      possible for this particular transformation type.               */
+/*      Nearest neighbour resampling without concerning about masking.  */
+/*      The source offsets of a scanline are computed once, then each   */
+/*      band is copied along the scanline. There is no arithmetic to    */
+/*      vectorize: without a gather instruction, the copy is a scalar   */
+/*      load and store per pixel.                                       */
 /************************************************************************/
 
-static void GWKNearestNoMasksByteThread(void* pData);
-
-static CPLErr GWKNearestNoMasksByte( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKNearestNoMasksByte", GWKNearestNoMasksByteThread );
-}
+template<class T>
+static void GWKNearestNoMasksThread( void* pData )
 
-static void GWKNearestNoMasksByteThread(void* pData)
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
     GDALWarpKernel *poWK = psJob->poWK;
@@ -3588,11 +3909,14 @@ static void GWKNearestNoMasksByteThread(void* pData)
 /* -------------------------------------------------------------------- */
     double *padfX, *padfY, *padfZ;
     int    *pabSuccess;
+    int    *panDstX, *panSrcOffset;
 
     padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    panDstX = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    panSrcOffset = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
@@ -3600,6 +3924,7 @@ static void GWKNearestNoMasksByteThread(void* pData)
     for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
     {
         int iDstX;
+        int nCount = 0;
 
 /* -------------------------------------------------------------------- */
 /*      Setup points to transform to source image space.                */
@@ -3618,26 +3943,31 @@ static void GWKNearestNoMasksByteThread(void* pData)
         poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
                               padfX, padfY, padfZ, pabSuccess );
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
+/* -------------------------------------------------------------------- */
+/*      Collect the pixels of the scanline that have a source pixel.    */
+/* -------------------------------------------------------------------- */
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
             COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
 
+            panDstX[nCount] = iDstX;
+            panSrcOffset[nCount] = iSrcOffset;
+            nCount ++;
+        }
+
 /* ==================================================================== */
 /*      Loop processing each band.                                      */
 /* ==================================================================== */
-            int iBand;
-            int iDstOffset;
+        int iBand;
 
-            iDstOffset = iDstX + iDstY * nDstXSize;
+        for( iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc = (const T *) poWK->papabySrcImage[iBand];
+            T* pDstLine = ((T *) poWK->papabyDstImage[iBand])
+                + iDstY * nDstXSize;
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                poWK->papabyDstImage[iBand][iDstOffset] = 
-                    poWK->papabySrcImage[iBand][iSrcOffset];
-            }
+            for( int i = 0; i < nCount; i++ )
+                pDstLine[panDstX[i]] = pSrc[panSrcOffset[i]];
         }
 
 /* -------------------------------------------------------------------- */
@@ -3654,24 +3984,93 @@ static void GWKNearestNoMasksByteThread(void* pData)
     CPLFree( padfY );
     CPLFree( padfZ );
     CPLFree( pabSuccess );
+    CPLFree( panDstX );
+    CPLFree( panSrcOffset );
 }
 
 /************************************************************************/
-/*                       GWKBilinearNoMasksByte()                       */
+/*                       GWKNearestNoMasksByte()                        */
 /*                                                                      */
-/*      Case for 8bit input data with bilinear resampling without       */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for 8bit input data with nearest neighbour resampling      */
+/*      without concerning about masking. Should be as fast as          */
+/*      possible for this particular transformation type.               */
+/************************************************************************/
+
+static CPLErr GWKNearestNoMasksByte( GDALWarpKernel *poWK )
+{
+    return GWKRun( poWK, "GWKNearestNoMasksByte", GWKNearestNoMasksThread<GByte> );
+}
+
 /************************************************************************/
+/*                    GWKResampleBandValidPixel()                       */
+/*                                                                      */
+/*      Resample a pixel whose neighbourhood has invalid source         */
+/*      samples, the same way as GWKGeneralCase(). Return TRUE if the   */
+/*      destination pixel was written.                                  */
+/************************************************************************/
+
+static int GWKResampleBandValidPixel( GDALWarpKernel *poWK, int iBand,
+                                      double dfSrcX, double dfSrcY,
+                                      int iSrcOffset, int iDstOffset )
+
+{
+    double dfBandDensity = 0.0;
+    double dfValueReal = 0.0;
+    double dfValueImag = 0.0;
+
+    if( poWK->nSrcXSize == 1 || poWK->nSrcYSize == 1 )
+        GWKGetPixelValue( poWK, iBand, iSrcOffset,
+                          &dfBandDensity, &dfValueReal, &dfValueImag );
+    else if( poWK->eResample == GRA_Bilinear )
+        GWKBilinearResample( poWK, iBand, dfSrcX, dfSrcY,
+                             &dfBandDensity, &dfValueReal, &dfValueImag );
+    else
+        GWKCubicResample( poWK, iBand, dfSrcX, dfSrcY,
+                          &dfBandDensity, &dfValueReal, &dfValueImag );
+
+    if( dfBandDensity < 0.0000000001 )
+        return FALSE;
+
+    GWKSetPixelValue( poWK, iBand, iDstOffset,
+                      dfBandDensity, dfValueReal, dfValueImag );
+
+    return TRUE;
+}
 
-static void GWKBilinearNoMasksByteThread(void* pData);
+/************************************************************************/
+/*                     GWKAreSrcSamplesValid()                          */
+/*                                                                      */
+/*      Check that nCount (at most 4) consecutive samples are set in a  */
+/*      validity mask.                                                  */
+/************************************************************************/
 
-static CPLErr GWKBilinearNoMasksByte( GDALWarpKernel *poWK )
+static inline int GWKAreSrcSamplesValid( const GUInt32* panValid,
+                                         int iOffset, int nCount )
 {
-    return GWKRun( poWK, "GWKBilinearNoMasksByte", GWKBilinearNoMasksByteThread );
+    const GUInt32 nAllSet = (1U << nCount) - 1;
+    const int iBit = iOffset & 0x1f;
+    GUInt32 nBits = panValid[iOffset >> 5] >> iBit;
+
+    if( iBit + nCount > 32 )
+        nBits |= panValid[(iOffset >> 5) + 1] << (32 - iBit);
+
+    return (nBits & nAllSet) == nAllSet;
 }
 
-static void GWKBilinearNoMasksByteThread(void* pData)
+/************************************************************************/
+/*              GWKResampleNoMasksOrBandValidOnlyThread()               */
+/*                                                                      */
+/*      Bilinear or cubic resampling of real data, without any mask or  */
+/*      with per band source validity masks (source nodata values),     */
+/*      and optionally a destination validity mask (destination         */
+/*      nodata values). Each scanline is split between the pixels       */
+/*      whose neighbourhood is inside the source window and valid,      */
+/*      which go through the row kernels, and the others.               */
+/************************************************************************/
+
+template<class T, GDALResampleAlg eResample>
+static void GWKResampleNoMasksOrBandValidOnlyThread( void* pData )
+
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
     GDALWarpKernel *poWK = psJob->poWK;
@@ -3682,6 +4081,10 @@ static void GWKBilinearNoMasksByteThread(void* pData)
     int nDstXSize = poWK->nDstXSize;
     int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
 
+    /* Size of the neighbourhood, and position of the resampled pixel in it */
+    const int nKernelSize = ( eResample == GRA_Bilinear ) ? 2 : 4;
+    const int nKernelBefore = ( eResample == GRA_Bilinear ) ? 0 : 1;
+
 /* -------------------------------------------------------------------- */
 /*      Allocate x,y,z coordinate arrays for transformation ... one     */
 /*      scanlines worth of positions.                                   */
@@ -3694,12 +4097,26 @@ static void GWKBilinearNoMasksByteThread(void* pData)
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
+/* -------------------------------------------------------------------- */
+/*      Pixels of a scanline going through the row kernels, the subset  */
+/*      of them that is valid in the current band, and the other        */
+/*      pixels with the nearest source sample.                          */
+/* -------------------------------------------------------------------- */
+    GWKResampleRowStruct sRow, sBandRow;
+    int *panBorderDstX, *panBorderSrcOffset;
+
+    GWKResampleRowAlloc( &sRow, nDstXSize );
+    GWKResampleRowAlloc( &sBandRow, nDstXSize );
+    panBorderDstX = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+    panBorderSrcOffset = (int *) CPLMalloc(sizeof(int) * nDstXSize);
+
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
     for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
     {
         int iDstX;
+        int nBorderCount = 0;
 
 /* -------------------------------------------------------------------- */
 /*      Setup points to transform to source image space.                */
@@ -3718,27 +4135,165 @@ static void GWKBilinearNoMasksByteThread(void* pData)
         poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
                               padfX, padfY, padfZ, pabSuccess );
 
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
+/* -------------------------------------------------------------------- */
+/*      Sort the pixels of the scanline.                                */
+/* -------------------------------------------------------------------- */
+        sRow.nCount = 0;
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
             COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
 
+            double dfSrcX = padfX[iDstX] - poWK->nSrcXOff;
+            double dfSrcY = padfY[iDstX] - poWK->nSrcYOff;
+            int iKernelX, iKernelY;
+
+            padfX[iDstX] = dfSrcX;
+            padfY[iDstX] = dfSrcY;
+
+            if( eResample == GRA_Bilinear )
+            {
+                iKernelX = (int) floor(dfSrcX - 0.5);
+                iKernelY = (int) floor(dfSrcY - 0.5);
+            }
+            else
+            {
+                iKernelX = (int) (dfSrcX - 0.5);
+                iKernelY = (int) (dfSrcY - 0.5);
+            }
+
+            if( iKernelX - nKernelBefore >= 0
+                && iKernelX - nKernelBefore + nKernelSize <= nSrcXSize
+                && iKernelY - nKernelBefore >= 0
+                && iKernelY - nKernelBefore + nKernelSize <= nSrcYSize )
+            {
+                sRow.panDstX[sRow.nCount] = iDstX;
+                sRow.panSrcOffset[sRow.nCount] = iKernelX - nKernelBefore
+                    + (iKernelY - nKernelBefore) * nSrcXSize;
+                sRow.padfDeltaX[sRow.nCount] = dfSrcX - 0.5 - iKernelX;
+                sRow.padfDeltaY[sRow.nCount] = dfSrcY - 0.5 - iKernelY;
+                sRow.nCount ++;
+            }
+            else
+            {
+                panBorderDstX[nBorderCount] = iDstX;
+                panBorderSrcOffset[nBorderCount] = iSrcOffset;
+                nBorderCount ++;
+            }
+        }
+
 /* ==================================================================== */
 /*      Loop processing each band.                                      */
 /* ==================================================================== */
-            int iBand;
-            int iDstOffset;
+        int iBand;
+        int i;
 
-            iDstOffset = iDstX + iDstY * nDstXSize;
+        for( iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc = (const T *) poWK->papabySrcImage[iBand];
+            T* pDstLine = ((T *) poWK->papabyDstImage[iBand])
+                + iDstY * nDstXSize;
+            const GUInt32* panSrcValid = ( poWK->papanBandSrcValid != NULL ) ?
+                poWK->papanBandSrcValid[iBand] : NULL;
+            const double* pdfDstNoData = ( poWK->padfDstNoDataReal != NULL ) ?
+                poWK->padfDstNoDataReal + iBand : NULL;
+            const GWKResampleRowStruct* psRow = &sRow;
 
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
+/* -------------------------------------------------------------------- */
+/*      Pixels with an invalid sample in their neighbourhood go         */
+/*      through the general resampling.                                 */
+/* -------------------------------------------------------------------- */
+            if( panSrcValid != NULL )
+            {
+                sBandRow.nCount = 0;
+                for( i = 0; i < sRow.nCount; i++ )
+                {
+                    int j;
+
+                    for( j = 0; j < nKernelSize; j++ )
+                    {
+                        if( !GWKAreSrcSamplesValid( panSrcValid,
+                                    sRow.panSrcOffset[i] + j * nSrcXSize,
+                                    nKernelSize ) )
+                            break;
+                    }
+
+                    iDstX = sRow.panDstX[i];
+                    if( j == nKernelSize )
+                    {
+                        sBandRow.panDstX[sBandRow.nCount] = iDstX;
+                        sBandRow.panSrcOffset[sBandRow.nCount] =
+                            sRow.panSrcOffset[i];
+                        sBandRow.padfDeltaX[sBandRow.nCount] =
+                            sRow.padfDeltaX[i];
+                        sBandRow.padfDeltaY[sBandRow.nCount] =
+                            sRow.padfDeltaY[i];
+                        sBandRow.nCount ++;
+                    }
+                    else if( GWKResampleBandValidPixel( poWK, iBand,
+                                                padfX[iDstX], padfY[iDstX], 0,
+                                                iDstX + iDstY * nDstXSize )
+                             && poWK->panDstValid != NULL )
+                    {
+                        int iDstOffset = iDstX + iDstY * nDstXSize;
+                        poWK->panDstValid[iDstOffset>>5] |=
+                            0x01 << (iDstOffset & 0x1f);
+                    }
+                }
+                psRow = &sBandRow;
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Row kernels.                                                    */
+/* -------------------------------------------------------------------- */
+            if( eResample == GRA_Bilinear )
+                GWKBilinearResampleRowNoMasksT( pSrc, nSrcXSize, psRow,
+                                                pDstLine, pdfDstNoData );
+            else
+                GWKCubicResampleRowNoMasksT( pSrc, nSrcXSize, psRow,
+                                             pDstLine, pdfDstNoData );
+
+            if( poWK->panDstValid != NULL )
+            {
+                for( i = 0; i < psRow->nCount; i++ )
+                {
+                    int iDstOffset = psRow->panDstX[i] + iDstY * nDstXSize;
+                    poWK->panDstValid[iDstOffset>>5] |=
+                        0x01 << (iDstOffset & 0x1f);
+                }
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Pixels on the border of the source window. Cubic resampling     */
+/*      falls back to bilinear there.                                   */
+/* -------------------------------------------------------------------- */
+            for( i = 0; i < nBorderCount; i++ )
             {
-                GWKBilinearResampleNoMasksByte( poWK, iBand,
-                                                padfX[iDstX]-poWK->nSrcXOff,
-                                                padfY[iDstX]-poWK->nSrcYOff,
-                                                &poWK->papabyDstImage[iBand][iDstOffset] );
+                int iDstOffset;
+                int bWritten;
+
+                iDstX = panBorderDstX[i];
+                iDstOffset = iDstX + iDstY * nDstXSize;
+
+                if( panSrcValid != NULL )
+                    bWritten = GWKResampleBandValidPixel( poWK, iBand,
+                                                padfX[iDstX], padfY[iDstX],
+                                                panBorderSrcOffset[i],
+                                                iDstOffset );
+                else
+                {
+                    T value;
+                    bWritten = GWKBilinearResampleNoMasksT( poWK, iBand,
+                                                            padfX[iDstX],
+                                                            padfY[iDstX],
+                                                            &value );
+                    if( bWritten )
+                        pDstLine[iDstX] = ( pdfDstNoData != NULL ) ?
+                            GWKAvoidNoDataT<T>( value, *pdfDstNoData ) : value;
+                }
+
+                if( bWritten && poWK->panDstValid != NULL )
+                    poWK->panDstValid[iDstOffset>>5] |=
+                        0x01 << (iDstOffset & 0x1f);
             }
         }
 
@@ -3756,24 +4311,58 @@ static void GWKBilinearNoMasksByteThread(void* pData)
     CPLFree( padfY );
     CPLFree( padfZ );
     CPLFree( pabSuccess );
+    GWKResampleRowFree( &sRow );
+    GWKResampleRowFree( &sBandRow );
+    CPLFree( panBorderDstX );
+    CPLFree( panBorderSrcOffset );
+}
+
+/************************************************************************/
+/*               GWKBilinearNoMasksOrBandValidOnlyByte()                */
+/*                                                                      */
+/*      Case for 8bit input data with bilinear resampling               */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
+/************************************************************************/
+
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyByte( GDALWarpKernel *poWK )
+{
+    return GWKRun( poWK, "GWKBilinearNoMasksOrBandValidOnlyByte",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GByte,
+                                                           GRA_Bilinear> );
+}
+
+/************************************************************************/
+/*                 GWKCubicNoMasksOrBandValidOnlyByte()                 */
+/*                                                                      */
+/*      Case for 8bit input data with cubic resampling                  */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
+/************************************************************************/
+
+static CPLErr GWKCubicNoMasksOrBandValidOnlyByte( GDALWarpKernel *poWK )
+{
+    return GWKRun( poWK, "GWKCubicNoMasksOrBandValidOnlyByte",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GByte,
+                                                           GRA_Cubic> );
 }
 
 /************************************************************************/
-/*                       GWKCubicNoMasksByte()                          */
+/*                   GWKCubicSplineNoMasksByte()                        */
 /*                                                                      */
-/*      Case for 8bit input data with cubic resampling without          */
+/*      Case for 8bit input data with cubic spline resampling without   */
 /*      concerning about masking. Should be as fast as possible         */
 /*      for this particular transformation type.                        */
 /************************************************************************/
 
-static void GWKCubicNoMasksByteThread(void* pData);
+static void GWKCubicSplineNoMasksByteThread(void* pData);
 
-static CPLErr GWKCubicNoMasksByte( GDALWarpKernel *poWK )
+static CPLErr GWKCubicSplineNoMasksByte( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKCubicNoMasksByte", GWKCubicNoMasksByteThread );
+    return GWKRun( poWK, "GWKCubicSplineNoMasksByte", GWKCubicSplineNoMasksByteThread );
 }
 
-static void GWKCubicNoMasksByteThread( void* pData )
+static void GWKCubicSplineNoMasksByteThread( void* pData )
 
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
@@ -3797,6 +4386,9 @@ static void GWKCubicNoMasksByteThread( void* pData )
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
+    int     nXRadius = poWK->nXRadius;
+    double  *padfBSpline = (double *)CPLCalloc( nXRadius * 2, sizeof(double) );
+
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
@@ -3838,10 +4430,11 @@ static void GWKCubicNoMasksByteThread( void* pData )
 
             for( iBand = 0; iBand < poWK->nBands; iBand++ )
             {
-                GWKCubicResampleNoMasksByte( poWK, iBand,
-                                             padfX[iDstX]-poWK->nSrcXOff,
-                                             padfY[iDstX]-poWK->nSrcYOff,
-                                             &poWK->papabyDstImage[iBand][iDstOffset] );
+                GWKCubicSplineResampleNoMasksByte( poWK, iBand,
+                                                   padfX[iDstX]-poWK->nSrcXOff,
+                                                   padfY[iDstX]-poWK->nSrcYOff,
+                                                   &poWK->papabyDstImage[iBand][iDstOffset],
+                                                   padfBSpline);
             }
         }
 
@@ -3859,24 +4452,25 @@ static void GWKCubicNoMasksByteThread( void* pData )
     CPLFree( padfY );
     CPLFree( padfZ );
     CPLFree( pabSuccess );
+    CPLFree( padfBSpline );
 }
 
 /************************************************************************/
-/*                   GWKCubicSplineNoMasksByte()                        */
+/*                          GWKNearestByte()                            */
 /*                                                                      */
-/*      Case for 8bit input data with cubic spline resampling without   */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for 8bit input data with nearest neighbour resampling      */
+/*      using valid flags. Should be as fast as possible for this       */
+/*      particular transformation type.                                 */
 /************************************************************************/
 
-static void GWKCubicSplineNoMasksByteThread(void* pData);
+static void GWKNearestByteThread(void* pData);
 
-static CPLErr GWKCubicSplineNoMasksByte( GDALWarpKernel *poWK )
+static CPLErr GWKNearestByte( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKCubicSplineNoMasksByte", GWKCubicSplineNoMasksByteThread );
+    return GWKRun( poWK, "GWKNearestByte", GWKNearestByteThread );
 }
 
-static void GWKCubicSplineNoMasksByteThread( void* pData )
+static void GWKNearestByteThread( void* pData )
 
 {
     GWKJobStruct* psJob = (GWKJobStruct*) pData;
@@ -3900,9 +4494,6 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
     padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
     pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
 
-    int     nXRadius = poWK->nXRadius;
-    double  *padfBSpline = (double *)CPLCalloc( nXRadius * 2, sizeof(double) );
-
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
@@ -3932,113 +4523,8 @@ static void GWKCubicSplineNoMasksByteThread( void* pData )
 /* ==================================================================== */
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GWKCubicSplineResampleNoMasksByte( poWK, iBand,
-                                                   padfX[iDstX]-poWK->nSrcXOff,
-                                                   padfY[iDstX]-poWK->nSrcYOff,
-                                                   &poWK->papabyDstImage[iBand][iDstOffset],
-                                                   padfBSpline);
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
-    CPLFree( padfBSpline );
-}
-
-/************************************************************************/
-/*                          GWKNearestByte()                            */
-/*                                                                      */
-/*      Case for 8bit input data with nearest neighbour resampling      */
-/*      using valid flags. Should be as fast as possible for this       */
-/*      particular transformation type.                                 */
-/************************************************************************/
-
-static void GWKNearestByteThread(void* pData);
-
-static CPLErr GWKNearestByte( GDALWarpKernel *poWK )
-{
-    return GWKRun( poWK, "GWKNearestByte", GWKNearestByteThread );
-}
-
-static void GWKNearestByteThread( void* pData )
-
-{
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            int iDstOffset;
-
+            int iDstOffset;
+
             COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
 
 /* -------------------------------------------------------------------- */
@@ -4135,308 +4621,69 @@ static void GWKNearestByteThread( void* pData )
 /*      transformation type.                                            */
 /************************************************************************/
 
-static void GWKNearestNoMasksShortThread(void* pData);
-
 static CPLErr GWKNearestNoMasksShort( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKNearestNoMasksShort", GWKNearestNoMasksShortThread );
-}
-
-static void GWKNearestNoMasksShortThread( void* pData )
-
-{
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            int iDstOffset;
-
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = 
-                    ((GInt16 *)poWK->papabySrcImage[iBand])[iSrcOffset];
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    return GWKRun( poWK, "GWKNearestNoMasksShort", GWKNearestNoMasksThread<GInt16> );
 }
 
 /************************************************************************/
-/*                       GWKBilinearNoMasksShort()                      */
+/*               GWKBilinearNoMasksOrBandValidOnlyShort()               */
 /*                                                                      */
-/*      Case for 16bit input data with cubic resampling without         */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for 16bit signed input data with bilinear resampling       */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
 /************************************************************************/
 
-static void GWKBilinearNoMasksShortThread(void* pData);
-
-static CPLErr GWKBilinearNoMasksShort( GDALWarpKernel *poWK )
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyShort( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKBilinearNoMasksShort", GWKBilinearNoMasksShortThread );
+    return GWKRun( poWK, "GWKBilinearNoMasksOrBandValidOnlyShort",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GInt16,
+                                                           GRA_Bilinear> );
 }
 
-static void GWKBilinearNoMasksShortThread( void* pData )
+/************************************************************************/
+/*                GWKCubicNoMasksOrBandValidOnlyShort()                 */
+/*                                                                      */
+/*      Case for 16bit signed input data with cubic resampling          */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
+/************************************************************************/
 
+static CPLErr GWKCubicNoMasksOrBandValidOnlyShort( GDALWarpKernel *poWK )
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                GWKBilinearResampleNoMasksShort( poWK, iBand,
-                                                 padfX[iDstX]-poWK->nSrcXOff,
-                                                 padfY[iDstX]-poWK->nSrcYOff,
-                                                 &iValue );
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    return GWKRun( poWK, "GWKCubicNoMasksOrBandValidOnlyShort",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GInt16,
+                                                           GRA_Cubic> );
 }
 
 /************************************************************************/
-/*                       GWKCubicNoMasksShort()                         */
+/*              GWKBilinearNoMasksOrBandValidOnlyUShort()               */
 /*                                                                      */
-/*      Case for 16bit input data with cubic resampling without         */
-/*      concerning about masking. Should be as fast as possible         */
-/*      for this particular transformation type.                        */
+/*      Case for unsigned 16bit input data with bilinear resampling     */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
 /************************************************************************/
 
-static void GWKCubicNoMasksShortThread(void* pData);
-
-static CPLErr GWKCubicNoMasksShort( GDALWarpKernel *poWK )
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyUShort( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKCubicNoMasksShort", GWKCubicNoMasksShortThread );
+    return GWKRun( poWK, "GWKBilinearNoMasksOrBandValidOnlyUShort",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GUInt16,
+                                                           GRA_Bilinear> );
 }
 
-static void GWKCubicNoMasksShortThread( void* pData )
+/************************************************************************/
+/*                GWKCubicNoMasksOrBandValidOnlyUShort()                */
+/*                                                                      */
+/*      Case for unsigned 16bit input data with cubic resampling        */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
+/************************************************************************/
 
+static CPLErr GWKCubicNoMasksOrBandValidOnlyUShort( GDALWarpKernel *poWK )
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            int iDstOffset;
-
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                GInt16  iValue = 0;
-                GWKCubicResampleNoMasksShort( poWK, iBand,
-                                              padfX[iDstX]-poWK->nSrcXOff,
-                                              padfY[iDstX]-poWK->nSrcYOff,
-                                              &iValue );
-                ((GInt16 *)poWK->papabyDstImage[iBand])[iDstOffset] = iValue;
-            }
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+    return GWKRun( poWK, "GWKCubicNoMasksOrBandValidOnlyUShort",
+                   GWKResampleNoMasksOrBandValidOnlyThread<GUInt16,
+                                                           GRA_Cubic> );
 }
 
 /************************************************************************/
@@ -4707,105 +4954,46 @@ static void GWKNearestShortThread(void* pData)
 }
 
 /************************************************************************/
-/*                    GWKNearestNoMasksFloat()                          */
+/*               GWKBilinearNoMasksOrBandValidOnlyFloat()               */
 /*                                                                      */
-/*      Case for 32bit float input data with nearest neighbour          */
-/*      resampling without concerning about masking. Should be as fast  */
-/*      as possible for this particular transformation type.            */
+/*      Case for 32bit float input data with bilinear resampling        */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
 /************************************************************************/
 
-static void GWKNearestNoMasksFloatThread(void* pData);
-
-static CPLErr GWKNearestNoMasksFloat( GDALWarpKernel *poWK )
+static CPLErr GWKBilinearNoMasksOrBandValidOnlyFloat( GDALWarpKernel *poWK )
 {
-    return GWKRun( poWK, "GWKNearestNoMasksFloat", GWKNearestNoMasksFloatThread );
+    return GWKRun( poWK, "GWKBilinearNoMasksOrBandValidOnlyFloat",
+                   GWKResampleNoMasksOrBandValidOnlyThread<float,
+                                                           GRA_Bilinear> );
 }
 
-static void GWKNearestNoMasksFloatThread( void* pData )
+/************************************************************************/
+/*                GWKCubicNoMasksOrBandValidOnlyFloat()                 */
+/*                                                                      */
+/*      Case for 32bit float input data with cubic resampling           */
+/*      without concerning about masking, or with source and            */
+/*      destination nodata values only.                                 */
+/************************************************************************/
 
+static CPLErr GWKCubicNoMasksOrBandValidOnlyFloat( GDALWarpKernel *poWK )
 {
-    GWKJobStruct* psJob = (GWKJobStruct*) pData;
-    GDALWarpKernel *poWK = psJob->poWK;
-    int iYMin = psJob->iYMin;
-    int iYMax = psJob->iYMax;
-
-    int iDstY;
-    int nDstXSize = poWK->nDstXSize;
-    int nSrcXSize = poWK->nSrcXSize, nSrcYSize = poWK->nSrcYSize;
-
-/* -------------------------------------------------------------------- */
-/*      Allocate x,y,z coordinate arrays for transformation ... one     */
-/*      scanlines worth of positions.                                   */
-/* -------------------------------------------------------------------- */
-    double *padfX, *padfY, *padfZ;
-    int    *pabSuccess;
-
-    padfX = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfY = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    padfZ = (double *) CPLMalloc(sizeof(double) * nDstXSize);
-    pabSuccess = (int *) CPLMalloc(sizeof(int) * nDstXSize);
-
-/* ==================================================================== */
-/*      Loop over output lines.                                         */
-/* ==================================================================== */
-    for( iDstY = iYMin; iDstY < iYMax; iDstY++ )
-    {
-        int iDstX;
-
-/* -------------------------------------------------------------------- */
-/*      Setup points to transform to source image space.                */
-/* -------------------------------------------------------------------- */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            padfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
-            padfY[iDstX] = iDstY + 0.5 + poWK->nDstYOff;
-            padfZ[iDstX] = 0.0;
-        }
-
-/* -------------------------------------------------------------------- */
-/*      Transform the points from destination pixel/line coordinates    */
-/*      to source pixel/line coordinates.                               */
-/* -------------------------------------------------------------------- */
-        poWK->pfnTransformer( psJob->pTransformerArg, TRUE, nDstXSize,
-                              padfX, padfY, padfZ, pabSuccess );
-
-/* ==================================================================== */
-/*      Loop over pixels in output scanline.                            */
-/* ==================================================================== */
-        for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
-        {
-            int iDstOffset;
-
-            COMPUTE_iSrcOffset(pabSuccess, iDstX, padfX, padfY, poWK, nSrcXSize, nSrcYSize);
-
-/* ==================================================================== */
-/*      Loop processing each band.                                      */
-/* ==================================================================== */
-            int iBand;
-            
-            iDstOffset = iDstX + iDstY * nDstXSize;
-
-            for( iBand = 0; iBand < poWK->nBands; iBand++ )
-            {
-                ((float *)poWK->papabyDstImage[iBand])[iDstOffset] = 
-                    ((float *)poWK->papabySrcImage[iBand])[iSrcOffset];
-            }
-        }
+    return GWKRun( poWK, "GWKCubicNoMasksOrBandValidOnlyFloat",
+                   GWKResampleNoMasksOrBandValidOnlyThread<float,
+                                                           GRA_Cubic> );
+}
 
-/* -------------------------------------------------------------------- */
-/*      Report progress to the user, and optionally cancel out.         */
-/* -------------------------------------------------------------------- */
-        if (psJob->pfnProgress(psJob))
-            break;
-    }
+/************************************************************************/
+/*                    GWKNearestNoMasksFloat()                          */
+/*                                                                      */
+/*      Case for 32bit float input data with nearest neighbour          */
+/*      resampling without concerning about masking. Should be as fast  */
+/*      as possible for this particular transformation type.            */
+/************************************************************************/
 
-/* -------------------------------------------------------------------- */
-/*      Cleanup and return.                                             */
-/* -------------------------------------------------------------------- */
-    CPLFree( padfX );
-    CPLFree( padfY );
-    CPLFree( padfZ );
-    CPLFree( pabSuccess );
+static CPLErr GWKNearestNoMasksFloat( GDALWarpKernel *poWK )
+{
+    return GWKRun( poWK, "GWKNearestNoMasksFloat", GWKNearestNoMasksThread<float> );
 }
 
 /************************************************************************/
@@ -535,6 +535,19 @@ CPLErr GDALWarpOperation::Initialize( const GDALWarpOptions *psNewOptions )
     bReportTimings = CSLFetchBoolean( psOptions->papszWarpOptions, 
                                       "REPORT_TIMINGS", FALSE );
 
+/* -------------------------------------------------------------------- */
+/*      If requested, with the approximating transformer, interpolate   */
+/*      within a grid of transformed points, computed once for the      */
+/*      whole destination window and shared by all chunks and threads.  */
+/* -------------------------------------------------------------------- */
+    if( psOptions->pfnTransformer == GDALApproxTransform 
+        && psOptions->pTransformerArg != NULL )
+    {
+        GDALApproxTransformerSetGridCache( psOptions->pTransformerArg,
+            atoi(CSLFetchNameValueDef( psOptions->papszWarpOptions,
+                                       "APPROX_GRID_CELL_SIZE", "0" )) );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Support creating cutline from text warpoption.                  */
 /* -------------------------------------------------------------------- */
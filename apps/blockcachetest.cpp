@@ -0,0 +1,284 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of the contention on the raster block cache when
+ *           several threads read through it.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+static int nMaxThreadCount = 8, nIterations = 10000, nWindowSize = 64;
+static const char *pszFilename = NULL;
+
+typedef struct
+{
+    int     nSeed;
+    int     bError;
+} WorkerInfo;
+
+static void WorkerFunc( void * );
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "blockcachetest [-t <max_thread#>] [-i <iterations>]\n"
+            "               [-w <window_size>] [-cachemax <megabytes>]\n"
+            "               [-shards <shard#>] [filename]\n"
+            "\n"
+            "Reads random windows of the first band of the file from 1 to\n"
+            "max_thread# threads, each thread using its own dataset handle,\n"
+            "and reports the throughput of the raster block cache.\n"
+            "If no file is specified, a tiled GeoTIFF is created in /vsimem.\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                          CreateTestFile()                            */
+/************************************************************************/
+
+static const char *CreateTestFile()
+
+{
+    const char *pszTestFilename = "/vsimem/blockcachetest.tif";
+    GDALDriverH hDriver = GDALGetDriverByName( "GTiff" );
+    if( hDriver == NULL )
+    {
+        printf( "GTiff driver not available.\n" );
+        exit( 1 );
+    }
+
+    char **papszOptions = NULL;
+    papszOptions = CSLSetNameValue( papszOptions, "TILED", "YES" );
+    papszOptions = CSLSetNameValue( papszOptions, "BLOCKXSIZE", "256" );
+    papszOptions = CSLSetNameValue( papszOptions, "BLOCKYSIZE", "256" );
+
+    const int nSize = 4096;
+    GDALDatasetH hDS = GDALCreate( hDriver, pszTestFilename, nSize, nSize, 1,
+                                   GDT_Byte, papszOptions );
+    CSLDestroy( papszOptions );
+    if( hDS == NULL )
+        exit( 1 );
+
+    GByte *pabyLine = (GByte *) CPLMalloc( nSize );
+    for( int iLine = 0; iLine < nSize; iLine++ )
+    {
+        for( int iPixel = 0; iPixel < nSize; iPixel++ )
+            pabyLine[iPixel] = (GByte) (iPixel + iLine);
+        GDALRasterIO( GDALGetRasterBand( hDS, 1 ), GF_Write,
+                      0, iLine, nSize, 1, pabyLine, nSize, 1, GDT_Byte, 0, 0 );
+    }
+    CPLFree( pabyLine );
+    GDALClose( hDS );
+
+    return pszTestFilename;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    int iArg;
+
+/* -------------------------------------------------------------------- */
+/*      Process arguments.                                              */
+/* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    GIntBig nCacheMax = 0;
+
+    for( iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-i") && iArg < argc-1 )
+            nIterations = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-t") && iArg < argc-1 )
+            nMaxThreadCount = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-w") && iArg < argc-1 )
+            nWindowSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-cachemax") && iArg < argc-1 )
+            nCacheMax = (GIntBig) atoi(argv[++iArg]) * 1024 * 1024;
+        else if( EQUAL(argv[iArg],"-shards") && iArg < argc-1 )
+            CPLSetConfigOption( "GDAL_CACHE_SHARDS", argv[++iArg] );
+        else if( pszFilename == NULL && argv[iArg][0] != '-' )
+            pszFilename = argv[iArg];
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+    }
+
+    if( nMaxThreadCount < 1 || nIterations < 1 || nWindowSize < 1 )
+        Usage();
+
+    GDALAllRegister();
+
+    if( nCacheMax > 0 )
+        GDALSetCacheMax64( nCacheMax );
+
+    if( pszFilename == NULL )
+        pszFilename = CreateTestFile();
+
+    GDALDatasetH hDS = GDALOpen( pszFilename, GA_ReadOnly );
+    if( hDS == NULL )
+        exit( 1 );
+    if( GDALGetRasterXSize( hDS ) < nWindowSize ||
+        GDALGetRasterYSize( hDS ) < nWindowSize )
+    {
+        printf( "Raster is smaller than the window size.\n" );
+        exit( 1 );
+    }
+    GDALClose( hDS );
+
+    printf( "Reading %d windows of %dx%d pixels per thread from %s, "
+            "cache max = " CPL_FRMT_GIB " bytes.\n",
+            nIterations, nWindowSize, nWindowSize, pszFilename,
+            GDALGetCacheMax64() );
+    printf( "threads  seconds  Mpixels/s  speedup\n" );
+
+/* -------------------------------------------------------------------- */
+/*      Run the workload with an increasing number of threads.          */
+/* -------------------------------------------------------------------- */
+    double dfSingleThreadThroughput = 0.0;
+    int nThreadCount = 1;
+
+    while( TRUE )
+    {
+        void **pahThreads = (void **) CPLCalloc( sizeof(void*), nThreadCount );
+        WorkerInfo *pasInfo = (WorkerInfo *)
+            CPLCalloc( sizeof(WorkerInfo), nThreadCount );
+
+        double dfStart = GetWallClockTime();
+
+        for( int iThread = 0; iThread < nThreadCount; iThread++ )
+        {
+            pasInfo[iThread].nSeed = iThread + 1;
+            pahThreads[iThread] =
+                CPLCreateJoinableThread( WorkerFunc, pasInfo + iThread );
+            if( pahThreads[iThread] == NULL )
+            {
+                printf( "CPLCreateJoinableThread() failed.\n" );
+                exit( 1 );
+            }
+        }
+
+        int bError = FALSE;
+        for( int iThread = 0; iThread < nThreadCount; iThread++ )
+        {
+            CPLJoinThread( pahThreads[iThread] );
+            bError |= pasInfo[iThread].bError;
+        }
+
+        double dfElapsed = GetWallClockTime() - dfStart;
+        if( dfElapsed <= 0.0 )
+            dfElapsed = 1e-6;
+
+        double dfThroughput = (double) nThreadCount * nIterations
+            * nWindowSize * nWindowSize / dfElapsed / 1e6;
+        if( nThreadCount == 1 )
+            dfSingleThreadThroughput = dfThroughput;
+
+        printf( "%7d  %7.3f  %9.1f  %7.2f%s\n",
+                nThreadCount, dfElapsed, dfThroughput,
+                dfThroughput / dfSingleThreadThroughput,
+                bError ? "  (read errors)" : "" );
+
+        CPLFree( pahThreads );
+        CPLFree( pasInfo );
+
+        if( nThreadCount == nMaxThreadCount )
+            break;
+        nThreadCount *= 2;
+        if( nThreadCount > nMaxThreadCount )
+            nThreadCount = nMaxThreadCount;
+    }
+
+    CSLDestroy( argv );
+
+    if( EQUALN(pszFilename, "/vsimem/", 8) )
+        VSIUnlink( pszFilename );
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
+
+/************************************************************************/
+/*                             WorkerFunc()                             */
+/************************************************************************/
+
+static void WorkerFunc( void *pData )
+
+{
+    WorkerInfo *psInfo = (WorkerInfo *) pData;
+
+    GDALDatasetH hDS = GDALOpen( pszFilename, GA_ReadOnly );
+    if( hDS == NULL )
+    {
+        psInfo->bError = TRUE;
+        return;
+    }
+
+    GDALRasterBandH hBand = GDALGetRasterBand( hDS, 1 );
+    int nXRange = GDALGetRasterXSize( hDS ) - nWindowSize + 1;
+    int nYRange = GDALGetRasterYSize( hDS ) - nWindowSize + 1;
+    GByte *pabyBuffer = (GByte *) CPLMalloc( nWindowSize * nWindowSize );
+
+    /* Simple LCG, so that each thread gets a reproducible sequence */
+    GUInt32 nState = (GUInt32) psInfo->nSeed;
+
+    for( int iIter = 0; iIter < nIterations; iIter++ )
+    {
+        nState = nState * 1103515245U + 12345U;
+        int nXOff = (int) ((nState >> 8) % (GUInt32) nXRange);
+        nState = nState * 1103515245U + 12345U;
+        int nYOff = (int) ((nState >> 8) % (GUInt32) nYRange);
+
+        if( GDALRasterIO( hBand, GF_Read, nXOff, nYOff,
+                          nWindowSize, nWindowSize,
+                          pabyBuffer, nWindowSize, nWindowSize,
+                          GDT_Byte, 0, 0 ) != CE_None )
+        {
+            psInfo->bError = TRUE;
+            break;
+        }
+    }
+
+    CPLFree( pabyBuffer );
+    GDALClose( hDS );
+}
@@ -31,6 +31,12 @@
 #include "cpl_string.h"
 #include "gdal.h"
 
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
 CPL_CVSID("$Id$");
 
 /* -------------------------------------------------------------------- */
@@ -125,3 +131,21 @@ void EarlySetConfigOptions( int argc, char ** argv )
         }
     }
 }
+
+/* -------------------------------------------------------------------- */
+/*                          GetWallClockTime()                          */
+/*                                                                      */
+/*      Return the current wall clock time in seconds, with the best    */
+/*      resolution available. Used to time the benchmark utilities.     */
+/* -------------------------------------------------------------------- */
+
+double GetWallClockTime( void )
+{
+#ifdef WIN32
+    return GetTickCount() / 1000.0;
+#else
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
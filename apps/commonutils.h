@@ -39,6 +39,8 @@ void CheckExtensionConsistency(const char* pszDestFilename,
 
 void EarlySetConfigOptions( int argc, char ** argv );
 
+double GetWallClockTime( void );
+
 CPL_C_END
 
 #endif
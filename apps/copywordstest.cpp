@@ -0,0 +1,251 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of GDALCopyWords() for all pairs of data types.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+static int nWordCount = 65536, nIterations = 1000, nStride = 3;
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "copywordstest [-n <word_count>] [-i <iterations>]\n"
+            "              [-stride <stride>] [-src <type>]* [-dst <type>]*\n"
+            "\n"
+            "Reports the throughput of GDALCopyWords() between packed buffers,\n"
+            "and between buffers whose words are separated by stride words,\n"
+            "for all pairs of source and destination data types, or the\n"
+            "specified ones. The packed and strided results are checked to\n"
+            "be identical.\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                            FillBuffer()                              */
+/*                                                                      */
+/*      Fill the source buffer with values covering the range of the    */
+/*      data type, and beyond the range of the smaller types.           */
+/************************************************************************/
+
+static void FillBuffer( GByte *pabyBuffer, GDALDataType eType )
+
+{
+    int nWordSize = GDALGetDataTypeSize( eType ) / 8;
+    GUInt32 nState = 1;
+
+    for( int i = 0; i < nWordCount; i++ )
+    {
+        nState = nState * 1103515245U + 12345U;
+        double dfValue = ((int) (nState >> 8) % 200000 - 100000) / 3.0;
+        double adfValue[2] = { dfValue, -dfValue };
+        GDALCopyWords( adfValue, GDT_CFloat64, 0,
+                       pabyBuffer + i * nWordSize, eType, 0, 1 );
+    }
+}
+
+/************************************************************************/
+/*                              Measure()                               */
+/*                                                                      */
+/*      Return the throughput in millions of words per second.          */
+/************************************************************************/
+
+static double Measure( GByte *pabySrc, GDALDataType eSrcType, int nSrcStride,
+                       GByte *pabyDst, GDALDataType eDstType, int nDstStride )
+
+{
+    double dfStart = GetWallClockTime();
+    for( int iIter = 0; iIter < nIterations; iIter++ )
+    {
+        GDALCopyWords( pabySrc, eSrcType, nSrcStride,
+                       pabyDst, eDstType, nDstStride, nWordCount );
+    }
+    double dfElapsed = GetWallClockTime() - dfStart;
+    if( dfElapsed <= 0.0 )
+        dfElapsed = 1e-6;
+    return (double) nWordCount * nIterations / dfElapsed / 1e6;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    int iArg;
+    int abSrcTypes[GDT_TypeCount];
+    int abDstTypes[GDT_TypeCount];
+    int bSrcTypeSpecified = FALSE, bDstTypeSpecified = FALSE;
+
+    memset( abSrcTypes, 0, sizeof(abSrcTypes) );
+    memset( abDstTypes, 0, sizeof(abDstTypes) );
+
+/* -------------------------------------------------------------------- */
+/*      Process arguments.                                              */
+/* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    for( iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-n") && iArg < argc-1 )
+            nWordCount = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-i") && iArg < argc-1 )
+            nIterations = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-stride") && iArg < argc-1 )
+            nStride = atoi(argv[++iArg]);
+        else if( (EQUAL(argv[iArg],"-src") || EQUAL(argv[iArg],"-dst")) &&
+                 iArg < argc-1 )
+        {
+            int bSrc = EQUAL(argv[iArg],"-src");
+            GDALDataType eType = GDALGetDataTypeByName( argv[++iArg] );
+            if( eType == GDT_Unknown )
+            {
+                printf( "Unknown data type: %s\n", argv[iArg] );
+                Usage();
+            }
+            if( bSrc )
+            {
+                abSrcTypes[eType] = TRUE;
+                bSrcTypeSpecified = TRUE;
+            }
+            else
+            {
+                abDstTypes[eType] = TRUE;
+                bDstTypeSpecified = TRUE;
+            }
+        }
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+    }
+
+    if( nWordCount < 1 || nIterations < 1 || nStride < 1 )
+        Usage();
+
+    for( int eType = GDT_Byte; eType < GDT_TypeCount; eType++ )
+    {
+        if( !bSrcTypeSpecified )
+            abSrcTypes[eType] = TRUE;
+        if( !bDstTypeSpecified )
+            abDstTypes[eType] = TRUE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Allocate buffers large enough for the strided case of the       */
+/*      largest data type.                                              */
+/* -------------------------------------------------------------------- */
+    size_t nBufferSize = (size_t) nWordCount * nStride * 16;
+    GByte *pabySrc = (GByte *) VSIMalloc( nBufferSize );
+    GByte *pabySrcStrided = (GByte *) VSIMalloc( nBufferSize );
+    GByte *pabyDst = (GByte *) VSIMalloc( nBufferSize );
+    GByte *pabyDstStrided = (GByte *) VSIMalloc( nBufferSize );
+    GByte *pabyDstCheck = (GByte *) VSIMalloc( nBufferSize );
+    if( pabySrc == NULL || pabySrcStrided == NULL || pabyDst == NULL ||
+        pabyDstStrided == NULL || pabyDstCheck == NULL )
+    {
+        printf( "Out of memory.\n" );
+        exit( 1 );
+    }
+
+    printf( "Copying %d words %d times, strided case with a stride of %d "
+            "words.\n", nWordCount, nIterations, nStride );
+    printf( "source    destination  packed Mwords/s  strided Mwords/s\n" );
+
+    int bMismatch = FALSE;
+    for( int eSrcType = GDT_Byte; eSrcType < GDT_TypeCount; eSrcType++ )
+    {
+        if( !abSrcTypes[eSrcType] )
+            continue;
+
+        int nSrcWordSize = GDALGetDataTypeSize( (GDALDataType) eSrcType ) / 8;
+        FillBuffer( pabySrc, (GDALDataType) eSrcType );
+        GDALCopyWords( pabySrc, (GDALDataType) eSrcType, nSrcWordSize,
+                       pabySrcStrided, (GDALDataType) eSrcType,
+                       nSrcWordSize * nStride, nWordCount );
+
+        for( int eDstType = GDT_Byte; eDstType < GDT_TypeCount; eDstType++ )
+        {
+            if( !abDstTypes[eDstType] )
+                continue;
+
+            int nDstWordSize =
+                GDALGetDataTypeSize( (GDALDataType) eDstType ) / 8;
+
+            double dfPacked =
+                Measure( pabySrc, (GDALDataType) eSrcType, nSrcWordSize,
+                         pabyDst, (GDALDataType) eDstType, nDstWordSize );
+            double dfStrided =
+                Measure( pabySrcStrided, (GDALDataType) eSrcType,
+                         nSrcWordSize * nStride,
+                         pabyDstStrided, (GDALDataType) eDstType,
+                         nDstWordSize * nStride );
+
+/* -------------------------------------------------------------------- */
+/*      The packed and strided cases take different code paths, so      */
+/*      check that they agree.                                          */
+/* -------------------------------------------------------------------- */
+            GDALCopyWords( pabyDstStrided, (GDALDataType) eDstType,
+                           nDstWordSize * nStride,
+                           pabyDstCheck, (GDALDataType) eDstType,
+                           nDstWordSize, nWordCount );
+            int bSame = memcmp( pabyDst, pabyDstCheck,
+                                (size_t) nWordCount * nDstWordSize ) == 0;
+            if( !bSame )
+                bMismatch = TRUE;
+
+            printf( "%-9s %-12s %15.1f  %16.1f%s\n",
+                    GDALGetDataTypeName( (GDALDataType) eSrcType ),
+                    GDALGetDataTypeName( (GDALDataType) eDstType ),
+                    dfPacked, dfStrided,
+                    bSame ? "" : "  (packed and strided results differ)" );
+        }
+    }
+
+    VSIFree( pabySrc );
+    VSIFree( pabySrcStrided );
+    VSIFree( pabyDst );
+    VSIFree( pabyDstStrided );
+    VSIFree( pabyDstCheck );
+
+    CSLDestroy( argv );
+
+    GDALDestroyDriverManager();
+
+    return bMismatch ? 1 : 0;
+}
@@ -0,0 +1,300 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of the multi-threaded decompression of tiled GeoTIFF
+ *           files (NUM_THREADS open option).
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_multiproc.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+static int nMaxThreadCount = 8, nIterations = 3, nWindowSize = 1024;
+static int nSize = 4096, nBands = 3;
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "gtiffreadtest [-t <max_thread#>] [-i <iterations>]\n"
+            "              [-w <window_size>] [-s <raster_size>] [-b <band#>]\n"
+            "              [-co <compression>]* [filename]*\n"
+            "\n"
+            "Reads the whole raster, by windows of window_size pixels, with\n"
+            "the NUM_THREADS open option of the GTiff driver set from 1 to\n"
+            "max_thread#, and reports the decompression throughput.\n"
+            "If no file is specified, tiled GeoTIFF files are created in\n"
+            "/vsimem with each of the compressions (DEFLATE and LZW by\n"
+            "default).\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                          CreateTestFile()                            */
+/************************************************************************/
+
+static char *CreateTestFile( const char *pszCompress )
+
+{
+    GDALDriverH hDriver = GDALGetDriverByName( "GTiff" );
+    if( hDriver == NULL )
+    {
+        printf( "GTiff driver not available.\n" );
+        exit( 1 );
+    }
+
+    char *pszTestFilename =
+        CPLStrdup( CPLSPrintf( "/vsimem/gtiffreadtest_%s.tif", pszCompress ) );
+
+    char **papszOptions = NULL;
+    papszOptions = CSLSetNameValue( papszOptions, "TILED", "YES" );
+    papszOptions = CSLSetNameValue( papszOptions, "COMPRESS", pszCompress );
+    papszOptions = CSLSetNameValue( papszOptions, "NUM_THREADS", "ALL_CPUS" );
+
+    GDALDatasetH hDS = GDALCreate( hDriver, pszTestFilename, nSize, nSize,
+                                   nBands, GDT_Byte, papszOptions );
+    CSLDestroy( papszOptions );
+    if( hDS == NULL )
+        exit( 1 );
+
+/* -------------------------------------------------------------------- */
+/*      Write a smooth gradient with some noise, so that the tiles      */
+/*      are neither trivial nor incompressible.                         */
+/* -------------------------------------------------------------------- */
+    GByte *pabyLine = (GByte *) CPLMalloc( nSize );
+    GUInt32 nState = 1;
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        for( int iLine = 0; iLine < nSize; iLine++ )
+        {
+            for( int iPixel = 0; iPixel < nSize; iPixel++ )
+            {
+                nState = nState * 1103515245U + 12345U;
+                pabyLine[iPixel] = (GByte)
+                    ((iPixel + iLine) / 16 + iBand * 32 + ((nState >> 16) & 7));
+            }
+            GDALRasterIO( GDALGetRasterBand( hDS, iBand + 1 ), GF_Write,
+                          0, iLine, nSize, 1, pabyLine, nSize, 1,
+                          GDT_Byte, 0, 0 );
+        }
+    }
+    CPLFree( pabyLine );
+    GDALClose( hDS );
+
+    return pszTestFilename;
+}
+
+/************************************************************************/
+/*                             ReadFile()                               */
+/*                                                                      */
+/*      Read the whole file by windows, and return the number of        */
+/*      pixels read, or -1 in case of error.                            */
+/************************************************************************/
+
+static GIntBig ReadFile( const char *pszFilename, int nThreadCount )
+
+{
+    char **papszOpenOptions = NULL;
+    papszOpenOptions = CSLSetNameValue( papszOpenOptions, "NUM_THREADS",
+                                        CPLSPrintf( "%d", nThreadCount ) );
+    GDALDatasetH hDS = GDALOpenEx( pszFilename, GDAL_OF_RASTER, NULL,
+                                   papszOpenOptions, NULL );
+    CSLDestroy( papszOpenOptions );
+    if( hDS == NULL )
+        return -1;
+
+    int nXSize = GDALGetRasterXSize( hDS );
+    int nYSize = GDALGetRasterYSize( hDS );
+    int nBandCount = GDALGetRasterCount( hDS );
+    GByte *pabyBuffer = (GByte *)
+        VSIMalloc3( nWindowSize, nWindowSize, nBandCount );
+    if( pabyBuffer == NULL )
+    {
+        GDALClose( hDS );
+        return -1;
+    }
+
+    GIntBig nPixels = 0;
+    for( int nYOff = 0; nYOff < nYSize; nYOff += nWindowSize )
+    {
+        int nReqYSize = MIN( nWindowSize, nYSize - nYOff );
+        for( int nXOff = 0; nXOff < nXSize; nXOff += nWindowSize )
+        {
+            int nReqXSize = MIN( nWindowSize, nXSize - nXOff );
+            if( GDALDatasetRasterIO( hDS, GF_Read, nXOff, nYOff,
+                                     nReqXSize, nReqYSize, pabyBuffer,
+                                     nReqXSize, nReqYSize, GDT_Byte,
+                                     nBandCount, NULL, 0, 0, 0 ) != CE_None )
+            {
+                nPixels = -1;
+                break;
+            }
+            nPixels += (GIntBig) nReqXSize * nReqYSize * nBandCount;
+        }
+        if( nPixels < 0 )
+            break;
+    }
+
+    VSIFree( pabyBuffer );
+    GDALClose( hDS );
+
+    return nPixels;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    int iArg;
+    char **papszCompressions = NULL;
+    char **papszFilenames = NULL;
+
+/* -------------------------------------------------------------------- */
+/*      Process arguments.                                              */
+/* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    for( iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-i") && iArg < argc-1 )
+            nIterations = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-t") && iArg < argc-1 )
+            nMaxThreadCount = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-w") && iArg < argc-1 )
+            nWindowSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-s") && iArg < argc-1 )
+            nSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-b") && iArg < argc-1 )
+            nBands = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-co") && iArg < argc-1 )
+            papszCompressions = CSLAddString( papszCompressions,
+                                              argv[++iArg] );
+        else if( argv[iArg][0] != '-' )
+            papszFilenames = CSLAddString( papszFilenames, argv[iArg] );
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+    }
+
+    if( nMaxThreadCount < 1 || nIterations < 1 || nWindowSize < 1 ||
+        nSize < 1 || nBands < 1 )
+        Usage();
+
+    GDALAllRegister();
+
+    int bCreatedFiles = FALSE;
+    if( papszFilenames == NULL )
+    {
+        if( papszCompressions == NULL )
+        {
+            papszCompressions = CSLAddString( papszCompressions, "DEFLATE" );
+            papszCompressions = CSLAddString( papszCompressions, "LZW" );
+        }
+        for( int i = 0; papszCompressions[i] != NULL; i++ )
+        {
+            char *pszTestFilename = CreateTestFile( papszCompressions[i] );
+            papszFilenames = CSLAddString( papszFilenames, pszTestFilename );
+            CPLFree( pszTestFilename );
+        }
+        bCreatedFiles = TRUE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Run the workload with an increasing number of threads.          */
+/* -------------------------------------------------------------------- */
+    for( int iFile = 0; papszFilenames[iFile] != NULL; iFile++ )
+    {
+        const char *pszFilename = papszFilenames[iFile];
+
+        printf( "Reading %s %d times by %dx%d windows, "
+                "cache max = " CPL_FRMT_GIB " bytes.\n",
+                pszFilename, nIterations, nWindowSize, nWindowSize,
+                GDALGetCacheMax64() );
+        printf( "threads  seconds  Mpixels/s  speedup\n" );
+
+        double dfSingleThreadThroughput = 0.0;
+        int nThreadCount = 1;
+
+        while( TRUE )
+        {
+            GIntBig nPixels = 0;
+            double dfStart = GetWallClockTime();
+
+            for( int iIter = 0; iIter < nIterations; iIter++ )
+            {
+                GIntBig nRead = ReadFile( pszFilename, nThreadCount );
+                if( nRead < 0 )
+                {
+                    printf( "Cannot read %s.\n", pszFilename );
+                    exit( 1 );
+                }
+                nPixels += nRead;
+            }
+
+            double dfElapsed = GetWallClockTime() - dfStart;
+            if( dfElapsed <= 0.0 )
+                dfElapsed = 1e-6;
+
+            double dfThroughput = (double) nPixels / dfElapsed / 1e6;
+            if( nThreadCount == 1 )
+                dfSingleThreadThroughput = dfThroughput;
+
+            printf( "%7d  %7.3f  %9.1f  %7.2f\n",
+                    nThreadCount, dfElapsed, dfThroughput,
+                    dfThroughput / dfSingleThreadThroughput );
+
+            if( nThreadCount == nMaxThreadCount )
+                break;
+            nThreadCount *= 2;
+            if( nThreadCount > nMaxThreadCount )
+                nThreadCount = nMaxThreadCount;
+        }
+        printf( "\n" );
+
+        if( bCreatedFiles )
+            VSIUnlink( pszFilename );
+    }
+
+    CSLDestroy( papszCompressions );
+    CSLDestroy( papszFilenames );
+    CSLDestroy( argv );
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -36,6 +36,8 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "commonutils.h"
+#include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 #include <map>
 #include <vector>
 
@@ -44,7 +46,8 @@ CPL_CVSID("$Id$");
 static int bSkipFailures = FALSE;
 static int nGroupTransactions = 20000;
 static int bPreserveFID = FALSE;
-static int nFIDToFetch = OGRNullFID;
+static GIntBig nFIDToFetch = OGRNullFID;
+static int nTranslationThreads = 0; /* 0: GDAL_NUM_THREADS, if set */
 
 #define COORD_DIM_LAYER_DIM -2
 
@@ -76,6 +79,50 @@ typedef struct
     TargetLayerInfo  *psInfo;
 } AssociatedLayers;
 
+/* State shared by the translation of the features of a layer, that is */
+/* only read once the translation has started. */
+typedef struct
+{
+    TargetLayerInfo             *psInfo;
+    OGRLayer                    *poSrcLayer;
+    OGRLayer                    *poDstLayer;
+    int                          bTransform;
+    OGRSpatialReference         *poOutputSRS;
+    OGRCoordinateTransformation *poGCPCoordTrans;
+    int                          bForceToPolygon;
+    int                          bForceToMultiPolygon;
+    int                          bForceToMultiLineString;
+    int                          bPromoteToMulti;
+    int                          nCoordDim;
+    GeomOperation                eGeomOp;
+    double                       dfGeomOpParam;
+    OGRGeometry                 *poClipSrc;
+    OGRGeometry                 *poClipDst;
+    int                          bExplodeCollections;
+    int                          nSrcGeomFieldCount;
+    int                          nDstGeomFieldCount;
+} TranslateFeatureContext;
+
+typedef struct
+{
+    OGRFeature                  *poSrcFeature;
+    std::vector<OGRFeature*>     apoDstFeatures;
+    int                          bTranslated; /* FALSE on fatal error */
+} TranslatedFeature;
+
+/* Cumulated over all the translated layers, for the -progress report */
+typedef struct
+{
+    GIntBig      nFeaturesRead;
+    GIntBig      nFeaturesWritten;
+    double       dfElapsedTime;
+    double       dfReadTime;
+    double       dfTranslateTime; /* summed over the translation threads */
+    double       dfWriteTime;
+} TranslationStats;
+
+static TranslationStats sTranslationStats = { 0, 0, 0.0, 0.0, 0.0, 0.0 };
+
 static TargetLayerInfo* SetupTargetLayer( GDALDataset *poSrcDS,
                                                 OGRLayer * poSrcLayer,
                                                 GDALDataset *poDstDS,
@@ -113,7 +160,7 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
                            int nCoordDim,
                            GeomOperation eGeomOp,
                            double dfGeomOpParam,
-                           long nCountLayerFeatures,
+                           GIntBig nCountLayerFeatures,
                            OGRGeometry* poClipSrc,
                            OGRGeometry *poClipDst,
                            int bExplodeCollections,
@@ -289,13 +336,13 @@ class OGRSplitListFieldLayer : public OGRLayer
                                                 void *pProgressArg);
 
     virtual OGRFeature          *GetNextFeature();
-    virtual OGRFeature          *GetFeature(long nFID);
+    virtual OGRFeature          *GetFeature(GIntBig nFID);
     virtual OGRFeatureDefn      *GetLayerDefn();
 
     virtual void                 ResetReading() { poSrcLayer->ResetReading(); }
     virtual int                  TestCapability(const char*) { return FALSE; }
 
-    virtual int                  GetFeatureCount( int bForce = TRUE )
+    virtual GIntBig              GetFeatureCount( int bForce = TRUE )
     {
         return poSrcLayer->GetFeatureCount(bForce);
     }
@@ -415,10 +462,10 @@ int  OGRSplitListFieldLayer::BuildLayerDefn(GDALProgressFunc pfnProgress,
         poSrcLayer->ResetReading();
         OGRFeature* poSrcFeature;
 
-        int nFeatureCount = 0;
+        GIntBig nFeatureCount = 0;
         if (poSrcLayer->TestCapability(OLCFastFeatureCount))
             nFeatureCount = poSrcLayer->GetFeatureCount();
-        int nFeatureIndex = 0;
+        GIntBig nFeatureIndex = 0;
 
         /* Scan the whole layer to compute the maximum number of */
         /* items for each field of list type */
@@ -619,7 +666,7 @@ OGRFeature *OGRSplitListFieldLayer::GetNextFeature()
 /*                           GetFeature()                               */
 /************************************************************************/
 
-OGRFeature *OGRSplitListFieldLayer::GetFeature(long nFID)
+OGRFeature *OGRSplitListFieldLayer::GetFeature(GIntBig nFID)
 {
     return TranslateFeature(poSrcLayer->GetFeature(nFID));
 }
@@ -849,6 +896,7 @@ int main( int nArgc, char ** papszArgv )
     char        **papszFieldTypesToString = NULL;
     int          bUnsetFieldWidth = FALSE;
     int          bDisplayProgress = FALSE;
+    int          bReportThroughput = FALSE;
     GDALProgressFunc pfnProgress = NULL;
     void        *pProgressArg = NULL;
     int          bWrapDateline = FALSE;
@@ -978,7 +1026,7 @@ int main( int nArgc, char ** papszArgv )
         else if( EQUAL(papszArgv[iArg],"-fid") )
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
-            nFIDToFetch = atoi(papszArgv[++iArg]);
+            nFIDToFetch = CPLAtoGIntBig(papszArgv[++iArg]);
         }
         else if( EQUAL(papszArgv[iArg],"-sql") )
         {
@@ -1050,6 +1098,17 @@ int main( int nArgc, char ** papszArgv )
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
             nGroupTransactions = atoi(papszArgv[++iArg]);
         }
+        else if( EQUAL(papszArgv[iArg],"-nt") )
+        {
+            CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
+            const char* pszThreads = papszArgv[++iArg];
+            nTranslationThreads = CPLParseNumThreads( pszThreads );
+            if( nTranslationThreads < 1 )
+            {
+                Usage(CPLSPrintf("-nt %s: invalid number of threads.",
+                                 pszThreads));
+            }
+        }
         else if( EQUAL(papszArgv[iArg],"-s_srs") )
         {
             CHECK_HAS_ENOUGH_ADDITIONAL_ARGS(1);
@@ -1160,6 +1219,7 @@ int main( int nArgc, char ** papszArgv )
         else if( EQUAL(papszArgv[iArg],"-progress") )
         {
             bDisplayProgress = TRUE;
+            bReportThroughput = TRUE;
         }
         else if( EQUAL(papszArgv[iArg],"-wrapdateline") )
         {
@@ -1373,6 +1433,9 @@ int main( int nArgc, char ** papszArgv )
             papszLayers = CSLAddString( papszLayers, papszArgv[iArg] );
     }
 
+    if( nTranslationThreads == 0 )
+        nTranslationThreads = CPLGetNumThreadsOption( NULL );
+
     if( pszDataSource == NULL )
     {
         if( pszDestDataSource == NULL )
@@ -1704,7 +1767,7 @@ int main( int nArgc, char ** papszArgv )
                            pszGeomField);
             }
 
-            long nCountLayerFeatures = 0;
+            GIntBig nCountLayerFeatures = 0;
             if (bDisplayProgress)
             {
                 if (bSrcIsOSM)
@@ -2076,9 +2139,9 @@ int main( int nArgc, char ** papszArgv )
             pszNewLayerName = CPLStrdup(CPLGetBasename(pszDestDataSource));
         }
 
-        long* panLayerCountFeatures = (long*) CPLCalloc(sizeof(long), nLayerCount);
-        long nCountLayersFeatures = 0;
-        long nAccCountFeatures = 0;
+        GIntBig* panLayerCountFeatures = (GIntBig*) CPLCalloc(sizeof(GIntBig), nLayerCount);
+        GIntBig nCountLayersFeatures = 0;
+        GIntBig nAccCountFeatures = 0;
         int iLayer;
 
         /* First pass to apply filters and count all features if necessary */
@@ -2167,7 +2230,7 @@ int main( int nArgc, char ** papszArgv )
                 else
                 {
                     pfnProgress = GDALScaledProgress;
-                    int nStart = 0;
+                    GIntBig nStart = 0;
                     if (poPassedLayer != poLayer && nMaxSplitListSubFields != 1)
                         nStart = panLayerCountFeatures[iLayer] / 2;
                     pProgressArg =
@@ -2237,6 +2300,26 @@ int main( int nArgc, char ** papszArgv )
         CPLFree(papoLayers);
     }
 /* -------------------------------------------------------------------- */
+/*      Report the throughput of the translation.                       */
+/* -------------------------------------------------------------------- */
+    if( bReportThroughput && !bQuiet &&
+        sTranslationStats.nFeaturesRead > 0 )
+    {
+        const TranslationStats* psStats = &sTranslationStats;
+        printf( CPL_FRMT_GIB " features read, " CPL_FRMT_GIB " written in "
+                "%.2f s (%.0f features/s).\n",
+                psStats->nFeaturesRead, psStats->nFeaturesWritten,
+                psStats->dfElapsedTime,
+                psStats->dfElapsedTime > 0 ?
+                    psStats->nFeaturesRead / psStats->dfElapsedTime : 0.0 );
+        printf( "Reading: %.2f s, translating: %.2f s (%d thread%s), "
+                "writing: %.2f s.\n",
+                psStats->dfReadTime, psStats->dfTranslateTime,
+                nTranslationThreads, nTranslationThreads > 1 ? "s" : "",
+                psStats->dfWriteTime );
+    }
+
+/* -------------------------------------------------------------------- */
 /*      Process DS style table                                          */
 /* -------------------------------------------------------------------- */
 
@@ -2309,7 +2392,7 @@ static void Usage(const char* pszAdditionalMsg, int bShort)
             "               [-lco NAME=VALUE] [-nln name] [-nlt type] [-dim 2|3|layer_dim] [layer [layer ...]]\n"
             "\n"
             "Advanced options :\n"
-            "               [-gt n]\n"
+            "               [-gt n] [-nt num_threads|ALL_CPUS]\n"
             "               [[-oo NAME=VALUE] ...] [[-doo NAME=VALUE] ...]\n"
             "               [-clipsrc [xmin ymin xmax ymax]|WKT|datasource|spat_extent]\n"
             "               [-clipsrcsql sql_statement] [-clipsrclayer layer]\n"
@@ -2362,6 +2445,9 @@ static void Usage(const char* pszAdditionalMsg, int bShort)
             " -dialect value: select a dialect, usually OGRSQL to avoid native sql.\n"
             " -skipfailures: skip features or layers that fail to convert\n"
             " -gt n: group n features per transaction (default 20000)\n"
+            " -nt num_threads|ALL_CPUS: translate the features with several threads,\n"
+            "      while reading and writing them in separate threads\n"
+            "      (default: GDAL_NUM_THREADS configuration option, or 1)\n"
             " -spat xmin ymin xmax ymax: spatial query extents\n"
             " -simplify tolerance: distance tolerance for simplification.\n"
             " -segmentize max_dist: maximum distance between 2 nodes.\n"
@@ -3236,6 +3322,617 @@ static int SetupCT( TargetLayerInfo* psInfo,
     }
     return TRUE;
 }
+
+/************************************************************************/
+/*                           TranslateFeature()                         */
+/*                                                                      */
+/*      Translate a source feature into one or several (with           */
+/*      -explodecollections) target features. Only reads the state      */
+/*      of the context, so it can be run concurrently from several      */
+/*      threads on different features. Returns FALSE on a fatal         */
+/*      error.                                                          */
+/************************************************************************/
+
+static int TranslateFeature( const TranslateFeatureContext* psCtxt,
+                             TranslatedFeature* psFeature )
+
+{
+    TargetLayerInfo *psInfo = psCtxt->psInfo;
+    OGRLayer        *poDstLayer = psCtxt->poDstLayer;
+    OGRFeature      *poFeature = psFeature->poSrcFeature;
+    int              iSrcZField = psInfo->iSrcZField;
+    int              nDstGeomFieldCount = psCtxt->nDstGeomFieldCount;
+
+    int nParts = 0;
+    int nIters = 1;
+    if (psCtxt->bExplodeCollections)
+    {
+        OGRGeometry* poSrcGeometry;
+        if( psInfo->iRequestedSrcGeomField >= 0 )
+            poSrcGeometry = poFeature->GetGeomFieldRef(
+                                    psInfo->iRequestedSrcGeomField);
+        else
+            poSrcGeometry = poFeature->GetGeometryRef();
+        if (poSrcGeometry)
+        {
+            switch (wkbFlatten(poSrcGeometry->getGeometryType()))
+            {
+                case wkbMultiPoint:
+                case wkbMultiLineString:
+                case wkbMultiPolygon:
+                case wkbGeometryCollection:
+                    nParts = ((OGRGeometryCollection*)poSrcGeometry)->getNumGeometries();
+                    nIters = nParts;
+                    if (nIters == 0)
+                        nIters = 1;
+                default:
+                    break;
+            }
+        }
+    }
+
+    for(int iPart = 0; iPart < nIters; iPart++)
+    {
+        CPLErrorReset();
+        OGRFeature *poDstFeature =
+            OGRFeature::CreateFeature( poDstLayer->GetLayerDefn() );
+
+        /* Optimization to avoid duplicating the source geometry in the */
+        /* target feature : we steal it from the source feature for now... */
+        /* (not done for geometries still in WKB form, as SetFrom() copies */
+        /* the WKB without building the geometry) */
+        OGRGeometry* poStolenGeometry = NULL;
+        if( !psCtxt->bExplodeCollections && psCtxt->nSrcGeomFieldCount == 1 &&
+            nDstGeomFieldCount == 1 )
+        {
+            if( poFeature->GetGeomFieldWKB(0, NULL) == NULL )
+                poStolenGeometry = poFeature->StealGeometry();
+        }
+        else if( !psCtxt->bExplodeCollections &&
+                 psInfo->iRequestedSrcGeomField >= 0 &&
+                 poFeature->GetGeomFieldWKB(
+                        psInfo->iRequestedSrcGeomField, NULL) == NULL )
+        {
+            poStolenGeometry = poFeature->StealGeometry(
+                psInfo->iRequestedSrcGeomField);
+        }
+
+        if( poDstFeature->SetFrom( poFeature, psInfo->panMap, TRUE ) != OGRERR_NONE )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to translate feature " CPL_FRMT_GIB " from layer %s.\n",
+                    poFeature->GetFID(), psCtxt->poSrcLayer->GetName() );
+
+            OGRFeature::DestroyFeature( poDstFeature );
+            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
+            return FALSE;
+        }
+
+        /* ... and now we can attach the stolen geometry */
+        if( poStolenGeometry )
+        {
+            poDstFeature->SetGeometryDirectly(poStolenGeometry);
+        }
+
+        if( bPreserveFID )
+            poDstFeature->SetFID( poFeature->GetFID() );
+
+        for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
+        {
+            OGRCoordinateTransformation* poCT = psInfo->papoCT[iGeom];
+            if( !psCtxt->bTransform )
+                poCT = psCtxt->poGCPCoordTrans;
+            char** papszTransformOptions = psInfo->papapszTransformOptions[iGeom];
+
+            /* Geometries still in WKB form that need no processing are */
+            /* passed as they are to the target layer */
+            if( poDstFeature->GetGeomFieldWKB(iGeom, NULL) != NULL &&
+                nParts == 0 && iSrcZField == -1 &&
+                psCtxt->nCoordDim == -1 && psCtxt->eGeomOp == NONE &&
+                psCtxt->poClipSrc == NULL && psCtxt->poClipDst == NULL &&
+                poCT == NULL && papszTransformOptions == NULL &&
+                !psCtxt->bForceToPolygon && !psCtxt->bForceToMultiPolygon &&
+                !psCtxt->bForceToMultiLineString && !psCtxt->bPromoteToMulti )
+                continue;
+
+            OGRGeometry* poDstGeometry = poDstFeature->GetGeomFieldRef(iGeom);
+            if (poDstGeometry == NULL)
+                continue;
+
+            if (nParts > 0)
+            {
+                /* For -explodecollections, extract the iPart(th) of the geometry */
+                OGRGeometry* poPart = ((OGRGeometryCollection*)poDstGeometry)->getGeometryRef(iPart);
+                ((OGRGeometryCollection*)poDstGeometry)->removeGeometry(iPart, FALSE);
+                poDstFeature->SetGeomFieldDirectly(iGeom, poPart);
+                poDstGeometry = poPart;
+            }
+
+            if (iSrcZField != -1)
+            {
+                SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
+                /* This will correct the coordinate dimension to 3 */
+                OGRGeometry* poDupGeometry = poDstGeometry->clone();
+                poDstFeature->SetGeomFieldDirectly(iGeom, poDupGeometry);
+                poDstGeometry = poDupGeometry;
+            }
+
+            if (psCtxt->nCoordDim == 2 || psCtxt->nCoordDim == 3)
+                poDstGeometry->setCoordinateDimension( psCtxt->nCoordDim );
+            else if ( psCtxt->nCoordDim == COORD_DIM_LAYER_DIM )
+                poDstGeometry->setCoordinateDimension(
+                    (poDstLayer->GetLayerDefn()->GetGeomFieldDefn(iGeom)->GetType() & wkb25DBit) ? 3 : 2 );
+
+            if (psCtxt->eGeomOp == SEGMENTIZE)
+            {
+                if (psCtxt->dfGeomOpParam > 0)
+                    poDstGeometry->segmentize(psCtxt->dfGeomOpParam);
+            }
+            else if (psCtxt->eGeomOp == SIMPLIFY_PRESERVE_TOPOLOGY)
+            {
+                if (psCtxt->dfGeomOpParam > 0)
+                {
+                    OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(psCtxt->dfGeomOpParam);
+                    if (poNewGeom)
+                    {
+                        poDstFeature->SetGeomFieldDirectly(iGeom, poNewGeom);
+                        poDstGeometry = poNewGeom;
+                    }
+                }
+            }
+
+            if (psCtxt->poClipSrc)
+            {
+                OGRGeometry* poClipped = poDstGeometry->Intersection(psCtxt->poClipSrc);
+                if (poClipped == NULL || poClipped->IsEmpty())
+                {
+                    OGRGeometryFactory::destroyGeometry(poClipped);
+                    OGRFeature::DestroyFeature( poDstFeature );
+                    poDstFeature = NULL;
+                    break;
+                }
+                poDstFeature->SetGeomFieldDirectly(iGeom, poClipped);
+                poDstGeometry = poClipped;
+            }
+
+            if( poCT != NULL || papszTransformOptions != NULL)
+            {
+                OGRGeometry* poReprojectedGeom =
+                    OGRGeometryFactory::transformWithOptions(poDstGeometry, poCT, papszTransformOptions);
+                if( poReprojectedGeom == NULL )
+                {
+                    fprintf( stderr, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).\n",
+                            poFeature->GetFID() );
+                    if( !bSkipFailures )
+                    {
+                        OGRFeature::DestroyFeature( poDstFeature );
+                        return FALSE;
+                    }
+                }
+
+                poDstFeature->SetGeomFieldDirectly(iGeom, poReprojectedGeom);
+                poDstGeometry = poReprojectedGeom;
+            }
+            else if (psCtxt->poOutputSRS != NULL)
+            {
+                poDstGeometry->assignSpatialReference(psCtxt->poOutputSRS);
+            }
+
+            if (psCtxt->poClipDst)
+            {
+                OGRGeometry* poClipped = poDstGeometry->Intersection(psCtxt->poClipDst);
+                if (poClipped == NULL || poClipped->IsEmpty())
+                {
+                    OGRGeometryFactory::destroyGeometry(poClipped);
+                    OGRFeature::DestroyFeature( poDstFeature );
+                    poDstFeature = NULL;
+                    break;
+                }
+
+                poDstFeature->SetGeomFieldDirectly(iGeom, poClipped);
+                poDstGeometry = poClipped;
+            }
+
+            if( psCtxt->bForceToPolygon )
+            {
+                poDstFeature->SetGeomFieldDirectly(iGeom, 
+                    OGRGeometryFactory::forceToPolygon(
+                        poDstFeature->StealGeometry(iGeom) ) );
+            }
+            else if( psCtxt->bForceToMultiPolygon ||
+                    (psCtxt->bPromoteToMulti && wkbFlatten(poDstGeometry->getGeometryType()) == wkbPolygon) )
+            {
+                poDstFeature->SetGeomFieldDirectly(iGeom, 
+                    OGRGeometryFactory::forceToMultiPolygon(
+                        poDstFeature->StealGeometry(iGeom) ) );
+            }
+            else if ( psCtxt->bForceToMultiLineString ||
+                    (psCtxt->bPromoteToMulti && wkbFlatten(poDstGeometry->getGeometryType()) == wkbLineString) )
+            {
+                poDstFeature->SetGeomFieldDirectly(iGeom, 
+                    OGRGeometryFactory::forceToMultiLineString(
+                        poDstFeature->StealGeometry(iGeom) ) );
+            }
+        }
+
+        if( poDstFeature != NULL )
+            psFeature->apoDstFeatures.push_back( poDstFeature );
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        FreeTranslatedFeature()                       */
+/************************************************************************/
+
+static void FreeTranslatedFeature( TranslatedFeature* psFeature )
+
+{
+    for( size_t i = 0; i < psFeature->apoDstFeatures.size(); i++ )
+        OGRFeature::DestroyFeature( psFeature->apoDstFeatures[i] );
+    psFeature->apoDstFeatures.clear();
+    OGRFeature::DestroyFeature( psFeature->poSrcFeature );
+    psFeature->poSrcFeature = NULL;
+}
+
+/************************************************************************/
+/*                       WriteTranslatedFeature()                       */
+/*                                                                      */
+/*      Write the target features of a translated source feature, and   */
+/*      free them. Returns FALSE if the translation must be stopped.    */
+/************************************************************************/
+
+static int WriteTranslatedFeature( const TranslateFeatureContext* psCtxt,
+                                   TranslatedFeature* psFeature,
+                                   int* pnFeaturesInTransaction,
+                                   GIntBig* pnFeaturesWritten )
+
+{
+    OGRLayer *poDstLayer = psCtxt->poDstLayer;
+    int       bRet = TRUE;
+
+    for( size_t i = 0; bRet && i < psFeature->apoDstFeatures.size(); i++ )
+    {
+        if( ++(*pnFeaturesInTransaction) == nGroupTransactions )
+        {
+            poDstLayer->CommitTransaction();
+            poDstLayer->StartTransaction();
+            *pnFeaturesInTransaction = 0;
+        }
+
+        CPLErrorReset();
+        if( poDstLayer->CreateFeature( psFeature->apoDstFeatures[i] ) == OGRERR_NONE )
+        {
+            (*pnFeaturesWritten) ++;
+        }
+        else if( !bSkipFailures )
+        {
+            if( nGroupTransactions )
+                poDstLayer->RollbackTransaction();
+
+            CPLError( CE_Failure, CPLE_AppDefined,
+                    "Unable to write feature " CPL_FRMT_GIB " from layer %s.\n",
+                    psFeature->poSrcFeature->GetFID(),
+                    psCtxt->poSrcLayer->GetName() );
+            bRet = FALSE;
+        }
+        else
+        {
+            CPLDebug( "OGR2OGR", "Unable to write feature " CPL_FRMT_GIB " into layer %s.\n",
+                       psFeature->poSrcFeature->GetFID(),
+                       psCtxt->poSrcLayer->GetName() );
+        }
+    }
+
+    /* The features translated before a failure are written, and the */
+    /* current transaction committed. */
+    if( bRet && !psFeature->bTranslated )
+    {
+        if( nGroupTransactions )
+            poDstLayer->CommitTransaction();
+        bRet = FALSE;
+    }
+
+    FreeTranslatedFeature( psFeature );
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                         TranslationPipeline                          */
+/*                                                                      */
+/*      With -nt, the thread of TranslateLayer() reads the source      */
+/*      features and groups them in batches, that are translated by     */
+/*      the jobs of the worker thread pool. A writer thread writes      */
+/*      the translated batches in their reading order. The number of    */
+/*      batches in flight is bounded, so that memory use does not       */
+/*      depend on the relative speed of the reading, translating and    */
+/*      writing steps.                                                  */
+/************************************************************************/
+
+#define TRANSLATION_BATCH_SIZE 256
+
+struct TranslationPipeline;
+
+typedef struct
+{
+    TranslationPipeline            *psPipeline;
+    GIntBig                         nSeq;
+    std::vector<TranslatedFeature>  asFeatures;
+    double                          dfTranslateTime;
+} TranslationBatch;
+
+struct TranslationPipeline
+{
+    const TranslateFeatureContext  *psCtxt;
+    int                             nThreads;
+    CPLJobGroup                    *psJobGroup;
+    void                           *hWriterThread;
+
+    /* Protected by hMutex */
+    void                           *hMutex;
+    void                           *hCond;
+    std::map<GIntBig, TranslationBatch*> oMapTranslatedBatches;
+    int                             nRunningJobs;
+    GIntBig                         nBatchesSubmitted;
+    GIntBig                         nBatchesWritten;
+    int                             bReadingFinished;
+    int                             bFailed;
+
+    /* Only used by the writer thread while it runs */
+    int                             nFeaturesInTransaction;
+    GIntBig                         nFeaturesWritten;
+    double                          dfTranslateTime;
+    double                          dfWriteTime;
+};
+
+/************************************************************************/
+/*                         TranslateBatchJob()                          */
+/************************************************************************/
+
+static void TranslateBatchJob( void* pData )
+
+{
+    TranslationBatch    *psBatch = (TranslationBatch*) pData;
+    TranslationPipeline *psPipeline = psBatch->psPipeline;
+    double               dfStart = GetWallClockTime();
+
+    for( size_t i = 0; i < psBatch->asFeatures.size(); i++ )
+    {
+        TranslatedFeature* psFeature = &psBatch->asFeatures[i];
+        psFeature->bTranslated = TranslateFeature( psPipeline->psCtxt,
+                                                   psFeature );
+        /* The features after a failed one will not be written */
+        if( !psFeature->bTranslated )
+            break;
+    }
+    psBatch->dfTranslateTime = GetWallClockTime() - dfStart;
+
+    CPLAcquireMutex( psPipeline->hMutex, 1000.0 );
+    psPipeline->nRunningJobs --;
+    psPipeline->oMapTranslatedBatches[psBatch->nSeq] = psBatch;
+    CPLCondBroadcast( psPipeline->hCond );
+    CPLReleaseMutex( psPipeline->hMutex );
+}
+
+/************************************************************************/
+/*                      WriteTranslatedBatches()                        */
+/*                                                                      */
+/*      Main function of the writer thread.                             */
+/************************************************************************/
+
+static void WriteTranslatedBatches( void* pData )
+
+{
+    TranslationPipeline *psPipeline = (TranslationPipeline*) pData;
+
+    CPLAcquireMutex( psPipeline->hMutex, 1000.0 );
+    while( TRUE )
+    {
+        std::map<GIntBig, TranslationBatch*>::iterator oIter =
+            psPipeline->oMapTranslatedBatches.find(psPipeline->nBatchesWritten);
+        if( oIter == psPipeline->oMapTranslatedBatches.end() )
+        {
+            if( psPipeline->bReadingFinished &&
+                psPipeline->nBatchesWritten == psPipeline->nBatchesSubmitted )
+                break;
+            CPLCondWait( psPipeline->hCond, psPipeline->hMutex );
+            continue;
+        }
+
+        TranslationBatch* psBatch = oIter->second;
+        psPipeline->oMapTranslatedBatches.erase( oIter );
+        int bFailed = psPipeline->bFailed;
+        CPLReleaseMutex( psPipeline->hMutex );
+
+/* -------------------------------------------------------------------- */
+/*      Once a feature could not be translated or written, the          */
+/*      remaining batches are only freed.                               */
+/* -------------------------------------------------------------------- */
+        double dfStart = GetWallClockTime();
+        for( size_t i = 0; i < psBatch->asFeatures.size(); i++ )
+        {
+            TranslatedFeature* psFeature = &psBatch->asFeatures[i];
+            if( bFailed )
+                FreeTranslatedFeature( psFeature );
+            else if( !WriteTranslatedFeature( psPipeline->psCtxt, psFeature,
+                                        &psPipeline->nFeaturesInTransaction,
+                                        &psPipeline->nFeaturesWritten ) )
+                bFailed = TRUE;
+        }
+        psPipeline->dfWriteTime += GetWallClockTime() - dfStart;
+        psPipeline->dfTranslateTime += psBatch->dfTranslateTime;
+        delete psBatch;
+
+        CPLAcquireMutex( psPipeline->hMutex, 1000.0 );
+        psPipeline->nBatchesWritten ++;
+        if( bFailed )
+            psPipeline->bFailed = TRUE;
+        CPLCondBroadcast( psPipeline->hCond );
+    }
+    CPLReleaseMutex( psPipeline->hMutex );
+}
+
+/************************************************************************/
+/*                      StartTranslationPipeline()                      */
+/************************************************************************/
+
+static TranslationPipeline* StartTranslationPipeline(
+                                const TranslateFeatureContext* psCtxt,
+                                int nFeaturesInTransaction,
+                                int nThreads )
+
+{
+    TranslationPipeline* psPipeline = new TranslationPipeline;
+
+    psPipeline->psCtxt = psCtxt;
+    psPipeline->nThreads = nThreads;
+    psPipeline->nRunningJobs = 0;
+    psPipeline->nBatchesSubmitted = 0;
+    psPipeline->nBatchesWritten = 0;
+    psPipeline->bReadingFinished = FALSE;
+    psPipeline->bFailed = FALSE;
+    psPipeline->nFeaturesInTransaction = nFeaturesInTransaction;
+    psPipeline->nFeaturesWritten = 0;
+    psPipeline->dfTranslateTime = 0.0;
+    psPipeline->dfWriteTime = 0.0;
+
+    psPipeline->hMutex = CPLCreateMutex();
+    CPLReleaseMutex( psPipeline->hMutex );
+    psPipeline->hCond = CPLCreateCond();
+    psPipeline->psJobGroup = CPLCreateJobGroup();
+    psPipeline->hWriterThread = NULL;
+    if( psPipeline->hCond != NULL )
+        psPipeline->hWriterThread =
+            CPLCreateJoinableThread( WriteTranslatedBatches, psPipeline );
+
+    if( psPipeline->hWriterThread == NULL )
+    {
+        CPLDebug( "OGR2OGR", "Cannot start the translation pipeline. "
+                  "Translating in a single thread" );
+        CPLDestroyJobGroup( psPipeline->psJobGroup );
+        if( psPipeline->hCond != NULL )
+            CPLDestroyCond( psPipeline->hCond );
+        CPLDestroyMutex( psPipeline->hMutex );
+        delete psPipeline;
+        return NULL;
+    }
+
+    return psPipeline;
+}
+
+/************************************************************************/
+/*                       SubmitTranslationBatch()                       */
+/*                                                                      */
+/*      Returns FALSE (and frees the batch) if the translation has      */
+/*      failed.                                                         */
+/************************************************************************/
+
+static int SubmitTranslationBatch( TranslationPipeline* psPipeline,
+                                   TranslationBatch* psBatch )
+
+{
+    CPLAcquireMutex( psPipeline->hMutex, 1000.0 );
+    while( !psPipeline->bFailed &&
+           (psPipeline->nRunningJobs >= psPipeline->nThreads ||
+            psPipeline->nBatchesSubmitted - psPipeline->nBatchesWritten
+                                            >= 2 * psPipeline->nThreads) )
+    {
+        CPLCondWait( psPipeline->hCond, psPipeline->hMutex );
+    }
+
+    if( psPipeline->bFailed )
+    {
+        CPLReleaseMutex( psPipeline->hMutex );
+        for( size_t i = 0; i < psBatch->asFeatures.size(); i++ )
+            FreeTranslatedFeature( &psBatch->asFeatures[i] );
+        delete psBatch;
+        return FALSE;
+    }
+
+    psBatch->psPipeline = psPipeline;
+    psBatch->nSeq = psPipeline->nBatchesSubmitted ++;
+    psPipeline->nRunningJobs ++;
+    CPLReleaseMutex( psPipeline->hMutex );
+
+    /* If the job cannot be queued, it is run in this thread */
+    CPLSubmitJob( psPipeline->psJobGroup, TranslateBatchJob, psBatch );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                     FinishTranslationPipeline()                      */
+/*                                                                      */
+/*      Wait for all the submitted batches to be written, and destroy   */
+/*      the pipeline. Returns FALSE if the translation has failed.      */
+/************************************************************************/
+
+static int FinishTranslationPipeline( TranslationPipeline* psPipeline,
+                                      GIntBig* pnFeaturesWritten,
+                                      double* pdfTranslateTime,
+                                      double* pdfWriteTime )
+
+{
+    CPLAcquireMutex( psPipeline->hMutex, 1000.0 );
+    psPipeline->bReadingFinished = TRUE;
+    CPLCondBroadcast( psPipeline->hCond );
+    CPLReleaseMutex( psPipeline->hMutex );
+
+    CPLWaitJobGroup( psPipeline->psJobGroup );
+    CPLJoinThread( psPipeline->hWriterThread );
+
+    int bRet = !psPipeline->bFailed;
+    *pnFeaturesWritten += psPipeline->nFeaturesWritten;
+    *pdfTranslateTime += psPipeline->dfTranslateTime;
+    *pdfWriteTime += psPipeline->dfWriteTime;
+
+    CPLDestroyJobGroup( psPipeline->psJobGroup );
+    CPLDestroyCond( psPipeline->hCond );
+    CPLDestroyMutex( psPipeline->hMutex );
+    delete psPipeline;
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                        ReportLayerProgress()                         */
+/************************************************************************/
+
+static void ReportLayerProgress( GDALDataset *poSrcDS,
+                                 GIntBig nCount,
+                                 GIntBig nCountLayerFeatures,
+                                 vsi_l_offset nSrcFileSize,
+                                 GDALProgressFunc pfnProgress,
+                                 void *pProgressArg )
+
+{
+    if (nSrcFileSize != 0)
+    {
+        if ((nCount % 1000) == 0)
+        {
+            OGRLayer* poFCLayer = poSrcDS->ExecuteSQL("GetBytesRead()", NULL, NULL);
+            if( poFCLayer != NULL )
+            {
+                OGRFeature* poFeat = poFCLayer->GetNextFeature();
+                if( poFeat )
+                {
+                    const char* pszReadSize = poFeat->GetFieldAsString(0);
+                    GUIntBig nReadSize = CPLScanUIntBig( pszReadSize, 32 );
+                    pfnProgress(nReadSize * 1.0 / nSrcFileSize, "", pProgressArg);
+                    OGRFeature::DestroyFeature( poFeat );
+                }
+            }
+            poSrcDS->ReleaseResultSet(poFCLayer);
+        }
+    }
+    else
+    {
+        pfnProgress(nCount * 1.0 / nCountLayerFeatures, "", pProgressArg);
+    }
+}
+
 /************************************************************************/
 /*                           TranslateLayer()                           */
 /************************************************************************/
@@ -3256,7 +3953,7 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
                            int nCoordDim,
                            GeomOperation eGeomOp,
                            double dfGeomOpParam,
-                           long nCountLayerFeatures,
+                           GIntBig nCountLayerFeatures,
                            OGRGeometry* poClipSrc,
                            OGRGeometry *poClipDst,
                            int bExplodeCollections,
@@ -3266,16 +3963,7 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
                            void *pProgressArg )
 
 {
-    OGRLayer    *poDstLayer;
-    int         bForceToPolygon = FALSE;
-    int         bForceToMultiPolygon = FALSE;
-    int         bForceToMultiLineString = FALSE;
-    int         *panMap = NULL;
-    int         iSrcZField;
-
-    poDstLayer = psInfo->poDstLayer;
-    panMap = psInfo->panMap;
-    iSrcZField = psInfo->iSrcZField;
+    OGRLayer    *poDstLayer = psInfo->poDstLayer;
     int nSrcGeomFieldCount = poSrcLayer->GetLayerDefn()->GetGeomFieldCount();
     int nDstGeomFieldCount = poDstLayer->GetLayerDefn()->GetGeomFieldCount();
 
@@ -3292,18 +3980,26 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
         }
 
     }
-    
-    if( wkbFlatten(eGType) == wkbPolygon )
-        bForceToPolygon = TRUE;
-    else if( wkbFlatten(eGType) == wkbMultiPolygon )
-        bForceToMultiPolygon = TRUE;
-    else if( wkbFlatten(eGType) == wkbMultiLineString )
-        bForceToMultiLineString = TRUE;
-    
-    if( bExplodeCollections && nDstGeomFieldCount > 1 )
-    {
-        bExplodeCollections = FALSE;
-    }
+
+    TranslateFeatureContext sCtxt;
+    sCtxt.psInfo = psInfo;
+    sCtxt.poSrcLayer = poSrcLayer;
+    sCtxt.poDstLayer = poDstLayer;
+    sCtxt.bTransform = bTransform;
+    sCtxt.poOutputSRS = poOutputSRS;
+    sCtxt.poGCPCoordTrans = poGCPCoordTrans;
+    sCtxt.bForceToPolygon = (wkbFlatten(eGType) == wkbPolygon);
+    sCtxt.bForceToMultiPolygon = (wkbFlatten(eGType) == wkbMultiPolygon);
+    sCtxt.bForceToMultiLineString = (wkbFlatten(eGType) == wkbMultiLineString);
+    sCtxt.bPromoteToMulti = bPromoteToMulti;
+    sCtxt.nCoordDim = nCoordDim;
+    sCtxt.eGeomOp = eGeomOp;
+    sCtxt.dfGeomOpParam = dfGeomOpParam;
+    sCtxt.poClipSrc = poClipSrc;
+    sCtxt.poClipDst = poClipDst;
+    sCtxt.bExplodeCollections = bExplodeCollections && nDstGeomFieldCount <= 1;
+    sCtxt.nSrcGeomFieldCount = nSrcGeomFieldCount;
+    sCtxt.nDstGeomFieldCount = nDstGeomFieldCount;
 
 /* -------------------------------------------------------------------- */
 /*      Transfer features.                                              */
@@ -3312,18 +4008,35 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
     int         nFeaturesInTransaction = 0;
     GIntBig      nCount = 0; /* written + failed */
     GIntBig      nFeaturesWritten = 0;
+    double       dfLayerStart = GetWallClockTime();
+    double       dfReadTime = 0.0, dfTranslateTime = 0.0, dfWriteTime = 0.0;
+    int          bRet = TRUE;
 
     if( nGroupTransactions )
         poDstLayer->StartTransaction();
 
+/* -------------------------------------------------------------------- */
+/*      The translation of the features is pipelined with -nt, unless   */
+/*      the coordinate transformation depends on the feature, or the    */
+/*      source and target layers belong to the same dataset.            */
+/* -------------------------------------------------------------------- */
+    TranslationPipeline *psPipeline = NULL;
+    TranslationBatch    *psBatch = NULL;
+    if( nTranslationThreads > 1 && !psInfo->bPerFeatureCT &&
+        nFIDToFetch == OGRNullFID && poSrcDS != poDstDS )
+    {
+        psPipeline = StartTranslationPipeline( &sCtxt, nFeaturesInTransaction,
+                                               nTranslationThreads );
+    }
+
     while( TRUE )
     {
-        OGRFeature      *poDstFeature = NULL;
+        double dfStart = GetWallClockTime();
 
         if( nFIDToFetch != OGRNullFID )
         {
             // Only fetch feature on first pass.
-            if( nFeaturesInTransaction == 0 )
+            if( nCount == 0 )
                 poFeature = poSrcLayer->GetFeature(nFIDToFetch);
             else
                 poFeature = NULL;
@@ -3331,6 +4044,8 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
         else
             poFeature = poSrcLayer->GetNextFeature();
 
+        dfReadTime += GetWallClockTime() - dfStart;
+
         if( poFeature == NULL )
             break;
 
@@ -3341,287 +4056,99 @@ static int TranslateLayer( TargetLayerInfo* psInfo,
                           poFeature, poOutputSRS, poGCPCoordTrans) )
             {
                 OGRFeature::DestroyFeature( poFeature );
-                return FALSE;
+                bRet = FALSE;
+                break;
             }
         }
 
         psInfo->nFeaturesRead ++;
 
-        int nParts = 0;
-        int nIters = 1;
-        if (bExplodeCollections)
-        {
-            OGRGeometry* poSrcGeometry;
-            if( psInfo->iRequestedSrcGeomField >= 0 )
-                poSrcGeometry = poFeature->GetGeomFieldRef(
-                                        psInfo->iRequestedSrcGeomField);
-            else
-                poSrcGeometry = poFeature->GetGeometryRef();
-            if (poSrcGeometry)
-            {
-                switch (wkbFlatten(poSrcGeometry->getGeometryType()))
-                {
-                    case wkbMultiPoint:
-                    case wkbMultiLineString:
-                    case wkbMultiPolygon:
-                    case wkbGeometryCollection:
-                        nParts = ((OGRGeometryCollection*)poSrcGeometry)->getNumGeometries();
-                        nIters = nParts;
-                        if (nIters == 0)
-                            nIters = 1;
-                    default:
-                        break;
-                }
-            }
-        }
+        TranslatedFeature sFeature;
+        sFeature.poSrcFeature = poFeature;
+        sFeature.bTranslated = TRUE;
 
-        for(int iPart = 0; iPart < nIters; iPart++)
+        if( psPipeline != NULL )
         {
-            if( ++nFeaturesInTransaction == nGroupTransactions )
+            if( psBatch == NULL )
             {
-                poDstLayer->CommitTransaction();
-                poDstLayer->StartTransaction();
-                nFeaturesInTransaction = 0;
+                psBatch = new TranslationBatch;
+                psBatch->asFeatures.reserve( TRANSLATION_BATCH_SIZE );
             }
-
-            CPLErrorReset();
-            poDstFeature = OGRFeature::CreateFeature( poDstLayer->GetLayerDefn() );
-
-            /* Optimization to avoid duplicating the source geometry in the */
-            /* target feature : we steal it from the source feature for now... */
-            OGRGeometry* poStolenGeometry = NULL;
-            if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
-                nDstGeomFieldCount == 1 )
-            {
-                poStolenGeometry = poFeature->StealGeometry();
-            }
-            else if( !bExplodeCollections &&
-                     psInfo->iRequestedSrcGeomField >= 0 )
-            {
-                poStolenGeometry = poFeature->StealGeometry(
-                    psInfo->iRequestedSrcGeomField);
-            }
-
-            if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
+            psBatch->asFeatures.push_back( sFeature );
+            if( (int)psBatch->asFeatures.size() == TRANSLATION_BATCH_SIZE )
             {
-                if( nGroupTransactions )
-                    poDstLayer->CommitTransaction();
-
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to translate feature %ld from layer %s.\n",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
-
-                OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
-                OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                return FALSE;
-            }
-
-            /* ... and now we can attach the stolen geometry */
-            if( poStolenGeometry )
-            {
-                poDstFeature->SetGeometryDirectly(poStolenGeometry);
-            }
-
-            if( bPreserveFID )
-                poDstFeature->SetFID( poFeature->GetFID() );
-            
-            for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
-            {
-                OGRGeometry* poDstGeometry = poDstFeature->GetGeomFieldRef(iGeom);
-                if (poDstGeometry == NULL)
-                    continue;
-
-                if (nParts > 0)
-                {
-                    /* For -explodecollections, extract the iPart(th) of the geometry */
-                    OGRGeometry* poPart = ((OGRGeometryCollection*)poDstGeometry)->getGeometryRef(iPart);
-                    ((OGRGeometryCollection*)poDstGeometry)->removeGeometry(iPart, FALSE);
-                    poDstFeature->SetGeomFieldDirectly(iGeom, poPart);
-                    poDstGeometry = poPart;
-                }
-
-                if (iSrcZField != -1)
-                {
-                    SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
-                    /* This will correct the coordinate dimension to 3 */
-                    OGRGeometry* poDupGeometry = poDstGeometry->clone();
-                    poDstFeature->SetGeomFieldDirectly(iGeom, poDupGeometry);
-                    poDstGeometry = poDupGeometry;
-                }
-
-                if (nCoordDim == 2 || nCoordDim == 3)
-                    poDstGeometry->setCoordinateDimension( nCoordDim );
-                else if ( nCoordDim == COORD_DIM_LAYER_DIM )
-                    poDstGeometry->setCoordinateDimension(
-                        (poDstLayer->GetLayerDefn()->GetGeomFieldDefn(iGeom)->GetType() & wkb25DBit) ? 3 : 2 );
-
-                if (eGeomOp == SEGMENTIZE)
-                {
-                    if (dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(dfGeomOpParam);
-                }
-                else if (eGeomOp == SIMPLIFY_PRESERVE_TOPOLOGY)
-                {
-                    if (dfGeomOpParam > 0)
-                    {
-                        OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            poDstFeature->SetGeomFieldDirectly(iGeom, poNewGeom);
-                            poDstGeometry = poNewGeom;
-                        }
-                    }
-                }
-
-                if (poClipSrc)
-                {
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(poClipSrc);
-                    if (poClipped == NULL || poClipped->IsEmpty())
-                    {
-                        OGRGeometryFactory::destroyGeometry(poClipped);
-                        goto end_loop;
-                    }
-                    poDstFeature->SetGeomFieldDirectly(iGeom, poClipped);
-                    poDstGeometry = poClipped;
-                }
-                
-                OGRCoordinateTransformation* poCT = psInfo->papoCT[iGeom];
-                if( !bTransform )
-                    poCT = poGCPCoordTrans;
-                char** papszTransformOptions = psInfo->papapszTransformOptions[iGeom];
-
-                if( poCT != NULL || papszTransformOptions != NULL)
-                {
-                    OGRGeometry* poReprojectedGeom =
-                        OGRGeometryFactory::transformWithOptions(poDstGeometry, poCT, papszTransformOptions);
-                    if( poReprojectedGeom == NULL )
-                    {
-                        if( nGroupTransactions )
-                            poDstLayer->CommitTransaction();
-
-                        fprintf( stderr, "Failed to reproject feature %d (geometry probably out of source or destination SRS).\n",
-                                (int) poFeature->GetFID() );
-                        if( !bSkipFailures )
-                        {
-                            OGRFeature::DestroyFeature( poFeature );
-                            OGRFeature::DestroyFeature( poDstFeature );
-                            return FALSE;
-                        }
-                    }
-
-                    poDstFeature->SetGeomFieldDirectly(iGeom, poReprojectedGeom);
-                    poDstGeometry = poReprojectedGeom;
-                }
-                else if (poOutputSRS != NULL)
-                {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
-                }
-
-                if (poClipDst)
-                {
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(poClipDst);
-                    if (poClipped == NULL || poClipped->IsEmpty())
-                    {
-                        OGRGeometryFactory::destroyGeometry(poClipped);
-                        goto end_loop;
-                    }
-
-                    poDstFeature->SetGeomFieldDirectly(iGeom, poClipped);
-                    poDstGeometry = poClipped;
-                }
-
-                if( bForceToPolygon )
-                {
-                    poDstFeature->SetGeomFieldDirectly(iGeom, 
-                        OGRGeometryFactory::forceToPolygon(
-                            poDstFeature->StealGeometry(iGeom) ) );
-                }
-                else if( bForceToMultiPolygon ||
-                        (bPromoteToMulti && wkbFlatten(poDstGeometry->getGeometryType()) == wkbPolygon) )
-                {
-                    poDstFeature->SetGeomFieldDirectly(iGeom, 
-                        OGRGeometryFactory::forceToMultiPolygon(
-                            poDstFeature->StealGeometry(iGeom) ) );
-                }
-                else if ( bForceToMultiLineString ||
-                        (bPromoteToMulti && wkbFlatten(poDstGeometry->getGeometryType()) == wkbLineString) )
-                {
-                    poDstFeature->SetGeomFieldDirectly(iGeom, 
-                        OGRGeometryFactory::forceToMultiLineString(
-                            poDstFeature->StealGeometry(iGeom) ) );
-                }
-            }
-
-            CPLErrorReset();
-            if( poDstLayer->CreateFeature( poDstFeature ) == OGRERR_NONE )
-            {
-                nFeaturesWritten ++;
+                int bSubmitted = SubmitTranslationBatch( psPipeline, psBatch );
+                psBatch = NULL;
+                if( !bSubmitted )
+                    break;
             }
-            else if( !bSkipFailures )
-            {
-                if( nGroupTransactions )
-                    poDstLayer->RollbackTransaction();
-
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to write feature %ld from layer %s.\n",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
+        }
+        else
+        {
+            dfStart = GetWallClockTime();
+            sFeature.bTranslated = TranslateFeature( &sCtxt, &sFeature );
+            double dfEnd = GetWallClockTime();
+            dfTranslateTime += dfEnd - dfStart;
 
-                OGRFeature::DestroyFeature( poFeature );
-                OGRFeature::DestroyFeature( poDstFeature );
-                return FALSE;
-            }
-            else
+            int bWritten = WriteTranslatedFeature( &sCtxt, &sFeature,
+                                                   &nFeaturesInTransaction,
+                                                   &nFeaturesWritten );
+            dfWriteTime += GetWallClockTime() - dfEnd;
+            if( !bWritten )
             {
-                CPLDebug( "OGR2OGR", "Unable to write feature %ld into layer %s.\n",
-                           poFeature->GetFID(), poSrcLayer->GetName() );
+                bRet = FALSE;
+                break;
             }
-
-end_loop:
-            OGRFeature::DestroyFeature( poDstFeature );
         }
 
-        OGRFeature::DestroyFeature( poFeature );
-
         /* Report progress */
         nCount ++;
         if (pfnProgress)
         {
-            if (nSrcFileSize != 0)
-            {
-                if ((nCount % 1000) == 0)
-                {
-                    OGRLayer* poFCLayer = poSrcDS->ExecuteSQL("GetBytesRead()", NULL, NULL);
-                    if( poFCLayer != NULL )
-                    {
-                        OGRFeature* poFeat = poFCLayer->GetNextFeature();
-                        if( poFeat )
-                        {
-                            const char* pszReadSize = poFeat->GetFieldAsString(0);
-                            GUIntBig nReadSize = CPLScanUIntBig( pszReadSize, 32 );
-                            pfnProgress(nReadSize * 1.0 / nSrcFileSize, "", pProgressArg);
-                            OGRFeature::DestroyFeature( poFeat );
-                        }
-                    }
-                    poSrcDS->ReleaseResultSet(poFCLayer);
-                }
-            }
-            else
-            {
-                pfnProgress(nCount * 1.0 / nCountLayerFeatures, "", pProgressArg);
-            }
+            ReportLayerProgress( poSrcDS, nCount, nCountLayerFeatures,
+                                 nSrcFileSize, pfnProgress, pProgressArg );
         }
 
         if (pnReadFeatureCount)
             *pnReadFeatureCount = nCount;
     }
 
+    if( psPipeline != NULL )
+    {
+        if( psBatch != NULL )
+        {
+            if( bRet )
+                SubmitTranslationBatch( psPipeline, psBatch );
+            else
+            {
+                for( size_t i = 0; i < psBatch->asFeatures.size(); i++ )
+                    FreeTranslatedFeature( &psBatch->asFeatures[i] );
+                delete psBatch;
+            }
+        }
+        if( !FinishTranslationPipeline( psPipeline, &nFeaturesWritten,
+                                        &dfTranslateTime, &dfWriteTime ) )
+            bRet = FALSE;
+    }
+
+    double dfElapsed = GetWallClockTime() - dfLayerStart;
+    sTranslationStats.nFeaturesRead += nCount;
+    sTranslationStats.nFeaturesWritten += nFeaturesWritten;
+    sTranslationStats.dfElapsedTime += dfElapsed;
+    sTranslationStats.dfReadTime += dfReadTime;
+    sTranslationStats.dfTranslateTime += dfTranslateTime;
+    sTranslationStats.dfWriteTime += dfWriteTime;
+
+    if( !bRet )
+        return FALSE;
+
     if( nGroupTransactions )
         poDstLayer->CommitTransaction();
 
-    CPLDebug("OGR2OGR", CPL_FRMT_GIB " features written in layer '%s'",
-             nFeaturesWritten, poDstLayer->GetName());
+    CPLDebug("OGR2OGR", CPL_FRMT_GIB " features written in layer '%s' "
+             "in %.2f s (reading %.2f s, translating %.2f s, writing %.2f s)",
+             nFeaturesWritten, poDstLayer->GetName(), dfElapsed,
+             dfReadTime, dfTranslateTime, dfWriteTime);
 
     return TRUE;
 }
-
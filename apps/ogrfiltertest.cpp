@@ -0,0 +1,281 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Benchmark of the evaluation of attribute filters, with the
+ *           compiled and the tree evaluators of OGR SQL expressions.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_api.h"
+#include "ogr_p.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+/* Filters used on datasets created with -create */
+static const char *apszDefaultFilters[] = {
+    "id > 500000",
+    "val < 250.5",
+    "id % 7 = 3 AND val > 100",
+    "name = 'name_42' OR id BETWEEN 1000 AND 2000",
+    "name LIKE 'name_1%'",
+    "id IN (1, 10, 100, 1000, 10000, 100000)",
+    "val * 2 + id > 1000 AND NOT name IS NULL",
+    NULL
+};
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "ogrfiltertest [-create <format> -n <feature_count>]\n"
+            "              [-where <expression>]* <datasource> [<layer>]\n"
+            "\n"
+            "Reports the time needed to read the features of a layer\n"
+            "without filter, and with each attribute filter evaluated by the\n"
+            "compiled and by the tree evaluator of OGR SQL expressions.\n"
+            "The number of matching features must be the same.\n"
+            "\n"
+            "With -create, a dataset of the given format (\"CSV\" or\n"
+            "\"ESRI Shapefile\") is first created with an integer 'id',\n"
+            "a real 'val' and a string 'name' field, and default filters\n"
+            "are used if none is specified.\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                           CreateDataset()                            */
+/************************************************************************/
+
+static void CreateDataset( const char *pszFormat, const char *pszFilename,
+                           int nFeatureCount )
+
+{
+    OGRSFDriverH hDriver = OGRGetDriverByName( pszFormat );
+    if( hDriver == NULL )
+    {
+        printf( "Unknown format: %s\n", pszFormat );
+        exit( 1 );
+    }
+
+    OGRDataSourceH hDS = OGR_Dr_CreateDataSource( hDriver, pszFilename,
+                                                  NULL );
+    if( hDS == NULL )
+        exit( 1 );
+
+    /* So that the CSV driver reads the fields with their type */
+    char **papszLCO = NULL;
+    if( EQUAL(pszFormat, "CSV") )
+        papszLCO = CSLSetNameValue( papszLCO, "CREATE_CSVT", "YES" );
+
+    OGRLayerH hLayer = OGR_DS_CreateLayer( hDS, CPLGetBasename(pszFilename),
+                                           NULL, wkbPoint, papszLCO );
+    CSLDestroy( papszLCO );
+    if( hLayer == NULL )
+        exit( 1 );
+
+    OGRFieldDefnH hFieldDefn = OGR_Fld_Create( "id", OFTInteger );
+    OGR_L_CreateField( hLayer, hFieldDefn, TRUE );
+    OGR_Fld_Destroy( hFieldDefn );
+
+    hFieldDefn = OGR_Fld_Create( "val", OFTReal );
+    OGR_L_CreateField( hLayer, hFieldDefn, TRUE );
+    OGR_Fld_Destroy( hFieldDefn );
+
+    hFieldDefn = OGR_Fld_Create( "name", OFTString );
+    OGR_Fld_SetWidth( hFieldDefn, 16 );
+    OGR_L_CreateField( hLayer, hFieldDefn, TRUE );
+    OGR_Fld_Destroy( hFieldDefn );
+
+    GUInt32 nState = 1;
+    for( int i = 0; i < nFeatureCount; i++ )
+    {
+        OGRFeatureH hFeature = OGR_F_Create( OGR_L_GetLayerDefn(hLayer) );
+        nState = nState * 1103515245U + 12345U;
+
+        OGR_F_SetFieldInteger( hFeature, 0, i );
+        OGR_F_SetFieldDouble( hFeature, 1, (nState >> 8) % 100000 / 100.0 );
+        /* Leave some names unset */
+        if( i % 100 != 99 )
+            OGR_F_SetFieldString( hFeature, 2,
+                                  CPLSPrintf( "name_%d", i % 1000 ) );
+
+        OGRGeometryH hPoint = OGR_G_CreateGeometry( wkbPoint );
+        OGR_G_SetPoint_2D( hPoint, 0, i % 1000, i / 1000 );
+        OGR_F_SetGeometryDirectly( hFeature, hPoint );
+
+        if( OGR_L_CreateFeature( hLayer, hFeature ) != OGRERR_NONE )
+            exit( 1 );
+        OGR_F_Destroy( hFeature );
+    }
+
+    OGR_DS_Destroy( hDS );
+}
+
+/************************************************************************/
+/*                              Measure()                               */
+/*                                                                      */
+/*      Read all the features of the layer matching the filter, and     */
+/*      return the elapsed time.                                        */
+/************************************************************************/
+
+static double Measure( OGRLayerH hLayer, const char *pszWhere,
+                       const char *pszCompile, GIntBig *pnMatching )
+
+{
+    CPLSetConfigOption( "OGR_SQL_COMPILE_EXPRESSIONS", pszCompile );
+    if( OGR_L_SetAttributeFilter( hLayer, pszWhere ) != OGRERR_NONE )
+        exit( 1 );
+    CPLSetConfigOption( "OGR_SQL_COMPILE_EXPRESSIONS", NULL );
+
+    double dfStart = GetWallClockTime();
+    OGRFeatureH hFeature;
+    GIntBig nMatching = 0;
+
+    OGR_L_ResetReading( hLayer );
+    while( (hFeature = OGR_L_GetNextFeature( hLayer )) != NULL )
+    {
+        nMatching ++;
+        OGR_F_Destroy( hFeature );
+    }
+
+    *pnMatching = nMatching;
+    return GetWallClockTime() - dfStart;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    const char *pszDataSource = NULL, *pszLayer = NULL;
+    const char *pszCreateFormat = NULL;
+    int nFeatureCount = 0;
+    char **papszFilters = NULL;
+
+    argc = OGRGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    OGRRegisterAll();
+
+    for( int iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-create") && iArg < argc-1 )
+            pszCreateFormat = argv[++iArg];
+        else if( EQUAL(argv[iArg],"-n") && iArg < argc-1 )
+            nFeatureCount = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-where") && iArg < argc-1 )
+            papszFilters = CSLAddString( papszFilters, argv[++iArg] );
+        else if( argv[iArg][0] == '-' )
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+        else if( pszDataSource == NULL )
+            pszDataSource = argv[iArg];
+        else if( pszLayer == NULL )
+            pszLayer = argv[iArg];
+        else
+            Usage();
+    }
+
+    if( pszDataSource == NULL || (pszCreateFormat != NULL && nFeatureCount < 1) )
+        Usage();
+
+    if( pszCreateFormat != NULL )
+    {
+        double dfStart = GetWallClockTime();
+        CreateDataset( pszCreateFormat, pszDataSource, nFeatureCount );
+        printf( "Created %d features in %.2f s.\n", nFeatureCount,
+                GetWallClockTime() - dfStart );
+        if( papszFilters == NULL )
+            papszFilters = CSLDuplicate( (char**) apszDefaultFilters );
+    }
+
+    if( papszFilters == NULL )
+        Usage();
+
+    OGRDataSourceH hDS = OGROpen( pszDataSource, FALSE, NULL );
+    if( hDS == NULL )
+    {
+        printf( "Cannot open %s.\n", pszDataSource );
+        exit( 1 );
+    }
+
+    OGRLayerH hLayer = pszLayer ? OGR_DS_GetLayerByName( hDS, pszLayer ) :
+                                  OGR_DS_GetLayer( hDS, 0 );
+    if( hLayer == NULL )
+    {
+        printf( "Cannot find layer.\n" );
+        exit( 1 );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read once without filter, which also warms the file cache.      */
+/* -------------------------------------------------------------------- */
+    GIntBig nMatching;
+    Measure( hLayer, NULL, "YES", &nMatching );
+    double dfNoFilter = Measure( hLayer, NULL, "YES", &nMatching );
+    printf( "No filter: " CPL_FRMT_GIB " features in %.3f s.\n",
+            nMatching, dfNoFilter );
+    printf( "\n%-50s %10s %10s %10s %8s\n",
+            "filter", "matching", "tree (s)", "compiled", "speedup" );
+
+    int bMismatch = FALSE;
+    for( int i = 0; papszFilters[i] != NULL; i++ )
+    {
+        GIntBig nMatchingTree, nMatchingCompiled;
+        double dfTree = Measure( hLayer, papszFilters[i], "NO",
+                                 &nMatchingTree );
+        double dfCompiled = Measure( hLayer, papszFilters[i], "YES",
+                                     &nMatchingCompiled );
+
+        double dfSpeedup = (dfCompiled > 0) ? dfTree / dfCompiled : 0.0;
+
+        printf( "%-50s %10" CPL_FRMT_GB_WITHOUT_PREFIX "d %10.3f %10.3f "
+                "%7.1fx%s\n",
+                papszFilters[i], nMatchingCompiled, dfTree, dfCompiled,
+                dfSpeedup,
+                nMatchingTree == nMatchingCompiled ? "" :
+                "  (the evaluators do not agree)" );
+        if( nMatchingTree != nMatchingCompiled )
+            bMismatch = TRUE;
+    }
+
+    OGR_DS_Destroy( hDS );
+    CSLDestroy( papszFilters );
+    CSLDestroy( argv );
+
+    OGRCleanupAll();
+
+    return bMismatch ? 1 : 0;
+}
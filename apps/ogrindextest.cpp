@@ -0,0 +1,210 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Test of the generic attribute indexes of layers of drivers
+ *           without index support, when they are up to date and when the
+ *           data has been modified after their creation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_api.h"
+#include "ogr_p.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+CPL_CVSID("$Id$");
+
+#define TEST_DIR        "/vsimem/ogrindextest"
+#define TEST_FILENAME   TEST_DIR "/test.json"
+
+static int nFailures = 0;
+
+/************************************************************************/
+/*                            WriteGeoJSON()                            */
+/*                                                                      */
+/*      Write a GeoJSON file with 10 points, whose val field is 1 to    */
+/*      10, except for the point of index iChanged that gets nNewVal.   */
+/************************************************************************/
+
+static void WriteGeoJSON( int iChanged, int nNewVal )
+
+{
+    CPLString osJSON = "{ \"type\": \"FeatureCollection\", \"features\": [\n";
+    for( int i = 0; i < 10; i++ )
+    {
+        osJSON += CPLSPrintf(
+            "%s{ \"type\": \"Feature\", \"properties\": { \"val\": %d }, "
+            "\"geometry\": { \"type\": \"Point\", \"coordinates\": [%d, 0] } }\n",
+            i > 0 ? "," : "", i == iChanged ? nNewVal : i + 1, i );
+    }
+    osJSON += "] }\n";
+
+    VSILFILE *fp = VSIFOpenL( TEST_FILENAME, "wb" );
+    VSIFWriteL( osJSON.c_str(), 1, osJSON.size(), fp );
+    VSIFCloseL( fp );
+}
+
+/************************************************************************/
+/*                             CheckCounts()                            */
+/*                                                                      */
+/*      Check that SELECT COUNT(*) and SELECT * agree, and give the     */
+/*      expected number of features.                                    */
+/************************************************************************/
+
+static void CheckCounts( const char *pszName, OGRDataSourceH hDS,
+                         const char *pszWhere, int nExpected )
+
+{
+    OGRLayerH hLayer = OGR_DS_GetLayer( hDS, 0 );
+    CPLString osLayerName = OGR_L_GetName( hLayer );
+    CPLString osSQL;
+
+    osSQL.Printf( "SELECT COUNT(*) FROM \"%s\" WHERE %s",
+                  osLayerName.c_str(), pszWhere );
+    OGRLayerH hSQLLayer = OGR_DS_ExecuteSQL( hDS, osSQL, NULL, NULL );
+    int nCount = -1;
+    if( hSQLLayer != NULL )
+    {
+        OGRFeatureH hFeat = OGR_L_GetNextFeature( hSQLLayer );
+        if( hFeat != NULL )
+        {
+            nCount = OGR_F_GetFieldAsInteger( hFeat, 0 );
+            OGR_F_Destroy( hFeat );
+        }
+        OGR_DS_ReleaseResultSet( hDS, hSQLLayer );
+    }
+
+    osSQL.Printf( "SELECT * FROM \"%s\" WHERE %s",
+                  osLayerName.c_str(), pszWhere );
+    hSQLLayer = OGR_DS_ExecuteSQL( hDS, osSQL, NULL, NULL );
+    int nSelected = 0;
+    if( hSQLLayer != NULL )
+    {
+        OGRFeatureH hFeat;
+        while( (hFeat = OGR_L_GetNextFeature( hSQLLayer )) != NULL )
+        {
+            nSelected ++;
+            OGR_F_Destroy( hFeat );
+        }
+        OGR_DS_ReleaseResultSet( hDS, hSQLLayer );
+    }
+
+    if( nCount != nSelected || nCount != nExpected )
+    {
+        printf( "FAILURE: %s: COUNT(*) = %d, SELECT * returned %d features, "
+                "expected %d\n", pszName, nCount, nSelected, nExpected );
+        nFailures ++;
+    }
+    else
+        printf( "OK: %s\n", pszName );
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    OGRRegisterAll();
+
+    argc = OGRGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    /* The GeoJSON layers support random reading in streaming mode only */
+    CPLSetConfigOption( "GEOJSON_STREAMING", "YES" );
+
+    VSIMkdir( TEST_DIR, 0755 );
+
+/* -------------------------------------------------------------------- */
+/*      Index the layer.                                                */
+/* -------------------------------------------------------------------- */
+    WriteGeoJSON( -1, 0 );
+
+    OGRDataSourceH hDS = OGROpen( TEST_FILENAME, FALSE, NULL );
+    if( hDS == NULL )
+    {
+        printf( "Cannot open %s\n", TEST_FILENAME );
+        exit( 1 );
+    }
+    CPLString osSQL;
+    osSQL.Printf( "CREATE INDEX ON \"%s\" USING val",
+                  OGR_L_GetName( OGR_DS_GetLayer( hDS, 0 ) ) );
+    OGR_DS_ExecuteSQL( hDS, osSQL, NULL, NULL );
+    OGR_DS_Destroy( hDS );
+
+    char **papszFiles = VSIReadDir( TEST_DIR );
+    int bHasIndex = FALSE;
+    for( int i = 0; papszFiles != NULL && papszFiles[i] != NULL; i++ )
+    {
+        if( EQUAL(CPLGetExtension(papszFiles[i]), "oim") )
+            bHasIndex = TRUE;
+    }
+    CSLDestroy( papszFiles );
+    if( !bHasIndex )
+    {
+        printf( "FAILURE: no index created\n" );
+        nFailures ++;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Up to date index.                                               */
+/* -------------------------------------------------------------------- */
+    hDS = OGROpen( TEST_FILENAME, FALSE, NULL );
+    CheckCounts( "up to date index, range", hDS, "val < 5", 4 );
+    CheckCounts( "up to date index, equality", hDS, "val = 3", 1 );
+    OGR_DS_Destroy( hDS );
+
+/* -------------------------------------------------------------------- */
+/*      Stale index: the value 3 is changed to 100 after the index      */
+/*      creation, so the index still lists that feature for val < 5.    */
+/* -------------------------------------------------------------------- */
+    WriteGeoJSON( 2, 100 );
+
+    hDS = OGROpen( TEST_FILENAME, FALSE, NULL );
+    CheckCounts( "stale index, range", hDS, "val < 5", 3 );
+    CheckCounts( "stale index, equality", hDS, "val = 3", 0 );
+    OGR_DS_Destroy( hDS );
+
+/* -------------------------------------------------------------------- */
+/*      Cleanup.                                                        */
+/* -------------------------------------------------------------------- */
+    papszFiles = VSIReadDir( TEST_DIR );
+    for( int i = 0; papszFiles != NULL && papszFiles[i] != NULL; i++ )
+        VSIUnlink( CPLFormFilename( TEST_DIR, papszFiles[i], NULL ) );
+    CSLDestroy( papszFiles );
+    VSIRmdir( TEST_DIR );
+
+    OGRCleanupAll();
+    CSLDestroy( argv );
+
+    if( nFailures )
+    {
+        printf( "%d failure(s)\n", nFailures );
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Test of resampled RasterIO() reads against the overviews
+ *           computed by GDALRegenerateOverviews(), and of their progress
+ *           callback.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_string.h"
+
+CPL_CVSID("$Id$");
+
+#define SRC_XSIZE   64
+#define SRC_YSIZE   48
+#define DST_XSIZE   (SRC_XSIZE / 2)
+#define DST_YSIZE   (SRC_YSIZE / 2)
+
+static int nFailures = 0;
+
+/************************************************************************/
+/*                            CreateSource()                            */
+/*                                                                      */
+/*      Create a one band Float32 MEM dataset. A linear ramp is         */
+/*      written when bRamp is TRUE, otherwise pseudo-random values      */
+/*      that are constant over each 2x2 block.                          */
+/************************************************************************/
+
+static GDALDatasetH CreateSource( int bRamp )
+
+{
+    GDALDatasetH hDS = GDALCreate( GDALGetDriverByName("MEM"), "",
+                                   SRC_XSIZE, SRC_YSIZE, 1,
+                                   GDT_Float32, NULL );
+    float afValues[SRC_XSIZE * SRC_YSIZE];
+
+    for( int iY = 0; iY < SRC_YSIZE; iY++ )
+    {
+        for( int iX = 0; iX < SRC_XSIZE; iX++ )
+        {
+            if( bRamp )
+                afValues[iY * SRC_XSIZE + iX] = (float) (3 * iX + 5 * iY);
+            else
+                afValues[iY * SRC_XSIZE + iX] =
+                    (float) (((iX / 2) * 7919 + (iY / 2) * 104729) % 251);
+        }
+    }
+
+    GDALRasterIO( GDALGetRasterBand(hDS, 1), GF_Write,
+                  0, 0, SRC_XSIZE, SRC_YSIZE,
+                  afValues, SRC_XSIZE, SRC_YSIZE, GDT_Float32, 0, 0 );
+
+    return hDS;
+}
+
+/************************************************************************/
+/*                           CompareToOverview()                        */
+/*                                                                      */
+/*      Compare the read of the whole source at half resolution with    */
+/*      eResampleAlg to the overview computed with pszResampling.       */
+/*      When nMargin is not 0, the pixels that close to the edges are   */
+/*      ignored.                                                        */
+/************************************************************************/
+
+static void CompareToOverview( const char *pszName, int bRamp,
+                               GDALRIOResampleAlg eResampleAlg,
+                               const char *pszResampling, int nMargin )
+
+{
+    GDALDatasetH hSrcDS = CreateSource( bRamp );
+    GDALDatasetH hOvrDS = GDALCreate( GDALGetDriverByName("MEM"), "",
+                                      DST_XSIZE, DST_YSIZE, 1,
+                                      GDT_Float32, NULL );
+    GDALRasterBandH hSrcBand = GDALGetRasterBand( hSrcDS, 1 );
+    GDALRasterBandH hOvrBand = GDALGetRasterBand( hOvrDS, 1 );
+    float afRead[DST_XSIZE * DST_YSIZE];
+    float afOverview[DST_XSIZE * DST_YSIZE];
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.eResampleAlg = eResampleAlg;
+
+    if( GDALRasterIOEx( hSrcBand, GF_Read, 0, 0, SRC_XSIZE, SRC_YSIZE,
+                        afRead, DST_XSIZE, DST_YSIZE, GDT_Float32, 0, 0,
+                        &sExtraArg ) != CE_None )
+    {
+        printf( "FAILURE: %s: resampled read failed (%s)\n",
+                pszName, CPLGetLastErrorMsg() );
+        nFailures ++;
+    }
+    else if( GDALRegenerateOverviews( hSrcBand, 1, &hOvrBand, pszResampling,
+                                      NULL, NULL ) != CE_None ||
+             GDALRasterIO( hOvrBand, GF_Read, 0, 0, DST_XSIZE, DST_YSIZE,
+                           afOverview, DST_XSIZE, DST_YSIZE, GDT_Float32,
+                           0, 0 ) != CE_None )
+    {
+        printf( "FAILURE: %s: overview computation failed (%s)\n",
+                pszName, CPLGetLastErrorMsg() );
+        nFailures ++;
+    }
+    else
+    {
+        int nDiffs = 0;
+        for( int iY = nMargin; iY < DST_YSIZE - nMargin; iY++ )
+        {
+            for( int iX = nMargin; iX < DST_XSIZE - nMargin; iX++ )
+            {
+                const int i = iY * DST_XSIZE + iX;
+                if( fabs(afRead[i] - afOverview[i]) > 1e-4 )
+                {
+                    if( nDiffs == 0 )
+                        printf( "FAILURE: %s: got %.8g at (%d,%d), "
+                                "expected %.8g\n",
+                                pszName, afRead[i], iX, iY, afOverview[i] );
+                    nDiffs ++;
+                }
+            }
+        }
+        if( nDiffs )
+            nFailures ++;
+        else
+            printf( "OK: %s\n", pszName );
+    }
+
+    GDALClose( hOvrDS );
+    GDALClose( hSrcDS );
+}
+
+/************************************************************************/
+/*                           CountProgress()                            */
+/************************************************************************/
+
+typedef struct
+{
+    int     nCalls;
+    double  dfLastComplete;
+    int     bCancel;
+} ProgressInfo;
+
+static int CPL_STDCALL CountProgress( double dfComplete,
+                                      const char * /* pszMessage */,
+                                      void *pProgressArg )
+
+{
+    ProgressInfo *psInfo = (ProgressInfo *) pProgressArg;
+
+    psInfo->nCalls ++;
+    psInfo->dfLastComplete = dfComplete;
+
+    return !psInfo->bCancel;
+}
+
+/************************************************************************/
+/*                           CheckProgress()                            */
+/*                                                                      */
+/*      Check that a resampled read reports its progress, and fails     */
+/*      when the progress callback requests it to stop.                 */
+/************************************************************************/
+
+static void CheckProgress( const char *pszName,
+                           GDALRIOResampleAlg eResampleAlg, int bCancel )
+
+{
+    GDALDatasetH hSrcDS = CreateSource( TRUE );
+    float afRead[DST_XSIZE * DST_YSIZE];
+    ProgressInfo sInfo = { 0, 0.0, bCancel };
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.eResampleAlg = eResampleAlg;
+    sExtraArg.pfnProgress = CountProgress;
+    sExtraArg.pProgressData = &sInfo;
+
+    CPLErrorReset();
+    CPLPushErrorHandler( CPLQuietErrorHandler );
+    CPLErr eErr = GDALRasterIOEx( GDALGetRasterBand(hSrcDS, 1), GF_Read,
+                                  0, 0, SRC_XSIZE, SRC_YSIZE,
+                                  afRead, DST_XSIZE, DST_YSIZE, GDT_Float32,
+                                  0, 0, &sExtraArg );
+    CPLPopErrorHandler();
+
+    if( sInfo.nCalls == 0 )
+    {
+        printf( "FAILURE: %s: progress callback not called\n", pszName );
+        nFailures ++;
+    }
+    else if( bCancel && eErr != CE_Failure )
+    {
+        printf( "FAILURE: %s: interrupted read did not fail\n", pszName );
+        nFailures ++;
+    }
+    else if( bCancel && CPLGetLastErrorNo() != CPLE_UserInterrupt )
+    {
+        printf( "FAILURE: %s: unexpected error '%s'\n",
+                pszName, CPLGetLastErrorMsg() );
+        nFailures ++;
+    }
+    else if( !bCancel && (eErr != CE_None || sInfo.dfLastComplete != 1.0) )
+    {
+        printf( "FAILURE: %s: read failed or did not complete "
+                "(last progress %g)\n", pszName, sInfo.dfLastComplete );
+        nFailures ++;
+    }
+    else
+        printf( "OK: %s\n", pszName );
+
+    GDALClose( hSrcDS );
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    GDALAllRegister();
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    if( GDALGetDriverByName( "MEM" ) == NULL )
+    {
+        printf( "MEM driver not available\n" );
+        exit( 1 );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Nearest neighbour picks its pixel at a different place within  */
+/*      the 2x2 footprint than the overview code, so use blocks of      */
+/*      constant values. Bilinear has no overview equivalent, but it    */
+/*      gives the same result as the average on a linear ramp, away     */
+/*      from the edges where its kernel is truncated.                   */
+/* -------------------------------------------------------------------- */
+    CompareToOverview( "nearest", FALSE, GRIORA_NearestNeighbour,
+                       "NEAREST", 0 );
+    CompareToOverview( "average", FALSE, GRIORA_Average, "AVERAGE", 0 );
+    CompareToOverview( "average on ramp", TRUE, GRIORA_Average,
+                       "AVERAGE", 0 );
+    CompareToOverview( "bilinear on ramp", TRUE, GRIORA_Bilinear,
+                       "AVERAGE", 1 );
+
+    CheckProgress( "bilinear progress", GRIORA_Bilinear, FALSE );
+    CheckProgress( "average progress", GRIORA_Average, FALSE );
+    CheckProgress( "bilinear interrupted", GRIORA_Bilinear, TRUE );
+    CheckProgress( "average interrupted", GRIORA_Average, TRUE );
+
+    GDALDestroyDriverManager();
+    CSLDestroy( argv );
+
+    if( nFailures )
+    {
+        printf( "%d failure(s)\n", nFailures );
+        return 1;
+    }
+    return 0;
+}
@@ -593,7 +593,7 @@ static int TestOGRLayerFeatureCount( GDALDataset* poDS, OGRLayer *poLayer, int b
 
 {
     int bRet = TRUE;
-    int         nFC = 0, nClaimedFC = poLayer->GetFeatureCount();
+    GIntBig     nFC = 0, nClaimedFC = poLayer->GetFeatureCount();
     OGRFeature  *poFeature;
     int         bWarnAboutSRS = FALSE;
     OGRFeatureDefn* poLayerDefn = poLayer->GetLayerDefn();
@@ -669,14 +669,14 @@ static int TestOGRLayerFeatureCount( GDALDataset* poDS, OGRLayer *poLayer, int b
     if( nFC != nClaimedFC )
     {
         bRet = FALSE;
-        printf( "ERROR: Claimed feature count %d doesn't match actual, %d.\n",
+        printf( "ERROR: Claimed feature count " CPL_FRMT_GIB " doesn't match actual, " CPL_FRMT_GIB ".\n",
                 nClaimedFC, nFC );
     }
     else if( nFC != poLayer->GetFeatureCount() )
     {
         bRet = FALSE;
-        printf( "ERROR: Feature count at end of layer %d differs "
-                "from at start, %d.\n",
+        printf( "ERROR: Feature count at end of layer " CPL_FRMT_GIB " differs "
+                "from at start, " CPL_FRMT_GIB ".\n",
                 nFC, poLayer->GetFeatureCount() );
     }
     else if( bVerbose )
@@ -700,7 +700,7 @@ static int TestOGRLayerFeatureCount( GDALDataset* poDS, OGRLayer *poLayer, int b
             else if (nClaimedFC != poFeatCount->GetFieldAsInteger(0))
             {
                 bRet = FALSE;
-                printf( "ERROR: Claimed feature count %d doesn't match '%s' one, %d.\n",
+                printf( "ERROR: Claimed feature count " CPL_FRMT_GIB " doesn't match '%s' one, %d.\n",
                         nClaimedFC, osSQL.c_str(), poFeatCount->GetFieldAsInteger(0) );
             }
             OGRFeature::DestroyFeature(poFeatCount);
@@ -736,7 +736,7 @@ static int TestOGRLayerRandomRead( OGRLayer *poLayer )
     if( poLayer->GetFeatureCount() < 5 )
     {
         if( bVerbose )
-            printf( "INFO: Only %d features on layer,"
+            printf( "INFO: Only " CPL_FRMT_GIB " features on layer,"
                     "skipping random read test.\n",
                     poLayer->GetFeatureCount() );
         
@@ -771,7 +771,7 @@ static int TestOGRLayerRandomRead( OGRLayer *poLayer )
     poFeature = poLayer->GetFeature( papoFeatures[1]->GetFID() );
     if (poFeature == NULL)
     {
-        printf( "ERROR: Cannot fetch feature %ld.\n",
+        printf( "ERROR: Cannot fetch feature " CPL_FRMT_GIB ".\n",
                  papoFeatures[1]->GetFID() );
         goto end;
     }
@@ -779,7 +779,7 @@ static int TestOGRLayerRandomRead( OGRLayer *poLayer )
     if( !poFeature->Equal( papoFeatures[1] ) )
     {
         bRet = FALSE;
-        printf( "ERROR: Attempt to randomly read feature %ld appears to\n"
+        printf( "ERROR: Attempt to randomly read feature " CPL_FRMT_GIB " appears to\n"
                 "       have returned a different feature than sequential\n"
                 "       reading indicates should have happened.\n",
                 papoFeatures[1]->GetFID() );
@@ -798,7 +798,7 @@ static int TestOGRLayerRandomRead( OGRLayer *poLayer )
     if( poFeature == NULL || !poFeature->Equal( papoFeatures[4] ) )
     {
         bRet = FALSE;
-        printf( "ERROR: Attempt to randomly read feature %ld appears to\n"
+        printf( "ERROR: Attempt to randomly read feature " CPL_FRMT_GIB " appears to\n"
                 "       have returned a different feature than sequential\n"
                 "       reading indicates should have happened.\n",
                 papoFeatures[4]->GetFID() );
@@ -841,7 +841,7 @@ static int TestOGRLayerSetNextByIndex( OGRLayer *poLayer )
     if( poLayer->GetFeatureCount() < 5 )
     {
         if( bVerbose )
-            printf( "INFO: Only %d features on layer,"
+            printf( "INFO: Only " CPL_FRMT_GIB " features on layer,"
                     "skipping SetNextByIndex test.\n",
                     poLayer->GetFeatureCount() );
         
@@ -977,7 +977,7 @@ static int TestOGRLayerRandomWrite( OGRLayer *poLayer )
     if( poLayer->GetFeatureCount() < 5 )
     {
         if( bVerbose )
-            printf( "INFO: Only %d features on layer,"
+            printf( "INFO: Only " CPL_FRMT_GIB " features on layer,"
                     "skipping random write test.\n",
                     poLayer->GetFeatureCount() );
         
@@ -1112,7 +1112,7 @@ static int TestSpatialFilter( OGRLayer *poLayer, int iGeomField )
     OGRPolygon  oInclusiveFilter, oExclusiveFilter;
     OGRLinearRing oRing;
     OGREnvelope sEnvelope;
-    int         nInclusiveCount;
+    GIntBig     nInclusiveCount;
 
 /* -------------------------------------------------------------------- */
 /*      Read the target feature.                                        */
@@ -1444,7 +1444,7 @@ static int TestAttributeFilter( GDALDataset* poDS, OGRLayer *poLayer )
 {
     int bRet = TRUE;
     OGRFeature  *poFeature, *poFeature2, *poFeature3, *poTargetFeature;
-    int         nInclusiveCount, nExclusiveCount, nTotalCount;
+    GIntBig     nInclusiveCount, nExclusiveCount, nTotalCount;
     CPLString osAttributeFilter;
 
 /* -------------------------------------------------------------------- */
@@ -1586,7 +1586,7 @@ static int TestAttributeFilter( GDALDataset* poDS, OGRLayer *poLayer )
 /* -------------------------------------------------------------------- */
     poLayer->ResetReading();
 
-    int nExclusiveCountWhileIterating = 0;
+    GIntBig nExclusiveCountWhileIterating = 0;
     while( (poFeature = poLayer->GetNextFeature()) != NULL )
     {
         if( poFeature->Equal(poTargetFeature) )
@@ -1633,7 +1633,7 @@ static int TestAttributeFilter( GDALDataset* poDS, OGRLayer *poLayer )
     {
         bRet = FALSE;
         printf( "ERROR: GetFeatureCount() may not be taking attribute "
-                "filter into account (nInclusiveCount = %d, nExclusiveCount = %d, nExclusiveCountWhileIterating = %d, nTotalCount = %d).\n",
+                "filter into account (nInclusiveCount = " CPL_FRMT_GIB ", nExclusiveCount = " CPL_FRMT_GIB ", nExclusiveCountWhileIterating = " CPL_FRMT_GIB ", nTotalCount = " CPL_FRMT_GIB ").\n",
                  nInclusiveCount, nExclusiveCount, nExclusiveCountWhileIterating, nTotalCount);
     }
     else if( bVerbose )
@@ -1716,7 +1716,7 @@ static int TestOGRLayerUTF8 ( OGRLayer *poLayer )
                     {
                         if (!bIsUTF8)
                         {
-                            printf( "ERROR: Found non-UTF8 content at field %d of feature %ld, but layer is advertized as UTF-8.\n",
+                            printf( "ERROR: Found non-UTF8 content at field %d of feature " CPL_FRMT_GIB ", but layer is advertized as UTF-8.\n",
                                     i, poFeature->GetFID() );
                             bRet = FALSE;
                             break;
@@ -2006,7 +2006,7 @@ static int TestTransactions( OGRLayer *poLayer )
 
 {
     OGRFeature* poFeature = NULL;
-    int nInitialFeatureCount = poLayer->GetFeatureCount();
+    GIntBig nInitialFeatureCount = poLayer->GetFeatureCount();
 
     OGRErr eErr = poLayer->StartTransaction();
     if (eErr == OGRERR_NONE)
@@ -27,59 +27,153 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
-#include <assert.h>
-
 #include "cpl_string.h"
-#include "cpl_atomic_ops.h"
 #include "cpl_multiproc.h"
 #include "ogr_spatialref.h"
+#include "ogr_geometry.h"
+#include "commonutils.h"
 
 CPL_CVSID("$Id$");
 
+#define POINT_COUNT         1024
+#define GEOM_POINT_COUNT    8
+#define GEOM_COUNT          (POINT_COUNT / GEOM_POINT_COUNT)
+
+#define MODE_POINTS         0
+#define MODE_GEOMETRIES     1
+#define MODE_BULK           2
+#define MODE_COUNT          3
+
+static const char * const apszModeNames[MODE_COUNT] =
+    { "OGRCoordinateTransformation::TransformEx()",
+      "OGRGeometry::transform()",
+      "OGRGeometryFactory::transformGeometries()" };
+
 double* padfRefX;
 double* padfRefY;
 double* padfRefResultX;
 double* padfRefResultY;
 OGRCoordinateTransformation *poCT;
-volatile int nIter = 0;
 int bCreateCTInThread = FALSE;
 OGRSpatialReference oSrcSRS, oDstSRS;
 int nCountIter = 10000;
 
-void ReprojFunc(void* unused)
+typedef struct
 {
+    int     nMode;
+    int     nIterations;
+    int     bMismatch;
+} ReprojJob;
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "testreprojmulti [-threads <max_thread#>] [-iter <iterations>]\n"
+            "                [-createctinthread] [-s_srs <srs_def>]\n"
+            "                [-t_srs <srs_def>]\n"
+            "\n"
+            "Transforms %d points per iteration from 1 to max_thread#\n"
+            "threads sharing the same transformation object (or each\n"
+            "creating its own if -createctinthread is specified), as point\n"
+            "arrays, as %d line strings transformed one at a time, and as\n"
+            "the same line strings transformed with a single call, and\n"
+            "reports the throughput.\n", POINT_COUNT, GEOM_COUNT );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                             ReprojFunc()                             */
+/************************************************************************/
+
+static void ReprojFunc( void* pData )
+{
+    ReprojJob *psJob = (ReprojJob *) pData;
     double* padfResultX;
     double* padfResultY;
-    padfResultX = (double*)CPLMalloc(1024 * sizeof(double));
-    padfResultY = (double*)CPLMalloc(1024 * sizeof(double));
-    OGRCoordinateTransformation *poCTInThread;
-    if (!bCreateCTInThread)
-        poCTInThread = poCT;
-    while(TRUE)
+    padfResultX = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
+    padfResultY = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
+    OGRGeometry* apoGeoms[GEOM_COUNT];
+    int i, iGeom;
+
+    for( iGeom = 0; iGeom < GEOM_COUNT; iGeom++ )
+        apoGeoms[iGeom] = new OGRLineString();
+
+    OGRCoordinateTransformation *poCTInThread = poCT;
+    for( int iIter = 0; iIter < psJob->nIterations; iIter++ )
     {
         if (bCreateCTInThread)
             poCTInThread = OGRCreateCoordinateTransformation(&oSrcSRS,&oDstSRS);
 
-        CPLAtomicInc(&nIter);
-        memcpy(padfResultX, padfRefX, 1024 * sizeof(double));
-        memcpy(padfResultY, padfRefY, 1024 * sizeof(double));
-        poCT->TransformEx( 1024, padfResultX, padfResultY, NULL, NULL );
+        if( psJob->nMode == MODE_POINTS )
+        {
+            memcpy(padfResultX, padfRefX, POINT_COUNT * sizeof(double));
+            memcpy(padfResultY, padfRefY, POINT_COUNT * sizeof(double));
+            poCTInThread->TransformEx( POINT_COUNT, padfResultX, padfResultY,
+                                       NULL, NULL );
+        }
+        else
+        {
+            for( iGeom = 0; iGeom < GEOM_COUNT; iGeom++ )
+            {
+                ((OGRLineString *) apoGeoms[iGeom])->setPoints(
+                    GEOM_POINT_COUNT,
+                    padfRefX + iGeom * GEOM_POINT_COUNT,
+                    padfRefY + iGeom * GEOM_POINT_COUNT );
+            }
+
+            if( psJob->nMode == MODE_GEOMETRIES )
+            {
+                for( iGeom = 0; iGeom < GEOM_COUNT; iGeom++ )
+                    apoGeoms[iGeom]->transform( poCTInThread );
+            }
+            else
+            {
+                OGRGeometryFactory::transformGeometries( poCTInThread,
+                                                         GEOM_COUNT,
+                                                         apoGeoms );
+            }
+
+            for( iGeom = 0; iGeom < GEOM_COUNT; iGeom++ )
+            {
+                OGRLineString *poLS = (OGRLineString *) apoGeoms[iGeom];
+                for( i = 0; i < GEOM_POINT_COUNT; i++ )
+                {
+                    padfResultX[iGeom * GEOM_POINT_COUNT + i] = poLS->getX(i);
+                    padfResultY[iGeom * GEOM_POINT_COUNT + i] = poLS->getY(i);
+                }
+            }
+        }
 
         /* Check that the results are consistant with the reference results */
-        assert(memcmp(padfResultX, padfRefResultX, 1024 * sizeof(double)) == 0);
-        assert(memcmp(padfResultY, padfRefResultY, 1024 * sizeof(double)) == 0);
+        if( memcmp(padfResultX, padfRefResultX, POINT_COUNT * sizeof(double)) != 0 ||
+            memcmp(padfResultY, padfRefResultY, POINT_COUNT * sizeof(double)) != 0 )
+            psJob->bMismatch = TRUE;
 
         if (bCreateCTInThread)
             OGRCoordinateTransformation::DestroyCT(poCTInThread);
     }
+
+    for( iGeom = 0; iGeom < GEOM_COUNT; iGeom++ )
+        delete apoGeoms[iGeom];
+    CPLFree(padfResultX);
+    CPLFree(padfResultY);
 }
 
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
 int main(int argc, char* argv[])
 {
     int nThreads = 2;
-    
+    const char *pszSrcSRS = "EPSG:4326";
+    const char *pszDstSRS = "EPSG:32631";
+
     int i;
-    for(i=0;i<argc;i++)
+    for(i=1;i<argc;i++)
     {
         if (EQUAL(argv[i], "-threads") && i+1 < argc)
             nThreads = atoi(argv[++i]);
@@ -87,34 +181,117 @@ int main(int argc, char* argv[])
             nCountIter = atoi(argv[++i]);
         else if (EQUAL(argv[i], "-createctinthread"))
             bCreateCTInThread = TRUE;
+        else if (EQUAL(argv[i], "-s_srs") && i+1 < argc)
+            pszSrcSRS = argv[++i];
+        else if (EQUAL(argv[i], "-t_srs") && i+1 < argc)
+            pszDstSRS = argv[++i];
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[i] );
+            Usage();
+        }
+    }
+
+    if( nThreads < 1 || nCountIter < 1 )
+        Usage();
+
+    if( oSrcSRS.SetFromUserInput(pszSrcSRS) != OGRERR_NONE ||
+        oDstSRS.SetFromUserInput(pszDstSRS) != OGRERR_NONE )
+    {
+        printf( "Invalid SRS definition.\n" );
+        return 1;
     }
 
-    oSrcSRS.importFromEPSG(4326);
-    oDstSRS.importFromEPSG(32631);
     poCT = OGRCreateCoordinateTransformation(&oSrcSRS,&oDstSRS);
     if (poCT == NULL)
-        return -1;
+        return 1;
 
-    padfRefX = (double*)CPLMalloc(1024 * sizeof(double));
-    padfRefY = (double*)CPLMalloc(1024 * sizeof(double));
-    padfRefResultX = (double*)CPLMalloc(1024 * sizeof(double));
-    padfRefResultY = (double*)CPLMalloc(1024 * sizeof(double));
+    padfRefX = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
+    padfRefY = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
+    padfRefResultX = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
+    padfRefResultY = (double*)CPLMalloc(POINT_COUNT * sizeof(double));
 
-    for(i=0;i<1024;i++)
+    for(i=0;i<POINT_COUNT;i++)
     {
-        padfRefX[i] = 2 + i / 1024.;
-        padfRefY[i] = 49 + i / 1024.;
+        padfRefX[i] = 2 + i / (double)POINT_COUNT;
+        padfRefY[i] = 49 + i / (double)POINT_COUNT;
+    }
+    memcpy(padfRefResultX, padfRefX, POINT_COUNT * sizeof(double));
+    memcpy(padfRefResultY, padfRefY, POINT_COUNT * sizeof(double));
+
+    poCT->TransformEx( POINT_COUNT, padfRefResultX, padfRefResultY, NULL, NULL );
+
+/* -------------------------------------------------------------------- */
+/*      Run the workload with an increasing number of threads.          */
+/* -------------------------------------------------------------------- */
+    int bMismatch = FALSE;
+    ReprojJob *pasJobs = (ReprojJob *) CPLCalloc(sizeof(ReprojJob), nThreads);
+    void **pahThreads = (void **) CPLCalloc(sizeof(void*), nThreads);
+
+    for( int nMode = 0; nMode < MODE_COUNT; nMode++ )
+    {
+        printf( "%d iterations of %d points with %s%s.\n",
+                nCountIter, POINT_COUNT, apszModeNames[nMode],
+                bCreateCTInThread ? ", one transformation per iteration" : "" );
+        printf( "threads  seconds  Mpoints/s  speedup\n" );
+
+        double dfSingleThreadThroughput = 0.0;
+        int nThreadCount = 1;
+
+        while( TRUE )
+        {
+            double dfStart = GetWallClockTime();
+
+            for( i = 0; i < nThreadCount; i++ )
+            {
+                pasJobs[i].nMode = nMode;
+                pasJobs[i].nIterations =
+                    nCountIter / nThreadCount + (i < nCountIter % nThreadCount);
+                pasJobs[i].bMismatch = FALSE;
+                pahThreads[i] = CPLCreateJoinableThread( ReprojFunc,
+                                                         &pasJobs[i] );
+            }
+            for( i = 0; i < nThreadCount; i++ )
+            {
+                CPLJoinThread( pahThreads[i] );
+                if( pasJobs[i].bMismatch )
+                    bMismatch = TRUE;
+            }
+
+            double dfElapsed = GetWallClockTime() - dfStart;
+            if( dfElapsed <= 0.0 )
+                dfElapsed = 1e-6;
+
+            double dfThroughput =
+                (double) nCountIter * POINT_COUNT / dfElapsed / 1e6;
+            if( nThreadCount == 1 )
+                dfSingleThreadThroughput = dfThroughput;
+
+            printf( "%7d  %7.3f  %9.2f  %7.2f\n",
+                    nThreadCount, dfElapsed, dfThroughput,
+                    dfThroughput / dfSingleThreadThroughput );
+
+            if( nThreadCount == nThreads )
+                break;
+            nThreadCount *= 2;
+            if( nThreadCount > nThreads )
+                nThreadCount = nThreads;
+        }
+        printf( "\n" );
     }
-    memcpy(padfRefResultX, padfRefX, 1024 * sizeof(double));
-    memcpy(padfRefResultY, padfRefY, 1024 * sizeof(double));
 
-    poCT->TransformEx( 1024, padfRefResultX, padfRefResultY, NULL, NULL );
+    if( bMismatch )
+        printf( "Some results are not consistant with the reference results!\n" );
 
-    for(i=0;i<nThreads;i++)
-        CPLCreateThread(ReprojFunc, NULL);
+    CPLFree( pasJobs );
+    CPLFree( pahThreads );
+    CPLFree( padfRefX );
+    CPLFree( padfRefY );
+    CPLFree( padfRefResultX );
+    CPLFree( padfRefResultY );
+    OGRCoordinateTransformation::DestroyCT( poCT );
 
-    while(nIter < nCountIter)
-        CPLSleep(0.001);
+    OSRCleanup();
 
-    return 0;
+    return bMismatch ? 1 : 0;
 }
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Test of the pixel function expressions of VRT derived bands,
+ *           including expressions too deeply nested to be accepted.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "cpl_string.h"
+
+CPL_CVSID("$Id$");
+
+#define SOURCE_FILENAME "/vsimem/vrtexpressiontest.tif"
+
+static int nFailures = 0;
+
+/************************************************************************/
+/*                             Repeat()                                 */
+/************************************************************************/
+
+static CPLString Repeat( const char *pszText, int nCount )
+
+{
+    CPLString osRet;
+    for( int i = 0; i < nCount; i++ )
+        osRet += pszText;
+    return osRet;
+}
+
+/************************************************************************/
+/*                           OpenExpression()                           */
+/*                                                                      */
+/*      Open a one band VRT computing the expression from the band of   */
+/*      the source dataset.                                             */
+/************************************************************************/
+
+static GDALDatasetH OpenExpression( const char *pszExpression )
+
+{
+    CPLString osXML;
+    osXML.Printf(
+        "<VRTDataset rasterXSize=\"2\" rasterYSize=\"1\">"
+        "<VRTRasterBand dataType=\"Float64\" band=\"1\""
+        " subClass=\"VRTDerivedRasterBand\">"
+        "<PixelFunctionExpression>%s</PixelFunctionExpression>"
+        "<SimpleSource>"
+        "<SourceFilename>" SOURCE_FILENAME "</SourceFilename>"
+        "<SourceBand>1</SourceBand>"
+        "</SimpleSource>"
+        "</VRTRasterBand>"
+        "</VRTDataset>", pszExpression );
+
+    return GDALOpen( osXML, GA_ReadOnly );
+}
+
+/************************************************************************/
+/*                            CheckValue()                              */
+/*                                                                      */
+/*      Check that the expression gives dfExpected for the first pixel  */
+/*      of the source, whose value is 3.                                */
+/************************************************************************/
+
+static void CheckValue( const char *pszName, const char *pszExpression,
+                        double dfExpected )
+
+{
+    GDALDatasetH hDS = OpenExpression( pszExpression );
+    double adfValues[2] = { 0.0, 0.0 };
+
+    if( hDS == NULL ||
+        GDALRasterIO( GDALGetRasterBand(hDS, 1), GF_Read, 0, 0, 2, 1,
+                      adfValues, 2, 1, GDT_Float64, 0, 0 ) != CE_None )
+    {
+        printf( "FAILURE: %s: cannot evaluate the expression (%s)\n",
+                pszName, CPLGetLastErrorMsg() );
+        nFailures ++;
+    }
+    else if( adfValues[0] != dfExpected )
+    {
+        printf( "FAILURE: %s: got %.18g, expected %.18g\n",
+                pszName, adfValues[0], dfExpected );
+        nFailures ++;
+    }
+    else
+        printf( "OK: %s\n", pszName );
+
+    if( hDS != NULL )
+        GDALClose( hDS );
+}
+
+/************************************************************************/
+/*                           CheckRejected()                            */
+/*                                                                      */
+/*      Check that the opening of the VRT fails with an error, instead  */
+/*      of overflowing the stack.                                       */
+/************************************************************************/
+
+static void CheckRejected( const char *pszName, const char *pszExpression )
+
+{
+    CPLErrorReset();
+    CPLPushErrorHandler( CPLQuietErrorHandler );
+    GDALDatasetH hDS = OpenExpression( pszExpression );
+    CPLPopErrorHandler();
+
+    if( hDS != NULL )
+    {
+        printf( "FAILURE: %s: expression accepted\n", pszName );
+        nFailures ++;
+        GDALClose( hDS );
+    }
+    else if( CPLGetLastErrorType() != CE_Failure ||
+             CPLGetLastErrorNo() != CPLE_AppDefined ||
+             strstr(CPLGetLastErrorMsg(), "nested") == NULL )
+    {
+        printf( "FAILURE: %s: unexpected error '%s'\n",
+                pszName, CPLGetLastErrorMsg() );
+        nFailures ++;
+    }
+    else
+        printf( "OK: %s\n", pszName );
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    GDALAllRegister();
+
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+/* -------------------------------------------------------------------- */
+/*      Create the source dataset.                                      */
+/* -------------------------------------------------------------------- */
+    GDALDriverH hDriver = GDALGetDriverByName( "GTiff" );
+    if( hDriver == NULL )
+    {
+        printf( "GTiff driver not available\n" );
+        exit( 1 );
+    }
+    GDALDatasetH hSrcDS = GDALCreate( hDriver, SOURCE_FILENAME, 2, 1, 1,
+                                      GDT_Float64, NULL );
+    double adfSrcValues[2] = { 3.0, 4.0 };
+    GDALRasterIO( GDALGetRasterBand(hSrcDS, 1), GF_Write, 0, 0, 2, 1,
+                  adfSrcValues, 2, 1, GDT_Float64, 0, 0 );
+    GDALClose( hSrcDS );
+
+/* -------------------------------------------------------------------- */
+/*      Nesting below the limit is accepted.                            */
+/* -------------------------------------------------------------------- */
+    CheckValue( "simple expression", "B1 * 2 + 1", 7.0 );
+    CheckValue( "100 parentheses",
+                (Repeat("(", 100) + "B1" + Repeat(")", 100)).c_str(), 3.0 );
+    CheckValue( "100 negations",
+                (Repeat("-", 100) + "B1").c_str(), 3.0 );
+    CheckValue( "100 terms sum",
+                ("B1" + Repeat(" + B1", 99)).c_str(), 300.0 );
+    CheckValue( "100 nested functions",
+                (Repeat("abs(", 100) + "B1" + Repeat(")", 100)).c_str(), 3.0 );
+
+/* -------------------------------------------------------------------- */
+/*      Over-deep expressions are rejected.                             */
+/* -------------------------------------------------------------------- */
+    const int nDeep = 100000;
+    CheckRejected( "deep parentheses",
+                   (Repeat("(", nDeep) + "B1" + Repeat(")", nDeep)).c_str() );
+    CheckRejected( "deep negations",
+                   (Repeat("-", nDeep) + "B1").c_str() );
+    CheckRejected( "deep logical not",
+                   (Repeat("!", nDeep) + "B1").c_str() );
+    CheckRejected( "deep nested functions",
+                   (Repeat("sqrt(", nDeep) + "B1" +
+                    Repeat(")", nDeep)).c_str() );
+    CheckRejected( "long power chain",
+                   ("B1" + Repeat(" ^ B1", nDeep)).c_str() );
+    CheckRejected( "long ternary chain",
+                   (Repeat("B1 ? B1 : ", nDeep) + "B1").c_str() );
+    CheckRejected( "long sum chain",
+                   ("B1" + Repeat(" + B1", nDeep)).c_str() );
+    CheckRejected( "long product chain",
+                   ("B1" + Repeat(" * B1", nDeep)).c_str() );
+
+    VSIUnlink( SOURCE_FILENAME );
+
+    GDALDestroyDriverManager();
+    CSLDestroy( argv );
+
+    if( nFailures )
+    {
+        printf( "%d failure(s)\n", nFailures );
+        return 1;
+    }
+    return 0;
+}
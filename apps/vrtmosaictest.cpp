@@ -0,0 +1,306 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of windowed reads in VRT mosaics made of a large
+ *           number of sources.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdal.h"
+#include "vrt/gdal_vrt.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+static int nTilesPerSide = 320, nTileSize = 16, nWindowSize = 256;
+static int nReads = 200, nDistinctTiles = 64, nThreads = 1;
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "vrtmosaictest [-t <tiles_per_side>] [-ts <tile_size>]\n"
+            "              [-w <window_size>] [-n <reads>]\n"
+            "              [-d <distinct_tiles>] [-nt <threads>]\n"
+            "\n"
+            "Builds an in-memory VRT mosaic of tiles_per_side x tiles_per_side\n"
+            "sources of tile_size x tile_size pixels each, taken from\n"
+            "distinct_tiles datasets, and reads the specified number of\n"
+            "window_size x window_size windows at random locations, with and\n"
+            "without the spatial index of the sources. If threads is greater\n"
+            "than 1, the windows are also read with that number of threads.\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                             ReadWindows()                            */
+/*                                                                      */
+/*      Read the random windows and return the elapsed time. The sum    */
+/*      of the pixel values is returned in *pnChecksum.                 */
+/************************************************************************/
+
+static double ReadWindows( GDALRasterBandH hBand, GUIntBig *pnChecksum )
+
+{
+    int nRasterSize = nTilesPerSide * nTileSize;
+    GByte *pabyBuffer = (GByte *) CPLMalloc( nWindowSize * nWindowSize );
+    GUInt32 nState = 1;
+    GUIntBig nChecksum = 0;
+
+    double dfStart = GetWallClockTime();
+
+    for( int iRead = 0; iRead < nReads; iRead++ )
+    {
+        nState = nState * 1103515245U + 12345U;
+        int nXOff = (nState >> 8) % (nRasterSize - nWindowSize + 1);
+        nState = nState * 1103515245U + 12345U;
+        int nYOff = (nState >> 8) % (nRasterSize - nWindowSize + 1);
+
+        if( GDALRasterIO( hBand, GF_Read, nXOff, nYOff,
+                          nWindowSize, nWindowSize, pabyBuffer,
+                          nWindowSize, nWindowSize, GDT_Byte,
+                          0, 0 ) != CE_None )
+        {
+            printf( "Read failed.\n" );
+            exit( 1 );
+        }
+
+        for( int i = 0; i < nWindowSize * nWindowSize; i++ )
+            nChecksum += pabyBuffer[i];
+    }
+
+    double dfElapsed = GetWallClockTime() - dfStart;
+
+    CPLFree( pabyBuffer );
+    *pnChecksum = nChecksum;
+
+    return dfElapsed;
+}
+
+/************************************************************************/
+/*                            CreateTiles()                             */
+/*                                                                      */
+/*      Create tiles whose content depends on the position of the       */
+/*      pixels. They are named, so that the VRT can tell them apart     */
+/*      when reading its sources with several threads.                  */
+/************************************************************************/
+
+static GDALDatasetH *CreateTiles()
+
+{
+    GDALDriverH hMEMDriver = GDALGetDriverByName( "MEM" );
+    GDALDatasetH *pahTiles = (GDALDatasetH *)
+        CPLMalloc( sizeof(GDALDatasetH) * nDistinctTiles );
+    GByte *pabyTile = (GByte *) CPLMalloc( 4 * nTileSize * nTileSize );
+
+    for( int iTile = 0; iTile < nDistinctTiles; iTile++ )
+    {
+        pahTiles[iTile] = GDALCreate( hMEMDriver, CPLSPrintf( "tile_%d", iTile ),
+                                      2 * nTileSize, 2 * nTileSize, 1,
+                                      GDT_Byte, NULL );
+        if( pahTiles[iTile] == NULL )
+            exit( 1 );
+
+        for( int i = 0; i < 4 * nTileSize * nTileSize; i++ )
+            pabyTile[i] = (GByte) ((i * 7 + iTile * 13) % 251);
+        GDALRasterIO( GDALGetRasterBand( pahTiles[iTile], 1 ), GF_Write,
+                      0, 0, 2 * nTileSize, 2 * nTileSize, pabyTile,
+                      2 * nTileSize, 2 * nTileSize, GDT_Byte, 0, 0 );
+    }
+    CPLFree( pabyTile );
+
+    return pahTiles;
+}
+
+/************************************************************************/
+/*                            BuildMosaic()                             */
+/*                                                                      */
+/*      Reference the tiles in turn, with a shifted source window, so   */
+/*      that misplaced sources change the checksum.                     */
+/************************************************************************/
+
+static VRTDatasetH BuildMosaic( GDALDatasetH *pahTiles )
+
+{
+    int nRasterSize = nTilesPerSide * nTileSize;
+    VRTDatasetH hVRTDS = VRTCreate( nRasterSize, nRasterSize );
+    GDALAddBand( hVRTDS, GDT_Byte, NULL );
+    VRTSourcedRasterBandH hVRTBand =
+        (VRTSourcedRasterBandH) GDALGetRasterBand( hVRTDS, 1 );
+
+    for( int iY = 0; iY < nTilesPerSide; iY++ )
+    {
+        for( int iX = 0; iX < nTilesPerSide; iX++ )
+        {
+            int iTile = (iY * nTilesPerSide + iX) % nDistinctTiles;
+            int nShift = (iX + iY * 3) % nTileSize;
+            VRTAddSimpleSource( hVRTBand,
+                                GDALGetRasterBand( pahTiles[iTile], 1 ),
+                                nShift, nShift, nTileSize, nTileSize,
+                                iX * nTileSize, iY * nTileSize,
+                                nTileSize, nTileSize,
+                                "near", VRT_NODATA_UNSET );
+        }
+    }
+
+    return hVRTDS;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    int iArg;
+
+/* -------------------------------------------------------------------- */
+/*      Process arguments.                                              */
+/* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    for( iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-t") && iArg < argc-1 )
+            nTilesPerSide = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-ts") && iArg < argc-1 )
+            nTileSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-w") && iArg < argc-1 )
+            nWindowSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-n") && iArg < argc-1 )
+            nReads = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-d") && iArg < argc-1 )
+            nDistinctTiles = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-nt") && iArg < argc-1 )
+            nThreads = atoi(argv[++iArg]);
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+    }
+
+    if( nTilesPerSide < 1 || nTileSize < 1 || nWindowSize < 1 || nReads < 1
+        || nWindowSize > nTilesPerSide * nTileSize || nDistinctTiles < 1 )
+        Usage();
+
+    GDALAllRegister();
+
+    GDALDatasetH *pahTiles = CreateTiles();
+
+    int nRasterSize = nTilesPerSide * nTileSize;
+    double dfStart = GetWallClockTime();
+    VRTDatasetH hVRTDS = BuildMosaic( pahTiles );
+    GDALRasterBandH hVRTBand = GDALGetRasterBand( hVRTDS, 1 );
+
+    printf( "Mosaic of %dx%d pixels, made of %d sources (built in %.2f s).\n",
+            nRasterSize, nRasterSize, nTilesPerSide * nTilesPerSide,
+            GetWallClockTime() - dfStart );
+    printf( "Reading %d windows of %dx%d pixels.\n",
+            nReads, nWindowSize, nWindowSize );
+
+/* -------------------------------------------------------------------- */
+/*      Run the reads without, then with the index. The option is       */
+/*      only checked until the index has been built.                    */
+/* -------------------------------------------------------------------- */
+    GUIntBig nChecksumScan = 0, nChecksumIndex = 0;
+
+    CPLSetConfigOption( "VRT_SOURCE_INDEX", "NO" );
+    double dfScan = ReadWindows( hVRTBand, &nChecksumScan );
+    CPLSetConfigOption( "VRT_SOURCE_INDEX", NULL );
+
+    /* The first read builds the index */
+    GByte byPixel;
+    dfStart = GetWallClockTime();
+    GDALRasterIO( hVRTBand, GF_Read, 0, 0, 1, 1,
+                  &byPixel, 1, 1, GDT_Byte, 0, 0 );
+    double dfBuild = GetWallClockTime() - dfStart;
+
+    double dfIndex = ReadWindows( hVRTBand, &nChecksumIndex );
+
+    printf( "Index build:        %10.3f s\n", dfBuild );
+    printf( "Without index:      %10.3f s (%.2f ms/read)\n",
+            dfScan, dfScan * 1000.0 / nReads );
+    printf( "With index:         %10.3f s (%.2f ms/read)\n",
+            dfIndex, dfIndex * 1000.0 / nReads );
+    if( dfIndex > 0.0 )
+        printf( "Speedup:            %10.2f\n", dfScan / dfIndex );
+
+    int nRet = 0;
+    if( nChecksumScan != nChecksumIndex )
+    {
+        printf( "Checksum mismatch: " CPL_FRMT_GUIB " vs " CPL_FRMT_GUIB "\n",
+                nChecksumScan, nChecksumIndex );
+        nRet = 1;
+    }
+
+    GDALClose( (GDALDatasetH) hVRTDS );
+
+/* -------------------------------------------------------------------- */
+/*      Run the reads with the index and several threads, on a mosaic   */
+/*      created with GDAL_NUM_THREADS set.                              */
+/* -------------------------------------------------------------------- */
+    if( nThreads > 1 )
+    {
+        GUIntBig nChecksumThreads = 0;
+
+        CPLSetConfigOption( "GDAL_NUM_THREADS", CPLSPrintf( "%d", nThreads ) );
+        hVRTDS = BuildMosaic( pahTiles );
+        CPLSetConfigOption( "GDAL_NUM_THREADS", NULL );
+
+        hVRTBand = GDALGetRasterBand( hVRTDS, 1 );
+        GDALRasterIO( hVRTBand, GF_Read, 0, 0, 1, 1,
+                      &byPixel, 1, 1, GDT_Byte, 0, 0 );
+        double dfThreads = ReadWindows( hVRTBand, &nChecksumThreads );
+
+        printf( "With %3d threads:   %10.3f s (%.2f ms/read)\n",
+                nThreads, dfThreads, dfThreads * 1000.0 / nReads );
+
+        if( nChecksumThreads != nChecksumIndex )
+        {
+            printf( "Checksum mismatch: " CPL_FRMT_GUIB " vs " CPL_FRMT_GUIB "\n",
+                    nChecksumIndex, nChecksumThreads );
+            nRet = 1;
+        }
+
+        GDALClose( (GDALDatasetH) hVRTDS );
+    }
+
+    for( int iTile = 0; iTile < nDistinctTiles; iTile++ )
+        GDALClose( pahTiles[iTile] );
+    CPLFree( pahTiles );
+
+    CSLDestroy( argv );
+
+    GDALDestroyDriverManager();
+
+    return nRet;
+}
@@ -0,0 +1,405 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Utilities
+ * Purpose:  Benchmark of the optimized warp kernels against the general
+ *           case kernel.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdalwarper.h"
+#include "cpl_string.h"
+#include "commonutils.h"
+
+CPL_CVSID("$Id$");
+
+static int nSize = 4096, nBands = 3, nIterations = 1;
+static double dfAngle = 10.0, dfScale = 0.9;
+static int bSrcNoData = FALSE;
+static double dfSrcNoData = 0.0;
+
+/* A unit geotransform at the origin would be taken as no georeferencing. */
+static const double dfOrigin = 1000.0;
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf( "warpkerneltest [-s <raster_size>] [-b <band#>] [-i <iterations>]\n"
+            "               [-angle <degrees>] [-scale <ratio>]\n"
+            "               [-srcnodata <value>]\n"
+            "               [-ot <type>]* [-r <resampling>]*\n"
+            "\n"
+            "Warps an in-memory raster of raster_size x raster_size pixels,\n"
+            "rotated by the specified angle and resampled by the specified\n"
+            "ratio, for each data type (Byte, Int16, UInt16 and Float32 by\n"
+            "default) and resampling method (near, bilinear and cubic by\n"
+            "default), with the optimized kernels and with the general case\n"
+            "kernel. Reports the throughput of both, and the maximum\n"
+            "difference between their results.\n" );
+    exit( 1 );
+}
+
+/************************************************************************/
+/*                         CreateSourceDataset()                        */
+/************************************************************************/
+
+static GDALDatasetH CreateSourceDataset( GDALDataType eType )
+
+{
+    GDALDriverH hDriver = GDALGetDriverByName( "MEM" );
+    GDALDatasetH hDS = GDALCreate( hDriver, "", nSize, nSize, nBands,
+                                   eType, NULL );
+    if( hDS == NULL )
+        exit( 1 );
+
+    double adfGeoTransform[6] = { dfOrigin, 1.0, 0.0, dfOrigin + nSize,
+                                  0.0, -1.0 };
+    GDALSetGeoTransform( hDS, adfGeoTransform );
+
+    float *pafLine = (float *) CPLMalloc( sizeof(float) * nSize );
+    GUInt32 nState = 1;
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        for( int iLine = 0; iLine < nSize; iLine++ )
+        {
+            for( int iPixel = 0; iPixel < nSize; iPixel++ )
+            {
+                nState = nState * 1103515245U + 12345U;
+                pafLine[iPixel] = (float)
+                    ((iPixel + iLine + iBand * 64) % 256 + ((nState >> 16) & 15));
+            }
+            GDALRasterIO( GDALGetRasterBand( hDS, iBand + 1 ), GF_Write,
+                          0, iLine, nSize, 1, pafLine, nSize, 1,
+                          GDT_Float32, 0, 0 );
+        }
+    }
+    CPLFree( pafLine );
+
+    return hDS;
+}
+
+/************************************************************************/
+/*                              WarpOnce()                              */
+/*                                                                      */
+/*      Return the number of destination pixels per second, and the     */
+/*      destination dataset in *phDstDS, which the caller must close.    */
+/************************************************************************/
+
+static double WarpOnce( GDALDatasetH hSrcDS, GDALDataType eType,
+                        GDALResampleAlg eResampleAlg, int bGeneralCase,
+                        GDALDatasetH *phDstDS )
+
+{
+/* -------------------------------------------------------------------- */
+/*      The destination covers the source, rotated around its center.   */
+/* -------------------------------------------------------------------- */
+    double dfRad = dfAngle * 3.14159265358979323846 / 180.0;
+    double dfCos = cos( dfRad ) * dfScale, dfSin = sin( dfRad ) * dfScale;
+    int nDstSize = (int) (nSize / dfScale);
+    double dfCenter = dfOrigin + nSize / 2.0;
+    double adfGeoTransform[6];
+
+    adfGeoTransform[1] = dfCos;
+    adfGeoTransform[2] = dfSin;
+    adfGeoTransform[4] = dfSin;
+    adfGeoTransform[5] = -dfCos;
+    adfGeoTransform[0] = dfCenter
+        - (adfGeoTransform[1] + adfGeoTransform[2]) * nDstSize / 2.0;
+    adfGeoTransform[3] = dfCenter
+        - (adfGeoTransform[4] + adfGeoTransform[5]) * nDstSize / 2.0;
+
+    GDALDriverH hDriver = GDALGetDriverByName( "MEM" );
+    GDALDatasetH hDstDS = GDALCreate( hDriver, "", nDstSize, nDstSize, nBands,
+                                      eType, NULL );
+    if( hDstDS == NULL )
+        exit( 1 );
+    GDALSetGeoTransform( hDstDS, adfGeoTransform );
+
+/* -------------------------------------------------------------------- */
+/*      Setup the warp.                                                 */
+/* -------------------------------------------------------------------- */
+    GDALWarpOptions *psWO = GDALCreateWarpOptions();
+
+    psWO->hSrcDS = hSrcDS;
+    psWO->hDstDS = hDstDS;
+    psWO->eWorkingDataType = eType;
+    psWO->eResampleAlg = eResampleAlg;
+    psWO->nBandCount = nBands;
+    psWO->panSrcBands = (int *) CPLMalloc( sizeof(int) * nBands );
+    psWO->panDstBands = (int *) CPLMalloc( sizeof(int) * nBands );
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        psWO->panSrcBands[iBand] = iBand + 1;
+        psWO->panDstBands[iBand] = iBand + 1;
+    }
+    if( bGeneralCase )
+        psWO->papszWarpOptions = CSLSetNameValue( psWO->papszWarpOptions,
+                                                  "USE_GENERAL_CASE", "TRUE" );
+    psWO->papszWarpOptions = CSLSetNameValue( psWO->papszWarpOptions,
+                                              "USE_OPENCL", "FALSE" );
+
+/* -------------------------------------------------------------------- */
+/*      As gdalwarp does, the source nodata value is also used as       */
+/*      destination nodata value.                                       */
+/* -------------------------------------------------------------------- */
+    if( bSrcNoData )
+    {
+        psWO->padfSrcNoDataReal = (double *) CPLMalloc( sizeof(double) * nBands );
+        psWO->padfSrcNoDataImag = (double *) CPLCalloc( sizeof(double), nBands );
+        psWO->padfDstNoDataReal = (double *) CPLMalloc( sizeof(double) * nBands );
+        psWO->padfDstNoDataImag = (double *) CPLCalloc( sizeof(double), nBands );
+        for( int iBand = 0; iBand < nBands; iBand++ )
+        {
+            psWO->padfSrcNoDataReal[iBand] = dfSrcNoData;
+            psWO->padfDstNoDataReal[iBand] = dfSrcNoData;
+            GDALSetRasterNoDataValue( GDALGetRasterBand( hDstDS, iBand + 1 ),
+                                      dfSrcNoData );
+        }
+        psWO->papszWarpOptions = CSLSetNameValue( psWO->papszWarpOptions,
+                                                  "INIT_DEST", "NO_DATA" );
+    }
+
+    psWO->pTransformerArg =
+        GDALCreateGenImgProjTransformer2( hSrcDS, hDstDS, NULL );
+    psWO->pfnTransformer = GDALGenImgProjTransform;
+    if( psWO->pTransformerArg == NULL )
+        exit( 1 );
+
+    double dfStart = GetWallClockTime();
+
+    GDALWarpOperationH hOperation = GDALCreateWarpOperation( psWO );
+    if( hOperation == NULL ||
+        GDALChunkAndWarpImage( hOperation, 0, 0,
+                               nDstSize, nDstSize ) != CE_None )
+    {
+        printf( "Warping failed.\n" );
+        exit( 1 );
+    }
+    GDALDestroyWarpOperation( hOperation );
+
+    double dfElapsed = GetWallClockTime() - dfStart;
+    if( dfElapsed <= 0.0 )
+        dfElapsed = 1e-6;
+
+    GDALDestroyGenImgProjTransformer( psWO->pTransformerArg );
+    GDALDestroyWarpOptions( psWO );
+    *phDstDS = hDstDS;
+
+    return (double) nDstSize * nDstSize / dfElapsed;
+}
+
+/************************************************************************/
+/*                           MaxDifference()                            */
+/*                                                                      */
+/*      Return the maximum absolute difference between the pixels of    */
+/*      two datasets of the same size.                                  */
+/************************************************************************/
+
+static double MaxDifference( GDALDatasetH hDS1, GDALDatasetH hDS2 )
+
+{
+    int nXSize = GDALGetRasterXSize( hDS1 );
+    int nYSize = GDALGetRasterYSize( hDS1 );
+    double *padfLine1 = (double *) CPLMalloc( sizeof(double) * nXSize );
+    double *padfLine2 = (double *) CPLMalloc( sizeof(double) * nXSize );
+    double dfMaxDiff = 0.0;
+
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        for( int iLine = 0; iLine < nYSize; iLine++ )
+        {
+            GDALRasterIO( GDALGetRasterBand( hDS1, iBand + 1 ), GF_Read,
+                          0, iLine, nXSize, 1, padfLine1, nXSize, 1,
+                          GDT_Float64, 0, 0 );
+            GDALRasterIO( GDALGetRasterBand( hDS2, iBand + 1 ), GF_Read,
+                          0, iLine, nXSize, 1, padfLine2, nXSize, 1,
+                          GDT_Float64, 0, 0 );
+            for( int iPixel = 0; iPixel < nXSize; iPixel++ )
+            {
+                double dfDiff = fabs( padfLine1[iPixel] - padfLine2[iPixel] );
+                if( dfDiff > dfMaxDiff )
+                    dfMaxDiff = dfDiff;
+            }
+        }
+    }
+
+    CPLFree( padfLine1 );
+    CPLFree( padfLine2 );
+
+    return dfMaxDiff;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char ** argv )
+
+{
+    int iArg;
+    int nTypeCount = 0, nResampleCount = 0;
+    GDALDataType aeTypes[GDT_TypeCount];
+    GDALResampleAlg aeResampleAlgs[16];
+
+/* -------------------------------------------------------------------- */
+/*      Process arguments.                                              */
+/* -------------------------------------------------------------------- */
+    argc = GDALGeneralCmdLineProcessor( argc, &argv, 0 );
+    if( argc < 1 )
+        exit( -argc );
+
+    for( iArg = 1; iArg < argc; iArg++ )
+    {
+        if( EQUAL(argv[iArg],"-s") && iArg < argc-1 )
+            nSize = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-b") && iArg < argc-1 )
+            nBands = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-i") && iArg < argc-1 )
+            nIterations = atoi(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-angle") && iArg < argc-1 )
+            dfAngle = CPLAtof(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-scale") && iArg < argc-1 )
+            dfScale = CPLAtof(argv[++iArg]);
+        else if( EQUAL(argv[iArg],"-srcnodata") && iArg < argc-1 )
+        {
+            bSrcNoData = TRUE;
+            dfSrcNoData = CPLAtof(argv[++iArg]);
+        }
+        else if( EQUAL(argv[iArg],"-ot") && iArg < argc-1 &&
+                 nTypeCount < GDT_TypeCount )
+        {
+            aeTypes[nTypeCount] = GDALGetDataTypeByName( argv[++iArg] );
+            if( aeTypes[nTypeCount] == GDT_Unknown )
+            {
+                printf( "Unknown data type: %s\n", argv[iArg] );
+                Usage();
+            }
+            nTypeCount ++;
+        }
+        else if( EQUAL(argv[iArg],"-r") && iArg < argc-1 &&
+                 nResampleCount < 16 )
+        {
+            iArg ++;
+            if( EQUAL(argv[iArg], "near") )
+                aeResampleAlgs[nResampleCount] = GRA_NearestNeighbour;
+            else if( EQUAL(argv[iArg], "bilinear") )
+                aeResampleAlgs[nResampleCount] = GRA_Bilinear;
+            else if( EQUAL(argv[iArg], "cubic") )
+                aeResampleAlgs[nResampleCount] = GRA_Cubic;
+            else if( EQUAL(argv[iArg], "cubicspline") )
+                aeResampleAlgs[nResampleCount] = GRA_CubicSpline;
+            else if( EQUAL(argv[iArg], "lanczos") )
+                aeResampleAlgs[nResampleCount] = GRA_Lanczos;
+            else
+            {
+                printf( "Unknown resampling method: %s\n", argv[iArg] );
+                Usage();
+            }
+            nResampleCount ++;
+        }
+        else
+        {
+            printf( "Unrecognised argument: %s\n", argv[iArg] );
+            Usage();
+        }
+    }
+
+    if( nSize < 16 || nBands < 1 || nIterations < 1 || dfScale <= 0.0 )
+        Usage();
+
+    if( nTypeCount == 0 )
+    {
+        aeTypes[nTypeCount++] = GDT_Byte;
+        aeTypes[nTypeCount++] = GDT_Int16;
+        aeTypes[nTypeCount++] = GDT_UInt16;
+        aeTypes[nTypeCount++] = GDT_Float32;
+    }
+    if( nResampleCount == 0 )
+    {
+        aeResampleAlgs[nResampleCount++] = GRA_NearestNeighbour;
+        aeResampleAlgs[nResampleCount++] = GRA_Bilinear;
+        aeResampleAlgs[nResampleCount++] = GRA_Cubic;
+    }
+
+    GDALAllRegister();
+
+    printf( "Warping %dx%d pixels, %d band(s), rotation of %.1f degrees, "
+            "scale of %.2f", nSize, nSize, nBands, dfAngle, dfScale );
+    if( bSrcNoData )
+        printf( ", nodata value of %.18g", dfSrcNoData );
+    printf( ".\n" );
+    printf( "type      resampling   general Mpixels/s  optimized Mpixels/s  "
+            "speedup  max diff\n" );
+
+/* -------------------------------------------------------------------- */
+/*      Run the workload.                                               */
+/* -------------------------------------------------------------------- */
+    static const char * const apszResampleNames[] =
+        { "near", "bilinear", "cubic", "cubicspline", "lanczos",
+          "average", "mode" };
+
+    for( int iType = 0; iType < nTypeCount; iType++ )
+    {
+        GDALDatasetH hSrcDS = CreateSourceDataset( aeTypes[iType] );
+
+        for( int iResample = 0; iResample < nResampleCount; iResample++ )
+        {
+            double dfGeneral = 0.0, dfOptimized = 0.0, dfMaxDiff = 0.0;
+            for( int iIter = 0; iIter < nIterations; iIter++ )
+            {
+                GDALDatasetH hGeneralDS, hOptimizedDS;
+
+                dfGeneral += WarpOnce( hSrcDS, aeTypes[iType],
+                                       aeResampleAlgs[iResample], TRUE,
+                                       &hGeneralDS );
+                dfOptimized += WarpOnce( hSrcDS, aeTypes[iType],
+                                         aeResampleAlgs[iResample], FALSE,
+                                         &hOptimizedDS );
+                if( iIter == 0 )
+                    dfMaxDiff = MaxDifference( hGeneralDS, hOptimizedDS );
+
+                GDALClose( hGeneralDS );
+                GDALClose( hOptimizedDS );
+            }
+
+            printf( "%-9s %-12s %17.1f  %19.1f  %7.2f  %8.3g\n",
+                    GDALGetDataTypeName( aeTypes[iType] ),
+                    apszResampleNames[aeResampleAlgs[iResample]],
+                    dfGeneral / nIterations / 1e6,
+                    dfOptimized / nIterations / 1e6,
+                    dfOptimized / dfGeneral, dfMaxDiff );
+        }
+
+        GDALClose( hSrcDS );
+    }
+
+    CSLDestroy( argv );
+
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -52,6 +52,7 @@
 #include "gt_wkt_srs.h"
 #include "tifvsi.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 #include "cplkeywordparser.h"
 #include "gt_jpeg_copy.h"
 #include <set>
@@ -228,6 +229,66 @@ class GTiffRGBABand;
 class GTiffBitmapBand;
 class GTiffJPEGOverviewDS;
 class GTiffJPEGOverviewBand;
+class GTiffDataset;
+
+/************************************************************************/
+/*                         GTiffCompressionJob                          */
+/*                                                                      */
+/*      A block submitted to a worker thread for compression. The       */
+/*      compressed bytes are written to the file in submission order.   */
+/************************************************************************/
+
+typedef struct
+{
+    GTiffDataset   *poDS;
+    CPLJobGroup    *psJobGroup;
+    uint16          nPredictor;
+    int             bBigEndian;
+
+    int             nBlockId;
+    int             bTiled;
+    int             nHeight;
+    GByte          *pabyBuffer;
+    int             nBufferSize;
+    int             nDataSize;
+
+    GByte          *pabyCompressedBuffer;
+    int             nCompressedBufferSize;
+    int             nCompressedSize;
+    int             bError;
+} GTiffCompressionJob;
+
+/************************************************************************/
+/*                        GTiffDecompressionJob                         */
+/*                                                                      */
+/*      Tiles of a multi-block read decoded by worker threads directly  */
+/*      into the block cache. Each job decodes every nTileStep-th tile  */
+/*      of the array, starting at iFirstTile.                           */
+/************************************************************************/
+
+typedef struct
+{
+    int               nBlockId;
+    int               nBlockXOff;
+    int               nBlockYOff;
+    int               nBand;
+    GByte            *pabyRawData;
+    int               nRawSize;
+    GDALRasterBlock **papoBlocks;
+    int               bError;
+} GTiffDecompressionTile;
+
+typedef struct
+{
+    GTiffDataset           *poDS;
+    uint16                  nPredictor;
+    int                     bBigEndian;
+    int                     nBlocksPerTile;
+    GTiffDecompressionTile *pasTiles;
+    int                     nTileCount;
+    int                     iFirstTile;
+    int                     nTileStep;
+} GTiffDecompressionJob;
 
 class GTiffDataset : public GDALPamDataset
 {
@@ -482,6 +543,31 @@ class GTiffDataset : public GDALPamDataset
 
     CPLErr   WriteEncodedTileOrStrip(uint32 tile_or_strip, void* data, int bPreserveDataBuffer);
 
+    /* Multi-threaded compression (NUM_THREADS creation option) */
+    int                  nCompressionJobs;
+    GTiffCompressionJob *pasCompressionJobs;
+    int                  nFirstPendingJob;
+    int                  nPendingJobs;
+
+    void         InitCompressionThreads( char** papszOptions );
+    int          IsBlockPendingCompression( int nBlockId );
+    CPLErr       SubmitCompressionJob( int nBlockId, GByte* pabyData );
+    CPLErr       WriteOldestCompressionJob();
+    CPLErr       WaitCompletionForAllJobs();
+    static void  ThreadCompressionFunc( void* pData );
+
+    TIFF*        CreateSingleBlockTIFF( const char* pszFilename,
+                                        VSILFILE* fpTmp, uint16 nPredictor,
+                                        int bBigEndian, int bTiled,
+                                        int nHeight );
+
+    /* Multi-threaded decompression (NUM_THREADS open option) */
+    int          nDecompressionThreads;
+
+    void         PrefetchBlocks( int nXOff, int nYOff, int nXSize, int nYSize,
+                                 int nBandCount, int *panBandMap );
+    static void  ThreadDecompressionFunc( void* pData );
+
     static void SaveICCProfile(GTiffDataset *pDS, TIFF *hTIFF, char **papszParmList, uint32 nBitsPerSample);
 };
 
@@ -1630,6 +1716,11 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
         }
     }
 
+    /* Decode in parallel the tiles that are not cached yet */
+    if( eRWFlag == GF_Read && nDecompressionThreads > 1 &&
+        nBufXSize >= nXSize && nBufYSize >= nYSize )
+        PrefetchBlocks( nXOff, nYOff, nXSize, nYSize, nBandCount, panBandMap );
+
     nJPEGOverviewVisibilityFlag ++;
     eErr =  GDALPamDataset::IRasterIO(
                 eRWFlag, nXOff, nYOff, nXSize, nYSize,
@@ -1691,6 +1782,11 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
         }
     }
 
+    /* Decode in parallel the tiles that are not cached yet */
+    if( eRWFlag == GF_Read && poGDS->nDecompressionThreads > 1 &&
+        nBufXSize >= nXSize && nBufYSize >= nYSize )
+        poGDS->PrefetchBlocks( nXOff, nYOff, nXSize, nYSize, 1, &nBand );
+
     poGDS->nJPEGOverviewVisibilityFlag ++;
     eErr = GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
                                         pData, nBufXSize, nBufYSize, eBufType,
@@ -4098,6 +4194,13 @@ GTiffDataset::GTiffDataset()
 
     pBaseMapping = NULL;
     nRefBaseMapping = 0;
+
+    nCompressionJobs = 0;
+    pasCompressionJobs = NULL;
+    nFirstPendingJob = 0;
+    nPendingJobs = 0;
+
+    nDecompressionThreads = 0;
 }
 
 /************************************************************************/
@@ -4161,6 +4264,21 @@ int GTiffDataset::Finalize()
 /* -------------------------------------------------------------------- */
     FlushCache();
 
+/* -------------------------------------------------------------------- */
+/*      Release the compression jobs, waiting for any job that could    */
+/*      not be written.                                                 */
+/* -------------------------------------------------------------------- */
+    for( int iJob = 0; iJob < nCompressionJobs; iJob++ )
+    {
+        CPLDestroyJobGroup( pasCompressionJobs[iJob].psJobGroup );
+        CPLFree( pasCompressionJobs[iJob].pabyBuffer );
+        CPLFree( pasCompressionJobs[iJob].pabyCompressedBuffer );
+    }
+    CPLFree( pasCompressionJobs );
+    pasCompressionJobs = NULL;
+    nCompressionJobs = 0;
+    nPendingJobs = 0;
+
 /* -------------------------------------------------------------------- */
 /*      If there is still changed metadata, then presumably we want     */
 /*      to push it into PAM.                                            */
@@ -4339,6 +4457,9 @@ void GTiffDataset::FillEmptyTiles()
     if (!SetDirectory())
         return;
 
+    /* Blocks being compressed must be written before looking for holes */
+    WaitCompletionForAllJobs();
+
 /* -------------------------------------------------------------------- */
 /*      How many blocks are there in this file?                         */
 /* -------------------------------------------------------------------- */
@@ -4544,6 +4665,31 @@ CPLErr  GTiffDataset::WriteEncodedTileOrStrip(uint32 tile_or_strip, void* data,
 {
     CPLErr eErr = CE_None;
 
+/* -------------------------------------------------------------------- */
+/*      Compress new blocks in a worker thread. Blocks that are         */
+/*      rewritten go through the synchronous path, once the pending     */
+/*      blocks have been written, so that libtiff can rewrite them in   */
+/*      place.                                                          */
+/* -------------------------------------------------------------------- */
+    if( nCompressionJobs > 0 )
+    {
+        toff_t *panByteCounts = NULL;
+
+        if( !IsBlockPendingCompression( tile_or_strip )
+            && (( TIFFIsTiled( hTIFF )
+                  && TIFFGetField( hTIFF, TIFFTAG_TILEBYTECOUNTS, &panByteCounts ) )
+                || ( !TIFFIsTiled( hTIFF )
+                  && TIFFGetField( hTIFF, TIFFTAG_STRIPBYTECOUNTS, &panByteCounts ) ))
+            && panByteCounts != NULL
+            && panByteCounts[tile_or_strip] == 0 )
+        {
+            return SubmitCompressionJob( tile_or_strip, (GByte*) data );
+        }
+
+        if( WaitCompletionForAllJobs() != CE_None )
+            return CE_Failure;
+    }
+
     if( TIFFIsTiled( hTIFF ) )
     {
         if( WriteEncodedTile(tile_or_strip, (GByte*) data, 
@@ -4564,6 +4710,627 @@ CPLErr  GTiffDataset::WriteEncodedTileOrStrip(uint32 tile_or_strip, void* data,
     return eErr;
 }
 
+/************************************************************************/
+/*                    GTiffIsThreadableCompression()                    */
+/*                                                                      */
+/*      Only codecs that encode each block independently of the rest    */
+/*      of the file can be run on a temporary file. JPEG shares its     */
+/*      tables through the JPEGTABLES tag of the main file.             */
+/************************************************************************/
+
+static int GTiffIsThreadableCompression( int nCompression )
+
+{
+    return nCompression == COMPRESSION_LZW ||
+           nCompression == COMPRESSION_ADOBE_DEFLATE ||
+           nCompression == COMPRESSION_DEFLATE ||
+           nCompression == COMPRESSION_PACKBITS ||
+           nCompression == COMPRESSION_LZMA;
+}
+
+/************************************************************************/
+/*                       InitCompressionThreads()                       */
+/*                                                                      */
+/*      Setup the compression of blocks by worker threads if the        */
+/*      NUM_THREADS creation option (or the GDAL_NUM_THREADS            */
+/*      configuration option) requests it.                              */
+/************************************************************************/
+
+void GTiffDataset::InitCompressionThreads( char** papszOptions )
+
+{
+    int nThreads = CPLGetNumThreadsOption( papszOptions );
+    if( nThreads <= 1 )
+        return;
+
+    if( !GTiffIsThreadableCompression( nCompression ) )
+    {
+        CPLDebug( "GTiff",
+                  "NUM_THREADS ignored with this compression method." );
+        return;
+    }
+
+    uint16 nPredictor = PREDICTOR_NONE;
+    TIFFGetField( hTIFF, TIFFTAG_PREDICTOR, &nPredictor );
+
+    CPLDebug( "GTiff", "Using %d threads for compression", nThreads );
+
+    pasCompressionJobs = (GTiffCompressionJob*)
+        CPLCalloc( nThreads, sizeof(GTiffCompressionJob) );
+    for( int i = 0; i < nThreads; i++ )
+    {
+        pasCompressionJobs[i].poDS = this;
+        pasCompressionJobs[i].psJobGroup = CPLCreateJobGroup();
+        pasCompressionJobs[i].nPredictor = nPredictor;
+        pasCompressionJobs[i].bBigEndian = TIFFIsBigEndian( hTIFF );
+    }
+    nCompressionJobs = nThreads;
+    nFirstPendingJob = 0;
+    nPendingJobs = 0;
+}
+
+/************************************************************************/
+/*                     IsBlockPendingCompression()                      */
+/************************************************************************/
+
+int GTiffDataset::IsBlockPendingCompression( int nBlockId )
+
+{
+    for( int i = 0; i < nPendingJobs; i++ )
+    {
+        if( pasCompressionJobs[(nFirstPendingJob + i) % nCompressionJobs]
+                .nBlockId == nBlockId )
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/************************************************************************/
+/*                       CreateSingleBlockTIFF()                        */
+/*                                                                      */
+/*      Create in fpTmp a TIFF file made of a single block, with the    */
+/*      same encoding parameters as this dataset. This is used to       */
+/*      encode or decode blocks in worker threads, independently of     */
+/*      the main TIFF handle.                                           */
+/************************************************************************/
+
+TIFF* GTiffDataset::CreateSingleBlockTIFF( const char* pszFilename,
+                                           VSILFILE* fpTmp,
+                                           uint16 nPredictor,
+                                           int bBigEndian,
+                                           int bTiled, int nHeight )
+
+{
+    TIFF* hTIFFTmp = VSI_TIFFOpen( pszFilename,
+                                   bBigEndian ? "w+b" : "w+l", fpTmp );
+    if( hTIFFTmp == NULL )
+        return NULL;
+
+    TIFFSetField( hTIFFTmp, TIFFTAG_IMAGEWIDTH, nBlockXSize );
+    TIFFSetField( hTIFFTmp, TIFFTAG_IMAGELENGTH, nHeight );
+    TIFFSetField( hTIFFTmp, TIFFTAG_BITSPERSAMPLE, nBitsPerSample );
+    TIFFSetField( hTIFFTmp, TIFFTAG_SAMPLESPERPIXEL,
+                  nPlanarConfig == PLANARCONFIG_SEPARATE ?
+                        1 : nSamplesPerPixel );
+    TIFFSetField( hTIFFTmp, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG );
+    TIFFSetField( hTIFFTmp, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK );
+    if( nSampleFormat != 0 )
+        TIFFSetField( hTIFFTmp, TIFFTAG_SAMPLEFORMAT, nSampleFormat );
+    TIFFSetField( hTIFFTmp, TIFFTAG_COMPRESSION, nCompression );
+    if( nPredictor != PREDICTOR_NONE )
+        TIFFSetField( hTIFFTmp, TIFFTAG_PREDICTOR, nPredictor );
+    if( nZLevel != -1 &&
+        (nCompression == COMPRESSION_ADOBE_DEFLATE ||
+         nCompression == COMPRESSION_DEFLATE) )
+        TIFFSetField( hTIFFTmp, TIFFTAG_ZIPQUALITY, nZLevel );
+    if( nLZMAPreset != -1 && nCompression == COMPRESSION_LZMA )
+        TIFFSetField( hTIFFTmp, TIFFTAG_LZMAPRESET, nLZMAPreset );
+
+    if( bTiled )
+    {
+        TIFFSetField( hTIFFTmp, TIFFTAG_TILEWIDTH, nBlockXSize );
+        TIFFSetField( hTIFFTmp, TIFFTAG_TILELENGTH, nBlockYSize );
+    }
+    else
+        TIFFSetField( hTIFFTmp, TIFFTAG_ROWSPERSTRIP, nHeight );
+
+    return hTIFFTmp;
+}
+
+/************************************************************************/
+/*                       ThreadCompressionFunc()                        */
+/*                                                                      */
+/*      Compress a block by writing it in a single block TIFF file in   */
+/*      /vsimem with the same encoding parameters as the main file,     */
+/*      and fetch back the compressed bytes.                            */
+/************************************************************************/
+
+void GTiffDataset::ThreadCompressionFunc( void* pData )
+
+{
+    GTiffCompressionJob* psJob = (GTiffCompressionJob*) pData;
+    GTiffDataset* poDS = psJob->poDS;
+
+    psJob->bError = TRUE;
+    psJob->nCompressedSize = 0;
+
+    CPLString osTmpFilename;
+    osTmpFilename.Printf( "/vsimem/gtiff/thread/job/%p", psJob );
+
+    VSILFILE* fpTmp = VSIFOpenL( osTmpFilename, "w+b" );
+    if( fpTmp == NULL )
+        return;
+    TIFF* hTIFFTmp = poDS->CreateSingleBlockTIFF( osTmpFilename, fpTmp,
+                                                  psJob->nPredictor,
+                                                  psJob->bBigEndian,
+                                                  psJob->bTiled,
+                                                  psJob->nHeight );
+    if( hTIFFTmp == NULL )
+    {
+        VSIFCloseL( fpTmp );
+        VSIUnlink( osTmpFilename );
+        return;
+    }
+
+    int nRet;
+    toff_t *panOffsets = NULL, *panByteCounts = NULL;
+    if( psJob->bTiled )
+    {
+        nRet = (int) TIFFWriteEncodedTile( hTIFFTmp, 0, psJob->pabyBuffer,
+                                           psJob->nDataSize );
+        if( nRet == psJob->nDataSize )
+        {
+            TIFFGetField( hTIFFTmp, TIFFTAG_TILEOFFSETS, &panOffsets );
+            TIFFGetField( hTIFFTmp, TIFFTAG_TILEBYTECOUNTS, &panByteCounts );
+        }
+    }
+    else
+    {
+        nRet = (int) TIFFWriteEncodedStrip( hTIFFTmp, 0, psJob->pabyBuffer,
+                                            psJob->nDataSize );
+        if( nRet == psJob->nDataSize )
+        {
+            TIFFGetField( hTIFFTmp, TIFFTAG_STRIPOFFSETS, &panOffsets );
+            TIFFGetField( hTIFFTmp, TIFFTAG_STRIPBYTECOUNTS, &panByteCounts );
+        }
+    }
+
+    toff_t nOffset = 0, nSize = 0;
+    if( panOffsets != NULL && panByteCounts != NULL )
+    {
+        nOffset = panOffsets[0];
+        nSize = panByteCounts[0];
+    }
+
+    XTIFFClose( hTIFFTmp );
+    VSIFCloseL( fpTmp );
+
+    vsi_l_offset nFileSize = 0;
+    GByte* pabyFile = VSIGetMemFileBuffer( osTmpFilename, &nFileSize, TRUE );
+    if( pabyFile != NULL && nSize > 0 && nOffset + nSize <= nFileSize )
+    {
+        if( (int) nSize > psJob->nCompressedBufferSize )
+        {
+            GByte* pabyNew = (GByte*)
+                VSIRealloc( psJob->pabyCompressedBuffer, (size_t) nSize );
+            if( pabyNew != NULL )
+            {
+                psJob->pabyCompressedBuffer = pabyNew;
+                psJob->nCompressedBufferSize = (int) nSize;
+            }
+        }
+        if( (int) nSize <= psJob->nCompressedBufferSize )
+        {
+            memcpy( psJob->pabyCompressedBuffer, pabyFile + nOffset,
+                    (size_t) nSize );
+            psJob->nCompressedSize = (int) nSize;
+            psJob->bError = FALSE;
+        }
+    }
+    VSIFree( pabyFile );
+}
+
+/************************************************************************/
+/*                      ThreadDecompressionFunc()                       */
+/*                                                                      */
+/*      Decode tiles by writing their raw bytes in a single block TIFF  */
+/*      file in /vsimem and reading them back through libtiff.          */
+/************************************************************************/
+
+void GTiffDataset::ThreadDecompressionFunc( void* pData )
+
+{
+    GTiffDecompressionJob* psJob = (GTiffDecompressionJob*) pData;
+    GTiffDataset* poDS = psJob->poDS;
+    int nWordSize = poDS->nBitsPerSample / 8;
+    int nBlockPixels = poDS->nBlockXSize * poDS->nBlockYSize;
+    int nTileSize = nBlockPixels * nWordSize * psJob->nBlocksPerTile;
+    GDALDataType eDT = poDS->papoBands[0]->GetRasterDataType();
+    GByte* pabyTile = NULL;
+
+    if( psJob->nBlocksPerTile > 1 )
+        pabyTile = (GByte*) VSIMalloc( nTileSize );
+
+    CPLString osTmpFilename;
+    osTmpFilename.Printf( "/vsimem/gtiff/thread/decode/%p", psJob );
+
+    /* Errors are reported by IReadBlock() when it reads the tile again */
+    CPLPushErrorHandler( CPLQuietErrorHandler );
+
+    for( int iTile = psJob->iFirstTile; iTile < psJob->nTileCount;
+         iTile += psJob->nTileStep )
+    {
+        GTiffDecompressionTile* psTile = &psJob->pasTiles[iTile];
+        if( psTile->bError )
+            continue;
+
+        GByte* pabyDst = ( psJob->nBlocksPerTile > 1 ) ? pabyTile :
+                    (GByte*) psTile->papoBlocks[0]->GetDataRef();
+
+        psTile->bError = TRUE;
+        if( pabyDst == NULL )
+            continue;
+
+        VSILFILE* fpTmp = VSIFOpenL( osTmpFilename, "w+b" );
+        if( fpTmp == NULL )
+            continue;
+
+        TIFF* hTIFFTmp = poDS->CreateSingleBlockTIFF( osTmpFilename, fpTmp,
+                                                      psJob->nPredictor,
+                                                      psJob->bBigEndian,
+                                                      TRUE,
+                                                      poDS->nBlockYSize );
+        if( hTIFFTmp != NULL )
+        {
+            if( TIFFWriteRawTile( hTIFFTmp, 0, psTile->pabyRawData,
+                                  psTile->nRawSize ) == psTile->nRawSize &&
+                TIFFReadEncodedTile( hTIFFTmp, 0, pabyDst,
+                                     nTileSize ) == nTileSize )
+            {
+                psTile->bError = FALSE;
+            }
+            XTIFFClose( hTIFFTmp );
+        }
+        VSIFCloseL( fpTmp );
+        VSIUnlink( osTmpFilename );
+
+/* -------------------------------------------------------------------- */
+/*      Dispatch pixel interleaved tiles into the blocks of the bands.  */
+/* -------------------------------------------------------------------- */
+        if( !psTile->bError && psJob->nBlocksPerTile > 1 )
+        {
+            for( int iBand = 0; iBand < psJob->nBlocksPerTile; iBand++ )
+            {
+                GDALCopyWords( pabyTile + iBand * nWordSize, eDT,
+                               nWordSize * psJob->nBlocksPerTile,
+                               psTile->papoBlocks[iBand]->GetDataRef(), eDT,
+                               nWordSize, nBlockPixels );
+            }
+        }
+    }
+
+    CPLPopErrorHandler();
+
+    VSIFree( pabyTile );
+}
+
+/************************************************************************/
+/*                           PrefetchBlocks()                           */
+/*                                                                      */
+/*      Load in the block cache the tiles of a read request that are    */
+/*      not cached yet, reading their compressed bytes sequentially     */
+/*      and decoding them with worker threads. Tiles that cannot be     */
+/*      decoded are left to the regular IReadBlock() path.              */
+/************************************************************************/
+
+void GTiffDataset::PrefetchBlocks( int nXOff, int nYOff, int nXSize, int nYSize,
+                                   int nBandCount, int *panBandMap )
+
+{
+    if( nDecompressionThreads <= 1 || eAccess != GA_ReadOnly ||
+        nBands == 0 || bTreatAsRGBA ||
+        !GTiffIsThreadableCompression( nCompression ) ||
+        (nBitsPerSample % 8) != 0 ||
+        nBitsPerSample !=
+            GDALGetDataTypeSize( papoBands[0]->GetRasterDataType() ) )
+        return;
+
+    if( !SetDirectory() || !TIFFIsTiled( hTIFF ) )
+        return;
+
+    int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    int nBlockX1 = nXOff / nBlockXSize;
+    int nBlockY1 = nYOff / nBlockYSize;
+    int nBlockX2 = (nXOff + nXSize - 1) / nBlockXSize;
+    int nBlockY2 = (nYOff + nYSize - 1) / nBlockYSize;
+    int nBlocksPerTile =
+        ( nPlanarConfig == PLANARCONFIG_CONTIG ) ? nBands : 1;
+    int nTileBandCount =
+        ( nPlanarConfig == PLANARCONFIG_CONTIG ) ? 1 : nBandCount;
+    int nBlockBytes = nBlockXSize * nBlockYSize * (nBitsPerSample / 8);
+
+/* -------------------------------------------------------------------- */
+/*      Do not bother for single tile requests, and do not evict the    */
+/*      tiles we are loading if the cache is not big enough.            */
+/* -------------------------------------------------------------------- */
+    GIntBig nMaxTiles = (GIntBig) (nBlockX2 - nBlockX1 + 1)
+        * (nBlockY2 - nBlockY1 + 1) * nTileBandCount;
+    if( nMaxTiles < 2 ||
+        nMaxTiles * nBlocksPerTile * nBlockBytes > GDALGetCacheMax64() / 2 )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the tiles that are on disk but not in the cache.        */
+/* -------------------------------------------------------------------- */
+    GTiffDecompressionTile* pasTiles = (GTiffDecompressionTile*)
+        VSICalloc( (size_t) nMaxTiles, sizeof(GTiffDecompressionTile) );
+    if( pasTiles == NULL )
+        return;
+
+    int nTiles = 0;
+    for( int iBandIdx = 0; iBandIdx < nTileBandCount; iBandIdx++ )
+    {
+        int nBand = ( nPlanarConfig == PLANARCONFIG_CONTIG ) ?
+                                    1 : panBandMap[iBandIdx];
+        GTiffRasterBand* poBand = (GTiffRasterBand*) papoBands[nBand-1];
+
+        for( int iY = nBlockY1; iY <= nBlockY2; iY++ )
+        {
+            for( int iX = nBlockX1; iX <= nBlockX2; iX++ )
+            {
+                GDALRasterBlock* poBlock =
+                    poBand->TryGetLockedBlockRef( iX, iY );
+                if( poBlock != NULL )
+                {
+                    poBlock->DropLock();
+                    continue;
+                }
+
+                int nBlockId = iX + iY * nBlocksPerRow;
+                if( nPlanarConfig == PLANARCONFIG_SEPARATE )
+                    nBlockId += (nBand-1) * nBlocksPerBand;
+                if( !IsBlockAvailable( nBlockId ) )
+                    continue;
+
+                pasTiles[nTiles].nBlockId = nBlockId;
+                pasTiles[nTiles].nBlockXOff = iX;
+                pasTiles[nTiles].nBlockYOff = iY;
+                pasTiles[nTiles].nBand = nBand;
+                nTiles ++;
+            }
+        }
+    }
+
+    toff_t *panByteCounts = NULL;
+    if( nTiles < 2 ||
+        !TIFFGetField( hTIFF, TIFFTAG_TILEBYTECOUNTS, &panByteCounts ) ||
+        panByteCounts == NULL )
+    {
+        CPLFree( pasTiles );
+        return;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Read the compressed tiles sequentially, and create their        */
+/*      blocks in the cache.                                            */
+/* -------------------------------------------------------------------- */
+    int nReadyTiles = 0;
+    for( int iTile = 0; iTile < nTiles; iTile++ )
+    {
+        GTiffDecompressionTile sTile = pasTiles[iTile];
+
+        toff_t nRawSize = panByteCounts[sTile.nBlockId];
+        if( nRawSize == 0 || nRawSize > INT_MAX )
+            continue;
+        sTile.nRawSize = (int) nRawSize;
+        sTile.pabyRawData = (GByte*) VSIMalloc( sTile.nRawSize );
+        if( sTile.pabyRawData == NULL )
+            continue;
+        if( TIFFReadRawTile( hTIFF, sTile.nBlockId, sTile.pabyRawData,
+                             sTile.nRawSize ) != sTile.nRawSize )
+        {
+            VSIFree( sTile.pabyRawData );
+            continue;
+        }
+
+        sTile.papoBlocks = (GDALRasterBlock**)
+            CPLCalloc( nBlocksPerTile, sizeof(GDALRasterBlock*) );
+        sTile.bError = FALSE;
+        for( int iBand = 0; iBand < nBlocksPerTile; iBand++ )
+        {
+            GDALRasterBand* poBand = papoBands[ nBlocksPerTile > 1 ?
+                                               iBand : sTile.nBand - 1 ];
+            sTile.papoBlocks[iBand] =
+                poBand->GetLockedBlockRef( sTile.nBlockXOff,
+                                           sTile.nBlockYOff, TRUE );
+            if( sTile.papoBlocks[iBand] == NULL )
+                sTile.bError = TRUE;
+        }
+        pasTiles[nReadyTiles++] = sTile;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Decode the tiles.                                               */
+/* -------------------------------------------------------------------- */
+    int nJobs = MIN( nDecompressionThreads, nReadyTiles );
+    GTiffDecompressionJob* pasJobs = (GTiffDecompressionJob*)
+        CPLCalloc( MAX(nJobs, 1), sizeof(GTiffDecompressionJob) );
+    uint16 nPredictor = PREDICTOR_NONE;
+    TIFFGetField( hTIFF, TIFFTAG_PREDICTOR, &nPredictor );
+
+    CPLJobGroup* psJobGroup = CPLCreateJobGroup();
+    for( int iJob = 0; iJob < nJobs; iJob++ )
+    {
+        pasJobs[iJob].poDS = this;
+        pasJobs[iJob].nPredictor = nPredictor;
+        pasJobs[iJob].bBigEndian = TIFFIsBigEndian( hTIFF );
+        pasJobs[iJob].nBlocksPerTile = nBlocksPerTile;
+        pasJobs[iJob].pasTiles = pasTiles;
+        pasJobs[iJob].nTileCount = nReadyTiles;
+        pasJobs[iJob].iFirstTile = iJob;
+        pasJobs[iJob].nTileStep = nJobs;
+        CPLSubmitJob( psJobGroup, ThreadDecompressionFunc, &pasJobs[iJob] );
+    }
+    CPLDestroyJobGroup( psJobGroup );
+
+/* -------------------------------------------------------------------- */
+/*      Release the blocks, and remove from the cache the ones that     */
+/*      could not be decoded.                                           */
+/* -------------------------------------------------------------------- */
+    for( int iTile = 0; iTile < nReadyTiles; iTile++ )
+    {
+        GTiffDecompressionTile* psTile = &pasTiles[iTile];
+        for( int iBand = 0; iBand < nBlocksPerTile; iBand++ )
+        {
+            if( psTile->papoBlocks[iBand] == NULL )
+                continue;
+            psTile->papoBlocks[iBand]->DropLock();
+            if( psTile->bError )
+            {
+                GDALRasterBand* poBand = papoBands[ nBlocksPerTile > 1 ?
+                                                   iBand : psTile->nBand - 1 ];
+                poBand->FlushBlock( psTile->nBlockXOff, psTile->nBlockYOff,
+                                    FALSE );
+            }
+        }
+        CPLFree( psTile->papoBlocks );
+        VSIFree( psTile->pabyRawData );
+    }
+
+    CPLFree( pasJobs );
+    CPLFree( pasTiles );
+}
+
+/************************************************************************/
+/*                        SubmitCompressionJob()                        */
+/************************************************************************/
+
+CPLErr GTiffDataset::SubmitCompressionJob( int nBlockId, GByte* pabyData )
+
+{
+    CPLErr eErr = CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the size of the block, trimming the last strip of the   */
+/*      image like WriteEncodedStrip() does.                            */
+/* -------------------------------------------------------------------- */
+    int cc, nHeight;
+    if( TIFFIsTiled( hTIFF ) )
+    {
+        cc = TIFFTileSize( hTIFF );
+        nHeight = nBlockYSize;
+    }
+    else
+    {
+        cc = TIFFStripSize( hTIFF );
+        nHeight = nRowsPerStrip;
+
+        int nStripWithinBand = nBlockId % nBlocksPerBand;
+        if( (int) ((nStripWithinBand+1) * nRowsPerStrip) > GetRasterYSize() )
+        {
+            nHeight = GetRasterYSize() - nStripWithinBand * nRowsPerStrip;
+            cc = (cc / nRowsPerStrip) * nHeight;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      If all the jobs are busy, write the oldest one to free it.      */
+/* -------------------------------------------------------------------- */
+    if( nPendingJobs == nCompressionJobs )
+        eErr = WriteOldestCompressionJob();
+
+    GTiffCompressionJob* psJob =
+        &pasCompressionJobs[(nFirstPendingJob + nPendingJobs)
+                            % nCompressionJobs];
+    if( cc > psJob->nBufferSize )
+    {
+        GByte* pabyNew = (GByte*) VSIRealloc( psJob->pabyBuffer, cc );
+        if( pabyNew == NULL )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Cannot allocate %d bytes for block compression.", cc );
+            return CE_Failure;
+        }
+        psJob->pabyBuffer = pabyNew;
+        psJob->nBufferSize = cc;
+    }
+    memcpy( psJob->pabyBuffer, pabyData, cc );
+    psJob->nBlockId = nBlockId;
+    psJob->bTiled = TIFFIsTiled( hTIFF );
+    psJob->nHeight = nHeight;
+    psJob->nDataSize = cc;
+    psJob->bError = FALSE;
+
+    nPendingJobs ++;
+    CPLSubmitJob( psJob->psJobGroup, ThreadCompressionFunc, psJob );
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                     WriteOldestCompressionJob()                      */
+/*                                                                      */
+/*      Wait for the oldest pending job and write its compressed        */
+/*      bytes, so that blocks reach the file in the same order as       */
+/*      without threads.                                                */
+/************************************************************************/
+
+CPLErr GTiffDataset::WriteOldestCompressionJob()
+
+{
+    if( nPendingJobs == 0 )
+        return CE_None;
+
+    GTiffCompressionJob* psJob = &pasCompressionJobs[nFirstPendingJob];
+    CPLWaitJobGroup( psJob->psJobGroup );
+
+    nFirstPendingJob = (nFirstPendingJob + 1) % nCompressionJobs;
+    nPendingJobs --;
+
+    if( psJob->bError )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Compression of block %d failed.", psJob->nBlockId );
+        return CE_Failure;
+    }
+
+    tmsize_t nRet;
+    if( TIFFIsTiled( hTIFF ) )
+        nRet = TIFFWriteRawTile( hTIFF, psJob->nBlockId,
+                                 psJob->pabyCompressedBuffer,
+                                 psJob->nCompressedSize );
+    else
+        nRet = TIFFWriteRawStrip( hTIFF, psJob->nBlockId,
+                                  psJob->pabyCompressedBuffer,
+                                  psJob->nCompressedSize );
+    if( nRet != psJob->nCompressedSize )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "TIFFWriteRawTile/Strip() failed." );
+        return CE_Failure;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      WaitCompletionForAllJobs()                      */
+/************************************************************************/
+
+CPLErr GTiffDataset::WaitCompletionForAllJobs()
+
+{
+    CPLErr eErr = CE_None;
+
+    while( nPendingJobs > 0 )
+    {
+        if( WriteOldestCompressionJob() != CE_None )
+            eErr = CE_Failure;
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           FlushBlockBuf()                            */
 /************************************************************************/
@@ -4871,6 +5638,9 @@ void GTiffCacheOffsetOrCount8(VSILFILE* fp,
 int GTiffDataset::IsBlockAvailable( int nBlockId )
 
 {
+    if( nPendingJobs > 0 && IsBlockPendingCompression( nBlockId ) )
+        WaitCompletionForAllJobs();
+
 #ifdef INTERNAL_LIBTIFF
 
     /* Optimization to avoid fetching the whole Strip/TileCounts and Strip/TileOffsets arrays */
@@ -5008,6 +5778,8 @@ void GTiffDataset::FlushDirectory()
 {
     if( GetAccess() == GA_Update )
     {
+        WaitCompletionForAllJobs();
+
         if( bMetadataChanged )
         {
             if (!SetDirectory())
@@ -6988,6 +7760,10 @@ GDALDataset *GTiffDataset::Open( GDALOpenInfo * poOpenInfo )
         return NULL;
     }
 
+    if( poOpenInfo->eAccess == GA_ReadOnly )
+        poDS->nDecompressionThreads =
+            CPLGetNumThreadsOption( poOpenInfo->papszOpenOptions );
+
 /* -------------------------------------------------------------------- */
 /*      Initialize any PAM information.                                 */
 /* -------------------------------------------------------------------- */
@@ -8619,6 +9395,7 @@ void GTiffDataset::ScanDirectories()
             }
             else
             {
+                poODS->nDecompressionThreads = nDecompressionThreads;
                 CPLDebug( "GTiff", "Opened %dx%d overview.\n", 
                           poODS->GetRasterXSize(), poODS->GetRasterYSize());
                 nOverviewCount++;
@@ -9536,6 +10313,8 @@ GDALDataset *GTiffDataset::Create( const char * pszFilename,
     poDS->nLZMAPreset = GTiffGetLZMAPreset(papszParmList);
     poDS->nJpegQuality = GTiffGetJpegQuality(papszParmList);
 
+    poDS->InitCompressionThreads(papszParmList);
+
 #if !defined(BIGTIFF_SUPPORT)
 /* -------------------------------------------------------------------- */
 /*      If we are writing jpeg compression we need to write some        */
@@ -10330,6 +11109,7 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
     poDS->nZLevel = GTiffGetZLevel(papszOptions);
     poDS->nLZMAPreset = GTiffGetLZMAPreset(papszOptions);
     poDS->nJpegQuality = GTiffGetJpegQuality(papszOptions);
+    poDS->InitCompressionThreads(papszOptions);
 
     if (nCompression == COMPRESSION_ADOBE_DEFLATE)
     {
@@ -11681,6 +12461,7 @@ void GDALRegister_GTiff()
 "       <Value>ITULAB</Value>"
 "   </Option>"
 "   <Option name='SPARSE_OK' type='boolean' description='Can newly created files have missing blocks?' default='FALSE'/>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression. Can be set to ALL_CPUS' default='1'/>"
 "   <Option name='ALPHA' type='string-select' description='Mark first extrasample as being alpha'>"
 "       <Value>NON-PREMULTIPLIED</Value>"
 "       <Value>PREMULTIPLIED</Value>"
@@ -11738,6 +12519,10 @@ void GDALRegister_GTiff()
                                    "Float64 CInt16 CInt32 CFloat32 CFloat64" );
         poDriver->SetMetadataItem( GDAL_DMD_CREATIONOPTIONLIST, 
                                    szCreateOptions );
+        poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST,
+"<OpenOptionList>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for decompression of tiles. Can be set to ALL_CPUS' default='1'/>"
+"</OpenOptionList>" );
         poDriver->SetMetadataItem( GDAL_DMD_SUBDATASETS, "YES" );
         poDriver->SetMetadataItem( GDAL_DCAP_VIRTUALIO, "YES" );
 
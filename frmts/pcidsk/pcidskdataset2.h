@@ -181,19 +181,19 @@ class OGRPCIDSKLayer : public OGRLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
-    OGRFeature         *GetFeature( long nFeatureId );
+    OGRFeature         *GetFeature( GIntBig nFeatureId );
     OGRErr              SetFeature( OGRFeature *poFeature );
 
     OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
     int                 TestCapability( const char * );
 
-    OGRErr              DeleteFeature( long nFID );
+    OGRErr              DeleteFeature( GIntBig nFID );
     OGRErr              CreateFeature( OGRFeature *poFeature );
     virtual OGRErr      CreateField( OGRFieldDefn *poField,
                                      int bApproxOK = TRUE );
 
-    int                 GetFeatureCount( int );
+    GIntBig             GetFeatureCount( int );
     OGRErr              GetExtent( OGREnvelope *psExtent, int bForce );
 };
 
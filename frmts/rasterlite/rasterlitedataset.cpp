@@ -126,7 +126,7 @@ CPLErr RasterliteBand::IReadBlock( int nBlockXOff, int nBlockYOff, void * pImage
 #ifdef RASTERLITE_DEBUG
     if (nBand == 1)
     {
-        printf("nTiles = %d\n", OGR_L_GetFeatureCount(hSQLLyr, TRUE));
+        printf("nTiles = %d\n", (int)OGR_L_GetFeatureCount(hSQLLyr, TRUE));
     }
 #endif
 
@@ -31,6 +31,7 @@
 #include "vrtdataset.h"
 #include "cpl_string.h"
 #include "cpl_minixml.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_spatialref.h"
 
 CPL_CVSID("$Id$");
@@ -69,6 +70,8 @@ VRTDataset::VRTDataset( int nXSize, int nYSize )
     poDriver = (GDALDriver *) GDALGetDriverByName( "VRT" );
 
     bCompatibleForDatasetIO = -1;
+
+    nNumThreads = CPLGetNumThreadsOption( NULL );
 }
 
 /************************************************************************/
@@ -725,7 +728,11 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
     VRTDataset *poDS = (VRTDataset *) OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess );
 
     if( poDS != NULL )
+    {
         poDS->bNeedsFlush = FALSE;
+        poDS->nNumThreads =
+            CPLGetNumThreadsOption( poOpenInfo->papszOpenOptions );
+    }
 
     CPLFree( pszXML );
     CPLFree( pszVRTPath );
@@ -917,6 +924,15 @@ CPLErr VRTDataset::AddBand( GDALDataType eType, char **papszOptions )
             if (pszFuncName != NULL)
                 poDerivedBand->SetPixelFunctionName(pszFuncName);
 
+            const char* pszExpression =
+                CSLFetchNameValue(papszOptions, "PixelFunctionExpression");
+            if (pszExpression != NULL &&
+                poDerivedBand->SetPixelFunctionExpression(pszExpression)
+                                                            != CE_None) {
+                delete poDerivedBand;
+                return CE_Failure;
+            }
+
             const char* pszTransferTypeName =
                 CSLFetchNameValue(papszOptions, "SourceTransferType");
             if (pszTransferTypeName != NULL) {
@@ -1161,6 +1177,8 @@ int VRTDataset::CloseDependentDatasets()
 /* We will return TRUE only if all the bands are VRTSourcedRasterBands */
 /* made of identical sources, that are strictly VRTSimpleSource, and that */
 /* the band number of each source is the band number of the VRTSouredRasterBand */
+/* Derived bands are excluded, as reading their sources directly would */
+/* bypass their pixel function */
 
 int VRTDataset::CheckCompatibleForDatasetIO()
 {
@@ -1171,6 +1189,8 @@ int VRTDataset::CheckCompatibleForDatasetIO()
     {
         if (!((VRTRasterBand *) papoBands[iBand])->IsSourcedRasterBand())
             return FALSE;
+        if (((VRTRasterBand *) papoBands[iBand])->IsPixelFunctionBand())
+            return FALSE;
 
         VRTSourcedRasterBand* poBand = (VRTSourcedRasterBand* )papoBands[iBand];
 
@@ -1305,20 +1325,14 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
             poBand->nSources = nSavedSources;
         }
 
-        CPLErr eErr = CE_None;
         /* Use the last band, because when sources reference a GDALProxyDataset, they */
         /* don't necessary instanciate all underlying rasterbands */
         VRTSourcedRasterBand* poBand = (VRTSourcedRasterBand* )papoBands[nBands - 1];
-        for(int iSource = 0; eErr == CE_None && iSource < poBand->nSources; iSource++)
-        {
-            VRTSimpleSource* poSource = (VRTSimpleSource* )poBand->papoSources[iSource];
-            eErr = poSource->DatasetRasterIO( nXOff, nYOff, nXSize, nYSize,
-                                              pData, nBufXSize, nBufYSize,
-                                              eBufType,
-                                              nBandCount, panBandMap,
-                                              nPixelSpace, nLineSpace, nBandSpace);
-        }
-        return eErr;
+        return poBand->SourcesRasterIO( nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize,
+                                        eBufType,
+                                        nBandCount, panBandMap,
+                                        nPixelSpace, nLineSpace, nBandSpace );
     }
 
     return GDALDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
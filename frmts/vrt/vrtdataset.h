@@ -35,6 +35,7 @@
 #include "gdal_pam.h"
 #include "gdal_vrt.h"
 #include "cpl_hash_set.h"
+#include "cpl_quad_tree.h"
 
 int VRTApplyMetadata( CPLXMLNode *, GDALMajorObject * );
 CPLXMLNode *VRTSerializeMetadata( GDALMajorObject * );
@@ -139,6 +140,8 @@ class CPL_DLL VRTDataset : public GDALDataset
     int            bCompatibleForDatasetIO;
     int            CheckCompatibleForDatasetIO();
 
+    int            nNumThreads;
+
   protected:
     virtual int         CloseDependentDatasets();
 
@@ -151,6 +154,8 @@ class CPL_DLL VRTDataset : public GDALDataset
     
     void SetWritable(int bWritable) { this->bWritable = bWritable; }
 
+    int  GetNumThreads() { return nNumThreads; }
+
     virtual CPLErr          CreateMaskBand( int nFlags );
     void SetMaskBand(VRTRasterBand* poMaskBand);
 
@@ -343,6 +348,7 @@ class CPL_DLL VRTRasterBand : public GDALRasterBand
     virtual int         CloseDependentDatasets();
 
     virtual int         IsSourcedRasterBand() { return FALSE; }
+    virtual int         IsPixelFunctionBand() { return FALSE; }
 };
 
 /************************************************************************/
@@ -358,7 +364,14 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
     CPLString      osLastLocationInfo;
     char         **papszSourceList;
 
+    /* Spatial index of the destination windows of the sources. */
+    /* Built on demand, see GetSourcesInWindow() */
+    CPLQuadTree   *hSourceIndex;
+    int            nIndexedSources;
+    VRTSource    **papoIndexedSources;
+
     void           Initialize( int nXSize, int nYSize );
+    int            BuildSourceIndex();
 
   public:
     int            nSources;
@@ -445,6 +458,18 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
     virtual int         CloseDependentDatasets();
 
     virtual int         IsSourcedRasterBand() { return TRUE; }
+
+    void           InvalidateSourceIndex();
+    int            GetSourcesInWindow( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       int **ppanSources );
+    CPLErr         SourcesRasterIO( int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    void *pData, int nBufXSize, int nBufYSize,
+                                    GDALDataType eBufType,
+                                    int nBandCount, int *panBandMap,
+                                    int nPixelSpace, int nLineSpace,
+                                    int nBandSpace );
 };
 
 /************************************************************************/
@@ -468,12 +493,51 @@ class CPL_DLL VRTWarpedRasterBand : public VRTRasterBand
     virtual GDALRasterBand *GetOverview(int);
 };
 
+/************************************************************************/
+/*                          VRTPixelExpression                          */
+/************************************************************************/
+
+struct VRTExprInstr;
+struct VRTExprNode;
+
+class VRTPixelExpression
+{
+    char         *pszExpression;
+    int           nInstructions;
+    VRTExprInstr *pasInstructions;
+    int           nRegisters;
+    int           nResultReg;
+    int           nMaxSource;
+
+                  VRTPixelExpression();
+
+    VRTExprInstr *Emit( int eOp, int nDst );
+    void          Generate( VRTExprNode *poNode, int nFirstFree,
+                            int bNeedRegister, int *pnReg, double *pdfConst );
+    void          Run( double **papadfRegs, int nCount );
+
+  public:
+                 ~VRTPixelExpression();
+
+    static VRTPixelExpression *Compile( const char *pszExpression );
+
+    const char   *GetExpression() { return pszExpression; }
+    int           GetMaxSourceIndex() { return nMaxSource; }
+
+    CPLErr        Evaluate( void **papoSources, int nSources, void *pData,
+                            int nBufXSize, int nBufYSize,
+                            GDALDataType eSrcType, GDALDataType eBufType,
+                            int nPixelSpace, int nLineSpace,
+                            int bNoDataSet, double dfNoData );
+};
+
 /************************************************************************/
 /*                         VRTDerivedRasterBand                         */
 /************************************************************************/
 
 class CPL_DLL VRTDerivedRasterBand : public VRTSourcedRasterBand
 {
+    VRTPixelExpression *poExpression;
 
  public:
     char *pszFuncName;
@@ -493,8 +557,11 @@ class CPL_DLL VRTDerivedRasterBand : public VRTSourcedRasterBand
     static GDALDerivedPixelFunc GetPixelFunction(const char *pszFuncName);
 
     void SetPixelFunctionName(const char *pszFuncName);
+    CPLErr SetPixelFunctionExpression(const char *pszExpression);
     void SetSourceTransferType(GDALDataType eDataType);
 
+    virtual int         IsPixelFunctionBand() { return TRUE; }
+
     virtual CPLErr         XMLInit( CPLXMLNode *, const char * );
     virtual CPLXMLNode *   SerializeToXML( const char *pszVRTPath );
 
@@ -607,6 +674,8 @@ public:
     int            GetSrcDstWindow( int, int, int, int, int, int, 
                                     int *, int *, int *, int *,
                                     int *, int *, int *, int * );
+    int            GetDstWindow( int *pnDstXOff, int *pnDstYOff,
+                                 int *pnDstXSize, int *pnDstYSize );
 
     virtual CPLErr  RasterIO( int nXOff, int nYOff, int nXSize, int nYSize, 
                               void *pData, int nBufXSize, int nBufYSize, 
@@ -639,6 +708,7 @@ public:
     virtual const char* GetType() { return "SimpleSource"; }
 
     GDALRasterBand* GetBand();
+    GDALDataset*    GetSourceDataset();
     int             IsSameExceptBandNumber(VRTSimpleSource* poOtherSource);
     CPLErr          DatasetRasterIO(
                                int nXOff, int nYOff, int nXSize, int nYSize,
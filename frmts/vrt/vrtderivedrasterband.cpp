@@ -51,6 +51,7 @@ VRTDerivedRasterBand::VRTDerivedRasterBand(GDALDataset *poDS, int nBand)
 {
     this->pszFuncName = NULL;
     this->eSourceTransferType = GDT_Unknown;
+    this->poExpression = NULL;
 }
 
 /************************************************************************/
@@ -65,6 +66,7 @@ VRTDerivedRasterBand::VRTDerivedRasterBand(GDALDataset *poDS, int nBand,
 {
     this->pszFuncName = NULL;
     this->eSourceTransferType = GDT_Unknown;
+    this->poExpression = NULL;
 }
 
 /************************************************************************/
@@ -78,6 +80,7 @@ VRTDerivedRasterBand::~VRTDerivedRasterBand()
         CPLFree(this->pszFuncName);
         this->pszFuncName = NULL;
     }
+    delete this->poExpression;
 }
 
 /************************************************************************/
@@ -180,6 +183,40 @@ void VRTDerivedRasterBand::SetPixelFunctionName(const char *pszFuncName)
     this->pszFuncName = CPLStrdup( pszFuncName );
 }
 
+/************************************************************************/
+/*                      SetPixelFunctionExpression()                    */
+/************************************************************************/
+
+/**
+ * Set an expression computing the pixels of this derived band from its
+ * sources, instead of a registered pixel function.  The sources are
+ * referred to as B1, B2, ... in their order of declaration.  The expression
+ * is compiled once and evaluated over whole chunks of pixels.
+ *
+ * When an expression is set, the pixel function name is ignored.
+ *
+ * @param pszExpression the expression, e.g. "(B2-B1)/(B2+B1)", or NULL to
+ * remove the expression.
+ *
+ * @return CE_None on success, or CE_Failure if the expression is invalid.
+ */
+CPLErr VRTDerivedRasterBand::SetPixelFunctionExpression(const char *pszExpression)
+{
+    VRTPixelExpression *poNewExpression = NULL;
+
+    if( pszExpression != NULL )
+    {
+        poNewExpression = VRTPixelExpression::Compile( pszExpression );
+        if( poNewExpression == NULL )
+            return CE_Failure;
+    }
+
+    delete this->poExpression;
+    this->poExpression = poNewExpression;
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                         SetSourceTransferType()                      */
 /************************************************************************/
@@ -322,8 +359,10 @@ CPLErr VRTDerivedRasterBand::IRasterIO(GDALRWFlag eRWFlag,
     }
 
     /* ---- Get pixel function for band ---- */
-    pfnPixelFunc = VRTDerivedRasterBand::GetPixelFunction(this->pszFuncName);
-    if (pfnPixelFunc == NULL) {
+    pfnPixelFunc = NULL;
+    if (this->poExpression == NULL &&
+        (pfnPixelFunc =
+         VRTDerivedRasterBand::GetPixelFunction(this->pszFuncName)) == NULL) {
 	CPLError( CE_Failure, CPLE_IllegalArg, 
 		  "VRTDerivedRasterBand::IRasterIO:" \
 		  "Derived band pixel function '%s' not registered.\n",
@@ -383,7 +422,14 @@ CPLErr VRTDerivedRasterBand::IRasterIO(GDALRWFlag eRWFlag,
     }
 
     /* ---- Apply pixel function ---- */
-    if (eErr == CE_None) {
+    if (eErr == CE_None && this->poExpression != NULL) {
+        eErr = this->poExpression->Evaluate((void **)pBuffers, nSources,
+                                            pData, nBufXSize, nBufYSize,
+                                            eSrcType, eBufType,
+                                            nPixelSpace, nLineSpace,
+                                            bNoDataValueSet, dfNoDataValue);
+    }
+    else if (eErr == CE_None) {
 	eErr = pfnPixelFunc((void **)pBuffers, nSources,
 			    pData, nBufXSize, nBufYSize,
 			    eSrcType, eBufType, nPixelSpace, nLineSpace);
@@ -417,6 +463,14 @@ CPLErr VRTDerivedRasterBand::XMLInit(CPLXMLNode *psTree,
     this->SetPixelFunctionName
 	(CPLGetXMLValue(psTree, "PixelFunctionType", NULL));
 
+    /* ---- Read optional pixel function expression ---- */
+    const char *pszExpression =
+        CPLGetXMLValue(psTree, "PixelFunctionExpression", NULL);
+    if (pszExpression != NULL &&
+        this->SetPixelFunctionExpression(pszExpression) != CE_None) {
+        return CE_Failure;
+    }
+
     /* ---- Read optional source transfer data type ---- */
     pszTypeName = CPLGetXMLValue(psTree, "SourceTransferType", NULL);
     if (pszTypeName != NULL) {
@@ -446,6 +500,9 @@ CPLXMLNode *VRTDerivedRasterBand::SerializeToXML(const char *pszVRTPath)
     /* ---- Encode DerivedBand-specific fields ---- */
     if( pszFuncName != NULL && strlen(pszFuncName) > 0 )
         CPLSetXMLValue(psTree, "PixelFunctionType", this->pszFuncName);
+    if( this->poExpression != NULL )
+        CPLSetXMLValue(psTree, "PixelFunctionExpression",
+                       this->poExpression->GetExpression());
     if( this->eSourceTransferType != GDT_Unknown)
         CPLSetXMLValue(psTree, "SourceTransferType", 
 		       GDALGetDataTypeName(this->eSourceTransferType));
@@ -0,0 +1,1132 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Implementation of VRTPixelExpression, the compiled form of the
+ *           arithmetic expressions used as pixel functions of derived bands.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "vrtdataset.h"
+#include "cpl_string.h"
+#include <math.h>
+
+CPL_CVSID("$Id$");
+
+/* Number of pixels evaluated at once. The registers of an expression */
+/* then stay in the L1/L2 cache while the instructions run over them. */
+#define VRT_EXPR_CHUNK_SIZE 512
+
+/* Maximum nesting level of the parser, and maximum depth of the syntax */
+/* tree. The expression comes from the VRT file, so this bounds the stack */
+/* used by the recursive parsing and code generation. */
+#define VRT_EXPR_MAX_DEPTH 256
+
+typedef enum
+{
+    VRT_EXPR_CONST,
+    VRT_EXPR_LOAD,
+    VRT_EXPR_NEG,
+    VRT_EXPR_NOT,
+    VRT_EXPR_ABS,
+    VRT_EXPR_SQRT,
+    VRT_EXPR_EXP,
+    VRT_EXPR_LOG,
+    VRT_EXPR_LOG10,
+    VRT_EXPR_FLOOR,
+    VRT_EXPR_CEIL,
+    VRT_EXPR_ADD,
+    VRT_EXPR_SUB,
+    VRT_EXPR_MUL,
+    VRT_EXPR_DIV,
+    VRT_EXPR_MOD,
+    VRT_EXPR_POW,
+    VRT_EXPR_MIN,
+    VRT_EXPR_MAX,
+    VRT_EXPR_LT,
+    VRT_EXPR_LE,
+    VRT_EXPR_GT,
+    VRT_EXPR_GE,
+    VRT_EXPR_EQ,
+    VRT_EXPR_NE,
+    VRT_EXPR_AND,
+    VRT_EXPR_OR,
+    VRT_EXPR_SELECT
+} VRTExprOp;
+
+/* An instruction operand is either a register (nReg >= 0) or a constant. */
+typedef struct
+{
+    int    nReg;
+    double dfConst;
+} VRTExprOperand;
+
+struct VRTExprInstr
+{
+    VRTExprOp       eOp;
+    int             nDst;
+    int             nSource;  /* 0-based, for VRT_EXPR_LOAD */
+    VRTExprOperand  asArgs[3];
+};
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         Operator functors                            */
+/* ==================================================================== */
+/************************************************************************/
+
+struct VRTOpNeg   { static inline double Apply(double a) { return -a; } };
+struct VRTOpNot   { static inline double Apply(double a) { return a == 0.0 ? 1.0 : 0.0; } };
+struct VRTOpAbs   { static inline double Apply(double a) { return fabs(a); } };
+struct VRTOpSqrt  { static inline double Apply(double a) { return sqrt(a); } };
+struct VRTOpExp   { static inline double Apply(double a) { return exp(a); } };
+struct VRTOpLog   { static inline double Apply(double a) { return log(a); } };
+struct VRTOpLog10 { static inline double Apply(double a) { return log10(a); } };
+struct VRTOpFloor { static inline double Apply(double a) { return floor(a); } };
+struct VRTOpCeil  { static inline double Apply(double a) { return ceil(a); } };
+
+struct VRTOpAdd { static inline double Apply(double a, double b) { return a + b; } };
+struct VRTOpSub { static inline double Apply(double a, double b) { return a - b; } };
+struct VRTOpMul { static inline double Apply(double a, double b) { return a * b; } };
+struct VRTOpDiv { static inline double Apply(double a, double b) { return a / b; } };
+struct VRTOpMod { static inline double Apply(double a, double b) { return fmod(a, b); } };
+struct VRTOpPow { static inline double Apply(double a, double b) { return pow(a, b); } };
+struct VRTOpMin { static inline double Apply(double a, double b) { return b < a ? b : a; } };
+struct VRTOpMax { static inline double Apply(double a, double b) { return b > a ? b : a; } };
+struct VRTOpLT  { static inline double Apply(double a, double b) { return a < b ? 1.0 : 0.0; } };
+struct VRTOpLE  { static inline double Apply(double a, double b) { return a <= b ? 1.0 : 0.0; } };
+struct VRTOpGT  { static inline double Apply(double a, double b) { return a > b ? 1.0 : 0.0; } };
+struct VRTOpGE  { static inline double Apply(double a, double b) { return a >= b ? 1.0 : 0.0; } };
+struct VRTOpEQ  { static inline double Apply(double a, double b) { return a == b ? 1.0 : 0.0; } };
+struct VRTOpNE  { static inline double Apply(double a, double b) { return a != b ? 1.0 : 0.0; } };
+struct VRTOpAnd { static inline double Apply(double a, double b) { return (a != 0.0 && b != 0.0) ? 1.0 : 0.0; } };
+struct VRTOpOr  { static inline double Apply(double a, double b) { return (a != 0.0 || b != 0.0) ? 1.0 : 0.0; } };
+
+/************************************************************************/
+/*                          VRTExprApplyScalar()                        */
+/*                                                                      */
+/*      Used to fold constant sub-expressions at compilation time.      */
+/************************************************************************/
+
+static double VRTExprApplyScalar( VRTExprOp eOp, const double *padfArgs )
+{
+    const double a = padfArgs[0];
+    const double b = padfArgs[1];
+
+    switch( eOp )
+    {
+        case VRT_EXPR_NEG:   return VRTOpNeg::Apply(a);
+        case VRT_EXPR_NOT:   return VRTOpNot::Apply(a);
+        case VRT_EXPR_ABS:   return VRTOpAbs::Apply(a);
+        case VRT_EXPR_SQRT:  return VRTOpSqrt::Apply(a);
+        case VRT_EXPR_EXP:   return VRTOpExp::Apply(a);
+        case VRT_EXPR_LOG:   return VRTOpLog::Apply(a);
+        case VRT_EXPR_LOG10: return VRTOpLog10::Apply(a);
+        case VRT_EXPR_FLOOR: return VRTOpFloor::Apply(a);
+        case VRT_EXPR_CEIL:  return VRTOpCeil::Apply(a);
+        case VRT_EXPR_ADD:   return VRTOpAdd::Apply(a, b);
+        case VRT_EXPR_SUB:   return VRTOpSub::Apply(a, b);
+        case VRT_EXPR_MUL:   return VRTOpMul::Apply(a, b);
+        case VRT_EXPR_DIV:   return VRTOpDiv::Apply(a, b);
+        case VRT_EXPR_MOD:   return VRTOpMod::Apply(a, b);
+        case VRT_EXPR_POW:   return VRTOpPow::Apply(a, b);
+        case VRT_EXPR_MIN:   return VRTOpMin::Apply(a, b);
+        case VRT_EXPR_MAX:   return VRTOpMax::Apply(a, b);
+        case VRT_EXPR_LT:    return VRTOpLT::Apply(a, b);
+        case VRT_EXPR_LE:    return VRTOpLE::Apply(a, b);
+        case VRT_EXPR_GT:    return VRTOpGT::Apply(a, b);
+        case VRT_EXPR_GE:    return VRTOpGE::Apply(a, b);
+        case VRT_EXPR_EQ:    return VRTOpEQ::Apply(a, b);
+        case VRT_EXPR_NE:    return VRTOpNE::Apply(a, b);
+        case VRT_EXPR_AND:   return VRTOpAnd::Apply(a, b);
+        case VRT_EXPR_OR:    return VRTOpOr::Apply(a, b);
+        case VRT_EXPR_SELECT:return a != 0.0 ? b : padfArgs[2];
+        default:
+            CPLAssert(FALSE);
+            return 0.0;
+    }
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                      Parser of expressions                           */
+/* ==================================================================== */
+/************************************************************************/
+
+/* Node of the syntax tree. Leaves are constants and source references. */
+struct VRTExprNode
+{
+    VRTExprOp    eOp;
+    double       dfValue;   /* VRT_EXPR_CONST */
+    int          nSource;   /* VRT_EXPR_LOAD, 0-based */
+    int          nArgs;
+    VRTExprNode *apoArgs[3];
+    int          nDepth;    /* 1 for a leaf */
+
+    VRTExprNode( VRTExprOp eOpIn ) :
+        eOp(eOpIn), dfValue(0.0), nSource(-1), nArgs(0), nDepth(1)
+    {
+        apoArgs[0] = apoArgs[1] = apoArgs[2] = NULL;
+    }
+
+    ~VRTExprNode()
+    {
+        for( int i = 0; i < nArgs; i++ )
+            delete apoArgs[i];
+    }
+};
+
+typedef struct
+{
+    const char *pszName;
+    VRTExprOp   eOp;
+    int         nArgs;
+} VRTExprFunction;
+
+static const VRTExprFunction asVRTExprFunctions[] =
+{
+    { "abs",   VRT_EXPR_ABS,   1 },
+    { "sqrt",  VRT_EXPR_SQRT,  1 },
+    { "exp",   VRT_EXPR_EXP,   1 },
+    { "log",   VRT_EXPR_LOG,   1 },
+    { "log10", VRT_EXPR_LOG10, 1 },
+    { "floor", VRT_EXPR_FLOOR, 1 },
+    { "ceil",  VRT_EXPR_CEIL,  1 },
+    { "pow",   VRT_EXPR_POW,   2 },
+    { "min",   VRT_EXPR_MIN,   2 },
+    { "max",   VRT_EXPR_MAX,   2 },
+};
+
+class VRTExprParser
+{
+    const char *pszExpression;
+    const char *pszCur;
+    int         bError;
+    int         nNesting;
+
+    void        SkipSpaces();
+    int         Accept( const char *pszToken );
+    void        Error( const char *pszMsg );
+    VRTExprNode *MakeNode( VRTExprOp eOp, int nArgs, VRTExprNode *poA,
+                           VRTExprNode *poB = NULL, VRTExprNode *poC = NULL );
+
+    int         EnterNesting();
+    VRTExprNode *ParseTernary();
+    VRTExprNode *ParseConditional();
+    VRTExprNode *ParseOr();
+    VRTExprNode *ParseAnd();
+    VRTExprNode *ParseEquality();
+    VRTExprNode *ParseRelational();
+    VRTExprNode *ParseAdditive();
+    VRTExprNode *ParseMultiplicative();
+    VRTExprNode *ParseUnary();
+    VRTExprNode *ParsePower();
+    VRTExprNode *ParsePrimary();
+
+  public:
+    VRTExprParser( const char *pszExpressionIn ) :
+        pszExpression(pszExpressionIn), pszCur(pszExpressionIn), bError(FALSE),
+        nNesting(0) {}
+
+    VRTExprNode *Parse();
+};
+
+/************************************************************************/
+/*                               Error()                                */
+/************************************************************************/
+
+void VRTExprParser::Error( const char *pszMsg )
+{
+    /* Only report the first error */
+    if( bError )
+        return;
+    bError = TRUE;
+    CPLError( CE_Failure, CPLE_AppDefined,
+              "Invalid pixel function expression '%s': %s at position %d.",
+              pszExpression, pszMsg, (int)(pszCur - pszExpression) + 1 );
+}
+
+/************************************************************************/
+/*                             SkipSpaces()                             */
+/************************************************************************/
+
+void VRTExprParser::SkipSpaces()
+{
+    while( *pszCur == ' ' || *pszCur == '\t' || *pszCur == '\n' ||
+           *pszCur == '\r' )
+        pszCur++;
+}
+
+/************************************************************************/
+/*                               Accept()                               */
+/*                                                                      */
+/*      Consume pszToken if it is the next token. A one character       */
+/*      token does not match the beginning of a two character one,      */
+/*      so that '<' does not match '<='.                                */
+/************************************************************************/
+
+int VRTExprParser::Accept( const char *pszToken )
+{
+    SkipSpaces();
+    size_t nLen = strlen(pszToken);
+    if( strncmp(pszCur, pszToken, nLen) != 0 )
+        return FALSE;
+    if( nLen == 1 && pszCur[1] == '=' && strchr("<>=!", pszToken[0]) != NULL )
+        return FALSE;
+    if( nLen == 1 && (pszToken[0] == '&' || pszToken[0] == '|') )
+        return FALSE;
+    pszCur += nLen;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                            EnterNesting()                            */
+/*                                                                      */
+/*      Called when entering a recursive rule, the caller decrementing  */
+/*      nNesting when leaving it. Fails past VRT_EXPR_MAX_DEPTH.        */
+/************************************************************************/
+
+int VRTExprParser::EnterNesting()
+{
+    if( nNesting >= VRT_EXPR_MAX_DEPTH )
+    {
+        Error(CPLSPrintf("expression nested more than %d levels deep",
+                         VRT_EXPR_MAX_DEPTH));
+        return FALSE;
+    }
+    nNesting++;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                              MakeNode()                              */
+/*                                                                      */
+/*      Create an operator node, and fold it if all its arguments are   */
+/*      constants. Takes ownership of the arguments, even on error.     */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::MakeNode( VRTExprOp eOp, int nArgs,
+                                      VRTExprNode *poA, VRTExprNode *poB,
+                                      VRTExprNode *poC )
+{
+    VRTExprNode *apoArgs[3] = { poA, poB, poC };
+    int bAllConst = TRUE;
+    double adfValues[3] = { 0.0, 0.0, 0.0 };
+
+    for( int i = 0; i < nArgs; i++ )
+    {
+        if( apoArgs[i] == NULL )
+        {
+            for( int j = 0; j < nArgs; j++ )
+                delete apoArgs[j];
+            return NULL;
+        }
+        if( apoArgs[i]->eOp != VRT_EXPR_CONST )
+            bAllConst = FALSE;
+        else
+            adfValues[i] = apoArgs[i]->dfValue;
+    }
+
+    VRTExprNode *poNode;
+    if( bAllConst )
+    {
+        poNode = new VRTExprNode(VRT_EXPR_CONST);
+        poNode->dfValue = VRTExprApplyScalar(eOp, adfValues);
+        for( int i = 0; i < nArgs; i++ )
+            delete apoArgs[i];
+    }
+    else
+    {
+        poNode = new VRTExprNode(eOp);
+        poNode->nArgs = nArgs;
+        for( int i = 0; i < nArgs; i++ )
+        {
+            poNode->apoArgs[i] = apoArgs[i];
+            if( apoArgs[i]->nDepth >= poNode->nDepth )
+                poNode->nDepth = apoArgs[i]->nDepth + 1;
+        }
+
+        /* Long chains of binary operators are parsed iteratively, */
+        /* but give deep trees */
+        if( poNode->nDepth > VRT_EXPR_MAX_DEPTH )
+        {
+            Error(CPLSPrintf("expression nested more than %d levels deep",
+                             VRT_EXPR_MAX_DEPTH));
+            delete poNode;
+            return NULL;
+        }
+    }
+    return poNode;
+}
+
+/************************************************************************/
+/*                               Parse()                                */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::Parse()
+{
+    VRTExprNode *poNode = ParseTernary();
+    if( poNode == NULL )
+        return NULL;
+
+    SkipSpaces();
+    if( *pszCur != '\0' )
+    {
+        Error("unexpected character");
+        delete poNode;
+        return NULL;
+    }
+    return poNode;
+}
+
+/************************************************************************/
+/*                            ParseTernary()                            */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParseTernary()
+{
+    if( !EnterNesting() )
+        return NULL;
+    VRTExprNode *poNode = ParseConditional();
+    nNesting--;
+    return poNode;
+}
+
+/************************************************************************/
+/*                          ParseConditional()                          */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParseConditional()
+{
+    VRTExprNode *poCond = ParseOr();
+    if( poCond == NULL || !Accept("?") )
+        return poCond;
+
+    VRTExprNode *poTrue = ParseTernary();
+    if( poTrue == NULL )
+    {
+        delete poCond;
+        return NULL;
+    }
+    if( !Accept(":") )
+    {
+        Error("':' expected");
+        delete poCond;
+        delete poTrue;
+        return NULL;
+    }
+    VRTExprNode *poFalse = ParseTernary();
+    if( poFalse == NULL )
+    {
+        delete poCond;
+        delete poTrue;
+        return NULL;
+    }
+
+    /* Only one branch is needed when the condition is a constant */
+    if( poCond->eOp == VRT_EXPR_CONST )
+    {
+        const int bCond = (poCond->dfValue != 0.0);
+        delete poCond;
+        delete (bCond ? poFalse : poTrue);
+        return bCond ? poTrue : poFalse;
+    }
+    return MakeNode(VRT_EXPR_SELECT, 3, poCond, poTrue, poFalse);
+}
+
+/************************************************************************/
+/*                     Binary operator levels                           */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParseOr()
+{
+    VRTExprNode *poNode = ParseAnd();
+    while( poNode != NULL && Accept("||") )
+        poNode = MakeNode(VRT_EXPR_OR, 2, poNode, ParseAnd());
+    return poNode;
+}
+
+VRTExprNode *VRTExprParser::ParseAnd()
+{
+    VRTExprNode *poNode = ParseEquality();
+    while( poNode != NULL && Accept("&&") )
+        poNode = MakeNode(VRT_EXPR_AND, 2, poNode, ParseEquality());
+    return poNode;
+}
+
+VRTExprNode *VRTExprParser::ParseEquality()
+{
+    VRTExprNode *poNode = ParseRelational();
+    while( poNode != NULL )
+    {
+        if( Accept("==") )
+            poNode = MakeNode(VRT_EXPR_EQ, 2, poNode, ParseRelational());
+        else if( Accept("!=") )
+            poNode = MakeNode(VRT_EXPR_NE, 2, poNode, ParseRelational());
+        else
+            break;
+    }
+    return poNode;
+}
+
+VRTExprNode *VRTExprParser::ParseRelational()
+{
+    VRTExprNode *poNode = ParseAdditive();
+    while( poNode != NULL )
+    {
+        if( Accept("<=") )
+            poNode = MakeNode(VRT_EXPR_LE, 2, poNode, ParseAdditive());
+        else if( Accept(">=") )
+            poNode = MakeNode(VRT_EXPR_GE, 2, poNode, ParseAdditive());
+        else if( Accept("<") )
+            poNode = MakeNode(VRT_EXPR_LT, 2, poNode, ParseAdditive());
+        else if( Accept(">") )
+            poNode = MakeNode(VRT_EXPR_GT, 2, poNode, ParseAdditive());
+        else
+            break;
+    }
+    return poNode;
+}
+
+VRTExprNode *VRTExprParser::ParseAdditive()
+{
+    VRTExprNode *poNode = ParseMultiplicative();
+    while( poNode != NULL )
+    {
+        if( Accept("+") )
+            poNode = MakeNode(VRT_EXPR_ADD, 2, poNode, ParseMultiplicative());
+        else if( Accept("-") )
+            poNode = MakeNode(VRT_EXPR_SUB, 2, poNode, ParseMultiplicative());
+        else
+            break;
+    }
+    return poNode;
+}
+
+VRTExprNode *VRTExprParser::ParseMultiplicative()
+{
+    VRTExprNode *poNode = ParseUnary();
+    while( poNode != NULL )
+    {
+        if( Accept("*") )
+            poNode = MakeNode(VRT_EXPR_MUL, 2, poNode, ParseUnary());
+        else if( Accept("/") )
+            poNode = MakeNode(VRT_EXPR_DIV, 2, poNode, ParseUnary());
+        else if( Accept("%") )
+            poNode = MakeNode(VRT_EXPR_MOD, 2, poNode, ParseUnary());
+        else
+            break;
+    }
+    return poNode;
+}
+
+/************************************************************************/
+/*                             ParseUnary()                             */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParseUnary()
+{
+    if( !EnterNesting() )
+        return NULL;
+
+    VRTExprNode *poNode;
+    if( Accept("-") )
+        poNode = MakeNode(VRT_EXPR_NEG, 1, ParseUnary());
+    else if( Accept("+") )
+        poNode = ParseUnary();
+    else if( Accept("!") )
+        poNode = MakeNode(VRT_EXPR_NOT, 1, ParseUnary());
+    else
+        poNode = ParsePower();
+
+    nNesting--;
+    return poNode;
+}
+
+/************************************************************************/
+/*                             ParsePower()                             */
+/*                                                                      */
+/*      '^' is right associative and binds tighter than the unary       */
+/*      operators on its left: -B1^2 is -(B1^2).                        */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParsePower()
+{
+    VRTExprNode *poNode = ParsePrimary();
+    if( poNode != NULL && Accept("^") )
+        poNode = MakeNode(VRT_EXPR_POW, 2, poNode, ParseUnary());
+    return poNode;
+}
+
+/************************************************************************/
+/*                            ParsePrimary()                            */
+/************************************************************************/
+
+VRTExprNode *VRTExprParser::ParsePrimary()
+{
+    SkipSpaces();
+
+/* -------------------------------------------------------------------- */
+/*      Parenthesized expression.                                       */
+/* -------------------------------------------------------------------- */
+    if( Accept("(") )
+    {
+        VRTExprNode *poNode = ParseTernary();
+        if( poNode != NULL && !Accept(")") )
+        {
+            Error("')' expected");
+            delete poNode;
+            return NULL;
+        }
+        return poNode;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Number.                                                         */
+/* -------------------------------------------------------------------- */
+    if( (*pszCur >= '0' && *pszCur <= '9') || *pszCur == '.' )
+    {
+        char *pszEnd = NULL;
+        double dfValue = CPLStrtod(pszCur, &pszEnd);
+        if( pszEnd == pszCur )
+        {
+            Error("invalid number");
+            return NULL;
+        }
+        pszCur = pszEnd;
+        VRTExprNode *poNode = new VRTExprNode(VRT_EXPR_CONST);
+        poNode->dfValue = dfValue;
+        return poNode;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Source reference (B1, B2, ...) or function call.                */
+/* -------------------------------------------------------------------- */
+    if( !((*pszCur >= 'a' && *pszCur <= 'z') ||
+          (*pszCur >= 'A' && *pszCur <= 'Z') || *pszCur == '_') )
+    {
+        Error(*pszCur == '\0' ? "unexpected end of expression"
+                              : "unexpected character");
+        return NULL;
+    }
+
+    const char *pszStart = pszCur;
+    while( (*pszCur >= 'a' && *pszCur <= 'z') ||
+           (*pszCur >= 'A' && *pszCur <= 'Z') ||
+           (*pszCur >= '0' && *pszCur <= '9') || *pszCur == '_' )
+        pszCur++;
+    CPLString osName(std::string(pszStart, pszCur - pszStart));
+
+    if( (osName[0] == 'B' || osName[0] == 'b') && osName.size() > 1 &&
+        osName.size() < 10 &&
+        strspn(osName.c_str() + 1, "0123456789") == osName.size() - 1 )
+    {
+        int nSource = atoi(osName.c_str() + 1);
+        if( nSource < 1 )
+        {
+            pszCur = pszStart;
+            Error("source numbering starts at B1");
+            return NULL;
+        }
+        VRTExprNode *poNode = new VRTExprNode(VRT_EXPR_LOAD);
+        poNode->nSource = nSource - 1;
+        return poNode;
+    }
+
+    const VRTExprFunction *psFunc = NULL;
+    for( size_t i = 0;
+         i < sizeof(asVRTExprFunctions) / sizeof(asVRTExprFunctions[0]); i++ )
+    {
+        if( EQUAL(osName, asVRTExprFunctions[i].pszName) )
+        {
+            psFunc = &asVRTExprFunctions[i];
+            break;
+        }
+    }
+    if( psFunc == NULL )
+    {
+        pszCur = pszStart;
+        Error(CPLSPrintf("unknown identifier '%s'", osName.c_str()));
+        return NULL;
+    }
+
+    if( !Accept("(") )
+    {
+        Error("'(' expected");
+        return NULL;
+    }
+    VRTExprNode *apoArgs[2] = { NULL, NULL };
+    for( int i = 0; i < psFunc->nArgs; i++ )
+    {
+        if( i > 0 && !Accept(",") )
+        {
+            Error(CPLSPrintf("%s() expects %d arguments",
+                             psFunc->pszName, psFunc->nArgs));
+            delete apoArgs[0];
+            return NULL;
+        }
+        apoArgs[i] = ParseTernary();
+        if( apoArgs[i] == NULL )
+        {
+            delete apoArgs[0];
+            return NULL;
+        }
+    }
+    if( !Accept(")") )
+    {
+        Error(CPLSPrintf("%s() expects %d argument%s",
+                         psFunc->pszName, psFunc->nArgs,
+                         psFunc->nArgs > 1 ? "s" : ""));
+        delete apoArgs[0];
+        delete apoArgs[1];
+        return NULL;
+    }
+    return MakeNode(psFunc->eOp, psFunc->nArgs, apoArgs[0], apoArgs[1]);
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          VRTPixelExpression                          */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                         VRTPixelExpression()                         */
+/************************************************************************/
+
+VRTPixelExpression::VRTPixelExpression()
+
+{
+    pszExpression = NULL;
+    nInstructions = 0;
+    pasInstructions = NULL;
+    nRegisters = 0;
+    nResultReg = 0;
+    nMaxSource = 0;
+}
+
+/************************************************************************/
+/*                        ~VRTPixelExpression()                         */
+/************************************************************************/
+
+VRTPixelExpression::~VRTPixelExpression()
+
+{
+    CPLFree( pszExpression );
+    CPLFree( pasInstructions );
+}
+
+/************************************************************************/
+/*                               Emit()                                 */
+/************************************************************************/
+
+VRTExprInstr *VRTPixelExpression::Emit( int eOp, int nDst )
+
+{
+    pasInstructions = (VRTExprInstr *)
+        CPLRealloc( pasInstructions,
+                    sizeof(VRTExprInstr) * (nInstructions + 1) );
+    VRTExprInstr *psInstr = pasInstructions + nInstructions;
+    nInstructions ++;
+
+    memset( psInstr, 0, sizeof(VRTExprInstr) );
+    psInstr->eOp = (VRTExprOp) eOp;
+    psInstr->nDst = nDst;
+    psInstr->nSource = -1;
+    for( int i = 0; i < 3; i++ )
+        psInstr->asArgs[i].nReg = -1;
+    if( nDst >= nRegisters )
+        nRegisters = nDst + 1;
+    return psInstr;
+}
+
+/************************************************************************/
+/*                              Generate()                              */
+/*                                                                      */
+/*      Generate the instructions computing a node, with a stack        */
+/*      allocation of the registers: the node result goes into the     */
+/*      first register that is free once its arguments are computed.   */
+/*      The registers of the sources are 0..nMaxSource-1, and are       */
+/*      loaded before running the program.                              */
+/************************************************************************/
+
+void VRTPixelExpression::Generate( VRTExprNode *poNode, int nFirstFree,
+                                   int bNeedRegister,
+                                   int *pnReg, double *pdfConst )
+
+{
+    if( poNode->eOp == VRT_EXPR_CONST )
+    {
+        if( !bNeedRegister )
+        {
+            *pnReg = -1;
+            *pdfConst = poNode->dfValue;
+            return;
+        }
+        VRTExprInstr *psInstr = Emit( VRT_EXPR_CONST, nFirstFree );
+        psInstr->asArgs[0].dfConst = poNode->dfValue;
+        *pnReg = nFirstFree;
+        return;
+    }
+
+    if( poNode->eOp == VRT_EXPR_LOAD )
+    {
+        *pnReg = poNode->nSource;
+        return;
+    }
+
+    VRTExprOperand asArgs[3];
+    int nNextFree = nFirstFree;
+    for( int i = 0; i < poNode->nArgs; i++ )
+    {
+        /* The operands of a selection are always registers */
+        Generate( poNode->apoArgs[i], nNextFree,
+                  poNode->eOp == VRT_EXPR_SELECT,
+                  &(asArgs[i].nReg), &(asArgs[i].dfConst) );
+        if( asArgs[i].nReg >= nNextFree )
+            nNextFree = asArgs[i].nReg + 1;
+    }
+
+    VRTExprInstr *psInstr = Emit( poNode->eOp, nFirstFree );
+    for( int i = 0; i < poNode->nArgs; i++ )
+        psInstr->asArgs[i] = asArgs[i];
+    *pnReg = nFirstFree;
+}
+
+/************************************************************************/
+/*                              Compile()                               */
+/************************************************************************/
+
+/**
+ * Compile an expression.
+ *
+ * The expression is made of numbers, of the sources of the band, named B1,
+ * B2, ..., of the C arithmetic, comparison and logical operators, of the
+ * '^' power operator, of the ternary 'cond ? a : b' operator, and of the
+ * abs, sqrt, exp, log, log10, floor, ceil, pow, min and max functions.
+ *
+ * @param pszExpression the expression.
+ *
+ * @return the compiled expression, or NULL in case of error (a CPLError()
+ * is then emitted).
+ */
+
+VRTPixelExpression *VRTPixelExpression::Compile( const char *pszExpression )
+
+{
+    VRTExprParser oParser( pszExpression );
+    VRTExprNode *poRoot = oParser.Parse();
+    if( poRoot == NULL )
+        return NULL;
+
+    VRTPixelExpression *poExpr = new VRTPixelExpression();
+    poExpr->pszExpression = CPLStrdup( pszExpression );
+
+/* -------------------------------------------------------------------- */
+/*      Find the number of sources referenced.                          */
+/* -------------------------------------------------------------------- */
+    std::vector<VRTExprNode*> apoStack;
+    apoStack.push_back( poRoot );
+    while( !apoStack.empty() )
+    {
+        VRTExprNode *poNode = apoStack.back();
+        apoStack.pop_back();
+        if( poNode->eOp == VRT_EXPR_LOAD && poNode->nSource >= poExpr->nMaxSource )
+            poExpr->nMaxSource = poNode->nSource + 1;
+        for( int i = 0; i < poNode->nArgs; i++ )
+            apoStack.push_back( poNode->apoArgs[i] );
+    }
+    poExpr->nRegisters = poExpr->nMaxSource;
+
+    int nReg;
+    double dfConst;
+    poExpr->Generate( poRoot, poExpr->nMaxSource, TRUE, &nReg, &dfConst );
+    poExpr->nResultReg = nReg;
+
+    delete poRoot;
+
+    return poExpr;
+}
+
+/************************************************************************/
+/*                             LoadSource()                             */
+/************************************************************************/
+
+template<class T> static void VRTExprLoad( const void *pSource, size_t iStart,
+                                           int nCount, double *padfDst )
+{
+    const T *pSrc = ((const T *) pSource) + iStart;
+    for( int i = 0; i < nCount; i++ )
+        padfDst[i] = pSrc[i];
+}
+
+static void VRTExprLoadSource( const void *pSource, GDALDataType eSrcType,
+                               size_t iStart, int nCount, double *padfDst )
+{
+    switch( eSrcType )
+    {
+        case GDT_Byte:
+            VRTExprLoad<GByte>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_UInt16:
+            VRTExprLoad<GUInt16>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_Int16:
+            VRTExprLoad<GInt16>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_UInt32:
+            VRTExprLoad<GUInt32>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_Int32:
+            VRTExprLoad<GInt32>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_Float32:
+            VRTExprLoad<float>( pSource, iStart, nCount, padfDst );
+            break;
+        case GDT_Float64:
+            VRTExprLoad<double>( pSource, iStart, nCount, padfDst );
+            break;
+        default:
+        {
+            /* Complex types: the real part is used */
+            int nSrcSize = GDALGetDataTypeSize(eSrcType) / 8;
+            GDALCopyWords( ((GByte *) pSource) + iStart * nSrcSize,
+                           eSrcType, nSrcSize,
+                           padfDst, GDT_Float64, sizeof(double), nCount );
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                         Instruction kernels                          */
+/************************************************************************/
+
+template<class Op> static void VRTExprUnary( const VRTExprInstr *psInstr,
+                                             double **papadfRegs, int nCount )
+{
+    double *padfDst = papadfRegs[psInstr->nDst];
+    const double *padfA = papadfRegs[psInstr->asArgs[0].nReg];
+    for( int i = 0; i < nCount; i++ )
+        padfDst[i] = Op::Apply(padfA[i]);
+}
+
+template<class Op> static void VRTExprBinary( const VRTExprInstr *psInstr,
+                                              double **papadfRegs, int nCount )
+{
+    double *padfDst = papadfRegs[psInstr->nDst];
+    const VRTExprOperand &sA = psInstr->asArgs[0];
+    const VRTExprOperand &sB = psInstr->asArgs[1];
+
+    /* Constant folding guarantees that at most one operand is a constant */
+    if( sA.nReg >= 0 && sB.nReg >= 0 )
+    {
+        const double *padfA = papadfRegs[sA.nReg];
+        const double *padfB = papadfRegs[sB.nReg];
+        for( int i = 0; i < nCount; i++ )
+            padfDst[i] = Op::Apply(padfA[i], padfB[i]);
+    }
+    else if( sA.nReg >= 0 )
+    {
+        const double *padfA = papadfRegs[sA.nReg];
+        const double dfB = sB.dfConst;
+        for( int i = 0; i < nCount; i++ )
+            padfDst[i] = Op::Apply(padfA[i], dfB);
+    }
+    else
+    {
+        const double dfA = sA.dfConst;
+        const double *padfB = papadfRegs[sB.nReg];
+        for( int i = 0; i < nCount; i++ )
+            padfDst[i] = Op::Apply(dfA, padfB[i]);
+    }
+}
+
+static void VRTExprSelect( const VRTExprInstr *psInstr,
+                           double **papadfRegs, int nCount )
+{
+    double *padfDst = papadfRegs[psInstr->nDst];
+    const double *padfCond = papadfRegs[psInstr->asArgs[0].nReg];
+    const double *padfTrue = papadfRegs[psInstr->asArgs[1].nReg];
+    const double *padfFalse = papadfRegs[psInstr->asArgs[2].nReg];
+    for( int i = 0; i < nCount; i++ )
+        padfDst[i] = (padfCond[i] != 0.0) ? padfTrue[i] : padfFalse[i];
+}
+
+static void VRTExprFill( double *padfDst, double dfValue, int nCount )
+{
+    for( int i = 0; i < nCount; i++ )
+        padfDst[i] = dfValue;
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+void VRTPixelExpression::Run( double **papadfRegs, int nCount )
+
+{
+    for( int iInstr = 0; iInstr < nInstructions; iInstr++ )
+    {
+        const VRTExprInstr *psInstr = pasInstructions + iInstr;
+        switch( psInstr->eOp )
+        {
+            case VRT_EXPR_CONST:
+                VRTExprFill( papadfRegs[psInstr->nDst],
+                             psInstr->asArgs[0].dfConst, nCount );
+                break;
+            case VRT_EXPR_NEG:   VRTExprUnary<VRTOpNeg>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_NOT:   VRTExprUnary<VRTOpNot>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_ABS:   VRTExprUnary<VRTOpAbs>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_SQRT:  VRTExprUnary<VRTOpSqrt>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_EXP:   VRTExprUnary<VRTOpExp>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_LOG:   VRTExprUnary<VRTOpLog>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_LOG10: VRTExprUnary<VRTOpLog10>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_FLOOR: VRTExprUnary<VRTOpFloor>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_CEIL:  VRTExprUnary<VRTOpCeil>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_ADD:   VRTExprBinary<VRTOpAdd>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_SUB:   VRTExprBinary<VRTOpSub>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_MUL:   VRTExprBinary<VRTOpMul>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_DIV:   VRTExprBinary<VRTOpDiv>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_MOD:   VRTExprBinary<VRTOpMod>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_POW:   VRTExprBinary<VRTOpPow>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_MIN:   VRTExprBinary<VRTOpMin>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_MAX:   VRTExprBinary<VRTOpMax>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_LT:    VRTExprBinary<VRTOpLT>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_LE:    VRTExprBinary<VRTOpLE>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_GT:    VRTExprBinary<VRTOpGT>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_GE:    VRTExprBinary<VRTOpGE>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_EQ:    VRTExprBinary<VRTOpEQ>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_NE:    VRTExprBinary<VRTOpNE>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_AND:   VRTExprBinary<VRTOpAnd>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_OR:    VRTExprBinary<VRTOpOr>( psInstr, papadfRegs, nCount ); break;
+            case VRT_EXPR_SELECT:
+                VRTExprSelect( psInstr, papadfRegs, nCount );
+                break;
+            default:
+                CPLAssert(FALSE);
+                break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+/**
+ * Evaluate the expression over packed source buffers.
+ *
+ * This has the same semantics as a GDALDerivedPixelFunc. The pixels are
+ * processed by chunks of a few hundreds, each instruction of the compiled
+ * expression running over a whole chunk. When bNoDataSet is TRUE, the
+ * pixels for which the expression evaluates to NaN are set to dfNoData.
+ */
+
+CPLErr VRTPixelExpression::Evaluate( void **papoSources, int nSources,
+                                     void *pData, int nBufXSize, int nBufYSize,
+                                     GDALDataType eSrcType,
+                                     GDALDataType eBufType,
+                                     int nPixelSpace, int nLineSpace,
+                                     int bNoDataSet, double dfNoData )
+
+{
+    if( nMaxSource > nSources )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Pixel function expression '%s' refers to B%d, "
+                  "but the band has only %d source(s).",
+                  pszExpression, nMaxSource, nSources );
+        return CE_Failure;
+    }
+
+    double *padfRegisters = (double *)
+        VSIMalloc3( nRegisters, VRT_EXPR_CHUNK_SIZE, sizeof(double) );
+    double **papadfRegs = (double **)
+        VSIMalloc2( nRegisters, sizeof(double *) );
+    if( padfRegisters == NULL || papadfRegs == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate registers of pixel function expression." );
+        VSIFree( padfRegisters );
+        VSIFree( papadfRegs );
+        return CE_Failure;
+    }
+    for( int iReg = 0; iReg < nRegisters; iReg++ )
+        papadfRegs[iReg] = padfRegisters + iReg * VRT_EXPR_CHUNK_SIZE;
+
+    const double *padfResult = papadfRegs[nResultReg];
+    const GIntBig nPixels = (GIntBig)nBufXSize * nBufYSize;
+    int iLine = 0;
+    int iCol = 0;
+
+    for( GIntBig iStart = 0; iStart < nPixels; iStart += VRT_EXPR_CHUNK_SIZE )
+    {
+        const int nCount = (int) MIN( (GIntBig)VRT_EXPR_CHUNK_SIZE,
+                                      nPixels - iStart );
+
+        for( int iSource = 0; iSource < nMaxSource; iSource++ )
+            VRTExprLoadSource( papoSources[iSource], eSrcType, (size_t)iStart,
+                               nCount, papadfRegs[iSource] );
+
+        Run( papadfRegs, nCount );
+
+        if( bNoDataSet )
+        {
+            double *padfDst = papadfRegs[nResultReg];
+            for( int i = 0; i < nCount; i++ )
+            {
+                if( CPLIsNan(padfDst[i]) )
+                    padfDst[i] = dfNoData;
+            }
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Write the chunk, that may span several lines of the output      */
+/*      buffer.                                                         */
+/* -------------------------------------------------------------------- */
+        int iDone = 0;
+        while( iDone < nCount )
+        {
+            int nRun = MIN( nCount - iDone, nBufXSize - iCol );
+            GDALCopyWords( (void *)(padfResult + iDone), GDT_Float64,
+                           sizeof(double),
+                           ((GByte *) pData) + (GIntBig)nLineSpace * iLine
+                           + (GIntBig)nPixelSpace * iCol,
+                           eBufType, nPixelSpace, nRun );
+            iDone += nRun;
+            iCol += nRun;
+            if( iCol == nBufXSize )
+            {
+                iCol = 0;
+                iLine ++;
+            }
+        }
+    }
+
+    VSIFree( padfRegisters );
+    VSIFree( papadfRegs );
+
+    return CE_None;
+}
@@ -31,9 +31,15 @@
 #include "vrtdataset.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include <algorithm>
+#include <map>
 
 CPL_CVSID("$Id$");
 
+/* Below that number of sources, scanning them all is cheap enough */
+#define VRT_MIN_SOURCES_FOR_INDEX   64
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          VRTSourcedRasterBand                        */
@@ -97,6 +103,9 @@ void VRTSourcedRasterBand::Initialize( int nXSize, int nYSize )
     bEqualAreas = FALSE;
     nRecursionCounter = 0;
     papszSourceList = NULL;
+    hSourceIndex = NULL;
+    nIndexedSources = 0;
+    papoIndexedSources = NULL;
 }
 
 /************************************************************************/
@@ -121,8 +130,7 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                                  int nPixelSpace, int nLineSpace )
 
 {
-    int         iSource;
-    CPLErr      eErr = CE_None;
+    CPLErr      eErr;
 
     if( eRWFlag == GF_Write )
     {
@@ -198,19 +206,487 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 /* -------------------------------------------------------------------- */
 /*      Overlay each source in turn over top this.                      */
 /* -------------------------------------------------------------------- */
-    for( iSource = 0; eErr == CE_None && iSource < nSources; iSource++ )
-    {
-        eErr = 
-            papoSources[iSource]->RasterIO( nXOff, nYOff, nXSize, nYSize, 
-                                            pData, nBufXSize, nBufYSize, 
-                                            eBufType, nPixelSpace, nLineSpace);
-    }
+    eErr = SourcesRasterIO( nXOff, nYOff, nXSize, nYSize,
+                            pData, nBufXSize, nBufYSize, eBufType,
+                            1, NULL, nPixelSpace, nLineSpace, 0 );
     
     nRecursionCounter --;
     
     return eErr;
 }
 
+/************************************************************************/
+/*                          VRTSourcesRequest                           */
+/************************************************************************/
+
+/* A read request shared by the jobs of SourcesRasterIO() */
+typedef struct
+{
+    int            nXOff;
+    int            nYOff;
+    int            nXSize;
+    int            nYSize;
+    void          *pData;
+    int            nBufXSize;
+    int            nBufYSize;
+    GDALDataType   eBufType;
+    int            nBandCount;
+    int           *panBandMap;   /* NULL for a read of a single band */
+    int            nPixelSpace;
+    int            nLineSpace;
+    int            nBandSpace;
+} VRTSourcesRequest;
+
+typedef struct
+{
+    const VRTSourcesRequest *psRequest;
+    VRTSource    **papoSources;
+    int           *panSources;
+    int            nSourceCount;
+    CPLErr         eErr;
+} VRTSourcesJob;
+
+/************************************************************************/
+/*                          VRTReadSources()                            */
+/************************************************************************/
+
+static CPLErr VRTReadSources( const VRTSourcesRequest *psRequest,
+                              VRTSource **papoSources,
+                              const int *panSources, int nSourceCount )
+
+{
+    CPLErr eErr = CE_None;
+
+    for( int i = 0; eErr == CE_None && i < nSourceCount; i++ )
+    {
+        int iSource = panSources ? panSources[i] : i;
+
+        if( psRequest->panBandMap == NULL )
+            eErr = papoSources[iSource]->RasterIO(
+                psRequest->nXOff, psRequest->nYOff,
+                psRequest->nXSize, psRequest->nYSize,
+                psRequest->pData,
+                psRequest->nBufXSize, psRequest->nBufYSize,
+                psRequest->eBufType,
+                psRequest->nPixelSpace, psRequest->nLineSpace );
+        else
+            eErr = ((VRTSimpleSource *) papoSources[iSource])->DatasetRasterIO(
+                psRequest->nXOff, psRequest->nYOff,
+                psRequest->nXSize, psRequest->nYSize,
+                psRequest->pData,
+                psRequest->nBufXSize, psRequest->nBufYSize,
+                psRequest->eBufType,
+                psRequest->nBandCount, psRequest->panBandMap,
+                psRequest->nPixelSpace, psRequest->nLineSpace,
+                psRequest->nBandSpace );
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                       VRTReadSourcesJobFunc()                        */
+/************************************************************************/
+
+static void VRTReadSourcesJobFunc( void *pData )
+
+{
+    VRTSourcesJob *psJob = (VRTSourcesJob *) pData;
+
+    psJob->eErr = VRTReadSources( psJob->psRequest, psJob->papoSources,
+                                  psJob->panSources, psJob->nSourceCount );
+}
+
+/* Orders the descriptions of the source datasets */
+struct VRTDescriptionLess
+{
+    bool operator()( const char *pszA, const char *pszB ) const
+    {
+        return strcmp( pszA, pszB ) < 0;
+    }
+};
+
+/************************************************************************/
+/*                       VRTAssignSourcesToWaves()                      */
+/*                                                                      */
+/*      Split the sources of a request in successive waves, so that     */
+/*      the sources of a wave can be read concurrently: they write to   */
+/*      disjoint windows of the buffer, and read from distinct          */
+/*      datasets. A source comes after all the previous sources that    */
+/*      write to an overlapping window, so compositing gives the same   */
+/*      result as reading the sources in turn. Sources whose footprint  */
+/*      or dataset is unknown are alone in their wave, after all the    */
+/*      previous sources and before all the next ones.                  */
+/*                                                                      */
+/*      panWave[i] is set to -1 for sources that do not intersect the   */
+/*      request. Returns the number of waves.                           */
+/************************************************************************/
+
+static int VRTAssignSourcesToWaves( const VRTSourcesRequest *psRequest,
+                                    VRTSource **papoSources,
+                                    const int *panSources, int nSourceCount,
+                                    int *panWave )
+
+{
+    CPLRectObj sBufBounds;
+    sBufBounds.minx = 0;
+    sBufBounds.miny = 0;
+    sBufBounds.maxx = psRequest->nBufXSize;
+    sBufBounds.maxy = psRequest->nBufYSize;
+
+    CPLQuadTree *hTree = CPLQuadTreeCreate( &sBufBounds, NULL );
+    CPLQuadTreeSetMaxDepth( hTree,
+                            CPLQuadTreeGetAdvisedMaxDepth(nSourceCount) );
+
+    CPLRectObj *pasOutWindows = (CPLRectObj *)
+        CPLMalloc( sizeof(CPLRectObj) * nSourceCount );
+    std::map<const char *, int, VRTDescriptionLess> oMapDatasetToLastWave;
+    int nWaveCount = 0;
+    int nFirstFreeWave = 0;
+
+    for( int i = 0; i < nSourceCount; i++ )
+    {
+        VRTSource *poSource = papoSources[panSources ? panSources[i] : i];
+        GDALDataset *poSrcDS = NULL;
+
+        if( poSource->IsSimpleSource() )
+            poSrcDS = ((VRTSimpleSource *) poSource)->GetSourceDataset();
+
+        if( poSrcDS == NULL || poSrcDS->GetDescription()[0] == '\0' )
+        {
+            panWave[i] = nWaveCount++;
+            nFirstFreeWave = nWaveCount;
+            continue;
+        }
+
+        int nReqXOff, nReqYOff, nReqXSize, nReqYSize;
+        int nOutXOff, nOutYOff, nOutXSize, nOutYSize;
+
+        if( !((VRTSimpleSource *) poSource)->GetSrcDstWindow(
+                psRequest->nXOff, psRequest->nYOff,
+                psRequest->nXSize, psRequest->nYSize,
+                psRequest->nBufXSize, psRequest->nBufYSize,
+                &nReqXOff, &nReqYOff, &nReqXSize, &nReqYSize,
+                &nOutXOff, &nOutYOff, &nOutXSize, &nOutYSize ) )
+        {
+            panWave[i] = -1;
+            continue;
+        }
+
+        CPLRectObj *psRect = pasOutWindows + i;
+        psRect->minx = nOutXOff;
+        psRect->miny = nOutYOff;
+        psRect->maxx = nOutXOff + nOutXSize;
+        psRect->maxy = nOutYOff + nOutYSize;
+
+        int nWave = nFirstFreeWave;
+
+        int nHits = 0;
+        void **pahHits = CPLQuadTreeSearch( hTree, psRect, &nHits );
+        for( int iHit = 0; iHit < nHits; iHit++ )
+        {
+            int j = (int)(size_t) pahHits[iHit];
+            const CPLRectObj *psOther = pasOutWindows + j;
+
+            /* The tree also returns windows that only touch this one */
+            if( psOther->minx < psRect->maxx && psRect->minx < psOther->maxx
+                && psOther->miny < psRect->maxy && psRect->miny < psOther->maxy )
+                nWave = MAX(nWave, panWave[j] + 1);
+        }
+        CPLFree( pahHits );
+
+        /* Sources of datasets with the same name may share the same */
+        /* underlying dataset, such as proxies of the dataset pool */
+        const char *pszKey = poSrcDS->GetDescription();
+        std::map<const char *, int, VRTDescriptionLess>::iterator oIter =
+            oMapDatasetToLastWave.find( pszKey );
+        if( oIter != oMapDatasetToLastWave.end() )
+            nWave = MAX(nWave, oIter->second + 1);
+        oMapDatasetToLastWave[pszKey] = nWave;
+
+        panWave[i] = nWave;
+        nWaveCount = MAX(nWaveCount, nWave + 1);
+
+        CPLQuadTreeInsertWithBounds( hTree, (void *)(size_t) i, psRect );
+    }
+
+    CPLQuadTreeDestroy( hTree );
+    CPLFree( pasOutWindows );
+
+    return nWaveCount;
+}
+
+/************************************************************************/
+/*                       VRTParallelReadSources()                       */
+/************************************************************************/
+
+static CPLErr VRTParallelReadSources( const VRTSourcesRequest *psRequest,
+                                      VRTSource **papoSources,
+                                      const int *panSources, int nSourceCount,
+                                      int nThreads )
+
+{
+    int *panWave = (int *) CPLMalloc( sizeof(int) * nSourceCount );
+    int nWaveCount = VRTAssignSourcesToWaves( psRequest, papoSources,
+                                              panSources, nSourceCount,
+                                              panWave );
+
+/* -------------------------------------------------------------------- */
+/*      Sort the sources by wave, keeping their order within a wave.    */
+/* -------------------------------------------------------------------- */
+    int *panWaveStart = (int *) CPLCalloc( sizeof(int), nWaveCount + 1 );
+    int i;
+
+    for( i = 0; i < nSourceCount; i++ )
+    {
+        if( panWave[i] >= 0 )
+            panWaveStart[panWave[i] + 1] ++;
+    }
+    for( i = 0; i < nWaveCount; i++ )
+        panWaveStart[i + 1] += panWaveStart[i];
+
+    int *panSorted = (int *)
+        CPLMalloc( sizeof(int) * MAX(1, panWaveStart[nWaveCount]) );
+    int *panNext = (int *) CPLMalloc( sizeof(int) * MAX(1, nWaveCount) );
+    memcpy( panNext, panWaveStart, sizeof(int) * nWaveCount );
+    for( i = 0; i < nSourceCount; i++ )
+    {
+        if( panWave[i] >= 0 )
+            panSorted[panNext[panWave[i]]++] = panSources ? panSources[i] : i;
+    }
+    CPLFree( panNext );
+    CPLFree( panWave );
+
+/* -------------------------------------------------------------------- */
+/*      Read the waves in turn. The sources of a wave are split in      */
+/*      contiguous runs, one per job.                                   */
+/* -------------------------------------------------------------------- */
+    CPLJobGroup *psJobGroup = NULL;
+    VRTSourcesJob *pasJobs = (VRTSourcesJob *)
+        CPLMalloc( sizeof(VRTSourcesJob) * nThreads );
+    CPLErr eErr = CE_None;
+
+    for( int iWave = 0; eErr == CE_None && iWave < nWaveCount; iWave++ )
+    {
+        int *panWaveSources = panSorted + panWaveStart[iWave];
+        int nWaveSources = panWaveStart[iWave + 1] - panWaveStart[iWave];
+
+        if( nWaveSources == 1 )
+        {
+            eErr = VRTReadSources( psRequest, papoSources, panWaveSources, 1 );
+            continue;
+        }
+
+        if( psJobGroup == NULL )
+            psJobGroup = CPLCreateJobGroup();
+
+        int nJobs = MIN(nThreads, nWaveSources);
+        int iJob;
+        for( iJob = 0; iJob < nJobs; iJob++ )
+        {
+            int nStart = (int) ((GIntBig) nWaveSources * iJob / nJobs);
+            int nEnd = (int) ((GIntBig) nWaveSources * (iJob + 1) / nJobs);
+
+            pasJobs[iJob].psRequest = psRequest;
+            pasJobs[iJob].papoSources = papoSources;
+            pasJobs[iJob].panSources = panWaveSources + nStart;
+            pasJobs[iJob].nSourceCount = nEnd - nStart;
+            pasJobs[iJob].eErr = CE_None;
+            CPLSubmitJob( psJobGroup, VRTReadSourcesJobFunc, pasJobs + iJob );
+        }
+        CPLWaitJobGroup( psJobGroup );
+
+        for( iJob = 0; iJob < nJobs; iJob++ )
+        {
+            if( pasJobs[iJob].eErr != CE_None )
+                eErr = pasJobs[iJob].eErr;
+        }
+    }
+
+    if( psJobGroup != NULL )
+        CPLDestroyJobGroup( psJobGroup );
+    CPLFree( pasJobs );
+    CPLFree( panSorted );
+    CPLFree( panWaveStart );
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                          SourcesRasterIO()                           */
+/*                                                                      */
+/*      Overlay the sources intersecting the request on the buffer.     */
+/*      If panBandMap is not NULL, this is a dataset level request      */
+/*      done with VRTSimpleSource::DatasetRasterIO(). When the dataset  */
+/*      has several threads, sources are read concurrently.             */
+/************************************************************************/
+
+CPLErr VRTSourcedRasterBand::SourcesRasterIO( int nXOff, int nYOff,
+                                              int nXSize, int nYSize,
+                                              void *pData,
+                                              int nBufXSize, int nBufYSize,
+                                              GDALDataType eBufType,
+                                              int nBandCount, int *panBandMap,
+                                              int nPixelSpace, int nLineSpace,
+                                              int nBandSpace )
+
+{
+    VRTSourcesRequest sRequest;
+
+    sRequest.nXOff = nXOff;
+    sRequest.nYOff = nYOff;
+    sRequest.nXSize = nXSize;
+    sRequest.nYSize = nYSize;
+    sRequest.pData = pData;
+    sRequest.nBufXSize = nBufXSize;
+    sRequest.nBufYSize = nBufYSize;
+    sRequest.eBufType = eBufType;
+    sRequest.nBandCount = nBandCount;
+    sRequest.panBandMap = panBandMap;
+    sRequest.nPixelSpace = nPixelSpace;
+    sRequest.nLineSpace = nLineSpace;
+    sRequest.nBandSpace = nBandSpace;
+
+    int *panSources = NULL;
+    int nCandidates = GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize,
+                                          &panSources );
+
+    int nThreads = (poDS != NULL) ? ((VRTDataset *) poDS)->GetNumThreads() : 1;
+
+    CPLErr eErr;
+    if( nThreads > 1 && nCandidates > 1 )
+        eErr = VRTParallelReadSources( &sRequest, papoSources,
+                                       panSources, nCandidates, nThreads );
+    else
+        eErr = VRTReadSources( &sRequest, papoSources,
+                               panSources, nCandidates );
+
+    CPLFree( panSources );
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                         InvalidateSourceIndex()                      */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourceIndex()
+
+{
+    if( hSourceIndex != NULL )
+    {
+        CPLQuadTreeDestroy( hSourceIndex );
+        hSourceIndex = NULL;
+    }
+    nIndexedSources = 0;
+    papoIndexedSources = NULL;
+}
+
+/************************************************************************/
+/*                          BuildSourceIndex()                          */
+/*                                                                      */
+/*      Index the destination window of each source. Sources whose      */
+/*      footprint is unknown are indexed with the extent of the band    */
+/*      so that they are always returned.                               */
+/************************************************************************/
+
+int VRTSourcedRasterBand::BuildSourceIndex()
+
+{
+    InvalidateSourceIndex();
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = 0;
+    sGlobalBounds.miny = 0;
+    sGlobalBounds.maxx = nRasterXSize;
+    sGlobalBounds.maxy = nRasterYSize;
+
+    hSourceIndex = CPLQuadTreeCreate( &sGlobalBounds, NULL );
+    if( hSourceIndex == NULL )
+        return FALSE;
+    CPLQuadTreeSetMaxDepth( hSourceIndex,
+                            CPLQuadTreeGetAdvisedMaxDepth(nSources) );
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        CPLRectObj sRect = sGlobalBounds;
+        int nDstXOff, nDstYOff, nDstXSize, nDstYSize;
+
+        if( papoSources[iSource]->IsSimpleSource()
+            && ((VRTSimpleSource *) papoSources[iSource])->GetDstWindow(
+                    &nDstXOff, &nDstYOff, &nDstXSize, &nDstYSize )
+            && nDstXSize >= 0 && nDstYSize >= 0 )
+        {
+            /* Clamp to the band extent so the tree stays balanced. */
+            /* This can only make the rectangle intersect more requests */
+            sRect.minx = MAX(0.0, MIN(sGlobalBounds.maxx, (double)nDstXOff));
+            sRect.miny = MAX(0.0, MIN(sGlobalBounds.maxy, (double)nDstYOff));
+            sRect.maxx = MAX(0.0, MIN(sGlobalBounds.maxx,
+                                      (double)nDstXOff + nDstXSize));
+            sRect.maxy = MAX(0.0, MIN(sGlobalBounds.maxy,
+                                      (double)nDstYOff + nDstYSize));
+        }
+
+        CPLQuadTreeInsertWithBounds( hSourceIndex,
+                                     (void*)(size_t)iSource, &sRect );
+    }
+
+    nIndexedSources = nSources;
+    papoIndexedSources = papoSources;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                         GetSourcesInWindow()                         */
+/*                                                                      */
+/*      Returns the number of sources that may contribute to the        */
+/*      passed window. *ppanSources is set to the CPLMalloc()'ed list   */
+/*      of their indices, in increasing order so that the compositing   */
+/*      order is preserved, or to NULL if all the sources must be       */
+/*      visited.                                                        */
+/************************************************************************/
+
+int VRTSourcedRasterBand::GetSourcesInWindow( int nXOff, int nYOff,
+                                              int nXSize, int nYSize,
+                                              int **ppanSources )
+
+{
+    *ppanSources = NULL;
+
+    if( nSources < VRT_MIN_SOURCES_FOR_INDEX )
+        return nSources;
+
+    /* nSources and papoSources are public, so check the index is in sync */
+    if( hSourceIndex == NULL
+        || nIndexedSources != nSources
+        || papoIndexedSources != papoSources )
+    {
+        if( !CSLTestBoolean( CPLGetConfigOption( "VRT_SOURCE_INDEX", "YES" ) )
+            || !BuildSourceIndex() )
+            return nSources;
+    }
+
+    CPLRectObj sAoi;
+    sAoi.minx = nXOff;
+    sAoi.miny = nYOff;
+    sAoi.maxx = (double)nXOff + nXSize;
+    sAoi.maxy = (double)nYOff + nYSize;
+
+    int nCount = 0;
+    void **pahSources = CPLQuadTreeSearch( hSourceIndex, &sAoi, &nCount );
+
+    int *panSources = (int *) CPLMalloc( sizeof(int) * MAX(1, nCount) );
+    for( int i = 0; i < nCount; i++ )
+        panSources[i] = (int)(size_t)pahSources[i];
+    CPLFree( pahSources );
+
+    std::sort( panSources, panSources + nCount );
+
+    *ppanSources = panSources;
+    return nCount;
+}
+
 /************************************************************************/
 /*                             IReadBlock()                             */
 /************************************************************************/
@@ -580,6 +1056,8 @@ CPLErr VRTSourcedRasterBand::GetHistogram( double dfMin, double dfMax,
 CPLErr VRTSourcedRasterBand::AddSource( VRTSource *poNewSource )
 
 {
+    InvalidateSourceIndex();
+
     nSources++;
 
     papoSources = (VRTSource **) 
@@ -1051,9 +1529,14 @@ const char *VRTSourcedRasterBand::GetMetadataItem( const char * pszName,
         CPLHashSet* hSetFiles = CPLHashSetNew(CPLHashSetHashStr,
                                               CPLHashSetEqualStr,
                                               NULL);
+
+        int *panSources = NULL;
+        int nCandidates = GetSourcesInWindow( iPixel, iLine, 1, 1,
+                                              &panSources );
         
-        for( int iSource = 0; iSource < nSources; iSource++ )
+        for( int i = 0; i < nCandidates; i++ )
         {
+            int iSource = panSources ? panSources[i] : i;
             int nReqXOff, nReqYOff, nReqXSize, nReqYSize;
             int nOutXOff, nOutYOff, nOutXSize, nOutYSize;
 
@@ -1072,6 +1555,7 @@ const char *VRTSourcedRasterBand::GetMetadataItem( const char * pszName,
             poSrc->GetFileList( &papszFileList, &nListSize, &nListMaxSize,
                                 hSetFiles );
         }
+        CPLFree( panSources );
         
 /* -------------------------------------------------------------------- */
 /*      Format into XML.                                                */
@@ -1208,6 +1692,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem( const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourceIndex();
             ((VRTDataset *)poDS)->SetNeedsFlush();
             return CE_None;
         }
@@ -1235,6 +1720,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata( char **papszNewMD, const char *pszDoma
 
         if( EQUAL(pszDomain,"vrt_sources") )
         {
+            InvalidateSourceIndex();
             for( int i = 0; i < nSources; i++ )
                 delete papoSources[i];
             CPLFree( papoSources );
@@ -1293,6 +1779,8 @@ void VRTSourcedRasterBand::GetFileList(char*** ppapszFileList, int *pnSize,
 
 int VRTSourcedRasterBand::CloseDependentDatasets()
 {
+    InvalidateSourceIndex();
+
     if (nSources == 0)
         return FALSE;
 
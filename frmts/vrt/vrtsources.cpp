@@ -624,6 +624,20 @@ GDALRasterBand* VRTSimpleSource::GetBand()
     return poMaskBandMainBand ? NULL : poRasterBand;
 }
 
+/************************************************************************/
+/*                          GetSourceDataset()                          */
+/*                                                                      */
+/*      Dataset read by the source, including when it is a mask band.   */
+/*      May be NULL.                                                    */
+/************************************************************************/
+
+GDALDataset* VRTSimpleSource::GetSourceDataset()
+{
+    GDALRasterBand* poBand = poMaskBandMainBand ? poMaskBandMainBand
+                                                : poRasterBand;
+    return poBand ? poBand->GetDataset() : NULL;
+}
+
 /************************************************************************/
 /*                       IsSameExceptBandNumber()                       */
 /************************************************************************/
@@ -675,6 +689,29 @@ void VRTSimpleSource::DstToSrc( double dfX, double dfY,
     dfYOut = ((dfY - nDstYOff) / nDstYSize) * nSrcYSize + nSrcYOff;
 }
 
+/************************************************************************/
+/*                            GetDstWindow()                            */
+/*                                                                      */
+/*      Returns FALSE if no destination window is set, in which case    */
+/*      the source is assumed to cover the whole virtual band.          */
+/************************************************************************/
+
+int VRTSimpleSource::GetDstWindow( int *pnDstXOff, int *pnDstYOff,
+                                   int *pnDstXSize, int *pnDstYSize )
+
+{
+    if( nDstXOff == -1 && nDstXSize == -1
+        && nDstYOff == -1 && nDstYSize == -1 )
+        return FALSE;
+
+    *pnDstXOff = nDstXOff;
+    *pnDstYOff = nDstYOff;
+    *pnDstXSize = nDstXSize;
+    *pnDstYSize = nDstYSize;
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                          GetSrcDstWindow()                           */
 /************************************************************************/
@@ -369,6 +369,10 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
                           void *, int, int, GDALDataType,
                           int, int *, int, int, int );
+    CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
+                          void *, int, int, GDALDataType,
+                          int, int *, int, int, int,
+                          GDALRasterIOExtraArg* psExtraArg );
 
     int           Reference();
     int           Dereference();
@@ -469,6 +473,8 @@ class CPL_DLL GDALRasterBlock
     GDALRasterBlock     *poNext;
     GDALRasterBlock     *poPrevious;
 
+    int                 nShard;
+
   public:
                 GDALRasterBlock( GDALRasterBand *, int, int );
     virtual     ~GDALRasterBlock();
@@ -500,7 +506,8 @@ class CPL_DLL GDALRasterBlock
     static int  FlushCacheBlock();
     static void Verify();
 
-    static int  SafeLockBlock( GDALRasterBlock ** );
+    static int  SafeLockBlock( GDALRasterBlock **, GDALRasterBand *,
+                               int nXOff, int nYOff );
     
     /* Should only be called by GDALDestroyDriverManager() */
     static void DestroyRBMutex();
@@ -546,6 +553,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     CPLErr eFlushBlockErr;
 
     void           SetFlushBlockErr( CPLErr eErr );
+    int            ResizeBlockHash( int nNewSize );
 
     friend class GDALRasterBlock;
 
@@ -570,6 +578,13 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     int         nSubBlocksPerColumn;
     GDALRasterBlock **papoBlocks;
 
+    /* When active, papoBlocks is an open addressing hash table of */
+    /* nBlockHashSize entries, keyed by the block offsets */
+    int         bSparseBlockingActive;
+    int         nBlockHashSize;
+    int         nBlockHashCount;
+    void       *hBlockHashMutex;
+
     int         nBlockReads;
     int         bForceCachedIO;
 
@@ -589,6 +604,9 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     CPLErr         OverviewRasterIO( GDALRWFlag, int, int, int, int,
                                      void *, int, int, GDALDataType,
                                      int, int );
+    CPLErr         RasterIOResampled( int, int, int, int,
+                                      void *, int, int, GDALDataType,
+                                      int, int, GDALRasterIOExtraArg* );
 
     int            InitBlockInfo();
 
@@ -612,6 +630,9 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
                           void *, int, int, GDALDataType,
                           int, int );
+    CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
+                          void *, int, int, GDALDataType,
+                          int, int, GDALRasterIOExtraArg* psExtraArg );
     CPLErr      ReadBlock( int, int, void * );
 
     CPLErr      WriteBlock( int, int, void * );
@@ -990,6 +1011,8 @@ int CPL_DLL GDALBandGetBestOverviewLevel(GDALRasterBand* poBand,
 
 int CPL_DLL GDALOvLevelAdjust( int nOvLevel, int nXSize );
 
+GDALRIOResampleAlg CPL_DLL GDALRasterIOGetResampleAlg(const char* pszResampling);
+
 GDALDataset CPL_DLL *
 GDALFindAssociatedAuxFile( const char *pszBasefile, GDALAccess eAccess,
                            GDALDataset *poDependentDS );
@@ -1032,11 +1055,23 @@ CPL_C_END
 void GDALNullifyOpenDatasetsList();
 void** GDALGetphDMMutex();
 void** GDALGetphDLMutex();
+void GDALAcquireDLMutex();
+void GDALReleaseDLMutex();
+int GDALGetDLMutexDepth();
 void GDALNullifyProxyPoolSingleton();
 GDALDriver* GDALGetAPIPROXYDriver();
 void GDALSetResponsiblePIDForCurrentThread(GIntBig responsiblePID);
 GIntBig GDALGetResponsiblePIDForCurrentThread();
 
+/* Holder of the mutex returned by GDALGetphDLMutex(). It must be used */
+/* instead of CPLMutexHolderD() so that GDALGetDLMutexDepth() is accurate */
+class GDALDLMutexHolder
+{
+    public:
+        GDALDLMutexHolder() { GDALAcquireDLMutex(); }
+        ~GDALDLMutexHolder() { GDALReleaseDLMutex(); }
+};
+
 CPLString GDALFindAssociatedFile( const char *pszBasename, const char *pszExt,
                                   char **papszSiblingFiles, int nFlags );
 
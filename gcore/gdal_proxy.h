@@ -209,7 +209,9 @@ class CPL_DLL GDALProxyPoolDataset : public GDALProxyDataset
         CPLHashSet      *metadataSet;
         CPLHashSet      *metadataItemSet;
 
-        GDALProxyPoolCacheEntry* cacheEntry;
+        /* Protects the above caches, and those of the bands, since */
+        /* the sources of a VRT can be read by several threads */
+        void            *hCacheMutex;
 
     protected:
         virtual GDALDataset *RefUnderlyingDataset();
@@ -270,6 +272,8 @@ class CPL_DLL GDALProxyPoolRasterBand : public GDALProxyRasterBand
         void Init();
 
     protected:
+        void** GetCacheMutex();
+
         virtual GDALRasterBand* RefUnderlyingRasterBand();
         virtual void UnrefUnderlyingRasterBand(GDALRasterBand* poUnderlyingRasterBand);
 
@@ -311,8 +315,9 @@ class GDALProxyPoolOverviewRasterBand : public GDALProxyPoolRasterBand
         GDALProxyPoolRasterBand *poMainBand;
         int                      nOverviewBand;
 
-        GDALRasterBand          *poUnderlyingMainRasterBand;
-        int                      nRefCountUnderlyingMainRasterBand;
+        /* Underlying main band of each band returned by RefUnderlyingRasterBand(), */
+        /* with its reference count, since the band can be used by several threads */
+        std::map<GDALRasterBand*, std::pair<GDALRasterBand*, int> > oMapUnderlyingMainRasterBand;
 
     protected:
         virtual GDALRasterBand* RefUnderlyingRasterBand();
@@ -335,8 +340,9 @@ class GDALProxyPoolMaskBand : public GDALProxyPoolRasterBand
     private:
         GDALProxyPoolRasterBand *poMainBand;
 
-        GDALRasterBand          *poUnderlyingMainRasterBand;
-        int                      nRefCountUnderlyingMainRasterBand;
+        /* Underlying main band of each band returned by RefUnderlyingRasterBand(), */
+        /* with its reference count, since the band can be used by several threads */
+        std::map<GDALRasterBand*, std::pair<GDALRasterBand*, int> > oMapUnderlyingMainRasterBand;
 
     protected:
         virtual GDALRasterBand* RefUnderlyingRasterBand();
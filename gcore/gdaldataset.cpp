@@ -38,6 +38,7 @@
 #include "ogr_attrind.h"
 #include "ogr_p.h"
 #include "ogrunionlayer.h"
+#include <algorithm>
 
 #ifdef SQLITE_ENABLED
 #include "../sqlite/ogrsqliteexecutesql.h"
@@ -120,6 +121,30 @@ void** GDALGetphDLMutex()
     return &hDLMutex;
 }
 
+/* Acquire the open-shared mutex and count how many times the current */
+/* thread holds it, so that GDALGetDLMutexDepth() can tell whether */
+/* releasing it once really unlocks it. Waiting on a condition, or */
+/* releasing it around a long operation, is only safe at depth 1 */
+void GDALAcquireDLMutex()
+{
+    CPLCreateOrAcquireMutex( &hDLMutex, 1000.0 );
+    int nDepth = (int)(size_t) CPLGetTLS(CTLS_GDALDATASET_DLMUTEX_DEPTH);
+    CPLSetTLS(CTLS_GDALDATASET_DLMUTEX_DEPTH, (void*)(size_t)(nDepth + 1), FALSE);
+}
+
+void GDALReleaseDLMutex()
+{
+    int nDepth = (int)(size_t) CPLGetTLS(CTLS_GDALDATASET_DLMUTEX_DEPTH);
+    CPLSetTLS(CTLS_GDALDATASET_DLMUTEX_DEPTH, (void*)(size_t)(nDepth - 1), FALSE);
+    CPLReleaseMutex( hDLMutex );
+}
+
+/* Number of times the current thread holds the open-shared mutex */
+int GDALGetDLMutexDepth()
+{
+    return (int)(size_t) CPLGetTLS(CTLS_GDALDATASET_DLMUTEX_DEPTH);
+}
+
 /* The current thread will act in the behalf of the thread of PID responsiblePID */
 void GDALSetResponsiblePIDForCurrentThread(GIntBig responsiblePID)
 {
@@ -181,7 +206,7 @@ GDALDataset::GDALDataset()
 /*      Add this dataset to the open dataset list.                      */
 /* -------------------------------------------------------------------- */
     {
-        CPLMutexHolderD( &hDLMutex );
+        GDALDLMutexHolder oHolder;
 
         if (poAllDatasetMap == NULL)
             poAllDatasetMap = new std::map<GDALDataset*, GIntBig>;
@@ -241,7 +266,7 @@ GDALDataset::~GDALDataset()
 /*      Remove dataset from the "open" dataset list.                    */
 /* -------------------------------------------------------------------- */
     {
-        CPLMutexHolderD( &hDLMutex );
+        GDALDLMutexHolder oHolder;
         if( poAllDatasetMap )
         {
             std::map<GDALDataset*, GIntBig>::iterator oIter = poAllDatasetMap->find(this);
@@ -419,6 +444,57 @@ void GDALDataset::BlockBasedFlushCache()
         }
     }
 
+/* -------------------------------------------------------------------- */
+/*      With block hash tables, the raster might have far too many      */
+/*      blocks to iterate over all of them, so only visit the offsets   */
+/*      of the cached blocks, in the same order.                        */
+/* -------------------------------------------------------------------- */
+    if( poBand1->bSparseBlockingActive )
+    {
+        std::vector< std::pair<int,int> > aoBlockOffsets;
+
+        for( iBand = 0; iBand < nBands; iBand++ )
+        {
+            GDALRasterBand *poBand = GetRasterBand( iBand+1 );
+            if( poBand->papoBlocks == NULL )
+                continue;
+            if( !poBand->bSparseBlockingActive )
+            {
+                GDALDataset::FlushCache();
+                return;
+            }
+
+            CPLMutexHolderOptionalLockD( poBand->hBlockHashMutex );
+            for( int iSlot = 0; iSlot < poBand->nBlockHashSize; iSlot++ )
+            {
+                GDALRasterBlock *poBlock = poBand->papoBlocks[iSlot];
+                if( poBlock != NULL )
+                    aoBlockOffsets.push_back(
+                        std::pair<int,int>( poBlock->GetYOff(),
+                                            poBlock->GetXOff() ) );
+            }
+        }
+
+        std::sort( aoBlockOffsets.begin(), aoBlockOffsets.end() );
+
+        for( size_t i = 0; i < aoBlockOffsets.size(); i++ )
+        {
+            if( i > 0 && aoBlockOffsets[i] == aoBlockOffsets[i-1] )
+                continue;
+
+            for( iBand = 0; iBand < nBands; iBand++ )
+            {
+                GDALRasterBand *poBand = GetRasterBand( iBand+1 );
+
+                CPLErr eErr = poBand->FlushBlock( aoBlockOffsets[i].second,
+                                                  aoBlockOffsets[i].first );
+                if( eErr != CE_None )
+                    return;
+            }
+        }
+        return;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Now flush writable data.                                        */
 /* -------------------------------------------------------------------- */
@@ -1131,7 +1207,7 @@ void GDALDataset::MarkAsShared()
     SharedDatasetCtxt* psStruct;
 
     /* Insert the dataset in the set of shared opened datasets */
-    CPLMutexHolderD( &hDLMutex );
+    GDALDLMutexHolder oHolder;
     if (phSharedDatasetSet == NULL)
         phSharedDatasetSet = CPLHashSetNew(GDALSharedDatasetHashFunc, GDALSharedDatasetEqualFunc, GDALSharedDatasetFreeFunc);
 
@@ -1667,6 +1743,45 @@ CPLErr GDALDataset::RasterIO( GDALRWFlag eRWFlag,
                               int nBandCount, int *panBandMap,
                               int nPixelSpace, int nLineSpace, int nBandSpace )
 
+{
+    return RasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                     pData, nBufXSize, nBufYSize, eBufType,
+                     nBandCount, panBandMap,
+                     nPixelSpace, nLineSpace, nBandSpace, NULL );
+}
+
+/************************************************************************/
+/*                              RasterIO()                              */
+/************************************************************************/
+
+/**
+ * \brief Read/write a region of image data from multiple bands, with extra
+ * arguments.
+ *
+ * This is the same as the other RasterIO() method, except for the
+ * psExtraArg argument, that may be NULL. See
+ * GDALRasterBand::RasterIO(GDALRWFlag, int, int, int, int, void *, int, int, GDALDataType, int, int, GDALRasterIOExtraArg*)
+ * for the meaning of the resampling method and of the progress callback.
+ * A resampled read is done band per band.
+ *
+ * This method is the same as the C GDALDatasetRasterIOEx() function.
+ *
+ * @param psExtraArg pointer to a GDALRasterIOExtraArg structure, initialized
+ * with INIT_RASTERIO_EXTRA_ARG(), or NULL.
+ *
+ * @return CE_Failure if the access fails, otherwise CE_None.
+ *
+ * @since GDAL 2.0
+ */
+
+CPLErr GDALDataset::RasterIO( GDALRWFlag eRWFlag,
+                              int nXOff, int nYOff, int nXSize, int nYSize,
+                              void * pData, int nBufXSize, int nBufYSize,
+                              GDALDataType eBufType, 
+                              int nBandCount, int *panBandMap,
+                              int nPixelSpace, int nLineSpace, int nBandSpace,
+                              GDALRasterIOExtraArg* psExtraArg )
+
 {
     int i = 0;
     int bNeedToFreeBandMap = FALSE;
@@ -1691,6 +1806,14 @@ CPLErr GDALDataset::RasterIO( GDALRWFlag eRWFlag,
         return CE_Failure;
     }
 
+    if( psExtraArg != NULL && psExtraArg->nVersion < 1 )
+    {
+        ReportError( CE_Failure, CPLE_IllegalArg,
+                  "Unsupported GDALRasterIOExtraArg version: %d.",
+                  psExtraArg->nVersion );
+        return CE_Failure;
+    }
+
     int bStopProcessing = FALSE;
     eErr = ValidateRasterIOOrAdviseReadParameters( "RasterIO()", &bStopProcessing,
                                                     nXOff, nYOff, nXSize, nYSize,
@@ -1747,11 +1870,46 @@ CPLErr GDALDataset::RasterIO( GDALRWFlag eRWFlag,
     }
 
 
+/* -------------------------------------------------------------------- */
+/*      Resampled reads are done band per band.                         */
+/* -------------------------------------------------------------------- */
+    int bResampled = ( psExtraArg != NULL && eRWFlag == GF_Read &&
+                       psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
+                       (nBufXSize != nXSize || nBufYSize != nYSize) );
+    if( bResampled )
+    {
+        GDALRasterIOExtraArg sBandExtraArg = *psExtraArg;
+
+        for( i = 0; i < nBandCount && eErr == CE_None; i++ )
+        {
+            GDALRasterBand *poBand = GetRasterBand( panBandMap[i] );
+
+            if( psExtraArg->pfnProgress != NULL )
+            {
+                sBandExtraArg.pfnProgress = GDALScaledProgress;
+                sBandExtraArg.pProgressData = 
+                    GDALCreateScaledProgress( i / (double) nBandCount,
+                                              (i+1) / (double) nBandCount,
+                                              psExtraArg->pfnProgress,
+                                              psExtraArg->pProgressData );
+            }
+
+            eErr = poBand->RasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                     ((GByte *) pData) + i * nBandSpace,
+                                     nBufXSize, nBufYSize, eBufType,
+                                     nPixelSpace, nLineSpace,
+                                     &sBandExtraArg );
+
+            if( psExtraArg->pfnProgress != NULL )
+                GDALDestroyScaledProgress( sBandExtraArg.pProgressData );
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      We are being forced to use cached IO instead of a driver        */
 /*      specific implementation.                                        */
 /* -------------------------------------------------------------------- */
-    if( bForceCachedIO )
+    else if( bForceCachedIO )
     {
         eErr = 
             BlockBasedRasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
@@ -1772,6 +1930,10 @@ CPLErr GDALDataset::RasterIO( GDALRWFlag eRWFlag,
                        nPixelSpace, nLineSpace, nBandSpace );
     }
 
+    if( eErr == CE_None && !bResampled && psExtraArg != NULL &&
+        psExtraArg->pfnProgress != NULL )
+        psExtraArg->pfnProgress( 1.0, "", psExtraArg->pProgressData );
+
 /* -------------------------------------------------------------------- */
 /*      Cleanup                                                         */
 /* -------------------------------------------------------------------- */
@@ -1809,6 +1971,39 @@ GDALDatasetRasterIO( GDALDatasetH hDS, GDALRWFlag eRWFlag,
                             nBandCount, panBandMap, 
                             nPixelSpace, nLineSpace, nBandSpace ) );
 }
+
+/************************************************************************/
+/*                       GDALDatasetRasterIOEx()                        */
+/************************************************************************/
+
+/**
+ * \brief Read/write a region of image data from multiple bands, with extra
+ * arguments.
+ *
+ * @see GDALDataset::RasterIO(GDALRWFlag, int, int, int, int, void *, int, int, GDALDataType, int, int *, int, int, int, GDALRasterIOExtraArg*)
+ * @since GDAL 2.0
+ */
+
+CPLErr CPL_STDCALL 							
+GDALDatasetRasterIOEx( GDALDatasetH hDS, GDALRWFlag eRWFlag,
+                       int nXOff, int nYOff, int nXSize, int nYSize,
+                       void * pData, int nBufXSize, int nBufYSize,
+                       GDALDataType eBufType,
+                       int nBandCount, int *panBandMap,
+                       int nPixelSpace, int nLineSpace, int nBandSpace,
+                       GDALRasterIOExtraArg* psExtraArg )
+    
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetRasterIOEx", CE_Failure );
+
+    GDALDataset    *poDS = (GDALDataset *) hDS;
+    
+    return( poDS->RasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                            pData, nBufXSize, nBufYSize, eBufType,
+                            nBandCount, panBandMap, 
+                            nPixelSpace, nLineSpace, nBandSpace,
+                            psExtraArg ) );
+}
                      
 /************************************************************************/
 /*                          GetOpenDatasets()                           */
@@ -1831,7 +2026,7 @@ GDALDatasetRasterIO( GDALDatasetH hDS, GDALRWFlag eRWFlag,
 GDALDataset **GDALDataset::GetOpenDatasets( int *pnCount )
 
 {
-    CPLMutexHolderD( &hDLMutex );
+    GDALDLMutexHolder oHolder;
 
     if (poAllDatasetMap != NULL)
     {
@@ -2354,7 +2549,7 @@ GDALDatasetH CPL_STDCALL GDALOpenEx( const char* pszFilename,
 /* -------------------------------------------------------------------- */
     if( nOpenFlags & GDAL_OF_SHARED )
     {
-        CPLMutexHolderD( &hDLMutex );
+        GDALDLMutexHolder oHolder;
 
         if (phSharedDatasetSet != NULL)
         {
@@ -2597,7 +2792,7 @@ void CPL_STDCALL GDALClose( GDALDatasetH hDS )
         return;
 
     GDALDataset *poDS = (GDALDataset *) hDS;
-    CPLMutexHolderD( &hDLMutex );
+    GDALDLMutexHolder oHolder;
     CPLLocaleC  oLocaleForcer;
 
     if (poDS->GetShared())
@@ -2694,7 +2889,7 @@ int CPL_STDCALL GDALDumpOpenDatasets( FILE *fp )
 {
     VALIDATE_POINTER1( fp, "GDALDumpOpenDatasets", 0 );
 
-    CPLMutexHolderD( &hDLMutex );
+    GDALDLMutexHolder oHolder;
 
     if (poAllDatasetMap != NULL)
     {
@@ -3747,7 +3942,7 @@ OGRLayer *GDALDataset::CopyLayer( OGRLayer *poSrcLayer,
         if( poDstFeature->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
         {
             CPLError( CE_Failure, CPLE_AppDefined,
-                      "Unable to translate feature %ld from layer %s.\n",
+                      "Unable to translate feature " CPL_FRMT_GIB " from layer %s.\n",
                       poFeature->GetFID(), poSrcDefn->GetName() );
             OGRFeature::DestroyFeature( poFeature );
             CPLFree(panMap);
@@ -3798,7 +3993,7 @@ OGRLayer *GDALDataset::CopyLayer( OGRLayer *poSrcLayer,
             if( papoDstFeature[nFeatCount]->SetFrom( poFeature, panMap, TRUE ) != OGRERR_NONE )
             {
                 CPLError( CE_Failure, CPLE_AppDefined,
-                          "Unable to translate feature %ld from layer %s.\n",
+                          "Unable to translate feature " CPL_FRMT_GIB " from layer %s.\n",
                           poFeature->GetFID(), poSrcDefn->GetName() );
                 OGRFeature::DestroyFeature( poFeature );
                 bStopTransfer = TRUE;
@@ -3985,8 +4180,12 @@ OGRErr GDALDataset::ProcessSQLCreateIndex( const char *pszSQLCommand )
     }
 
 /* -------------------------------------------------------------------- */
-/*      Does this layer even support attribute indexes?                 */
+/*      Does this layer even support attribute indexes? If the driver   */
+/*      does not, try to put generic indexes next to the datasource.    */
 /* -------------------------------------------------------------------- */
+    if( poLayer->GetIndex() == NULL )
+        OGRInitializeSidecarIndexSupport( this, poLayer, TRUE );
+
     if( poLayer->GetIndex() == NULL )
     {
         CPLError( CE_Failure, CPLE_AppDefined, 
@@ -4095,6 +4294,9 @@ OGRErr GDALDataset::ProcessSQLDropIndex( const char *pszSQLCommand )
 /* -------------------------------------------------------------------- */
 /*      Does this layer even support attribute indexes?                 */
 /* -------------------------------------------------------------------- */
+    if( poLayer->GetIndex() == NULL )
+        OGRInitializeSidecarIndexSupport( this, poLayer, FALSE );
+
     if( poLayer->GetIndex() == NULL )
     {
         CPLError( CE_Failure, CPLE_AppDefined, 
@@ -35,6 +35,7 @@
 #include "cpl_multiproc.h"
 #include "gdal_pam.h"
 #include "gdal_alg_priv.h"
+#include "cpl_worker_thread_pool.h"
 
 #ifdef _MSC_VER
 #  ifdef MSVC_USE_VLD
@@ -263,6 +264,11 @@ GDALDriverManager::~GDALDriverManager()
         *GDALGetphDLMutex() = NULL; 
     } 
 
+/* -------------------------------------------------------------------- */
+/*      Stop the worker threads.                                        */
+/* -------------------------------------------------------------------- */
+    CPLCleanupWorkerThreadPool();
+
 /* -------------------------------------------------------------------- */
 /*      Cleanup raster block mutex                                      */
 /* -------------------------------------------------------------------- */
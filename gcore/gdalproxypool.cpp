@@ -56,6 +56,11 @@ struct _GDALProxyPoolCacheEntry
     char         *pszFileName;
     GDALDataset  *poDS;
 
+    /* TRUE while the dataset is being opened by the thread openingPID. */
+    /* Other threads wait for hCond to be signaled before using the entry */
+    int           bOpening;
+    GIntBig       openingPID;
+
     /* Ref count of the cached dataset */
     int           refCount;
 
@@ -68,7 +73,7 @@ class GDALDatasetPool
     private:
         /* Ref count of the pool singleton */
         /* Taken by "toplevel" GDALProxyPoolDataset in its constructor and released */
-        /* in its destructor. See also refCountOfDisableRefCount for the difference */
+        /* in its destructor. See also DisableRefCount() for the difference */
         /* between toplevel and inner GDALProxyPoolDataset */
         int refCount;
 
@@ -77,13 +82,24 @@ class GDALDatasetPool
         GDALProxyPoolCacheEntry* firstEntry;
         GDALProxyPoolCacheEntry* lastEntry;
 
-        /* This variable prevents a dataset that is going to be opened in GDALDatasetPool::_RefDataset */
-        /* from increasing refCount if, during its opening, it creates a GDALProxyPoolDataset */
-        /* We increment it before opening or closing a cached dataset and decrement it afterwards */
+        /* Signaled, with the pool mutex held, each time an entry has */
+        /* finished being opened */
+        void* hCond;
+
+        /* This variable prevents the pool from being destroyed while the */
+        /* driver manager is cleaning up. See PreventDestroy() */
+        int refCountOfDisableRefCount;
+
+        /* A dataset that is going to be opened in GDALDatasetPool::_RefDataset */
+        /* must not increase refCount if, during its opening, it creates a GDALProxyPoolDataset */
+        /* We increment a per-thread counter (see DisableRefCount()) before opening or */
+        /* closing a cached dataset and decrement it afterwards. It is per-thread since */
+        /* the opening is done without holding the pool mutex */
         /* The typical use case is a VRT made of simple sources that are VRT */
         /* We don't want the "inner" VRT to take a reference on the pool, otherwise there is */
         /* a high chance that this reference will not be dropped and the pool remain ghost */
-        int refCountOfDisableRefCount;
+        static void DisableRefCount(int nDelta);
+        static int  IsRefCountDisabled();
 
         /* Caution : to be sure that we don't run out of entries, size must be at */
         /* least greater or equal than the maximum number of threads */
@@ -99,6 +115,7 @@ class GDALDatasetPool
         static void Unref();
         static GDALProxyPoolCacheEntry* RefDataset(const char* pszFileName, GDALAccess eAccess);
         static void UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry);
+        static void UnrefDataset(GDALDataset* poDS);
 
         static void PreventDestroy();
         static void ForceDestroy();
@@ -117,6 +134,7 @@ GDALDatasetPool::GDALDatasetPool(int maxSize)
     lastEntry = NULL;
     refCount = 0;
     refCountOfDisableRefCount = 0;
+    hCond = CPLCreateCond();
 }
 
 /************************************************************************/
@@ -141,6 +159,8 @@ GDALDatasetPool::~GDALDatasetPool()
         cur = next;
     }
     GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+    if (hCond)
+        CPLDestroyCond(hCond);
 }
 
 /************************************************************************/
@@ -187,14 +207,44 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName, G
 {
     GDALProxyPoolCacheEntry* cur = firstEntry;
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    GIntBig currentPID = CPLGetPID();
     GDALProxyPoolCacheEntry* lastEntryWithZeroRefCount = NULL;
 
+    /* The pool mutex is recursive. Releasing it once, or waiting on */
+    /* hCond, only unlocks it if it is held once by the current thread. */
+    /* Otherwise (for example when a dataset being closed by GDALClose() */
+    /* reads from its sources) we can neither wait for an entry being */
+    /* opened by another thread, nor let other threads run while opening : */
+    /* the dataset is then opened with the mutex held, and entries being */
+    /* opened by other threads are ignored, at the cost of a duplicate handle */
+    int bCanReleaseMutex = (GDALGetDLMutexDepth() == 1 && hCond != NULL);
+
     while(cur)
     {
         GDALProxyPoolCacheEntry* next = cur->next;
 
         if (strcmp(cur->pszFileName, pszFileName) == 0 &&
-            cur->responsiblePID == responsiblePID)
+            cur->responsiblePID == responsiblePID &&
+            cur->bOpening)
+        {
+            /* Wait for the thread that is opening the dataset, unless */
+            /* this is ourselves (recursive opening) */
+            if (bCanReleaseMutex && cur->openingPID != currentPID)
+            {
+                /* Our reference prevents the entry from being recycled */
+                cur->refCount ++;
+                while (cur->bOpening)
+                    CPLCondWait(hCond, *GDALGetphDLMutex());
+                cur->refCount --;
+
+                /* The list may have changed meanwhile : restart the lookup */
+                cur = firstEntry;
+                lastEntryWithZeroRefCount = NULL;
+                continue;
+            }
+        }
+        else if (strcmp(cur->pszFileName, pszFileName) == 0 &&
+                 cur->responsiblePID == responsiblePID)
         {
             if (cur != firstEntry)
             {
@@ -243,32 +293,33 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName, G
             /* dataset */
             GDALSetResponsiblePIDForCurrentThread(lastEntryWithZeroRefCount->responsiblePID);
 
-            refCountOfDisableRefCount ++;
+            DisableRefCount(1);
             GDALClose(lastEntryWithZeroRefCount->poDS);
-            refCountOfDisableRefCount --;
+            DisableRefCount(-1);
 
             lastEntryWithZeroRefCount->poDS = NULL;
             GDALSetResponsiblePIDForCurrentThread(responsiblePID);
         }
 
         /* Recycle this entry for the to-be-openeded dataset and */
-        /* moves it to the top of the list */
-        if (lastEntryWithZeroRefCount->prev)
-            lastEntryWithZeroRefCount->prev->next = lastEntryWithZeroRefCount->next;
-        else
-            CPLAssert(0);
-        if (lastEntryWithZeroRefCount->next)
-            lastEntryWithZeroRefCount->next->prev = lastEntryWithZeroRefCount->prev;
-        else
+        /* moves it to the top of the list. When several threads use the */
+        /* pool, it may already be the first entry */
+        if (lastEntryWithZeroRefCount != firstEntry)
         {
-            CPLAssert(lastEntryWithZeroRefCount == lastEntry);
-            lastEntry->prev->next = NULL;
-            lastEntry = lastEntry->prev;
+            lastEntryWithZeroRefCount->prev->next = lastEntryWithZeroRefCount->next;
+            if (lastEntryWithZeroRefCount->next)
+                lastEntryWithZeroRefCount->next->prev = lastEntryWithZeroRefCount->prev;
+            else
+            {
+                CPLAssert(lastEntryWithZeroRefCount == lastEntry);
+                lastEntry = lastEntryWithZeroRefCount->prev;
+            }
+            lastEntryWithZeroRefCount->prev = NULL;
+            lastEntryWithZeroRefCount->next = firstEntry;
+            firstEntry->prev = lastEntryWithZeroRefCount;
+            firstEntry = lastEntryWithZeroRefCount;
         }
-        lastEntryWithZeroRefCount->prev = NULL;
-        lastEntryWithZeroRefCount->next = firstEntry;
-        firstEntry->prev = lastEntryWithZeroRefCount;
-        cur = firstEntry = lastEntryWithZeroRefCount;
+        cur = lastEntryWithZeroRefCount;
 #ifdef DEBUG_PROXY_POOL
         CheckLinks();
 #endif
@@ -293,21 +344,60 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName, G
     cur->pszFileName = CPLStrdup(pszFileName);
     cur->responsiblePID = responsiblePID;
     cur->refCount = 1;
+    cur->poDS = NULL;
+    cur->bOpening = TRUE;
+    cur->openingPID = currentPID;
+
+    /* When possible, open the dataset without holding the pool mutex, so */
+    /* that the sources of a VRT read by several threads can be opened */
+    /* simultaneously. The entry cannot be recycled meanwhile since it */
+    /* is referenced, and other threads looking for it wait on hCond */
+    if (bCanReleaseMutex)
+        GDALReleaseDLMutex();
+
+    DisableRefCount(1);
+    GDALDataset* poDS = (GDALDataset*) GDALOpen(pszFileName, eAccess);
+    DisableRefCount(-1);
 
-    refCountOfDisableRefCount ++;
-    cur->poDS = (GDALDataset*) GDALOpen(pszFileName, eAccess);
-    refCountOfDisableRefCount --;
+    if (bCanReleaseMutex)
+        GDALAcquireDLMutex();
+
+    cur->poDS = poDS;
+    cur->bOpening = FALSE;
+    if (hCond)
+        CPLCondBroadcast(hCond);
 
     return cur;
 }
 
+/************************************************************************/
+/*                          DisableRefCount()                           */
+/************************************************************************/
+
+void GDALDatasetPool::DisableRefCount(int nDelta)
+{
+    int nCount = (int)(size_t) CPLGetTLS(CTLS_PROXYPOOL_DISABLEREFCOUNT);
+    nCount += nDelta;
+    CPLSetTLS(CTLS_PROXYPOOL_DISABLEREFCOUNT, (void*)(size_t) nCount, FALSE);
+}
+
+/************************************************************************/
+/*                        IsRefCountDisabled()                          */
+/************************************************************************/
+
+int GDALDatasetPool::IsRefCountDisabled()
+{
+    return singleton->refCountOfDisableRefCount != 0 ||
+           CPLGetTLS(CTLS_PROXYPOOL_DISABLEREFCOUNT) != NULL;
+}
+
 /************************************************************************/
 /*                                 Ref()                                */
 /************************************************************************/
 
 void GDALDatasetPool::Ref()
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     if (singleton == NULL)
     {
         int maxSize = atoi(CPLGetConfigOption("GDAL_MAX_DATASET_POOL_SIZE", "100"));
@@ -315,14 +405,14 @@ void GDALDatasetPool::Ref()
             maxSize = 100;
         singleton = new GDALDatasetPool(maxSize);
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (!IsRefCountDisabled())
       singleton->refCount++;
 }
 
 /* keep that in sync with gdaldrivermanager.cpp */
 void GDALDatasetPool::PreventDestroy()
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     if (! singleton)
         return;
     singleton->refCountOfDisableRefCount ++;
@@ -341,13 +431,13 @@ void GDALDatasetPoolPreventDestroy()
 
 void GDALDatasetPool::Unref()
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     if (! singleton)
     {
         CPLAssert(0);
         return;
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (!IsRefCountDisabled())
     {
       singleton->refCount--;
       if (singleton->refCount == 0)
@@ -361,7 +451,7 @@ void GDALDatasetPool::Unref()
 /* keep that in sync with gdaldrivermanager.cpp */
 void GDALDatasetPool::ForceDestroy()
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     if (! singleton)
         return;
     singleton->refCountOfDisableRefCount --;
@@ -383,7 +473,7 @@ void GDALDatasetPoolForceDestroy()
 
 GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName, GDALAccess eAccess)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     return singleton->_RefDataset(pszFileName, eAccess);
 }
 
@@ -393,10 +483,29 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName, GD
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
+    GDALDLMutexHolder oHolder;
     cacheEntry->refCount --;
 }
 
+/* Release the reference taken on the entry of a dataset. This does not */
+/* rely on the entry remembered by the caller, which may have been changed */
+/* by another thread using the same GDALProxyPoolDataset */
+void GDALDatasetPool::UnrefDataset(GDALDataset* poDS)
+{
+    GDALDLMutexHolder oHolder;
+    GDALProxyPoolCacheEntry* cur = singleton->firstEntry;
+    while(cur)
+    {
+        if (cur->poDS == poDS && cur->refCount > 0)
+        {
+            cur->refCount --;
+            return;
+        }
+        cur = cur->next;
+    }
+    CPLAssert(0);
+}
+
 CPL_C_START
 
 typedef struct
@@ -463,6 +572,119 @@ void free_func_get_metadata_item(void* _elt)
 
 CPL_C_END
 
+/* The values cached by the proxy objects are only replaced when the */
+/* underlying value changes, so that a pointer returned to a thread is */
+/* not freed by another thread querying the same value */
+
+static int EqualStrings(const char* pszA, const char* pszB)
+{
+    if (pszA == NULL || pszB == NULL)
+        return pszA == pszB;
+    return strcmp(pszA, pszB) == 0;
+}
+
+static int EqualStringLists(char** papszA, char** papszB)
+{
+    int nCount = CSLCount(papszA);
+    if (nCount != CSLCount(papszB))
+        return FALSE;
+    for(int i=0;i<nCount;i++)
+    {
+        if (strcmp(papszA[i], papszB[i]) != 0)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static int EqualGCPLists(int nCountA, const GDAL_GCP* pasA,
+                         int nCountB, const GDAL_GCP* pasB)
+{
+    if (nCountA != nCountB)
+        return FALSE;
+    for(int i=0;i<nCountA;i++)
+    {
+        if (!EqualStrings(pasA[i].pszId, pasB[i].pszId) ||
+            !EqualStrings(pasA[i].pszInfo, pasB[i].pszInfo) ||
+            pasA[i].dfGCPPixel != pasB[i].dfGCPPixel ||
+            pasA[i].dfGCPLine != pasB[i].dfGCPLine ||
+            pasA[i].dfGCPX != pasB[i].dfGCPX ||
+            pasA[i].dfGCPY != pasB[i].dfGCPY ||
+            pasA[i].dfGCPZ != pasB[i].dfGCPZ)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static int EqualColorTables(GDALColorTable* poA, GDALColorTable* poB)
+{
+    if (poA == NULL || poB == NULL)
+        return poA == poB;
+    if (poA->GetPaletteInterpretation() != poB->GetPaletteInterpretation() ||
+        poA->GetColorEntryCount() != poB->GetColorEntryCount())
+        return FALSE;
+    for(int i=0;i<poA->GetColorEntryCount();i++)
+    {
+        const GDALColorEntry* psA = poA->GetColorEntry(i);
+        const GDALColorEntry* psB = poB->GetColorEntry(i);
+        if (psA->c1 != psB->c1 || psA->c2 != psB->c2 ||
+            psA->c3 != psB->c3 || psA->c4 != psB->c4)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/* Return the cached metadata of pszDomain, after updating it from */
+/* papszUnderlyingMetadata if needed. The caller holds the cache mutex */
+static char** CacheMetadata(CPLHashSet** pMetadataSet,
+                            const char* pszDomain,
+                            char** papszUnderlyingMetadata)
+{
+    if (*pMetadataSet == NULL)
+        *pMetadataSet = CPLHashSetNew(hash_func_get_metadata,
+                                      equal_func_get_metadata,
+                                      free_func_get_metadata);
+
+    GetMetadataElt sKey;
+    sKey.pszDomain = (char*) pszDomain;
+    GetMetadataElt* pElt = (GetMetadataElt*) CPLHashSetLookup(*pMetadataSet, &sKey);
+    if (pElt != NULL && EqualStringLists(pElt->papszMetadata, papszUnderlyingMetadata))
+        return pElt->papszMetadata;
+
+    pElt = (GetMetadataElt*) CPLMalloc(sizeof(GetMetadataElt));
+    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
+    pElt->papszMetadata = CSLDuplicate(papszUnderlyingMetadata);
+    CPLHashSetInsert(*pMetadataSet, pElt);
+
+    return pElt->papszMetadata;
+}
+
+/* Same as CacheMetadata(), for a metadata item */
+static const char* CacheMetadataItem(CPLHashSet** pMetadataItemSet,
+                                     const char* pszName,
+                                     const char* pszDomain,
+                                     const char* pszUnderlyingMetadataItem)
+{
+    if (*pMetadataItemSet == NULL)
+        *pMetadataItemSet = CPLHashSetNew(hash_func_get_metadata_item,
+                                          equal_func_get_metadata_item,
+                                          free_func_get_metadata_item);
+
+    GetMetadataItemElt sKey;
+    sKey.pszName = (char*) pszName;
+    sKey.pszDomain = (char*) pszDomain;
+    GetMetadataItemElt* pElt = (GetMetadataItemElt*) CPLHashSetLookup(*pMetadataItemSet, &sKey);
+    if (pElt != NULL && EqualStrings(pElt->pszMetadataItem, pszUnderlyingMetadataItem))
+        return pElt->pszMetadataItem;
+
+    pElt = (GetMetadataItemElt*) CPLMalloc(sizeof(GetMetadataItemElt));
+    pElt->pszName = (pszName) ? CPLStrdup(pszName) : NULL;
+    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
+    pElt->pszMetadataItem = (pszUnderlyingMetadataItem) ? CPLStrdup(pszUnderlyingMetadataItem) : NULL;
+    CPLHashSetInsert(*pMetadataItemSet, pElt);
+
+    return pElt->pszMetadataItem;
+}
+
 /* ******************************************************************** */
 /*                     GDALProxyPoolDataset                             */
 /* ******************************************************************** */
@@ -526,7 +748,7 @@ GDALProxyPoolDataset::GDALProxyPoolDataset(const char* pszSourceDatasetDescripti
     pasGCPList = NULL;
     metadataSet = NULL;
     metadataItemSet = NULL;
-    cacheEntry = NULL;
+    hCacheMutex = NULL;
 }
 
 /************************************************************************/
@@ -553,6 +775,8 @@ GDALProxyPoolDataset::~GDALProxyPoolDataset()
         CPLHashSetDestroy(metadataSet);
     if (metadataItemSet)
         CPLHashSetDestroy(metadataItemSet);
+    if (hCacheMutex)
+        CPLDestroyMutex(hCacheMutex);
 
     GDALDatasetPool::Unref();
 }
@@ -582,9 +806,12 @@ GDALDataset* GDALProxyPoolDataset::RefUnderlyingDataset()
     /* was done by the creating thread, otherwise it will not be correctly closed afterwards... */
     /* To make a long story short : this is necessary when warping with ChunkAndWarpMulti */
     /* a VRT of GeoTIFFs that have associated .aux files */
+    /* The entry is not stored in the object, so that it can be used */
+    /* by several threads at once. */
     GIntBig curResponsiblePID = GDALGetResponsiblePIDForCurrentThread();
     GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-    cacheEntry = GDALDatasetPool::RefDataset(GetDescription(), eAccess);
+    GDALProxyPoolCacheEntry* cacheEntry =
+        GDALDatasetPool::RefDataset(GetDescription(), eAccess);
     GDALSetResponsiblePIDForCurrentThread(curResponsiblePID);
     if (cacheEntry != NULL)
     {
@@ -602,12 +829,8 @@ GDALDataset* GDALProxyPoolDataset::RefUnderlyingDataset()
 
 void GDALProxyPoolDataset::UnrefUnderlyingDataset(GDALDataset* poUnderlyingDataset)
 {
-    if (cacheEntry != NULL)
-    {
-        CPLAssert(cacheEntry->poDS == poUnderlyingDataset);
-        if (cacheEntry->poDS != NULL)
-            GDALDatasetPool::UnrefDataset(cacheEntry);
-    }
+    if (poUnderlyingDataset != NULL)
+        GDALDatasetPool::UnrefDataset(poUnderlyingDataset);
 }
 
 /************************************************************************/
@@ -665,25 +888,22 @@ CPLErr GDALProxyPoolDataset::GetGeoTransform( double * padfGeoTransform )
 
 char      **GDALProxyPoolDataset::GetMetadata( const char * pszDomain  )
 {
-    if (metadataSet == NULL)
-        metadataSet = CPLHashSetNew(hash_func_get_metadata,
-                                    equal_func_get_metadata,
-                                    free_func_get_metadata);
-
     GDALDataset* poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == NULL)
         return NULL;
 
     char** papszUnderlyingMetadata = poUnderlyingDataset->GetMetadata(pszDomain);
 
-    GetMetadataElt* pElt = (GetMetadataElt*) CPLMalloc(sizeof(GetMetadataElt));
-    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
-    pElt->papszMetadata = CSLDuplicate(papszUnderlyingMetadata);
-    CPLHashSetInsert(metadataSet, pElt);
+    char** papszMetadata;
+    {
+        CPLMutexHolderD( &hCacheMutex );
+        papszMetadata = CacheMetadata(&metadataSet, pszDomain,
+                                      papszUnderlyingMetadata);
+    }
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
-    return pElt->papszMetadata;
+    return papszMetadata;
 }
 
 /************************************************************************/
@@ -693,11 +913,6 @@ char      **GDALProxyPoolDataset::GetMetadata( const char * pszDomain  )
 const char *GDALProxyPoolDataset::GetMetadataItem( const char * pszName,
                                                    const char * pszDomain  )
 {
-    if (metadataItemSet == NULL)
-        metadataItemSet = CPLHashSetNew(hash_func_get_metadata_item,
-                                        equal_func_get_metadata_item,
-                                        free_func_get_metadata_item);
-
     GDALDataset* poUnderlyingDataset = RefUnderlyingDataset();
     if (poUnderlyingDataset == NULL)
         return NULL;
@@ -705,15 +920,16 @@ const char *GDALProxyPoolDataset::GetMetadataItem( const char * pszName,
     const char* pszUnderlyingMetadataItem =
             poUnderlyingDataset->GetMetadataItem(pszName, pszDomain);
 
-    GetMetadataItemElt* pElt = (GetMetadataItemElt*) CPLMalloc(sizeof(GetMetadataItemElt));
-    pElt->pszName = (pszName) ? CPLStrdup(pszName) : NULL;
-    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
-    pElt->pszMetadataItem = (pszUnderlyingMetadataItem) ? CPLStrdup(pszUnderlyingMetadataItem) : NULL;
-    CPLHashSetInsert(metadataItemSet, pElt);
+    const char* pszMetadataItem;
+    {
+        CPLMutexHolderD( &hCacheMutex );
+        pszMetadataItem = CacheMetadataItem(&metadataItemSet, pszName, pszDomain,
+                                            pszUnderlyingMetadataItem);
+    }
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
-    return pElt->pszMetadataItem;
+    return pszMetadataItem;
 }
 
 /************************************************************************/
@@ -738,16 +954,24 @@ const char *GDALProxyPoolDataset::GetGCPProjection()
     if (poUnderlyingDataset == NULL)
         return NULL;
 
-    CPLFree(pszGCPProjection);
-    pszGCPProjection = NULL;
-
     const char* pszUnderlyingGCPProjection = poUnderlyingDataset->GetGCPProjection();
-    if (pszUnderlyingGCPProjection)
-        pszGCPProjection = CPLStrdup(pszUnderlyingGCPProjection);
+
+    const char* pszRet;
+    {
+        CPLMutexHolderD( &hCacheMutex );
+        if (!EqualStrings(pszGCPProjection, pszUnderlyingGCPProjection))
+        {
+            CPLFree(pszGCPProjection);
+            pszGCPProjection = NULL;
+            if (pszUnderlyingGCPProjection)
+                pszGCPProjection = CPLStrdup(pszUnderlyingGCPProjection);
+        }
+        pszRet = pszGCPProjection;
+    }
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
-    return pszGCPProjection;
+    return pszRet;
 }
 
 /************************************************************************/
@@ -760,21 +984,32 @@ const GDAL_GCP *GDALProxyPoolDataset::GetGCPs()
     if (poUnderlyingDataset == NULL)
         return NULL;
 
-    if (nGCPCount)
+    const GDAL_GCP* pasUnderlyingGCPList = poUnderlyingDataset->GetGCPs();
+    int nUnderlyingGCPCount = poUnderlyingDataset->GetGCPCount();
+
+    const GDAL_GCP* pasRet;
     {
-        GDALDeinitGCPs( nGCPCount, pasGCPList );
-        CPLFree( pasGCPList );
-        pasGCPList = NULL;
-    }
+        CPLMutexHolderD( &hCacheMutex );
+        if (!EqualGCPLists(nGCPCount, pasGCPList,
+                           nUnderlyingGCPCount, pasUnderlyingGCPList))
+        {
+            if (nGCPCount)
+            {
+                GDALDeinitGCPs( nGCPCount, pasGCPList );
+                CPLFree( pasGCPList );
+                pasGCPList = NULL;
+            }
 
-    const GDAL_GCP* pasUnderlyingGCPList = poUnderlyingDataset->GetGCPs();
-    nGCPCount = poUnderlyingDataset->GetGCPCount();
-    if (nGCPCount)
-        pasGCPList = GDALDuplicateGCPs(nGCPCount, pasUnderlyingGCPList );
+            nGCPCount = nUnderlyingGCPCount;
+            if (nGCPCount)
+                pasGCPList = GDALDuplicateGCPs(nGCPCount, pasUnderlyingGCPList );
+        }
+        pasRet = pasGCPList;
+    }
 
     UnrefUnderlyingDataset(poUnderlyingDataset);
 
-    return pasGCPList;
+    return pasRet;
 }
 
 /************************************************************************/
@@ -908,6 +1143,15 @@ void GDALProxyPoolRasterBand::AddSrcMaskBandDescription( GDALDataType eDataType,
                                                 nBlockXSize, nBlockYSize);
 }
 
+/************************************************************************/
+/*                          GetCacheMutex()                             */
+/************************************************************************/
+
+void** GDALProxyPoolRasterBand::GetCacheMutex()
+{
+    return &(((GDALProxyPoolDataset*)poDS)->hCacheMutex);
+}
+
 /************************************************************************/
 /*                  RefUnderlyingRasterBand()                           */
 /************************************************************************/
@@ -943,25 +1187,22 @@ void GDALProxyPoolRasterBand::UnrefUnderlyingRasterBand(GDALRasterBand* poUnderl
 
 char      **GDALProxyPoolRasterBand::GetMetadata( const char * pszDomain  )
 {
-    if (metadataSet == NULL)
-        metadataSet = CPLHashSetNew(hash_func_get_metadata,
-                                    equal_func_get_metadata,
-                                    free_func_get_metadata);
-
     GDALRasterBand* poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == NULL)
         return NULL;
 
     char** papszUnderlyingMetadata = poUnderlyingRasterBand->GetMetadata(pszDomain);
 
-    GetMetadataElt* pElt = (GetMetadataElt*) CPLMalloc(sizeof(GetMetadataElt));
-    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
-    pElt->papszMetadata = CSLDuplicate(papszUnderlyingMetadata);
-    CPLHashSetInsert(metadataSet, pElt);
+    char** papszMetadata;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        papszMetadata = CacheMetadata(&metadataSet, pszDomain,
+                                      papszUnderlyingMetadata);
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return pElt->papszMetadata;
+    return papszMetadata;
 }
 
 /************************************************************************/
@@ -971,11 +1212,6 @@ char      **GDALProxyPoolRasterBand::GetMetadata( const char * pszDomain  )
 const char *GDALProxyPoolRasterBand::GetMetadataItem( const char * pszName,
                                                    const char * pszDomain  )
 {
-    if (metadataItemSet == NULL)
-        metadataItemSet = CPLHashSetNew(hash_func_get_metadata_item,
-                                        equal_func_get_metadata_item,
-                                        free_func_get_metadata_item);
-
     GDALRasterBand* poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == NULL)
         return NULL;
@@ -983,15 +1219,16 @@ const char *GDALProxyPoolRasterBand::GetMetadataItem( const char * pszName,
     const char* pszUnderlyingMetadataItem =
             poUnderlyingRasterBand->GetMetadataItem(pszName, pszDomain);
 
-    GetMetadataItemElt* pElt = (GetMetadataItemElt*) CPLMalloc(sizeof(GetMetadataItemElt));
-    pElt->pszName = (pszName) ? CPLStrdup(pszName) : NULL;
-    pElt->pszDomain = (pszDomain) ? CPLStrdup(pszDomain) : NULL;
-    pElt->pszMetadataItem = (pszUnderlyingMetadataItem) ? CPLStrdup(pszUnderlyingMetadataItem) : NULL;
-    CPLHashSetInsert(metadataItemSet, pElt);
+    const char* pszMetadataItem;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        pszMetadataItem = CacheMetadataItem(&metadataItemSet, pszName, pszDomain,
+                                            pszUnderlyingMetadataItem);
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return pElt->pszMetadataItem;
+    return pszMetadataItem;
 }
 
 /* ******************************************************************** */
@@ -1004,16 +1241,25 @@ char **GDALProxyPoolRasterBand::GetCategoryNames()
     if (poUnderlyingRasterBand == NULL)
         return NULL;
 
-    CSLDestroy(papszCategoryNames);
-    papszCategoryNames = NULL;
-
     char** papszUnderlyingCategoryNames = poUnderlyingRasterBand->GetCategoryNames();
-    if (papszUnderlyingCategoryNames)
-        papszCategoryNames = CSLDuplicate(papszUnderlyingCategoryNames);
+
+    char** papszRet;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        if (!EqualStringLists(papszCategoryNames, papszUnderlyingCategoryNames) ||
+            (papszCategoryNames == NULL) != (papszUnderlyingCategoryNames == NULL))
+        {
+            CSLDestroy(papszCategoryNames);
+            papszCategoryNames = NULL;
+            if (papszUnderlyingCategoryNames)
+                papszCategoryNames = CSLDuplicate(papszUnderlyingCategoryNames);
+        }
+        papszRet = papszCategoryNames;
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return papszCategoryNames;
+    return papszRet;
 }
 
 /* ******************************************************************** */
@@ -1026,16 +1272,24 @@ const char *GDALProxyPoolRasterBand::GetUnitType()
     if (poUnderlyingRasterBand == NULL)
         return NULL;
 
-    CPLFree(pszUnitType);
-    pszUnitType = NULL;
-
     const char* pszUnderlyingUnitType = poUnderlyingRasterBand->GetUnitType();
-    if (pszUnderlyingUnitType)
-        pszUnitType = CPLStrdup(pszUnderlyingUnitType);
+
+    const char* pszRet;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        if (!EqualStrings(pszUnitType, pszUnderlyingUnitType))
+        {
+            CPLFree(pszUnitType);
+            pszUnitType = NULL;
+            if (pszUnderlyingUnitType)
+                pszUnitType = CPLStrdup(pszUnderlyingUnitType);
+        }
+        pszRet = pszUnitType;
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return pszUnitType;
+    return pszRet;
 }
 
 /* ******************************************************************** */
@@ -1048,17 +1302,25 @@ GDALColorTable *GDALProxyPoolRasterBand::GetColorTable()
     if (poUnderlyingRasterBand == NULL)
         return NULL;
 
-    if (poColorTable)
-        delete poColorTable;
-    poColorTable = NULL;
-
     GDALColorTable* poUnderlyingColorTable = poUnderlyingRasterBand->GetColorTable();
-    if (poUnderlyingColorTable)
-        poColorTable = poUnderlyingColorTable->Clone();
+
+    GDALColorTable* poRet;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        if (!EqualColorTables(poColorTable, poUnderlyingColorTable))
+        {
+            if (poColorTable)
+                delete poColorTable;
+            poColorTable = NULL;
+            if (poUnderlyingColorTable)
+                poColorTable = poUnderlyingColorTable->Clone();
+        }
+        poRet = poColorTable;
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return poColorTable;
+    return poRet;
 }
 
 /* ******************************************************************** */
@@ -1067,10 +1329,13 @@ GDALColorTable *GDALProxyPoolRasterBand::GetColorTable()
 
 GDALRasterBand *GDALProxyPoolRasterBand::GetOverview(int nOverviewBand)
 {
-    if (nOverviewBand >= 0 && nOverviewBand < nSizeProxyOverviewRasterBand)
     {
-        if (papoProxyOverviewRasterBand[nOverviewBand])
-            return papoProxyOverviewRasterBand[nOverviewBand];
+        CPLMutexHolderD( GetCacheMutex() );
+        if (nOverviewBand >= 0 && nOverviewBand < nSizeProxyOverviewRasterBand)
+        {
+            if (papoProxyOverviewRasterBand[nOverviewBand])
+                return papoProxyOverviewRasterBand[nOverviewBand];
+        }
     }
 
     GDALRasterBand* poUnderlyingRasterBand = RefUnderlyingRasterBand();
@@ -1084,25 +1349,33 @@ GDALRasterBand *GDALProxyPoolRasterBand::GetOverview(int nOverviewBand)
         return NULL;
     }
 
-    if (nOverviewBand >= nSizeProxyOverviewRasterBand)
+    GDALRasterBand* poRet;
     {
-        int i;
-        papoProxyOverviewRasterBand = (GDALProxyPoolOverviewRasterBand**)
-                CPLRealloc(papoProxyOverviewRasterBand,
-                        sizeof(GDALProxyPoolOverviewRasterBand*) * (nOverviewBand + 1));
-        for(i=nSizeProxyOverviewRasterBand; i<nOverviewBand + 1;i++)
-            papoProxyOverviewRasterBand[i] = NULL;
-        nSizeProxyOverviewRasterBand = nOverviewBand + 1;
-    }
+        CPLMutexHolderD( GetCacheMutex() );
+
+        if (nOverviewBand >= nSizeProxyOverviewRasterBand)
+        {
+            int i;
+            papoProxyOverviewRasterBand = (GDALProxyPoolOverviewRasterBand**)
+                    CPLRealloc(papoProxyOverviewRasterBand,
+                            sizeof(GDALProxyPoolOverviewRasterBand*) * (nOverviewBand + 1));
+            for(i=nSizeProxyOverviewRasterBand; i<nOverviewBand + 1;i++)
+                papoProxyOverviewRasterBand[i] = NULL;
+            nSizeProxyOverviewRasterBand = nOverviewBand + 1;
+        }
 
-    papoProxyOverviewRasterBand[nOverviewBand] =
-            new GDALProxyPoolOverviewRasterBand((GDALProxyPoolDataset*)poDS,
-                                                poOverviewRasterBand,
-                                                this, nOverviewBand);
+        /* Another thread may have created it meanwhile */
+        if (papoProxyOverviewRasterBand[nOverviewBand] == NULL)
+            papoProxyOverviewRasterBand[nOverviewBand] =
+                new GDALProxyPoolOverviewRasterBand((GDALProxyPoolDataset*)poDS,
+                                                    poOverviewRasterBand,
+                                                    this, nOverviewBand);
+        poRet = papoProxyOverviewRasterBand[nOverviewBand];
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return papoProxyOverviewRasterBand[nOverviewBand];
+    return poRet;
 }
 
 /* ******************************************************************** */
@@ -1122,8 +1395,11 @@ GDALRasterBand *GDALProxyPoolRasterBand::GetRasterSampleOverview( int nDesiredSa
 
 GDALRasterBand *GDALProxyPoolRasterBand::GetMaskBand()
 {
-    if (poProxyMaskBand)
-        return poProxyMaskBand;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        if (poProxyMaskBand)
+            return poProxyMaskBand;
+    }
 
     GDALRasterBand* poUnderlyingRasterBand = RefUnderlyingRasterBand();
     if (poUnderlyingRasterBand == NULL)
@@ -1131,14 +1407,22 @@ GDALRasterBand *GDALProxyPoolRasterBand::GetMaskBand()
 
     GDALRasterBand* poMaskBand = poUnderlyingRasterBand->GetMaskBand();
 
-    poProxyMaskBand =
-            new GDALProxyPoolMaskBand((GDALProxyPoolDataset*)poDS,
-                                       poMaskBand,
-                                       this);
+    GDALRasterBand* poRet;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+
+        /* Another thread may have created it meanwhile */
+        if (poProxyMaskBand == NULL)
+            poProxyMaskBand =
+                new GDALProxyPoolMaskBand((GDALProxyPoolDataset*)poDS,
+                                           poMaskBand,
+                                           this);
+        poRet = poProxyMaskBand;
+    }
 
     UnrefUnderlyingRasterBand(poUnderlyingRasterBand);
 
-    return poProxyMaskBand;
+    return poRet;
 }
 
 /* ******************************************************************** */
@@ -1153,9 +1437,6 @@ GDALProxyPoolOverviewRasterBand::GDALProxyPoolOverviewRasterBand(GDALProxyPoolDa
 {
     this->poMainBand = poMainBand;
     this->nOverviewBand = nOverviewBand;
-
-    poUnderlyingMainRasterBand = NULL;
-    nRefCountUnderlyingMainRasterBand = 0;
 }
 
 /* ******************************************************************** */
@@ -1164,7 +1445,7 @@ GDALProxyPoolOverviewRasterBand::GDALProxyPoolOverviewRasterBand(GDALProxyPoolDa
 
 GDALProxyPoolOverviewRasterBand::~GDALProxyPoolOverviewRasterBand()
 {
-    CPLAssert(nRefCountUnderlyingMainRasterBand == 0);
+    CPLAssert(oMapUnderlyingMainRasterBand.empty());
 }
 
 /* ******************************************************************** */
@@ -1173,12 +1454,24 @@ GDALProxyPoolOverviewRasterBand::~GDALProxyPoolOverviewRasterBand()
 
 GDALRasterBand* GDALProxyPoolOverviewRasterBand::RefUnderlyingRasterBand()
 {
-    poUnderlyingMainRasterBand = poMainBand->RefUnderlyingRasterBand();
+    GDALRasterBand* poUnderlyingMainRasterBand = poMainBand->RefUnderlyingRasterBand();
     if (poUnderlyingMainRasterBand == NULL)
         return NULL;
 
-    nRefCountUnderlyingMainRasterBand ++;
-    return poUnderlyingMainRasterBand->GetOverview(nOverviewBand);
+    GDALRasterBand* poUnderlyingRasterBand =
+        poUnderlyingMainRasterBand->GetOverview(nOverviewBand);
+    if (poUnderlyingRasterBand == NULL)
+    {
+        poMainBand->UnrefUnderlyingRasterBand(poUnderlyingMainRasterBand);
+        return NULL;
+    }
+
+    CPLMutexHolderD( GetCacheMutex() );
+    std::pair<GDALRasterBand*, int>& oMainBand =
+        oMapUnderlyingMainRasterBand[poUnderlyingRasterBand];
+    oMainBand.first = poUnderlyingMainRasterBand;
+    oMainBand.second ++;
+    return poUnderlyingRasterBand;
 }
 
 /* ******************************************************************** */
@@ -1187,8 +1480,21 @@ GDALRasterBand* GDALProxyPoolOverviewRasterBand::RefUnderlyingRasterBand()
 
 void GDALProxyPoolOverviewRasterBand::UnrefUnderlyingRasterBand(GDALRasterBand* poUnderlyingRasterBand)
 {
+    GDALRasterBand* poUnderlyingMainRasterBand = NULL;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        std::map<GDALRasterBand*, std::pair<GDALRasterBand*, int> >::iterator oIter =
+            oMapUnderlyingMainRasterBand.find(poUnderlyingRasterBand);
+        if (oIter == oMapUnderlyingMainRasterBand.end())
+        {
+            CPLAssert(0);
+            return;
+        }
+        poUnderlyingMainRasterBand = oIter->second.first;
+        if (-- oIter->second.second == 0)
+            oMapUnderlyingMainRasterBand.erase(oIter);
+    }
     poMainBand->UnrefUnderlyingRasterBand(poUnderlyingMainRasterBand);
-    nRefCountUnderlyingMainRasterBand --;
 }
 
 
@@ -1202,9 +1508,6 @@ GDALProxyPoolMaskBand::GDALProxyPoolMaskBand(GDALProxyPoolDataset* poDS,
         GDALProxyPoolRasterBand(poDS, poUnderlyingMaskBand)
 {
     this->poMainBand = poMainBand;
-
-    poUnderlyingMainRasterBand = NULL;
-    nRefCountUnderlyingMainRasterBand = 0;
 }
 
 /* ******************************************************************** */
@@ -1218,9 +1521,6 @@ GDALProxyPoolMaskBand::GDALProxyPoolMaskBand(GDALProxyPoolDataset* poDS,
         GDALProxyPoolRasterBand(poDS, 1, eDataType, nBlockXSize, nBlockYSize)
 {
     this->poMainBand = poMainBand;
-
-    poUnderlyingMainRasterBand = NULL;
-    nRefCountUnderlyingMainRasterBand = 0;
 }
 
 /* ******************************************************************** */
@@ -1229,7 +1529,7 @@ GDALProxyPoolMaskBand::GDALProxyPoolMaskBand(GDALProxyPoolDataset* poDS,
 
 GDALProxyPoolMaskBand::~GDALProxyPoolMaskBand()
 {
-    CPLAssert(nRefCountUnderlyingMainRasterBand == 0);
+    CPLAssert(oMapUnderlyingMainRasterBand.empty());
 }
 
 /* ******************************************************************** */
@@ -1238,12 +1538,23 @@ GDALProxyPoolMaskBand::~GDALProxyPoolMaskBand()
 
 GDALRasterBand* GDALProxyPoolMaskBand::RefUnderlyingRasterBand()
 {
-    poUnderlyingMainRasterBand = poMainBand->RefUnderlyingRasterBand();
+    GDALRasterBand* poUnderlyingMainRasterBand = poMainBand->RefUnderlyingRasterBand();
     if (poUnderlyingMainRasterBand == NULL)
         return NULL;
 
-    nRefCountUnderlyingMainRasterBand ++;
-    return poUnderlyingMainRasterBand->GetMaskBand();
+    GDALRasterBand* poUnderlyingRasterBand = poUnderlyingMainRasterBand->GetMaskBand();
+    if (poUnderlyingRasterBand == NULL)
+    {
+        poMainBand->UnrefUnderlyingRasterBand(poUnderlyingMainRasterBand);
+        return NULL;
+    }
+
+    CPLMutexHolderD( GetCacheMutex() );
+    std::pair<GDALRasterBand*, int>& oMainBand =
+        oMapUnderlyingMainRasterBand[poUnderlyingRasterBand];
+    oMainBand.first = poUnderlyingMainRasterBand;
+    oMainBand.second ++;
+    return poUnderlyingRasterBand;
 }
 
 /* ******************************************************************** */
@@ -1252,6 +1563,19 @@ GDALRasterBand* GDALProxyPoolMaskBand::RefUnderlyingRasterBand()
 
 void GDALProxyPoolMaskBand::UnrefUnderlyingRasterBand(GDALRasterBand* poUnderlyingRasterBand)
 {
+    GDALRasterBand* poUnderlyingMainRasterBand = NULL;
+    {
+        CPLMutexHolderD( GetCacheMutex() );
+        std::map<GDALRasterBand*, std::pair<GDALRasterBand*, int> >::iterator oIter =
+            oMapUnderlyingMainRasterBand.find(poUnderlyingRasterBand);
+        if (oIter == oMapUnderlyingMainRasterBand.end())
+        {
+            CPLAssert(0);
+            return;
+        }
+        poUnderlyingMainRasterBand = oIter->second.first;
+        if (-- oIter->second.second == 0)
+            oMapUnderlyingMainRasterBand.erase(oIter);
+    }
     poMainBand->UnrefUnderlyingRasterBand(poUnderlyingMainRasterBand);
-    nRefCountUnderlyingMainRasterBand --;
 }
@@ -32,13 +32,94 @@
 #include "gdal_priv.h"
 #include "gdal_rat.h"
 #include "cpl_string.h"
+#include "cpl_multiproc.h"
 
 #define SUBBLOCK_SIZE 64
 #define TO_SUBBLOCK(x) ((x) >> 6)
 #define WITHIN_SUBBLOCK(x) ((x) & 0x3f)
 
+/* Initial (and minimum) number of entries of the block hash table */
+#define BLOCK_HASH_MIN_SIZE 64
+
 CPL_CVSID("$Id$");
 
+/************************************************************************/
+/*                         GDALBlockHashSlot()                          */
+/*                                                                      */
+/*      Home slot of a block in a block hash table whose size is a      */
+/*      power of two.                                                   */
+/************************************************************************/
+
+static int GDALBlockHashSlot( int nXBlockOff, int nYBlockOff, int nSize )
+
+{
+    GUInt32 nHash = ((GUInt32)nXBlockOff * 0x9E3779B1U)
+                  ^ ((GUInt32)nYBlockOff * 0x85EBCA77U);
+    nHash ^= nHash >> 15;
+
+    return (int)(nHash & (GUInt32)(nSize - 1));
+}
+
+/************************************************************************/
+/*                        GDALBlockHashLookup()                         */
+/*                                                                      */
+/*      Return the slot of the block at the requested offsets, or of    */
+/*      the empty slot where it should be inserted. Linear probing is   */
+/*      used, and the table is never more than half full.               */
+/************************************************************************/
+
+static int GDALBlockHashLookup( GDALRasterBlock **papoTable, int nSize,
+                                int nXBlockOff, int nYBlockOff )
+
+{
+    int iSlot = GDALBlockHashSlot( nXBlockOff, nYBlockOff, nSize );
+
+    while( papoTable[iSlot] != NULL
+           && (papoTable[iSlot]->GetXOff() != nXBlockOff
+               || papoTable[iSlot]->GetYOff() != nYBlockOff) )
+        iSlot = (iSlot + 1) & (nSize - 1);
+
+    return iSlot;
+}
+
+/************************************************************************/
+/*                       GDALBlockHashRemoveAt()                        */
+/*                                                                      */
+/*      Empty a slot of the block hash table, shifting back the         */
+/*      following entries of the probe sequence, so that no tombstone   */
+/*      is needed.                                                      */
+/************************************************************************/
+
+static void GDALBlockHashRemoveAt( GDALRasterBlock **papoTable, int nSize,
+                                   int iHole )
+
+{
+    int iSlot = iHole;
+
+    papoTable[iHole] = NULL;
+
+    while( TRUE )
+    {
+        iSlot = (iSlot + 1) & (nSize - 1);
+
+        GDALRasterBlock *poBlock = papoTable[iSlot];
+        if( poBlock == NULL )
+            return;
+
+        int iHome = GDALBlockHashSlot( poBlock->GetXOff(), poBlock->GetYOff(),
+                                       nSize );
+
+        /* Move the entry into the hole, unless its home slot lies */
+        /* (cyclically) between the hole and its current slot. */
+        if( ((iSlot - iHome) & (nSize - 1)) >= ((iSlot - iHole) & (nSize - 1)) )
+        {
+            papoTable[iHole] = poBlock;
+            papoTable[iSlot] = NULL;
+            iHole = iSlot;
+        }
+    }
+}
+
 /************************************************************************/
 /*                           GDALRasterBand()                           */
 /************************************************************************/
@@ -62,6 +143,11 @@ GDALRasterBand::GDALRasterBand()
     bSubBlockingActive = FALSE;
     papoBlocks = NULL;
 
+    bSparseBlockingActive = FALSE;
+    nBlockHashSize = 0;
+    nBlockHashCount = 0;
+    hBlockHashMutex = NULL;
+
     poMask = NULL;
     bOwnMask = false;
     nMaskFlags = 0;
@@ -87,11 +173,14 @@ GDALRasterBand::~GDALRasterBand()
 
     CPLFree( papoBlocks );
 
-    if( nBlockReads > nBlocksPerRow * nBlocksPerColumn
+    if( hBlockHashMutex != NULL )
+        CPLDestroyMutex( hBlockHashMutex );
+
+    if( nBlockReads > (GIntBig)nBlocksPerRow * nBlocksPerColumn
         && nBand == 1 && poDS != NULL )
     {
-        CPLDebug( "GDAL", "%d block reads on %d block band 1 of %s.",
-                  nBlockReads, nBlocksPerRow * nBlocksPerColumn, 
+        CPLDebug( "GDAL", "%d block reads on " CPL_FRMT_GIB " block band 1 of %s.",
+                  nBlockReads, (GIntBig)nBlocksPerRow * nBlocksPerColumn, 
                   poDS->GetDescription() );
     }
 
@@ -180,6 +269,56 @@ CPLErr GDALRasterBand::RasterIO( GDALRWFlag eRWFlag,
                                  int nPixelSpace,
                                  int nLineSpace )
 
+{
+    return RasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                     pData, nBufXSize, nBufYSize, eBufType,
+                     nPixelSpace, nLineSpace, NULL );
+}
+
+/************************************************************************/
+/*                              RasterIO()                              */
+/************************************************************************/
+
+/**
+ * \brief Read/write a region of image data for this band, with extra
+ * arguments.
+ *
+ * This is the same as the other RasterIO() method, except for the
+ * psExtraArg argument, that may be NULL.
+ *
+ * When reading with a buffer size different from the size of the region,
+ * psExtraArg->eResampleAlg selects how the buffer pixels are computed.
+ * With GRIORA_NearestNeighbour, the default, the nearest source pixel is
+ * picked, possibly from an overview, as in the other RasterIO() method.
+ * The other methods compute each buffer pixel from all the source pixels
+ * it covers, or from a neighbourhood of them when upsampling, using the
+ * pixels around the region if needed. The nodata value of the band, if
+ * any, is taken into account. Data of bands with a color table, and complex
+ * data, are always read with GRIORA_NearestNeighbour, except for GRIORA_Mode.
+ * The resampling method is ignored for writes.
+ *
+ * psExtraArg->pfnProgress, if not NULL, is called as the request is
+ * processed. If it returns FALSE, the request is interrupted and
+ * CE_Failure is returned.
+ *
+ * This method is the same as the C GDALRasterIOEx() function.
+ *
+ * @param psExtraArg pointer to a GDALRasterIOExtraArg structure, initialized
+ * with INIT_RASTERIO_EXTRA_ARG(), or NULL.
+ *
+ * @return CE_Failure if the access fails, otherwise CE_None.
+ *
+ * @since GDAL 2.0
+ */
+
+CPLErr GDALRasterBand::RasterIO( GDALRWFlag eRWFlag,
+                                 int nXOff, int nYOff, int nXSize, int nYSize,
+                                 void * pData, int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType,
+                                 int nPixelSpace,
+                                 int nLineSpace,
+                                 GDALRasterIOExtraArg* psExtraArg )
+
 {
 
     if( NULL == pData )
@@ -253,17 +392,44 @@ CPLErr GDALRasterBand::RasterIO( GDALRWFlag eRWFlag,
         return CE_Failure;
     }
 
+    if( psExtraArg != NULL && psExtraArg->nVersion < 1 )
+    {
+        ReportError( CE_Failure, CPLE_IllegalArg,
+                  "Unsupported GDALRasterIOExtraArg version: %d.",
+                  psExtraArg->nVersion );
+        return CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Resampled reads are done by the generic implementation.         */
+/* -------------------------------------------------------------------- */
+    if( psExtraArg != NULL && eRWFlag == GF_Read &&
+        psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
+        (nBufXSize != nXSize || nBufYSize != nYSize) )
+    {
+        return RasterIOResampled( nXOff, nYOff, nXSize, nYSize,
+                                  pData, nBufXSize, nBufYSize, eBufType,
+                                  nPixelSpace, nLineSpace, psExtraArg );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Call the format specific function.                              */
 /* -------------------------------------------------------------------- */
+    CPLErr eErr;
     if( bForceCachedIO )
-        return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+        eErr = GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
                                          pData, nBufXSize, nBufYSize, eBufType,
                                          nPixelSpace, nLineSpace );
     else
-        return IRasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+        eErr = IRasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
                           pData, nBufXSize, nBufYSize, eBufType,
                           nPixelSpace, nLineSpace ) ;
+
+    if( eErr == CE_None && psExtraArg != NULL &&
+        psExtraArg->pfnProgress != NULL )
+        psExtraArg->pfnProgress( 1.0, "", psExtraArg->pProgressData );
+
+    return eErr;
 }
 
 /************************************************************************/
@@ -292,6 +458,36 @@ GDALRasterIO( GDALRasterBandH hBand, GDALRWFlag eRWFlag,
                               pData, nBufXSize, nBufYSize, eBufType,
                               nPixelSpace, nLineSpace ) );
 }
+
+/************************************************************************/
+/*                           GDALRasterIOEx()                           */
+/************************************************************************/
+
+/**
+ * \brief Read/write a region of image data for this band, with extra
+ * arguments.
+ *
+ * @see GDALRasterBand::RasterIO(GDALRWFlag, int, int, int, int, void *, int, int, GDALDataType, int, int, GDALRasterIOExtraArg*)
+ * @since GDAL 2.0
+ */
+
+CPLErr CPL_STDCALL 
+GDALRasterIOEx( GDALRasterBandH hBand, GDALRWFlag eRWFlag,
+                int nXOff, int nYOff, int nXSize, int nYSize,
+                void * pData, int nBufXSize, int nBufYSize,
+                GDALDataType eBufType,
+                int nPixelSpace, int nLineSpace,
+                GDALRasterIOExtraArg* psExtraArg )
+    
+{
+    VALIDATE_POINTER1( hBand, "GDALRasterIOEx", CE_Failure );
+
+    GDALRasterBand *poBand = static_cast<GDALRasterBand*>(hBand);
+
+    return( poBand->RasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                              pData, nBufXSize, nBufYSize, eBufType,
+                              nPixelSpace, nLineSpace, psExtraArg ) );
+}
                      
 /************************************************************************/
 /*                             ReadBlock()                              */
@@ -712,7 +908,37 @@ int GDALRasterBand::InitBlockInfo()
     nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
     nBlocksPerColumn = DIV_ROUND_UP(nRasterYSize, nBlockYSize);
 
-    if( nBlocksPerRow < SUBBLOCK_SIZE/2 )
+/* -------------------------------------------------------------------- */
+/*      Select how cached blocks are looked up. The block array (with   */
+/*      subblocking for wide rasters) is fast but its size depends on   */
+/*      the number of blocks of the raster, whereas the hash table      */
+/*      only grows with the number of cached blocks, which is better    */
+/*      suited to huge rasters of which only a few blocks are read.     */
+/* -------------------------------------------------------------------- */
+    const char* pszBlockCache =
+        CPLGetConfigOption("GDAL_BAND_BLOCK_CACHE", "AUTO");
+    if( EQUAL(pszBlockCache, "HASH") )
+        bSparseBlockingActive = TRUE;
+    else if( EQUAL(pszBlockCache, "ARRAY") )
+        bSparseBlockingActive = FALSE;
+    else
+        bSparseBlockingActive =
+            ((GIntBig)nBlocksPerRow * nBlocksPerColumn > 1024 * 1024);
+
+    if( bSparseBlockingActive )
+    {
+        bSubBlockingActive = FALSE;
+
+        hBlockHashMutex = CPLCreateMutex();
+        if( hBlockHashMutex != NULL )
+            CPLReleaseMutex( hBlockHashMutex );
+
+        nBlockHashSize = BLOCK_HASH_MIN_SIZE;
+        nBlockHashCount = 0;
+        papoBlocks = (GDALRasterBlock **)
+            VSICalloc( sizeof(void*), nBlockHashSize );
+    }
+    else if( nBlocksPerRow < SUBBLOCK_SIZE/2 )
     {
         bSubBlockingActive = FALSE;
 
@@ -758,6 +984,41 @@ int GDALRasterBand::InitBlockInfo()
     return TRUE;
 }
 
+/************************************************************************/
+/*                          ResizeBlockHash()                           */
+/*                                                                      */
+/*      Rehash the cached blocks into a hash table of nNewSize          */
+/*      entries. The block hash mutex must be held.                     */
+/************************************************************************/
+
+int GDALRasterBand::ResizeBlockHash( int nNewSize )
+
+{
+    GDALRasterBlock **papoNewBlocks = (GDALRasterBlock **)
+        VSICalloc( sizeof(void*), nNewSize );
+
+    if( papoNewBlocks == NULL )
+        return FALSE;
+
+    for( int iSlot = 0; iSlot < nBlockHashSize; iSlot++ )
+    {
+        GDALRasterBlock *poBlock = papoBlocks[iSlot];
+        if( poBlock == NULL )
+            continue;
+
+        int iNewSlot = GDALBlockHashLookup( papoNewBlocks, nNewSize,
+                                            poBlock->GetXOff(),
+                                            poBlock->GetYOff() );
+        papoNewBlocks[iNewSlot] = poBlock;
+    }
+
+    CPLFree( papoBlocks );
+    papoBlocks = papoNewBlocks;
+    nBlockHashSize = nNewSize;
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                             AdoptBlock()                             */
 /*                                                                      */
@@ -776,7 +1037,54 @@ CPLErr GDALRasterBand::AdoptBlock( int nXBlockOff, int nYBlockOff,
     
     if( !InitBlockInfo() )
         return CE_Failure;
-    
+
+/* -------------------------------------------------------------------- */
+/*      Hash table case.  Any other block at the same offsets is        */
+/*      flushed without holding the hash mutex, since writing it        */
+/*      might need to lock blocks of other bands.                       */
+/* -------------------------------------------------------------------- */
+    if( bSparseBlockingActive )
+    {
+        int bFlushPrevious;
+        {
+            CPLMutexHolderOptionalLockD( hBlockHashMutex );
+            int iSlot = GDALBlockHashLookup( papoBlocks, nBlockHashSize,
+                                             nXBlockOff, nYBlockOff );
+            if( papoBlocks[iSlot] == poBlock )
+                return CE_None;
+            bFlushPrevious = (papoBlocks[iSlot] != NULL);
+        }
+
+        if( bFlushPrevious )
+            FlushBlock( nXBlockOff, nYBlockOff );
+
+        CPLMutexHolderOptionalLockD( hBlockHashMutex );
+
+        /* Keep the load factor between 1/8 and 1/2 */
+        int nNewSize = nBlockHashSize;
+        while( (nBlockHashCount + 1) * 2 > nNewSize )
+            nNewSize *= 2;
+        while( nNewSize > BLOCK_HASH_MIN_SIZE
+               && (nBlockHashCount + 1) * 8 < nNewSize )
+            nNewSize /= 2;
+
+        if( nNewSize != nBlockHashSize && !ResizeBlockHash( nNewSize )
+            && (nBlockHashCount + 1) * 2 > nBlockHashSize )
+        {
+            ReportError( CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in AdoptBlock()." );
+            return CE_Failure;
+        }
+
+        int iSlot = GDALBlockHashLookup( papoBlocks, nBlockHashSize,
+                                         nXBlockOff, nYBlockOff );
+        papoBlocks[iSlot] = poBlock;
+        nBlockHashCount++;
+        poBlock->Touch();
+
+        return CE_None;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Simple case without subblocking.                                */
 /* -------------------------------------------------------------------- */
@@ -868,6 +1176,34 @@ CPLErr GDALRasterBand::FlushCache()
     if (papoBlocks == NULL)
         return eGlobalErr;
 
+/* -------------------------------------------------------------------- */
+/*      Hash table case. Removing a block only shifts back entries      */
+/*      that follow it, so a single pass empties the table.             */
+/* -------------------------------------------------------------------- */
+    if( bSparseBlockingActive )
+    {
+        for( int iSlot = 0; iSlot < nBlockHashSize; iSlot++ )
+        {
+            while( TRUE )
+            {
+                int nXBlockOff, nYBlockOff;
+                {
+                    CPLMutexHolderOptionalLockD( hBlockHashMutex );
+                    if( papoBlocks[iSlot] == NULL )
+                        break;
+                    nXBlockOff = papoBlocks[iSlot]->GetXOff();
+                    nYBlockOff = papoBlocks[iSlot]->GetYOff();
+                }
+
+                CPLErr eErr = FlushBlock( nXBlockOff, nYBlockOff,
+                                          eGlobalErr == CE_None );
+                if( eErr != CE_None )
+                    eGlobalErr = eErr;
+            }
+        }
+        return eGlobalErr;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Flush all blocks in memory ... this case is without subblocking.*/
 /* -------------------------------------------------------------------- */
@@ -995,14 +1331,36 @@ CPLErr GDALRasterBand::FlushBlock( int nXBlockOff, int nYBlockOff, int bWriteDir
         return( CE_Failure );
     }
 
+/* -------------------------------------------------------------------- */
+/*      Hash table case.                                                */
+/* -------------------------------------------------------------------- */
+    if( bSparseBlockingActive )
+    {
+        CPLMutexHolderOptionalLockD( hBlockHashMutex );
+
+        int iSlot = GDALBlockHashLookup( papoBlocks, nBlockHashSize,
+                                         nXBlockOff, nYBlockOff );
+
+        GDALRasterBlock::SafeLockBlock( papoBlocks + iSlot, this,
+                                        nXBlockOff, nYBlockOff );
+
+        poBlock = papoBlocks[iSlot];
+        if( poBlock != NULL )
+        {
+            GDALBlockHashRemoveAt( papoBlocks, nBlockHashSize, iSlot );
+            nBlockHashCount--;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Simple case for single level caches.                            */
 /* -------------------------------------------------------------------- */
-    if( !bSubBlockingActive )
+    else if( !bSubBlockingActive )
     {
         nBlockIndex = nXBlockOff + nYBlockOff * nBlocksPerRow;
 
-        GDALRasterBlock::SafeLockBlock( papoBlocks + nBlockIndex );
+        GDALRasterBlock::SafeLockBlock( papoBlocks + nBlockIndex, this,
+                                         nXBlockOff, nYBlockOff );
 
         poBlock = papoBlocks[nBlockIndex];
         papoBlocks[nBlockIndex] = NULL;
@@ -1028,7 +1386,8 @@ CPLErr GDALRasterBand::FlushBlock( int nXBlockOff, int nYBlockOff, int bWriteDir
         int nBlockInSubBlock = WITHIN_SUBBLOCK(nXBlockOff)
             + WITHIN_SUBBLOCK(nYBlockOff) * SUBBLOCK_SIZE;
         
-        GDALRasterBlock::SafeLockBlock( papoSubBlockGrid + nBlockInSubBlock );
+        GDALRasterBlock::SafeLockBlock( papoSubBlockGrid + nBlockInSubBlock,
+                                        this, nXBlockOff, nYBlockOff );
 
         poBlock = papoSubBlockGrid[nBlockInSubBlock];
         papoSubBlockGrid[nBlockInSubBlock] = NULL;
@@ -1112,6 +1471,22 @@ GDALRasterBlock *GDALRasterBand::TryGetLockedBlockRef( int nXBlockOff,
         return( NULL );
     }
 
+/* -------------------------------------------------------------------- */
+/*      Hash table case.                                                */
+/* -------------------------------------------------------------------- */
+    if( bSparseBlockingActive )
+    {
+        CPLMutexHolderOptionalLockD( hBlockHashMutex );
+
+        int iSlot = GDALBlockHashLookup( papoBlocks, nBlockHashSize,
+                                         nXBlockOff, nYBlockOff );
+
+        GDALRasterBlock::SafeLockBlock( papoBlocks + iSlot, this,
+                                        nXBlockOff, nYBlockOff );
+
+        return papoBlocks[iSlot];
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Simple case for single level caches.                            */
 /* -------------------------------------------------------------------- */
@@ -1119,7 +1494,8 @@ GDALRasterBlock *GDALRasterBand::TryGetLockedBlockRef( int nXBlockOff,
     {
         nBlockIndex = nXBlockOff + nYBlockOff * nBlocksPerRow;
         
-        GDALRasterBlock::SafeLockBlock( papoBlocks + nBlockIndex );
+        GDALRasterBlock::SafeLockBlock( papoBlocks + nBlockIndex, this,
+                                         nXBlockOff, nYBlockOff );
 
         return papoBlocks[nBlockIndex];
     }
@@ -1142,7 +1518,8 @@ GDALRasterBlock *GDALRasterBand::TryGetLockedBlockRef( int nXBlockOff,
     int nBlockInSubBlock = WITHIN_SUBBLOCK(nXBlockOff)
         + WITHIN_SUBBLOCK(nYBlockOff) * SUBBLOCK_SIZE;
 
-    GDALRasterBlock::SafeLockBlock( papoSubBlockGrid + nBlockInSubBlock );
+    GDALRasterBlock::SafeLockBlock( papoSubBlockGrid + nBlockInSubBlock,
+                                    this, nXBlockOff, nYBlockOff );
 
     return papoSubBlockGrid[nBlockInSubBlock];
 }
@@ -1259,7 +1636,7 @@ GDALRasterBlock * GDALRasterBand::GetLockedBlockRef( int nXBlockOff,
         if( !bJustInitialize )
         {
             nBlockReads++;
-            if( nBlockReads == nBlocksPerRow * nBlocksPerColumn + 1 
+            if( nBlockReads == (GIntBig)nBlocksPerRow * nBlocksPerColumn + 1 
                 && nBand == 1 && poDS != NULL )
             {
                 CPLDebug( "GDAL", "Potential thrashing on band %d of %s.",
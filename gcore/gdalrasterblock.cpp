@@ -36,13 +36,130 @@ CPL_CVSID("$Id$");
 
 static int bCacheMaxInitialized = FALSE;
 static GIntBig nCacheMax = 40 * 1024*1024;
-static volatile GIntBig nCacheUsed = 0;
 
-static volatile GDALRasterBlock *poOldest = NULL;    /* tail */
-static volatile GDALRasterBlock *poNewest = NULL;    /* head */
+/* -------------------------------------------------------------------- */
+/*      The block cache is split into several shards, each one with     */
+/*      its own LRU list, memory counter and mutex, so that threads     */
+/*      working on different blocks do not contend on a single lock.   */
+/*      A block is assigned to a shard by hashing its band and block    */
+/*      offsets. The GDAL_CACHEMAX limit applies to the sum of the      */
+/*      memory used by all shards.                                      */
+/* -------------------------------------------------------------------- */
+
+#define GDAL_RB_MAX_SHARDS 64
+
+typedef struct
+{
+    void                     *hMutex;
+    GIntBig                   nCacheUsed;  /* protected by hMutex */
+    GDALRasterBlock          *poOldest;    /* tail */
+    GDALRasterBlock          *poNewest;    /* head */
+
+    /* Avoid false sharing of cache lines between shards */
+    char                      abyPadding[64 - 3 * sizeof(void*) - sizeof(GIntBig)];
+} GDALRasterBlockShard;
 
+static GDALRasterBlockShard asShards[GDAL_RB_MAX_SHARDS];
+static volatile int nShardCount = 0;
+
+/* Only used to protect the initialization of the shards */
 static void *hRBMutex = NULL;
 
+/************************************************************************/
+/*                        GDALRBGetShardCount()                         */
+/*                                                                      */
+/*      Initialize the shards on first use. The number of shards is     */
+/*      taken from the GDAL_CACHE_SHARDS configuration option, and      */
+/*      defaults to the number of CPUs. It is rounded up to a power     */
+/*      of two.                                                         */
+/************************************************************************/
+
+static int GDALRBGetShardCount()
+
+{
+    if( nShardCount != 0 )
+        return nShardCount;
+
+    CPLMutexHolderD( &hRBMutex );
+
+    if( nShardCount == 0 )
+    {
+        int nRequested;
+        const char* pszShards = CPLGetConfigOption("GDAL_CACHE_SHARDS", NULL);
+        if( pszShards != NULL )
+            nRequested = atoi(pszShards);
+        else
+            nRequested = CPLGetNumCPUs();
+
+        int nShards = 1;
+        while( nShards < nRequested && nShards < GDAL_RB_MAX_SHARDS )
+            nShards *= 2;
+
+        for( int i = 0; i < nShards; i++ )
+        {
+            asShards[i].hMutex = CPLCreateMutex();
+            if( asShards[i].hMutex != NULL )
+                CPLReleaseMutex( asShards[i].hMutex );
+            asShards[i].nCacheUsed = 0;
+            asShards[i].poOldest = NULL;
+            asShards[i].poNewest = NULL;
+        }
+
+        nShardCount = nShards;
+    }
+
+    return nShardCount;
+}
+
+/************************************************************************/
+/*                          GDALRBGetShard()                            */
+/************************************************************************/
+
+static int GDALRBGetShard( GDALRasterBand *poBand, int nXOff, int nYOff )
+
+{
+    int nShards = GDALRBGetShardCount();
+    if( nShards == 1 )
+        return 0;
+
+    GUIntBig nHash = ((GUIntBig)(size_t)poBand) >> 4;
+    nHash ^= (GUIntBig)((GUInt32)nXOff * 0x9E3779B1U);
+    nHash ^= (GUIntBig)((GUInt32)nYOff * 0x85EBCA77U) << 7;
+    nHash ^= nHash >> 17;
+
+    return (int)(nHash & (GUIntBig)(nShards - 1));
+}
+
+/************************************************************************/
+/*                     GDALRBGetShardCacheUsed()                        */
+/*                                                                      */
+/*      The counter is read with the shard mutex held, since a 64 bit   */
+/*      read is not atomic on 32 bit platforms.                         */
+/************************************************************************/
+
+static GIntBig GDALRBGetShardCacheUsed( int iShard )
+
+{
+    CPLMutexHolderOptionalLockD( asShards[iShard].hMutex );
+    return asShards[iShard].nCacheUsed;
+}
+
+/************************************************************************/
+/*                        GDALRBGetCacheUsed()                          */
+/************************************************************************/
+
+static GIntBig GDALRBGetCacheUsed()
+
+{
+    GIntBig nUsed = 0;
+    int nShards = nShardCount;
+
+    for( int i = 0; i < nShards; i++ )
+        nUsed += GDALRBGetShardCacheUsed( i );
+
+    return nUsed;
+}
+
 /************************************************************************/
 /*                          GDALSetCacheMax()                           */
 /************************************************************************/
@@ -96,13 +213,9 @@ void CPL_STDCALL GDALSetCacheMax64( GIntBig nNewSizeInBytes )
 /*      Flush blocks till we are under the new limit or till we         */
 /*      can't seem to flush anymore.                                    */
 /* -------------------------------------------------------------------- */
-    while( nCacheUsed > nCacheMax )
+    while( GDALRBGetCacheUsed() > nCacheMax )
     {
-        GIntBig nOldCacheUsed = nCacheUsed;
-
-        GDALFlushCacheBlock();
-
-        if( nCacheUsed == nOldCacheUsed )
+        if( !GDALFlushCacheBlock() )
             break;
     }
 }
@@ -201,6 +314,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    GIntBig nCacheUsed = GDALRBGetCacheUsed();
     if (nCacheUsed > INT_MAX)
     {
         static int bHasWarned = FALSE;
@@ -231,7 +345,7 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
-    return nCacheUsed;
+    return GDALRBGetCacheUsed();
 }
 
 /************************************************************************/
@@ -283,6 +397,12 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * Some driver classes are implemented in a fashion that completely avoids
  * use of the GDAL raster cache (and GDALRasterBlock) though this is not very
  * common.
+ *
+ * To reduce lock contention in multi-threaded applications, the cache is
+ * split into several shards, each one with its own LRU list and mutex.
+ * The number of shards defaults to the number of CPUs and can be set with
+ * the GDAL_CACHE_SHARDS configuration option (1 restores a single global
+ * LRU list). The upper cache limit applies to the total of all shards.
  */
 
 /************************************************************************/
@@ -302,6 +422,9 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * for a new cache block would put cache memory use over the established
  * limit.   
  *
+ * The oldest unlocked block of the shard using the most memory is flushed.
+ * Other shards are tried in turn if all its blocks are locked.
+ *
  * C++ analog to the C function GDALFlushCacheBlock().
  * 
  * @return TRUE if successful or FALSE if no flushable block is found.
@@ -310,18 +433,39 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock()
 
 {
-    int nXOff, nYOff;
-    GDALRasterBand *poBand;
+    int nXOff = 0, nYOff = 0;
+    GDALRasterBand *poBand = NULL;
+    int nShards = nShardCount;
 
+    if( nShards == 0 )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Start with the biggest shard to keep them balanced.             */
+/* -------------------------------------------------------------------- */
+    int iFirstShard = 0;
+    GIntBig nMaxUsed = -1;
+    for( int i = 0; i < nShards; i++ )
+    {
+        GIntBig nUsed = GDALRBGetShardCacheUsed( i );
+        if( nUsed > nMaxUsed )
+        {
+            nMaxUsed = nUsed;
+            iFirstShard = i;
+        }
+    }
+
+    for( int i = 0; i < nShards && poBand == NULL; i++ )
     {
-        CPLMutexHolderD( &hRBMutex );
-        GDALRasterBlock *poTarget = (GDALRasterBlock *) poOldest;
+        int iShard = (iFirstShard + i) & (nShards - 1);
+        CPLMutexHolderOptionalLockD( asShards[iShard].hMutex );
+        GDALRasterBlock *poTarget = asShards[iShard].poOldest;
 
         while( poTarget != NULL && poTarget->GetLockCount() > 0 ) 
             poTarget = poTarget->poPrevious;
         
         if( poTarget == NULL )
-            return FALSE;
+            continue;
 
         poTarget->Detach();
 
@@ -330,6 +474,9 @@ int GDALRasterBlock::FlushCacheBlock()
         poBand = poTarget->GetBand();
     }
 
+    if( poBand == NULL )
+        return FALSE;
+
     CPLErr eErr = poBand->FlushBlock( nXOff, nYOff );
     if (eErr != CE_None)
     {
@@ -377,6 +524,8 @@ GDALRasterBlock::GDALRasterBlock( GDALRasterBand *poBandIn,
 
     nXOff = nXOffIn;
     nYOff = nYOffIn;
+
+    nShard = GDALRBGetShard( poBand, nXOff, nYOff );
 }
 
 /************************************************************************/
@@ -403,8 +552,8 @@ GDALRasterBlock::~GDALRasterBlock()
         nSizeInBytes = (nXSize * nYSize * GDALGetDataTypeSize(eType)+7)/8;
 
         {
-            CPLMutexHolderD( &hRBMutex );
-            nCacheUsed -= nSizeInBytes;
+            CPLMutexHolderOptionalLockD( asShards[nShard].hMutex );
+            asShards[nShard].nCacheUsed -= nSizeInBytes;
         }
     }
 
@@ -431,14 +580,15 @@ GDALRasterBlock::~GDALRasterBlock()
 void GDALRasterBlock::Detach()
 
 {
-    CPLMutexHolderD( &hRBMutex );
+    GDALRasterBlockShard *psShard = asShards + nShard;
+    CPLMutexHolderOptionalLockD( psShard->hMutex );
 
-    if( poOldest == this )
-        poOldest = poPrevious;
+    if( psShard->poOldest == this )
+        psShard->poOldest = poPrevious;
 
-    if( poNewest == this )
+    if( psShard->poNewest == this )
     {
-        poNewest = poNext;
+        psShard->poNewest = poNext;
     }
 
     if( poPrevious != NULL )
@@ -463,28 +613,36 @@ void GDALRasterBlock::Detach()
 void GDALRasterBlock::Verify()
 
 {
-    CPLMutexHolderD( &hRBMutex );
-
-    CPLAssert( (poNewest == NULL && poOldest == NULL)
-               || (poNewest != NULL && poOldest != NULL) );
+    int nShards = nShardCount;
 
-    if( poNewest != NULL )
+    for( int iShard = 0; iShard < nShards; iShard++ )
     {
-        CPLAssert( poNewest->poPrevious == NULL );
-        CPLAssert( poOldest->poNext == NULL );
-        
-        for( GDALRasterBlock *poBlock = (GDALRasterBlock *) poNewest; 
-             poBlock != NULL;
-             poBlock = poBlock->poNext )
+        GDALRasterBlockShard *psShard = asShards + iShard;
+        CPLMutexHolderOptionalLockD( psShard->hMutex );
+
+        CPLAssert( (psShard->poNewest == NULL && psShard->poOldest == NULL)
+                   || (psShard->poNewest != NULL && psShard->poOldest != NULL) );
+
+        if( psShard->poNewest != NULL )
         {
-            if( poBlock->poPrevious )
-            {
-                CPLAssert( poBlock->poPrevious->poNext == poBlock );
-            }
+            CPLAssert( psShard->poNewest->poPrevious == NULL );
+            CPLAssert( psShard->poOldest->poNext == NULL );
 
-            if( poBlock->poNext )
+            for( GDALRasterBlock *poBlock = psShard->poNewest; 
+                 poBlock != NULL;
+                 poBlock = poBlock->poNext )
             {
-                CPLAssert( poBlock->poNext->poPrevious == poBlock );
+                CPLAssert( poBlock->nShard == iShard );
+
+                if( poBlock->poPrevious )
+                {
+                    CPLAssert( poBlock->poPrevious->poNext == poBlock );
+                }
+
+                if( poBlock->poNext )
+                {
+                    CPLAssert( poBlock->poNext->poPrevious == poBlock );
+                }
             }
         }
     }
@@ -535,13 +693,14 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
-    CPLMutexHolderD( &hRBMutex );
+    GDALRasterBlockShard *psShard = asShards + nShard;
+    CPLMutexHolderOptionalLockD( psShard->hMutex );
 
-    if( poNewest == this )
+    if( psShard->poNewest == this )
         return;
 
-    if( poOldest == this )
-        poOldest = this->poPrevious;
+    if( psShard->poOldest == this )
+        psShard->poOldest = this->poPrevious;
     
     if( poPrevious != NULL )
         poPrevious->poNext = poNext;
@@ -550,19 +709,19 @@ void GDALRasterBlock::Touch()
         poNext->poPrevious = poPrevious;
 
     poPrevious = NULL;
-    poNext = (GDALRasterBlock *) poNewest;
+    poNext = psShard->poNewest;
 
-    if( poNewest != NULL )
+    if( psShard->poNewest != NULL )
     {
-        CPLAssert( poNewest->poPrevious == NULL );
-        poNewest->poPrevious = this;
+        CPLAssert( psShard->poNewest->poPrevious == NULL );
+        psShard->poNewest->poPrevious = this;
     }
-    poNewest = this;
+    psShard->poNewest = this;
     
-    if( poOldest == NULL )
+    if( psShard->poOldest == NULL )
     {
         CPLAssert( poPrevious == NULL && poNext == NULL );
-        poOldest = this;
+        psShard->poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -587,7 +746,6 @@ void GDALRasterBlock::Touch()
 CPLErr GDALRasterBlock::Internalize()
 
 {
-    CPLMutexHolderD( &hRBMutex );
     void        *pNewData;
     int         nSizeInBytes;
     GIntBig     nCurCacheMax = GDALGetCacheMax64();
@@ -611,17 +769,19 @@ CPLErr GDALRasterBlock::Internalize()
 
 /* -------------------------------------------------------------------- */
 /*      Flush old blocks if we are nearing our memory limit.            */
+/*      No shard mutex must be held while flushing, since writing a     */
+/*      dirty block may require locking other blocks.                  */
 /* -------------------------------------------------------------------- */
     AddLock(); /* don't flush this block! */
 
-    nCacheUsed += nSizeInBytes;
-    while( nCacheUsed > nCurCacheMax )
     {
-        GIntBig nOldCacheUsed = nCacheUsed;
-
-        GDALFlushCacheBlock();
+        CPLMutexHolderOptionalLockD( asShards[nShard].hMutex );
+        asShards[nShard].nCacheUsed += nSizeInBytes;
+    }
 
-        if( nCacheUsed == nOldCacheUsed )
+    while( GDALRBGetCacheUsed() > nCurCacheMax )
+    {
+        if( !GDALFlushCacheBlock() )
             break;
     }
 
@@ -677,20 +837,26 @@ void GDALRasterBlock::MarkClean()
  * \brief Safely lock block.
  *
  * This method locks a GDALRasterBlock (and touches it) in a thread-safe
- * manner.  The global block cache mutex is held while locking the block,
- * in order to avoid race conditions with other threads that might be
- * trying to expire the block at the same time.  The block pointer may be
+ * manner.  The mutex of the cache shard of the block is held while locking
+ * the block, in order to avoid race conditions with other threads that might
+ * be trying to expire the block at the same time.  The block pointer may be
  * safely NULL, in which case this method does nothing. 
  *
  * @param ppBlock Pointer to the block pointer to try and lock/touch.
+ * @param poBand the band owning the block.
+ * @param nXOff the horizontal block offset of the block.
+ * @param nYOff the vertical block offset of the block.
  */
  
-int GDALRasterBlock::SafeLockBlock( GDALRasterBlock ** ppBlock )
+int GDALRasterBlock::SafeLockBlock( GDALRasterBlock ** ppBlock,
+                                    GDALRasterBand *poBand,
+                                    int nXOff, int nYOff )
 
 {
     CPLAssert( NULL != ppBlock );
 
-    CPLMutexHolderD( &hRBMutex );
+    int iShard = GDALRBGetShard( poBand, nXOff, nYOff );
+    CPLMutexHolderOptionalLockD( asShards[iShard].hMutex );
 
     if( *ppBlock != NULL )
     {
@@ -709,6 +875,14 @@ int GDALRasterBlock::SafeLockBlock( GDALRasterBlock ** ppBlock )
 
 void GDALRasterBlock::DestroyRBMutex()
 {
+    for( int i = 0; i < nShardCount; i++ )
+    {
+        if( asShards[i].hMutex != NULL )
+            CPLDestroyMutex( asShards[i].hMutex );
+        asShards[i].hMutex = NULL;
+    }
+    nShardCount = 0;
+
     if( hRBMutex != NULL )
         CPLDestroyMutex(hRBMutex);
     hRBMutex = NULL;
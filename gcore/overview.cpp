@@ -29,6 +29,8 @@
  ****************************************************************************/
 
 #include "gdal_priv.h"
+#include "cpl_worker_thread_pool.h"
+#include <vector>
 
 CPL_CVSID("$Id$");
 
@@ -1796,6 +1798,578 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
 
 
 
+/************************************************************************/
+/* ==================================================================== */
+/*                          GDALOvrChunkBand                            */
+/* ==================================================================== */
+/************************************************************************/
+
+/*
+ * Stand-in for an overview band given to the downsampling functions when
+ * they run in a worker thread. It has the dimensions of the overview band,
+ * and records the writes done into it, so that they can be replayed later
+ * on the real overview band, from the thread that owns its dataset.
+ */
+
+class GDALOvrChunkBand : public GDALRasterBand
+{
+    typedef struct
+    {
+        int             nXOff;
+        int             nYOff;
+        int             nXSize;
+        int             nYSize;
+        int             nBufXSize;
+        int             nBufYSize;
+        GDALDataType    eBufType;
+        size_t          nOffset;
+    } RecordedWrite;
+
+    std::vector<RecordedWrite> asWrites;
+    std::vector<GByte>         abyData;
+
+  protected:
+    virtual CPLErr IReadBlock( int, int, void * );
+    virtual CPLErr IRasterIO( GDALRWFlag, int, int, int, int,
+                              void *, int, int, GDALDataType,
+                              int, int );
+
+  public:
+                   GDALOvrChunkBand( GDALRasterBand* poOverview );
+
+    CPLErr         ReplayWrites( GDALRasterBand* poOverview );
+    void           DiscardWrites();
+};
+
+/************************************************************************/
+/*                          GDALOvrChunkBand()                          */
+/************************************************************************/
+
+GDALOvrChunkBand::GDALOvrChunkBand( GDALRasterBand* poOverview )
+
+{
+    nRasterXSize = poOverview->GetXSize();
+    nRasterYSize = poOverview->GetYSize();
+    eDataType = poOverview->GetRasterDataType();
+    nBlockXSize = nRasterXSize;
+    nBlockYSize = 1;
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr GDALOvrChunkBand::IReadBlock( int, int, void * )
+
+{
+    CPLError( CE_Failure, CPLE_NotSupported,
+              "GDALOvrChunkBand::IReadBlock() not supported" );
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GDALOvrChunkBand::IRasterIO( GDALRWFlag eRWFlag,
+                                    int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    void * pData,
+                                    int nBufXSize, int nBufYSize,
+                                    GDALDataType eBufType,
+                                    int nPixelSpace, int nLineSpace )
+
+{
+    if( eRWFlag != GF_Write )
+    {
+        CPLError( CE_Failure, CPLE_NotSupported,
+                  "GDALOvrChunkBand::IRasterIO() only supports writing" );
+        return CE_Failure;
+    }
+
+    int nBufPixelSize = GDALGetDataTypeSize(eBufType) / 8;
+    size_t nBufLineSize = (size_t)nBufXSize * nBufPixelSize;
+
+    RecordedWrite sWrite;
+    sWrite.nXOff = nXOff;
+    sWrite.nYOff = nYOff;
+    sWrite.nXSize = nXSize;
+    sWrite.nYSize = nYSize;
+    sWrite.nBufXSize = nBufXSize;
+    sWrite.nBufYSize = nBufYSize;
+    sWrite.eBufType = eBufType;
+    sWrite.nOffset = abyData.size();
+    asWrites.push_back( sWrite );
+
+    abyData.resize( sWrite.nOffset + nBufLineSize * nBufYSize );
+    for( int iLine = 0; iLine < nBufYSize; iLine++ )
+    {
+        GDALCopyWords( ((GByte *) pData) + (size_t)iLine * nLineSpace,
+                       eBufType, nPixelSpace,
+                       &abyData[sWrite.nOffset + iLine * nBufLineSize],
+                       eBufType, nBufPixelSize, nBufXSize );
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                            ReplayWrites()                            */
+/*                                                                      */
+/*      Do the recorded writes, in the same order, into the overview    */
+/*      band, and forget them.                                          */
+/************************************************************************/
+
+CPLErr GDALOvrChunkBand::ReplayWrites( GDALRasterBand* poOverview )
+
+{
+    CPLErr eErr = CE_None;
+
+    for( size_t i = 0; i < asWrites.size() && eErr == CE_None; i++ )
+    {
+        const RecordedWrite& sWrite = asWrites[i];
+        eErr = poOverview->RasterIO( GF_Write,
+                                     sWrite.nXOff, sWrite.nYOff,
+                                     sWrite.nXSize, sWrite.nYSize,
+                                     &abyData[sWrite.nOffset],
+                                     sWrite.nBufXSize, sWrite.nBufYSize,
+                                     sWrite.eBufType, 0, 0 );
+    }
+
+    DiscardWrites();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                           DiscardWrites()                            */
+/************************************************************************/
+
+void GDALOvrChunkBand::DiscardWrites()
+
+{
+    asWrites.resize( 0 );
+    abyData.resize( 0 );
+}
+
+/************************************************************************/
+/*                         GDALOvrReadChunk()                           */
+/*                                                                      */
+/*      Read a chunk of all the bands of the source of an overview      */
+/*      level, and the mask of the first band if pabyChunkNoDataMask   */
+/*      is not NULL.                                                    */
+/************************************************************************/
+
+static CPLErr GDALOvrReadChunk( int nBands, GDALRasterBand** papoSrcBands,
+                                GDALRasterBand*** papapoOverviewBands,
+                                int iSrcOverview,
+                                int nChunkXOff, int nChunkYOff,
+                                int nXCount, int nYCount,
+                                GDALDataType eWrkDataType,
+                                void** papaChunk,
+                                GByte* pabyChunkNoDataMask )
+
+{
+    CPLErr eErr = CE_None;
+    int    iBand;
+
+    /* Read the source buffers for all the bands */
+    for(iBand=0;iBand<nBands && eErr == CE_None;iBand++)
+    {
+        GDALRasterBand* poSrcBand;
+        if (iSrcOverview == -1)
+            poSrcBand = papoSrcBands[iBand];
+        else
+            poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
+        eErr = poSrcBand->RasterIO( GF_Read,
+                                    nChunkXOff, nChunkYOff,
+                                    nXCount, nYCount, 
+                                    papaChunk[iBand],
+                                    nXCount, nYCount,
+                                    eWrkDataType, 0, 0 );
+    }
+
+    if (pabyChunkNoDataMask != NULL && eErr == CE_None)
+    {
+        GDALRasterBand* poSrcBand;
+        if (iSrcOverview == -1)
+            poSrcBand = papoSrcBands[0];
+        else
+            poSrcBand = papapoOverviewBands[0][iSrcOverview];
+        eErr = poSrcBand->GetMaskBand()->RasterIO( GF_Read,
+                                                   nChunkXOff, nChunkYOff,
+                                                   nXCount, nYCount, 
+                                                   pabyChunkNoDataMask,
+                                                   nXCount, nYCount,
+                                                   GDT_Byte, 0, 0 );
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                       Multi-threaded downsampling                    */
+/************************************************************************/
+
+typedef struct
+{
+    int                     nBands;
+    int                     nSrcWidth;
+    int                     nSrcHeight;
+    GDALDataType            eWrkDataType;
+    GDALDataType            eSrcDataType;
+    GDALDownsampleFunction  pfnDownsampleFn;
+    const char             *pszResampling;
+    const int              *pabHasNoData;
+    const float            *pafNoDataValue;
+
+    void                   *hMutex;
+    void                   *hCond;
+} GDALOvrChunkContext;
+
+typedef struct
+{
+    const GDALOvrChunkContext *psCtxt;
+
+    int                     nChunkXOff;
+    int                     nChunkYOff;
+    int                     nXCount;
+    int                     nYCount;
+    void                  **papaChunk;
+    GByte                  *pabyChunkNoDataMask;
+    GDALOvrChunkBand      **papoChunkBands;
+
+    /* Protected by psCtxt->hMutex once the job is submitted */
+    int                     bDone;
+    CPLErr                  eErr;
+    int                     nErrorNo;
+    CPLString               osErrorMsg;
+} GDALOvrChunkJob;
+
+/************************************************************************/
+/*                      GDALOvrDownsampleChunkJob()                     */
+/************************************************************************/
+
+static void GDALOvrDownsampleChunkJob( void* pData )
+
+{
+    GDALOvrChunkJob           *psJob = (GDALOvrChunkJob *) pData;
+    const GDALOvrChunkContext *psCtxt = psJob->psCtxt;
+    CPLErr                     eErr = CE_None;
+    int                        nErrorNo = CPLE_None;
+    CPLString                  osErrorMsg;
+
+/* -------------------------------------------------------------------- */
+/*      Errors are reported by the thread that writes the chunk.        */
+/* -------------------------------------------------------------------- */
+    CPLPushErrorHandler( CPLQuietErrorHandler );
+    CPLErrorReset();
+
+    for( int iBand = 0; iBand < psCtxt->nBands && eErr == CE_None; iBand++ )
+    {
+        eErr = psCtxt->pfnDownsampleFn( psCtxt->nSrcWidth, psCtxt->nSrcHeight,
+                                        psCtxt->eWrkDataType,
+                                        psJob->papaChunk[iBand],
+                                        psJob->pabyChunkNoDataMask,
+                                        psJob->nChunkXOff, psJob->nXCount,
+                                        psJob->nChunkYOff, psJob->nYCount,
+                                        psJob->papoChunkBands[iBand],
+                                        psCtxt->pszResampling,
+                                        psCtxt->pabHasNoData[iBand],
+                                        psCtxt->pafNoDataValue[iBand],
+                                        /*poColorTable*/ NULL,
+                                        psCtxt->eSrcDataType );
+    }
+
+    if( eErr != CE_None )
+    {
+        nErrorNo = CPLGetLastErrorNo();
+        osErrorMsg = CPLGetLastErrorMsg();
+    }
+    CPLPopErrorHandler();
+
+    CPLAcquireMutex( psCtxt->hMutex, 1000.0 );
+    psJob->eErr = eErr;
+    psJob->nErrorNo = nErrorNo;
+    psJob->osErrorMsg = osErrorMsg;
+    psJob->bDone = TRUE;
+    CPLCondBroadcast( psCtxt->hCond );
+    CPLReleaseMutex( psCtxt->hMutex );
+}
+
+/************************************************************************/
+/*                        GDALOvrCreateChunkJob()                       */
+/************************************************************************/
+
+static GDALOvrChunkJob* GDALOvrCreateChunkJob( const GDALOvrChunkContext* psCtxt,
+                                               GDALRasterBand** papoOvrBands,
+                                               int nFullResXChunk,
+                                               int nFullResYChunk,
+                                               int bUseNoDataMask )
+
+{
+    int nBands = psCtxt->nBands;
+    int bOK = TRUE;
+
+    GDALOvrChunkJob* psJob = new GDALOvrChunkJob;
+    psJob->psCtxt = psCtxt;
+    psJob->papaChunk = (void**) CPLCalloc(nBands, sizeof(void*));
+    psJob->pabyChunkNoDataMask = NULL;
+    psJob->papoChunkBands = (GDALOvrChunkBand**)
+        CPLMalloc(nBands * sizeof(GDALOvrChunkBand*));
+    psJob->bDone = TRUE;
+    psJob->eErr = CE_None;
+    psJob->nErrorNo = CPLE_None;
+
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        psJob->papoChunkBands[iBand] =
+            new GDALOvrChunkBand( papoOvrBands[iBand] );
+        psJob->papaChunk[iBand] =
+            VSIMalloc3(nFullResXChunk, nFullResYChunk,
+                       GDALGetDataTypeSize(psCtxt->eWrkDataType) / 8);
+        if( psJob->papaChunk[iBand] == NULL )
+            bOK = FALSE;
+    }
+    if( bUseNoDataMask )
+    {
+        psJob->pabyChunkNoDataMask =
+            (GByte*) VSIMalloc2(nFullResXChunk, nFullResYChunk);
+        if( psJob->pabyChunkNoDataMask == NULL )
+            bOK = FALSE;
+    }
+
+    if( !bOK )
+    {
+        for( int iBand = 0; iBand < nBands; iBand++ )
+        {
+            CPLFree(psJob->papaChunk[iBand]);
+            delete psJob->papoChunkBands[iBand];
+        }
+        CPLFree(psJob->papaChunk);
+        CPLFree(psJob->papoChunkBands);
+        CPLFree(psJob->pabyChunkNoDataMask);
+        delete psJob;
+
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "GDALRegenerateOverviewsMultiBand: Out of memory." );
+        return NULL;
+    }
+
+    return psJob;
+}
+
+/************************************************************************/
+/*                        GDALOvrFreeChunkJob()                         */
+/************************************************************************/
+
+static void GDALOvrFreeChunkJob( GDALOvrChunkJob* psJob )
+
+{
+    for( int iBand = 0; iBand < psJob->psCtxt->nBands; iBand++ )
+    {
+        CPLFree(psJob->papaChunk[iBand]);
+        delete psJob->papoChunkBands[iBand];
+    }
+    CPLFree(psJob->papaChunk);
+    CPLFree(psJob->papoChunkBands);
+    CPLFree(psJob->pabyChunkNoDataMask);
+    delete psJob;
+}
+
+/************************************************************************/
+/*                        GDALOvrWriteChunkJob()                        */
+/*                                                                      */
+/*      Wait for the job to be completed, and write its result into     */
+/*      the overview bands. If bWrite is FALSE, the result is only      */
+/*      discarded.                                                      */
+/************************************************************************/
+
+static CPLErr GDALOvrWriteChunkJob( GDALOvrChunkJob* psJob, int bWrite,
+                                    GDALRasterBand** papoOvrBands )
+
+{
+    const GDALOvrChunkContext *psCtxt = psJob->psCtxt;
+    CPLErr eErr = CE_None;
+    int    iBand;
+
+    CPLAcquireMutex( psCtxt->hMutex, 1000.0 );
+    while( !psJob->bDone )
+        CPLCondWait( psCtxt->hCond, psCtxt->hMutex );
+    CPLReleaseMutex( psCtxt->hMutex );
+
+    if( bWrite && psJob->eErr != CE_None )
+    {
+        CPLError( psJob->eErr, psJob->nErrorNo, "%s",
+                  psJob->osErrorMsg.c_str() );
+        eErr = psJob->eErr;
+    }
+
+    for( iBand = 0; iBand < psCtxt->nBands; iBand++ )
+    {
+        if( bWrite && eErr == CE_None )
+            eErr = psJob->papoChunkBands[iBand]->ReplayWrites(
+                                                        papoOvrBands[iBand] );
+        else
+            psJob->papoChunkBands[iBand]->DiscardWrites();
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                     GDALRegenerateOverviewLevelMT()                  */
+/*                                                                      */
+/*      Compute an overview level with several threads. The source      */
+/*      chunks are read, and the overview is written, in the same       */
+/*      order as in the single threaded case, by the calling thread,    */
+/*      while up to 2 * nThreads chunks are downsampled in the          */
+/*      worker threads.                                                 */
+/************************************************************************/
+
+static CPLErr
+GDALRegenerateOverviewLevelMT( int nThreads,
+                               const GDALOvrChunkContext* psCtxt,
+                               GDALRasterBand** papoSrcBands,
+                               GDALRasterBand*** papapoOverviewBands,
+                               int iSrcOverview, int iOverview,
+                               int nFullResXChunk, int nFullResYChunk,
+                               int bUseNoDataMask,
+                               double* pdfCurPixelCount,
+                               double dfTotalPixelCount,
+                               GDALProgressFunc pfnProgress,
+                               void * pProgressData )
+
+{
+    CPLErr eErr = CE_None;
+    int    nBands = psCtxt->nBands;
+    int    nSrcWidth = psCtxt->nSrcWidth;
+    int    nSrcHeight = psCtxt->nSrcHeight;
+    int    nSlots = 2 * nThreads;
+    int    iBand;
+
+    std::vector<GDALRasterBand*> apoOvrBands;
+    for( iBand = 0; iBand < nBands; iBand++ )
+        apoOvrBands.push_back( papapoOverviewBands[iBand][iOverview] );
+
+    std::vector<GDALOvrChunkJob*> apsJobs;
+    CPLJobGroup* psJobGroup = CPLCreateJobGroup();
+    GIntBig nJobsSubmitted = 0;
+    GIntBig nJobsWritten = 0;
+
+    int nChunkYOff;
+    for( nChunkYOff = 0; nChunkYOff < nSrcHeight && eErr == CE_None; nChunkYOff += nFullResYChunk )
+    {
+        int nYCount;
+        if  (nChunkYOff + nFullResYChunk <= nSrcHeight)
+            nYCount = nFullResYChunk;
+        else
+            nYCount = nSrcHeight - nChunkYOff;
+
+        int nChunkXOff;
+        for( nChunkXOff = 0; nChunkXOff < nSrcWidth && eErr == CE_None; nChunkXOff += nFullResXChunk )
+        {
+            int nXCount;
+            if  (nChunkXOff + nFullResXChunk <= nSrcWidth)
+                nXCount = nFullResXChunk;
+            else
+                nXCount = nSrcWidth - nChunkXOff;
+
+/* -------------------------------------------------------------------- */
+/*      Write the oldest chunk if all the slots are in use.             */
+/* -------------------------------------------------------------------- */
+            GDALOvrChunkJob* psJob;
+            if( nJobsSubmitted - nJobsWritten == nSlots )
+            {
+                psJob = apsJobs[(int)(nJobsWritten % nSlots)];
+                eErr = GDALOvrWriteChunkJob( psJob, TRUE, &apoOvrBands[0] );
+                nJobsWritten ++;
+
+                *pdfCurPixelCount += (double)psJob->nXCount * psJob->nYCount;
+                if( eErr == CE_None &&
+                    !pfnProgress( *pdfCurPixelCount / dfTotalPixelCount,
+                                  NULL, pProgressData ) )
+                {
+                    CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                    eErr = CE_Failure;
+                }
+                if( eErr != CE_None )
+                    break;
+            }
+            else
+            {
+                psJob = GDALOvrCreateChunkJob( psCtxt, &apoOvrBands[0],
+                                               nFullResXChunk, nFullResYChunk,
+                                               bUseNoDataMask );
+                if( psJob == NULL )
+                {
+                    eErr = CE_Failure;
+                    break;
+                }
+                apsJobs.push_back( psJob );
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Read the source chunk, and submit its downsampling.             */
+/* -------------------------------------------------------------------- */
+            eErr = GDALOvrReadChunk( nBands, papoSrcBands,
+                                     papapoOverviewBands, iSrcOverview,
+                                     nChunkXOff, nChunkYOff,
+                                     nXCount, nYCount,
+                                     psCtxt->eWrkDataType,
+                                     psJob->papaChunk,
+                                     psJob->pabyChunkNoDataMask );
+            if( eErr != CE_None )
+                break;
+
+            psJob->nChunkXOff = nChunkXOff;
+            psJob->nChunkYOff = nChunkYOff;
+            psJob->nXCount = nXCount;
+            psJob->nYCount = nYCount;
+            psJob->bDone = FALSE;
+            nJobsSubmitted ++;
+
+            /* If the job cannot be queued, it is run in this thread */
+            CPLSubmitJob( psJobGroup, GDALOvrDownsampleChunkJob, psJob );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write the remaining chunks, or only wait for them on failure.   */
+/* -------------------------------------------------------------------- */
+    while( nJobsWritten < nJobsSubmitted )
+    {
+        GDALOvrChunkJob* psJob = apsJobs[(int)(nJobsWritten % nSlots)];
+        CPLErr eErrWrite = GDALOvrWriteChunkJob( psJob, eErr == CE_None,
+                                                 &apoOvrBands[0] );
+        nJobsWritten ++;
+        if( eErr != CE_None )
+            continue;
+        eErr = eErrWrite;
+
+        *pdfCurPixelCount += (double)psJob->nXCount * psJob->nYCount;
+        if( eErr == CE_None &&
+            !pfnProgress( *pdfCurPixelCount / dfTotalPixelCount,
+                          NULL, pProgressData ) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    CPLWaitJobGroup( psJobGroup );
+    CPLDestroyJobGroup( psJobGroup );
+
+    for( size_t i = 0; i < apsJobs.size(); i++ )
+        GDALOvrFreeChunkJob( apsJobs[i] );
+
+    /* Flush the data to overviews */
+    for( iBand = 0; iBand < nBands; iBand++ )
+        apoOvrBands[iBand]->FlushCache();
+
+    return eErr;
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -1823,6 +2397,12 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
  *               read the source data of size deltax * deltay for all the bands
  *               generate the corresponding overview block for all the bands
  *
+ * Starting with GDAL 2.0, the overview blocks can be generated by several
+ * threads, by setting the GDAL_NUM_THREADS configuration option to the
+ * number of threads, or ALL_CPUS. The source data is still read, and the
+ * overviews written, by the calling thread, in the same order, so the result
+ * is identical to the single threaded case.
+ *
  * This function will honour properly NODATA_VALUES tuples (special dataset metadata) so
  * that only a given RGB triplet (in case of a RGB image) will be considered as the
  * nodata value and not each value of the triplet independantly per band.
@@ -1947,6 +2527,32 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
         pafNoDataValue[iBand] = (float) papoSrcBands[iBand]->GetNoDataValue(&pabHasNoData[iBand]);
     }
 
+/* -------------------------------------------------------------------- */
+/*      With several threads, the chunks are downsampled by the worker  */
+/*      threads. This is not done from a worker thread, whose own       */
+/*      queue would hold the jobs it waits for.                         */
+/* -------------------------------------------------------------------- */
+    int nThreads = CPLGetNumThreadsOption( NULL );
+    void* hMutex = NULL;
+    void* hCond = NULL;
+    if( nThreads > 1 && CPLIsWorkerThread() )
+        nThreads = 1;
+    if( nThreads > 1 )
+    {
+        hCond = CPLCreateCond();
+        if( hCond == NULL )
+        {
+            CPLDebug( "GDAL", "Cannot create condition variable. "
+                      "Computing overviews in a single thread" );
+            nThreads = 1;
+        }
+        else
+        {
+            hMutex = CPLCreateMutex();
+            CPLReleaseMutex( hMutex );
+        }
+    }
+
     /* Second pass to do the real job ! */
     double dfCurPixelCount = 0;
     for(iOverview=0;iOverview<nOverviews && eErr == CE_None;iOverview++)
@@ -1973,6 +2579,33 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
         int nFullResXChunk = (nDstBlockXSize * nSrcWidth) / nDstWidth;
         int nFullResYChunk = (nDstBlockYSize * nSrcHeight) / nDstHeight;
 
+        if( nThreads > 1 )
+        {
+            GDALOvrChunkContext sCtxt;
+            sCtxt.nBands = nBands;
+            sCtxt.nSrcWidth = nSrcWidth;
+            sCtxt.nSrcHeight = nSrcHeight;
+            sCtxt.eWrkDataType = eWrkDataType;
+            sCtxt.eSrcDataType = eDataType;
+            sCtxt.pfnDownsampleFn = pfnDownsampleFn;
+            sCtxt.pszResampling = pszResampling;
+            sCtxt.pabHasNoData = pabHasNoData;
+            sCtxt.pafNoDataValue = pafNoDataValue;
+            sCtxt.hMutex = hMutex;
+            sCtxt.hCond = hCond;
+
+            eErr = GDALRegenerateOverviewLevelMT( nThreads, &sCtxt,
+                                                  papoSrcBands,
+                                                  papapoOverviewBands,
+                                                  iSrcOverview, iOverview,
+                                                  nFullResXChunk, nFullResYChunk,
+                                                  bUseNoDataMask,
+                                                  &dfCurPixelCount,
+                                                  dfTotalPixelCount,
+                                                  pfnProgress, pProgressData );
+            continue;
+        }
+
         void** papaChunk = (void**) CPLMalloc(nBands * sizeof(void*));
         GByte* pabyChunkNoDataMask = NULL;
         for(iBand=0;iBand<nBands;iBand++)
@@ -2036,36 +2669,11 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
                 else
                     nXCount = nSrcWidth - nChunkXOff;
 
-                /* Read the source buffers for all the bands */
-                for(iBand=0;iBand<nBands && eErr == CE_None;iBand++)
-                {
-                    GDALRasterBand* poSrcBand;
-                    if (iSrcOverview == -1)
-                        poSrcBand = papoSrcBands[iBand];
-                    else
-                        poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
-                    eErr = poSrcBand->RasterIO( GF_Read,
-                                                nChunkXOff, nChunkYOff,
-                                                nXCount, nYCount, 
-                                                papaChunk[iBand],
-                                                nXCount, nYCount,
-                                                eWrkDataType, 0, 0 );
-                }
-
-                if (bUseNoDataMask && eErr == CE_None)
-                {
-                    GDALRasterBand* poSrcBand;
-                    if (iSrcOverview == -1)
-                        poSrcBand = papoSrcBands[0];
-                    else
-                        poSrcBand = papapoOverviewBands[0][iSrcOverview];
-                    eErr = poSrcBand->GetMaskBand()->RasterIO( GF_Read,
-                                                               nChunkXOff, nChunkYOff,
-                                                               nXCount, nYCount, 
-                                                               pabyChunkNoDataMask,
-                                                               nXCount, nYCount,
-                                                               GDT_Byte, 0, 0 );
-                }
+                eErr = GDALOvrReadChunk( nBands, papoSrcBands,
+                                         papapoOverviewBands, iSrcOverview,
+                                         nChunkXOff, nChunkYOff,
+                                         nXCount, nYCount, eWrkDataType,
+                                         papaChunk, pabyChunkNoDataMask );
 
                 /* Compute the resulting overview block */
                 for(iBand=0;iBand<nBands && eErr == CE_None;iBand++)
@@ -2101,6 +2709,10 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
 
     CPLFree(pabHasNoData);
     CPLFree(pafNoDataValue);
+    if( hCond != NULL )
+        CPLDestroyCond( hCond );
+    if( hMutex != NULL )
+        CPLDestroyMutex( hMutex );
 
     if (eErr == CE_None)
         pfnProgress( 1.0, NULL, pProgressData );
@@ -30,6 +30,7 @@
  ****************************************************************************/
 
 #include "gdal_priv.h"
+#include <algorithm>
 
 // Define a list of "C++" compilers that have broken template support or
 // broken scoping so we can fall back on the legacy implementation of
@@ -42,6 +43,14 @@
 #include <stdexcept>
 #include <limits>
 
+// SSE2 is always available on x86_64, and on x86 when the compiler is
+// allowed to use it, so there is no need for a runtime check.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_SSE2_COPYWORDS 1
+#include <emmintrin.h>
+#endif
+
 // For now, work around MSVC++ 6.0's broken template support. If this value
 // is not defined, the old GDALCopyWords implementation is used.
 #define USE_NEW_COPYWORDS 1
@@ -833,6 +842,284 @@ inline void CopyWord(const float fValueIn, unsigned int &nValueOut)
     }
 }
 
+#ifdef HAVE_SSE2_COPYWORDS
+
+/************************************************************************/
+/*                    GDALCopyWordsContiguousSSE2()                     */
+/************************************************************************/
+/**
+ * SSE2 implementations of the most common conversions between packed
+ * buffers. They must give the same results as CopyWord(), which is used
+ * for the remaining words that do not fill a whole SSE2 register.
+ *
+ * The generic template returns false for the pairs of types that have
+ * no SSE2 implementation, so that GDALCopyWordsT() uses its scalar loop.
+ *
+ * @param pSrcData the packed source buffer
+ * @param pDstData the packed destination buffer
+ * @param nWordCount the total number of pixel words to copy
+ * @return true if the words have been copied
+ */
+
+template <class Tin, class Tout>
+inline bool GDALCopyWordsContiguousSSE2(const Tin* const, Tout* const, int)
+{
+    return false;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const unsigned char* const pSrcData,
+                                        unsigned short* const pDstData,
+                                        int nWordCount)
+{
+    const __m128i xmm_zero = _mm_setzero_si128();
+    int n = 0;
+    for( ; n < nWordCount - 15; n += 16 )
+    {
+        __m128i xmm = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+                         _mm_unpacklo_epi8(xmm, xmm_zero));
+        _mm_storeu_si128((__m128i*) (pDstData + n + 8),
+                         _mm_unpackhi_epi8(xmm, xmm_zero));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const unsigned char* const pSrcData,
+                                        short* const pDstData,
+                                        int nWordCount)
+{
+    /* Byte values are the same as their UInt16 and Int16 representations */
+    return GDALCopyWordsContiguousSSE2(pSrcData,
+                                       reinterpret_cast<unsigned short*>(pDstData),
+                                       nWordCount);
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const unsigned char* const pSrcData,
+                                        float* const pDstData,
+                                        int nWordCount)
+{
+    const __m128i xmm_zero = _mm_setzero_si128();
+    int n = 0;
+    for( ; n < nWordCount - 15; n += 16 )
+    {
+        __m128i xmm = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        __m128i xmm_lo = _mm_unpacklo_epi8(xmm, xmm_zero);
+        __m128i xmm_hi = _mm_unpackhi_epi8(xmm, xmm_zero);
+        _mm_storeu_ps(pDstData + n,
+                _mm_cvtepi32_ps(_mm_unpacklo_epi16(xmm_lo, xmm_zero)));
+        _mm_storeu_ps(pDstData + n + 4,
+                _mm_cvtepi32_ps(_mm_unpackhi_epi16(xmm_lo, xmm_zero)));
+        _mm_storeu_ps(pDstData + n + 8,
+                _mm_cvtepi32_ps(_mm_unpacklo_epi16(xmm_hi, xmm_zero)));
+        _mm_storeu_ps(pDstData + n + 12,
+                _mm_cvtepi32_ps(_mm_unpackhi_epi16(xmm_hi, xmm_zero)));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const unsigned short* const pSrcData,
+                                        unsigned char* const pDstData,
+                                        int nWordCount)
+{
+    const __m128i xmm_255 = _mm_set1_epi16(255);
+    int n = 0;
+    for( ; n < nWordCount - 15; n += 16 )
+    {
+        __m128i xmm0 = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        __m128i xmm1 = _mm_loadu_si128((const __m128i*) (pSrcData + n + 8));
+        /* min(x, 255) for unsigned values, since _mm_packus_epi16() */
+        /* considers its inputs as signed */
+        xmm0 = _mm_sub_epi16(xmm0, _mm_subs_epu16(xmm0, xmm_255));
+        xmm1 = _mm_sub_epi16(xmm1, _mm_subs_epu16(xmm1, xmm_255));
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+                         _mm_packus_epi16(xmm0, xmm1));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const short* const pSrcData,
+                                        unsigned char* const pDstData,
+                                        int nWordCount)
+{
+    int n = 0;
+    for( ; n < nWordCount - 15; n += 16 )
+    {
+        __m128i xmm0 = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        __m128i xmm1 = _mm_loadu_si128((const __m128i*) (pSrcData + n + 8));
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+                         _mm_packus_epi16(xmm0, xmm1));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const unsigned short* const pSrcData,
+                                        float* const pDstData,
+                                        int nWordCount)
+{
+    const __m128i xmm_zero = _mm_setzero_si128();
+    int n = 0;
+    for( ; n < nWordCount - 7; n += 8 )
+    {
+        __m128i xmm = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        _mm_storeu_ps(pDstData + n,
+                      _mm_cvtepi32_ps(_mm_unpacklo_epi16(xmm, xmm_zero)));
+        _mm_storeu_ps(pDstData + n + 4,
+                      _mm_cvtepi32_ps(_mm_unpackhi_epi16(xmm, xmm_zero)));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const short* const pSrcData,
+                                        float* const pDstData,
+                                        int nWordCount)
+{
+    int n = 0;
+    for( ; n < nWordCount - 7; n += 8 )
+    {
+        __m128i xmm = _mm_loadu_si128((const __m128i*) (pSrcData + n));
+        /* Sign extension to 32 bit */
+        __m128i xmm_lo = _mm_srai_epi32(_mm_unpacklo_epi16(xmm, xmm), 16);
+        __m128i xmm_hi = _mm_srai_epi32(_mm_unpackhi_epi16(xmm, xmm), 16);
+        _mm_storeu_ps(pDstData + n, _mm_cvtepi32_ps(xmm_lo));
+        _mm_storeu_ps(pDstData + n + 4, _mm_cvtepi32_ps(xmm_hi));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const float* const pSrcData,
+                                        unsigned char* const pDstData,
+                                        int nWordCount)
+{
+    const __m128 xmm_half = _mm_set1_ps(0.5f);
+    const __m128 xmm_min = _mm_setzero_ps();
+    const __m128 xmm_max = _mm_set1_ps(255.0f);
+    int n = 0;
+    for( ; n < nWordCount - 15; n += 16 )
+    {
+        __m128i axmm[4];
+        for( int i = 0; i < 4; i++ )
+        {
+            __m128 xmm = _mm_loadu_ps(pSrcData + n + 4 * i);
+            xmm = _mm_add_ps(xmm, xmm_half);
+            xmm = _mm_min_ps(_mm_max_ps(xmm, xmm_min), xmm_max);
+            axmm[i] = _mm_cvttps_epi32(xmm);
+        }
+        __m128i xmm_lo = _mm_packs_epi32(axmm[0], axmm[1]);
+        __m128i xmm_hi = _mm_packs_epi32(axmm[2], axmm[3]);
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+                         _mm_packus_epi16(xmm_lo, xmm_hi));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const float* const pSrcData,
+                                        unsigned short* const pDstData,
+                                        int nWordCount)
+{
+    const __m128 xmm_half = _mm_set1_ps(0.5f);
+    const __m128 xmm_min = _mm_setzero_ps();
+    const __m128 xmm_max = _mm_set1_ps(65535.0f);
+    const __m128i xmm_32768 = _mm_set1_epi32(32768);
+    const __m128i xmm_sign16 = _mm_set1_epi16((short) 0x8000);
+    int n = 0;
+    for( ; n < nWordCount - 7; n += 8 )
+    {
+        __m128 xmm0 = _mm_add_ps(_mm_loadu_ps(pSrcData + n), xmm_half);
+        __m128 xmm1 = _mm_add_ps(_mm_loadu_ps(pSrcData + n + 4), xmm_half);
+        xmm0 = _mm_min_ps(_mm_max_ps(xmm0, xmm_min), xmm_max);
+        xmm1 = _mm_min_ps(_mm_max_ps(xmm1, xmm_min), xmm_max);
+        /* There is no unsigned saturated packing of 32 bit values in */
+        /* SSE2, so shift the values to the Int16 range, and back */
+        __m128i xmm_lo = _mm_sub_epi32(_mm_cvttps_epi32(xmm0), xmm_32768);
+        __m128i xmm_hi = _mm_sub_epi32(_mm_cvttps_epi32(xmm1), xmm_32768);
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+            _mm_xor_si128(_mm_packs_epi32(xmm_lo, xmm_hi), xmm_sign16));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const float* const pSrcData,
+                                        short* const pDstData,
+                                        int nWordCount)
+{
+    const __m128 xmm_zero = _mm_setzero_ps();
+    const __m128 xmm_half = _mm_set1_ps(0.5f);
+    const __m128 xmm_minus_half = _mm_set1_ps(-0.5f);
+    const __m128 xmm_min = _mm_set1_ps(-32768.0f);
+    const __m128 xmm_max = _mm_set1_ps(32767.0f);
+    int n = 0;
+    for( ; n < nWordCount - 7; n += 8 )
+    {
+        __m128i axmm[2];
+        for( int i = 0; i < 2; i++ )
+        {
+            __m128 xmm = _mm_loadu_ps(pSrcData + n + 4 * i);
+            /* Round half away from zero, as CopyWord() does */
+            __m128 xmm_mask = _mm_cmpge_ps(xmm, xmm_zero);
+            __m128 xmm_round = _mm_or_ps(_mm_and_ps(xmm_mask, xmm_half),
+                                    _mm_andnot_ps(xmm_mask, xmm_minus_half));
+            xmm = _mm_add_ps(xmm, xmm_round);
+            xmm = _mm_min_ps(_mm_max_ps(xmm, xmm_min), xmm_max);
+            axmm[i] = _mm_cvttps_epi32(xmm);
+        }
+        _mm_storeu_si128((__m128i*) (pDstData + n),
+                         _mm_packs_epi32(axmm[0], axmm[1]));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const float* const pSrcData,
+                                        double* const pDstData,
+                                        int nWordCount)
+{
+    int n = 0;
+    for( ; n < nWordCount - 3; n += 4 )
+    {
+        __m128 xmm = _mm_loadu_ps(pSrcData + n);
+        _mm_storeu_pd(pDstData + n, _mm_cvtps_pd(xmm));
+        _mm_storeu_pd(pDstData + n + 2, _mm_cvtps_pd(_mm_movehl_ps(xmm, xmm)));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+inline bool GDALCopyWordsContiguousSSE2(const double* const pSrcData,
+                                        float* const pDstData,
+                                        int nWordCount)
+{
+    int n = 0;
+    for( ; n < nWordCount - 3; n += 4 )
+    {
+        __m128 xmm_lo = _mm_cvtpd_ps(_mm_loadu_pd(pSrcData + n));
+        __m128 xmm_hi = _mm_cvtpd_ps(_mm_loadu_pd(pSrcData + n + 2));
+        _mm_storeu_ps(pDstData + n, _mm_movelh_ps(xmm_lo, xmm_hi));
+    }
+    for( ; n < nWordCount; n++ )
+        CopyWord(pSrcData[n], pDstData[n]);
+    return true;
+}
+
+#endif /* HAVE_SSE2_COPYWORDS */
+
 /************************************************************************/
 /*                           GDALCopyWordsT()                           */
 /************************************************************************/
@@ -867,6 +1154,15 @@ static void GDALCopyWordsT(const Tin* const pSrcData, int nSrcPixelStride,
                            Tout* const pDstData, int nDstPixelStride,
                            int nWordCount)
 {
+#ifdef HAVE_SSE2_COPYWORDS
+    if (nSrcPixelStride == static_cast<int>(sizeof(Tin)) &&
+        nDstPixelStride == static_cast<int>(sizeof(Tout)) &&
+        GDALCopyWordsContiguousSSE2(pSrcData, pDstData, nWordCount))
+    {
+        return;
+    }
+#endif
+
     std::ptrdiff_t nDstOffset = 0;
 
     const char* const pSrcDataPtr = reinterpret_cast<const char*>(pSrcData);
@@ -2249,6 +2545,647 @@ CPLErr GDALRasterBand::OverviewRasterIO( GDALRWFlag eRWFlag,
                                      nPixelSpace, nLineSpace );
 }
 
+/************************************************************************/
+/*                     GDALRasterIOGetResampleAlg()                     */
+/************************************************************************/
+
+/**
+ * Return the RasterIO() resampling method matching a name, as used by
+ * the -r switch of utilities ("NEAR", "BILINEAR", "CUBIC", "CUBICSPLINE",
+ * "LANCZOS", "AVERAGE" or "MODE").
+ */
+
+GDALRIOResampleAlg GDALRasterIOGetResampleAlg(const char* pszResampling)
+{
+    GDALRIOResampleAlg eResampleAlg = GRIORA_NearestNeighbour;
+    if( EQUALN(pszResampling, "NEAR", 4) )
+        eResampleAlg = GRIORA_NearestNeighbour;
+    else if( EQUAL(pszResampling, "BILINEAR") )
+        eResampleAlg = GRIORA_Bilinear;
+    else if( EQUAL(pszResampling, "CUBIC") )
+        eResampleAlg = GRIORA_Cubic;
+    else if( EQUAL(pszResampling, "CUBICSPLINE") )
+        eResampleAlg = GRIORA_CubicSpline;
+    else if( EQUAL(pszResampling, "LANCZOS") )
+        eResampleAlg = GRIORA_Lanczos;
+    else if( EQUAL(pszResampling, "AVERAGE") )
+        eResampleAlg = GRIORA_Average;
+    else if( EQUAL(pszResampling, "MODE") )
+        eResampleAlg = GRIORA_Mode;
+    else
+    {
+        CPLError( CE_Warning, CPLE_NotSupported,
+                  "GDALRasterIOGetResampleAlg: Unsupported resampling method: %s. "
+                  "Using nearest neighbour.", pszResampling );
+    }
+    return eResampleAlg;
+}
+
+/************************************************************************/
+/*                       Resampling kernels                             */
+/*                                                                      */
+/*      x is the distance between a source pixel center and the         */
+/*      sampled position, in source pixels (or destination pixels       */
+/*      when downsampling, where the kernel is stretched).              */
+/************************************************************************/
+
+static double GDALRIOKernelBilinear( double x )
+{
+    x = fabs(x);
+    return ( x < 1.0 ) ? 1.0 - x : 0.0;
+}
+
+static double GDALRIOKernelCubic( double x )
+{
+    /* Cubic convolution, a = -0.5 */
+    const double a = -0.5;
+    x = fabs(x);
+    if( x < 1.0 )
+        return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+    if( x < 2.0 )
+        return ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+    return 0.0;
+}
+
+static double GDALRIOKernelCubicSpline( double x )
+{
+    x = fabs(x);
+    if( x < 1.0 )
+        return (4.0 + x * x * (3.0 * x - 6.0)) / 6.0;
+    if( x < 2.0 )
+        return (2.0 - x) * (2.0 - x) * (2.0 - x) / 6.0;
+    return 0.0;
+}
+
+static double GDALRIOKernelLanczos( double x )
+{
+    if( x == 0.0 )
+        return 1.0;
+    if( fabs(x) >= 3.0 )
+        return 0.0;
+    const double dfPIX = M_PI * x;
+    return 3.0 * sin(dfPIX) * sin(dfPIX / 3.0) / (dfPIX * dfPIX);
+}
+
+/************************************************************************/
+/*                           GDALRIOWeights                             */
+/*                                                                      */
+/*      Contributions of the source pixels to the destination pixels    */
+/*      along one axis. As the kernels are separable, the weight of a   */
+/*      source pixel for a destination pixel is the product of its      */
+/*      weights along both axis.                                        */
+/************************************************************************/
+
+typedef struct
+{
+    int     nSrcMin;      /* first source pixel needed, in raster coordinates */
+    int     nSrcCount;    /* number of source pixels needed */
+    int     nMaxTaps;
+    int    *panFirst;     /* per destination pixel, relative to nSrcMin */
+    int    *panCount;
+    double *padfWeights;  /* nMaxTaps per destination pixel */
+} GDALRIOWeights;
+
+static void GDALRIOFreeWeights( GDALRIOWeights *psWeights )
+{
+    CPLFree( psWeights->panFirst );
+    CPLFree( psWeights->panCount );
+    CPLFree( psWeights->padfWeights );
+}
+
+/************************************************************************/
+/*                        GDALRIOComputeWeights()                       */
+/************************************************************************/
+
+static int GDALRIOComputeWeights( GDALRIOResampleAlg eResampleAlg,
+                                  int nOff, int nSize, int nBufSize,
+                                  int nRasterSize, GDALRIOWeights *psWeights )
+{
+    double (*pfnKernel)(double) = NULL;
+    double dfRadius = 0.0;
+
+    switch( eResampleAlg )
+    {
+        case GRIORA_Bilinear:
+            pfnKernel = GDALRIOKernelBilinear; dfRadius = 1.0; break;
+        case GRIORA_Cubic:
+            pfnKernel = GDALRIOKernelCubic; dfRadius = 2.0; break;
+        case GRIORA_CubicSpline:
+            pfnKernel = GDALRIOKernelCubicSpline; dfRadius = 2.0; break;
+        case GRIORA_Lanczos:
+            pfnKernel = GDALRIOKernelLanczos; dfRadius = 3.0; break;
+        default:
+            /* Average and mode use the footprint of the destination pixel */
+            break;
+    }
+
+    const double dfRatio = nSize / (double) nBufSize;
+    const double dfScale = MAX(1.0, dfRatio);
+    int nMin = 0, nMax = 0;
+
+    /* Kernels may use the pixels around the window, but not the footprints */
+    if( pfnKernel != NULL )
+    {
+        nMin = 0;
+        nMax = nRasterSize - 1;
+    }
+    else
+    {
+        nMin = nOff;
+        nMax = nOff + nSize - 1;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      First pass to find the range of source pixels of each           */
+/*      destination pixel.                                              */
+/* -------------------------------------------------------------------- */
+    psWeights->panFirst = (int *) VSIMalloc2( nBufSize, sizeof(int) );
+    psWeights->panCount = (int *) VSIMalloc2( nBufSize, sizeof(int) );
+    psWeights->padfWeights = NULL;
+    if( psWeights->panFirst == NULL || psWeights->panCount == NULL )
+    {
+        GDALRIOFreeWeights( psWeights );
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate resampling weights" );
+        return FALSE;
+    }
+
+    int i, k;
+    psWeights->nMaxTaps = 1;
+    psWeights->nSrcMin = INT_MAX;
+    int nSrcMax = -1;
+    for( i = 0; i < nBufSize; i++ )
+    {
+        int kMin, kMax;
+        if( pfnKernel != NULL )
+        {
+            const double dfCenter = nOff + (i + 0.5) * dfRatio;
+            const double dfSupport = dfRadius * dfScale;
+            kMin = (int) floor(dfCenter - dfSupport - 0.5) + 1;
+            kMax = (int) ceil(dfCenter + dfSupport - 0.5) - 1;
+        }
+        else
+        {
+            kMin = (int) floor(nOff + i * dfRatio);
+            kMax = (int) ceil(nOff + (i + 1) * dfRatio) - 1;
+        }
+        kMin = MAX(kMin, nMin);
+        kMax = MIN(kMax, nMax);
+        if( kMax < kMin )
+        {
+            /* Can only happen by rounding at the edges */
+            kMax = kMin = MIN(MAX(kMin, nMin), nMax);
+        }
+        psWeights->panFirst[i] = kMin;
+        psWeights->panCount[i] = kMax - kMin + 1;
+        psWeights->nMaxTaps = MAX(psWeights->nMaxTaps, kMax - kMin + 1);
+        psWeights->nSrcMin = MIN(psWeights->nSrcMin, kMin);
+        nSrcMax = MAX(nSrcMax, kMax);
+    }
+    psWeights->nSrcCount = nSrcMax - psWeights->nSrcMin + 1;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the normalized weights.                                 */
+/* -------------------------------------------------------------------- */
+    psWeights->padfWeights = (double *)
+        VSIMalloc3( nBufSize, psWeights->nMaxTaps, sizeof(double) );
+    if( psWeights->padfWeights == NULL )
+    {
+        GDALRIOFreeWeights( psWeights );
+        CPLError( CE_Failure, CPLE_OutOfMemory,
+                  "Cannot allocate resampling weights" );
+        return FALSE;
+    }
+
+    for( i = 0; i < nBufSize; i++ )
+    {
+        double *padfW = psWeights->padfWeights + i * psWeights->nMaxTaps;
+        const int kMin = psWeights->panFirst[i];
+        const int nCount = psWeights->panCount[i];
+        double dfSum = 0.0;
+
+        for( k = 0; k < nCount; k++ )
+        {
+            if( pfnKernel != NULL )
+            {
+                const double dfCenter = nOff + (i + 0.5) * dfRatio;
+                padfW[k] = pfnKernel( (kMin + k + 0.5 - dfCenter) / dfScale );
+            }
+            else if( eResampleAlg == GRIORA_Average )
+            {
+                /* Part of the source pixel covered by the destination pixel */
+                const double dfLeft = nOff + i * dfRatio;
+                const double dfRight = nOff + (i + 1) * dfRatio;
+                padfW[k] = MIN(dfRight, kMin + k + 1.0) - MAX(dfLeft, kMin + k);
+                if( padfW[k] < 0.0 )
+                    padfW[k] = 0.0;
+            }
+            else
+                padfW[k] = 1.0;
+            dfSum += padfW[k];
+        }
+
+        if( dfSum != 0.0 )
+        {
+            for( k = 0; k < nCount; k++ )
+                padfW[k] /= dfSum;
+        }
+        else
+        {
+            for( k = 0; k < nCount; k++ )
+                padfW[k] = 1.0 / nCount;
+        }
+
+        psWeights->panFirst[i] -= psWeights->nSrcMin;
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                       GDALRIOResampleRows()                          */
+/*                                                                      */
+/*      Horizontal pass: resample source lines to the buffer width.     */
+/*      With nodata, padfDstWeights receives the sum of the weights     */
+/*      of the valid source pixels, and padfDst is not normalized.      */
+/************************************************************************/
+
+template<int bHasNoData>
+static void GDALRIOResampleRows( const double *padfSrc, int nSrcLineSize,
+                                 int nLines, const GDALRIOWeights *psW,
+                                 int nBufXSize, double dfNoData,
+                                 double *padfDst, double *padfDstWeights )
+{
+    for( int iLine = 0; iLine < nLines; iLine++ )
+    {
+        const double *padfSrcLine = padfSrc + (size_t)iLine * nSrcLineSize;
+        double *padfDstLine = padfDst + (size_t)iLine * nBufXSize;
+
+        for( int i = 0; i < nBufXSize; i++ )
+        {
+            const double *padfS = padfSrcLine + psW->panFirst[i];
+            const double *padfW = psW->padfWeights + i * psW->nMaxTaps;
+            const int nCount = psW->panCount[i];
+            double dfValue = 0.0;
+            double dfWeightSum = 0.0;
+
+            for( int k = 0; k < nCount; k++ )
+            {
+                if( bHasNoData )
+                {
+                    if( padfS[k] == dfNoData || CPLIsNan(padfS[k]) )
+                        continue;
+                    dfWeightSum += padfW[k];
+                }
+                dfValue += padfW[k] * padfS[k];
+            }
+
+            padfDstLine[i] = dfValue;
+            if( bHasNoData )
+                padfDstWeights[(size_t)iLine * nBufXSize + i] = dfWeightSum;
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALRIOResampleColumns()                       */
+/*                                                                      */
+/*      Vertical pass: compute one buffer line from the horizontally    */
+/*      resampled lines, one tap at a time to run along the lines.      */
+/************************************************************************/
+
+template<int bHasNoData>
+static void GDALRIOResampleColumns( const double *padfRows,
+                                    const double *padfRowWeights,
+                                    int nFirst, int nCount,
+                                    const double *padfW, int nBufXSize,
+                                    double dfNoData,
+                                    double *padfDst, double *padfDstWeights )
+{
+    int i;
+
+    for( i = 0; i < nBufXSize; i++ )
+        padfDst[i] = 0.0;
+    if( bHasNoData )
+    {
+        for( i = 0; i < nBufXSize; i++ )
+            padfDstWeights[i] = 0.0;
+    }
+
+    for( int k = 0; k < nCount; k++ )
+    {
+        const double dfW = padfW[k];
+        const double *padfRow = padfRows + (size_t)(nFirst + k) * nBufXSize;
+        for( i = 0; i < nBufXSize; i++ )
+            padfDst[i] += dfW * padfRow[i];
+
+        if( bHasNoData )
+        {
+            const double *padfRowW =
+                padfRowWeights + (size_t)(nFirst + k) * nBufXSize;
+            for( i = 0; i < nBufXSize; i++ )
+                padfDstWeights[i] += dfW * padfRowW[i];
+        }
+    }
+
+    if( bHasNoData )
+    {
+        for( i = 0; i < nBufXSize; i++ )
+        {
+            if( fabs(padfDstWeights[i]) > 1e-10 )
+                padfDst[i] /= padfDstWeights[i];
+            else
+                padfDst[i] = dfNoData;
+        }
+    }
+}
+
+/************************************************************************/
+/*                          GDALRIOModeLine()                           */
+/*                                                                      */
+/*      Most frequent valid value of the footprint of each buffer       */
+/*      pixel of a line. Ties are resolved with the lowest value.       */
+/************************************************************************/
+
+static void GDALRIOModeLine( const double *padfSrc, int nSrcLineSize,
+                             int nFirstLine, int nLines,
+                             const GDALRIOWeights *psXW, int nBufXSize,
+                             int bHasNoData, double dfNoData, int bByte,
+                             double *padfValues, int *panHisto,
+                             double *padfDst )
+{
+    for( int i = 0; i < nBufXSize; i++ )
+    {
+        const int nFirstCol = psXW->panFirst[i];
+        const int nCols = psXW->panCount[i];
+        int nValues = 0;
+
+        for( int iLine = nFirstLine; iLine < nFirstLine + nLines; iLine++ )
+        {
+            const double *padfS =
+                padfSrc + (size_t)iLine * nSrcLineSize + nFirstCol;
+            for( int k = 0; k < nCols; k++ )
+            {
+                if( bHasNoData && (padfS[k] == dfNoData || CPLIsNan(padfS[k])) )
+                    continue;
+                padfValues[nValues++] = padfS[k];
+            }
+        }
+
+        if( nValues == 0 )
+        {
+            padfDst[i] = dfNoData;
+            continue;
+        }
+
+        double dfBest = padfValues[0];
+        int nBestCount = 0;
+        if( bByte )
+        {
+            int j;
+            for( j = 0; j < nValues; j++ )
+            {
+                const int nValue = (int) padfValues[j];
+                const int nCount = ++panHisto[nValue];
+                if( nCount > nBestCount ||
+                    (nCount == nBestCount && nValue < dfBest) )
+                {
+                    nBestCount = nCount;
+                    dfBest = nValue;
+                }
+            }
+            for( j = 0; j < nValues; j++ )
+                panHisto[(int) padfValues[j]] = 0;
+        }
+        else
+        {
+            std::sort( padfValues, padfValues + nValues );
+            int j = 0;
+            while( j < nValues )
+            {
+                int jEnd = j + 1;
+                while( jEnd < nValues && padfValues[jEnd] == padfValues[j] )
+                    jEnd++;
+                if( jEnd - j > nBestCount )
+                {
+                    nBestCount = jEnd - j;
+                    dfBest = padfValues[j];
+                }
+                j = jEnd;
+            }
+        }
+        padfDst[i] = dfBest;
+    }
+}
+
+/************************************************************************/
+/*                         RasterIOResampled()                          */
+/*                                                                      */
+/*      Generic implementation of resampled reads. The window, and      */
+/*      the pixels around it needed by the kernel, are read by          */
+/*      chunks of lines at full resolution in double precision, and     */
+/*      resampled with a horizontal then a vertical pass.               */
+/************************************************************************/
+
+#define RIO_RESAMPLE_CHUNK_BYTES    (4 * 1024 * 1024)
+
+CPLErr GDALRasterBand::RasterIOResampled( int nXOff, int nYOff,
+                                          int nXSize, int nYSize,
+                                          void * pData,
+                                          int nBufXSize, int nBufYSize,
+                                          GDALDataType eBufType,
+                                          int nPixelSpace, int nLineSpace,
+                                          GDALRasterIOExtraArg* psExtraArg )
+{
+    GDALRIOResampleAlg eResampleAlg = psExtraArg->eResampleAlg;
+    GDALProgressFunc pfnProgress = psExtraArg->pfnProgress;
+    void *pProgressData = psExtraArg->pProgressData;
+
+    if( pfnProgress == NULL )
+        pfnProgress = GDALDummyProgress;
+
+/* -------------------------------------------------------------------- */
+/*      Interpolating palette indices or complex values makes no        */
+/*      sense.                                                          */
+/* -------------------------------------------------------------------- */
+    if( eResampleAlg != GRIORA_Mode &&
+        (GetColorTable() != NULL || GDALDataTypeIsComplex(eDataType)) )
+    {
+        GDALRasterIOExtraArg sExtraArg = *psExtraArg;
+        sExtraArg.eResampleAlg = GRIORA_NearestNeighbour;
+        return RasterIO( GF_Read, nXOff, nYOff, nXSize, nYSize,
+                         pData, nBufXSize, nBufYSize, eBufType,
+                         nPixelSpace, nLineSpace, &sExtraArg );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Start from the best overview when downsampling.                 */
+/* -------------------------------------------------------------------- */
+    if( (nBufXSize < nXSize || nBufYSize < nYSize)
+        && GetOverviewCount() > 0 )
+    {
+        int nOXOff = nXOff, nOYOff = nYOff, nOXSize = nXSize, nOYSize = nYSize;
+        int nOverview = GDALBandGetBestOverviewLevel( this,
+                                                      nOXOff, nOYOff,
+                                                      nOXSize, nOYSize,
+                                                      nBufXSize, nBufYSize );
+        GDALRasterBand *poOverview =
+            (nOverview >= 0) ? GetOverview( nOverview ) : NULL;
+        if( poOverview != NULL )
+            return poOverview->RasterIO( GF_Read, nOXOff, nOYOff,
+                                         nOXSize, nOYSize,
+                                         pData, nBufXSize, nBufYSize, eBufType,
+                                         nPixelSpace, nLineSpace, psExtraArg );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compute the weights along both axis.                            */
+/* -------------------------------------------------------------------- */
+    GDALRIOWeights sXW, sYW;
+    if( !GDALRIOComputeWeights( eResampleAlg, nXOff, nXSize, nBufXSize,
+                                nRasterXSize, &sXW ) )
+        return CE_Failure;
+    if( !GDALRIOComputeWeights( eResampleAlg, nYOff, nYSize, nBufYSize,
+                                nRasterYSize, &sYW ) )
+    {
+        GDALRIOFreeWeights( &sXW );
+        return CE_Failure;
+    }
+
+    int bHasNoData = FALSE;
+    double dfNoData = GetNoDataValue( &bHasNoData );
+    if( !bHasNoData )
+        dfNoData = 0.0;
+
+    const int bMode = (eResampleAlg == GRIORA_Mode);
+    const int nSrcXSize = sXW.nSrcCount;
+
+/* -------------------------------------------------------------------- */
+/*      Number of source lines read at once.                            */
+/* -------------------------------------------------------------------- */
+    int nChunkLines = RIO_RESAMPLE_CHUNK_BYTES / (nSrcXSize * (int)sizeof(double));
+    nChunkLines = MAX(nChunkLines, sYW.nMaxTaps);
+    nChunkLines = MIN(nChunkLines, sYW.nSrcCount);
+
+    double *padfSrc = (double *)
+        VSIMalloc3( nChunkLines, nSrcXSize, sizeof(double) );
+    double *padfRows = NULL;
+    double *padfRowWeights = NULL;
+    double *padfLine = (double *) VSIMalloc2( nBufXSize, 2 * sizeof(double) );
+    double *padfValues = NULL;
+    int    *panHisto = NULL;
+    int     bOK = (padfSrc != NULL && padfLine != NULL);
+
+    if( bMode )
+    {
+        padfValues = (double *)
+            VSIMalloc3( sXW.nMaxTaps, sYW.nMaxTaps, sizeof(double) );
+        panHisto = (int *) VSICalloc( 256, sizeof(int) );
+        bOK &= (padfValues != NULL && panHisto != NULL);
+    }
+    else
+    {
+        padfRows = (double *)
+            VSIMalloc3( nChunkLines, nBufXSize, sizeof(double) );
+        bOK &= (padfRows != NULL);
+        if( bHasNoData )
+        {
+            padfRowWeights = (double *)
+                VSIMalloc3( nChunkLines, nBufXSize, sizeof(double) );
+            bOK &= (padfRowWeights != NULL);
+        }
+    }
+
+    CPLErr eErr = CE_None;
+    if( !bOK )
+    {
+        ReportError( CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate resampling buffers" );
+        eErr = CE_Failure;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Process the buffer lines by groups whose source lines fit in    */
+/*      a chunk.                                                        */
+/* -------------------------------------------------------------------- */
+    int iBufLine = 0;
+    while( eErr == CE_None && iBufLine < nBufYSize )
+    {
+        const int nChunkFirst = sYW.panFirst[iBufLine];
+        int iBufLineEnd = iBufLine + 1;
+        while( iBufLineEnd < nBufYSize &&
+               sYW.panFirst[iBufLineEnd] + sYW.panCount[iBufLineEnd]
+                                            - nChunkFirst <= nChunkLines )
+            iBufLineEnd++;
+        const int nChunkLast = sYW.panFirst[iBufLineEnd - 1]
+                                + sYW.panCount[iBufLineEnd - 1] - 1;
+        const int nLines = nChunkLast - nChunkFirst + 1;
+
+        eErr = RasterIO( GF_Read, sXW.nSrcMin, sYW.nSrcMin + nChunkFirst,
+                         nSrcXSize, nLines, padfSrc, nSrcXSize, nLines,
+                         GDT_Float64, 0, 0, NULL );
+        if( eErr != CE_None )
+            break;
+
+        if( !bMode )
+        {
+            if( bHasNoData )
+                GDALRIOResampleRows<TRUE>( padfSrc, nSrcXSize, nLines, &sXW,
+                                           nBufXSize, dfNoData,
+                                           padfRows, padfRowWeights );
+            else
+                GDALRIOResampleRows<FALSE>( padfSrc, nSrcXSize, nLines, &sXW,
+                                            nBufXSize, dfNoData,
+                                            padfRows, NULL );
+        }
+
+        for( ; iBufLine < iBufLineEnd; iBufLine++ )
+        {
+            const int nFirst = sYW.panFirst[iBufLine] - nChunkFirst;
+            const int nCount = sYW.panCount[iBufLine];
+
+            if( bMode )
+                GDALRIOModeLine( padfSrc, nSrcXSize, nFirst, nCount,
+                                 &sXW, nBufXSize, bHasNoData, dfNoData,
+                                 eDataType == GDT_Byte,
+                                 padfValues, panHisto, padfLine );
+            else if( bHasNoData )
+                GDALRIOResampleColumns<TRUE>( padfRows, padfRowWeights,
+                                              nFirst, nCount,
+                                              sYW.padfWeights + iBufLine * sYW.nMaxTaps,
+                                              nBufXSize, dfNoData,
+                                              padfLine, padfLine + nBufXSize );
+            else
+                GDALRIOResampleColumns<FALSE>( padfRows, NULL,
+                                               nFirst, nCount,
+                                               sYW.padfWeights + iBufLine * sYW.nMaxTaps,
+                                               nBufXSize, dfNoData,
+                                               padfLine, NULL );
+
+            GDALCopyWords( padfLine, GDT_Float64, sizeof(double),
+                           ((GByte *) pData) + (size_t)iBufLine * nLineSpace,
+                           eBufType, nPixelSpace, nBufXSize );
+        }
+
+        if( !pfnProgress( iBufLine / (double) nBufYSize, "", pProgressData ) )
+        {
+            ReportError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            eErr = CE_Failure;
+        }
+    }
+
+    VSIFree( padfSrc );
+    VSIFree( padfRows );
+    VSIFree( padfRowWeights );
+    VSIFree( padfLine );
+    VSIFree( padfValues );
+    VSIFree( panHisto );
+    GDALRIOFreeWeights( &sXW );
+    GDALRIOFreeWeights( &sYW );
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GetBestOverviewLevel()                        */
 /*                                                                      */
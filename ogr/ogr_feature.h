@@ -229,15 +229,23 @@ class CPL_DLL OGRFeatureDefn
  * A simple feature, including geometry and attributes.
  */
 
+struct OGRLazyGeometry;
+
 class CPL_DLL OGRFeature
 {
   private:
 
-    long                nFID;
+    GIntBig             nFID;
     OGRFeatureDefn      *poDefn;
     OGRGeometry        **papoGeometries;
+    OGRLazyGeometry     *pasLazyGeometries;
     OGRField            *pauFields;
 
+    void                ResolveLazyGeometry( int iField );
+    void                DiscardLazyGeometry( int iField );
+    void                SetGeomFieldFrom( int iField, OGRFeature *poSrcFeature,
+                                          int iSrcField );
+
   protected: 
     char *              m_pszStyleString;
     OGRStyleTable       *m_poStyleTable;
@@ -267,6 +275,13 @@ class CPL_DLL OGRFeature
     OGRErr              SetGeomFieldDirectly( int iField, OGRGeometry * );
     OGRErr              SetGeomField( int iField, OGRGeometry * );
 
+    OGRErr              SetGeomFieldWKB( int iField, const GByte *pabyWKB,
+                                         int nBytes,
+                                         const OGREnvelope *psEnvelope = NULL );
+    const GByte        *GetGeomFieldWKB( int iField, int *pnBytes );
+    OGRErr              GetGeomFieldEnvelope( int iField,
+                                              OGREnvelope *psEnvelope );
+
     OGRFeature         *Clone();
     virtual OGRBoolean  Equal( OGRFeature * poFeature );
 
@@ -347,8 +362,8 @@ class CPL_DLL OGRFeature
                                        nYear, nMonth, nDay, 
                                        nHour, nMinute, nSecond, nTZFlag ); }
 
-    long                GetFID() { return nFID; }
-    virtual OGRErr      SetFID( long nFID );
+    GIntBig             GetFID() { return nFID; }
+    virtual OGRErr      SetFID( GIntBig nFID );
 
     void                DumpReadable( FILE *, char** papszOptions = NULL );
 
@@ -372,22 +387,113 @@ class CPL_DLL OGRFeature
     static void         DestroyFeature( OGRFeature * );
 };
 
+/************************************************************************/
+/*                           OGRFeatureBatch                            */
+/************************************************************************/
+
+/**
+ * A batch of features stored column-wise.
+ *
+ * OFTInteger and OFTReal fields are stored in contiguous int and double
+ * arrays, OFTDate, OFTTime and OFTDateTime fields in an array of OGRField.
+ * OFTString, OFTBinary, OFTIntegerList, OFTRealList and OFTStringList
+ * fields, as well as geometries (as WKB), are stored in a single buffer
+ * per field, the value of the i-th feature being in the
+ * [panOffsets[i], panOffsets[i+1]) range of that buffer.
+ *
+ * Batches are filled with OGRLayer::GetNextFeatureBatch().
+ */
+
+class CPL_DLL OGRFeatureBatch
+{
+  private:
+    typedef struct
+    {
+        int             nKind;
+        GByte          *pabyIsSet;
+        void           *pFixed;
+        GByte          *pabyData;
+        size_t          nDataSize;
+        size_t          nDataAlloc;
+        size_t         *panOffsets;
+    } OGRFeatureBatchColumn;
+
+    OGRFeatureDefn     *poDefn;
+    int                 nFieldCount;
+    int                 nGeomFieldCount;
+    int                 nCapacity;
+    int                 nFeatureCount;
+    GIntBig            *panFIDs;
+
+    OGRFeatureBatchColumn *pasFields;
+    OGRFeatureBatchColumn *pasGeomFields;
+
+    GByte              *AppendData( OGRFeatureBatchColumn *psCol,
+                                    size_t nBytes );
+
+  public:
+                        OGRFeatureBatch( OGRFeatureDefn *poDefnIn,
+                                         int nCapacityIn );
+                       ~OGRFeatureBatch();
+
+    OGRFeatureDefn     *GetDefnRef() { return poDefn; }
+    int                 GetCapacity() { return nCapacity; }
+    int                 GetFeatureCount() { return nFeatureCount; }
+    int                 IsFull() { return nFeatureCount == nCapacity; }
+
+    void                Reset();
+
+    int                 BeginFeature( GIntBig nFID );
+    void                DiscardFeature();
+    OGRErr              AddFeature( OGRFeature *poFeature );
+
+    void                SetField( int iField, int nValue );
+    void                SetField( int iField, double dfValue );
+    void                SetField( int iField, const char *pszValue,
+                                  int nLength = -1 );
+    void                SetField( int iField, int nBytes,
+                                  const GByte *pabyData );
+    void                SetField( int iField, OGRField *psField );
+
+    void                SetGeomFieldWKB( int iGeomField,
+                                         const GByte *pabyWKB, int nBytes );
+    OGRErr              SetGeomField( int iGeomField, OGRGeometry *poGeom );
+
+    const GIntBig      *GetFIDs() { return panFIDs; }
+    const GByte        *GetFieldSetFlags( int iField );
+    const int          *GetFieldAsIntegerArray( int iField );
+    const double       *GetFieldAsDoubleArray( int iField );
+    const OGRField     *GetFieldAsDateTimeArray( int iField );
+    const GByte        *GetFieldData( int iField,
+                                      const size_t **ppanOffsets );
+    const GByte        *GetGeomFieldWKB( int iGeomField,
+                                         const size_t **ppanOffsets );
+
+    OGRFeature         *GetFeature( int iFeature );
+};
+
 /************************************************************************/
 /*                           OGRFeatureQuery                            */
 /************************************************************************/
 
 class OGRLayer;
+class OGRAttrIndex;
 class swq_expr_node;
+class swq_compiled_expr;
 
 class CPL_DLL OGRFeatureQuery
 {
   private:
     OGRFeatureDefn *poTargetDefn;
     void           *pSWQExpr;
+    swq_compiled_expr *poCompiledExpr;
 
     char          **FieldCollector( void *, char ** );
 
-    long       *EvaluateAgainstIndices( swq_expr_node*, OGRLayer *, int& nFIDCount);
+    GIntBig    *EvaluateAgainstIndices( swq_expr_node*, OGRLayer *, int& nFIDCount);
+    GIntBig    *EvaluateAgainstRangeIndex( swq_expr_node*, int iColumn,
+                                           OGRAttrIndex *, OGRLayer *,
+                                           int& nFIDCount );
     
     int         CanUseIndex( swq_expr_node*, OGRLayer * );
     
@@ -398,7 +504,7 @@ class CPL_DLL OGRFeatureQuery
     OGRErr      Compile( OGRFeatureDefn *, const char * );
     int         Evaluate( OGRFeature * );
 
-    long       *EvaluateAgainstIndices( OGRLayer *, OGRErr * );
+    GIntBig    *EvaluateAgainstIndices( OGRLayer *, OGRErr * );
     
     int         CanUseIndex( OGRLayer * );
 
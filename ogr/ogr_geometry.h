@@ -257,6 +257,17 @@ class CPL_DLL OGRCurve : public OGRGeometry
 /*                            OGRLineString                             */
 /************************************************************************/
 
+/* Number of points stored in the OGRLineString object itself, to avoid */
+/* allocating memory for short lines and rings. */
+#define OGR_LINESTRING_INLINE_POINTS    5
+
+/* TODO: not done yet, as they change the paoPoints/padfZ layout that   */
+/* subclasses, OGRGeometryFactory and drivers access directly:          */
+/*  - a single interleaved XYZ array instead of paoPoints + padfZ,      */
+/*  - an optional float32 coordinate mode (opt-in, as it is lossy),     */
+/*  - an arena-backed OGRGeometryFactory creation path, which needs a   */
+/*    way for geometries to be released other than delete.             */
+
 /**
  * Concrete representation of a multi-vertex line.
  */
@@ -271,6 +282,14 @@ class CPL_DLL OGRLineString : public OGRCurve
     void        Make3D();
     void        Make2D();
 
+  private:
+    /* Number of points that paoPoints, and padfZ if not NULL, can hold */
+    int         nPointCapacity;
+    OGRRawPoint aoInlinePoints[OGR_LINESTRING_INLINE_POINTS];
+
+    int         SetPointCapacity( int nNewCapacity );
+    void        FreePoints();
+
   public:
                 OGRLineString();
     virtual     ~OGRLineString();
@@ -685,6 +704,10 @@ class CPL_DLL OGRGeometryFactory
     static OGRGeometry* transformWithOptions( const OGRGeometry* poSrcGeom,
                                               OGRCoordinateTransformation *poCT,
                                               char** papszOptions );
+    static OGRErr transformGeometries( OGRCoordinateTransformation *poCT,
+                                       int nGeomCount,
+                                       OGRGeometry **papoGeoms,
+                                       OGRErr *paeErrors = NULL );
 
     static OGRGeometry* 
         approximateArcAngles( double dfX, double dfY, double dfZ,
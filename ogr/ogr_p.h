@@ -147,5 +147,7 @@ char CPL_DLL * OGRGeometryToHexEWKB( OGRGeometry * poGeometry, int nSRSId );
 /************************************************************************/
 
 OGRErr OGRReadWKBGeometryType( unsigned char * pabyData, OGRwkbGeometryType *eGeometryType, OGRBoolean *b3D );
+OGRErr CPL_DLL OGRWKBGetEnvelope( const GByte *pabyWKB, int nBytes,
+                                 OGREnvelope *psEnvelope );
 
 #endif /* ndef OGR_P_H_INCLUDED */
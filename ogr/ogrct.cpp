@@ -34,6 +34,7 @@
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
+#include "cpl_atomic_ops.h"
 
 #ifdef PROJ_STATIC
 #include "proj_api.h"
@@ -95,6 +96,148 @@ static void    (*pfn_pj_ctx_free)( projCtx ) = NULL;
 #  define LIBNAME      "libproj.so"
 #endif
 
+/************************************************************************/
+/*                        OGRProj4ThreadContext                         */
+/*                                                                      */
+/*      PROJ.4 context and projection objects owned by a thread.  They  */
+/*      are used when a transformation object is used concurrently by   */
+/*      several threads, so that each thread runs pj_transform() on     */
+/*      its own objects, without serializing on a mutex.  The objects   */
+/*      are keyed by the PROJ.4 definitions, so that transformation     */
+/*      objects created and destroyed in other threads never leave      */
+/*      dangling references here.                                       */
+/************************************************************************/
+
+#define OGR_PROJ4_THREAD_CACHE_SIZE     32
+
+typedef struct
+{
+    char       *pszSrcProj4Defn;
+    char       *pszDstProj4Defn;
+    projPJ      psPJSource;
+    projPJ      psPJTarget;
+    GUIntBig    nLastUse;
+} OGRProj4ThreadCacheEntry;
+
+typedef struct
+{
+    projCtx     pjctx;
+    int         nEntryCount;
+    GUIntBig    nUseCounter;
+    OGRProj4ThreadCacheEntry asEntries[OGR_PROJ4_THREAD_CACHE_SIZE];
+} OGRProj4ThreadContext;
+
+/************************************************************************/
+/*                     OGRProj4FreeThreadCacheEntry()                   */
+/************************************************************************/
+
+static void OGRProj4FreeThreadCacheEntry( OGRProj4ThreadCacheEntry *psEntry )
+{
+    if( psEntry->psPJSource != NULL )
+        pfn_pj_free( psEntry->psPJSource );
+    if( psEntry->psPJTarget != NULL )
+        pfn_pj_free( psEntry->psPJTarget );
+    CPLFree( psEntry->pszSrcProj4Defn );
+    CPLFree( psEntry->pszDstProj4Defn );
+    memset( psEntry, 0, sizeof(OGRProj4ThreadCacheEntry) );
+}
+
+/************************************************************************/
+/*                      OGRProj4FreeThreadContext()                     */
+/*                                                                      */
+/*      Called when the thread terminates.  Must not use any TLS.       */
+/************************************************************************/
+
+static void OGRProj4FreeThreadContext( void *pData )
+{
+    OGRProj4ThreadContext *psContext = (OGRProj4ThreadContext *) pData;
+
+    for( int i = 0; i < psContext->nEntryCount; i++ )
+        OGRProj4FreeThreadCacheEntry( &psContext->asEntries[i] );
+    pfn_pj_ctx_free( psContext->pjctx );
+    CPLFree( psContext );
+}
+
+/************************************************************************/
+/*                     OGRProj4GetThreadObjects()                       */
+/*                                                                      */
+/*      Return the projection objects of the calling thread for a       */
+/*      pair of PROJ.4 definitions, creating them if needed.            */
+/************************************************************************/
+
+static OGRProj4ThreadCacheEntry *
+OGRProj4GetThreadObjects( const char *pszSrcProj4Defn,
+                          const char *pszDstProj4Defn )
+{
+    OGRProj4ThreadContext *psContext = (OGRProj4ThreadContext *)
+        CPLGetTLS( CTLS_PROJCONTEXTHOLDER );
+
+    if( psContext == NULL )
+    {
+        projCtx pjctx = pfn_pj_ctx_alloc();
+        if( pjctx == NULL )
+            return NULL;
+
+        psContext = (OGRProj4ThreadContext *)
+            CPLCalloc( 1, sizeof(OGRProj4ThreadContext) );
+        psContext->pjctx = pjctx;
+        CPLSetTLSWithFreeFunc( CTLS_PROJCONTEXTHOLDER, psContext,
+                               OGRProj4FreeThreadContext );
+    }
+
+    psContext->nUseCounter ++;
+
+    int i, iLeastRecentlyUsed = 0;
+    for( i = 0; i < psContext->nEntryCount; i++ )
+    {
+        OGRProj4ThreadCacheEntry *psEntry = &psContext->asEntries[i];
+        if( strcmp( psEntry->pszSrcProj4Defn, pszSrcProj4Defn ) == 0 &&
+            strcmp( psEntry->pszDstProj4Defn, pszDstProj4Defn ) == 0 )
+        {
+            psEntry->nLastUse = psContext->nUseCounter;
+            return psEntry;
+        }
+        if( psEntry->nLastUse <
+            psContext->asEntries[iLeastRecentlyUsed].nLastUse )
+            iLeastRecentlyUsed = i;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Not found : create the objects, evicting the least recently     */
+/*      used ones if the cache is full.                                 */
+/* -------------------------------------------------------------------- */
+    OGRProj4ThreadCacheEntry *psEntry;
+    if( psContext->nEntryCount < OGR_PROJ4_THREAD_CACHE_SIZE )
+        psEntry = &psContext->asEntries[psContext->nEntryCount++];
+    else
+    {
+        psEntry = &psContext->asEntries[iLeastRecentlyUsed];
+        OGRProj4FreeThreadCacheEntry( psEntry );
+    }
+
+    psEntry->psPJSource = pfn_pj_init_plus_ctx( psContext->pjctx,
+                                                pszSrcProj4Defn );
+    psEntry->psPJTarget = pfn_pj_init_plus_ctx( psContext->pjctx,
+                                                pszDstProj4Defn );
+    psEntry->pszSrcProj4Defn = CPLStrdup( pszSrcProj4Defn );
+    psEntry->pszDstProj4Defn = CPLStrdup( pszDstProj4Defn );
+    psEntry->nLastUse = psContext->nUseCounter;
+
+    if( psEntry->psPJSource == NULL || psEntry->psPJTarget == NULL )
+    {
+        /* Should not happen as the definitions were already accepted */
+        /* by the transformation object. */
+        OGRProj4FreeThreadCacheEntry( psEntry );
+        psContext->asEntries[psEntry - psContext->asEntries] =
+            psContext->asEntries[--psContext->nEntryCount];
+        memset( &psContext->asEntries[psContext->nEntryCount], 0,
+                sizeof(OGRProj4ThreadCacheEntry) );
+        return NULL;
+    }
+
+    return psEntry;
+}
+
 /************************************************************************/
 /*                         OCTCleanupProjMutex()                        */
 /************************************************************************/
@@ -106,6 +249,14 @@ void OCTCleanupProjMutex()
         CPLDestroyMutex(hPROJMutex);
         hPROJMutex = NULL;
     }
+
+    OGRProj4ThreadContext *psContext = (OGRProj4ThreadContext *)
+        CPLGetTLS( CTLS_PROJCONTEXTHOLDER );
+    if( psContext != NULL )
+    {
+        OGRProj4FreeThreadContext( psContext );
+        CPLSetTLS( CTLS_PROJCONTEXTHOLDER, NULL, FALSE );
+    }
 }
 
 /************************************************************************/
@@ -138,6 +289,12 @@ class OGRProj4CT : public OGRCoordinateTransformation
     
     projCtx     pjctx;
 
+    /* Kept to create the objects of the threads that use this */
+    /* transformation concurrently. */
+    char       *pszSrcProj4Defn;
+    char       *pszDstProj4Defn;
+    volatile int nUsers;
+
     int         InitializeNoLock( OGRSpatialReference *poSource, 
                                   OGRSpatialReference *poTarget );
 
@@ -478,6 +635,10 @@ OGRProj4CT::OGRProj4CT()
     padfTargetY = NULL;
     padfTargetZ = NULL;
 
+    pszSrcProj4Defn = NULL;
+    pszDstProj4Defn = NULL;
+    nUsers = 0;
+
     if (pfn_pj_ctx_alloc != NULL)
         pjctx = pfn_pj_ctx_alloc();
     else
@@ -530,6 +691,9 @@ OGRProj4CT::~OGRProj4CT()
     CPLFree(padfTargetX);
     CPLFree(padfTargetY);
     CPLFree(padfTargetZ);
+
+    CPLFree(pszSrcProj4Defn);
+    CPLFree(pszDstProj4Defn);
 }
 
 /************************************************************************/
@@ -647,17 +811,11 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     // means debug output could be one "increment" late. 
     static int   nDebugReportCount = 0;
 
-    char        *pszSrcProj4Defn = NULL;
-
     if( poSRSSource->exportToProj4( &pszSrcProj4Defn ) != OGRERR_NONE )
-    {
-        CPLFree( pszSrcProj4Defn );
         return FALSE;
-    }
 
     if( strlen(pszSrcProj4Defn) == 0 )
     {
-        CPLFree( pszSrcProj4Defn );
         CPLError( CE_Failure, CPLE_AppDefined, 
                   "No PROJ.4 translation for source SRS, coordinate\n"
                   "transformation initialization has failed." );
@@ -702,28 +860,17 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
         CPLDebug( "OGRCT", "Source: %s", pszSrcProj4Defn );
 
     if( psPJSource == NULL )
-    {
-        CPLFree( pszSrcProj4Defn );
         return FALSE;
-    }
 
 /* -------------------------------------------------------------------- */
 /*      Establish PROJ.4 handle for target if projection.               */
 /* -------------------------------------------------------------------- */
 
-    char        *pszDstProj4Defn = NULL;
-
     if( poSRSTarget->exportToProj4( &pszDstProj4Defn ) != OGRERR_NONE )
-    {
-        CPLFree( pszSrcProj4Defn );
-        CPLFree( pszDstProj4Defn );
         return FALSE;
-    }
 
     if( strlen(pszDstProj4Defn) == 0 )
     {
-        CPLFree( pszSrcProj4Defn );
-        CPLFree( pszDstProj4Defn );
         CPLError( CE_Failure, CPLE_AppDefined, 
                   "No PROJ.4 translation for destination SRS, coordinate\n"
                   "transformation initialization has failed." );
@@ -747,11 +894,7 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     }
 
     if( psPJTarget == NULL )
-    {
-        CPLFree( pszSrcProj4Defn );
-        CPLFree( pszDstProj4Defn );
         return FALSE;
-    }
 
     /* Determine if we really have a transformation to do */
     bIdentityTransform = (strcmp(pszSrcProj4Defn, pszDstProj4Defn) == 0);
@@ -766,9 +909,6 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
         bTargetLatLong = FALSE;*/
     }
 
-    CPLFree( pszSrcProj4Defn );
-    CPLFree( pszDstProj4Defn );
-
     return TRUE;
 }
 
@@ -874,15 +1014,42 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
     }
     
 /* -------------------------------------------------------------------- */
-/*      Do the transformation using PROJ.4.                             */
+/*      Select the PROJ.4 objects to use.  Without PROJ.4 contexts,     */
+/*      all calls are serialized on the global mutex.  With them, the   */
+/*      objects of this transformation are used if no other thread is   */
+/*      using them, otherwise the calling thread uses its own objects.  */
 /* -------------------------------------------------------------------- */
-    if( !bIdentityTransform && pjctx == NULL )
+    projPJ psPJSourceToUse = psPJSource;
+    projPJ psPJTargetToUse = psPJTarget;
+    int    bOwnObjects = TRUE;
+
+    if( bIdentityTransform )
+        /* nothing to do */;
+    else if( pjctx == NULL )
     {
         /* The mutex has already been created */
         CPLAssert(hPROJMutex != NULL);
         CPLAcquireMutex(hPROJMutex, 1000.0);
     }
+    else if( CPLAtomicInc(&nUsers) > 1 )
+    {
+        OGRProj4ThreadCacheEntry *psEntry =
+            OGRProj4GetThreadObjects( pszSrcProj4Defn, pszDstProj4Defn );
+        if( psEntry == NULL )
+        {
+            CPLAtomicDec(&nUsers);
+            if( pabSuccess )
+                memset( pabSuccess, 0, sizeof(int) * nCount );
+            return FALSE;
+        }
+        psPJSourceToUse = psEntry->psPJSource;
+        psPJTargetToUse = psEntry->psPJTarget;
+        bOwnObjects = FALSE;
+    }
 
+/* -------------------------------------------------------------------- */
+/*      Do the transformation using PROJ.4.                             */
+/* -------------------------------------------------------------------- */
     if( bIdentityTransform )
         err = 0;
     else if (bCheckWithInvertProj)
@@ -890,41 +1057,68 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
         /* For some projections, we cannot detect if we are trying to reproject */
         /* coordinates outside the validity area of the projection. So let's do */
         /* the reverse reprojection and compare with the source coordinates */
-        if (nCount > nMaxCount)
+        double *padfOriXToUse, *padfOriYToUse, *padfOriZToUse;
+        double *padfTargetXToUse, *padfTargetYToUse, *padfTargetZToUse;
+        double *padfTmp = NULL;
+
+        if( bOwnObjects )
         {
-            nMaxCount = nCount;
-            padfOriX = (double*) CPLRealloc(padfOriX, sizeof(double)*nCount);
-            padfOriY = (double*) CPLRealloc(padfOriY, sizeof(double)*nCount);
-            padfOriZ = (double*) CPLRealloc(padfOriZ, sizeof(double)*nCount);
-            padfTargetX = (double*) CPLRealloc(padfTargetX, sizeof(double)*nCount);
-            padfTargetY = (double*) CPLRealloc(padfTargetY, sizeof(double)*nCount);
-            padfTargetZ = (double*) CPLRealloc(padfTargetZ, sizeof(double)*nCount);
+            if (nCount > nMaxCount)
+            {
+                nMaxCount = nCount;
+                padfOriX = (double*) CPLRealloc(padfOriX, sizeof(double)*nCount);
+                padfOriY = (double*) CPLRealloc(padfOriY, sizeof(double)*nCount);
+                padfOriZ = (double*) CPLRealloc(padfOriZ, sizeof(double)*nCount);
+                padfTargetX = (double*) CPLRealloc(padfTargetX, sizeof(double)*nCount);
+                padfTargetY = (double*) CPLRealloc(padfTargetY, sizeof(double)*nCount);
+                padfTargetZ = (double*) CPLRealloc(padfTargetZ, sizeof(double)*nCount);
+            }
+            padfOriXToUse = padfOriX;
+            padfOriYToUse = padfOriY;
+            padfOriZToUse = padfOriZ;
+            padfTargetXToUse = padfTargetX;
+            padfTargetYToUse = padfTargetY;
+            padfTargetZToUse = padfTargetZ;
         }
-        memcpy(padfOriX, x, sizeof(double)*nCount);
-        memcpy(padfOriY, y, sizeof(double)*nCount);
+        else
+        {
+            /* The buffers of the object may be in use by another thread */
+            padfTmp = (double*) CPLMalloc(sizeof(double) * 6 * nCount);
+            padfOriXToUse = padfTmp;
+            padfOriYToUse = padfTmp + nCount;
+            padfOriZToUse = padfTmp + 2 * nCount;
+            padfTargetXToUse = padfTmp + 3 * nCount;
+            padfTargetYToUse = padfTmp + 4 * nCount;
+            padfTargetZToUse = padfTmp + 5 * nCount;
+        }
+
+        memcpy(padfOriXToUse, x, sizeof(double)*nCount);
+        memcpy(padfOriYToUse, y, sizeof(double)*nCount);
         if (z)
         {
-            memcpy(padfOriZ, z, sizeof(double)*nCount);
+            memcpy(padfOriZToUse, z, sizeof(double)*nCount);
         }
-        err = pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
+        err = pfn_pj_transform( psPJSourceToUse, psPJTargetToUse, nCount, 1,
+                                x, y, z );
         if (err == 0)
         {
-            memcpy(padfTargetX, x, sizeof(double)*nCount);
-            memcpy(padfTargetY, y, sizeof(double)*nCount);
+            memcpy(padfTargetXToUse, x, sizeof(double)*nCount);
+            memcpy(padfTargetYToUse, y, sizeof(double)*nCount);
             if (z)
             {
-                memcpy(padfTargetZ, z, sizeof(double)*nCount);
+                memcpy(padfTargetZToUse, z, sizeof(double)*nCount);
             }
             
-            err = pfn_pj_transform( psPJTarget, psPJSource , nCount, 1,
-                                    padfTargetX, padfTargetY, (z) ? padfTargetZ : NULL);
+            err = pfn_pj_transform( psPJTargetToUse, psPJSourceToUse, nCount, 1,
+                                    padfTargetXToUse, padfTargetYToUse,
+                                    (z) ? padfTargetZToUse : NULL);
             if (err == 0)
             {
                 for( i = 0; i < nCount; i++ )
                 {
                     if ( x[i] != HUGE_VAL && y[i] != HUGE_VAL &&
-                        (fabs(padfTargetX[i] - padfOriX[i]) > dfThreshold ||
-                         fabs(padfTargetY[i] - padfOriY[i]) > dfThreshold) )
+                        (fabs(padfTargetXToUse[i] - padfOriXToUse[i]) > dfThreshold ||
+                         fabs(padfTargetYToUse[i] - padfOriYToUse[i]) > dfThreshold) )
                     {
                         x[i] = HUGE_VAL;
                         y[i] = HUGE_VAL;
@@ -932,12 +1126,18 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
                 }
             }
         }
+
+        CPLFree( padfTmp );
     }
     else
     {
-        err = pfn_pj_transform( psPJSource, psPJTarget, nCount, 1, x, y, z );
+        err = pfn_pj_transform( psPJSourceToUse, psPJTargetToUse, nCount, 1,
+                                x, y, z );
     }
 
+    if( !bIdentityTransform && pjctx != NULL )
+        CPLAtomicDec(&nUsers);
+
 /* -------------------------------------------------------------------- */
 /*      Try to report an error through CPL.  Get proj.4 error string    */
 /*      if possible.  Try to avoid reporting thousands of error         */
@@ -35,6 +35,15 @@
 
 CPL_CVSID("$Id$");
 
+/* Geometry of a feature kept in its WKB form until it is needed */
+struct OGRLazyGeometry
+{
+    GByte      *pabyWKB;
+    int         nWKBSize;
+    int         bHasEnvelope;
+    OGREnvelope sEnvelope;
+};
+
 /************************************************************************/
 /*                             OGRFeature()                             */
 /************************************************************************/
@@ -70,6 +79,7 @@ OGRFeature::OGRFeature( OGRFeatureDefn * poDefnIn )
 
     papoGeometries = (OGRGeometry **) CPLCalloc( poDefn->GetGeomFieldCount(),
                                         sizeof(OGRGeometry*) );
+    pasLazyGeometries = NULL;
 
     for( int i = 0; i < poDefn->GetFieldCount(); i++ )
     {
@@ -154,12 +164,15 @@ OGRFeature::~OGRFeature()
     for( i = 0; i < nGeomFieldCount; i++ )
     {
         delete papoGeometries[i];
+        if( pasLazyGeometries != NULL )
+            CPLFree( pasLazyGeometries[i].pabyWKB );
     }
     
     poDefn->Release();
 
     CPLFree( pauFields );
     CPLFree( papoGeometries );
+    CPLFree( pasLazyGeometries );
     CPLFree(m_pszStyleString);
     CPLFree(m_pszTmpFieldValue);
 }
@@ -414,14 +427,7 @@ OGRErr OGR_F_SetGeometry( OGRFeatureH hFeat, OGRGeometryH hGeom )
 OGRGeometry *OGRFeature::StealGeometry()
 
 {
-    if( GetGeomFieldCount() > 0 )
-    {
-        OGRGeometry *poReturn = papoGeometries[0];
-        papoGeometries[0] = NULL;
-        return poReturn;
-    }
-    else
-        return NULL;
+    return StealGeometry(0);
 }
 
 OGRGeometry *OGRFeature::StealGeometry(int iGeomField)
@@ -429,7 +435,7 @@ OGRGeometry *OGRFeature::StealGeometry(int iGeomField)
 {
     if( iGeomField >= 0 && iGeomField < GetGeomFieldCount() )
     {
-        OGRGeometry *poReturn = papoGeometries[iGeomField];
+        OGRGeometry *poReturn = GetGeomFieldRef(iGeomField);
         papoGeometries[iGeomField] = NULL;
         return poReturn;
     }
@@ -532,8 +538,11 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(int iField)
 {
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return NULL;
-    else
-        return papoGeometries[iField];
+
+    if( pasLazyGeometries != NULL && pasLazyGeometries[iField].pabyWKB != NULL )
+        ResolveLazyGeometry( iField );
+
+    return papoGeometries[iField];
 }
 
 /************************************************************************/
@@ -557,7 +566,7 @@ OGRGeometry *OGRFeature::GetGeomFieldRef(const char* pszFName)
     if( iField < 0 )
         return NULL;
     else
-        return papoGeometries[iField];
+        return GetGeomFieldRef(iField);
 }
 
 /************************************************************************/
@@ -616,6 +625,7 @@ OGRErr OGRFeature::SetGeomFieldDirectly( int iField, OGRGeometry * poGeomIn )
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return OGRERR_FAILURE;
 
+    DiscardLazyGeometry( iField );
     delete papoGeometries[iField];
     papoGeometries[iField] = poGeomIn;
 
@@ -690,6 +700,7 @@ OGRErr OGRFeature::SetGeomField( int iField, OGRGeometry * poGeomIn )
     if( iField < 0 || iField >= GetGeomFieldCount() )
         return OGRERR_FAILURE;
 
+    DiscardLazyGeometry( iField );
     delete papoGeometries[iField];
 
     if( poGeomIn != NULL )
@@ -732,6 +743,277 @@ OGRErr OGR_F_SetGeomField( OGRFeatureH hFeat, int iField, OGRGeometryH hGeom )
     return ((OGRFeature *) hFeat)->SetGeomField(iField, (OGRGeometry *) hGeom);
 }
 
+/************************************************************************/
+/*                          SetGeomFieldWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Set feature geometry of a specified geometry field from WKB.
+ *
+ * The WKB blob is copied and kept as is: the geometry object is only
+ * built when it is first requested with GetGeomFieldRef() (or any method
+ * that needs it). This allows drivers that store geometries as WKB to
+ * avoid instantiating geometries that the caller never looks at, and
+ * writers accepting WKB to fetch the blob directly with GetGeomFieldWKB().
+ *
+ * The geometry will be assigned the spatial reference of the geometry
+ * field definition when it is built.
+ *
+ * @param iField geometry field to set.
+ * @param pabyWKB the WKB blob (OGC or ISO flavour). Passing NULL is
+ * equivalent to SetGeomField(iField, NULL).
+ * @param nBytes the size of pabyWKB in bytes.
+ * @param psEnvelope the 2D envelope of the geometry if the caller already
+ * knows it (e.g. from a GeoPackage blob header), or NULL.
+ *
+ * @return OGRERR_NONE if successful, or OGRERR_FAILURE if the index is
+ * invalid.
+ *
+ * @since GDAL 2.0
+ */
+
+OGRErr OGRFeature::SetGeomFieldWKB( int iField, const GByte *pabyWKB,
+                                    int nBytes, const OGREnvelope *psEnvelope )
+
+{
+    if( iField < 0 || iField >= GetGeomFieldCount() )
+        return OGRERR_FAILURE;
+
+    if( pabyWKB == NULL || nBytes <= 0 )
+        return SetGeomField( iField, NULL );
+
+    delete papoGeometries[iField];
+    papoGeometries[iField] = NULL;
+
+    if( pasLazyGeometries == NULL )
+        pasLazyGeometries = (OGRLazyGeometry *)
+            CPLCalloc( GetGeomFieldCount(), sizeof(OGRLazyGeometry) );
+
+    OGRLazyGeometry *psLazy = pasLazyGeometries + iField;
+    if( psLazy->pabyWKB == NULL || psLazy->nWKBSize < nBytes )
+    {
+        CPLFree( psLazy->pabyWKB );
+        psLazy->pabyWKB = (GByte *) VSIMalloc( nBytes );
+        if( psLazy->pabyWKB == NULL )
+        {
+            CPLError( CE_Failure, CPLE_OutOfMemory,
+                      "Cannot allocate %d bytes for WKB geometry", nBytes );
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    memcpy( psLazy->pabyWKB, pabyWKB, nBytes );
+    psLazy->nWKBSize = nBytes;
+
+    if( psEnvelope != NULL )
+    {
+        psLazy->bHasEnvelope = TRUE;
+        psLazy->sEnvelope = *psEnvelope;
+    }
+    else
+        psLazy->bHasEnvelope = FALSE;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          GetGeomFieldWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Fetch the WKB blob of a geometry field that has not been parsed yet.
+ *
+ * This returns the blob set with SetGeomFieldWKB(), as long as the geometry
+ * has not been built since (in which case it might have been modified by
+ * the caller, and NULL is returned). Writers can use this to pass through
+ * the geometry without a round trip through OGRGeometry. The blob may use
+ * either byte order, and either the OGC 2.5D or the ISO flavour of 3D types.
+ *
+ * @param iField geometry field to fetch.
+ * @param pnBytes pointer to an int where the size of the blob is returned,
+ * or NULL.
+ *
+ * @return a pointer to internal data that must not be freed, or NULL.
+ *
+ * @since GDAL 2.0
+ */
+
+const GByte *OGRFeature::GetGeomFieldWKB( int iField, int *pnBytes )
+
+{
+    if( iField < 0 || iField >= GetGeomFieldCount() ||
+        pasLazyGeometries == NULL ||
+        pasLazyGeometries[iField].pabyWKB == NULL )
+    {
+        if( pnBytes != NULL )
+            *pnBytes = 0;
+        return NULL;
+    }
+
+    if( pnBytes != NULL )
+        *pnBytes = pasLazyGeometries[iField].nWKBSize;
+    return pasLazyGeometries[iField].pabyWKB;
+}
+
+/************************************************************************/
+/*                        GetGeomFieldEnvelope()                        */
+/************************************************************************/
+
+/**
+ * \brief Fetch the 2D envelope of the geometry of a geometry field.
+ *
+ * When the geometry was set with SetGeomFieldWKB() and has not been built
+ * yet, the envelope is computed directly from the WKB blob (or taken from
+ * the envelope passed to SetGeomFieldWKB()), without instantiating the
+ * geometry.
+ *
+ * This method is the same as the C function OGR_F_GetGeomFieldEnvelope().
+ *
+ * @param iField geometry field.
+ * @param psEnvelope the envelope to fill.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_FAILURE if the index is invalid
+ * or if the feature has no geometry or an empty geometry for that field.
+ *
+ * @since GDAL 2.0
+ */
+
+OGRErr OGRFeature::GetGeomFieldEnvelope( int iField,
+                                         OGREnvelope *psEnvelope )
+
+{
+    if( iField < 0 || iField >= GetGeomFieldCount() )
+        return OGRERR_FAILURE;
+
+    if( pasLazyGeometries != NULL && pasLazyGeometries[iField].pabyWKB != NULL )
+    {
+        OGRLazyGeometry *psLazy = pasLazyGeometries + iField;
+        if( psLazy->bHasEnvelope )
+        {
+            *psEnvelope = psLazy->sEnvelope;
+            return OGRERR_NONE;
+        }
+
+        OGRErr eErr = OGRWKBGetEnvelope( psLazy->pabyWKB, psLazy->nWKBSize,
+                                         &(psLazy->sEnvelope) );
+        if( eErr == OGRERR_NONE )
+        {
+            psLazy->bHasEnvelope = TRUE;
+            *psEnvelope = psLazy->sEnvelope;
+            return OGRERR_NONE;
+        }
+        if( eErr == OGRERR_FAILURE )
+            return OGRERR_FAILURE;
+
+        /* Not something we can scan: build the geometry */
+    }
+
+    OGRGeometry *poGeom = GetGeomFieldRef(iField);
+    if( poGeom == NULL || poGeom->IsEmpty() )
+        return OGRERR_FAILURE;
+
+    poGeom->getEnvelope( psEnvelope );
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                     OGR_F_GetGeomFieldEnvelope()                     */
+/************************************************************************/
+
+/**
+ * \brief Fetch the 2D envelope of the geometry of a geometry field.
+ *
+ * This function is the same as the C++ method
+ * OGRFeature::GetGeomFieldEnvelope().
+ *
+ * @param hFeat handle to the feature.
+ * @param iField geometry field.
+ * @param psEnvelope the envelope to fill.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_FAILURE if the index is invalid
+ * or if the feature has no geometry or an empty geometry for that field.
+ *
+ * @since GDAL 2.0
+ */
+
+OGRErr OGR_F_GetGeomFieldEnvelope( OGRFeatureH hFeat, int iField,
+                                   OGREnvelope *psEnvelope )
+
+{
+    VALIDATE_POINTER1( hFeat, "OGR_F_GetGeomFieldEnvelope", CE_Failure );
+    VALIDATE_POINTER1( psEnvelope, "OGR_F_GetGeomFieldEnvelope", CE_Failure );
+
+    return ((OGRFeature *) hFeat)->GetGeomFieldEnvelope(iField, psEnvelope);
+}
+
+/************************************************************************/
+/*                        ResolveLazyGeometry()                         */
+/*                                                                      */
+/*      Build the geometry of a field set with SetGeomFieldWKB().       */
+/************************************************************************/
+
+void OGRFeature::ResolveLazyGeometry( int iField )
+
+{
+    OGRLazyGeometry *psLazy = pasLazyGeometries + iField;
+    OGRGeometry *poGeom = NULL;
+
+    if( OGRGeometryFactory::createFromWkb(
+            psLazy->pabyWKB,
+            poDefn->GetGeomFieldDefn(iField)->GetSpatialRef(),
+            &poGeom, psLazy->nWKBSize ) != OGRERR_NONE )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Unable to read geometry of feature " CPL_FRMT_GIB, nFID );
+        poGeom = NULL;
+    }
+
+    DiscardLazyGeometry( iField );
+    delete papoGeometries[iField];
+    papoGeometries[iField] = poGeom;
+}
+
+/************************************************************************/
+/*                        DiscardLazyGeometry()                         */
+/************************************************************************/
+
+void OGRFeature::DiscardLazyGeometry( int iField )
+
+{
+    if( pasLazyGeometries != NULL )
+    {
+        CPLFree( pasLazyGeometries[iField].pabyWKB );
+        pasLazyGeometries[iField].pabyWKB = NULL;
+        pasLazyGeometries[iField].nWKBSize = 0;
+        pasLazyGeometries[iField].bHasEnvelope = FALSE;
+    }
+}
+
+/************************************************************************/
+/*                          SetGeomFieldFrom()                          */
+/*                                                                      */
+/*      Copy a geometry field of another feature, keeping it in its     */
+/*      WKB form if it has not been built yet.                          */
+/************************************************************************/
+
+void OGRFeature::SetGeomFieldFrom( int iField, OGRFeature *poSrcFeature,
+                                   int iSrcField )
+
+{
+    OGRLazyGeometry *psSrcLazy = NULL;
+    if( poSrcFeature->pasLazyGeometries != NULL &&
+        iSrcField >= 0 && iSrcField < poSrcFeature->GetGeomFieldCount() )
+        psSrcLazy = poSrcFeature->pasLazyGeometries + iSrcField;
+
+    if( psSrcLazy != NULL && psSrcLazy->pabyWKB != NULL )
+    {
+        SetGeomFieldWKB( iField, psSrcLazy->pabyWKB, psSrcLazy->nWKBSize,
+                         psSrcLazy->bHasEnvelope ? &(psSrcLazy->sEnvelope)
+                                                 : NULL );
+    }
+    else
+        SetGeomField( iField, poSrcFeature->GetGeomFieldRef(iSrcField) );
+}
+
 /************************************************************************/
 /*                               Clone()                                */
 /************************************************************************/
@@ -759,7 +1041,7 @@ OGRFeature *OGRFeature::Clone()
     }
     for( i = 0; i < poDefn->GetGeomFieldCount(); i++ )
     {
-        poNew->SetGeomField( i, papoGeometries[i] );
+        poNew->SetGeomFieldFrom( i, this, i );
     }
 
     if( GetStyleString() != NULL )
@@ -1084,16 +1366,16 @@ int OGRFeature::IsFieldSet( int iField )
 
           case SPF_OGR_GEOM_WKT:
           case SPF_OGR_GEOMETRY:
-            return GetGeomFieldCount() > 0 && papoGeometries[0] != NULL;
+            return GetGeomFieldCount() > 0 && GetGeomFieldRef(0) != NULL;
 
           case SPF_OGR_STYLE:
             return ((OGRFeature *)this)->GetStyleString() != NULL;
 
           case SPF_OGR_GEOM_AREA:
-            if( GetGeomFieldCount() == 0 || papoGeometries[0] == NULL )
+            if( GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == NULL )
                 return FALSE;
 
-            return OGR_G_Area((OGRGeometryH)papoGeometries[0]) != 0.0;
+            return OGR_G_Area((OGRGeometryH)GetGeomFieldRef(0)) != 0.0;
 
           default:
             return FALSE;
@@ -1274,12 +1556,12 @@ int OGRFeature::GetFieldAsInteger( int iField )
         switch (iSpecialField)
         {
         case SPF_FID:
-            return GetFID();
+            return (int) GetFID();
 
         case SPF_OGR_GEOM_AREA:
-            if( GetGeomFieldCount() == 0 || papoGeometries[0] == NULL )
+            if( GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == NULL )
                 return 0;
-            return (int)OGR_G_Area((OGRGeometryH)papoGeometries[0]);
+            return (int)OGR_G_Area((OGRGeometryH)GetGeomFieldRef(0));
 
         default:
             return 0;
@@ -1364,12 +1646,12 @@ double OGRFeature::GetFieldAsDouble( int iField )
         switch (iSpecialField)
         {
         case SPF_FID:
-            return GetFID();
+            return (double) GetFID();
 
         case SPF_OGR_GEOM_AREA:
-            if( GetGeomFieldCount() == 0 || papoGeometries[0] == NULL )
+            if( GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == NULL )
                 return 0.0;
-            return OGR_G_Area((OGRGeometryH)papoGeometries[0]);
+            return OGR_G_Area((OGRGeometryH)GetGeomFieldRef(0));
 
         default:
             return 0.0;
@@ -1461,12 +1743,12 @@ const char *OGRFeature::GetFieldAsString( int iField )
         switch (iSpecialField)
         {
           case SPF_FID:
-            snprintf( szTempBuffer, TEMP_BUFFER_SIZE, "%ld", GetFID() );
+            snprintf( szTempBuffer, TEMP_BUFFER_SIZE, CPL_FRMT_GIB, GetFID() );
             return m_pszTmpFieldValue = CPLStrdup( szTempBuffer );
 
           case SPF_OGR_GEOMETRY:
-            if( GetGeomFieldCount() > 0 && papoGeometries[0] != NULL )
-                return papoGeometries[0]->getGeometryName();
+            if( GetGeomFieldCount() > 0 && GetGeomFieldRef(0) != NULL )
+                return GetGeomFieldRef(0)->getGeometryName();
             else
                 return "";
 
@@ -1478,21 +1760,21 @@ const char *OGRFeature::GetFieldAsString( int iField )
 
           case SPF_OGR_GEOM_WKT:
           {
-              if( GetGeomFieldCount() == 0 || papoGeometries[0] == NULL )
+              if( GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == NULL )
                   return "";
 
-              if (papoGeometries[0]->exportToWkt( &m_pszTmpFieldValue ) == OGRERR_NONE )
+              if (GetGeomFieldRef(0)->exportToWkt( &m_pszTmpFieldValue ) == OGRERR_NONE )
                   return m_pszTmpFieldValue;
               else
                   return "";
           }
 
           case SPF_OGR_GEOM_AREA:
-            if( GetGeomFieldCount() == 0 || papoGeometries[0] == NULL )
+            if( GetGeomFieldCount() == 0 || GetGeomFieldRef(0) == NULL )
                 return "";
 
             snprintf( szTempBuffer, TEMP_BUFFER_SIZE, "%.16g", 
-                      OGR_G_Area((OGRGeometryH)papoGeometries[0]) );
+                      OGR_G_Area((OGRGeometryH)GetGeomFieldRef(0)) );
             return m_pszTmpFieldValue = CPLStrdup( szTempBuffer );
 
           default:
@@ -2998,7 +3280,7 @@ void OGRFeature::DumpReadable( FILE * fpOut, char** papszOptions )
     if( fpOut == NULL )
         fpOut = stdout;
 
-    fprintf( fpOut, "OGRFeature(%s):%ld\n", poDefn->GetName(), GetFID() );
+    fprintf( fpOut, "OGRFeature(%s):" CPL_FRMT_GIB "\n", poDefn->GetName(), GetFID() );
 
     const char* pszDisplayFields =
             CSLFetchNameValue(papszOptions, "DISPLAY_FIELDS");
@@ -3042,12 +3324,14 @@ void OGRFeature::DumpReadable( FILE * fpOut, char** papszOptions )
             {
                 OGRGeomFieldDefn    *poFDefn = poDefn->GetGeomFieldDefn(iField);
 
-                if( papoGeometries[iField] != NULL )
+                OGRGeometry *poGeom = GetGeomFieldRef(iField);
+
+                if( poGeom != NULL )
                 {
                     fprintf( fpOut, "  " );
                     if( strlen(poFDefn->GetNameRef()) > 0 && GetGeomFieldCount() > 1 )
                         fprintf( fpOut, "%s = ", poFDefn->GetNameRef() );
-                    papoGeometries[iField]->dumpReadable( fpOut, "", papszOptions );
+                    poGeom->dumpReadable( fpOut, "", papszOptions );
                 }
             }
         }
@@ -3109,7 +3393,7 @@ void OGR_F_DumpReadable( OGRFeatureH hFeat, FILE *fpOut )
  * @return feature id or OGRNullFID if none has been assigned.
  */
 
-long OGR_F_GetFID( OGRFeatureH hFeat )
+GIntBig OGR_F_GetFID( OGRFeatureH hFeat )
 
 {
     VALIDATE_POINTER1( hFeat, "OGR_F_GetFID", 0 );
@@ -3136,7 +3420,7 @@ long OGR_F_GetFID( OGRFeatureH hFeat )
  * @return On success OGRERR_NONE, or on failure some other value. 
  */
 
-OGRErr OGRFeature::SetFID( long nFID )
+OGRErr OGRFeature::SetFID( GIntBig nFID )
 
 {
     this->nFID = nFID;
@@ -3164,7 +3448,7 @@ OGRErr OGRFeature::SetFID( long nFID )
  * @return On success OGRERR_NONE, or on failure some other value. 
  */
 
-OGRErr OGR_F_SetFID( OGRFeatureH hFeat, long nFID )
+OGRErr OGR_F_SetFID( OGRFeatureH hFeat, GIntBig nFID )
 
 {
     VALIDATE_POINTER1( hFeat, "OGR_F_SetFID", CE_Failure );
@@ -3524,10 +3808,10 @@ OGRErr OGRFeature::SetFrom( OGRFeature * poSrcFeature, int *panMap ,
         int iSrc = poSrcFeature->GetGeomFieldIndex(
                                     poGFieldDefn->GetNameRef());
         if( iSrc >= 0 )
-            SetGeomField( 0, poSrcFeature->GetGeomFieldRef(iSrc) );
+            SetGeomFieldFrom( 0, poSrcFeature, iSrc );
         else
             /* whatever the geometry field names are. For backward compatibility */
-            SetGeomField( 0, poSrcFeature->GetGeomFieldRef(0) );
+            SetGeomFieldFrom( 0, poSrcFeature, 0 );
     }
     else
     {
@@ -3539,7 +3823,7 @@ OGRErr OGRFeature::SetFrom( OGRFeature * poSrcFeature, int *panMap ,
             int iSrc = poSrcFeature->GetGeomFieldIndex(
                                         poGFieldDefn->GetNameRef());
             if( iSrc >= 0 )
-                SetGeomField( i, poSrcFeature->GetGeomFieldRef(iSrc) );
+                SetGeomFieldFrom( i, poSrcFeature, iSrc );
             else
                 SetGeomField( i, NULL );
         }
@@ -3981,6 +4265,17 @@ OGRErr OGRFeature::RemapGeomFields( OGRFeatureDefn *poNewDefn,
     if( poNewDefn == NULL )
         poNewDefn = poDefn;
 
+    if( pasLazyGeometries != NULL )
+    {
+        for( iDstField = 0; iDstField < poDefn->GetGeomFieldCount(); iDstField++ )
+        {
+            if( pasLazyGeometries[iDstField].pabyWKB != NULL )
+                ResolveLazyGeometry( iDstField );
+        }
+        CPLFree( pasLazyGeometries );
+        pasLazyGeometries = NULL;
+    }
+
     papoNewGeomFields = (OGRGeometry **) CPLCalloc( poNewDefn->GetGeomFieldCount(), 
                                            sizeof(OGRGeometry*) );
 
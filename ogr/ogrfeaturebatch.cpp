@@ -0,0 +1,969 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRFeatureBatch class implementation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_feature.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$");
+
+/* Storage kinds of the columns of a batch */
+#define OFB_NONE        0
+#define OFB_INTEGER     1
+#define OFB_REAL        2
+#define OFB_DATETIME    3
+#define OFB_STRING      4
+#define OFB_BINARY      5
+#define OFB_INTLIST     6
+#define OFB_REALLIST    7
+#define OFB_STRLIST     8
+#define OFB_WKB         9
+
+/************************************************************************/
+/*                         OGRFeatureBatchKind()                        */
+/************************************************************************/
+
+static int OGRFeatureBatchKind( OGRFieldType eType )
+{
+    switch( eType )
+    {
+        case OFTInteger:        return OFB_INTEGER;
+        case OFTReal:           return OFB_REAL;
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:       return OFB_DATETIME;
+        case OFTString:         return OFB_STRING;
+        case OFTBinary:         return OFB_BINARY;
+        case OFTIntegerList:    return OFB_INTLIST;
+        case OFTRealList:       return OFB_REALLIST;
+        case OFTStringList:     return OFB_STRLIST;
+        default:                return OFB_NONE;
+    }
+}
+
+/************************************************************************/
+/*                          OGRFeatureBatch()                           */
+/************************************************************************/
+
+/**
+ * \brief Constructor
+ *
+ * The batch increments the reference count of the feature definition,
+ * which must be the one of the layer the batch will be filled from.
+ *
+ * @param poDefnIn feature definition of the features of the batch.
+ * @param nCapacityIn maximum number of features held by the batch.
+ *
+ * @since GDAL 2.0
+ */
+
+OGRFeatureBatch::OGRFeatureBatch( OGRFeatureDefn *poDefnIn, int nCapacityIn )
+
+{
+    int i;
+
+    poDefn = poDefnIn;
+    poDefn->Reference();
+
+    nCapacity = MAX(1, nCapacityIn);
+    nFeatureCount = 0;
+    panFIDs = (GIntBig *) CPLMalloc( sizeof(GIntBig) * nCapacity );
+
+    nFieldCount = poDefn->GetFieldCount();
+    pasFields = (OGRFeatureBatchColumn *)
+        CPLCalloc( sizeof(OGRFeatureBatchColumn), MAX(1, nFieldCount) );
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        OGRFeatureBatchColumn *psCol = pasFields + i;
+
+        psCol->nKind = OGRFeatureBatchKind(
+            poDefn->GetFieldDefn(i)->GetType() );
+        psCol->pabyIsSet = (GByte *) CPLCalloc( 1, nCapacity );
+
+        switch( psCol->nKind )
+        {
+            case OFB_INTEGER:
+                psCol->pFixed = CPLCalloc( sizeof(int), nCapacity );
+                break;
+            case OFB_REAL:
+                psCol->pFixed = CPLCalloc( sizeof(double), nCapacity );
+                break;
+            case OFB_DATETIME:
+                psCol->pFixed = CPLCalloc( sizeof(OGRField), nCapacity );
+                break;
+            case OFB_NONE:
+                break;
+            default:
+                psCol->panOffsets = (size_t *)
+                    CPLCalloc( sizeof(size_t), nCapacity + 1 );
+                break;
+        }
+    }
+
+    nGeomFieldCount = poDefn->GetGeomFieldCount();
+    pasGeomFields = (OGRFeatureBatchColumn *)
+        CPLCalloc( sizeof(OGRFeatureBatchColumn), MAX(1, nGeomFieldCount) );
+    for( i = 0; i < nGeomFieldCount; i++ )
+    {
+        pasGeomFields[i].nKind = OFB_WKB;
+        pasGeomFields[i].panOffsets = (size_t *)
+            CPLCalloc( sizeof(size_t), nCapacity + 1 );
+    }
+}
+
+/************************************************************************/
+/*                          ~OGRFeatureBatch()                          */
+/************************************************************************/
+
+OGRFeatureBatch::~OGRFeatureBatch()
+
+{
+    int i;
+
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        CPLFree( pasFields[i].pabyIsSet );
+        CPLFree( pasFields[i].pFixed );
+        CPLFree( pasFields[i].pabyData );
+        CPLFree( pasFields[i].panOffsets );
+    }
+    CPLFree( pasFields );
+
+    for( i = 0; i < nGeomFieldCount; i++ )
+    {
+        CPLFree( pasGeomFields[i].pabyData );
+        CPLFree( pasGeomFields[i].panOffsets );
+    }
+    CPLFree( pasGeomFields );
+
+    CPLFree( panFIDs );
+
+    poDefn->Release();
+}
+
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Remove all features from the batch.
+ *
+ * The buffers are kept allocated so that they can be reused for the
+ * next features.
+ */
+
+void OGRFeatureBatch::Reset()
+
+{
+    int i;
+
+    nFeatureCount = 0;
+
+    for( i = 0; i < nFieldCount; i++ )
+        pasFields[i].nDataSize = 0;
+    for( i = 0; i < nGeomFieldCount; i++ )
+        pasGeomFields[i].nDataSize = 0;
+}
+
+/************************************************************************/
+/*                            BeginFeature()                            */
+/************************************************************************/
+
+/**
+ * \brief Append a new empty feature to the batch.
+ *
+ * The fields and geometries of the new feature are unset. They can then
+ * be set with the SetField(), SetGeomField() and SetGeomFieldWKB()
+ * methods, each field being set at most once.
+ *
+ * @param nFID feature id of the new feature.
+ *
+ * @return the index of the new feature in the batch, or -1 if the batch
+ * is full.
+ */
+
+int OGRFeatureBatch::BeginFeature( GIntBig nFID )
+
+{
+    if( nFeatureCount == nCapacity )
+        return -1;
+
+    int iFeature = nFeatureCount++;
+    int i;
+
+    panFIDs[iFeature] = nFID;
+
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        OGRFeatureBatchColumn *psCol = pasFields + i;
+
+        psCol->pabyIsSet[iFeature] = FALSE;
+        if( psCol->panOffsets != NULL )
+            psCol->panOffsets[iFeature + 1] = psCol->nDataSize;
+    }
+    for( i = 0; i < nGeomFieldCount; i++ )
+        pasGeomFields[i].panOffsets[iFeature + 1] = pasGeomFields[i].nDataSize;
+
+    return iFeature;
+}
+
+/************************************************************************/
+/*                           DiscardFeature()                           */
+/************************************************************************/
+
+/**
+ * \brief Remove the last feature appended with BeginFeature().
+ */
+
+void OGRFeatureBatch::DiscardFeature()
+
+{
+    if( nFeatureCount == 0 )
+        return;
+
+    nFeatureCount--;
+
+    int i;
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        if( pasFields[i].panOffsets != NULL )
+            pasFields[i].nDataSize = pasFields[i].panOffsets[nFeatureCount];
+    }
+    for( i = 0; i < nGeomFieldCount; i++ )
+        pasGeomFields[i].nDataSize = pasGeomFields[i].panOffsets[nFeatureCount];
+}
+
+/************************************************************************/
+/*                             AddFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Append a copy of a feature to the batch.
+ *
+ * @param poFeature the feature to copy. Its definition must have the same
+ * fields and geometry fields as the one of the batch.
+ *
+ * @return OGRERR_NONE on success, or OGRERR_FAILURE if the batch is full.
+ */
+
+OGRErr OGRFeatureBatch::AddFeature( OGRFeature *poFeature )
+
+{
+    OGRFeatureDefn *poSrcDefn = poFeature->GetDefnRef();
+
+    if( poSrcDefn->GetFieldCount() != nFieldCount
+        || poSrcDefn->GetGeomFieldCount() != nGeomFieldCount )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Feature definition does not match the one of the batch." );
+        return OGRERR_FAILURE;
+    }
+
+    if( BeginFeature( poFeature->GetFID() ) < 0 )
+        return OGRERR_FAILURE;
+
+    int i;
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        if( poFeature->IsFieldSet( i ) )
+            SetField( i, poFeature->GetRawFieldRef( i ) );
+    }
+
+    for( i = 0; i < nGeomFieldCount; i++ )
+    {
+        /* Geometries not built yet by the feature are copied as WKB */
+        int nBytes = 0;
+        const GByte *pabyWKB = poFeature->GetGeomFieldWKB( i, &nBytes );
+        if( pabyWKB != NULL )
+        {
+            SetGeomFieldWKB( i, pabyWKB, nBytes );
+            continue;
+        }
+
+        if( SetGeomField( i, poFeature->GetGeomFieldRef( i ) ) != OGRERR_NONE )
+        {
+            DiscardFeature();
+            return OGRERR_FAILURE;
+        }
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                             AppendData()                             */
+/*                                                                      */
+/*      Grow the buffer of a variable length column by nBytes for the  */
+/*      last feature, and return a pointer to the added bytes.          */
+/************************************************************************/
+
+GByte *OGRFeatureBatch::AppendData( OGRFeatureBatchColumn *psCol,
+                                    size_t nBytes )
+
+{
+    if( psCol->nDataSize + nBytes > psCol->nDataAlloc )
+    {
+        size_t nNewAlloc = psCol->nDataAlloc * 2 + 1024;
+        if( nNewAlloc < psCol->nDataSize + nBytes )
+            nNewAlloc = psCol->nDataSize + nBytes;
+        psCol->pabyData = (GByte *) CPLRealloc( psCol->pabyData, nNewAlloc );
+        psCol->nDataAlloc = nNewAlloc;
+    }
+
+    GByte *pabyRet = psCol->pabyData + psCol->nDataSize;
+    psCol->nDataSize += nBytes;
+    psCol->panOffsets[nFeatureCount] = psCol->nDataSize;
+
+    return pabyRet;
+}
+
+/************************************************************************/
+/*                              SetField()                              */
+/************************************************************************/
+
+/**
+ * \brief Set a field of the last feature of the batch to an integer value.
+ *
+ * OFTInteger, OFTReal, OFTString, OFTIntegerList and OFTRealList fields
+ * will be set from the value. Other field types are not affected.
+ *
+ * @param iField the field to set, from 0 to GetFieldCount()-1.
+ * @param nValue the value to assign.
+ */
+
+void OGRFeatureBatch::SetField( int iField, int nValue )
+
+{
+    if( nFeatureCount == 0 || iField < 0 || iField >= nFieldCount )
+        return;
+
+    OGRFeatureBatchColumn *psCol = pasFields + iField;
+    int iFeature = nFeatureCount - 1;
+
+    switch( psCol->nKind )
+    {
+        case OFB_INTEGER:
+            ((int *) psCol->pFixed)[iFeature] = nValue;
+            break;
+
+        case OFB_REAL:
+            ((double *) psCol->pFixed)[iFeature] = nValue;
+            break;
+
+        case OFB_STRING:
+        {
+            char szTemp[32];
+            sprintf( szTemp, "%d", nValue );
+            memcpy( AppendData( psCol, strlen(szTemp) ), szTemp,
+                    strlen(szTemp) );
+            break;
+        }
+
+        case OFB_INTLIST:
+            memcpy( AppendData( psCol, sizeof(int) ), &nValue, sizeof(int) );
+            break;
+
+        case OFB_REALLIST:
+        {
+            double dfValue = nValue;
+            memcpy( AppendData( psCol, sizeof(double) ), &dfValue,
+                    sizeof(double) );
+            break;
+        }
+
+        default:
+            return;
+    }
+
+    psCol->pabyIsSet[iFeature] = TRUE;
+}
+
+/**
+ * \brief Set a field of the last feature of the batch to a double value.
+ *
+ * OFTInteger, OFTReal, OFTString, OFTIntegerList and OFTRealList fields
+ * will be set from the value. Other field types are not affected.
+ *
+ * @param iField the field to set, from 0 to GetFieldCount()-1.
+ * @param dfValue the value to assign.
+ */
+
+void OGRFeatureBatch::SetField( int iField, double dfValue )
+
+{
+    if( nFeatureCount == 0 || iField < 0 || iField >= nFieldCount )
+        return;
+
+    OGRFeatureBatchColumn *psCol = pasFields + iField;
+    int iFeature = nFeatureCount - 1;
+
+    switch( psCol->nKind )
+    {
+        case OFB_INTEGER:
+            ((int *) psCol->pFixed)[iFeature] = (int) dfValue;
+            break;
+
+        case OFB_REAL:
+            ((double *) psCol->pFixed)[iFeature] = dfValue;
+            break;
+
+        case OFB_STRING:
+        {
+            char szTemp[64];
+            snprintf( szTemp, sizeof(szTemp), "%.15g", dfValue );
+            memcpy( AppendData( psCol, strlen(szTemp) ), szTemp,
+                    strlen(szTemp) );
+            break;
+        }
+
+        case OFB_INTLIST:
+        {
+            int nValue = (int) dfValue;
+            memcpy( AppendData( psCol, sizeof(int) ), &nValue, sizeof(int) );
+            break;
+        }
+
+        case OFB_REALLIST:
+            memcpy( AppendData( psCol, sizeof(double) ), &dfValue,
+                    sizeof(double) );
+            break;
+
+        default:
+            return;
+    }
+
+    psCol->pabyIsSet[iFeature] = TRUE;
+}
+
+/**
+ * \brief Set a field of the last feature of the batch to a string value.
+ *
+ * OFTInteger, OFTReal, OFTDate, OFTTime, OFTDateTime, OFTString, OFTBinary
+ * and OFTStringList fields will be set from the value. Other field types
+ * are not affected.
+ *
+ * @param iField the field to set, from 0 to GetFieldCount()-1.
+ * @param pszValue the value to assign.
+ * @param nLength the length in bytes of pszValue, or -1 if it is
+ * nul-terminated.
+ */
+
+void OGRFeatureBatch::SetField( int iField, const char *pszValue,
+                                int nLength )
+
+{
+    if( nFeatureCount == 0 || iField < 0 || iField >= nFieldCount
+        || pszValue == NULL )
+        return;
+
+    OGRFeatureBatchColumn *psCol = pasFields + iField;
+    int iFeature = nFeatureCount - 1;
+
+    if( nLength < 0 )
+        nLength = (int) strlen(pszValue);
+
+    switch( psCol->nKind )
+    {
+        case OFB_STRING:
+        case OFB_BINARY:
+            memcpy( AppendData( psCol, nLength ), pszValue, nLength );
+            break;
+
+        case OFB_STRLIST:
+        {
+            GByte *pabyDst = AppendData( psCol, nLength + 1 );
+            memcpy( pabyDst, pszValue, nLength );
+            pabyDst[nLength] = '\0';
+            break;
+        }
+
+        case OFB_INTEGER:
+            ((int *) psCol->pFixed)[iFeature] = atoi(pszValue);
+            break;
+
+        case OFB_REAL:
+            ((double *) psCol->pFixed)[iFeature] = CPLAtof(pszValue);
+            break;
+
+        case OFB_DATETIME:
+        {
+            OGRField *psField = ((OGRField *) psCol->pFixed) + iFeature;
+            if( !OGRParseDate( pszValue, psField, 0 ) )
+                return;
+            break;
+        }
+
+        default:
+            return;
+    }
+
+    psCol->pabyIsSet[iFeature] = TRUE;
+}
+
+/**
+ * \brief Set a field of the last feature of the batch to a binary value.
+ *
+ * Only OFTBinary and OFTString fields are affected.
+ *
+ * @param iField the field to set, from 0 to GetFieldCount()-1.
+ * @param nBytes the number of bytes of pabyData.
+ * @param pabyData the data to assign.
+ */
+
+void OGRFeatureBatch::SetField( int iField, int nBytes, const GByte *pabyData )
+
+{
+    if( nFeatureCount == 0 || iField < 0 || iField >= nFieldCount )
+        return;
+
+    OGRFeatureBatchColumn *psCol = pasFields + iField;
+
+    if( psCol->nKind != OFB_BINARY && psCol->nKind != OFB_STRING )
+        return;
+
+    if( nBytes > 0 )
+        memcpy( AppendData( psCol, nBytes ), pabyData, nBytes );
+    psCol->pabyIsSet[nFeatureCount - 1] = TRUE;
+}
+
+/**
+ * \brief Set a field of the last feature of the batch from a raw field.
+ *
+ * The OGRField is interpreted according to the type of the field, as
+ * done by OGRFeature::SetField( int, OGRField * ).
+ *
+ * @param iField the field to set, from 0 to GetFieldCount()-1.
+ * @param psField the value to assign.
+ */
+
+void OGRFeatureBatch::SetField( int iField, OGRField *psField )
+
+{
+    if( nFeatureCount == 0 || iField < 0 || iField >= nFieldCount )
+        return;
+
+    OGRFeatureBatchColumn *psCol = pasFields + iField;
+    int iFeature = nFeatureCount - 1;
+
+    switch( psCol->nKind )
+    {
+        case OFB_INTEGER:
+            ((int *) psCol->pFixed)[iFeature] = psField->Integer;
+            break;
+
+        case OFB_REAL:
+            ((double *) psCol->pFixed)[iFeature] = psField->Real;
+            break;
+
+        case OFB_DATETIME:
+            ((OGRField *) psCol->pFixed)[iFeature] = *psField;
+            break;
+
+        case OFB_STRING:
+        {
+            size_t nLength = strlen(psField->String);
+            memcpy( AppendData( psCol, nLength ), psField->String, nLength );
+            break;
+        }
+
+        case OFB_BINARY:
+            if( psField->Binary.nCount > 0 )
+                memcpy( AppendData( psCol, psField->Binary.nCount ),
+                        psField->Binary.paData, psField->Binary.nCount );
+            break;
+
+        case OFB_INTLIST:
+            if( psField->IntegerList.nCount > 0 )
+                memcpy( AppendData( psCol,
+                                    sizeof(int) * psField->IntegerList.nCount ),
+                        psField->IntegerList.paList,
+                        sizeof(int) * psField->IntegerList.nCount );
+            break;
+
+        case OFB_REALLIST:
+            if( psField->RealList.nCount > 0 )
+                memcpy( AppendData( psCol,
+                                    sizeof(double) * psField->RealList.nCount ),
+                        psField->RealList.paList,
+                        sizeof(double) * psField->RealList.nCount );
+            break;
+
+        case OFB_STRLIST:
+        {
+            for( int i = 0; i < psField->StringList.nCount; i++ )
+            {
+                const char *pszItem = psField->StringList.paList[i];
+                size_t nLength = strlen(pszItem) + 1;
+                memcpy( AppendData( psCol, nLength ), pszItem, nLength );
+            }
+            break;
+        }
+
+        default:
+            return;
+    }
+
+    psCol->pabyIsSet[iFeature] = TRUE;
+}
+
+/************************************************************************/
+/*                          SetGeomFieldWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Set a geometry of the last feature of the batch from WKB.
+ *
+ * @param iGeomField the geometry field to set.
+ * @param pabyWKB the WKB geometry, copied into the batch.
+ * @param nBytes the size of pabyWKB.
+ */
+
+void OGRFeatureBatch::SetGeomFieldWKB( int iGeomField,
+                                       const GByte *pabyWKB, int nBytes )
+
+{
+    if( nFeatureCount == 0 || iGeomField < 0
+        || iGeomField >= nGeomFieldCount || nBytes <= 0 )
+        return;
+
+    memcpy( AppendData( pasGeomFields + iGeomField, nBytes ), pabyWKB, nBytes );
+}
+
+/************************************************************************/
+/*                            SetGeomField()                            */
+/************************************************************************/
+
+/**
+ * \brief Set a geometry of the last feature of the batch.
+ *
+ * The geometry is exported as little endian WKB into the batch.
+ *
+ * @param iGeomField the geometry field to set.
+ * @param poGeom the geometry. May be NULL.
+ *
+ * @return OGRERR_NONE on success.
+ */
+
+OGRErr OGRFeatureBatch::SetGeomField( int iGeomField, OGRGeometry *poGeom )
+
+{
+    if( nFeatureCount == 0 || iGeomField < 0
+        || iGeomField >= nGeomFieldCount )
+        return OGRERR_FAILURE;
+
+    if( poGeom == NULL )
+        return OGRERR_NONE;
+
+    OGRFeatureBatchColumn *psCol = pasGeomFields + iGeomField;
+    int nSize = poGeom->WkbSize();
+    OGRErr eErr = poGeom->exportToWkb( wkbNDR, AppendData( psCol, nSize ) );
+
+    if( eErr != OGRERR_NONE )
+    {
+        psCol->nDataSize -= nSize;
+        psCol->panOffsets[nFeatureCount] = psCol->nDataSize;
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                          GetFieldSetFlags()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the array of flags telling if a field is set.
+ *
+ * @param iField the field, from 0 to GetFieldCount()-1.
+ *
+ * @return an array of GetFeatureCount() flags, TRUE for the features
+ * where the field is set, or NULL if iField is invalid.
+ */
+
+const GByte *OGRFeatureBatch::GetFieldSetFlags( int iField )
+
+{
+    if( iField < 0 || iField >= nFieldCount )
+        return NULL;
+
+    return pasFields[iField].pabyIsSet;
+}
+
+/************************************************************************/
+/*                       GetFieldAsIntegerArray()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTInteger field.
+ *
+ * @param iField the field, from 0 to GetFieldCount()-1.
+ *
+ * @return an array of GetFeatureCount() values, or NULL if the field is
+ * not an OFTInteger field. Values of unset fields are undefined.
+ */
+
+const int *OGRFeatureBatch::GetFieldAsIntegerArray( int iField )
+
+{
+    if( iField < 0 || iField >= nFieldCount
+        || pasFields[iField].nKind != OFB_INTEGER )
+        return NULL;
+
+    return (const int *) pasFields[iField].pFixed;
+}
+
+/************************************************************************/
+/*                       GetFieldAsDoubleArray()                        */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTReal field.
+ *
+ * @param iField the field, from 0 to GetFieldCount()-1.
+ *
+ * @return an array of GetFeatureCount() values, or NULL if the field is
+ * not an OFTReal field. Values of unset fields are undefined.
+ */
+
+const double *OGRFeatureBatch::GetFieldAsDoubleArray( int iField )
+
+{
+    if( iField < 0 || iField >= nFieldCount
+        || pasFields[iField].nKind != OFB_REAL )
+        return NULL;
+
+    return (const double *) pasFields[iField].pFixed;
+}
+
+/************************************************************************/
+/*                      GetFieldAsDateTimeArray()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTDate, OFTTime or OFTDateTime field.
+ *
+ * Only the Date member of the returned OGRField structures is meaningful.
+ *
+ * @param iField the field, from 0 to GetFieldCount()-1.
+ *
+ * @return an array of GetFeatureCount() values, or NULL if the field is
+ * not a date or time field. Values of unset fields are undefined.
+ */
+
+const OGRField *OGRFeatureBatch::GetFieldAsDateTimeArray( int iField )
+
+{
+    if( iField < 0 || iField >= nFieldCount
+        || pasFields[iField].nKind != OFB_DATETIME )
+        return NULL;
+
+    return (const OGRField *) pasFields[iField].pFixed;
+}
+
+/************************************************************************/
+/*                            GetFieldData()                            */
+/************************************************************************/
+
+/**
+ * \brief Return the buffer of a variable length field.
+ *
+ * The value of the i-th feature is in the [(*ppanOffsets)[i],
+ * (*ppanOffsets)[i+1]) range of the returned buffer. OFTString values
+ * are not nul-terminated. OFTIntegerList and OFTRealList values are
+ * arrays of int and double, and OFTStringList values are sequences of
+ * nul-terminated strings.
+ *
+ * @param iField the field, from 0 to GetFieldCount()-1.
+ * @param ppanOffsets pointer to the location where the array of
+ * GetFeatureCount()+1 offsets is returned.
+ *
+ * @return the buffer (possibly NULL if all values are empty), or NULL with
+ * *ppanOffsets set to NULL if the field is not a variable length field.
+ */
+
+const GByte *OGRFeatureBatch::GetFieldData( int iField,
+                                            const size_t **ppanOffsets )
+
+{
+    if( iField < 0 || iField >= nFieldCount
+        || pasFields[iField].panOffsets == NULL )
+    {
+        *ppanOffsets = NULL;
+        return NULL;
+    }
+
+    *ppanOffsets = pasFields[iField].panOffsets;
+    return pasFields[iField].pabyData;
+}
+
+/************************************************************************/
+/*                          GetGeomFieldWKB()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the WKB buffer of a geometry field.
+ *
+ * The geometry of the i-th feature is in the [(*ppanOffsets)[i],
+ * (*ppanOffsets)[i+1]) range of the returned buffer, and is empty for
+ * features without geometry. The geometries may be in any byte order.
+ *
+ * @param iGeomField the geometry field.
+ * @param ppanOffsets pointer to the location where the array of
+ * GetFeatureCount()+1 offsets is returned.
+ *
+ * @return the buffer, or NULL.
+ */
+
+const GByte *OGRFeatureBatch::GetGeomFieldWKB( int iGeomField,
+                                               const size_t **ppanOffsets )
+
+{
+    if( iGeomField < 0 || iGeomField >= nGeomFieldCount )
+    {
+        *ppanOffsets = NULL;
+        return NULL;
+    }
+
+    *ppanOffsets = pasGeomFields[iGeomField].panOffsets;
+    return pasGeomFields[iGeomField].pabyData;
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Build an OGRFeature from a feature of the batch.
+ *
+ * @param iFeature index of the feature, from 0 to GetFeatureCount()-1.
+ *
+ * @return a new feature to be destroyed by the caller, or NULL.
+ */
+
+OGRFeature *OGRFeatureBatch::GetFeature( int iFeature )
+
+{
+    if( iFeature < 0 || iFeature >= nFeatureCount )
+        return NULL;
+
+    OGRFeature *poFeature = new OGRFeature( poDefn );
+    int i;
+
+    poFeature->SetFID( panFIDs[iFeature] );
+
+    for( i = 0; i < nFieldCount; i++ )
+    {
+        OGRFeatureBatchColumn *psCol = pasFields + i;
+
+        if( !psCol->pabyIsSet[iFeature] )
+            continue;
+
+        GByte *pabyData = NULL;
+        int nLength = 0;
+        if( psCol->panOffsets != NULL )
+        {
+            pabyData = psCol->pabyData + psCol->panOffsets[iFeature];
+            nLength = (int) (psCol->panOffsets[iFeature + 1]
+                             - psCol->panOffsets[iFeature]);
+        }
+
+        switch( psCol->nKind )
+        {
+            case OFB_INTEGER:
+                poFeature->SetField( i, ((int *) psCol->pFixed)[iFeature] );
+                break;
+
+            case OFB_REAL:
+                poFeature->SetField( i, ((double *) psCol->pFixed)[iFeature] );
+                break;
+
+            case OFB_DATETIME:
+                poFeature->SetField( i, ((OGRField *) psCol->pFixed) + iFeature );
+                break;
+
+            case OFB_STRING:
+            {
+                char *pszValue = (char *) CPLMalloc( nLength + 1 );
+                memcpy( pszValue, pabyData, nLength );
+                pszValue[nLength] = '\0';
+                poFeature->SetField( i, pszValue );
+                CPLFree( pszValue );
+                break;
+            }
+
+            case OFB_BINARY:
+                poFeature->SetField( i, nLength, pabyData );
+                break;
+
+            case OFB_INTLIST:
+                poFeature->SetField( i, nLength / (int) sizeof(int),
+                                     (int *) pabyData );
+                break;
+
+            case OFB_REALLIST:
+                poFeature->SetField( i, nLength / (int) sizeof(double),
+                                     (double *) pabyData );
+                break;
+
+            case OFB_STRLIST:
+            {
+                char **papszList = NULL;
+                int iOffset = 0;
+                while( iOffset < nLength )
+                {
+                    papszList = CSLAddString( papszList,
+                                              (char *) pabyData + iOffset );
+                    iOffset += (int) strlen((char *) pabyData + iOffset) + 1;
+                }
+                poFeature->SetField( i, papszList );
+                CSLDestroy( papszList );
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    for( i = 0; i < nGeomFieldCount; i++ )
+    {
+        OGRFeatureBatchColumn *psCol = pasGeomFields + i;
+        int nBytes = (int) (psCol->panOffsets[iFeature + 1]
+                            - psCol->panOffsets[iFeature]);
+
+        if( nBytes == 0 )
+            continue;
+
+        /* The geometry is only built if the caller asks for it */
+        poFeature->SetGeomFieldWKB( i,
+                                    psCol->pabyData + psCol->panOffsets[iFeature],
+                                    nBytes );
+    }
+
+    return poFeature;
+}
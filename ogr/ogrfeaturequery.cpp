@@ -55,6 +55,7 @@ OGRFeatureQuery::OGRFeatureQuery()
 {
     poTargetDefn = NULL;
     pSWQExpr = NULL;
+    poCompiledExpr = NULL;
 }
 
 /************************************************************************/
@@ -64,6 +65,7 @@ OGRFeatureQuery::OGRFeatureQuery()
 OGRFeatureQuery::~OGRFeatureQuery()
 
 {
+    delete poCompiledExpr;
     delete (swq_expr_node *) pSWQExpr;
 }
 
@@ -78,6 +80,9 @@ OGRErr OGRFeatureQuery::Compile( OGRFeatureDefn *poDefn,
 /* -------------------------------------------------------------------- */
 /*      Clear any existing expression.                                  */
 /* -------------------------------------------------------------------- */
+    delete poCompiledExpr;
+    poCompiledExpr = NULL;
+
     if( pSWQExpr != NULL )
     {
         delete (swq_expr_node *) pSWQExpr;
@@ -165,6 +170,17 @@ OGRErr OGRFeatureQuery::Compile( OGRFeatureDefn *poDefn,
         pSWQExpr = NULL;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Turn the expression into a program that can be evaluated        */
+/*      without allocating intermediate nodes, when possible.           */
+/* -------------------------------------------------------------------- */
+    else if( CSLTestBoolean(
+                 CPLGetConfigOption( "OGR_SQL_COMPILE_EXPRESSIONS", "YES" ) ) )
+    {
+        poCompiledExpr =
+            swq_compiled_expr::Compile( (swq_expr_node *) pSWQExpr );
+    }
+
     CPLFree( papszFieldNames );
     CPLFree( paeFieldTypes );
 
@@ -213,6 +229,50 @@ static swq_expr_node *OGRFeatureFetcher( swq_expr_node *op, void *pFeatureIn )
     return poRetNode;
 }
 
+/************************************************************************/
+/*                       OGRFeatureValueFetcher()                       */
+/*                                                                      */
+/*      Fetcher of the compiled expression. String values of fields     */
+/*      that are not strings are formatted in a temporary buffer of     */
+/*      the feature, so they must be copied.                            */
+/************************************************************************/
+
+static void OGRFeatureValueFetcher( swq_expr_node *op, void *pFeatureIn,
+                                    swq_value *psValue )
+
+{
+    OGRFeature *poFeature = (OGRFeature *) pFeatureIn;
+
+    switch( op->field_type )
+    {
+      case SWQ_INTEGER:
+      case SWQ_BOOLEAN:
+        psValue->int_value = poFeature->GetFieldAsInteger(op->field_index);
+        break;
+
+      case SWQ_FLOAT:
+        psValue->float_value = poFeature->GetFieldAsDouble(op->field_index);
+        break;
+
+      default:
+      {
+        const char *pszValue = poFeature->GetFieldAsString(op->field_index);
+        if( op->field_index < poFeature->GetFieldCount() &&
+            poFeature->GetFieldDefnRef(op->field_index)->GetType()
+                                                            == OFTString )
+            psValue->string_value = pszValue;
+        else
+        {
+            psValue->osStorage = pszValue;
+            psValue->string_value = psValue->osStorage.c_str();
+        }
+        break;
+      }
+    }
+
+    psValue->is_null = !(poFeature->IsFieldSet(op->field_index));
+}
+
 /************************************************************************/
 /*                              Evaluate()                              */
 /************************************************************************/
@@ -223,6 +283,10 @@ int OGRFeatureQuery::Evaluate( OGRFeature *poFeature )
     if( pSWQExpr == NULL )
         return FALSE;
 
+    if( poCompiledExpr != NULL )
+        return poCompiledExpr->EvaluateBoolean( OGRFeatureValueFetcher,
+                                                (void *) poFeature );
+
     swq_expr_node *poResult;
 
     poResult = ((swq_expr_node *) pSWQExpr)->Evaluate( OGRFeatureFetcher,
@@ -240,6 +304,178 @@ int OGRFeatureQuery::Evaluate( OGRFeature *poFeature )
     return bLogicalResult;
 }
 
+/************************************************************************/
+/*                          OGRGetRangeBound()                          */
+/*                                                                      */
+/*      Convert a constant to a bound of a range query on an index of   */
+/*      a field of the given type, if the comparison would be done      */
+/*      the same way by the index and by the expression evaluator.      */
+/************************************************************************/
+
+static int OGRGetRangeBound( swq_expr_node *poValue, OGRFieldType eType,
+                             OGRField *psBound )
+
+{
+    if( poValue->eNodeType != SNT_CONSTANT || poValue->is_null )
+        return FALSE;
+
+    switch( eType )
+    {
+      case OFTInteger:
+      case OFTReal:
+        if( poValue->field_type == SWQ_INTEGER )
+            psBound->Real = poValue->int_value;
+        else if( poValue->field_type == SWQ_FLOAT )
+            psBound->Real = poValue->float_value;
+        else
+            return FALSE;
+        return TRUE;
+
+      case OFTString:
+      case OFTDate:
+      case OFTTime:
+      case OFTDateTime:
+        if( (poValue->field_type == SWQ_STRING
+             || poValue->field_type == SWQ_DATE
+             || poValue->field_type == SWQ_TIME
+             || poValue->field_type == SWQ_TIMESTAMP)
+            && poValue->string_value != NULL )
+        {
+            psBound->String = poValue->string_value;
+            return TRUE;
+        }
+        return FALSE;
+
+      default:
+        return FALSE;
+    }
+}
+
+/************************************************************************/
+/*                          OGRGetLikePrefix()                          */
+/*                                                                      */
+/*      Analyze a LIKE pattern. Patterns without wildcards are          */
+/*      equality tests, and patterns that are a literal followed by     */
+/*      a single trailing '%' are prefix tests. Other patterns cannot   */
+/*      be evaluated with an index.                                     */
+/************************************************************************/
+
+static int OGRGetLikePrefix( const char *pszPattern, CPLString &osLiteral,
+                             int &bPrefix )
+
+{
+    size_t nLen = strlen(pszPattern);
+
+    bPrefix = FALSE;
+    if( nLen > 0 && pszPattern[nLen-1] == '%' )
+    {
+        bPrefix = TRUE;
+        nLen --;
+    }
+
+    for( size_t i = 0; i < nLen; i++ )
+    {
+        /* swq_test_like() folds the case of each byte with tolower() */
+        if( pszPattern[i] == '%' || pszPattern[i] == '_'
+            || (pszPattern[i] & 0x80) != 0 )
+            return FALSE;
+    }
+
+    osLiteral.assign( pszPattern, nLen );
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          OGRGetRangeIndex()                          */
+/*                                                                      */
+/*      Return the index supporting range queries with which a          */
+/*      comparison, BETWEEN, IN or LIKE operation can be evaluated,     */
+/*      or NULL. *piColumn is set to the position of the column in      */
+/*      the operands.                                                   */
+/************************************************************************/
+
+static OGRAttrIndex *OGRGetRangeIndex( swq_expr_node *psExpr,
+                                       OGRLayer *poLayer, int *piColumn )
+
+{
+    int iColumn = 0;
+
+    switch( psExpr->nOperation )
+    {
+      case SWQ_EQ:
+      case SWQ_LT:
+      case SWQ_LE:
+      case SWQ_GT:
+      case SWQ_GE:
+        if( psExpr->nSubExprCount != 2 )
+            return NULL;
+        if( psExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN )
+            iColumn = 1;
+        break;
+
+      case SWQ_BETWEEN:
+        if( psExpr->nSubExprCount != 3 )
+            return NULL;
+        break;
+
+      case SWQ_IN:
+        if( psExpr->nSubExprCount < 2 )
+            return NULL;
+        break;
+
+      case SWQ_LIKE:
+        /* No ESCAPE clause */
+        if( psExpr->nSubExprCount != 2 )
+            return NULL;
+        break;
+
+      default:
+        return NULL;
+    }
+
+    swq_expr_node *poColumn = psExpr->papoSubExpr[iColumn];
+
+    if( poColumn->eNodeType != SNT_COLUMN || poColumn->table_index != 0
+        || poColumn->field_index < 0
+        || poColumn->field_index >= poLayer->GetLayerDefn()->GetFieldCount() )
+        return NULL;
+
+    OGRAttrIndex *poIndex =
+        poLayer->GetIndex()->GetFieldIndex( poColumn->field_index );
+    if( poIndex == NULL || !poIndex->SupportsRangeQueries() )
+        return NULL;
+
+    OGRFieldType eType = poLayer->GetLayerDefn()->
+                            GetFieldDefn(poColumn->field_index)->GetType();
+    OGRField sBound;
+
+    if( psExpr->nOperation == SWQ_LIKE )
+    {
+        CPLString osLiteral;
+        int bPrefix;
+
+        if( eType != OFTString
+            || psExpr->papoSubExpr[1]->eNodeType != SNT_CONSTANT
+            || psExpr->papoSubExpr[1]->field_type != SWQ_STRING
+            || psExpr->papoSubExpr[1]->string_value == NULL
+            || !OGRGetLikePrefix( psExpr->papoSubExpr[1]->string_value,
+                                  osLiteral, bPrefix ) )
+            return NULL;
+    }
+    else
+    {
+        for( int i = 0; i < psExpr->nSubExprCount; i++ )
+        {
+            if( i != iColumn &&
+                !OGRGetRangeBound( psExpr->papoSubExpr[i], eType, &sBound ) )
+                return NULL;
+        }
+    }
+
+    *piColumn = iColumn;
+    return poIndex;
+}
+
 /************************************************************************/
 /*                            CanUseIndex()                             */
 /************************************************************************/
@@ -276,6 +512,10 @@ int OGRFeatureQuery::CanUseIndex( swq_expr_node *psExpr,
                CanUseIndex( psExpr->papoSubExpr[1], poLayer );
     }
 
+    int iColumn;
+    if( OGRGetRangeIndex( psExpr, poLayer, &iColumn ) != NULL )
+        return TRUE;
+
     if( !(psExpr->nOperation == SWQ_EQ || psExpr->nOperation == SWQ_IN)
         || psExpr->nSubExprCount < 2 )
         return FALSE;
@@ -306,18 +546,20 @@ int OGRFeatureQuery::CanUseIndex( swq_expr_node *psExpr,
 /*      available indices, or an "OGRNullFID" terminated list of        */
 /*      FIDs if it can.                                                 */
 /*                                                                      */
-/*      For now we only support equality tests on a single indexed      */
-/*      attribute field.  Eventually we should make this support        */
-/*      multi-part queries with ranges.                                 */
+/*      Equality tests, and combinations of them with AND and OR, are   */
+/*      supported. Indexes supporting range queries can also evaluate   */
+/*      <, <=, >, >=, BETWEEN, and LIKE with a 'prefix%' pattern.       */
 /************************************************************************/
 
-static int CompareLong(const void *a, const void *b)
+static int CompareGIntBig(const void *a, const void *b)
 {
-	return (*(const long *)a) - (*(const long *)b);
+    const GIntBig nA = *(const GIntBig *)a;
+    const GIntBig nB = *(const GIntBig *)b;
+    return (nA < nB) ? -1 : (nA > nB) ? 1 : 0;
 }
 
-long *OGRFeatureQuery::EvaluateAgainstIndices( OGRLayer *poLayer, 
-                                               OGRErr *peErr )
+GIntBig *OGRFeatureQuery::EvaluateAgainstIndices( OGRLayer *poLayer, 
+                                                  OGRErr *peErr )
 
 {
     swq_expr_node *psExpr = (swq_expr_node *) pSWQExpr;
@@ -337,11 +579,11 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( OGRLayer *poLayer,
 
 /* The input arrays must be sorted ! */
 static
-long* OGRORLongArray(long panFIDList1[], int nFIDCount1,
-                     long panFIDList2[], int nFIDCount2, int& nFIDCount)
+GIntBig* OGRORGIntBigArray(GIntBig panFIDList1[], int nFIDCount1,
+                           GIntBig panFIDList2[], int nFIDCount2, int& nFIDCount)
 {
     int nMaxCount = nFIDCount1 + nFIDCount2;
-    long* panFIDList = (long*) CPLMalloc((nMaxCount+1) * sizeof(long));
+    GIntBig* panFIDList = (GIntBig*) CPLMalloc((nMaxCount+1) * sizeof(GIntBig));
     nFIDCount = 0;
 
     int i1 = 0, i2 =0;
@@ -349,8 +591,8 @@ long* OGRORLongArray(long panFIDList1[], int nFIDCount1,
     {
         if (i1 < nFIDCount1 && i2 < nFIDCount2)
         {
-            long nVal1 = panFIDList1[i1];
-            long nVal2 = panFIDList2[i2];
+            GIntBig nVal1 = panFIDList1[i1];
+            GIntBig nVal2 = panFIDList2[i2];
             if (nVal1 < nVal2)
             {
                 if (i1+1 < nFIDCount1 && panFIDList1[i1+1] <= nVal2)
@@ -390,13 +632,13 @@ long* OGRORLongArray(long panFIDList1[], int nFIDCount1,
         }
         else if (i1 < nFIDCount1)
         {
-            long nVal1 = panFIDList1[i1];
+            GIntBig nVal1 = panFIDList1[i1];
             panFIDList[nFIDCount ++] = nVal1;
             i1 ++;
         }
         else if (i2 < nFIDCount2)
         {
-            long nVal2 = panFIDList2[i2];
+            GIntBig nVal2 = panFIDList2[i2];
             panFIDList[nFIDCount ++] = nVal2;
             i2 ++;
         }
@@ -409,18 +651,18 @@ long* OGRORLongArray(long panFIDList1[], int nFIDCount1,
 
 /* The input arrays must be sorted ! */
 static
-long* OGRANDLongArray(long panFIDList1[], int nFIDCount1,
-                      long panFIDList2[], int nFIDCount2, int& nFIDCount)
+GIntBig* OGRANDGIntBigArray(GIntBig panFIDList1[], int nFIDCount1,
+                            GIntBig panFIDList2[], int nFIDCount2, int& nFIDCount)
 {
     int nMaxCount = MAX(nFIDCount1, nFIDCount2);
-    long* panFIDList = (long*) CPLMalloc((nMaxCount+1) * sizeof(long));
+    GIntBig* panFIDList = (GIntBig*) CPLMalloc((nMaxCount+1) * sizeof(GIntBig));
     nFIDCount = 0;
 
     int i1 = 0, i2 =0;
     for(;i1<nFIDCount1 && i2<nFIDCount2;)
     {
-        long nVal1 = panFIDList1[i1];
-        long nVal2 = panFIDList2[i2];
+        GIntBig nVal1 = panFIDList1[i1];
+        GIntBig nVal2 = panFIDList2[i2];
         if (nVal1 < nVal2)
         {
             if (i1+1 < nFIDCount1 && panFIDList1[i1+1] <= nVal2)
@@ -458,9 +700,9 @@ long* OGRANDLongArray(long panFIDList1[], int nFIDCount1,
     return panFIDList;
 }
 
-long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
-                                               OGRLayer *poLayer,
-                                               int& nFIDCount )
+GIntBig *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
+                                                  OGRLayer *poLayer,
+                                                  int& nFIDCount )
 {
     OGRAttrIndex *poIndex;
 
@@ -475,18 +717,18 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
          psExpr->nSubExprCount == 2)
     {
         int nFIDCount1 = 0, nFIDCount2 = 0;
-        long* panFIDList1 = EvaluateAgainstIndices( psExpr->papoSubExpr[0], poLayer, nFIDCount1 );
-        long* panFIDList2 = panFIDList1 == NULL ? NULL :
+        GIntBig* panFIDList1 = EvaluateAgainstIndices( psExpr->papoSubExpr[0], poLayer, nFIDCount1 );
+        GIntBig* panFIDList2 = panFIDList1 == NULL ? NULL :
                             EvaluateAgainstIndices( psExpr->papoSubExpr[1], poLayer, nFIDCount2 );
-        long* panFIDList = NULL;
+        GIntBig* panFIDList = NULL;
         if (panFIDList1 != NULL && panFIDList2 != NULL)
         {
             if (psExpr->nOperation == SWQ_OR )
-                panFIDList = OGRORLongArray(panFIDList1, nFIDCount1,
-                                            panFIDList2, nFIDCount2, nFIDCount);
+                panFIDList = OGRORGIntBigArray(panFIDList1, nFIDCount1,
+                                               panFIDList2, nFIDCount2, nFIDCount);
             else if (psExpr->nOperation == SWQ_AND )
-                panFIDList = OGRANDLongArray(panFIDList1, nFIDCount1,
-                                            panFIDList2, nFIDCount2, nFIDCount);
+                panFIDList = OGRANDGIntBigArray(panFIDList1, nFIDCount1,
+                                                panFIDList2, nFIDCount2, nFIDCount);
 
         }
         CPLFree(panFIDList1);
@@ -494,6 +736,12 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
         return panFIDList;
     }
 
+    int iColumn;
+    poIndex = OGRGetRangeIndex( psExpr, poLayer, &iColumn );
+    if( poIndex != NULL )
+        return EvaluateAgainstRangeIndex( psExpr, iColumn, poIndex,
+                                          poLayer, nFIDCount );
+
     if( !(psExpr->nOperation == SWQ_EQ || psExpr->nOperation == SWQ_IN)
         || psExpr->nSubExprCount < 2 )
         return NULL;
@@ -523,7 +771,7 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
     if (psExpr->nOperation == SWQ_IN)
     {
         int nLength;
-        long *panFIDs = NULL;
+        GIntBig *panFIDs = NULL;
         int iIN;
 
         for( iIN = 1; iIN < psExpr->nSubExprCount; iIN++ )
@@ -556,7 +804,7 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
         if (nFIDCount > 1)
         {
             /* the returned FIDs are expected to be in sorted order */
-            qsort(panFIDs, nFIDCount, sizeof(long), CompareLong);
+            qsort(panFIDs, nFIDCount, sizeof(GIntBig), CompareGIntBig);
         }
         return panFIDs;
     }
@@ -587,15 +835,130 @@ long *OGRFeatureQuery::EvaluateAgainstIndices( swq_expr_node *psExpr,
     }
 
     int nLength = 0;
-    long *panFIDs = poIndex->GetAllMatches( &sValue, NULL, &nFIDCount, &nLength );
+    GIntBig *panFIDs = poIndex->GetAllMatches( &sValue, NULL, &nFIDCount, &nLength );
     if (nFIDCount > 1)
     {
         /* the returned FIDs are expected to be in sorted order */
-        qsort(panFIDs, nFIDCount, sizeof(long), CompareLong);
+        qsort(panFIDs, nFIDCount, sizeof(GIntBig), CompareGIntBig);
     }
     return panFIDs;
 }
 
+/************************************************************************/
+/*                     EvaluateAgainstRangeIndex()                      */
+/*                                                                      */
+/*      Evaluate an operation accepted by OGRGetRangeIndex().           */
+/************************************************************************/
+
+GIntBig *OGRFeatureQuery::EvaluateAgainstRangeIndex( swq_expr_node *psExpr,
+                                                     int iColumn,
+                                                     OGRAttrIndex *poIndex,
+                                                     OGRLayer *poLayer,
+                                                     int& nFIDCount )
+{
+    OGRFieldType eType = poLayer->GetLayerDefn()->GetFieldDefn(
+        psExpr->papoSubExpr[iColumn]->field_index)->GetType();
+    OGRField sBound1, sBound2;
+
+    if( psExpr->nOperation == SWQ_LIKE )
+    {
+        CPLString osLiteral;
+        int bPrefix;
+
+        OGRGetLikePrefix( psExpr->papoSubExpr[1]->string_value,
+                          osLiteral, bPrefix );
+        if( bPrefix )
+            return poIndex->GetPrefixMatches( osLiteral, &nFIDCount );
+
+        sBound1.String = (char *) osLiteral.c_str();
+        return poIndex->GetRangeMatches( &sBound1, TRUE, &sBound1, TRUE,
+                                         &nFIDCount );
+    }
+
+    if( psExpr->nOperation == SWQ_IN )
+    {
+        GIntBig *panFIDs = NULL;
+
+        nFIDCount = 0;
+        for( int iIN = 1; iIN < psExpr->nSubExprCount; iIN++ )
+        {
+            int nValueFIDCount = 0;
+
+            OGRGetRangeBound( psExpr->papoSubExpr[iIN], eType, &sBound1 );
+            GIntBig *panValueFIDs =
+                poIndex->GetRangeMatches( &sBound1, TRUE, &sBound1, TRUE,
+                                          &nValueFIDCount );
+            if( panValueFIDs == NULL )
+            {
+                CPLFree( panFIDs );
+                return NULL;
+            }
+
+            if( panFIDs == NULL )
+            {
+                panFIDs = panValueFIDs;
+                nFIDCount = nValueFIDCount;
+            }
+            else
+            {
+                GIntBig *panUnion =
+                    OGRORGIntBigArray( panFIDs, nFIDCount,
+                                       panValueFIDs, nValueFIDCount,
+                                       nFIDCount );
+                CPLFree( panFIDs );
+                CPLFree( panValueFIDs );
+                panFIDs = panUnion;
+            }
+        }
+        return panFIDs;
+    }
+
+    if( psExpr->nOperation == SWQ_BETWEEN )
+    {
+        OGRGetRangeBound( psExpr->papoSubExpr[1], eType, &sBound1 );
+        OGRGetRangeBound( psExpr->papoSubExpr[2], eType, &sBound2 );
+        return poIndex->GetRangeMatches( &sBound1, TRUE, &sBound2, TRUE,
+                                         &nFIDCount );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Comparison, with the operator mirrored if the constant comes    */
+/*      first.                                                          */
+/* -------------------------------------------------------------------- */
+    int nOperation = psExpr->nOperation;
+
+    OGRGetRangeBound( psExpr->papoSubExpr[1 - iColumn], eType, &sBound1 );
+    if( iColumn == 1 )
+    {
+        if( nOperation == SWQ_LT )
+            nOperation = SWQ_GT;
+        else if( nOperation == SWQ_LE )
+            nOperation = SWQ_GE;
+        else if( nOperation == SWQ_GT )
+            nOperation = SWQ_LT;
+        else if( nOperation == SWQ_GE )
+            nOperation = SWQ_LE;
+    }
+
+    switch( nOperation )
+    {
+      case SWQ_LT:
+      case SWQ_LE:
+        return poIndex->GetRangeMatches( NULL, FALSE,
+                                         &sBound1, nOperation == SWQ_LE,
+                                         &nFIDCount );
+
+      case SWQ_GT:
+      case SWQ_GE:
+        return poIndex->GetRangeMatches( &sBound1, nOperation == SWQ_GE,
+                                         NULL, FALSE, &nFIDCount );
+
+      default:
+        return poIndex->GetRangeMatches( &sBound1, TRUE, &sBound1, TRUE,
+                                         &nFIDCount );
+    }
+}
+
 /************************************************************************/
 /*                         OGRFieldCollector()                          */
 /*                                                                      */
@@ -33,6 +33,7 @@
 #include "ogr_api.h"
 #include "ogr_p.h"
 #include "ogr_geos.h"
+#include <vector>
 
 CPL_CVSID("$Id$");
 
@@ -2488,6 +2489,259 @@ OGRGeometry* OGRGeometryFactory::transformWithOptions( const OGRGeometry* poSrcG
     return poDstGeom;
 }
 
+/************************************************************************/
+/*                   OGRCollectTransformableParts()                     */
+/*                                                                      */
+/*      Collect the points and line strings of a geometry and of all    */
+/*      its sub-geometries, with their number of points (-1 for         */
+/*      points).  Returns FALSE for unhandled geometry types.           */
+/************************************************************************/
+
+static int OGRCollectTransformableParts( OGRGeometry *poGeom,
+                                         std::vector<OGRGeometry*>& apoParts,
+                                         std::vector<int>& anPartPoints,
+                                         std::vector<OGRGeometry*>& apoAll )
+{
+    apoAll.push_back( poGeom );
+
+    switch( wkbFlatten(poGeom->getGeometryType()) )
+    {
+        case wkbPoint:
+            apoParts.push_back( poGeom );
+            anPartPoints.push_back( -1 );
+            return TRUE;
+
+        case wkbLineString:
+            apoParts.push_back( poGeom );
+            anPartPoints.push_back( ((OGRLineString *) poGeom)->getNumPoints() );
+            return TRUE;
+
+        case wkbPolygon:
+        {
+            OGRPolygon *poPoly = (OGRPolygon *) poGeom;
+            if( poPoly->getExteriorRing() == NULL )
+                return TRUE;
+            if( !OGRCollectTransformableParts( poPoly->getExteriorRing(),
+                                               apoParts, anPartPoints,
+                                               apoAll ) )
+                return FALSE;
+            for( int i = 0; i < poPoly->getNumInteriorRings(); i++ )
+            {
+                if( !OGRCollectTransformableParts( poPoly->getInteriorRing(i),
+                                                   apoParts, anPartPoints,
+                                                   apoAll ) )
+                    return FALSE;
+            }
+            return TRUE;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        {
+            OGRGeometryCollection *poColl = (OGRGeometryCollection *) poGeom;
+            for( int i = 0; i < poColl->getNumGeometries(); i++ )
+            {
+                if( !OGRCollectTransformableParts( poColl->getGeometryRef(i),
+                                                   apoParts, anPartPoints,
+                                                   apoAll ) )
+                    return FALSE;
+            }
+            return TRUE;
+        }
+
+        default:
+            return FALSE;
+    }
+}
+
+/************************************************************************/
+/*                        transformGeometries()                         */
+/************************************************************************/
+
+/**
+ * \brief Transform several geometries with a single transformation call.
+ *
+ * The coordinates of all the geometries are gathered into a single array, 
+ * transformed with one call to OGRCoordinateTransformation::TransformEx(),
+ * and written back.  This avoids the overhead of a transformation call per 
+ * line string or point, which dominates for small geometries.
+ *
+ * Geometries with points that fail to transform are transformed again
+ * with OGRGeometry::transform(), so the result for each geometry is the same
+ * as with OGRGeometry::transform(), including regarding the
+ * OGR_ENABLE_PARTIAL_REPROJECTION configuration option.
+ *
+ * The transformation object may be shared by several threads calling this
+ * method concurrently.
+ *
+ * @param poCT the transformation to apply.
+ * @param nGeomCount the number of geometries.
+ * @param papoGeoms the array of nGeomCount geometries, modified in place.
+ * NULL entries are skipped.
+ * @param paeErrors an optional array of nGeomCount error codes, set to
+ * the result of the transformation of each geometry.
+ *
+ * @return OGRERR_NONE if all geometries were transformed, or the error of
+ * the first one that failed.
+ *
+ * @since GDAL 2.0
+ */
+
+OGRErr OGRGeometryFactory::transformGeometries( 
+                                    OGRCoordinateTransformation *poCT,
+                                    int nGeomCount, OGRGeometry **papoGeoms,
+                                    OGRErr *paeErrors )
+
+{
+#ifdef DISABLE_OGRGEOM_TRANSFORM
+    return OGRERR_FAILURE;
+#else
+    std::vector<OGRGeometry*> apoParts;
+    std::vector<int> anPartPoints;
+    std::vector<OGRGeometry*> apoAll;
+    /* Index of the first part, and of the first geometry in apoAll, of */
+    /* each geometry.  A geometry with no part in apoAll is transformed */
+    /* individually. */
+    std::vector<int> anFirstPart( nGeomCount + 1 );
+    std::vector<int> anFirstAll( nGeomCount + 1 );
+    int iGeom;
+    size_t iPart, nPoints = 0;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the parts of the geometries, and count their points.    */
+/* -------------------------------------------------------------------- */
+    for( iGeom = 0; iGeom < nGeomCount; iGeom++ )
+    {
+        anFirstPart[iGeom] = (int) apoParts.size();
+        anFirstAll[iGeom] = (int) apoAll.size();
+        if( papoGeoms[iGeom] != NULL &&
+            !OGRCollectTransformableParts( papoGeoms[iGeom], apoParts,
+                                           anPartPoints, apoAll ) )
+        {
+            apoParts.resize( anFirstPart[iGeom] );
+            anPartPoints.resize( anFirstPart[iGeom] );
+            apoAll.resize( anFirstAll[iGeom] );
+        }
+    }
+    anFirstPart[nGeomCount] = (int) apoParts.size();
+    anFirstAll[nGeomCount] = (int) apoAll.size();
+
+    for( iPart = 0; iPart < apoParts.size(); iPart++ )
+        nPoints += (anPartPoints[iPart] < 0) ? 1 : anPartPoints[iPart];
+
+    if( nPoints > (size_t) INT_MAX )
+        return OGRERR_NOT_ENOUGH_MEMORY;
+
+    double *padfXYZ = (double *) VSIMalloc2( sizeof(double) * 3,
+                                             MAX(1, nPoints) );
+    int *pabSuccess = (int *) VSIMalloc2( sizeof(int), MAX(1, nPoints) );
+    if( padfXYZ == NULL || pabSuccess == NULL )
+    {
+        VSIFree( padfXYZ );
+        VSIFree( pabSuccess );
+        return OGRERR_NOT_ENOUGH_MEMORY;
+    }
+    double *padfX = padfXYZ;
+    double *padfY = padfXYZ + nPoints;
+    double *padfZ = padfXYZ + 2 * nPoints;
+
+/* -------------------------------------------------------------------- */
+/*      Gather the coordinates and transform them at once.              */
+/* -------------------------------------------------------------------- */
+    size_t iPoint = 0;
+    for( iPart = 0; iPart < apoParts.size(); iPart++ )
+    {
+        if( anPartPoints[iPart] < 0 )
+        {
+            OGRPoint *poPoint = (OGRPoint *) apoParts[iPart];
+            padfX[iPoint] = poPoint->getX();
+            padfY[iPoint] = poPoint->getY();
+            padfZ[iPoint] = poPoint->getZ();
+            iPoint ++;
+        }
+        else
+        {
+            ((OGRLineString *) apoParts[iPart])->getPoints(
+                padfX + iPoint, sizeof(double),
+                padfY + iPoint, sizeof(double),
+                padfZ + iPoint, sizeof(double) );
+            iPoint += anPartPoints[iPart];
+        }
+    }
+
+    if( nPoints > 0 &&
+        !poCT->TransformEx( (int) nPoints, padfX, padfY, padfZ, pabSuccess ) )
+        memset( pabSuccess, 0, sizeof(int) * nPoints );
+
+/* -------------------------------------------------------------------- */
+/*      Write back the coordinates of the geometries whose points all   */
+/*      transformed, and transform the others individually.             */
+/* -------------------------------------------------------------------- */
+    OGRErr eResult = OGRERR_NONE;
+    OGRSpatialReference *poTargetSRS = poCT->GetTargetCS();
+    size_t iFirstPoint = 0;
+
+    for( iGeom = 0; iGeom < nGeomCount; iGeom++ )
+    {
+        OGRErr eErr = OGRERR_NONE;
+        size_t nGeomPoints = 0;
+        int i, bAllSuccess = TRUE;
+
+        for( i = anFirstPart[iGeom]; i < anFirstPart[iGeom+1]; i++ )
+            nGeomPoints += (anPartPoints[i] < 0) ? 1 : anPartPoints[i];
+        for( iPoint = iFirstPoint; 
+             iPoint < iFirstPoint + nGeomPoints && bAllSuccess; iPoint++ )
+            bAllSuccess = pabSuccess[iPoint];
+
+        if( papoGeoms[iGeom] == NULL )
+            /* nothing to do */;
+        else if( anFirstAll[iGeom] == anFirstAll[iGeom+1] || !bAllSuccess )
+            eErr = papoGeoms[iGeom]->transform( poCT );
+        else
+        {
+            iPoint = iFirstPoint;
+            for( i = anFirstPart[iGeom]; i < anFirstPart[iGeom+1]; i++ )
+            {
+                if( anPartPoints[i] < 0 )
+                {
+                    OGRPoint *poPoint = (OGRPoint *) apoParts[i];
+                    poPoint->setX( padfX[iPoint] );
+                    poPoint->setY( padfY[iPoint] );
+                    if( poPoint->getCoordinateDimension() == 3 )
+                        poPoint->setZ( padfZ[iPoint] );
+                    iPoint ++;
+                }
+                else
+                {
+                    OGRLineString *poLS = (OGRLineString *) apoParts[i];
+                    poLS->setPoints( anPartPoints[i], padfX + iPoint,
+                                     padfY + iPoint,
+                                     poLS->getCoordinateDimension() == 3 ?
+                                        padfZ + iPoint : NULL );
+                    iPoint += anPartPoints[i];
+                }
+            }
+            for( i = anFirstAll[iGeom]; i < anFirstAll[iGeom+1]; i++ )
+                apoAll[i]->assignSpatialReference( poTargetSRS );
+        }
+
+        iFirstPoint += nGeomPoints;
+
+        if( paeErrors != NULL )
+            paeErrors[iGeom] = eErr;
+        if( eErr != OGRERR_NONE && eResult == OGRERR_NONE )
+            eResult = eErr;
+    }
+
+    VSIFree( padfXYZ );
+    VSIFree( pabSuccess );
+
+    return eResult;
+#endif
+}
+
 /************************************************************************/
 /*                        approximateArcAngles()                        */
 /************************************************************************/
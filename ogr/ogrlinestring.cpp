@@ -49,6 +49,7 @@ OGRLineString::OGRLineString()
     nPointCount = 0;
     paoPoints = NULL;
     padfZ = NULL;
+    nPointCapacity = 0;
 }
 
 /************************************************************************/
@@ -58,10 +59,92 @@ OGRLineString::OGRLineString()
 OGRLineString::~OGRLineString()
 
 {
-    if( paoPoints != NULL )
+    FreePoints();
+}
+
+/************************************************************************/
+/*                             FreePoints()                             */
+/************************************************************************/
+
+void OGRLineString::FreePoints()
+
+{
+    if( paoPoints != aoInlinePoints )
         OGRFree( paoPoints );
+    paoPoints = NULL;
+
+    OGRFree( padfZ );
+    padfZ = NULL;
+
+    nPointCapacity = 0;
+}
+
+/************************************************************************/
+/*                          SetPointCapacity()                          */
+/*                                                                      */
+/*      Grow the point arrays so that they can hold at least            */
+/*      nNewCapacity points. Up to OGR_LINESTRING_INLINE_POINTS         */
+/*      points are stored in the object itself. The Z array is always   */
+/*      allocated, with the same capacity.                              */
+/************************************************************************/
+
+int OGRLineString::SetPointCapacity( int nNewCapacity )
+
+{
+    if( nNewCapacity <= nPointCapacity )
+        return TRUE;
+
+    if( nNewCapacity > INT_MAX / (int) sizeof(OGRRawPoint) )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Could not allocate array for %d points", nNewCapacity);
+        return FALSE;
+    }
+
+    OGRRawPoint *paoNewPoints;
+
+    if( nNewCapacity <= OGR_LINESTRING_INLINE_POINTS )
+    {
+        /* nPointCapacity is 0, otherwise it would be large enough */
+        paoNewPoints = aoInlinePoints;
+        nNewCapacity = OGR_LINESTRING_INLINE_POINTS;
+    }
+    else if( paoPoints == aoInlinePoints )
+    {
+        paoNewPoints = (OGRRawPoint *)
+            VSIMalloc( sizeof(OGRRawPoint) * nNewCapacity );
+        if( paoNewPoints != NULL )
+            memcpy( paoNewPoints, aoInlinePoints,
+                    sizeof(OGRRawPoint) * nPointCount );
+    }
+    else
+        paoNewPoints = (OGRRawPoint *)
+            VSIRealloc( paoPoints, sizeof(OGRRawPoint) * nNewCapacity );
+
+    if( paoNewPoints == NULL )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Could not allocate array for %d points", nNewCapacity);
+        return FALSE;
+    }
+    paoPoints = paoNewPoints;
+
     if( padfZ != NULL )
-        OGRFree( padfZ );
+    {
+        double* padfNewZ = (double *)
+            VSIRealloc( padfZ, sizeof(double) * nNewCapacity );
+        if( padfNewZ == NULL )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Could not allocate array for %d points", nNewCapacity);
+            return FALSE;
+        }
+        padfZ = padfNewZ;
+    }
+
+    nPointCapacity = nNewCapacity;
+
+    return TRUE;
 }
 
 /************************************************************************/
@@ -187,10 +270,10 @@ void OGRLineString::Make3D()
 {
     if( padfZ == NULL )
     {
-        if( nPointCount == 0 )
+        if( nPointCapacity == 0 )
             padfZ = (double *) OGRCalloc(sizeof(double),1);
         else
-            padfZ = (double *) OGRCalloc(sizeof(double),nPointCount);
+            padfZ = (double *) OGRCalloc(sizeof(double),nPointCapacity);
     }
     nCoordDimension = 3;
 }
@@ -293,7 +376,10 @@ double OGRLineString::getZ( int iVertex ) const
  *
  * This method primary exists to preset the number of points in a linestring
  * geometry before setPoint() is used to assign them to avoid reallocating
- * the array larger with each call to addPoint(). 
+ * the array larger with each call to addPoint(). Note that the arrays are
+ * grown by more than one point at once when points are added, and that
+ * they are not shrunk when the number of points decreases, except when it
+ * becomes 0.
  *
  * This method has no SFCOM analog.
  *
@@ -305,44 +391,45 @@ void OGRLineString::setNumPoints( int nNewPointCount, int bZeroizeNewContent )
 {
     if( nNewPointCount == 0 )
     {
-        OGRFree( paoPoints );
-        paoPoints = NULL;
-        
-        OGRFree( padfZ );
-        padfZ = NULL;
-        
+        FreePoints();
         nPointCount = 0;
         return;
     }
 
     if( nNewPointCount > nPointCount )
     {
-        OGRRawPoint* paoNewPoints = (OGRRawPoint *)
-            VSIRealloc(paoPoints, sizeof(OGRRawPoint) * nNewPointCount);
-        if (paoNewPoints == NULL)
+/* -------------------------------------------------------------------- */
+/*      Grow the arrays geometrically when points are appended, so      */
+/*      that building a line with addPoint() is not quadratic.          */
+/* -------------------------------------------------------------------- */
+        if( nNewPointCount > nPointCapacity )
         {
-            CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "Could not allocate array for %d points", nNewPointCount);
-            return;
+            int nNewCapacity = nNewPointCount;
+            if( nPointCount > 0 && nPointCapacity < INT_MAX / 3 )
+                nNewCapacity = MAX( nNewPointCount,
+                                    nPointCapacity + nPointCapacity / 2 );
+            if( !SetPointCapacity( nNewCapacity ) )
+                return;
         }
-        paoPoints = paoNewPoints;
-        
+
         if( bZeroizeNewContent )
             memset( paoPoints + nPointCount,
                 0, sizeof(OGRRawPoint) * (nNewPointCount - nPointCount) );
         
         if( getCoordinateDimension() == 3 )
         {
-            double* padfNewZ = (double *)
-                VSIRealloc( padfZ, sizeof(double)*nNewPointCount );
-            if (padfNewZ == NULL)
+            if( padfZ == NULL )
             {
-                CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "Could not allocate array for %d points", nNewPointCount);
-                return;
+                padfZ = (double *)
+                    VSICalloc( sizeof(double), nPointCapacity );
+                if( padfZ == NULL )
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                        "Could not allocate array for %d points", nNewPointCount);
+                    return;
+                }
             }
-            padfZ = padfNewZ;
-            if( bZeroizeNewContent )
+            else if( bZeroizeNewContent )
                 memset( padfZ + nPointCount, 0,
                     sizeof(double) * (nNewPointCount - nPointCount) );
         }
@@ -1098,30 +1185,29 @@ OGRErr OGRLineString::importFromWkt( char ** ppszInput )
 /*      Read the point list.                                            */
 /* -------------------------------------------------------------------- */
     int      nMaxPoint = 0;
+    int      nNewPointCount = 0;
+    OGRRawPoint *paoNewPoints = NULL;
+    double   *padfNewZ = NULL;
 
-    nPointCount = 0;
-
-    pszInput = OGRWktReadPoints( pszInput, &paoPoints, &padfZ, &nMaxPoint,
-                                 &nPointCount );
+    pszInput = OGRWktReadPoints( pszInput, &paoNewPoints, &padfNewZ,
+                                 &nMaxPoint, &nNewPointCount );
     if( pszInput == NULL )
+    {
+        CPLFree( paoNewPoints );
+        CPLFree( padfNewZ );
         return OGRERR_CORRUPT_DATA;
+    }
 
     *ppszInput = (char *) pszInput;
 
-    if( padfZ == NULL )
-        nCoordDimension = 2;
+    /* Ignore Z array when we have a LINESTRING M */
+    if( bHasM && !bHasZ )
+        setPoints( nNewPointCount, paoNewPoints, NULL );
     else
-    {
-        /* Ignore Z array when we have a LINESTRING M */
-        if (bHasM && !bHasZ)
-        {
-            nCoordDimension = 2;
-            CPLFree(padfZ);
-            padfZ = NULL;
-        }
-        else
-            nCoordDimension = 3;
-    }
+        setPoints( nNewPointCount, paoNewPoints, padfNewZ );
+
+    CPLFree( paoNewPoints );
+    CPLFree( padfNewZ );
     
     return OGRERR_NONE;
 }
@@ -1854,15 +1940,11 @@ void OGRLineString::segmentize( double dfMaxLength )
         }
     }
 
-    OGRFree(paoPoints);
-    paoPoints = paoNewPoints;
-    nPointCount = nNewPointCount;
+    if( nNewPointCount > 0 )
+        setPoints( nNewPointCount, paoNewPoints, padfNewZ );
 
-    if( nCoordinateDimension == 3 )
-    {
-        OGRFree(padfZ);
-        padfZ = padfNewZ;
-    }
+    OGRFree(paoNewPoints);
+    OGRFree(padfNewZ);
 }
 
 /************************************************************************/
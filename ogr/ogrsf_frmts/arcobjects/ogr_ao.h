@@ -70,13 +70,13 @@ public:
 
   virtual void        ResetReading();
   virtual OGRFeature* GetNextFeature();
-  virtual OGRFeature* GetFeature( long nFeatureId );
+  virtual OGRFeature* GetFeature( GIntBig nFeatureId );
 
   HRESULT GetTable(ITable** ppTable);
 
 
   virtual OGRErr      GetExtent( OGREnvelope *psExtent, int bForce );
-  virtual int         GetFeatureCount( int bForce );
+  virtual GIntBig     GetFeatureCount( int bForce );
   virtual OGRErr      SetAttributeFilter( const char *pszQuery );
   virtual void 	      SetSpatialFilterRect (double dfMinX, double dfMinY, double dfMaxX, double dfMaxY);
   virtual void        SetSpatialFilter( OGRGeometry * );
@@ -87,7 +87,7 @@ public:
 
   virtual OGRErr      SetFeature( OGRFeature *poFeature );
   virtual OGRErr      CreateFeature( OGRFeature *poFeature );
-  virtual OGRErr      DeleteFeature( long nFID );
+  virtual OGRErr      DeleteFeature( GIntBig nFID );
 */
    OGRFeatureDefn *    GetLayerDefn() { return m_pFeatureDefn; }
 
@@ -123,8 +123,8 @@ class OGRCARTODBTableLayer : public OGRCARTODBLayer
     virtual const char*         GetName() { return osName.c_str(); }
     virtual OGRFeatureDefn *    GetLayerDefn();
 
-    virtual int                 GetFeatureCount( int bForce = TRUE );
-    virtual OGRFeature         *GetFeature( long nFeatureId );
+    virtual GIntBig             GetFeatureCount( int bForce = TRUE );
+    virtual OGRFeature         *GetFeature( GIntBig nFeatureId );
 
     virtual int                 TestCapability( const char * );
 
@@ -133,7 +133,7 @@ class OGRCARTODBTableLayer : public OGRCARTODBLayer
 
     virtual OGRErr      CreateFeature( OGRFeature *poFeature );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
-    virtual OGRErr      DeleteFeature( long nFID );
+    virtual OGRErr      DeleteFeature( GIntBig nFID );
 
     virtual void        SetSpatialFilter( OGRGeometry *poGeom ) { SetSpatialFilter(0, poGeom); }
     virtual void        SetSpatialFilter( int iGeomField, OGRGeometry *poGeom );
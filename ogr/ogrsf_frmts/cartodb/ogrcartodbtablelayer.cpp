@@ -446,7 +446,7 @@ OGRErr OGRCARTODBTableLayer::CreateFeature( OGRFeature *poFeature )
             else
                 bMustComma = TRUE;
 
-            osSQL += CPLSPrintf("%ld", poFeature->GetFID());
+            osSQL += CPLSPrintf(CPL_FRMT_GIB, poFeature->GetFID());
         }
 
         osSQL += ")";
@@ -587,7 +587,7 @@ OGRErr OGRCARTODBTableLayer::SetFeature( OGRFeature *poFeature )
         }
     }
 
-    osSQL += CPLSPrintf(" WHERE %s = %ld",
+    osSQL += CPLSPrintf(" WHERE %s = " CPL_FRMT_GIB,
                     OGRCARTODBEscapeIdentifier(osFIDColName).c_str(),
                     poFeature->GetFID());
     
@@ -621,7 +621,7 @@ OGRErr OGRCARTODBTableLayer::SetFeature( OGRFeature *poFeature )
 /*                          DeleteFeature()                             */
 /************************************************************************/
 
-OGRErr OGRCARTODBTableLayer::DeleteFeature( long nFID )
+OGRErr OGRCARTODBTableLayer::DeleteFeature( GIntBig nFID )
 
 {
     GetLayerDefn();
@@ -637,7 +637,7 @@ OGRErr OGRCARTODBTableLayer::DeleteFeature( long nFID )
         return OGRERR_FAILURE;
     
     CPLString osSQL;
-    osSQL.Printf("DELETE FROM %s WHERE %s = %ld",
+    osSQL.Printf("DELETE FROM %s WHERE %s = " CPL_FRMT_GIB,
                     OGRCARTODBEscapeIdentifier(osName).c_str(),
                     OGRCARTODBEscapeIdentifier(osFIDColName).c_str(),
                     nFID);
@@ -758,14 +758,14 @@ void OGRCARTODBTableLayer::BuildWhere()
 /*                              GetFeature()                            */
 /************************************************************************/
 
-OGRFeature* OGRCARTODBTableLayer::GetFeature( long nFeatureId )
+OGRFeature* OGRCARTODBTableLayer::GetFeature( GIntBig nFeatureId )
 {
     GetLayerDefn();
     
     if( osFIDColName.size() == 0 )
         return OGRCARTODBLayer::GetFeature(nFeatureId);
 
-    CPLString osSQL(CPLSPrintf("SELECT * FROM %s WHERE %s = %ld",
+    CPLString osSQL(CPLSPrintf("SELECT * FROM %s WHERE %s = " CPL_FRMT_GIB,
                                OGRCARTODBEscapeIdentifier(osName).c_str(),
                                OGRCARTODBEscapeIdentifier(osFIDColName).c_str(),
                                nFeatureId));
@@ -789,7 +789,7 @@ OGRFeature* OGRCARTODBTableLayer::GetFeature( long nFeatureId )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRCARTODBTableLayer::GetFeatureCount(int bForce)
+GIntBig OGRCARTODBTableLayer::GetFeatureCount(int bForce)
 {
     GetLayerDefn();
 
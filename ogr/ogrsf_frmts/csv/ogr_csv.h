@@ -116,7 +116,7 @@ class OGRCSVLayer : public OGRLayer
     void                SetCreateCSVT(int bCreateCSVT);
     void                SetWriteBOM(int bWriteBOM);
 
-    virtual int         GetFeatureCount( int bForce = TRUE );
+    virtual GIntBig     GetFeatureCount( int bForce = TRUE );
 
     OGRErr              WriteHeader();
 };
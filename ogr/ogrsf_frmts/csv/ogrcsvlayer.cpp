@@ -1404,7 +1404,7 @@ void OGRCSVLayer::SetWriteBOM(int bWriteBOM)
 /*                        GetFeatureCount()                             */
 /************************************************************************/
 
-int OGRCSVLayer::GetFeatureCount( int bForce )
+GIntBig OGRCSVLayer::GetFeatureCount( int bForce )
 {
     if (bInWriteMode || m_poFilterGeom != NULL || m_poAttrQuery != NULL)
         return OGRLayer::GetFeatureCount(bForce);
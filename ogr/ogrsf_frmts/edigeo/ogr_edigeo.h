@@ -66,8 +66,8 @@ class OGREDIGEOLayer : public OGRLayer
 
     virtual void                ResetReading();
     virtual OGRFeature *        GetNextFeature();
-    virtual OGRFeature *        GetFeature(long nFID);
-    virtual int                 GetFeatureCount( int bForce );
+    virtual OGRFeature *        GetFeature(GIntBig nFID);
+    virtual GIntBig             GetFeatureCount( int bForce );
 
     virtual OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
@@ -82,3 +82,38 @@ OGRAttrIndex::OGRAttrIndex()
 OGRAttrIndex::~OGRAttrIndex()
 {
 }
+
+/************************************************************************/
+/*                        SupportsRangeQueries()                        */
+/************************************************************************/
+
+int OGRAttrIndex::SupportsRangeQueries()
+
+{
+    return FALSE;
+}
+
+/************************************************************************/
+/*                          GetRangeMatches()                           */
+/************************************************************************/
+
+GIntBig *OGRAttrIndex::GetRangeMatches( OGRField * /*psMin*/,
+                                        int /*bMinIncluded*/,
+                                        OGRField * /*psMax*/,
+                                        int /*bMaxIncluded*/,
+                                        int * /*pnFIDCount*/ )
+
+{
+    return NULL;
+}
+
+/************************************************************************/
+/*                          GetPrefixMatches()                          */
+/************************************************************************/
+
+GIntBig *OGRAttrIndex::GetPrefixMatches( const char * /*pszPrefix*/,
+                                         int * /*pnFIDCount*/ )
+
+{
+    return NULL;
+}
@@ -0,0 +1,1587 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Persistent B-tree attribute indexes, usable by any driver, that
+ *           support equality and range queries.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_attrind.h"
+#include "swq.h"
+#include "cpl_minixml.h"
+#include <vector>
+#include <algorithm>
+
+CPL_CVSID("$Id$");
+
+/*
+** The indexes of a layer are listed in a XML metadata file (.oim), and
+** each index is stored in its own .oix file, made of pages of the same
+** size. All values are little endian.
+**
+** Page 0 is the header :
+**    8 bytes : signature "OGRBTIDX"
+**    GUInt32 : version (1)
+**    GUInt32 : page size
+**    GUInt32 : key type (BTK_INTEGER, BTK_REAL or BTK_STRING)
+**    GUInt32 : key size, in bytes
+**    GUInt64 : number of entries
+**    GUInt32 : number of leaf pages
+**    GUInt32 : number of levels of the tree, leaves included
+**    GUInt32 : number of the root page (0 for an empty index)
+**
+** The leaf pages are the pages 1 to the number of leaf pages, in key
+** order. Each page starts with a GUInt32 entry count, followed by the
+** entries (key, 64 bit FID), sorted by key and then by FID. The pages of
+** the upper levels follow. They start with a GUInt32 entry count, followed
+** by the first key of each child page and the GUInt32 child page number.
+**
+** Integer keys are 32 bit signed integers, and real keys are doubles.
+** String keys, also used for date and time fields with their OGR SQL
+** string representation, are zero padded to the length of the longest
+** value, and are ordered case insensitively like OGR SQL compares strings.
+**
+** The tree is built in one pass from the sorted entries. When entries are
+** added to an existing index, it is rebuilt before being queried again.
+*/
+
+#define BTREE_SIGNATURE         "OGRBTIDX"
+#define BTREE_VERSION           1
+#define BTREE_HEADER_SIZE       44
+#define BTREE_MIN_PAGE_SIZE     4096
+#define BTREE_MIN_PAGE_ENTRIES  8
+#define BTREE_MAX_STRING_SIZE   1024
+
+#define BTK_INTEGER             1
+#define BTK_REAL                2
+#define BTK_STRING              3
+
+/************************************************************************/
+/*                          OGRBTreeAttrIndex                           */
+/*                                                                      */
+/*      B-tree index of one field. For date and time fields, the key    */
+/*      given to AddEntry() is the string representation of the         */
+/*      value (OGRFeature::GetFieldAsString()) in the String member.    */
+/************************************************************************/
+
+class OGRBTreeLayerAttrIndex;
+
+class OGRBTreeAttrIndex : public OGRAttrIndex
+{
+public:
+    OGRBTreeLayerAttrIndex *poLIndex;
+    int         iField;
+    int         eKeyType;
+    CPLString   osFilename;
+    int         bBuilding;
+
+    /* Reading state */
+    VSILFILE   *fp;
+    GUInt32     nPageSize;
+    GUInt32     nKeySize;
+    GUIntBig    nEntryCount;
+    GUInt32     nLeafPages;
+    GUInt32     nLevels;
+    GUInt32     nRootPage;
+    std::vector<GByte> abyPage;
+    GUInt32     nCachedPage;
+    std::vector<char> achKey;
+
+    /* Building state */
+    swq_external_sort *poSorter;
+    size_t      nMaxStringLength;
+
+                OGRBTreeAttrIndex( OGRBTreeLayerAttrIndex *, int iField,
+                                   int eKeyType, const char *pszFilename );
+               ~OGRBTreeAttrIndex();
+
+    OGRErr      Open();
+    void        Close();
+    OGRErr      StartBuild( int bKeepEntries );
+    OGRErr      Flush();
+    OGRErr      WriteTree();
+
+    const GByte *ReadPage( GUInt32 nPage );
+    const char *GetStringKey( const GByte *pabyKey );
+    int         CompareKey( const GByte *pabyKey, const OGRField *psBound );
+    GIntBig     GetEntryFID( const GByte *pabyEntry );
+    int         AddRecordFromEntry( const GByte *pabyEntry );
+    int         Scan( const OGRField *psMin, int bMinIncluded,
+                      const OGRField *psMax, int bMaxIncluded,
+                      const char *pszPrefix, std::vector<GIntBig>& anFIDs );
+    GIntBig    *BuildFIDList( std::vector<GIntBig>& anFIDs,
+                              int *pnFIDCount );
+    int         KeyToBound( const OGRField *psKey, OGRField *psBound );
+
+    static int  CompareRecords( const GByte *pabyRecord1,
+                                const GByte *pabyRecord2,
+                                void *pUserData );
+
+    /* base class virtual methods */
+    GIntBig     GetFirstMatch( OGRField *psKey );
+    GIntBig    *GetAllMatches( OGRField *psKey );
+    GIntBig    *GetAllMatches( OGRField *psKey, GIntBig* panFIDList, int* nFIDCount, int* nLength );
+
+    OGRErr      AddEntry( OGRField *psKey, GIntBig nFID );
+    OGRErr      RemoveEntry( OGRField *psKey, GIntBig nFID );
+
+    OGRErr      Clear();
+
+    int         SupportsRangeQueries();
+    GIntBig    *GetRangeMatches( OGRField *psMin, int bMinIncluded,
+                                 OGRField *psMax, int bMaxIncluded,
+                                 int *pnFIDCount );
+    GIntBig    *GetPrefixMatches( const char *pszPrefix, int *pnFIDCount );
+};
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        OGRBTreeLayerAttrIndex                        */
+/* ==================================================================== */
+/************************************************************************/
+
+class OGRBTreeLayerAttrIndex : public OGRLayerAttrIndex
+{
+public:
+    int         nIndexCount;
+    OGRBTreeAttrIndex **papoIndexList;
+
+    char        *pszMetadataFilename;
+
+                OGRBTreeLayerAttrIndex();
+    virtual     ~OGRBTreeLayerAttrIndex();
+
+    /* base class virtual methods */
+    OGRErr      Initialize( const char *pszIndexPath, OGRLayer * );
+    OGRErr      CreateIndex( int iField );
+    OGRErr      DropIndex( int iField );
+    OGRErr      IndexAllFeatures( int iField = -1 );
+
+    OGRErr      AddToIndex( OGRFeature *poFeature, int iField = -1 );
+    OGRErr      RemoveFromIndex( OGRFeature *poFeature );
+
+    OGRAttrIndex *GetFieldIndex( int iField );
+
+    /* custom to OGRBTreeLayerAttrIndex */
+    OGRBTreeAttrIndex *FindIndex( int iField );
+    OGRErr      SaveConfigToXML();
+    OGRErr      LoadConfigFromXML();
+
+    OGRLayer   *GetLayer() { return poLayer; }
+};
+
+/************************************************************************/
+/*                          GetFieldKeyType()                           */
+/************************************************************************/
+
+static int GetFieldKeyType( OGRFieldType eType )
+
+{
+    switch( eType )
+    {
+      case OFTInteger:
+        return BTK_INTEGER;
+
+      case OFTReal:
+        return BTK_REAL;
+
+      case OFTString:
+      case OFTDate:
+      case OFTTime:
+      case OFTDateTime:
+        return BTK_STRING;
+
+      default:
+        return 0;
+    }
+}
+
+/************************************************************************/
+/*                       OGRBTreeLayerAttrIndex()                       */
+/************************************************************************/
+
+OGRBTreeLayerAttrIndex::OGRBTreeLayerAttrIndex()
+
+{
+    nIndexCount = 0;
+    papoIndexList = NULL;
+    pszMetadataFilename = NULL;
+}
+
+/************************************************************************/
+/*                      ~OGRBTreeLayerAttrIndex()                       */
+/************************************************************************/
+
+OGRBTreeLayerAttrIndex::~OGRBTreeLayerAttrIndex()
+
+{
+    for( int i = 0; i < nIndexCount; i++ )
+        delete papoIndexList[i];
+    CPLFree( papoIndexList );
+
+    CPLFree( pszMetadataFilename );
+}
+
+/************************************************************************/
+/*                             Initialize()                             */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::Initialize( const char *pszIndexPathIn,
+                                           OGRLayer *poLayerIn )
+
+{
+    if( poLayerIn == poLayer )
+        return OGRERR_NONE;
+
+    poLayer = poLayerIn;
+    pszIndexPath = CPLStrdup( pszIndexPathIn );
+    pszMetadataFilename = CPLStrdup(
+        CPLResetExtension( pszIndexPathIn, "oim" ) );
+
+/* -------------------------------------------------------------------- */
+/*      If a metadata file already exists, load it.                     */
+/* -------------------------------------------------------------------- */
+    VSIStatBufL sStat;
+
+    if( VSIStatL( pszMetadataFilename, &sStat ) == 0 )
+        return LoadConfigFromXML();
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         LoadConfigFromXML()                          */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::LoadConfigFromXML()
+
+{
+    CPLXMLNode *psRoot = CPLParseXMLFile( pszMetadataFilename );
+
+    if( psRoot == NULL )
+        return OGRERR_FAILURE;
+
+    CPLXMLNode *psIndexList = CPLGetXMLNode( psRoot,
+                                             "=OGRBTreeLayerAttrIndex" );
+    if( psIndexList == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "%s is not an attribute index metadata file.",
+                  pszMetadataFilename );
+        CPLDestroyXMLNode( psRoot );
+        return OGRERR_FAILURE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Process each index. The fields are identified by their name,    */
+/*      so that the indexes survive changes in the field order.         */
+/* -------------------------------------------------------------------- */
+    OGRFeatureDefn *poDefn = poLayer->GetLayerDefn();
+    CPLXMLNode *psAttrIndex;
+
+    for( psAttrIndex = psIndexList->psChild;
+         psAttrIndex != NULL;
+         psAttrIndex = psAttrIndex->psNext )
+    {
+        if( psAttrIndex->eType != CXT_Element
+            || !EQUAL(psAttrIndex->pszValue,"OGRBTreeAttrIndex") )
+            continue;
+
+        const char *pszFieldName = CPLGetXMLValue(psAttrIndex,"FieldName","");
+        const char *pszFilename = CPLGetXMLValue(psAttrIndex,"Filename","");
+        int iField = poDefn->GetFieldIndex( pszFieldName );
+
+        if( iField < 0 || pszFilename[0] == '\0' || FindIndex(iField) )
+        {
+            CPLError( CE_Warning, CPLE_AppDefined,
+                      "Skipping attribute index of field '%s' in %s.",
+                      pszFieldName, pszMetadataFilename );
+            continue;
+        }
+
+        OGRBTreeAttrIndex *poAttrInd =
+            new OGRBTreeAttrIndex( this, iField,
+                    GetFieldKeyType(poDefn->GetFieldDefn(iField)->GetType()),
+                    CPLFormFilename( CPLGetPath(pszMetadataFilename),
+                                     pszFilename, NULL ) );
+        if( poAttrInd->Open() != OGRERR_NONE )
+        {
+            CPLError( CE_Warning, CPLE_AppDefined,
+                      "Skipping attribute index of field '%s' in %s.",
+                      pszFieldName, pszMetadataFilename );
+            delete poAttrInd;
+            continue;
+        }
+
+        nIndexCount++;
+        papoIndexList = (OGRBTreeAttrIndex **)
+            CPLRealloc(papoIndexList, sizeof(void*) * nIndexCount);
+        papoIndexList[nIndexCount-1] = poAttrInd;
+    }
+
+    CPLDestroyXMLNode( psRoot );
+
+    CPLDebug( "OGR", "Restored %d field indexes for layer %s from %s.",
+              nIndexCount, poDefn->GetName(), pszMetadataFilename );
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                          SaveConfigToXML()                           */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::SaveConfigToXML()
+
+{
+    if( nIndexCount == 0 )
+    {
+        VSIUnlink( pszMetadataFilename );
+        return OGRERR_NONE;
+    }
+
+    CPLXMLNode *psRoot;
+
+    psRoot = CPLCreateXMLNode( NULL, CXT_Element, "OGRBTreeLayerAttrIndex" );
+
+    for( int i = 0; i < nIndexCount; i++ )
+    {
+        OGRBTreeAttrIndex *poAI = papoIndexList[i];
+        CPLXMLNode *psIndex;
+
+        psIndex = CPLCreateXMLNode( psRoot, CXT_Element, "OGRBTreeAttrIndex" );
+
+        CPLCreateXMLElementAndValue( psIndex, "FieldName",
+            poLayer->GetLayerDefn()->GetFieldDefn(poAI->iField)->GetNameRef() );
+        CPLCreateXMLElementAndValue( psIndex, "Filename",
+                                     CPLGetFilename( poAI->osFilename ) );
+    }
+
+    int bOK = CPLSerializeXMLTreeToFile( psRoot, pszMetadataFilename );
+    CPLDestroyXMLNode( psRoot );
+
+    return bOK ? OGRERR_NONE : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                          IndexAllFeatures()                          */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::IndexAllFeatures( int iField )
+
+{
+    OGRFeature *poFeature;
+    OGRErr      eErr = OGRERR_NONE;
+
+    poLayer->ResetReading();
+
+    while( eErr == OGRERR_NONE &&
+           (poFeature = poLayer->GetNextFeature()) != NULL )
+    {
+        eErr = AddToIndex( poFeature, iField );
+
+        delete poFeature;
+    }
+
+    poLayer->ResetReading();
+
+/* -------------------------------------------------------------------- */
+/*      Write the trees.                                                */
+/* -------------------------------------------------------------------- */
+    for( int i = 0; i < nIndexCount; i++ )
+    {
+        OGRBTreeAttrIndex *poAI = papoIndexList[i];
+
+        if( iField != -1 && iField != poAI->iField )
+            continue;
+
+        poAI->bBuilding = FALSE;
+        if( eErr == OGRERR_NONE )
+            eErr = poAI->Flush();
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                            CreateIndex()                             */
+/*                                                                      */
+/*      Create an empty index for the indicated field. Use              */
+/*      IndexAllFeatures() to populate it.                              */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::CreateIndex( int iField )
+
+{
+    OGRFieldDefn *poFldDefn=poLayer->GetLayerDefn()->GetFieldDefn(iField);
+
+    if( FindIndex( iField ) != NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "It seems we already have an index for field %d/%s\n"
+                  "of layer %s.",
+                  iField, poFldDefn->GetNameRef(),
+                  poLayer->GetLayerDefn()->GetName() );
+        return OGRERR_FAILURE;
+    }
+
+    int eKeyType = GetFieldKeyType( poFldDefn->GetType() );
+    if( eKeyType == 0 )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Indexing not support for the field type of field %s.",
+                  poFldDefn->GetNameRef() );
+        return OGRERR_FAILURE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Find a file name not used by another index of the layer.        */
+/* -------------------------------------------------------------------- */
+    CPLString osFilename;
+
+    for( int nSuffix = iField; TRUE; nSuffix++ )
+    {
+        osFilename = CPLFormFilename(
+            CPLGetPath(pszMetadataFilename),
+            CPLSPrintf("%s_%d", CPLGetBasename(pszMetadataFilename), nSuffix),
+            "oix" );
+
+        int i;
+        for( i = 0; i < nIndexCount; i++ )
+        {
+            if( papoIndexList[i]->osFilename == osFilename )
+                break;
+        }
+        if( i == nIndexCount )
+            break;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write an empty index, to check that we can.                     */
+/* -------------------------------------------------------------------- */
+    OGRBTreeAttrIndex *poAttrInd =
+        new OGRBTreeAttrIndex( this, iField, eKeyType, osFilename );
+
+    if( poAttrInd->StartBuild( FALSE ) != OGRERR_NONE ||
+        poAttrInd->Flush() != OGRERR_NONE )
+    {
+        delete poAttrInd;
+        return OGRERR_FAILURE;
+    }
+    poAttrInd->bBuilding = TRUE;
+
+    nIndexCount++;
+    papoIndexList = (OGRBTreeAttrIndex **)
+        CPLRealloc(papoIndexList, sizeof(void*) * nIndexCount);
+    papoIndexList[nIndexCount-1] = poAttrInd;
+
+    return SaveConfigToXML();
+}
+
+/************************************************************************/
+/*                             DropIndex()                              */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::DropIndex( int iField )
+
+{
+    int i;
+    OGRFieldDefn *poFldDefn=poLayer->GetLayerDefn()->GetFieldDefn(iField);
+
+    for( i = 0; i < nIndexCount; i++ )
+    {
+        if( papoIndexList[i]->iField == iField )
+            break;
+    }
+
+    if( i == nIndexCount )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "DROP INDEX on field (%s) that doesn't have an index.",
+                  poFldDefn->GetNameRef() );
+        return OGRERR_FAILURE;
+    }
+
+    OGRBTreeAttrIndex *poAI = papoIndexList[i];
+
+    memmove( papoIndexList + i, papoIndexList + i + 1,
+             sizeof(void*) * (nIndexCount - i - 1) );
+    nIndexCount--;
+
+    CPLString osFilename = poAI->osFilename;
+    delete poAI;
+    VSIUnlink( osFilename );
+
+    return SaveConfigToXML();
+}
+
+/************************************************************************/
+/*                             FindIndex()                              */
+/************************************************************************/
+
+OGRBTreeAttrIndex *OGRBTreeLayerAttrIndex::FindIndex( int iField )
+
+{
+    for( int i = 0; i < nIndexCount; i++ )
+    {
+        if( papoIndexList[i]->iField == iField )
+            return papoIndexList[i];
+    }
+
+    return NULL;
+}
+
+/************************************************************************/
+/*                           GetFieldIndex()                            */
+/*                                                                      */
+/*      Indexes are not visible until they are fully built.             */
+/************************************************************************/
+
+OGRAttrIndex *OGRBTreeLayerAttrIndex::GetFieldIndex( int iField )
+
+{
+    OGRBTreeAttrIndex *poAI = FindIndex( iField );
+
+    if( poAI != NULL && poAI->bBuilding )
+        return NULL;
+
+    return poAI;
+}
+
+/************************************************************************/
+/*                             AddToIndex()                             */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::AddToIndex( OGRFeature *poFeature,
+                                           int iTargetField )
+
+{
+    OGRErr eErr = OGRERR_NONE;
+
+    if( poFeature->GetFID() == OGRNullFID )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Attempt to index feature with no FID." );
+        return OGRERR_FAILURE;
+    }
+
+    for( int i = 0; i < nIndexCount && eErr == OGRERR_NONE; i++ )
+    {
+        int iField = papoIndexList[i]->iField;
+
+        if( iTargetField != -1 && iTargetField != iField )
+            continue;
+
+        if( !poFeature->IsFieldSet( iField ) )
+            continue;
+
+        OGRFieldType eType = poFeature->GetFieldDefnRef(iField)->GetType();
+        if( eType == OFTDate || eType == OFTTime || eType == OFTDateTime )
+        {
+            OGRField sKey;
+            sKey.String = (char *) poFeature->GetFieldAsString( iField );
+            eErr = papoIndexList[i]->AddEntry( &sKey, poFeature->GetFID() );
+        }
+        else
+            eErr = papoIndexList[i]->AddEntry(
+                poFeature->GetRawFieldRef( iField ), poFeature->GetFID() );
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                          RemoveFromIndex()                           */
+/************************************************************************/
+
+OGRErr OGRBTreeLayerAttrIndex::RemoveFromIndex( OGRFeature * /*poFeature*/ )
+
+{
+    return OGRERR_UNSUPPORTED_OPERATION;
+}
+
+/************************************************************************/
+/*                      OGRCreateBTreeLayerIndex()                      */
+/************************************************************************/
+
+OGRLayerAttrIndex *OGRCreateBTreeLayerIndex()
+
+{
+    return new OGRBTreeLayerAttrIndex();
+}
+
+/************************************************************************/
+/*                  OGRInitializeSidecarIndexSupport()                  */
+/*                                                                      */
+/*      Initialize attribute index support for a layer of a driver      */
+/*      without its own attribute indexes. The index files are put      */
+/*      next to the datasource, or in it if it is a directory, and      */
+/*      named after the layer. Only file based datasources, with        */
+/*      layers supporting random reading, can be indexed. If bCreate    */
+/*      is FALSE, index support is initialized only if the layer        */
+/*      already has indexes.                                            */
+/************************************************************************/
+
+OGRErr OGRInitializeSidecarIndexSupport( GDALDataset *poDS,
+                                         OGRLayer *poLayer, int bCreate )
+
+{
+    if( poLayer->GetIndex() != NULL )
+        return OGRERR_NONE;
+
+    const char *pszDSName = poDS->GetDescription();
+    VSIStatBufL sStat;
+
+    if( VSIStatL( pszDSName, &sStat ) != 0 ||
+        !poLayer->TestCapability( OLCRandomRead ) )
+        return OGRERR_FAILURE;
+
+/* -------------------------------------------------------------------- */
+/*      Form the index path from the layer name, without the            */
+/*      characters that are not allowed in file names.                  */
+/* -------------------------------------------------------------------- */
+    CPLString osLayerName = poLayer->GetName();
+
+    for( size_t i = 0; i < osLayerName.size(); i++ )
+    {
+        if( strchr( "/\\:*?\"<>|. ", osLayerName[i] ) != NULL )
+            osLayerName[i] = '_';
+    }
+
+    CPLString osIndexPath;
+    if( VSI_ISDIR(sStat.st_mode) )
+        osIndexPath = CPLFormFilename( pszDSName, osLayerName, "oim" );
+    else
+        osIndexPath = CPLFormFilename( CPLGetPath(pszDSName),
+                                       CPLSPrintf("%s_%s",
+                                                  CPLGetBasename(pszDSName),
+                                                  osLayerName.c_str()),
+                                       "oim" );
+
+    if( !bCreate && VSIStatL( osIndexPath, &sStat ) != 0 )
+        return OGRERR_FAILURE;
+
+    return poLayer->InitializeIndexSupport( osIndexPath );
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          OGRBTreeAttrIndex                           */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                         OGRBTreeAttrIndex()                          */
+/************************************************************************/
+
+OGRBTreeAttrIndex::OGRBTreeAttrIndex( OGRBTreeLayerAttrIndex *poLayerIndex,
+                                      int iFieldIn, int eKeyTypeIn,
+                                      const char *pszFilename )
+
+{
+    poLIndex = poLayerIndex;
+    iField = iFieldIn;
+    eKeyType = eKeyTypeIn;
+    osFilename = pszFilename;
+    bBuilding = FALSE;
+
+    fp = NULL;
+    nPageSize = 0;
+    nKeySize = 0;
+    nEntryCount = 0;
+    nLeafPages = 0;
+    nLevels = 0;
+    nRootPage = 0;
+    nCachedPage = 0;
+
+    poSorter = NULL;
+    nMaxStringLength = 0;
+}
+
+/************************************************************************/
+/*                         ~OGRBTreeAttrIndex()                         */
+/************************************************************************/
+
+OGRBTreeAttrIndex::~OGRBTreeAttrIndex()
+
+{
+    /* Entries added after the index was built */
+    if( poSorter != NULL && !bBuilding )
+        Flush();
+
+    delete poSorter;
+    Close();
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::Open()
+
+{
+    Close();
+
+    fp = VSIFOpenL( osFilename, "rb" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OpenFailed,
+                  "Failed to open index file %s.", osFilename.c_str() );
+        return OGRERR_FAILURE;
+    }
+
+    GByte abyHeader[BTREE_HEADER_SIZE];
+    GUInt32 nVersion, nFileKeyType;
+
+    if( VSIFReadL( abyHeader, BTREE_HEADER_SIZE, 1, fp ) != 1 ||
+        memcmp( abyHeader, BTREE_SIGNATURE, 8 ) != 0 )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "%s is not an attribute index file.", osFilename.c_str() );
+        Close();
+        return OGRERR_FAILURE;
+    }
+
+    memcpy( &nVersion, abyHeader + 8, 4 );
+    CPL_LSBPTR32( &nVersion );
+    memcpy( &nPageSize, abyHeader + 12, 4 );
+    CPL_LSBPTR32( &nPageSize );
+    memcpy( &nFileKeyType, abyHeader + 16, 4 );
+    CPL_LSBPTR32( &nFileKeyType );
+    memcpy( &nKeySize, abyHeader + 20, 4 );
+    CPL_LSBPTR32( &nKeySize );
+    memcpy( &nEntryCount, abyHeader + 24, 8 );
+    CPL_LSBPTR64( &nEntryCount );
+    memcpy( &nLeafPages, abyHeader + 32, 4 );
+    CPL_LSBPTR32( &nLeafPages );
+    memcpy( &nLevels, abyHeader + 36, 4 );
+    CPL_LSBPTR32( &nLevels );
+    memcpy( &nRootPage, abyHeader + 40, 4 );
+    CPL_LSBPTR32( &nRootPage );
+
+    if( nVersion != BTREE_VERSION || (int) nFileKeyType != eKeyType ||
+        nPageSize < BTREE_MIN_PAGE_SIZE || nKeySize == 0 ||
+        4 + BTREE_MIN_PAGE_ENTRIES * (nKeySize + 8) > nPageSize ||
+        (nEntryCount == 0) != (nRootPage == 0) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "%s is not a supported attribute index file for field %s.",
+                  osFilename.c_str(),
+                  poLIndex->GetLayer()->GetLayerDefn()->
+                                    GetFieldDefn(iField)->GetNameRef() );
+        Close();
+        return OGRERR_FAILURE;
+    }
+
+    abyPage.resize( nPageSize );
+    achKey.resize( nKeySize + 1 );
+    nCachedPage = 0;
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+void OGRBTreeAttrIndex::Close()
+
+{
+    if( fp != NULL )
+    {
+        VSIFCloseL( fp );
+        fp = NULL;
+    }
+    nCachedPage = 0;
+}
+
+/************************************************************************/
+/*                           CompareRecords()                           */
+/*                                                                      */
+/*      The records sorted to build the tree are the 64 bit FID,        */
+/*      followed by the key. String keys are zero terminated.           */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::CompareRecords( const GByte *pabyRecord1,
+                                       const GByte *pabyRecord2,
+                                       void *pUserData )
+
+{
+    OGRBTreeAttrIndex *poThis = (OGRBTreeAttrIndex *) pUserData;
+    int nRet = 0;
+
+    switch( poThis->eKeyType )
+    {
+      case BTK_INTEGER:
+      {
+          GInt32 nVal1, nVal2;
+          memcpy( &nVal1, pabyRecord1 + 8, 4 );
+          memcpy( &nVal2, pabyRecord2 + 8, 4 );
+          nRet = (nVal1 < nVal2) ? -1 : (nVal1 > nVal2) ? 1 : 0;
+          break;
+      }
+
+      case BTK_REAL:
+      {
+          double dfVal1, dfVal2;
+          memcpy( &dfVal1, pabyRecord1 + 8, 8 );
+          memcpy( &dfVal2, pabyRecord2 + 8, 8 );
+          nRet = (dfVal1 < dfVal2) ? -1 : (dfVal1 > dfVal2) ? 1 : 0;
+          break;
+      }
+
+      default:
+      {
+          const char *pszVal1 = (const char *) pabyRecord1 + 8;
+          const char *pszVal2 = (const char *) pabyRecord2 + 8;
+          nRet = strcasecmp( pszVal1, pszVal2 );
+          if( nRet == 0 )
+              nRet = strcmp( pszVal1, pszVal2 );
+          break;
+      }
+    }
+
+    if( nRet == 0 )
+    {
+        GIntBig nFID1, nFID2;
+        memcpy( &nFID1, pabyRecord1, 8 );
+        memcpy( &nFID2, pabyRecord2, 8 );
+        nRet = (nFID1 < nFID2) ? -1 : (nFID1 > nFID2) ? 1 : 0;
+    }
+
+    return nRet;
+}
+
+/************************************************************************/
+/*                             StartBuild()                             */
+/*                                                                      */
+/*      Start collecting the entries of a new tree, optionally with     */
+/*      the entries of the current one.                                 */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::StartBuild( int bKeepEntries )
+
+{
+    delete poSorter;
+    poSorter = new swq_external_sort( CompareRecords, this,
+                                      swq_get_max_memory(), FALSE );
+    nMaxStringLength = 0;
+
+    if( !bKeepEntries || fp == NULL )
+        return OGRERR_NONE;
+
+    for( GUInt32 nPage = 1; nPage <= nLeafPages; nPage++ )
+    {
+        const GByte *pabyPage = ReadPage( nPage );
+        if( pabyPage == NULL )
+            return OGRERR_FAILURE;
+
+        GUInt32 nEntries;
+        memcpy( &nEntries, pabyPage, 4 );
+        CPL_LSBPTR32( &nEntries );
+
+        for( GUInt32 i = 0; i < nEntries; i++ )
+        {
+            if( !AddRecordFromEntry( pabyPage + 4 + i * (nKeySize + 8) ) )
+                return OGRERR_FAILURE;
+        }
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                         AddRecordFromEntry()                         */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::AddRecordFromEntry( const GByte *pabyEntry )
+
+{
+    std::vector<GByte> abyRecord( 8 + nKeySize + 1, 0 );
+    GIntBig nFID = GetEntryFID( pabyEntry );
+
+    memcpy( &abyRecord[0], &nFID, 8 );
+    memcpy( &abyRecord[8], pabyEntry, nKeySize );
+
+    size_t nSize = 8 + nKeySize;
+    if( eKeyType == BTK_INTEGER )
+    {
+        CPL_LSBPTR32( &abyRecord[8] );
+    }
+    else if( eKeyType == BTK_REAL )
+    {
+        CPL_LSBPTR64( &abyRecord[8] );
+    }
+    else
+    {
+        size_t nLen = strlen( (const char *) &abyRecord[8] );
+        nMaxStringLength = MAX( nMaxStringLength, nLen );
+        nSize = 8 + nLen + 1;
+    }
+
+    return poSorter->AddRecord( &abyRecord[0], nSize );
+}
+
+/************************************************************************/
+/*                               Flush()                                */
+/*                                                                      */
+/*      Write the tree of the collected entries, if any.                */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::Flush()
+
+{
+    if( poSorter == NULL )
+        return OGRERR_NONE;
+
+    OGRErr eErr = OGRERR_FAILURE;
+    if( poSorter->Finish() )
+        eErr = WriteTree();
+
+    delete poSorter;
+    poSorter = NULL;
+
+    if( eErr == OGRERR_NONE )
+        eErr = Open();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                             WriteTree()                              */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::WriteTree()
+
+{
+    Close();
+
+/* -------------------------------------------------------------------- */
+/*      Compute the layout.                                             */
+/* -------------------------------------------------------------------- */
+    if( eKeyType == BTK_INTEGER )
+        nKeySize = 4;
+    else if( eKeyType == BTK_REAL )
+        nKeySize = 8;
+    else
+    {
+        if( nMaxStringLength > BTREE_MAX_STRING_SIZE )
+        {
+            CPLError( CE_Failure, CPLE_NotSupported,
+                      "Values of more than %d characters cannot be indexed.",
+                      BTREE_MAX_STRING_SIZE );
+            return OGRERR_FAILURE;
+        }
+        nKeySize = (GUInt32) MAX( nMaxStringLength, 1 );
+    }
+
+    nPageSize = BTREE_MIN_PAGE_SIZE;
+    while( 4 + BTREE_MIN_PAGE_ENTRIES * (nKeySize + 8) > nPageSize )
+        nPageSize *= 2;
+
+    GUInt32 nLeafCapacity = (nPageSize - 4) / (nKeySize + 8);
+    GUInt32 nNodeCapacity = (nPageSize - 4) / (nKeySize + 4);
+
+    VSILFILE *fpOut = VSIFOpenL( osFilename, "wb" );
+    if( fpOut == NULL )
+    {
+        CPLError( CE_Failure, CPLE_OpenFailed,
+                  "Failed to create %s.", osFilename.c_str() );
+        return OGRERR_FAILURE;
+    }
+
+    std::vector<GByte> abyOutPage( nPageSize, 0 );
+    int bOK = VSIFWriteL( &abyOutPage[0], nPageSize, 1, fpOut ) == 1;
+
+/* -------------------------------------------------------------------- */
+/*      Write the leaves, and collect the first key of each one, as     */
+/*      the entries of the level above.                                 */
+/* -------------------------------------------------------------------- */
+    std::vector<GByte> abyChildren;
+    GUInt32 nPage = 1;
+    GUInt32 nEntries = 0;
+    GIntBig nRecordCount = poSorter->GetRecordCount();
+
+    nEntryCount = 0;
+    for( GIntBig iRecord = 0; bOK && iRecord < nRecordCount; iRecord++ )
+    {
+        size_t nSize = 0;
+        const GByte *pabyRecord = poSorter->GetRecord( iRecord, &nSize );
+        if( pabyRecord == NULL )
+        {
+            bOK = FALSE;
+            break;
+        }
+
+        GByte *pabyEntry = &abyOutPage[4 + nEntries * (nKeySize + 8)];
+        memset( pabyEntry, 0, nKeySize );
+        memcpy( pabyEntry, pabyRecord + 8, MIN(nSize - 8, nKeySize) );
+        if( eKeyType == BTK_INTEGER )
+        {
+            CPL_LSBPTR32( pabyEntry );
+        }
+        else if( eKeyType == BTK_REAL )
+        {
+            CPL_LSBPTR64( pabyEntry );
+        }
+        memcpy( pabyEntry + nKeySize, pabyRecord, 8 );
+        CPL_LSBPTR64( pabyEntry + nKeySize );
+
+        if( nEntries == 0 )
+        {
+            size_t nOffset = abyChildren.size();
+            abyChildren.resize( nOffset + nKeySize + 4 );
+            memcpy( &abyChildren[nOffset], pabyEntry, nKeySize );
+            GUInt32 nPageLSB = CPL_LSBWORD32( nPage );
+            memcpy( &abyChildren[nOffset + nKeySize], &nPageLSB, 4 );
+        }
+
+        nEntryCount ++;
+        if( ++nEntries == nLeafCapacity || iRecord + 1 == nRecordCount )
+        {
+            GUInt32 nEntriesLSB = CPL_LSBWORD32( nEntries );
+            memcpy( &abyOutPage[0], &nEntriesLSB, 4 );
+            bOK = VSIFWriteL( &abyOutPage[0], nPageSize, 1, fpOut ) == 1;
+            memset( &abyOutPage[0], 0, nPageSize );
+            nEntries = 0;
+            nPage ++;
+        }
+    }
+    nLeafPages = nPage - 1;
+    nLevels = (nLeafPages > 0) ? 1 : 0;
+
+/* -------------------------------------------------------------------- */
+/*      Write the upper levels, until there is a single page.           */
+/* -------------------------------------------------------------------- */
+    size_t nChildSize = nKeySize + 4;
+
+    while( bOK && abyChildren.size() / nChildSize > 1 )
+    {
+        std::vector<GByte> abyParents;
+        size_t nChildren = abyChildren.size() / nChildSize;
+
+        for( size_t iChild = 0; bOK && iChild < nChildren;
+             iChild += nNodeCapacity )
+        {
+            nEntries = (GUInt32) MIN( nNodeCapacity, nChildren - iChild );
+
+            memset( &abyOutPage[0], 0, nPageSize );
+            GUInt32 nEntriesLSB = CPL_LSBWORD32( nEntries );
+            memcpy( &abyOutPage[0], &nEntriesLSB, 4 );
+            memcpy( &abyOutPage[4], &abyChildren[iChild * nChildSize],
+                    nEntries * nChildSize );
+            bOK = VSIFWriteL( &abyOutPage[0], nPageSize, 1, fpOut ) == 1;
+
+            size_t nOffset = abyParents.size();
+            abyParents.resize( nOffset + nChildSize );
+            memcpy( &abyParents[nOffset], &abyChildren[iChild * nChildSize],
+                    nKeySize );
+            GUInt32 nPageLSB = CPL_LSBWORD32( nPage );
+            memcpy( &abyParents[nOffset + nKeySize], &nPageLSB, 4 );
+            nPage ++;
+        }
+
+        abyChildren.swap( abyParents );
+        nLevels ++;
+    }
+
+    nRootPage = nLevels > 0 ? nPage - 1 : 0;
+
+/* -------------------------------------------------------------------- */
+/*      Write the header.                                               */
+/* -------------------------------------------------------------------- */
+    GByte abyHeader[BTREE_HEADER_SIZE];
+    GUInt32 nVal;
+    GUIntBig nVal64;
+
+    memcpy( abyHeader, BTREE_SIGNATURE, 8 );
+    nVal = CPL_LSBWORD32( BTREE_VERSION );
+    memcpy( abyHeader + 8, &nVal, 4 );
+    nVal = CPL_LSBWORD32( nPageSize );
+    memcpy( abyHeader + 12, &nVal, 4 );
+    nVal = CPL_LSBWORD32( eKeyType );
+    memcpy( abyHeader + 16, &nVal, 4 );
+    nVal = CPL_LSBWORD32( nKeySize );
+    memcpy( abyHeader + 20, &nVal, 4 );
+    nVal64 = nEntryCount;
+    CPL_LSBPTR64( &nVal64 );
+    memcpy( abyHeader + 24, &nVal64, 8 );
+    nVal = CPL_LSBWORD32( nLeafPages );
+    memcpy( abyHeader + 32, &nVal, 4 );
+    nVal = CPL_LSBWORD32( nLevels );
+    memcpy( abyHeader + 36, &nVal, 4 );
+    nVal = CPL_LSBWORD32( nRootPage );
+    memcpy( abyHeader + 40, &nVal, 4 );
+
+    if( bOK )
+        bOK = VSIFSeekL( fpOut, 0, SEEK_SET ) == 0 &&
+              VSIFWriteL( abyHeader, BTREE_HEADER_SIZE, 1, fpOut ) == 1;
+
+    if( VSIFCloseL( fpOut ) != 0 )
+        bOK = FALSE;
+
+    if( !bOK )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Failed to write %s.", osFilename.c_str() );
+        return OGRERR_FAILURE;
+    }
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                              ReadPage()                              */
+/************************************************************************/
+
+const GByte *OGRBTreeAttrIndex::ReadPage( GUInt32 nPage )
+
+{
+    if( nPage == nCachedPage && nCachedPage != 0 )
+        return &abyPage[0];
+
+    nCachedPage = 0;
+    if( fp == NULL ||
+        VSIFSeekL( fp, (vsi_l_offset) nPage * nPageSize, SEEK_SET ) != 0 ||
+        VSIFReadL( &abyPage[0], nPageSize, 1, fp ) != 1 )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Failed to read page %u of %s.", nPage, osFilename.c_str() );
+        return NULL;
+    }
+
+    GUInt32 nEntries;
+    memcpy( &nEntries, &abyPage[0], 4 );
+    CPL_LSBPTR32( &nEntries );
+    if( nEntries == 0 || nEntries > (nPageSize - 4) / (nKeySize + 4) ||
+        (nPage <= nLeafPages && nEntries > (nPageSize - 4) / (nKeySize + 8)) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Corrupted page %u in %s.", nPage, osFilename.c_str() );
+        return NULL;
+    }
+
+    nCachedPage = nPage;
+    return &abyPage[0];
+}
+
+/************************************************************************/
+/*                            GetStringKey()                            */
+/************************************************************************/
+
+const char *OGRBTreeAttrIndex::GetStringKey( const GByte *pabyKey )
+
+{
+    memcpy( &achKey[0], pabyKey, nKeySize );
+    achKey[nKeySize] = '\0';
+    return &achKey[0];
+}
+
+/************************************************************************/
+/*                            GetEntryFID()                             */
+/************************************************************************/
+
+GIntBig OGRBTreeAttrIndex::GetEntryFID( const GByte *pabyEntry )
+
+{
+    GIntBig nFID;
+    memcpy( &nFID, pabyEntry + nKeySize, 8 );
+    CPL_LSBPTR64( &nFID );
+    return nFID;
+}
+
+/************************************************************************/
+/*                             CompareKey()                             */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::CompareKey( const GByte *pabyKey,
+                                   const OGRField *psBound )
+
+{
+    switch( eKeyType )
+    {
+      case BTK_INTEGER:
+      {
+          GInt32 nVal;
+          memcpy( &nVal, pabyKey, 4 );
+          CPL_LSBPTR32( &nVal );
+          return (nVal < psBound->Real) ? -1 : (nVal > psBound->Real) ? 1 : 0;
+      }
+
+      case BTK_REAL:
+      {
+          double dfVal;
+          memcpy( &dfVal, pabyKey, 8 );
+          CPL_LSBPTR64( &dfVal );
+          return (dfVal < psBound->Real) ? -1 : (dfVal > psBound->Real) ? 1 : 0;
+      }
+
+      default:
+          return strcasecmp( GetStringKey( pabyKey ), psBound->String );
+    }
+}
+
+/************************************************************************/
+/*                                Scan()                                */
+/*                                                                      */
+/*      Collect the FIDs of the entries whose key is between the        */
+/*      bounds, or starts with the prefix. The tree is walked down to   */
+/*      the leaf that may hold the first matching entry, and the        */
+/*      following leaves are scanned until an entry is beyond the       */
+/*      upper bound.                                                    */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::Scan( const OGRField *psMin, int bMinIncluded,
+                             const OGRField *psMax, int bMaxIncluded,
+                             const char *pszPrefix,
+                             std::vector<GIntBig>& anFIDs )
+
+{
+    if( fp == NULL )
+        return FALSE;
+    if( nRootPage == 0 )
+        return TRUE;
+
+    OGRField sPrefix;
+    size_t nPrefixLen = 0;
+    if( pszPrefix != NULL )
+    {
+        sPrefix.String = (char *) pszPrefix;
+        psMin = &sPrefix;
+        bMinIncluded = TRUE;
+        psMax = NULL;
+        nPrefixLen = strlen( pszPrefix );
+    }
+
+    GUInt32 nPage = 1;
+
+    if( psMin != NULL )
+    {
+        nPage = nRootPage;
+        for( GUInt32 iLevel = nLevels; iLevel > 1; iLevel-- )
+        {
+            const GByte *pabyNode = ReadPage( nPage );
+            if( pabyNode == NULL )
+                return FALSE;
+
+            GUInt32 nEntries;
+            memcpy( &nEntries, pabyNode, 4 );
+            CPL_LSBPTR32( &nEntries );
+
+            /* Last child whose first key is lower than the bound */
+            int nLow = 0, nHigh = (int) nEntries - 1, iChild = 0;
+            while( nLow <= nHigh )
+            {
+                int nMid = (nLow + nHigh) / 2;
+                if( CompareKey( pabyNode + 4 + nMid * (nKeySize + 4),
+                                psMin ) < 0 )
+                {
+                    iChild = nMid;
+                    nLow = nMid + 1;
+                }
+                else
+                    nHigh = nMid - 1;
+            }
+
+            memcpy( &nPage, pabyNode + 4 + iChild * (nKeySize + 4) + nKeySize,
+                    4 );
+            CPL_LSBPTR32( &nPage );
+            if( nPage == 0 || nPage > nLeafPages + nRootPage )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined,
+                          "Corrupted index %s.", osFilename.c_str() );
+                return FALSE;
+            }
+        }
+    }
+
+    for( ; nPage <= nLeafPages; nPage++ )
+    {
+        const GByte *pabyLeaf = ReadPage( nPage );
+        if( pabyLeaf == NULL )
+            return FALSE;
+
+        GUInt32 nEntries;
+        memcpy( &nEntries, pabyLeaf, 4 );
+        CPL_LSBPTR32( &nEntries );
+
+        for( GUInt32 i = 0; i < nEntries; i++ )
+        {
+            const GByte *pabyEntry = pabyLeaf + 4 + i * (nKeySize + 8);
+
+            if( psMin != NULL )
+            {
+                int nCmp = CompareKey( pabyEntry, psMin );
+                if( nCmp < 0 || (nCmp == 0 && !bMinIncluded) )
+                    continue;
+            }
+
+            if( pszPrefix != NULL )
+            {
+                if( strncasecmp( GetStringKey( pabyEntry ), pszPrefix,
+                                 nPrefixLen ) != 0 )
+                    return TRUE;
+            }
+            else if( psMax != NULL )
+            {
+                int nCmp = CompareKey( pabyEntry, psMax );
+                if( nCmp > 0 || (nCmp == 0 && !bMaxIncluded) )
+                    return TRUE;
+            }
+
+            anFIDs.push_back( GetEntryFID( pabyEntry ) );
+        }
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                            BuildFIDList()                            */
+/************************************************************************/
+
+GIntBig *OGRBTreeAttrIndex::BuildFIDList( std::vector<GIntBig>& anFIDs,
+                                          int *pnFIDCount )
+
+{
+    std::sort( anFIDs.begin(), anFIDs.end() );
+
+    GIntBig *panFIDList = (GIntBig *)
+        CPLMalloc( sizeof(GIntBig) * (anFIDs.size() + 1) );
+    if( !anFIDs.empty() )
+        memcpy( panFIDList, &anFIDs[0], sizeof(GIntBig) * anFIDs.size() );
+    panFIDList[anFIDs.size()] = OGRNullFID;
+    *pnFIDCount = (int) anFIDs.size();
+
+    return panFIDList;
+}
+
+/************************************************************************/
+/*                             KeyToBound()                             */
+/*                                                                      */
+/*      Convert a key of the type of the field to a bound of a range    */
+/*      query.                                                          */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::KeyToBound( const OGRField *psKey, OGRField *psBound )
+
+{
+    if( psKey == NULL )
+        return FALSE;
+
+    if( eKeyType == BTK_INTEGER )
+        psBound->Real = psKey->Integer;
+    else if( eKeyType == BTK_REAL )
+        psBound->Real = psKey->Real;
+    else
+        psBound->String = psKey->String;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        SupportsRangeQueries()                        */
+/************************************************************************/
+
+int OGRBTreeAttrIndex::SupportsRangeQueries()
+
+{
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          GetRangeMatches()                           */
+/************************************************************************/
+
+GIntBig *OGRBTreeAttrIndex::GetRangeMatches( OGRField *psMin,
+                                             int bMinIncluded,
+                                             OGRField *psMax,
+                                             int bMaxIncluded,
+                                             int *pnFIDCount )
+
+{
+    std::vector<GIntBig> anFIDs;
+
+    if( Flush() != OGRERR_NONE ||
+        !Scan( psMin, bMinIncluded, psMax, bMaxIncluded, NULL, anFIDs ) )
+        return NULL;
+
+    return BuildFIDList( anFIDs, pnFIDCount );
+}
+
+/************************************************************************/
+/*                          GetPrefixMatches()                          */
+/************************************************************************/
+
+GIntBig *OGRBTreeAttrIndex::GetPrefixMatches( const char *pszPrefix,
+                                              int *pnFIDCount )
+
+{
+    std::vector<GIntBig> anFIDs;
+
+    if( eKeyType != BTK_STRING || Flush() != OGRERR_NONE ||
+        !Scan( NULL, FALSE, NULL, FALSE, pszPrefix, anFIDs ) )
+        return NULL;
+
+    return BuildFIDList( anFIDs, pnFIDCount );
+}
+
+/************************************************************************/
+/*                           GetFirstMatch()                            */
+/************************************************************************/
+
+GIntBig OGRBTreeAttrIndex::GetFirstMatch( OGRField *psKey )
+
+{
+    OGRField sBound;
+    int nFIDCount = 0;
+
+    if( !KeyToBound( psKey, &sBound ) )
+        return OGRNullFID;
+
+    GIntBig *panFIDs = GetRangeMatches( &sBound, TRUE, &sBound, TRUE,
+                                        &nFIDCount );
+    GIntBig nFID = (panFIDs != NULL) ? panFIDs[0] : OGRNullFID;
+    CPLFree( panFIDs );
+
+    return nFID;
+}
+
+/************************************************************************/
+/*                           GetAllMatches()                            */
+/*                                                                      */
+/*      Append the matches to a list that is grown as needed.           */
+/************************************************************************/
+
+GIntBig *OGRBTreeAttrIndex::GetAllMatches( OGRField *psKey,
+                                           GIntBig* panFIDList,
+                                           int* nFIDCount, int* nLength )
+
+{
+    if (panFIDList == NULL)
+    {
+        panFIDList = (GIntBig *) CPLMalloc(sizeof(GIntBig) * 2);
+        *nFIDCount = 0;
+        *nLength = 2;
+    }
+
+    OGRField sBound;
+    std::vector<GIntBig> anFIDs;
+
+    if( KeyToBound( psKey, &sBound ) && Flush() == OGRERR_NONE )
+        Scan( &sBound, TRUE, &sBound, TRUE, NULL, anFIDs );
+
+    if( *nFIDCount + (int) anFIDs.size() >= *nLength )
+    {
+        *nLength = *nFIDCount + (int) anFIDs.size() + 1;
+        panFIDList = (GIntBig *)
+            CPLRealloc(panFIDList, sizeof(GIntBig) * (*nLength));
+    }
+
+    for( size_t i = 0; i < anFIDs.size(); i++ )
+        panFIDList[(*nFIDCount)++] = anFIDs[i];
+
+    panFIDList[*nFIDCount] = OGRNullFID;
+
+    return panFIDList;
+}
+
+GIntBig *OGRBTreeAttrIndex::GetAllMatches( OGRField *psKey )
+
+{
+    int nFIDCount, nLength;
+    return GetAllMatches( psKey, NULL, &nFIDCount, &nLength );
+}
+
+/************************************************************************/
+/*                              AddEntry()                              */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::AddEntry( OGRField *psKey, GIntBig nFID )
+
+{
+    if( psKey == NULL )
+        return OGRERR_FAILURE;
+
+    /* Rebuild the tree with the new entry at the next query */
+    if( poSorter == NULL && StartBuild( TRUE ) != OGRERR_NONE )
+    {
+        delete poSorter;
+        poSorter = NULL;
+        return OGRERR_FAILURE;
+    }
+
+    std::vector<GByte> abyRecord( 16 );
+    size_t nSize;
+
+    memcpy( &abyRecord[0], &nFID, 8 );
+    if( eKeyType == BTK_INTEGER )
+    {
+        memcpy( &abyRecord[8], &(psKey->Integer), 4 );
+        nSize = 12;
+    }
+    else if( eKeyType == BTK_REAL )
+    {
+        /* NaN values do not match any comparison */
+        if( CPLIsNan(psKey->Real) )
+            return OGRERR_NONE;
+        memcpy( &abyRecord[8], &(psKey->Real), 8 );
+        nSize = 16;
+    }
+    else
+    {
+        size_t nLen = strlen( psKey->String );
+        nMaxStringLength = MAX( nMaxStringLength, nLen );
+        abyRecord.resize( 8 + nLen + 1 );
+        memcpy( &abyRecord[8], psKey->String, nLen + 1 );
+        nSize = 8 + nLen + 1;
+    }
+
+    return poSorter->AddRecord( &abyRecord[0], nSize ) ?
+                                        OGRERR_NONE : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                            RemoveEntry()                             */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::RemoveEntry( OGRField * /*psKey*/, GIntBig /*nFID*/ )
+
+{
+    return OGRERR_UNSUPPORTED_OPERATION;
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+OGRErr OGRBTreeAttrIndex::Clear()
+
+{
+    if( StartBuild( FALSE ) != OGRERR_NONE )
+        return OGRERR_FAILURE;
+
+    return Flush();
+}
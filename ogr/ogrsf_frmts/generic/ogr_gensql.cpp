@@ -31,6 +31,7 @@
 #include "swq.h"
 #include "ogr_p.h"
 #include "ogr_gensql.h"
+#include "ogr_attrind.h"
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include "cpl_time.h"
@@ -52,6 +53,64 @@ class OGRGenSQLGeomFieldDefn: public OGRGeomFieldDefn
         int bForceGeomType;
 };
 
+/************************************************************************/
+/*                          OGRGenSQLJoinIndex                          */
+/*                                                                      */
+/*      Index of the features of a joined layer by the value of its     */
+/*      join field, so that the feature matching a primary feature      */
+/*      can be found without re-querying the joined layer. As with      */
+/*      the attribute filter it replaces, the first feature of the      */
+/*      layer with a given value is retained. The keys are either       */
+/*      numbers, or lower case strings since the OGR SQL string         */
+/*      comparison ignores case.                                        */
+/*                                                                      */
+/*      The index is a hash table, replaced by an external sort of      */
+/*      the keys that is searched by dichotomy when it does not fit     */
+/*      in the OGR_SQL_MAX_MEMORY budget.                               */
+/************************************************************************/
+
+typedef struct
+{
+    GIntBig     nFID;
+    double      dfKey;
+    char       *pszKey;
+} OGRGenSQLJoinEntry;
+
+class OGRGenSQLJoinIndex
+{
+    int         bNumeric;
+    CPLHashSet *hSet;
+    size_t      nMemory;
+    size_t      nMaxMemory;
+    swq_external_sort *poSorter;
+    std::vector<GByte> abyRecord;
+
+    static unsigned long HashEntry( const void *pEntry );
+    static int          EqualEntries( const void *pEntry1,
+                                      const void *pEntry2 );
+    static void         FreeEntry( void *pEntry );
+    static int          CompareRecords( const GByte *pabyRecord1,
+                                        const GByte *pabyRecord2,
+                                        void *pUserData );
+    static int          SpillEntry( void *pEntry, void *pUserData );
+
+    void        EncodeRecord( const OGRGenSQLJoinEntry *psEntry,
+                              std::vector<GByte> &abyOut );
+    int         AddRecord( const OGRGenSQLJoinEntry *psEntry );
+    void        Spill();
+    GIntBig     LookupSorted( const OGRGenSQLJoinEntry *psEntry );
+
+  public:
+                OGRGenSQLJoinIndex( int bNumericIn );
+               ~OGRGenSQLJoinIndex();
+
+    int         Build( OGRLayer *poJoinLayer, int iField );
+    int         IsNumeric() { return bNumeric; }
+
+    GIntBig     Lookup( double dfKey );
+    GIntBig     Lookup( const char *pszKey );
+};
+
 /************************************************************************/
 /*               OGRGenSQLResultsLayerHasSpecialField()                 */
 /************************************************************************/
@@ -99,11 +158,19 @@ OGRGenSQLResultsLayer::OGRGenSQLResultsLayer( GDALDataset *poSrcDS,
     poSummaryFeature = NULL;
     panFIDIndex = NULL;
     bOrderByValid = FALSE;
+    poOrderBySorter = NULL;
+    pasOrderByTuples = NULL;
+    papoJoinIndexes = NULL;
     nIndexSize = 0;
     nNextIndexFID = 0;
     nExtraDSCount = 0;
     papoExtraDS = NULL;
     panGeomFieldToSrcGeomField = NULL;
+    bUseSidecarIndex = FALSE;
+    poSrcIndexQuery = NULL;
+    panSrcFIDs = NULL;
+    nSrcFIDCount = 0;
+    iNextSrcFID = 0;
 
 /* -------------------------------------------------------------------- */
 /*      Identify all the layers involved in the SELECT.                 */
@@ -172,6 +239,27 @@ OGRGenSQLResultsLayer::OGRGenSQLResultsLayer( GDALDataset *poSrcDS,
     else
         this->pszWHERE = NULL;
 
+/* -------------------------------------------------------------------- */
+/*      If the driver has no attribute indexes of its own, but generic  */
+/*      indexes have been created for the layer with CREATE INDEX,      */
+/*      use them to evaluate the WHERE clause.                          */
+/* -------------------------------------------------------------------- */
+    if( this->pszWHERE != NULL && poSrcLayer->GetIndex() == NULL &&
+        OGRInitializeSidecarIndexSupport( poSrcDS, poSrcLayer,
+                                          FALSE ) == OGRERR_NONE )
+    {
+        poSrcIndexQuery = new OGRFeatureQuery();
+        if( poSrcIndexQuery->Compile( poSrcLayer->GetLayerDefn(),
+                                      this->pszWHERE ) == OGRERR_NONE &&
+            poSrcIndexQuery->CanUseIndex( poSrcLayer ) )
+            bUseSidecarIndex = TRUE;
+        else
+        {
+            delete poSrcIndexQuery;
+            poSrcIndexQuery = NULL;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Prepare a feature definition based on the query.                */
 /* -------------------------------------------------------------------- */
@@ -469,8 +557,18 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
     papoTableLayers = NULL;
              
     CPLFree( panFIDIndex );
+    delete poOrderBySorter;
+    CPLFree( pasOrderByTuples );
     CPLFree( panGeomFieldToSrcGeomField );
 
+    if( papoJoinIndexes != NULL )
+    {
+        for( int iJoin = 0; iJoin < ((swq_select *) pSelectInfo)->join_count;
+             iJoin++ )
+            delete papoJoinIndexes[iJoin];
+        CPLFree( papoJoinIndexes );
+    }
+
     delete poSummaryFeature;
     delete (swq_select *) pSelectInfo;
 
@@ -487,6 +585,9 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
 
     CPLFree( papoExtraDS );
     CPLFree( pszWHERE );
+
+    CPLFree( panSrcFIDs );
+    delete poSrcIndexQuery;
 }
 
 /************************************************************************/
@@ -574,6 +675,57 @@ void OGRGenSQLResultsLayer::ApplyFiltersToSource()
     }
 
     poSrcLayer->ResetReading();
+
+/* -------------------------------------------------------------------- */
+/*      Fetch the matching FIDs from the generic attribute indexes.     */
+/* -------------------------------------------------------------------- */
+    if( bUseSidecarIndex )
+    {
+        CPLFree( panSrcFIDs );
+        panSrcFIDs = poSrcIndexQuery->EvaluateAgainstIndices( poSrcLayer,
+                                                              NULL );
+        for( nSrcFIDCount = 0;
+             panSrcFIDs != NULL && panSrcFIDs[nSrcFIDCount] != OGRNullFID;
+             nSrcFIDCount++ ) {}
+        iNextSrcFID = 0;
+    }
+}
+
+/************************************************************************/
+/*                         GetNextSrcFeature()                          */
+/*                                                                      */
+/*      Fetch the next feature of the source layer matching the         */
+/*      filters, by FID if we have the list of the matching FIDs.       */
+/************************************************************************/
+
+OGRFeature *OGRGenSQLResultsLayer::GetNextSrcFeature()
+{
+    if( panSrcFIDs == NULL )
+        return poSrcLayer->GetNextFeature();
+
+    int iSrcGeomField = -1;
+    if( m_poFilterGeom != NULL && m_iGeomFieldFilter >= 0 &&
+        m_iGeomFieldFilter < GetLayerDefn()->GetGeomFieldCount() )
+        iSrcGeomField = panGeomFieldToSrcGeomField[m_iGeomFieldFilter];
+
+    while( iNextSrcFID < nSrcFIDCount )
+    {
+        OGRFeature *poSrcFeature =
+            poSrcLayer->GetFeature( panSrcFIDs[iNextSrcFID++] );
+
+        if( poSrcFeature == NULL )
+            continue;
+
+        /* The index may be out of date, so check the feature anyway */
+        if( poSrcIndexQuery->Evaluate( poSrcFeature ) &&
+            (iSrcGeomField < 0 ||
+             FilterGeometry( poSrcFeature->GetGeomFieldRef(iSrcGeomField) )) )
+            return poSrcFeature;
+
+        delete poSrcFeature;
+    }
+
+    return NULL;
 }
 
 /************************************************************************/
@@ -600,7 +752,7 @@ void OGRGenSQLResultsLayer::ResetReading()
 /*      ourselves in it.                                                */
 /************************************************************************/
 
-OGRErr OGRGenSQLResultsLayer::SetNextByIndex( long nIndex )
+OGRErr OGRGenSQLResultsLayer::SetNextByIndex( GIntBig nIndex )
 
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
@@ -609,7 +761,7 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex( long nIndex )
 
     if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
         || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-        || panFIDIndex != NULL )
+        || panFIDIndex != NULL || poOrderBySorter != NULL )
     {
         nNextIndexFID = nIndex;
         return OGRERR_NONE;
@@ -660,7 +812,7 @@ OGRErr OGRGenSQLResultsLayer::GetExtent( int iGeomField,
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRGenSQLResultsLayer::GetFeatureCount( int bForce )
+GIntBig OGRGenSQLResultsLayer::GetFeatureCount( int bForce )
 
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
@@ -700,7 +852,7 @@ int OGRGenSQLResultsLayer::TestCapability( const char *pszCap )
     {
         if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
             || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-            || panFIDIndex != NULL )
+            || panFIDIndex != NULL || poOrderBySorter != NULL )
             return TRUE;
         else 
             return poSrcLayer->TestCapability( pszCap );
@@ -819,14 +971,17 @@ int OGRGenSQLResultsLayer::PrepareSummary()
 
 /* -------------------------------------------------------------------- */
 /*      We treat COUNT(*) as a special case, and fill with              */
-/*      GetFeatureCount().                                              */
+/*      GetFeatureCount(), unless the matching features come from       */
+/*      generic indexes: as they may be out of date, the features       */
+/*      must be checked like when they are read.                        */
 /* -------------------------------------------------------------------- */
 
     if( psSelectInfo->result_columns == 1 
         && psSelectInfo->column_defs[0].col_func == SWQCF_COUNT
-        && psSelectInfo->column_defs[0].field_index < 0 )
+        && psSelectInfo->column_defs[0].field_index < 0
+        && panSrcFIDs == NULL )
     {
-        poSummaryFeature->SetField( 0, poSrcLayer->GetFeatureCount( TRUE ) );
+        poSummaryFeature->SetField( 0, (int) poSrcLayer->GetFeatureCount( TRUE ) );
         poSrcLayer->GetLayerDefn()->SetGeometryIgnored(bSaveIsGeomIgnored);
         return TRUE;
     }
@@ -839,7 +994,7 @@ int OGRGenSQLResultsLayer::PrepareSummary()
     OGRFeature *poSrcFeature;
     int iField;
 
-    while( (poSrcFeature = poSrcLayer->GetNextFeature()) != NULL )
+    while( (poSrcFeature = GetNextSrcFeature()) != NULL )
     {
         for( iField = 0; iField < psSelectInfo->result_columns; iField++ )
         {
@@ -1063,6 +1218,383 @@ static swq_expr_node *OGRMultiFeatureFetcher( swq_expr_node *op,
     return poRetNode;
 }
 
+/************************************************************************/
+/*                         OGRGenSQLJoinIndex()                         */
+/************************************************************************/
+
+OGRGenSQLJoinIndex::OGRGenSQLJoinIndex( int bNumericIn ) :
+    bNumeric( bNumericIn ), nMemory( 0 ),
+    nMaxMemory( swq_get_max_memory() ), poSorter( NULL )
+
+{
+    hSet = CPLHashSetNew( HashEntry, EqualEntries, FreeEntry );
+}
+
+/************************************************************************/
+/*                        ~OGRGenSQLJoinIndex()                         */
+/************************************************************************/
+
+OGRGenSQLJoinIndex::~OGRGenSQLJoinIndex()
+
+{
+    if( hSet != NULL )
+        CPLHashSetDestroy( hSet );
+    delete poSorter;
+}
+
+/************************************************************************/
+/*                             HashEntry()                              */
+/************************************************************************/
+
+unsigned long OGRGenSQLJoinIndex::HashEntry( const void *pEntry )
+
+{
+    const OGRGenSQLJoinEntry *psEntry = (const OGRGenSQLJoinEntry *) pEntry;
+
+    if( psEntry->pszKey != NULL )
+        return CPLHashSetHashStr( psEntry->pszKey );
+
+    /* -0.0 and 0.0 are equal */
+    double dfKey = (psEntry->dfKey == 0.0) ? 0.0 : psEntry->dfKey;
+    GUInt32 anWords[2];
+    memcpy( anWords, &dfKey, sizeof(anWords) );
+    return anWords[0] ^ (anWords[1] * 31);
+}
+
+/************************************************************************/
+/*                            EqualEntries()                            */
+/************************************************************************/
+
+int OGRGenSQLJoinIndex::EqualEntries( const void *pEntry1,
+                                      const void *pEntry2 )
+
+{
+    const OGRGenSQLJoinEntry *psEntry1 = (const OGRGenSQLJoinEntry *) pEntry1;
+    const OGRGenSQLJoinEntry *psEntry2 = (const OGRGenSQLJoinEntry *) pEntry2;
+
+    if( psEntry1->pszKey != NULL )
+        return strcmp( psEntry1->pszKey, psEntry2->pszKey ) == 0;
+
+    return psEntry1->dfKey == psEntry2->dfKey;
+}
+
+/************************************************************************/
+/*                             FreeEntry()                              */
+/************************************************************************/
+
+void OGRGenSQLJoinIndex::FreeEntry( void *pEntry )
+
+{
+    OGRGenSQLJoinEntry *psEntry = (OGRGenSQLJoinEntry *) pEntry;
+
+    CPLFree( psEntry->pszKey );
+    CPLFree( psEntry );
+}
+
+/************************************************************************/
+/*                           CompareRecords()                           */
+/*                                                                      */
+/*      Records of the external sort are the FID followed by the        */
+/*      number or the string.                                           */
+/************************************************************************/
+
+int OGRGenSQLJoinIndex::CompareRecords( const GByte *pabyRecord1,
+                                        const GByte *pabyRecord2,
+                                        void *pUserData )
+
+{
+    OGRGenSQLJoinIndex *poIndex = (OGRGenSQLJoinIndex *) pUserData;
+
+    if( !poIndex->bNumeric )
+        return strcmp( (const char *) pabyRecord1 + sizeof(GIntBig),
+                       (const char *) pabyRecord2 + sizeof(GIntBig) );
+
+    double dfKey1, dfKey2;
+    memcpy( &dfKey1, pabyRecord1 + sizeof(GIntBig), sizeof(double) );
+    memcpy( &dfKey2, pabyRecord2 + sizeof(GIntBig), sizeof(double) );
+    if( dfKey1 < dfKey2 )
+        return -1;
+    if( dfKey1 > dfKey2 )
+        return 1;
+    return 0;
+}
+
+/************************************************************************/
+/*                            EncodeRecord()                            */
+/************************************************************************/
+
+void OGRGenSQLJoinIndex::EncodeRecord( const OGRGenSQLJoinEntry *psEntry,
+                                       std::vector<GByte> &abyOut )
+
+{
+    abyOut.resize( sizeof(GIntBig) );
+    memcpy( &abyOut[0], &(psEntry->nFID), sizeof(GIntBig) );
+
+    if( bNumeric )
+        abyOut.insert( abyOut.end(), (const GByte *) &(psEntry->dfKey),
+                          (const GByte *) &(psEntry->dfKey) + sizeof(double) );
+    else
+        abyOut.insert( abyOut.end(), (const GByte *) psEntry->pszKey,
+                          (const GByte *) psEntry->pszKey
+                                            + strlen(psEntry->pszKey) + 1 );
+}
+
+/************************************************************************/
+/*                             AddRecord()                              */
+/************************************************************************/
+
+int OGRGenSQLJoinIndex::AddRecord( const OGRGenSQLJoinEntry *psEntry )
+
+{
+    EncodeRecord( psEntry, abyRecord );
+    return poSorter->AddRecord( &abyRecord[0], abyRecord.size() );
+}
+
+/************************************************************************/
+/*                             SpillEntry()                             */
+/************************************************************************/
+
+int OGRGenSQLJoinIndex::SpillEntry( void *pEntry, void *pUserData )
+
+{
+    OGRGenSQLJoinIndex *poIndex = (OGRGenSQLJoinIndex *) pUserData;
+
+    return poIndex->AddRecord( (OGRGenSQLJoinEntry *) pEntry );
+}
+
+/************************************************************************/
+/*                               Spill()                                */
+/*                                                                      */
+/*      Move the entries of the hash table to an external sort. The     */
+/*      entries are the first ones of their key, and come before the    */
+/*      features read next, so the external sort, that keeps the        */
+/*      first of the equal records, retains them.                       */
+/************************************************************************/
+
+void OGRGenSQLJoinIndex::Spill()
+
+{
+    CPLDebug( "GenSQL", "Join index exceeds %d MB, using an external sort.",
+              (int) (nMaxMemory / (1024 * 1024)) );
+
+    poSorter = new swq_external_sort( CompareRecords, this, nMaxMemory, TRUE );
+
+    /* Errors are reported by the next calls to the external sort */
+    CPLHashSetForeach( hSet, SpillEntry, this );
+    CPLHashSetDestroy( hSet );
+    hSet = NULL;
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+int OGRGenSQLJoinIndex::Build( OGRLayer *poJoinLayer, int iField )
+
+{
+    OGRFeature *poFeature;
+    OGRFieldType eType =
+        poJoinLayer->GetLayerDefn()->GetFieldDefn( iField )->GetType();
+    int bOK = TRUE;
+
+    poJoinLayer->SetAttributeFilter( NULL );
+    poJoinLayer->ResetReading();
+
+    while( bOK && (poFeature = poJoinLayer->GetNextFeature()) != NULL )
+    {
+        OGRGenSQLJoinEntry sEntry;
+
+        if( !poFeature->IsFieldSet( iField ) )
+        {
+            delete poFeature;
+            continue;
+        }
+
+        sEntry.nFID = poFeature->GetFID();
+        sEntry.dfKey = 0.0;
+        sEntry.pszKey = NULL;
+
+        if( bNumeric && eType == OFTString )
+            /* As CAST(field AS FLOAT) */
+            sEntry.dfKey = CPLAtof( poFeature->GetFieldAsString( iField ) );
+        else if( bNumeric )
+            sEntry.dfKey = poFeature->GetFieldAsDouble( iField );
+        else
+            sEntry.pszKey = CPLStrdup(
+                CPLString( poFeature->GetFieldAsString( iField ) ).tolower() );
+
+        delete poFeature;
+
+        if( poSorter != NULL )
+        {
+            bOK = AddRecord( &sEntry );
+            CPLFree( sEntry.pszKey );
+        }
+        else if( CPLHashSetLookup( hSet, &sEntry ) != NULL )
+        {
+            CPLFree( sEntry.pszKey );
+        }
+        else
+        {
+            OGRGenSQLJoinEntry *psEntry = (OGRGenSQLJoinEntry *)
+                CPLMalloc( sizeof(OGRGenSQLJoinEntry) );
+            *psEntry = sEntry;
+            CPLHashSetInsert( hSet, psEntry );
+
+            /* The entry, its string and its node in the hash table */
+            nMemory += sizeof(OGRGenSQLJoinEntry) + 48;
+            if( psEntry->pszKey != NULL )
+                nMemory += strlen(psEntry->pszKey) + 16;
+            if( nMemory > nMaxMemory )
+                Spill();
+        }
+    }
+
+    poJoinLayer->ResetReading();
+
+    if( bOK && poSorter != NULL )
+        bOK = poSorter->Finish();
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                            LookupSorted()                            */
+/*                                                                      */
+/*      Search the key in the sorted records by dichotomy.              */
+/************************************************************************/
+
+GIntBig OGRGenSQLJoinIndex::LookupSorted( const OGRGenSQLJoinEntry *psEntry )
+
+{
+    std::vector<GByte> abySearched;
+    GIntBig nLow = 0, nHigh = poSorter->GetRecordCount() - 1;
+
+    EncodeRecord( psEntry, abySearched );
+
+    while( nLow <= nHigh )
+    {
+        GIntBig nMiddle = nLow + (nHigh - nLow) / 2;
+        const GByte *pabyRecord = poSorter->GetRecord( nMiddle );
+
+        if( pabyRecord == NULL )
+            break;
+
+        int nResult = CompareRecords( pabyRecord, &abySearched[0], this );
+        if( nResult == 0 )
+        {
+            GIntBig nFID;
+            memcpy( &nFID, pabyRecord, sizeof(GIntBig) );
+            return nFID;
+        }
+        else if( nResult < 0 )
+            nLow = nMiddle + 1;
+        else
+            nHigh = nMiddle - 1;
+    }
+
+    return OGRNullFID;
+}
+
+/************************************************************************/
+/*                               Lookup()                               */
+/*                                                                      */
+/*      Return the FID of the feature of the joined layer with a        */
+/*      given key, or OGRNullFID.                                       */
+/************************************************************************/
+
+GIntBig OGRGenSQLJoinIndex::Lookup( double dfKey )
+
+{
+    OGRGenSQLJoinEntry sEntry;
+
+    sEntry.nFID = OGRNullFID;
+    sEntry.dfKey = dfKey;
+    sEntry.pszKey = NULL;
+
+    if( hSet == NULL )
+        return LookupSorted( &sEntry );
+
+    OGRGenSQLJoinEntry *psEntry = (OGRGenSQLJoinEntry *)
+        CPLHashSetLookup( hSet, &sEntry );
+    return psEntry ? psEntry->nFID : OGRNullFID;
+}
+
+GIntBig OGRGenSQLJoinIndex::Lookup( const char *pszKey )
+
+{
+    OGRGenSQLJoinEntry sEntry;
+    CPLString osKey( pszKey );
+
+    osKey.tolower();
+    sEntry.nFID = OGRNullFID;
+    sEntry.dfKey = 0.0;
+    sEntry.pszKey = (char *) osKey.c_str();
+
+    if( hSet == NULL )
+        return LookupSorted( &sEntry );
+
+    OGRGenSQLJoinEntry *psEntry = (OGRGenSQLJoinEntry *)
+        CPLHashSetLookup( hSet, &sEntry );
+    return psEntry ? psEntry->nFID : OGRNullFID;
+}
+
+/************************************************************************/
+/*                          BuildJoinIndexes()                          */
+/*                                                                      */
+/*      Index the joined layers on their join field, so that the        */
+/*      joined features are found with a hash join instead of an        */
+/*      attribute filter set on the joined layer for each primary       */
+/*      feature. This requires fast random reading in the joined        */
+/*      layer, and can be disabled with OGR_SQL_HASH_JOIN=NO, for       */
+/*      instance for joined layers with an attribute index when few     */
+/*      primary features are read.                                      */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::BuildJoinIndexes()
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+
+    papoJoinIndexes = (OGRGenSQLJoinIndex **)
+        CPLCalloc( sizeof(OGRGenSQLJoinIndex *), psSelectInfo->join_count );
+
+    if( !CSLTestBoolean( CPLGetConfigOption( "OGR_SQL_HASH_JOIN", "YES" ) ) )
+        return;
+
+    for( int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++ )
+    {
+        swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+        OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
+
+        /* Reading the joined layer must not disturb the primary one */
+        if( poJoinLayer == poSrcLayer ||
+            !poJoinLayer->TestCapability( OLCRandomRead ) )
+            continue;
+
+        OGRFieldType ePrimaryFieldType = poSrcLayer->GetLayerDefn()->
+                    GetFieldDefn( psJoinInfo->primary_field )->GetType();
+        OGRFieldType eSecondaryFieldType = poJoinLayer->GetLayerDefn()->
+                    GetFieldDefn( psJoinInfo->secondary_field )->GetType();
+
+        if( (ePrimaryFieldType != OFTInteger && ePrimaryFieldType != OFTReal
+             && ePrimaryFieldType != OFTString) ||
+            (eSecondaryFieldType != OFTInteger && eSecondaryFieldType != OFTReal
+             && eSecondaryFieldType != OFTString) )
+            continue;
+
+        /* Strings are compared as numbers if one of the fields is numeric */
+        int bNumeric = ePrimaryFieldType != OFTString ||
+                       eSecondaryFieldType != OFTString;
+
+        OGRGenSQLJoinIndex *poJoinIndex = new OGRGenSQLJoinIndex( bNumeric );
+        if( poJoinIndex->Build( poJoinLayer, psJoinInfo->secondary_field ) )
+            papoJoinIndexes[iJoin] = poJoinIndex;
+        else
+            delete poJoinIndex;
+    }
+}
+
 /************************************************************************/
 /*                          TranslateFeature()                          */
 /************************************************************************/
@@ -1086,6 +1618,9 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
 /* -------------------------------------------------------------------- */
     int iJoin;
 
+    if( papoJoinIndexes == NULL && psSelectInfo->join_count > 0 )
+        BuildJoinIndexes();
+
     for( iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++ )
     {
         CPLString osFilter;
@@ -1113,6 +1648,30 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
                     GetFieldDefn(psJoinInfo->primary_field )->GetType();
         OGRFieldType eSecondaryFieldType = poSecondaryFieldDefn->GetType();
 
+        OGRField *psSrcField = 
+            poSrcFeat->GetRawFieldRef(psJoinInfo->primary_field);
+
+        // Probe the index of the joined layer if we have one.
+        OGRGenSQLJoinIndex *poJoinIndex = papoJoinIndexes[iJoin];
+        if( poJoinIndex != NULL )
+        {
+            GIntBig nJoinFID;
+
+            if( ePrimaryFieldType == OFTInteger )
+                nJoinFID = poJoinIndex->Lookup( (double) psSrcField->Integer );
+            else if( ePrimaryFieldType == OFTReal )
+                nJoinFID = poJoinIndex->Lookup( psSrcField->Real );
+            else if( poJoinIndex->IsNumeric() )
+                nJoinFID = poJoinIndex->Lookup(
+                                    CPLStrtod( psSrcField->String, NULL ) );
+            else
+                nJoinFID = poJoinIndex->Lookup( psSrcField->String );
+
+            apoFeatures.push_back( nJoinFID == OGRNullFID ? NULL :
+                                   poJoinLayer->GetFeature( nJoinFID ) );
+            continue;
+        }
+
         // Prepare attribute query to express fetching on the joined variable
         
         // If joining a (primary) numeric column with a (secondary) string column
@@ -1126,9 +1685,6 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
         else
             osFilter.Printf("%s = ", poSecondaryFieldDefn->GetNameRef() );
 
-        OGRField *psSrcField = 
-            poSrcFeat->GetRawFieldRef(psJoinInfo->primary_field);
-
         switch( ePrimaryFieldType )
         {
           case OFTInteger:
@@ -1406,11 +1962,11 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
     {
         OGRFeature *poFeature;
 
-        if( panFIDIndex != NULL )
+        if( panFIDIndex != NULL || poOrderBySorter != NULL )
             poFeature =  GetFeature( nNextIndexFID++ );
         else
         {
-            OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
+            OGRFeature *poSrcFeat = GetNextSrcFeature();
 
             if( poSrcFeat == NULL )
                 return NULL;
@@ -1438,7 +1994,7 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRGenSQLResultsLayer::GetFeature( long nFID )
+OGRFeature *OGRGenSQLResultsLayer::GetFeature( GIntBig nFID )
 
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
@@ -1472,8 +2028,10 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature( long nFID )
         if( nFID < 0 || nFID >= psSummary->count )
             return NULL;
 
-        if( psSummary->distinct_list[nFID] != NULL )
-            poSummaryFeature->SetField( 0, psSummary->distinct_list[nFID] );
+        const char *pszValue =
+            swq_select_get_distinct_value( psSelectInfo, 0, (int) nFID );
+        if( pszValue != NULL )
+            poSummaryFeature->SetField( 0, pszValue );
         else
             poSummaryFeature->UnsetField( 0 );
         poSummaryFeature->SetFID( nFID );
@@ -1492,6 +2050,13 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature( long nFID )
         else
             nFID = panFIDIndex[nFID];
     }
+    else if( poOrderBySorter != NULL )
+    {
+        const GByte *pabyRecord = poOrderBySorter->GetRecord( nFID );
+        if( pabyRecord == NULL )
+            return NULL;
+        memcpy( &nFID, pabyRecord, sizeof(GIntBig) );
+    }
 
 /* -------------------------------------------------------------------- */
 /*      Handle request for random record.                               */
@@ -1539,12 +2104,13 @@ OGRFeatureDefn *OGRGenSQLResultsLayer::GetLayerDefn()
 /*                                                                      */
 /*      This is accomplished by making one pass through all the         */
 /*      eligible source features, and capturing the order by fields     */
-/*      of all records in memory.  A quick sort is then applied to      */
+/*      of all records in memory.  A merge sort is then applied to      */
 /*      this in memory copy of the order-by fields to create the        */
 /*      required index.                                                 */
 /*                                                                      */
-/*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*      When the key values exceed the memory budget set with the       */
+/*      OGR_SQL_MAX_MEMORY configuration option, they are passed to     */
+/*      an external sort that spills them to temporary files.           */
 /************************************************************************/
 
 void OGRGenSQLResultsLayer::CreateOrderByIndex()
@@ -1553,7 +2119,7 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
     OGRField *pasIndexFields;
     int      i, nOrderItems = psSelectInfo->order_specs;
-    long     *panFIDList;
+    GIntBig  *panFIDList;
 
     if( ! (psSelectInfo->order_specs > 0
            && psSelectInfo->query_mode == SWQM_RECORDSET
@@ -1575,17 +2141,31 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
     panFIDIndex = NULL;
     pasIndexFields = (OGRField *) 
         CPLCalloc(sizeof(OGRField), nOrderItems * nFeaturesAlloc);
-    panFIDList = (long *) CPLMalloc(sizeof(long) * nFeaturesAlloc);
+    panFIDList = (GIntBig *) CPLMalloc(sizeof(GIntBig) * nFeaturesAlloc);
 
 /* -------------------------------------------------------------------- */
 /*      Read in all the key values.                                     */
 /* -------------------------------------------------------------------- */
     OGRFeature *poSrcFeat;
+    size_t nMaxMemory = swq_get_max_memory();
+    size_t nStringMemory = 0;
+    std::vector<GByte> abyRecord;
+
     nIndexSize = 0;
 
-    while( (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
+    while( (poSrcFeat = GetNextSrcFeature()) != NULL )
     {
-        int iKey;
+        if( poOrderBySorter != NULL )
+        {
+            ReadIndexFields( poSrcFeat, pasIndexFields );
+            int bOK = AddOrderByRecord( poSrcFeat->GetFID(), pasIndexFields,
+                                        abyRecord );
+            FreeIndexFields( pasIndexFields, 1 );
+            delete poSrcFeat;
+            if( !bOK )
+                break;
+            continue;
+        }
 
         if (nIndexSize == nFeaturesAlloc)
         {
@@ -1602,8 +2182,8 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
             }
             pasIndexFields = pasNewIndexFields;
 
-            long* panNewFIDList = (long *)
-                VSIRealloc(panFIDList, sizeof(long) *  nNewFeaturesAlloc);
+            GIntBig* panNewFIDList = (GIntBig *)
+                VSIRealloc(panFIDList, sizeof(GIntBig) *  nNewFeaturesAlloc);
             if (panNewFIDList == NULL)
             {
                 VSIFree(pasIndexFields);
@@ -1613,66 +2193,68 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
             }
             panFIDList = panNewFIDList;
 
-            memset(pasIndexFields + nFeaturesAlloc, 0,
+            memset(pasIndexFields + nFeaturesAlloc * nOrderItems, 0,
                    sizeof(OGRField) * nOrderItems * (nNewFeaturesAlloc - nFeaturesAlloc));
 
             nFeaturesAlloc = nNewFeaturesAlloc;
         }
 
-        for( iKey = 0; iKey < nOrderItems; iKey++ )
-        {
-            swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-            OGRFieldDefn *poFDefn;
-            OGRField *psSrcField, *psDstField;
-
-            psDstField = pasIndexFields + nIndexSize * nOrderItems + iKey;
+        nStringMemory += ReadIndexFields( poSrcFeat,
+                                    pasIndexFields + nIndexSize * nOrderItems );
 
-            if ( psKeyDef->field_index >= iFIDFieldIndex)
-            {
-                if ( psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-                {
-                    switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
-                    {
-                      case SWQ_INTEGER:
-                        psDstField->Integer = poSrcFeat->GetFieldAsInteger(psKeyDef->field_index);
-                        break;
-
-                      case SWQ_FLOAT:
-                        psDstField->Real = poSrcFeat->GetFieldAsDouble(psKeyDef->field_index);
-                        break;
-
-                      default:
-                        psDstField->String = CPLStrdup( poSrcFeat->GetFieldAsString(psKeyDef->field_index) );
-                        break;
-                    }
-                }
-                continue;
-            }
-            
-            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-                psKeyDef->field_index );
+        panFIDList[nIndexSize] = poSrcFeat->GetFID();
+        delete poSrcFeat;
 
-            psSrcField = poSrcFeat->GetRawFieldRef( psKeyDef->field_index );
+        nIndexSize++;
 
-            if( poFDefn->GetType() == OFTInteger 
-                || poFDefn->GetType() == OFTReal
-                || poFDefn->GetType() == OFTDate
-                || poFDefn->GetType() == OFTTime
-                || poFDefn->GetType() == OFTDateTime)
-                memcpy( psDstField, psSrcField, sizeof(OGRField) );
-            else if( poFDefn->GetType() == OFTString )
-            {
-                if( poSrcFeat->IsFieldSet( psKeyDef->field_index ) )
-                    psDstField->String = CPLStrdup( psSrcField->String );
-                else
-                    memcpy( psDstField, psSrcField, sizeof(OGRField) );
-            }
+/* -------------------------------------------------------------------- */
+/*      Switch to the external sort if the keys, the index and the      */
+/*      temporary array of the merge sort do not fit in memory.         */
+/*      The keys read so far are passed to it in their order.           */
+/* -------------------------------------------------------------------- */
+        if( (size_t) nIndexSize * (nOrderItems * sizeof(OGRField)
+                                   + 3 * sizeof(GIntBig))
+            + nStringMemory > nMaxMemory )
+        {
+            CPLDebug( "GenSQL",
+                      "ORDER BY keys exceed %d MB after %d features, "
+                      "using an external sort.",
+                      (int) (nMaxMemory / (1024 * 1024)), nIndexSize );
+
+            poOrderBySorter = new swq_external_sort( CompareOrderByRecords,
+                                                     this, nMaxMemory, FALSE );
+            pasOrderByTuples = (OGRField *)
+                CPLCalloc(sizeof(OGRField), 2 * nOrderItems);
+
+            int bOK = TRUE;
+            for( i = 0; bOK && i < nIndexSize; i++ )
+                bOK = AddOrderByRecord( panFIDList[i],
+                                        pasIndexFields + i * nOrderItems,
+                                        abyRecord );
+
+            FreeIndexFields( pasIndexFields, nIndexSize );
+            CPLFree( panFIDList );
+            panFIDList = NULL;
+            pasIndexFields = (OGRField *)
+                CPLRealloc( pasIndexFields, sizeof(OGRField) * nOrderItems );
+            nIndexSize = 0;
+
+            if( !bOK )
+                break;
         }
+    }
 
-        panFIDList[nIndexSize] = poSrcFeat->GetFID();
-        delete poSrcFeat;
+    if( poOrderBySorter != NULL )
+    {
+        CPLFree( pasIndexFields );
+        CPLFree( panFIDList );
 
-        nIndexSize++;
+        /* On failure, the error has been reported and no feature is */
+        /* returned. */
+        poOrderBySorter->Finish();
+
+        ResetReading();
+        return;
     }
 
     //CPLDebug("GenSQL", "CreateOrderByIndex() = %d features", nIndexSize);
@@ -1680,7 +2262,7 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 /* -------------------------------------------------------------------- */
 /*      Initialize panFIDIndex                                          */
 /* -------------------------------------------------------------------- */
-    panFIDIndex = (long *) CPLMalloc(sizeof(long) * nIndexSize);
+    panFIDIndex = (GIntBig *) CPLMalloc(sizeof(GIntBig) * nIndexSize);
     for( i = 0; i < nIndexSize; i++ )
         panFIDIndex[i] = i;
 
@@ -1705,21 +2287,66 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 /* -------------------------------------------------------------------- */
 /*      Free the key field values.                                      */
 /* -------------------------------------------------------------------- */
+    FreeIndexFields( pasIndexFields, nIndexSize );
+    CPLFree( pasIndexFields );
+
+    /* If it is already sorted, then free than panFIDIndex array */
+    /* so that GetNextFeature() can call a sequential GetNextFeature() */
+    /* on the source array. Very usefull for layers where random access */
+    /* is slow. */
+    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
+    if (bAlreadySorted)
+    {
+        CPLFree( panFIDIndex );
+        panFIDIndex = NULL;
+
+        nIndexSize = 0;
+    }
+
+    ResetReading();
+}
+
+/************************************************************************/
+/*                          ReadIndexFields()                           */
+/*                                                                      */
+/*      Capture the order by fields of a source feature. Returns the    */
+/*      approximate amount of memory allocated for the strings.         */
+/************************************************************************/
+
+size_t OGRGenSQLResultsLayer::ReadIndexFields( OGRFeature *poSrcFeat,
+                                               OGRField *pasTuple )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int nOrderItems = psSelectInfo->order_specs;
+    size_t nStringMemory = 0;
+
     for( int iKey = 0; iKey < nOrderItems; iKey++ )
     {
         swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
         OGRFieldDefn *poFDefn;
+        OGRField *psSrcField, *psDstField;
 
-        if ( psKeyDef->field_index >= iFIDFieldIndex &&
-            psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+        psDstField = pasTuple + iKey;
+
+        if ( psKeyDef->field_index >= iFIDFieldIndex)
         {
-            /* warning: only special fields of type string should be deallocated */
-            if (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex] == SWQ_STRING)
+            if ( psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
             {
-                for( i = 0; i < nIndexSize; i++ )
+                switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
                 {
-                    OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-                    CPLFree( psField->String );
+                  case SWQ_INTEGER:
+                    psDstField->Integer = poSrcFeat->GetFieldAsInteger(psKeyDef->field_index);
+                    break;
+
+                  case SWQ_FLOAT:
+                    psDstField->Real = poSrcFeat->GetFieldAsDouble(psKeyDef->field_index);
+                    break;
+
+                  default:
+                    psDstField->String = CPLStrdup( poSrcFeat->GetFieldAsString(psKeyDef->field_index) );
+                    nStringMemory += strlen(psDstField->String) + 16;
+                    break;
                 }
             }
             continue;
@@ -1728,35 +2355,173 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
         poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
             psKeyDef->field_index );
 
-        if( poFDefn->GetType() == OFTString )
+        psSrcField = poSrcFeat->GetRawFieldRef( psKeyDef->field_index );
+
+        if( poFDefn->GetType() == OFTInteger 
+            || poFDefn->GetType() == OFTReal
+            || poFDefn->GetType() == OFTDate
+            || poFDefn->GetType() == OFTTime
+            || poFDefn->GetType() == OFTDateTime)
+            memcpy( psDstField, psSrcField, sizeof(OGRField) );
+        else if( poFDefn->GetType() == OFTString )
         {
-            for( i = 0; i < nIndexSize; i++ )
+            if( poSrcFeat->IsFieldSet( psKeyDef->field_index ) )
             {
-                OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-                
-                if( psField->Set.nMarker1 != OGRUnsetMarker 
-                    || psField->Set.nMarker2 != OGRUnsetMarker )
-                    CPLFree( psField->String );
+                psDstField->String = CPLStrdup( psSrcField->String );
+                nStringMemory += strlen(psDstField->String) + 16;
             }
+            else
+                memcpy( psDstField, psSrcField, sizeof(OGRField) );
         }
     }
 
-    CPLFree( pasIndexFields );
+    return nStringMemory;
+}
 
-    /* If it is already sorted, then free than panFIDIndex array */
-    /* so that GetNextFeature() can call a sequential GetNextFeature() */
-    /* on the source array. Very usefull for layers where random access */
-    /* is slow. */
-    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
-    if (bAlreadySorted)
+/************************************************************************/
+/*                          FreeIndexFields()                           */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::FreeIndexFields( OGRField *pasIndexFields,
+                                             int nEntries )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int nOrderItems = psSelectInfo->order_specs;
+
+    for( int iKey = 0; iKey < nOrderItems; iKey++ )
     {
-        CPLFree( panFIDIndex );
-        panFIDIndex = NULL;
+        if( !IsStringKey( iKey ) )
+            continue;
 
-        nIndexSize = 0;
+        for( int i = 0; i < nEntries; i++ )
+        {
+            OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
+
+            if( psField->Set.nMarker1 != OGRUnsetMarker 
+                || psField->Set.nMarker2 != OGRUnsetMarker )
+                CPLFree( psField->String );
+        }
     }
+}
 
-    ResetReading();
+/************************************************************************/
+/*                            IsStringKey()                             */
+/*                                                                      */
+/*      Whether the order by field holds an allocated string.           */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::IsStringKey( int iKey )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+
+    if( psKeyDef->field_index >= iFIDFieldIndex )
+    {
+        /* warning: only special fields of type string should be deallocated */
+        return psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT &&
+               SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex]
+                                                                == SWQ_STRING;
+    }
+
+    return poSrcLayer->GetLayerDefn()->GetFieldDefn(
+                            psKeyDef->field_index )->GetType() == OFTString;
+}
+
+/************************************************************************/
+/*                          AddOrderByRecord()                          */
+/*                                                                      */
+/*      Serialize the FID and the order by fields of a feature for      */
+/*      the external sort: the FID, the raw fields, and then the        */
+/*      value of the string fields that are set, in order.              */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::AddOrderByRecord( GIntBig nFID,
+                                             OGRField *pasTuple,
+                                             std::vector<GByte> &abyRecord )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int nOrderItems = psSelectInfo->order_specs;
+
+    abyRecord.resize( sizeof(GIntBig) + nOrderItems * sizeof(OGRField) );
+    memcpy( &abyRecord[0], &nFID, sizeof(GIntBig) );
+    memcpy( &abyRecord[sizeof(GIntBig)], pasTuple,
+            nOrderItems * sizeof(OGRField) );
+
+    for( int iKey = 0; iKey < nOrderItems; iKey++ )
+    {
+        if( IsStringKey( iKey ) &&
+            (pasTuple[iKey].Set.nMarker1 != OGRUnsetMarker 
+             || pasTuple[iKey].Set.nMarker2 != OGRUnsetMarker) )
+        {
+            const char *pszValue = pasTuple[iKey].String;
+            abyRecord.insert( abyRecord.end(), (const GByte *) pszValue,
+                              (const GByte *) pszValue + strlen(pszValue) + 1 );
+        }
+    }
+
+    return poOrderBySorter->AddRecord( &abyRecord[0], abyRecord.size() );
+}
+
+/************************************************************************/
+/*                        DecodeOrderByRecord()                         */
+/*                                                                      */
+/*      Restore the order by fields of a record of the external         */
+/*      sort, and return its FID. The strings point in the record.      */
+/************************************************************************/
+
+GIntBig OGRGenSQLResultsLayer::DecodeOrderByRecord( const GByte *pabyRecord,
+                                                    OGRField *pasTuple )
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    int nOrderItems = psSelectInfo->order_specs;
+    GIntBig nFID;
+
+    memcpy( &nFID, pabyRecord, sizeof(GIntBig) );
+    memcpy( pasTuple, pabyRecord + sizeof(GIntBig),
+            nOrderItems * sizeof(OGRField) );
+
+    const char *pszString = (const char *)
+        (pabyRecord + sizeof(GIntBig) + nOrderItems * sizeof(OGRField));
+    for( int iKey = 0; iKey < nOrderItems; iKey++ )
+    {
+        if( IsStringKey( iKey ) &&
+            (pasTuple[iKey].Set.nMarker1 != OGRUnsetMarker 
+             || pasTuple[iKey].Set.nMarker2 != OGRUnsetMarker) )
+        {
+            pasTuple[iKey].String = (char *) pszString;
+            pszString += strlen(pszString) + 1;
+        }
+    }
+
+    return nFID;
+}
+
+/************************************************************************/
+/*                       CompareOrderByRecords()                        */
+/*                                                                      */
+/*      Comparison function of the external sort, consistent with       */
+/*      SortIndexSection(): the first record must be returned first     */
+/*      if Compare() is positive.                                       */
+/************************************************************************/
+
+int OGRGenSQLResultsLayer::CompareOrderByRecords( const GByte *pabyRecord1,
+                                                  const GByte *pabyRecord2,
+                                                  void *pUserData )
+
+{
+    OGRGenSQLResultsLayer *poLayer = (OGRGenSQLResultsLayer *) pUserData;
+    swq_select *psSelectInfo = (swq_select *) poLayer->pSelectInfo;
+    OGRField *pasFirst = poLayer->pasOrderByTuples;
+    OGRField *pasSecond = pasFirst + psSelectInfo->order_specs;
+
+    poLayer->DecodeOrderByRecord( pabyRecord1, pasFirst );
+    poLayer->DecodeOrderByRecord( pabyRecord2, pasSecond );
+
+    return -poLayer->Compare( pasFirst, pasSecond );
 }
 
 /************************************************************************/
@@ -1780,12 +2545,12 @@ void OGRGenSQLResultsLayer::SortIndexSection( OGRField *pasIndexFields,
     int nSecondGroup = nEntries - nFirstGroup;
     int nSecondStart = nStart + nFirstGroup;
     int iMerge = 0;
-    long *panMerged;
+    GIntBig *panMerged;
 
     SortIndexSection( pasIndexFields, nFirstStart, nFirstGroup );
     SortIndexSection( pasIndexFields, nSecondStart, nSecondGroup );
 
-    panMerged = (long *) CPLMalloc( sizeof(long) * nEntries );
+    panMerged = (GIntBig *) CPLMalloc( sizeof(GIntBig) * nEntries );
         
     while( iMerge < nEntries )
     {
@@ -1815,7 +2580,7 @@ void OGRGenSQLResultsLayer::SortIndexSection( OGRField *pasIndexFields,
 
     /* Copy the merge list back into the main index */
 
-    memcpy( panFIDIndex + nStart, panMerged, sizeof(long) * nEntries );
+    memcpy( panFIDIndex + nStart, panMerged, sizeof(GIntBig) * nEntries );
     CPLFree( panMerged );
 }
 
@@ -1846,11 +2611,17 @@ int OGRGenSQLResultsLayer::Compare( OGRField *pasFirstTuple,
             poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
                 psKeyDef->field_index );
         
-        if( (pasFirstTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-             && pasFirstTuple[iKey].Set.nMarker2 == OGRUnsetMarker)
-            || (pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-                && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker) )
-            nResult = 0;
+        int bFirstUnset = 
+            (pasFirstTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
+             && pasFirstTuple[iKey].Set.nMarker2 == OGRUnsetMarker);
+        int bSecondUnset = 
+            (pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
+             && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker);
+
+        /* Unset values sort before any value, so that the ordering */
+        /* is consistent, as needed by the external sort. */
+        if( bFirstUnset || bSecondUnset )
+            nResult = bSecondUnset - bFirstUnset;
         else if ( poFDefn == NULL )
         {
             switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
@@ -2022,6 +2793,11 @@ void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
     CPLFree( panFIDIndex );
     panFIDIndex = NULL;
 
+    delete poOrderBySorter;
+    poOrderBySorter = NULL;
+    CPLFree( pasOrderByTuples );
+    pasOrderByTuples = NULL;
+
     nIndexSize = 0;
     bOrderByValid = FALSE;
 }
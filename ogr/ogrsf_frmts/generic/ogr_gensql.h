@@ -45,6 +45,8 @@
 #define ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(poFDefn, idx) \
     ((idx) - ((poFDefn)->GetFieldCount() + SPECIAL_FIELD_COUNT))
 
+class OGRGenSQLJoinIndex;
+
 /************************************************************************/
 /*                        OGRGenSQLResultsLayer                         */
 /************************************************************************/
@@ -67,14 +69,21 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
     int        *panGeomFieldToSrcGeomField;
 
     int         nIndexSize;
-    long       *panFIDIndex;
+    GIntBig    *panFIDIndex;
     int         bOrderByValid;
 
+    /* Used instead of panFIDIndex when the keys do not fit in memory */
+    swq_external_sort *poOrderBySorter;
+    OGRField   *pasOrderByTuples;
+
     int         nNextIndexFID;
     OGRFeature  *poSummaryFeature;
 
     int         iFIDFieldIndex;
 
+    OGRGenSQLJoinIndex **papoJoinIndexes;
+    void        BuildJoinIndexes();
+
     int         nExtraDSCount;
     GDALDataset **papoExtraDS;
 
@@ -83,10 +92,29 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
     void        SortIndexSection( OGRField *pasIndexFields, 
                                   int nStart, int nEntries );
     int         Compare( OGRField *pasFirst, OGRField *pasSecond );
+    size_t      ReadIndexFields( OGRFeature *poSrcFeat, OGRField *pasTuple );
+    void        FreeIndexFields( OGRField *pasIndexFields, int nEntries );
+    int         IsStringKey( int iKey );
+    int         AddOrderByRecord( GIntBig nFID, OGRField *pasTuple,
+                                  std::vector<GByte> &abyRecord );
+    GIntBig     DecodeOrderByRecord( const GByte *pabyRecord,
+                                     OGRField *pasTuple );
+    static int  CompareOrderByRecords( const GByte *pabyRecord1,
+                                       const GByte *pabyRecord2,
+                                       void *pUserData );
 
     void        ClearFilters();
     void        ApplyFiltersToSource();
 
+    /* Matching FIDs, when the WHERE clause is evaluated with generic */
+    /* attribute indexes of a driver that does not use them itself.   */
+    int         bUseSidecarIndex;
+    OGRFeatureQuery *poSrcIndexQuery;
+    GIntBig    *panSrcFIDs;
+    int         nSrcFIDCount;
+    int         iNextSrcFID;
+    OGRFeature *GetNextSrcFeature();
+
     void        FindAndSetIgnoredFields();
     void        ExploreExprForIgnoredFields(swq_expr_node* expr, CPLHashSet* hSet);
     void        AddFieldDefnToSet(int iTable, int iColumn, CPLHashSet* hSet);
@@ -109,12 +137,12 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
 
     virtual void        ResetReading();
     virtual OGRFeature *GetNextFeature();
-    virtual OGRErr      SetNextByIndex( long nIndex );
-    virtual OGRFeature *GetFeature( long nFID );
+    virtual OGRErr      SetNextByIndex( GIntBig nIndex );
+    virtual OGRFeature *GetFeature( GIntBig nFID );
 
     virtual OGRFeatureDefn *GetLayerDefn();
 
-    virtual int         GetFeatureCount( int bForce = TRUE );
+    virtual GIntBig     GetFeatureCount( int bForce = TRUE );
     virtual OGRErr      GetExtent(OGREnvelope *psExtent, int bForce = TRUE) { return GetExtent(0, psExtent, bForce); }
     virtual OGRErr      GetExtent(int iGeomField, OGREnvelope *psExtent, int bForce = TRUE);
 
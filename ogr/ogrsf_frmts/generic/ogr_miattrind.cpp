@@ -58,12 +58,12 @@ public:
                ~OGRMIAttrIndex();
 
     GByte      *BuildKey( OGRField *psKey );
-    long        GetFirstMatch( OGRField *psKey );
-    long       *GetAllMatches( OGRField *psKey );
-    long       *GetAllMatches( OGRField *psKey, long* panFIDList, int* nFIDCount, int* nLength );
+    GIntBig     GetFirstMatch( OGRField *psKey );
+    GIntBig    *GetAllMatches( OGRField *psKey );
+    GIntBig    *GetAllMatches( OGRField *psKey, GIntBig* panFIDList, int* nFIDCount, int* nLength );
 
-    OGRErr      AddEntry( OGRField *psKey, long nFID );
-    OGRErr      RemoveEntry( OGRField *psKey, long nFID );
+    OGRErr      AddEntry( OGRField *psKey, GIntBig nFID );
+    OGRErr      RemoveEntry( OGRField *psKey, GIntBig nFID );
 
     OGRErr      Clear();
 };
@@ -702,15 +702,26 @@ OGRMIAttrIndex::~OGRMIAttrIndex()
 /*                              AddEntry()                              */
 /************************************************************************/
 
-OGRErr OGRMIAttrIndex::AddEntry( OGRField *psKey, long nFID )
+OGRErr OGRMIAttrIndex::AddEntry( OGRField *psKey, GIntBig nFID )
 
 {
-    GByte *pabyKey = BuildKey( psKey );
-
     if( psKey == NULL )
         return OGRERR_FAILURE;
 
-    if( poINDFile->AddEntry( iIndex, pabyKey, nFID+1 ) != 0 )
+/* -------------------------------------------------------------------- */
+/*      The .ind format stores 32 bit record numbers.                   */
+/* -------------------------------------------------------------------- */
+    if( nFID < 0 || nFID >= INT_MAX )
+    {
+        CPLError( CE_Failure, CPLE_NotSupported,
+                  "FID " CPL_FRMT_GIB " cannot be stored in a .ind attribute index.",
+                  nFID );
+        return OGRERR_FAILURE;
+    }
+
+    GByte *pabyKey = BuildKey( psKey );
+
+    if( poINDFile->AddEntry( iIndex, pabyKey, (int) nFID+1 ) != 0 )
         return OGRERR_FAILURE;
     else
         return OGRERR_NONE;
@@ -720,7 +731,7 @@ OGRErr OGRMIAttrIndex::AddEntry( OGRField *psKey, long nFID )
 /*                            RemoveEntry()                             */
 /************************************************************************/
 
-OGRErr OGRMIAttrIndex::RemoveEntry( OGRField * /*psKey*/, long /*nFID*/ )
+OGRErr OGRMIAttrIndex::RemoveEntry( OGRField * /*psKey*/, GIntBig /*nFID*/ )
 
 {
     return OGRERR_UNSUPPORTED_OPERATION;
@@ -758,11 +769,11 @@ GByte *OGRMIAttrIndex::BuildKey( OGRField *psKey )
 /*                           GetFirstMatch()                            */
 /************************************************************************/
 
-long OGRMIAttrIndex::GetFirstMatch( OGRField *psKey )
+GIntBig OGRMIAttrIndex::GetFirstMatch( OGRField *psKey )
 
 {
     GByte *pabyKey = BuildKey( psKey );
-    long nFID;
+    int nFID;
 
     nFID = poINDFile->FindFirst( iIndex, pabyKey );
     if( nFID < 1 )
@@ -775,14 +786,14 @@ long OGRMIAttrIndex::GetFirstMatch( OGRField *psKey )
 /*                           GetAllMatches()                            */
 /************************************************************************/
 
-long *OGRMIAttrIndex::GetAllMatches( OGRField *psKey, long* panFIDList, int* nFIDCount, int* nLength )
+GIntBig *OGRMIAttrIndex::GetAllMatches( OGRField *psKey, GIntBig* panFIDList, int* nFIDCount, int* nLength )
 {
     GByte *pabyKey = BuildKey( psKey );
-    long nFID;
+    int nFID;
 
     if (panFIDList == NULL)
     {
-        panFIDList = (long *) CPLMalloc(sizeof(long) * 2);
+        panFIDList = (GIntBig *) CPLMalloc(sizeof(GIntBig) * 2);
         *nFIDCount = 0;
         *nLength = 2;
     }
@@ -793,7 +804,7 @@ long *OGRMIAttrIndex::GetAllMatches( OGRField *psKey, long* panFIDList, int* nFI
         if( *nFIDCount >= *nLength-1 )
         {
             *nLength = (*nLength) * 2 + 10;
-            panFIDList = (long *) CPLRealloc(panFIDList, sizeof(long)* (*nLength));
+            panFIDList = (GIntBig *) CPLRealloc(panFIDList, sizeof(GIntBig)* (*nLength));
         }
         panFIDList[(*nFIDCount)++] = nFID - 1;
         
@@ -805,7 +816,7 @@ long *OGRMIAttrIndex::GetAllMatches( OGRField *psKey, long* panFIDList, int* nFI
     return panFIDList;
 }
 
-long *OGRMIAttrIndex::GetAllMatches( OGRField *psKey )
+GIntBig *OGRMIAttrIndex::GetAllMatches( OGRField *psKey )
 {
     int nFIDCount, nLength;
     return GetAllMatches( psKey, NULL, &nFIDCount, &nLength );
@@ -167,11 +167,11 @@ int OGR_L_GetRefCount( OGRLayerH hLayer )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRLayer::GetFeatureCount( int bForce )
+GIntBig OGRLayer::GetFeatureCount( int bForce )
 
 {
     OGRFeature     *poFeature;
-    int            nFeatureCount = 0;
+    GIntBig        nFeatureCount = 0;
 
     if( !bForce )
         return -1;
@@ -191,7 +191,7 @@ int OGRLayer::GetFeatureCount( int bForce )
 /*                       OGR_L_GetFeatureCount()                        */
 /************************************************************************/
 
-int OGR_L_GetFeatureCount( OGRLayerH hLayer, int bForce )
+GIntBig OGR_L_GetFeatureCount( OGRLayerH hLayer, int bForce )
 
 {
     VALIDATE_POINTER1( hLayer, "OGR_L_GetFeature", 0 );
@@ -259,19 +259,18 @@ OGRErr OGRLayer::GetExtentInternal(int iGeomField, OGREnvelope *psExtent, int bF
     ResetReading();
     while( (poFeature = GetNextFeature()) != NULL )
     {
-        OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iGeomField);
-        if (poGeom == NULL || poGeom->IsEmpty())
+        /* Does not build the geometry if it is still in WKB form */
+        if (poFeature->GetGeomFieldEnvelope(iGeomField, &oEnv) != OGRERR_NONE)
         {
             /* Do nothing */
         }
         else if (!bExtentSet)
         {
-            poGeom->getEnvelope(psExtent);
+            *psExtent = oEnv;
             bExtentSet = TRUE;
         }
         else
         {
-            poGeom->getEnvelope(&oEnv);
             if (oEnv.MinX < psExtent->MinX) 
                 psExtent->MinX = oEnv.MinX;
             if (oEnv.MinY < psExtent->MinY) 
@@ -418,7 +417,7 @@ OGRErr OGR_L_SetAttributeFilter( OGRLayerH hLayer, const char *pszQuery )
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRLayer::GetFeature( long nFID )
+OGRFeature *OGRLayer::GetFeature( GIntBig nFID )
 
 {
     OGRFeature *poFeature;
@@ -453,7 +452,7 @@ OGRFeature *OGRLayer::GetFeature( long nFID )
 /*                          OGR_L_GetFeature()                          */
 /************************************************************************/
 
-OGRFeatureH OGR_L_GetFeature( OGRLayerH hLayer, long nFeatureId )
+OGRFeatureH OGR_L_GetFeature( OGRLayerH hLayer, GIntBig nFeatureId )
 
 {
     VALIDATE_POINTER1( hLayer, "OGR_L_GetFeature", NULL );
@@ -465,7 +464,7 @@ OGRFeatureH OGR_L_GetFeature( OGRLayerH hLayer, long nFeatureId )
 /*                           SetNextByIndex()                           */
 /************************************************************************/
 
-OGRErr OGRLayer::SetNextByIndex( long nIndex )
+OGRErr OGRLayer::SetNextByIndex( GIntBig nIndex )
 
 {
     OGRFeature *poFeature;
@@ -490,7 +489,7 @@ OGRErr OGRLayer::SetNextByIndex( long nIndex )
 /*                        OGR_L_SetNextByIndex()                        */
 /************************************************************************/
 
-OGRErr OGR_L_SetNextByIndex( OGRLayerH hLayer, long nIndex )
+OGRErr OGR_L_SetNextByIndex( OGRLayerH hLayer, GIntBig nIndex )
 
 {
     VALIDATE_POINTER1( hLayer, "OGR_L_SetNextByIndex", OGRERR_INVALID_HANDLE );
@@ -510,6 +509,36 @@ OGRFeatureH OGR_L_GetNextFeature( OGRLayerH hLayer )
     return (OGRFeatureH) ((OGRLayer *)hLayer)->GetNextFeature();
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    if( poBatch->GetDefnRef() != GetLayerDefn() )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "The batch has not been created with the definition "
+                  "of the layer." );
+        return 0;
+    }
+
+    poBatch->Reset();
+
+    while( !poBatch->IsFull() )
+    {
+        OGRFeature *poFeature = GetNextFeature();
+        if( poFeature == NULL )
+            break;
+
+        poBatch->AddFeature( poFeature );
+        delete poFeature;
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                             SetFeature()                             */
 /************************************************************************/
@@ -1269,6 +1298,46 @@ int OGRLayer::FilterGeometry( OGRGeometry *poGeometry )
     }
 }
 
+/************************************************************************/
+/*                           FilterGeometry()                           */
+/*                                                                      */
+/*      Same as above for the geometry of a feature, but first          */
+/*      compares the envelope of the geometry with the filter, which    */
+/*      avoids building geometries that are kept as WKB by the          */
+/*      feature when it is enough to decide.                            */
+/************************************************************************/
+
+int OGRLayer::FilterGeometry( OGRFeature *poFeature, int iGeomField )
+
+{
+    if( m_poFilterGeom == NULL )
+        return TRUE;
+
+    if( poFeature->GetGeomFieldWKB( iGeomField, NULL ) != NULL )
+    {
+        OGREnvelope sGeomEnv;
+
+        if( poFeature->GetGeomFieldEnvelope( iGeomField, &sGeomEnv )
+                                                            == OGRERR_NONE )
+        {
+            if( sGeomEnv.MaxX < m_sFilterEnvelope.MinX
+                || sGeomEnv.MaxY < m_sFilterEnvelope.MinY
+                || m_sFilterEnvelope.MaxX < sGeomEnv.MinX
+                || m_sFilterEnvelope.MaxY < sGeomEnv.MinY )
+                return FALSE;
+
+            if( m_bFilterIsEnvelope &&
+                sGeomEnv.MinX >= m_sFilterEnvelope.MinX &&
+                sGeomEnv.MinY >= m_sFilterEnvelope.MinY &&
+                sGeomEnv.MaxX <= m_sFilterEnvelope.MaxX &&
+                sGeomEnv.MaxY <= m_sFilterEnvelope.MaxY )
+                return TRUE;
+        }
+    }
+
+    return FilterGeometry( poFeature->GetGeomFieldRef(iGeomField) );
+}
+
 /************************************************************************/
 /*                         OGR_L_ResetReading()                         */
 /************************************************************************/
@@ -1297,7 +1366,32 @@ OGRErr OGRLayer::InitializeIndexSupport( const char *pszFilename )
     if (m_poAttrIndex != NULL)
         return OGRERR_NONE;
 
-    m_poAttrIndex = OGRCreateDefaultLayerIndex();
+/* -------------------------------------------------------------------- */
+/*      Drivers keep using MapInfo style indexes (.idm/.ind), that      */
+/*      other versions can read. B-tree indexes, that also support      */
+/*      range queries, are used for the generic indexes of drivers      */
+/*      without index support (a .oim path is then given), for layers   */
+/*      that already have them, or if OGR_ATTR_INDEX_FORMAT=BTREE.      */
+/* -------------------------------------------------------------------- */
+    VSIStatBufL sStat;
+    int bBTree;
+
+    if( EQUALN(pszFilename, "<OGRMILayerAttrIndex>", 21) )
+        bBTree = FALSE;
+    else if( EQUAL(CPLGetExtension(pszFilename), "oim") )
+        bBTree = TRUE;
+    else if( VSIStatL( CPLResetExtension(pszFilename, "idm"), &sStat ) == 0 )
+        bBTree = FALSE;
+    else if( VSIStatL( CPLResetExtension(pszFilename, "oim"), &sStat ) == 0 )
+        bBTree = TRUE;
+    else
+        bBTree = EQUAL( CPLGetConfigOption( "OGR_ATTR_INDEX_FORMAT",
+                                            "MAPINFO" ), "BTREE" );
+
+    if( bBTree )
+        m_poAttrIndex = OGRCreateBTreeLayerIndex();
+    else
+        m_poAttrIndex = OGRCreateDefaultLayerIndex();
 
     eErr = m_poAttrIndex->Initialize( pszFilename, this );
     if( eErr != OGRERR_NONE )
@@ -1335,7 +1429,7 @@ OGRErr OGR_L_SyncToDisk( OGRLayerH hDS )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRLayer::DeleteFeature( long nFID )
+OGRErr OGRLayer::DeleteFeature( GIntBig nFID )
 
 {
     return OGRERR_UNSUPPORTED_OPERATION;
@@ -1345,7 +1439,7 @@ OGRErr OGRLayer::DeleteFeature( long nFID )
 /*                        OGR_L_DeleteFeature()                         */
 /************************************************************************/
 
-OGRErr OGR_L_DeleteFeature( OGRLayerH hDS, long nFID )
+OGRErr OGR_L_DeleteFeature( OGRLayerH hDS, GIntBig nFID )
 
 {
     VALIDATE_POINTER1( hDS, "OGR_L_DeleteFeature", OGRERR_INVALID_HANDLE );
@@ -88,12 +88,17 @@ OGRFeature *OGRLayerDecorator::GetNextFeature()
     return m_poDecoratedLayer->GetNextFeature();
 }
 
-OGRErr      OGRLayerDecorator::SetNextByIndex( long nIndex )
+int         OGRLayerDecorator::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    return m_poDecoratedLayer->GetNextFeatureBatch(poBatch);
+}
+
+OGRErr      OGRLayerDecorator::SetNextByIndex( GIntBig nIndex )
 {
     return m_poDecoratedLayer->SetNextByIndex(nIndex);
 }
 
-OGRFeature *OGRLayerDecorator::GetFeature( long nFID )
+OGRFeature *OGRLayerDecorator::GetFeature( GIntBig nFID )
 {
     return m_poDecoratedLayer->GetFeature(nFID);
 }
@@ -108,7 +113,7 @@ OGRErr      OGRLayerDecorator::CreateFeature( OGRFeature *poFeature )
     return m_poDecoratedLayer->CreateFeature(poFeature);
 }
 
-OGRErr      OGRLayerDecorator::DeleteFeature( long nFID )
+OGRErr      OGRLayerDecorator::DeleteFeature( GIntBig nFID )
 {
     return m_poDecoratedLayer->DeleteFeature(nFID);
 }
@@ -133,7 +138,7 @@ OGRSpatialReference *OGRLayerDecorator::GetSpatialRef()
     return m_poDecoratedLayer->GetSpatialRef();
 }
 
-int         OGRLayerDecorator::GetFeatureCount( int bForce )
+GIntBig     OGRLayerDecorator::GetFeatureCount( int bForce )
 {
     return m_poDecoratedLayer->GetFeatureCount(bForce);
 }
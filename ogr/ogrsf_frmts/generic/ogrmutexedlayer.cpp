@@ -95,13 +95,19 @@ OGRFeature *OGRMutexedLayer::GetNextFeature()
     return OGRLayerDecorator::GetNextFeature();
 }
 
-OGRErr      OGRMutexedLayer::SetNextByIndex( long nIndex )
+int         OGRMutexedLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    return OGRLayerDecorator::GetNextFeatureBatch(poBatch);
+}
+
+OGRErr      OGRMutexedLayer::SetNextByIndex( GIntBig nIndex )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
     return OGRLayerDecorator::SetNextByIndex(nIndex);
 }
 
-OGRFeature *OGRMutexedLayer::GetFeature( long nFID )
+OGRFeature *OGRMutexedLayer::GetFeature( GIntBig nFID )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
     return OGRLayerDecorator::GetFeature(nFID);
@@ -119,7 +125,7 @@ OGRErr      OGRMutexedLayer::CreateFeature( OGRFeature *poFeature )
     return OGRLayerDecorator::CreateFeature(poFeature);
 }
 
-OGRErr      OGRMutexedLayer::DeleteFeature( long nFID )
+OGRErr      OGRMutexedLayer::DeleteFeature( GIntBig nFID )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
     return OGRLayerDecorator::DeleteFeature(nFID);
@@ -149,7 +155,7 @@ OGRSpatialReference *OGRMutexedLayer::GetSpatialRef()
     return OGRLayerDecorator::GetSpatialRef();
 }
 
-int         OGRMutexedLayer::GetFeatureCount( int bForce )
+GIntBig     OGRMutexedLayer::GetFeatureCount( int bForce )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
     return OGRLayerDecorator::GetFeatureCount(bForce);
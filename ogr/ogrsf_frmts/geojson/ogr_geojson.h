@@ -38,6 +38,7 @@
 #define SPACE_FOR_BBOX  80
 
 class OGRGeoJSONDataSource;
+class OGRGeoJSONReader;
 
 /************************************************************************/
 /*                           OGRGeoJSONLayer                            */
@@ -62,9 +63,10 @@ public:
     //
     OGRFeatureDefn* GetLayerDefn();
     
-    int GetFeatureCount( int bForce = TRUE );
+    GIntBig GetFeatureCount( int bForce = TRUE );
     void ResetReading();
     OGRFeature* GetNextFeature();
+    OGRFeature* GetFeature( GIntBig nFID );
     int TestCapability( const char* pszCap );
     const char* GetFIDColumn();
     void SetFIDColumn( const char* pszFIDColumn );
@@ -74,6 +76,7 @@ public:
     //
     void AddFeature( OGRFeature* poFeature );
     void DetectGeometryType();
+    void SetStreamingReader( OGRGeoJSONReader* poReader );
 
 private:
 
@@ -84,6 +87,10 @@ private:
     OGRGeoJSONDataSource* poDS_;
     OGRFeatureDefn* poFeatureDefn_;
     CPLString sFIDColumn_;
+
+    // Set when features are read from the file on demand, instead of
+    // being stored in seqFeatures_.
+    OGRGeoJSONReader* poStreamingReader_;
 };
 
 /************************************************************************/
@@ -201,6 +208,8 @@ private:
     //
     void Clear();
     int ReadFromFile( GDALOpenInfo* poOpenInfo );
+    int UseStreaming( GDALOpenInfo* poOpenInfo );
+    OGRErr ReadFromFileStreaming( GDALOpenInfo* poOpenInfo );
     int ReadFromService( const char* pszSource );
     void LoadLayers();
 };
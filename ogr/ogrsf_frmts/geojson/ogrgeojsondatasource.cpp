@@ -84,6 +84,22 @@ int OGRGeoJSONDataSource::Open( GDALOpenInfo* poOpenInfo,
     }
     else if( eGeoJSONSourceFile == nSrcType )
     {
+/* -------------------------------------------------------------------- */
+/*      Large FeatureCollection files are read in streaming mode, so    */
+/*      that they do not need to be loaded in memory.                   */
+/* -------------------------------------------------------------------- */
+        if( UseStreaming( poOpenInfo ) )
+        {
+            OGRErr eErr = ReadFromFileStreaming( poOpenInfo );
+            if( OGRERR_NONE == eErr )
+                return TRUE;
+            if( OGRERR_UNSUPPORTED_OPERATION != eErr )
+            {
+                Clear();
+                return FALSE;
+            }
+        }
+
         if( !ReadFromFile( poOpenInfo ) )
             return FALSE;
     }
@@ -365,6 +381,78 @@ int OGRGeoJSONDataSource::ReadFromFile( GDALOpenInfo* poOpenInfo )
     return TRUE;
 }
 
+/************************************************************************/
+/*                            UseStreaming()                            */
+/*                                                                      */
+/*      Streaming is used for files whose header identifies a           */
+/*      FeatureCollection, and that are larger than 10 MB, unless       */
+/*      forced with the GEOJSON_STREAMING configuration option.         */
+/************************************************************************/
+
+int OGRGeoJSONDataSource::UseStreaming( GDALOpenInfo* poOpenInfo )
+{
+    const char* pszOpt = CPLGetConfigOption("GEOJSON_STREAMING", "AUTO");
+    if( !EQUAL(pszOpt, "AUTO") && !CSLTestBoolean(pszOpt) )
+        return FALSE;
+
+    if( poOpenInfo->pabyHeader == NULL )
+        return FALSE;
+
+    const char* pszHeader = (const char*) poOpenInfo->pabyHeader;
+    if( strstr(pszHeader, "\"FeatureCollection\"") == NULL ||
+        strstr(pszHeader, "\"Topology\"") != NULL ||
+        strstr(pszHeader, "esriGeometry") != NULL ||
+        strstr(pszHeader, "esriFieldType") != NULL )
+        return FALSE;
+
+    if( EQUAL(pszOpt, "AUTO") )
+    {
+        VSIStatBufL sStatBuf;
+        if( VSIStatL( poOpenInfo->pszFilename, &sStatBuf ) != 0 ||
+            sStatBuf.st_size < 10 * 1024 * 1024 )
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        ReadFromFileStreaming()                       */
+/************************************************************************/
+
+OGRErr OGRGeoJSONDataSource::ReadFromFileStreaming( GDALOpenInfo* poOpenInfo )
+{
+    VSILFILE* fp = VSIFOpenL( poOpenInfo->pszFilename, "rb" );
+    if( NULL == fp )
+        return OGRERR_UNSUPPORTED_OPERATION;
+
+    OGRGeoJSONReader* poReader = new OGRGeoJSONReader();
+
+    if( eGeometryAsCollection == flTransGeom_ )
+    {
+        poReader->SetPreserveGeometryType( false );
+        CPLDebug( "GeoJSON", "Geometry as OGRGeometryCollection type." );
+    }
+
+    if( eAtributesSkip == flTransAttrs_ )
+    {
+        poReader->SetSkipAttributes( true );
+        CPLDebug( "GeoJSON", "Skip all attributes." );
+    }
+
+    /* On success, the reader is owned by the layer */
+    OGRErr eErr = poReader->FirstPassReadLayer( this, fp );
+    if( OGRERR_NONE != eErr )
+    {
+        delete poReader;
+        return eErr;
+    }
+
+    pszName_ = CPLStrdup( poOpenInfo->pszFilename );
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                           ReadFromService()                          */
 /************************************************************************/
@@ -0,0 +1,313 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Incremental scanner of the features of a GeoJSON FeatureCollection
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrgeojsonreader.h"
+#include "cpl_error.h"
+#include <ctype.h>
+
+CPL_CVSID("$Id$");
+
+#define SCANNER_BUFFER_SIZE 65536
+
+/************************************************************************/
+/*                      OGRGeoJSONFeatureScanner()                      */
+/************************************************************************/
+
+OGRGeoJSONFeatureScanner::OGRGeoJSONFeatureScanner( VSILFILE* fp )
+    : fp_( fp ),
+        pszBuffer_( (char*) CPLMalloc( SCANNER_BUFFER_SIZE ) ),
+        nBufferSize_( 0 ), nBufferPos_( 0 ), nBufferOffset_( 0 ),
+        eState_( eBeforeObject ), nDepth_( 0 ),
+        bInString_( false ), bEscape_( false ),
+        posCapture_( NULL ), nCaptureStart_( 0 ),
+        nFeatureOffset_( 0 ), bError_( false )
+{
+    VSIFSeekL( fp_, 0, SEEK_SET );
+}
+
+/************************************************************************/
+/*                     ~OGRGeoJSONFeatureScanner()                      */
+/************************************************************************/
+
+OGRGeoJSONFeatureScanner::~OGRGeoJSONFeatureScanner()
+{
+    CPLFree( pszBuffer_ );
+}
+
+/************************************************************************/
+/*                            StartCapture()                            */
+/************************************************************************/
+
+void OGRGeoJSONFeatureScanner::StartCapture( CPLString* posTarget,
+                                             size_t nPos )
+{
+    posCapture_ = posTarget;
+    nCaptureStart_ = nPos;
+}
+
+/************************************************************************/
+/*                             EndCapture()                             */
+/*                                                                      */
+/*      Append the captured bytes of the current buffer, up to nPos     */
+/*      excluded, to the capture target.                                */
+/************************************************************************/
+
+void OGRGeoJSONFeatureScanner::EndCapture( size_t nPos )
+{
+    if( posCapture_ != NULL && nPos > nCaptureStart_ )
+        posCapture_->append( pszBuffer_ + nCaptureStart_,
+                             nPos - nCaptureStart_ );
+    posCapture_ = NULL;
+}
+
+/************************************************************************/
+/*                             FillBuffer()                             */
+/************************************************************************/
+
+bool OGRGeoJSONFeatureScanner::FillBuffer()
+{
+    /* Flush the pending capture, that continues in the next buffer */
+    if( posCapture_ != NULL )
+    {
+        if( nBufferSize_ > nCaptureStart_ )
+            posCapture_->append( pszBuffer_ + nCaptureStart_,
+                                 nBufferSize_ - nCaptureStart_ );
+        nCaptureStart_ = 0;
+    }
+
+    nBufferOffset_ += nBufferSize_;
+    nBufferSize_ = VSIFReadL( pszBuffer_, 1, SCANNER_BUFFER_SIZE, fp_ );
+    nBufferPos_ = 0;
+
+    return nBufferSize_ != 0;
+}
+
+/************************************************************************/
+/*                           SetSyntaxError()                           */
+/************************************************************************/
+
+void OGRGeoJSONFeatureScanner::SetSyntaxError( const char* pszMsg,
+                                               size_t nPos )
+{
+    CPLError( CE_Failure, CPLE_AppDefined,
+              "GeoJSON parsing error: %s (at offset " CPL_FRMT_GUIB ")",
+              pszMsg, (GUIntBig)(nBufferOffset_ + nPos) );
+    bError_ = true;
+    posCapture_ = NULL;
+}
+
+/************************************************************************/
+/*                            NextFeature()                             */
+/*                                                                      */
+/*      Advance to the next object of the top-level "features" array.   */
+/*      Returns false at the end of the document, or on error.          */
+/************************************************************************/
+
+bool OGRGeoJSONFeatureScanner::NextFeature()
+{
+    osFeature_.clear();
+
+    while( !bError_ && eState_ != eEnd )
+    {
+        if( nBufferPos_ == nBufferSize_ && !FillBuffer() )
+        {
+            SetSyntaxError( "unexpected end of file", 0 );
+            return false;
+        }
+
+        for( size_t i = nBufferPos_; i < nBufferSize_; i++ )
+        {
+            const char ch = pszBuffer_[i];
+
+            if( bInString_ )
+            {
+                if( bEscape_ )
+                    bEscape_ = false;
+                else if( ch == '\\' )
+                    bEscape_ = true;
+                else if( ch == '"' )
+                {
+                    bInString_ = false;
+                    if( eState_ == eInKey )
+                    {
+                        EndCapture( i );
+                        eState_ = eExpectColon;
+                    }
+                }
+                continue;
+            }
+
+            switch( eState_ )
+            {
+/* -------------------------------------------------------------------- */
+/*      Skip anything before the root object (JSONP prefix, ...)        */
+/* -------------------------------------------------------------------- */
+              case eBeforeObject:
+                if( ch == '{' )
+                {
+                    nDepth_ = 1;
+                    eState_ = eExpectKey;
+                }
+                break;
+
+/* -------------------------------------------------------------------- */
+/*      Members of the root object.                                     */
+/* -------------------------------------------------------------------- */
+              case eExpectKey:
+                if( ch == '"' )
+                {
+                    bInString_ = true;
+                    eState_ = eInKey;
+                    osKey_.clear();
+                    StartCapture( &osKey_, i + 1 );
+                }
+                else if( ch == '}' )
+                {
+                    nDepth_ = 0;
+                    eState_ = eEnd;
+                }
+                else if( ch != ',' && !isspace((unsigned char)ch) )
+                {
+                    SetSyntaxError( "member name expected", i );
+                    return false;
+                }
+                break;
+
+              case eExpectColon:
+                if( ch == ':' )
+                {
+                    if( osKey_ == "features" )
+                        eState_ = eExpectFeaturesArray;
+                    else
+                    {
+                        /* Other members are kept in the header object */
+                        if( osHeader_.size() )
+                            osHeader_ += ",";
+                        osHeader_ += "\"";
+                        osHeader_ += osKey_;
+                        osHeader_ += "\":";
+                        StartCapture( &osHeader_, i + 1 );
+                        eState_ = eInMember;
+                    }
+                }
+                else if( !isspace((unsigned char)ch) )
+                {
+                    SetSyntaxError( "':' expected", i );
+                    return false;
+                }
+                break;
+
+              case eInMember:
+                if( ch == '"' )
+                    bInString_ = true;
+                else if( ch == '{' || ch == '[' )
+                    nDepth_ ++;
+                else if( ch == '}' || ch == ']' )
+                {
+                    if( nDepth_ == 1 )
+                    {
+                        EndCapture( i );
+                        nDepth_ = 0;
+                        eState_ = eEnd;
+                    }
+                    else
+                        nDepth_ --;
+                }
+                else if( ch == ',' && nDepth_ == 1 )
+                {
+                    EndCapture( i );
+                    eState_ = eExpectKey;
+                }
+                break;
+
+/* -------------------------------------------------------------------- */
+/*      Elements of the "features" array.                               */
+/* -------------------------------------------------------------------- */
+              case eExpectFeaturesArray:
+                if( ch == '[' )
+                {
+                    nDepth_ = 2;
+                    eState_ = eInFeaturesArray;
+                }
+                else if( !isspace((unsigned char)ch) )
+                {
+                    SetSyntaxError( "'features' member is not an array", i );
+                    return false;
+                }
+                break;
+
+              case eInFeaturesArray:
+                if( ch == '"' )
+                    bInString_ = true;
+                else if( ch == '{' || ch == '[' )
+                {
+                    if( nDepth_ == 2 && ch == '{' )
+                    {
+                        nFeatureOffset_ = nBufferOffset_ + i;
+                        StartCapture( &osFeature_, i );
+                    }
+                    nDepth_ ++;
+                }
+                else if( ch == '}' || ch == ']' )
+                {
+                    nDepth_ --;
+                    if( nDepth_ == 1 )
+                        eState_ = eExpectKey;
+                    else if( nDepth_ == 2 && posCapture_ == &osFeature_ )
+                    {
+                        EndCapture( i + 1 );
+                        nBufferPos_ = i + 1;
+                        return true;
+                    }
+                }
+                break;
+
+              case eInKey:
+              case eEnd:
+                break;
+            }
+
+            if( eState_ == eEnd )
+                break;
+        }
+
+        nBufferPos_ = nBufferSize_;
+    }
+
+    return false;
+}
+
+/************************************************************************/
+/*                             GetHeader()                              */
+/************************************************************************/
+
+CPLString OGRGeoJSONFeatureScanner::GetHeader() const
+{
+    return "{" + osHeader_ + "}";
+}
@@ -30,6 +30,7 @@
 #include <algorithm> // for_each, find_if
 #include <json.h> // JSON-C
 #include "ogr_geojson.h"
+#include "ogrgeojsonreader.h"
 
 /* Remove annoying warnings Microsoft Visual C++ */
 #if defined(_MSC_VER)
@@ -52,7 +53,8 @@ OGRGeoJSONLayer::OGRGeoJSONLayer( const char* pszName,
                                   OGRSpatialReference* poSRSIn,
                                   OGRwkbGeometryType eGType,
                                   OGRGeoJSONDataSource* poDS )
-    : iterCurrent_( seqFeatures_.end() ), poDS_( poDS ), poFeatureDefn_(new OGRFeatureDefn( pszName ) )
+    : iterCurrent_( seqFeatures_.end() ), poDS_( poDS ), poFeatureDefn_(new OGRFeatureDefn( pszName ) ),
+      poStreamingReader_( NULL )
 {
     CPLAssert( NULL != poDS_ );
     CPLAssert( NULL != poFeatureDefn_ );
@@ -77,6 +79,8 @@ OGRGeoJSONLayer::~OGRGeoJSONLayer()
     {
         poFeatureDefn_->Release();
     }
+
+    delete poStreamingReader_;
 }
 
 /************************************************************************/
@@ -92,10 +96,14 @@ OGRFeatureDefn* OGRGeoJSONLayer::GetLayerDefn()
 /*                           GetFeatureCount                            */
 /************************************************************************/
 
-int OGRGeoJSONLayer::GetFeatureCount( int bForce )
+GIntBig OGRGeoJSONLayer::GetFeatureCount( int bForce )
 {
     if (m_poFilterGeom == NULL && m_poAttrQuery == NULL)
+    {
+        if( NULL != poStreamingReader_ )
+            return poStreamingReader_->GetFeatureCount();
         return static_cast<int>( seqFeatures_.size() );
+    }
     else
         return OGRLayer::GetFeatureCount(bForce);
 }
@@ -106,6 +114,8 @@ int OGRGeoJSONLayer::GetFeatureCount( int bForce )
 
 void OGRGeoJSONLayer::ResetReading()
 {
+    if( NULL != poStreamingReader_ )
+        poStreamingReader_->ResetReading();
     iterCurrent_ = seqFeatures_.begin();
 }
 
@@ -115,6 +125,30 @@ void OGRGeoJSONLayer::ResetReading()
 
 OGRFeature* OGRGeoJSONLayer::GetNextFeature()
 {
+    if( NULL != poStreamingReader_ )
+    {
+        OGRFeature* poFeature;
+        while( (poFeature = poStreamingReader_->GetNextFeature( this )) != NULL )
+        {
+            if((m_poFilterGeom == NULL
+                || FilterGeometry( poFeature->GetGeometryRef() ) )
+            && (m_poAttrQuery == NULL
+                || m_poAttrQuery->Evaluate( poFeature )) )
+            {
+                if (poFeature->GetGeometryRef() != NULL && GetSpatialRef() != NULL)
+                {
+                    poFeature->GetGeometryRef()->assignSpatialReference( GetSpatialRef() );
+                }
+
+                return poFeature;
+            }
+
+            delete poFeature;
+        }
+
+        return NULL;
+    }
+
     while ( iterCurrent_ != seqFeatures_.end() )
     {
         OGRFeature* poFeature = (*iterCurrent_);
@@ -141,13 +175,38 @@ OGRFeature* OGRGeoJSONLayer::GetNextFeature()
     return NULL;
 }
 
+/************************************************************************/
+/*                           GetFeature                                 */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONLayer::GetFeature( GIntBig nFID )
+{
+    if( NULL == poStreamingReader_ )
+        return OGRLayer::GetFeature( nFID );
+
+    OGRFeature* poFeature = poStreamingReader_->GetFeature( this, nFID );
+    if( NULL != poFeature && poFeature->GetGeometryRef() != NULL &&
+        GetSpatialRef() != NULL )
+    {
+        poFeature->GetGeometryRef()->assignSpatialReference( GetSpatialRef() );
+    }
+
+    return poFeature;
+}
+
 /************************************************************************/
 /*                           TestCapability                             */
 /************************************************************************/
 
 int OGRGeoJSONLayer::TestCapability( const char* pszCap )
 {
-    UNREFERENCED_PARAM(pszCap);
+    if( NULL != poStreamingReader_ )
+    {
+        if( EQUAL( pszCap, OLCRandomRead ) )
+            return TRUE;
+        if( EQUAL( pszCap, OLCFastFeatureCount ) )
+            return m_poFilterGeom == NULL && m_poAttrQuery == NULL;
+    }
 
     return FALSE;
 }
@@ -204,6 +263,18 @@ void OGRGeoJSONLayer::AddFeature( OGRFeature* poFeature )
     seqFeatures_.push_back( poNewFeature );
 }
 
+/************************************************************************/
+/*                           SetStreamingReader                         */
+/************************************************************************/
+
+void OGRGeoJSONLayer::SetStreamingReader( OGRGeoJSONReader* poReader )
+{
+    CPLAssert( seqFeatures_.empty() );
+
+    delete poStreamingReader_;
+    poStreamingReader_ = poReader;
+}
+
 /************************************************************************/
 /*                           DetectGeometryType                         */
 /************************************************************************/
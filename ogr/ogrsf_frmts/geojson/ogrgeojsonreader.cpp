@@ -41,7 +41,8 @@ OGRGeoJSONReader::OGRGeoJSONReader()
     : poGJObject_( NULL ),
         bGeometryPreserve_( true ),
         bAttributesSkip_( false ),
-        bFlattenGeocouchSpatiallistFormat (-1), bFoundId (false), bFoundRev(false), bFoundTypeFeature(false), bIsGeocouchSpatiallistFormat(false)
+        bFlattenGeocouchSpatiallistFormat (-1), bFoundId (false), bFoundRev(false), bFoundTypeFeature(false), bIsGeocouchSpatiallistFormat(false),
+        fp_( NULL ), nNextFeature_( 0 )
 {
     // Take a deep breath and get to work.
 }
@@ -58,6 +59,11 @@ OGRGeoJSONReader::~OGRGeoJSONReader()
     }
 
     poGJObject_ = NULL;
+
+    if( NULL != fp_ )
+    {
+        VSIFCloseL( fp_ );
+    }
 }
 
 /************************************************************************/
@@ -408,6 +414,17 @@ bool OGRGeoJSONReader::GenerateLayerDefn( OGRGeoJSONLayer* poLayer, json_object*
         }
     }
 
+    FinalizeLayerDefn( poLayer );
+
+    return bSuccess;
+}
+
+/************************************************************************/
+/*                         FinalizeLayerDefn()                          */
+/************************************************************************/
+
+void OGRGeoJSONReader::FinalizeLayerDefn( OGRGeoJSONLayer* poLayer )
+{
 /* -------------------------------------------------------------------- */
 /*      Validate and add FID column if necessary.                       */
 /* -------------------------------------------------------------------- */
@@ -439,8 +456,6 @@ bool OGRGeoJSONReader::GenerateLayerDefn( OGRGeoJSONLayer* poLayer, json_object*
       poLayer_->SetFIDColumn( fldDefn.GetNameRef() );
       }
     */
-
-    return bSuccess;
 }
 
 /************************************************************************/
@@ -876,6 +891,339 @@ OGRGeoJSONReader::ReadFeatureCollection( OGRGeoJSONLayer* poLayer, json_object*
     }
 }
 
+/************************************************************************/
+/*                         FirstPassReadLayer()                         */
+/*                                                                      */
+/*      Scan a FeatureCollection stored in a file, to establish the     */
+/*      layer schema and the location of each feature, without          */
+/*      keeping the features in memory. The reader takes ownership of   */
+/*      fp, and on success, is itself owned by the created layer.       */
+/*      Returns OGRERR_UNSUPPORTED_OPERATION if the file is not a       */
+/*      FeatureCollection, so that it can be read in memory instead.    */
+/************************************************************************/
+
+OGRErr OGRGeoJSONReader::FirstPassReadLayer( OGRGeoJSONDataSource* poDS,
+                                             VSILFILE* fp )
+{
+    CPLAssert( NULL == fp_ );
+    fp_ = fp;
+
+    OGRGeoJSONLayer* poLayer = new OGRGeoJSONLayer( OGRGeoJSONLayer::DefaultName,
+                                    NULL,
+                                    OGRGeoJSONLayer::DefaultGeometryType,
+                                    poDS );
+    OGRFeatureDefn* poDefn = poLayer->GetLayerDefn();
+
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    bool bMixedGeomType = false;
+
+    // Candidate ids of the features. See ReadFeature() for how they are
+    // used to set the FID. Only allocated if at least one feature has one.
+    std::vector<GIntBig> anPropertyIds;
+    std::vector<GIntBig> anTopLevelIds;
+
+    OGRGeoJSONFeatureScanner oScanner( fp_ );
+    while( oScanner.NextFeature() )
+    {
+        json_tokener* jstok = json_tokener_new();
+        json_object* poObj = json_tokener_parse_ex( jstok,
+                                                    oScanner.GetFeatureText(),
+                                                    (int)oScanner.GetFeatureSize() );
+        if( jstok->err != json_tokener_success )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "GeoJSON parsing error: %s (at offset " CPL_FRMT_GUIB ")",
+                      json_tokener_error_desc(jstok->err),
+                      (GUIntBig)(oScanner.GetFeatureOffset() + jstok->char_offset) );
+            json_tokener_free( jstok );
+            delete poLayer;
+            return OGRERR_CORRUPT_DATA;
+        }
+        json_tokener_free( jstok );
+
+        if( !bAttributesSkip_ && !GenerateFeatureDefn( poLayer, poObj ) )
+        {
+            CPLDebug( "GeoJSON", "Create feature schema failure." );
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Features without a geometry member are rejected by              */
+/*      ReadFeature(), so they are skipped.                             */
+/* -------------------------------------------------------------------- */
+        bool bHasGeomMember = false;
+        json_object* poObjGeom = NULL;
+        json_object_iter it;
+        it.key = NULL;
+        it.val = NULL;
+        it.entry = NULL;
+        json_object_object_foreachC( poObj, it )
+        {
+            if( EQUAL( it.key, "geometry" ) )
+            {
+                bHasGeomMember = true;
+                poObjGeom = it.val;
+            }
+        }
+        if( !bHasGeomMember )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Invalid Feature object. "
+                      "Missing \'geometry\' member." );
+            json_object_put( poObj );
+            continue;
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Same logic as OGRGeoJSONLayer::DetectGeometryType().            */
+/* -------------------------------------------------------------------- */
+        if( !bMixedGeomType && NULL != poObjGeom )
+        {
+            OGRGeometry* poGeometry = ReadGeometry( poObjGeom );
+            if( NULL != poGeometry )
+            {
+                OGRwkbGeometryType eType = poGeometry->getGeometryType();
+                if( aoFeatures_.size() == 0 )
+                    eGeomType = eType;
+                else if( eType != eGeomType )
+                {
+                    CPLDebug( "GeoJSON",
+                        "Detected layer of mixed-geometry type features." );
+                    eGeomType = OGRGeoJSONLayer::DefaultGeometryType;
+                    bMixedGeomType = true;
+                }
+                delete poGeometry;
+            }
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Collect the ids of the feature.                                 */
+/* -------------------------------------------------------------------- */
+        GIntBig nPropertyId = -1;
+        json_object* poObjProps = OGRGeoJSONFindMemberByName( poObj, "properties" );
+        if( NULL != poObjProps &&
+            json_object_get_type(poObjProps) == json_type_object )
+        {
+            if( bIsGeocouchSpatiallistFormat )
+                poObjProps = json_object_object_get(poObjProps, "properties");
+            json_object* poObjId = NULL;
+            if( NULL != poObjProps &&
+                json_object_get_type(poObjProps) == json_type_object )
+                poObjId = json_object_object_get( poObjProps,
+                                        OGRGeoJSONLayer::DefaultFIDColumn );
+            if( NULL != poObjId )
+                nPropertyId = json_object_get_int( poObjId );
+        }
+
+        GIntBig nTopLevelId = -1;
+        json_object* poObjId = OGRGeoJSONFindMemberByName( poObj,
+                                        OGRGeoJSONLayer::DefaultFIDColumn );
+        if( NULL != poObjId && json_object_get_type(poObjId) == json_type_int )
+            nTopLevelId = json_object_get_int( poObjId );
+
+        if( nPropertyId != -1 && anPropertyIds.size() == 0 )
+            anPropertyIds.resize( aoFeatures_.size(), -1 );
+        if( anPropertyIds.size() != 0 )
+            anPropertyIds.push_back( nPropertyId );
+
+        if( nTopLevelId != -1 && anTopLevelIds.size() == 0 )
+            anTopLevelIds.resize( aoFeatures_.size(), -1 );
+        if( anTopLevelIds.size() != 0 )
+            anTopLevelIds.push_back( nTopLevelId );
+
+        FeatureLocation sLocation;
+        sLocation.nOffset = oScanner.GetFeatureOffset();
+        sLocation.nSize = oScanner.GetFeatureSize();
+        aoFeatures_.push_back( sLocation );
+
+        json_object_put( poObj );
+    }
+
+    if( oScanner.HasError() )
+    {
+        delete poLayer;
+        return OGRERR_CORRUPT_DATA;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Check that this is really a FeatureCollection.                  */
+/* -------------------------------------------------------------------- */
+    json_object* poHeader = json_tokener_parse( oScanner.GetHeader() );
+    json_object* poObjType = NULL;
+    if( NULL != poHeader )
+        poObjType = OGRGeoJSONFindMemberByName( poHeader, "type" );
+    if( NULL == poObjType ||
+        json_object_get_type( poObjType ) != json_type_string ||
+        !EQUAL( json_object_get_string( poObjType ), "FeatureCollection" ) )
+    {
+        if( NULL != poHeader )
+            json_object_put( poHeader );
+        delete poLayer;
+        return OGRERR_UNSUPPORTED_OPERATION;
+    }
+
+    if( !bAttributesSkip_ )
+        FinalizeLayerDefn( poLayer );
+
+    poDefn->SetGeomType( eGeomType );
+
+    OGRSpatialReference* poSRS = OGRGeoJSONReadSpatialReference( poHeader );
+    if (poSRS == NULL ) {
+        // If there is none defined, we use 4326
+        poSRS = new OGRSpatialReference();
+        if( OGRERR_NONE != poSRS->importFromEPSG( 4326 ) )
+        {
+            delete poSRS;
+            poSRS = NULL;
+        }
+    }
+    if( poDefn->GetGeomFieldCount() != 0 )
+        poDefn->GetGeomFieldDefn(0)->SetSpatialRef( poSRS );
+    if( poSRS != NULL )
+        poSRS->Release();
+
+    json_object_put( poHeader );
+
+/* -------------------------------------------------------------------- */
+/*      Compute the FIDs that ReadFeature() will assign, if they are    */
+/*      not the index of the features.                                  */
+/* -------------------------------------------------------------------- */
+    if( anPropertyIds.size() != 0 || anTopLevelIds.size() != 0 )
+    {
+        const bool bUsePropertyId =
+            EQUAL( OGRGeoJSONLayer::DefaultFIDColumn, poLayer->GetFIDColumn() );
+        bool bFIDIsIndex = true;
+
+        anFIDs_.resize( aoFeatures_.size() );
+        for( size_t i = 0; i < aoFeatures_.size(); i++ )
+        {
+            GIntBig nFID = -1;
+            if( bUsePropertyId && anPropertyIds.size() != 0 )
+                nFID = anPropertyIds[i];
+            if( nFID == -1 && anTopLevelIds.size() != 0 )
+                nFID = anTopLevelIds[i];
+            if( nFID == -1 )
+                nFID = (GIntBig)i;
+            anFIDs_[i] = nFID;
+            if( nFID != (GIntBig)i )
+                bFIDIsIndex = false;
+        }
+
+        if( bFIDIsIndex )
+            std::vector<GIntBig>().swap( anFIDs_ );
+    }
+
+    CPLDebug( "GeoJSON", "Streaming mode: %d features found in first pass",
+              (int)aoFeatures_.size() );
+
+    ResetReading();
+    poLayer->SetStreamingReader( this );
+    poDS->AddLayer( poLayer );
+
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            ResetReading()                            */
+/************************************************************************/
+
+void OGRGeoJSONReader::ResetReading()
+{
+    nNextFeature_ = 0;
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONReader::GetNextFeature( OGRGeoJSONLayer* poLayer )
+{
+    if( nNextFeature_ >= aoFeatures_.size() )
+        return NULL;
+
+    return ReadFeatureAt( poLayer, nNextFeature_++ );
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONReader::GetFeature( OGRGeoJSONLayer* poLayer,
+                                          GIntBig nFID )
+{
+    GIntBig iFeature = nFID;
+
+    if( anFIDs_.size() != 0 )
+    {
+        if( oMapFIDToIndex_.size() == 0 )
+        {
+            for( size_t i = 0; i < anFIDs_.size(); i++ )
+                oMapFIDToIndex_.insert(
+                    std::pair<GIntBig, size_t>( anFIDs_[i], i ) );
+        }
+
+        std::map<GIntBig, size_t>::const_iterator oIter =
+            oMapFIDToIndex_.find( nFID );
+        if( oIter == oMapFIDToIndex_.end() )
+            return NULL;
+        iFeature = (GIntBig)oIter->second;
+    }
+
+    if( iFeature < 0 || iFeature >= (GIntBig)aoFeatures_.size() )
+        return NULL;
+
+    return ReadFeatureAt( poLayer, (size_t)iFeature );
+}
+
+/************************************************************************/
+/*                           ReadFeatureAt()                            */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONReader::ReadFeatureAt( OGRGeoJSONLayer* poLayer,
+                                             size_t iFeature )
+{
+    const FeatureLocation& sLocation = aoFeatures_[iFeature];
+
+    abyBuffer_.resize( sLocation.nSize + 1 );
+    if( VSIFSeekL( fp_, sLocation.nOffset, SEEK_SET ) != 0 ||
+        VSIFReadL( &abyBuffer_[0], 1, sLocation.nSize, fp_ ) != sLocation.nSize )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot read feature at offset " CPL_FRMT_GUIB,
+                  (GUIntBig)sLocation.nOffset );
+        return NULL;
+    }
+    abyBuffer_[sLocation.nSize] = '\0';
+
+    json_object* poObj = json_tokener_parse( &abyBuffer_[0] );
+    if( NULL == poObj )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "GeoJSON parsing error for feature at offset " CPL_FRMT_GUIB,
+                  (GUIntBig)sLocation.nOffset );
+        return NULL;
+    }
+
+    OGRFeature* poFeature = ReadFeature( poLayer, poObj );
+    json_object_put( poObj );
+
+/* -------------------------------------------------------------------- */
+/*      Same logic as OGRGeoJSONLayer::AddFeature().                    */
+/* -------------------------------------------------------------------- */
+    if( NULL != poFeature && -1 == poFeature->GetFID() )
+    {
+        int nFID = static_cast<int>(iFeature);
+        poFeature->SetFID( nFID );
+
+        int nField = poFeature->GetFieldIndex( OGRGeoJSONLayer::DefaultFIDColumn );
+        if( -1 != nField && poLayer->GetLayerDefn()->GetFieldDefn(nField)->GetType() == OFTInteger )
+        {
+            poFeature->SetField( nField, nFID );
+        }
+    }
+
+    return poFeature;
+}
+
 /************************************************************************/
 /*                           OGRGeoJSONFindMemberByName                 */
 /************************************************************************/
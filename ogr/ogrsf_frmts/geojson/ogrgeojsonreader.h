@@ -31,7 +31,11 @@
 #define OGR_GEOJSONREADER_H_INCLUDED
 
 #include <ogr_core.h>
+#include <cpl_string.h>
+#include <cpl_vsi.h>
 #include <json.h> // JSON-C
+#include <map>
+#include <vector>
 
 /************************************************************************/
 /*                         FORWARD DECLARATIONS                         */
@@ -78,6 +82,73 @@ struct GeoJSONObject
     };
 };
 
+/************************************************************************/
+/*                       OGRGeoJSONFeatureScanner                       */
+/************************************************************************/
+
+/* Reads a FeatureCollection from a file by chunks, and returns the text */
+/* of the elements of its "features" array one at a time, without       */
+/* building the JSON tree of the whole document. The other members of   */
+/* the root object are collected in a "header" object.                  */
+
+class OGRGeoJSONFeatureScanner
+{
+public:
+
+    OGRGeoJSONFeatureScanner( VSILFILE* fp );
+    ~OGRGeoJSONFeatureScanner();
+
+    bool NextFeature();
+    const char* GetFeatureText() const { return osFeature_.c_str(); }
+    size_t GetFeatureSize() const { return osFeature_.size(); }
+    vsi_l_offset GetFeatureOffset() const { return nFeatureOffset_; }
+
+    CPLString GetHeader() const;
+    bool HasError() const { return bError_; }
+
+private:
+
+    enum State
+    {
+        eBeforeObject,
+        eExpectKey,
+        eInKey,
+        eExpectColon,
+        eInMember,
+        eExpectFeaturesArray,
+        eInFeaturesArray,
+        eEnd
+    };
+
+    VSILFILE* fp_;
+    char* pszBuffer_;
+    size_t nBufferSize_;
+    size_t nBufferPos_;
+    vsi_l_offset nBufferOffset_;
+
+    State eState_;
+    int nDepth_;
+    bool bInString_;
+    bool bEscape_;
+
+    CPLString osKey_;
+    CPLString osHeader_;
+    CPLString osFeature_;
+    CPLString* posCapture_;
+    size_t nCaptureStart_;
+    vsi_l_offset nFeatureOffset_;
+
+    bool bError_;
+
+    OGRGeoJSONFeatureScanner( OGRGeoJSONFeatureScanner const& );
+    OGRGeoJSONFeatureScanner& operator=( OGRGeoJSONFeatureScanner const& );
+
+    bool FillBuffer();
+    void StartCapture( CPLString* posTarget, size_t nPos );
+    void EndCapture( size_t nPos );
+    void SetSyntaxError( const char* pszMsg, size_t nPos );
+};
+
 /************************************************************************/
 /*                           OGRGeoJSONReader                           */
 /************************************************************************/
@@ -100,6 +171,15 @@ public:
                     const char* pszName,
                     json_object* poObj );
 
+    //
+    // Streaming read of a FeatureCollection stored in a file.
+    //
+    OGRErr FirstPassReadLayer( OGRGeoJSONDataSource* poDS, VSILFILE* fp );
+    void ResetReading();
+    OGRFeature* GetNextFeature( OGRGeoJSONLayer* poLayer );
+    OGRFeature* GetFeature( OGRGeoJSONLayer* poLayer, GIntBig nFID );
+    GIntBig GetFeatureCount() const { return (GIntBig)aoFeatures_.size(); }
+
 private:
 
     json_object* poGJObject_;
@@ -110,6 +190,20 @@ private:
     int bFlattenGeocouchSpatiallistFormat;
     bool bFoundId, bFoundRev, bFoundTypeFeature, bIsGeocouchSpatiallistFormat;
 
+    // Location of a feature object in the file, in streaming mode.
+    struct FeatureLocation
+    {
+        vsi_l_offset nOffset;
+        size_t nSize;
+    };
+
+    VSILFILE* fp_;
+    std::vector<FeatureLocation> aoFeatures_;
+    std::vector<GIntBig> anFIDs_; // empty if FID == index of the feature
+    std::map<GIntBig, size_t> oMapFIDToIndex_;
+    size_t nNextFeature_;
+    std::vector<char> abyBuffer_;
+
     //
     // Copy operations not supported.
     //
@@ -121,12 +215,14 @@ private:
     //
     bool GenerateLayerDefn( OGRGeoJSONLayer* poLayer, json_object* poGJObject );
     bool GenerateFeatureDefn( OGRGeoJSONLayer* poLayer, json_object* poObj );
+    void FinalizeLayerDefn( OGRGeoJSONLayer* poLayer );
     bool AddFeature( OGRGeoJSONLayer* poLayer, OGRGeometry* poGeometry );
     bool AddFeature( OGRGeoJSONLayer* poLayer, OGRFeature* poFeature );
 
     OGRGeometry* ReadGeometry( json_object* poObj );
     OGRFeature* ReadFeature( OGRGeoJSONLayer* poLayer, json_object* poObj );
     void ReadFeatureCollection( OGRGeoJSONLayer* poLayer, json_object* poObj );
+    OGRFeature* ReadFeatureAt( OGRGeoJSONLayer* poLayer, size_t iFeature );
 };
 
 /************************************************************************/
@@ -134,7 +134,7 @@ void OGRGeomediaSelectLayer::ResetReading()
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRGeomediaSelectLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRGeomediaSelectLayer::GetFeature( GIntBig nFeatureId )
 
 {
     return OGRGeomediaLayer::GetFeature( nFeatureId );
@@ -159,7 +159,7 @@ int OGRGeomediaSelectLayer::TestCapability( const char * pszCap )
 /*      way of counting features matching a spatial query.              */
 /************************************************************************/
 
-int OGRGeomediaSelectLayer::GetFeatureCount( int bForce )
+GIntBig OGRGeomediaSelectLayer::GetFeatureCount( int bForce )
 
 {
     return OGRGeomediaLayer::GetFeatureCount( bForce );
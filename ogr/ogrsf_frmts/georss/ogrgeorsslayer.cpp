@@ -2227,7 +2227,7 @@ int OGRGeoRSSLayer::TestCapability( const char * pszCap )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRGeoRSSLayer::GetFeatureCount( int bForce )
+GIntBig OGRGeoRSSLayer::GetFeatureCount( int bForce )
 
 {
     if (bWriteMode)
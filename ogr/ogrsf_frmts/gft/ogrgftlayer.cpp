@@ -501,7 +501,7 @@ OGRFeature *OGRGFTLayer::GetNextRawFeature()
 /*                          SetNextByIndex()                            */
 /************************************************************************/
 
-OGRErr OGRGFTLayer::SetNextByIndex( long nIndex )
+OGRErr OGRGFTLayer::SetNextByIndex( GIntBig nIndex )
 {
     if (nIndex < 0)
         return OGRERR_FAILURE;
@@ -124,7 +124,7 @@ class OGRGMELayer : public OGRLayer
 
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
     virtual OGRErr      CreateFeature( OGRFeature *poFeature );
-    virtual OGRErr      DeleteFeature(long int);
+    virtual OGRErr      DeleteFeature(GIntBig int);
     virtual OGRErr      CreateField( OGRFieldDefn *poField, int bApproxOK = TRUE );
 
     virtual OGRErr      StartTransaction();
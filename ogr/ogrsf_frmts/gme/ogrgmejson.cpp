@@ -60,7 +60,7 @@ json_object* OGRGMEFeatureToGeoJSON(OGRFeature* poFeature)
     pjoGeometry = OGRGMEGeometryToGeoJSON(poGeometry);
     if ( NULL == pjoGeometry ) {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "GME: NULL Geometry detected in feature %ld. Ignoring feature.",
+                  "GME: NULL Geometry detected in feature " CPL_FRMT_GIB ". Ignoring feature.",
                   poFeature->GetFID() );
         json_object_put( pjoFeature );
         return NULL;
@@ -728,12 +728,12 @@ OGRErr OGRGMELayer::CreateFeature( OGRFeature *poFeature )
     int nGxId = poFeature->GetFieldIndex("gx_id");
     CPLDebug("GME", "gx_id is field %d", iGxIdField);
     CPLString osGxId;
-    CPLDebug("GME", "Inserting feature %ld as %s", poFeature->GetFID(), osGxId.c_str());
+    CPLDebug("GME", "Inserting feature " CPL_FRMT_GIB " as %s", poFeature->GetFID(), osGxId.c_str());
     if (nGxId >= 0) {
         iGxIdField = nGxId;
         if(poFeature->IsFieldSet(iGxIdField)) {
           osGxId = poFeature->GetFieldAsString(iGxIdField);
-          CPLDebug("GME", "Feature already has %ld gx_id='%s'", poFeature->GetFID(),
+          CPLDebug("GME", "Feature already has " CPL_FRMT_GIB " gx_id='%s'", poFeature->GetFID(),
                    osGxId.c_str());
         }
         else {
@@ -807,14 +807,14 @@ OGRErr OGRGMELayer::SetFeature( OGRFeature *poFeature )
 /*                           DeleteteFeature()                          */
 /************************************************************************/
 
-OGRErr OGRGMELayer::DeleteFeature( long nFID )
+OGRErr OGRGMELayer::DeleteFeature( GIntBig nFID )
 {
     if(bInTransaction) {
         std::map<int, OGRFeature *>::iterator fit;
         fit = omnpoInsertedFeatures.find(nFID);
         if (fit != omnpoInsertedFeatures.end()) {
             omnpoInsertedFeatures.erase(fit);
-            CPLDebug("GME", "Found %ld in omnpoInsertedFeatures", nFID);
+            CPLDebug("GME", "Found " CPL_FRMT_GIB " in omnpoInsertedFeatures", nFID);
         }
         else {
             unsigned int iBatchSize = GetBatchPatchSize();
@@ -522,7 +522,7 @@ OGRFeature *OGRGMLLayer::GetNextFeature()
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRGMLLayer::GetFeatureCount( int bForce )
+GIntBig OGRGMLLayer::GetFeatureCount( int bForce )
 
 {
     if( poFClass == NULL )
@@ -671,7 +671,7 @@ OGRErr OGRGMLLayer::CreateFeature( OGRFeature *poFeature )
                              poFeatureDefn->GetName(),
                              poFeature->GetFieldAsString(nGMLIdIndex) );
         else
-            poDS->PrintLine( fp, "%s gml:id=\"%s.%ld\">",
+            poDS->PrintLine( fp, "%s gml:id=\"%s." CPL_FRMT_GIB "\">",
                              poFeatureDefn->GetName(),
                              poFeatureDefn->GetName(),
                              poFeature->GetFID() );
@@ -681,7 +681,7 @@ OGRErr OGRGMLLayer::CreateFeature( OGRFeature *poFeature )
         nGMLIdIndex = poFeatureDefn->GetFieldIndex("fid");
         if (bUseOldFIDFormat)
         {
-            poDS->PrintLine( fp, "%s fid=\"F%ld\">",
+            poDS->PrintLine( fp, "%s fid=\"F" CPL_FRMT_GIB "\">",
                              poFeatureDefn->GetName(),
                              poFeature->GetFID() );
         }
@@ -693,7 +693,7 @@ OGRErr OGRGMLLayer::CreateFeature( OGRFeature *poFeature )
         }
         else
         {
-            poDS->PrintLine( fp, "%s fid=\"%s.%ld\">",
+            poDS->PrintLine( fp, "%s fid=\"%s." CPL_FRMT_GIB "\">",
                              poFeatureDefn->GetName(),
                              poFeatureDefn->GetName(),
                              poFeature->GetFID() );
@@ -752,13 +752,13 @@ OGRErr OGRGMLLayer::CreateFeature( OGRFeature *poFeature )
             {
                 if( poFeatureDefn->GetGeomFieldCount() > 1 )
                     papszOptions = CSLAddString(papszOptions,
-                        CPLSPrintf("GMLID=%s.%s.%ld",
+                        CPLSPrintf("GMLID=%s.%s." CPL_FRMT_GIB,
                                    poFeatureDefn->GetName(),
                                    poFieldDefn->GetNameRef(),
                                    poFeature->GetFID()));
                 else
                     papszOptions = CSLAddString(papszOptions,
-                        CPLSPrintf("GMLID=%s.geom.%ld",
+                        CPLSPrintf("GMLID=%s.geom." CPL_FRMT_GIB,
                                    poFeatureDefn->GetName(), poFeature->GetFID()));
             }
             pszGeometry = poGeom->exportToGML(papszOptions);
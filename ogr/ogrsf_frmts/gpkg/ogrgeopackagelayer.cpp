@@ -141,7 +141,7 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
             return NULL;
 
         if( (m_poFilterGeom == NULL
-            || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
+            || FilterGeometry( poFeature, m_iGeomFieldFilter ) )
             && (m_poAttrQuery == NULL
                 || m_poAttrQuery->Evaluate( poFeature )) )
             return poFeature;
@@ -185,15 +185,34 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
         if ( sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
             !poGeomFieldDefn->IsIgnored() )
         {
-            OGRSpatialReference* poSrs = poGeomFieldDefn->GetSpatialRef();
             int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
             GByte *pabyGpkg = (GByte *)sqlite3_column_blob(hStmt, iGeomCol);
-            OGRGeometry *poGeom = GPkgGeometryToOGR(pabyGpkg, iGpkgSize, poSrs);
-            if ( ! poGeom )
+            GPkgHeader oHeader;
+
+            /* Keep the WKB part of the blob: the geometry will only be */
+            /* built if it is requested, and the envelope of the header */
+            /* saves scanning it for spatial filtering */
+            if( iGpkgSize < 8 ||
+                GPkgHeaderFromWKB(pabyGpkg, &oHeader) != OGRERR_NONE ||
+                oHeader.szHeader >= (size_t)iGpkgSize )
             {
                 CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
             }
-            poFeature->SetGeometryDirectly( poGeom );
+            else
+            {
+                OGREnvelope sEnvelope;
+                int bHasEnvelope = ( !oHeader.bEmpty && oHeader.iDims > 0 );
+                if( bHasEnvelope )
+                {
+                    sEnvelope.MinX = oHeader.MinX;
+                    sEnvelope.MaxX = oHeader.MaxX;
+                    sEnvelope.MinY = oHeader.MinY;
+                    sEnvelope.MaxY = oHeader.MaxY;
+                }
+                poFeature->SetGeomFieldWKB( 0, pabyGpkg + oHeader.szHeader,
+                                            iGpkgSize - (int)oHeader.szHeader,
+                                            bHasEnvelope ? &sEnvelope : NULL );
+            }
         }
     }
     
@@ -267,6 +286,131 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
     return poFeature;
 }
 
+/************************************************************************/
+/*                     TranslateFeatureIntoBatch()                      */
+/*                                                                      */
+/*      Same as TranslateFeature(), but appends the current result to   */
+/*      a batch without instanciating a feature.                        */
+/************************************************************************/
+
+void OGRGeoPackageLayer::TranslateFeatureIntoBatch( sqlite3_stmt* hStmt,
+                                                    OGRFeatureBatch* poBatch )
+
+{
+    int         iField;
+
+    if( iFIDCol >= 0 )
+        poBatch->BeginFeature( sqlite3_column_int64( hStmt, iFIDCol ) );
+    else
+        poBatch->BeginFeature( iNextShapeId );
+
+    iNextShapeId++;
+
+    m_nFeaturesRead++;
+
+/* -------------------------------------------------------------------- */
+/*      The geometry blob is a GeoPackage header followed by WKB, so    */
+/*      the WKB can be copied as it is.                                 */
+/* -------------------------------------------------------------------- */
+    if( iGeomCol >= 0 )
+    {
+        OGRGeomFieldDefn* poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(0);
+        if ( sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
+            !poGeomFieldDefn->IsIgnored() )
+        {
+            int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+            const GByte *pabyGpkg = (const GByte *)sqlite3_column_blob(hStmt, iGeomCol);
+            GPkgHeader oHeader;
+            if ( iGpkgSize < 8 ||
+                 GPkgHeaderFromWKB(pabyGpkg, &oHeader) != OGRERR_NONE ||
+                 oHeader.szHeader >= (size_t)iGpkgSize )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
+            }
+            else
+            {
+                poBatch->SetGeomFieldWKB( 0, pabyGpkg + oHeader.szHeader,
+                                          iGpkgSize - (int)oHeader.szHeader );
+            }
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      set the fields.                                                 */
+/* -------------------------------------------------------------------- */
+    for( iField = 0; iField < m_poFeatureDefn->GetFieldCount(); iField++ )
+    {
+        OGRFieldDefn *poFieldDefn = m_poFeatureDefn->GetFieldDefn( iField );
+        if ( poFieldDefn->IsIgnored() )
+            continue;
+
+        int iRawField = panFieldOrdinals[iField];
+
+        if( sqlite3_column_type( hStmt, iRawField ) == SQLITE_NULL )
+            continue;
+
+        switch( poFieldDefn->GetType() )
+        {
+            case OFTInteger:
+                poBatch->SetField( iField, 
+                    sqlite3_column_int( hStmt, iRawField ) );
+                break;
+
+            case OFTReal:
+                poBatch->SetField( iField, 
+                    sqlite3_column_double( hStmt, iRawField ) );
+                break;
+
+            case OFTBinary:
+            {
+                const GByte* pabyData = (const GByte*)sqlite3_column_blob( hStmt, iRawField );
+                const int nBytes = sqlite3_column_bytes( hStmt, iRawField );
+
+                poBatch->SetField( iField, nBytes, pabyData );
+                break;
+            }
+
+            case OFTDate:
+            case OFTDateTime:
+            {
+                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
+                int nYear, nMonth, nDay, nHour = 0, nMinute = 0;
+                float fSecond = 0.0f;
+                int nParsed = sscanf(pszTxt, "%d-%d-%dT%d:%d:%fZ", &nYear, &nMonth,
+                                     &nDay, &nHour, &nMinute, &fSecond);
+                if( (poFieldDefn->GetType() == OFTDate && nParsed >= 3) ||
+                    nParsed == 6 )
+                {
+                    OGRField sField;
+                    memset( &sField, 0, sizeof(sField) );
+                    sField.Date.Year = (GInt16)nYear;
+                    sField.Date.Month = (GByte)nMonth;
+                    sField.Date.Day = (GByte)nDay;
+                    if( poFieldDefn->GetType() == OFTDateTime )
+                    {
+                        sField.Date.Hour = (GByte)nHour;
+                        sField.Date.Minute = (GByte)nMinute;
+                        sField.Date.Second = (GByte)(int)(fSecond + 0.5);
+                    }
+                    poBatch->SetField( iField, &sField );
+                }
+                break;
+            }
+
+            case OFTString:
+            {
+                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
+                poBatch->SetField( iField, pszTxt,
+                                   sqlite3_column_bytes( hStmt, iRawField ) );
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
 /************************************************************************/
 /*                      GetFIDColumn()                                  */
 /************************************************************************/
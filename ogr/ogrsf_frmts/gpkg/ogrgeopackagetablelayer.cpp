@@ -129,7 +129,8 @@ OGRErr OGRGeoPackageTableLayer::BuildColumns()
 OGRBoolean OGRGeoPackageTableLayer::IsGeomFieldSet( OGRFeature *poFeature )
 {
     if ( poFeature->GetDefnRef()->GetGeomFieldCount() && 
-         poFeature->GetGeomFieldRef(0) )
+         (poFeature->GetGeomFieldWKB(0, NULL) != NULL ||
+          poFeature->GetGeomFieldRef(0)) )
     {
         return TRUE;        
     }
@@ -154,18 +155,28 @@ OGRErr OGRGeoPackageTableLayer::FeatureBindParameters( OGRFeature *poFeature,
 
     if( bAddFID )
     {
-        err = sqlite3_bind_int(poStmt, nColCount++, poFeature->GetFID());
+        err = sqlite3_bind_int64(poStmt, nColCount++, poFeature->GetFID());
     }
 
     /* Bind data values to the statement, here bind the blob for geometry */
     if ( poFeatureDefn->GetGeomFieldCount() )
     {
         GByte *pabyWkb = NULL;
+        size_t szWkb = 0;
+
+        /* Geometry still in WKB form: copy it without building it */
+        int nFeatureWkbSize = 0;
+        const GByte *pabyFeatureWkb = poFeature->GetGeomFieldWKB(0, &nFeatureWkbSize);
+        if ( pabyFeatureWkb != NULL )
+            pabyWkb = GPkgGeometryFromWKB(pabyFeatureWkb, nFeatureWkbSize, m_iSrs, &szWkb);
 
         /* Non-NULL geometry */
-        if ( poFeature->GetGeomFieldRef(0) )
+        if ( pabyWkb != NULL )
+        {
+            err = sqlite3_bind_blob(poStmt, nColCount++, pabyWkb, szWkb, CPLFree);
+        }
+        else if ( poFeature->GetGeomFieldRef(0) )
         {
-            size_t szWkb;
             pabyWkb = GPkgGeometryFromOGR(poFeature->GetGeomFieldRef(0), m_iSrs, &szWkb);
             err = sqlite3_bind_blob(poStmt, nColCount++, pabyWkb, szWkb, CPLFree);
         }
@@ -263,11 +274,11 @@ OGRErr OGRGeoPackageTableLayer::FeatureBindUpdateParameters( OGRFeature *poFeatu
         return err;
 
     /* Bind the FID to the "WHERE" clause */
-    err = sqlite3_bind_int(poStmt, nColCount, poFeature->GetFID());    
+    err = sqlite3_bind_int64(poStmt, nColCount, poFeature->GetFID());    
     if ( err != SQLITE_OK )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "failed to bind FID '%ld' to statement", poFeature->GetFID());
+                  "failed to bind FID '" CPL_FRMT_GIB "' to statement", poFeature->GetFID());
         return OGRERR_FAILURE;       
     }
     
@@ -790,12 +801,12 @@ OGRErr OGRGeoPackageTableLayer::CreateFeature( OGRFeature *poFeature )
     if ( IsGeomFieldSet(poFeature) )
     {
         OGREnvelope oEnv;
-        poFeature->GetGeomFieldRef(0)->getEnvelope(&oEnv);
-        UpdateExtent(&oEnv);
+        if ( poFeature->GetGeomFieldEnvelope(0, &oEnv) == OGRERR_NONE )
+            UpdateExtent(&oEnv);
     }
 
     /* Read the latest FID value */
-    int iFid;
+    GIntBig iFid;
     if ( (iFid = sqlite3_last_insert_rowid(m_poDS->GetDB())) )
     {
         poFeature->SetFID(iFid);
@@ -908,8 +919,8 @@ OGRErr OGRGeoPackageTableLayer::SetFeature( OGRFeature *poFeature )
         if ( IsGeomFieldSet(poFeature) )
         {
             OGREnvelope oEnv;
-            poFeature->GetGeomFieldRef(0)->getEnvelope(&oEnv);
-            UpdateExtent(&oEnv);
+            if ( poFeature->GetGeomFieldEnvelope(0, &oEnv) == OGRERR_NONE )
+                UpdateExtent(&oEnv);
         }
     }
 
@@ -1006,11 +1017,61 @@ OGRFeature* OGRGeoPackageTableLayer::GetNextFeature()
     return OGRGeoPackageLayer::GetNextFeature();
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRGeoPackageTableLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    CreateSpatialIndexIfNecessary();
+
+    /* Features must be instanciated to be evaluated against the filters */
+    if( m_poFilterGeom != NULL || m_poAttrQuery != NULL ||
+        poBatch->GetDefnRef() != m_poFeatureDefn )
+        return OGRLayer::GetNextFeatureBatch(poBatch);
+
+    poBatch->Reset();
+
+    while( !poBatch->IsFull() )
+    {
+        if( m_poQueryStatement == NULL )
+        {
+            ResetStatement();
+            if (m_poQueryStatement == NULL)
+                break;
+        }
+
+        if( bDoStep )
+        {
+            int rc = sqlite3_step( m_poQueryStatement );
+            if( rc != SQLITE_ROW )
+            {
+                if ( rc != SQLITE_DONE )
+                {
+                    sqlite3_reset(m_poQueryStatement);
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                            "In GetNextFeatureBatch(): sqlite3_step() : %s",
+                            sqlite3_errmsg(m_poDS->GetDB()) );
+                }
+
+                ClearStatement();
+                break;
+            }
+        }
+        else
+            bDoStep = TRUE;
+
+        TranslateFeatureIntoBatch( m_poQueryStatement, poBatch );
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                        GetFeature()                                  */
 /************************************************************************/
 
-OGRFeature* OGRGeoPackageTableLayer::GetFeature(long nFID)
+OGRFeature* OGRGeoPackageTableLayer::GetFeature(GIntBig nFID)
 {
     /* No FID, no answer. */
     if (nFID == OGRNullFID || m_pszFidColumn == NULL )
@@ -1023,7 +1084,7 @@ OGRFeature* OGRGeoPackageTableLayer::GetFeature(long nFID)
 
     /* No filters apply, just use the FID */
     CPLString soSQL;
-    soSQL.Printf("SELECT %s FROM \"%s\" WHERE \"%s\" = %ld",
+    soSQL.Printf("SELECT %s FROM \"%s\" WHERE \"%s\" = " CPL_FRMT_GIB,
                  m_soColumns.c_str(), m_pszTableName, m_pszFidColumn, nFID);
 
     int err = sqlite3_prepare(m_poDS->GetDB(), soSQL.c_str(), -1, &m_poQueryStatement, NULL);
@@ -1056,7 +1117,7 @@ OGRFeature* OGRGeoPackageTableLayer::GetFeature(long nFID)
 /*                        DeleteFeature()                               */
 /************************************************************************/
 
-OGRErr OGRGeoPackageTableLayer::DeleteFeature(long nFID) 
+OGRErr OGRGeoPackageTableLayer::DeleteFeature(GIntBig nFID) 
 {
     if( !m_poDS->GetUpdate() || m_pszFidColumn == NULL )
     {
@@ -1075,7 +1136,7 @@ OGRErr OGRGeoPackageTableLayer::DeleteFeature(long nFID)
 
     /* No filters apply, just use the FID */
     CPLString soSQL;
-    soSQL.Printf("DELETE FROM \"%s\" WHERE \"%s\" = %ld",
+    soSQL.Printf("DELETE FROM \"%s\" WHERE \"%s\" = " CPL_FRMT_GIB,
                  m_pszTableName, m_pszFidColumn, nFID);
 
     
@@ -1126,7 +1187,7 @@ OGRErr OGRGeoPackageTableLayer::RollbackTransaction()
 /*                        GetFeatureCount()                             */
 /************************************************************************/
 
-int OGRGeoPackageTableLayer::GetFeatureCount( int bForce )
+GIntBig OGRGeoPackageTableLayer::GetFeatureCount( int bForce )
 {
     if( m_poFilterGeom != NULL && !m_bFilterIsEnvelope )
         return OGRGeoPackageLayer::GetFeatureCount();
@@ -1140,7 +1201,7 @@ int OGRGeoPackageTableLayer::GetFeatureCount( int bForce )
         soSQL.Printf("SELECT Count(*) FROM \"%s\" ", m_pszTableName);
 
     /* Just run the query directly and get back integer */
-    int iFeatureCount = SQLGetInteger(m_poDS->GetDB(), soSQL.c_str(), &err);
+    GIntBig iFeatureCount = SQLGetInteger64(m_poDS->GetDB(), soSQL.c_str(), &err);
 
     /* Generic implementation uses -1 for error condition, so we will too */
     if ( err == OGRERR_NONE )
@@ -186,6 +186,42 @@ int SQLGetInteger(sqlite3 * poDb, const char * pszSQL, OGRErr *err)
     return i;
 }
 
+/* Returns the first row of first column of SQL as 64 bit integer */
+GIntBig SQLGetInteger64(sqlite3 * poDb, const char * pszSQL, OGRErr *err)
+{
+    CPLAssert( poDb != NULL );
+    
+    sqlite3_stmt *poStmt;
+    int rc;
+    GIntBig i;
+    
+    /* Prepare the SQL */
+    rc = sqlite3_prepare_v2(poDb, pszSQL, strlen(pszSQL), &poStmt, NULL);
+    if ( rc != SQLITE_OK )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined, "sqlite3_prepare_v2(%s) failed: %s",
+                  pszSQL, sqlite3_errmsg( poDb ) );
+        if ( err ) *err = OGRERR_FAILURE;
+        return 0;
+    }
+    
+    /* Execute and fetch first row */
+    rc = sqlite3_step(poStmt);
+    if ( rc != SQLITE_ROW )
+    {
+        if ( err ) *err = OGRERR_FAILURE;
+        sqlite3_finalize(poStmt);
+        return 0;
+    }
+    
+    /* Read the integer from the row */
+    i = sqlite3_column_int64(poStmt, 0);
+    sqlite3_finalize(poStmt);
+    
+    if ( err ) *err = OGRERR_NONE;
+    return i;
+}
+
 
 /* Requirement 20: A GeoPackage SHALL store feature table geometries */
 /* with the basic simple feature geometry types (Geometry, Point, */
@@ -459,6 +495,72 @@ GByte* GPkgGeometryFromOGR(const OGRGeometry *poGeometry, int iSrsId, size_t *ps
 }
 
 
+/* Build a GeoPackage geometry blob directly from a 2D WKB geometry, */
+/* typically one that has been read from another GeoPackage and has not */
+/* been instanciated. Returns NULL if the WKB cannot be passed through as */
+/* it is, in which case GPkgGeometryFromOGR() must be used. */
+GByte* GPkgGeometryFromWKB(const GByte *pabyWkbIn, int nWkbSize, int iSrsId, size_t *pszWkb)
+{
+    CPLAssert( pabyWkbIn != NULL );
+
+    if ( nWkbSize < 5 || (pabyWkbIn[0] != wkbXDR && pabyWkbIn[0] != wkbNDR) )
+        return NULL;
+
+    /* Only 2D types have the same encoding in the OGC and ISO variants */
+    GUInt32 nRawType;
+    memcpy(&nRawType, pabyWkbIn + 1, 4);
+    if ( OGR_SWAP((OGRwkbByteOrder)pabyWkbIn[0]) )
+        nRawType = CPL_SWAP32(nRawType);
+    if ( nRawType < (GUInt32)wkbPoint || nRawType > (GUInt32)wkbGeometryCollection )
+        return NULL;
+
+    OGREnvelope oEnv;
+    OGRErr err = OGRWKBGetEnvelope(pabyWkbIn, nWkbSize, &oEnv);
+    if ( err == OGRERR_CORRUPT_DATA )
+        return NULL;
+    OGRBoolean bEmpty = (err != OGRERR_NONE);
+    OGRBoolean bPoint = (nRawType == (GUInt32)wkbPoint);
+
+    GByte byFlags = 0;
+    OGRwkbByteOrder eByteOrder = (OGRwkbByteOrder)CPL_IS_LSB;
+
+    size_t szHeader = 2+1+1+4;
+    if ( ! bPoint && ! bEmpty )
+        szHeader += 8*2*2;
+
+    size_t szWkb = szHeader + nWkbSize;
+    GByte *pabyWkb = (GByte *)CPLMalloc(szWkb);
+    if (pszWkb)
+        *pszWkb = szWkb;
+
+    /* Header Magic and GPKG BLOB Version */
+    pabyWkb[0] = 0x47;
+    pabyWkb[1] = 0x50;
+    pabyWkb[2] = 0;
+
+    if ( bEmpty )
+        byFlags |= (1 << 4);
+    else if ( ! bPoint )
+        byFlags |= (1 << 1); /* 2D envelope */
+    byFlags |= eByteOrder;
+    pabyWkb[3] = byFlags;
+
+    memcpy(pabyWkb+4, &iSrsId, 4);
+
+    if ( ! bPoint && ! bEmpty )
+    {
+        double *padPtr = (double*)(pabyWkb+8);
+        padPtr[0] = oEnv.MinX;
+        padPtr[1] = oEnv.MaxX;
+        padPtr[2] = oEnv.MinY;
+        padPtr[3] = oEnv.MaxY;
+    }
+
+    memcpy(pabyWkb + szHeader, pabyWkbIn, nWkbSize);
+
+    return pabyWkb;
+}
+
 OGRErr GPkgHeaderFromWKB(const GByte *pabyGpkg, GPkgHeader *poHeader)
 {
     CPLAssert( pabyGpkg != NULL );
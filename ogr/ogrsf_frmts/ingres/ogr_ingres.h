@@ -117,7 +117,7 @@ class OGRIngresLayer : public OGRLayer
 
     virtual OGRFeature *GetNextFeature();
 
-    virtual OGRFeature *GetFeature( long nFeatureId );
+    virtual OGRFeature *GetFeature( GIntBig nFeatureId );
     
     OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
@@ -164,7 +164,7 @@ class OGRIngresTableLayer : public OGRIngresLayer
 
     OGRErr              Initialize(const char* pszTableName);
     
-//    virtual OGRFeature *GetFeature( long nFeatureId );
+//    virtual OGRFeature *GetFeature( GIntBig nFeatureId );
     virtual void        ResetReading();
 //    virtual int         GetFeatureCount( int );
 
@@ -173,7 +173,7 @@ class OGRIngresTableLayer : public OGRIngresLayer
     virtual OGRErr      SetAttributeFilter( const char * );
 
     virtual OGRErr      CreateFeature( OGRFeature *poFeature );
-    virtual OGRErr      DeleteFeature( long nFID );
+    virtual OGRErr      DeleteFeature( GIntBig nFID );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
 
     virtual OGRErr      CreateField( OGRFieldDefn *poField,
@@ -213,7 +213,7 @@ class OGRIngresResultLayer : public OGRIngresLayer
 
 
     virtual void        ResetReading();
-    virtual int         GetFeatureCount( int );
+    virtual GIntBig     GetFeatureCount( int );
 };
 
 /************************************************************************/
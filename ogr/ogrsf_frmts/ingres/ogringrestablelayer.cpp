@@ -492,7 +492,7 @@ OGRErr OGRIngresTableLayer::SetFeature( OGRFeature *poFeature )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRIngresTableLayer::DeleteFeature( long nFID )
+OGRErr OGRIngresTableLayer::DeleteFeature( GIntBig nFID )
 
 {
     CPLString           osCommand;
@@ -504,7 +504,7 @@ OGRErr OGRIngresTableLayer::DeleteFeature( long nFID )
     if( osFIDColumn.size() == 0 )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "DeleteFeature(%ld) failed.  Unable to delete features "
+                  "DeleteFeature(" CPL_FRMT_GIB ") failed.  Unable to delete features "
                   "in tables without\n a recognised FID column.",
                   nFID );
         return OGRERR_FAILURE;
@@ -514,7 +514,7 @@ OGRErr OGRIngresTableLayer::DeleteFeature( long nFID )
 /* -------------------------------------------------------------------- */
 /*      Form the statement to drop the record.                          */
 /* -------------------------------------------------------------------- */
-    osCommand.Printf( "DELETE FROM %s WHERE %s = %ld",
+    osCommand.Printf( "DELETE FROM %s WHERE %s = " CPL_FRMT_GIB,
                       poFeatureDefn->GetName(), osFIDColumn.c_str(), nFID );
                       
 /* -------------------------------------------------------------------- */
@@ -913,7 +913,7 @@ OGRErr OGRIngresTableLayer::CreateFeature( OGRFeature *poFeature )
     {
         if( bNeedComma )
             osCommand += ", ";
-        osCommand += CPLString().Printf( "%ld ", poFeature->GetFID() );
+        osCommand += CPLString().Printf( CPL_FRMT_GIB " ", poFeature->GetFID() );
         bNeedComma = TRUE;
     }
 
@@ -1132,7 +1132,7 @@ OGRErr OGRIngresTableLayer::CreateField( OGRFieldDefn *poFieldIn,
 /*                             GetFeature()                             */
 /************************************************************************/
 #ifdef notdef
-OGRFeature *OGRIngresTableLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRIngresTableLayer::GetFeature( GIntBig nFeatureId )
 
 {
     if( pszFIDColumn == NULL )
@@ -1151,7 +1151,7 @@ OGRFeature *OGRIngresTableLayer::GetFeature( long nFeatureId )
     char        *pszCommand = (char *) CPLMalloc(strlen(pszFieldList)+2000);
 
     sprintf( pszCommand, 
-             "SELECT %s FROM %s WHERE %s = %ld", 
+             "SELECT %s FROM %s WHERE %s = " CPL_FRMT_GIB, 
              pszFieldList, poFeatureDefn->GetName(), pszFIDColumn, 
              nFeatureId );
     CPLFree( pszFieldList );
@@ -1215,7 +1215,7 @@ OGRFeature *OGRIngresTableLayer::GetFeature( long nFeatureId )
 /************************************************************************/
 
 #ifdef notdef
-int OGRIngresTableLayer::GetFeatureCount( int bForce )
+GIntBig OGRIngresTableLayer::GetFeatureCount( int bForce )
 
 {
 /* -------------------------------------------------------------------- */
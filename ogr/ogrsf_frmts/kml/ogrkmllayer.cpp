@@ -216,7 +216,7 @@ OGRFeature *OGRKMLLayer::GetNextFeature()
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRKMLLayer::GetFeatureCount( int bForce )
+GIntBig OGRKMLLayer::GetFeatureCount( int bForce )
 {
     int nCount = 0;
 
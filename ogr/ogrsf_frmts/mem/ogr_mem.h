@@ -32,6 +32,7 @@
 #define _OGRMEM_H_INCLUDED
 
 #include "ogrsf_frmts.h"
+#include "cpl_quad_tree.h"
 
 /************************************************************************/
 /*                             OGRMemLayer                              */
@@ -41,18 +42,35 @@ class OGRMemLayer : public OGRLayer
 {
     OGRFeatureDefn     *poFeatureDefn;
     
-    int                 nFeatureCount;
-    int                 nMaxFeatureCount;
+    GIntBig             nFeatureCount;
+    GIntBig             nMaxFeatureCount;
     OGRFeature        **papoFeatures;
 
-    int                 iNextReadFID;
-    int                 iNextCreateFID;
+    GIntBig             iNextReadFID;
+    GIntBig             iNextCreateFID;
 
     int                 bUpdatable;
     int                 bAdvertizeUTF8;
 
     int                 bHasHoles;
 
+    /* Spatial index over the envelopes of the geometries of the field */
+    /* iSpatialIndexGeomField, built on the first spatial query */
+    CPLQuadTree        *hSpatialIndex;
+    int                 iSpatialIndexGeomField;
+    CPLRectObj          sSpatialIndexBounds;
+    GIntBig             nSpatialIndexStaleEntries;
+
+    GIntBig            *panMatchingFIDs;
+    int                 nMatchingFIDs;
+    int                 iMatchingFID;
+
+    void                BuildSpatialIndex();
+    void                InvalidateSpatialIndex();
+    void                AddToSpatialIndex( OGRFeature *poFeature );
+    void                ScanSpatialIndex();
+    OGRFeature         *GetNextCandidateFeature();
+
   public:
                         OGRMemLayer( const char * pszName,
                                      OGRSpatialReference *poSRS,
@@ -61,16 +79,17 @@ class OGRMemLayer : public OGRLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
-    virtual OGRErr      SetNextByIndex( long nIndex );
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch );
+    virtual OGRErr      SetNextByIndex( GIntBig nIndex );
 
-    OGRFeature         *GetFeature( long nFeatureId );
+    OGRFeature         *GetFeature( GIntBig nFeatureId );
     OGRErr              SetFeature( OGRFeature *poFeature );
     OGRErr              CreateFeature( OGRFeature *poFeature );
-    virtual OGRErr      DeleteFeature( long nFID );
+    virtual OGRErr      DeleteFeature( GIntBig nFID );
     
     OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
-    int                 GetFeatureCount( int );
+    GIntBig             GetFeatureCount( int );
 
     virtual OGRErr      CreateField( OGRFieldDefn *poField,
                                      int bApproxOK = TRUE );
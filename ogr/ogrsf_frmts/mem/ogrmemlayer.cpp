@@ -31,6 +31,7 @@
 #include "ogr_mem.h"
 #include "cpl_conv.h"
 #include "ogr_p.h"
+#include <algorithm>
 
 CPL_CVSID("$Id$");
 
@@ -63,6 +64,14 @@ OGRMemLayer::OGRMemLayer( const char * pszName, OGRSpatialReference *poSRSIn,
     bUpdatable = TRUE;
     bAdvertizeUTF8 = FALSE;
     bHasHoles = FALSE;
+
+    hSpatialIndex = NULL;
+    iSpatialIndexGeomField = 0;
+    nSpatialIndexStaleEntries = 0;
+
+    panMatchingFIDs = NULL;
+    nMatchingFIDs = 0;
+    iMatchingFID = 0;
 }
 
 /************************************************************************/
@@ -79,13 +88,16 @@ OGRMemLayer::~OGRMemLayer()
                   poFeatureDefn->GetName() );
     }
 
-    for( int i = 0; i < nMaxFeatureCount; i++ )
+    for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
     {
         if( papoFeatures[i] != NULL )
             delete papoFeatures[i];
     }
     CPLFree( papoFeatures );
 
+    InvalidateSpatialIndex();
+    CPLFree( panMatchingFIDs );
+
     if( poFeatureDefn )
         poFeatureDefn->Release();
 }
@@ -98,6 +110,11 @@ void OGRMemLayer::ResetReading()
 
 {
     iNextReadFID = 0;
+
+    CPLFree( panMatchingFIDs );
+    panMatchingFIDs = NULL;
+    nMatchingFIDs = 0;
+    iMatchingFID = 0;
 }
 
 /************************************************************************/
@@ -107,13 +124,10 @@ void OGRMemLayer::ResetReading()
 OGRFeature *OGRMemLayer::GetNextFeature()
 
 {
-    while( iNextReadFID < nMaxFeatureCount )
-    {
-        OGRFeature *poFeature = papoFeatures[iNextReadFID++];
-
-        if( poFeature == NULL )
-            continue;
+    OGRFeature *poFeature;
 
+    while( (poFeature = GetNextCandidateFeature()) != NULL )
+    {
         if( (m_poFilterGeom == NULL
              || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
             && (m_poAttrQuery == NULL
@@ -127,11 +141,43 @@ OGRFeature *OGRMemLayer::GetNextFeature()
     return NULL;
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/*                                                                      */
+/*      The stored features are copied directly into the batch,        */
+/*      without being cloned.                                           */
+/************************************************************************/
+
+int OGRMemLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    if( poBatch->GetDefnRef() != poFeatureDefn )
+        return OGRLayer::GetNextFeatureBatch( poBatch );
+
+    poBatch->Reset();
+
+    OGRFeature *poFeature;
+
+    while( !poBatch->IsFull() && (poFeature = GetNextCandidateFeature()) != NULL )
+    {
+        if( (m_poFilterGeom == NULL
+             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
+            && (m_poAttrQuery == NULL
+                || m_poAttrQuery->Evaluate( poFeature ) ) )
+        {
+            m_nFeaturesRead++;
+            poBatch->AddFeature( poFeature );
+        }
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                           SetNextByIndex()                           */
 /************************************************************************/
 
-OGRErr OGRMemLayer::SetNextByIndex( long nIndex )
+OGRErr OGRMemLayer::SetNextByIndex( GIntBig nIndex )
 
 {
     if( m_poFilterGeom != NULL || m_poAttrQuery != NULL || bHasHoles )
@@ -149,7 +195,7 @@ OGRErr OGRMemLayer::SetNextByIndex( long nIndex )
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRMemLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRMemLayer::GetFeature( GIntBig nFeatureId )
 
 {
     if( nFeatureId < 0 || nFeatureId >= nMaxFeatureCount )
@@ -189,19 +235,23 @@ OGRErr OGRMemLayer::SetFeature( OGRFeature *poFeature )
 
     if( poFeature->GetFID() >= nMaxFeatureCount )
     {
-        int nNewCount = MAX(2*nMaxFeatureCount+10, poFeature->GetFID() + 1 );
+        GIntBig nNewCount = MAX(2*nMaxFeatureCount+10, poFeature->GetFID() + 1 );
 
-        OGRFeature** papoNewFeatures = (OGRFeature **) 
-            VSIRealloc( papoFeatures, sizeof(OGRFeature *) * nNewCount);
+        OGRFeature** papoNewFeatures = NULL;
+        if( (GUIntBig) nNewCount <= (~(size_t)0) / sizeof(OGRFeature *) )
+            papoNewFeatures = (OGRFeature **) 
+                VSIRealloc( papoFeatures,
+                            sizeof(OGRFeature *) * (size_t) nNewCount);
         if (papoNewFeatures == NULL)
         {
             CPLError(CE_Failure, CPLE_OutOfMemory,
-                     "Cannot allocate array of %d elements", nNewCount);
+                     "Cannot allocate array of " CPL_FRMT_GIB " elements",
+                     nNewCount);
             return OGRERR_FAILURE;
         }
         papoFeatures = papoNewFeatures;
         memset( papoFeatures + nMaxFeatureCount, 0, 
-                sizeof(OGRFeature *) * (nNewCount - nMaxFeatureCount) );
+                sizeof(OGRFeature *) * (size_t) (nNewCount - nMaxFeatureCount) );
         nMaxFeatureCount = nNewCount;
     }
 
@@ -210,6 +260,10 @@ OGRErr OGRMemLayer::SetFeature( OGRFeature *poFeature )
         delete papoFeatures[poFeature->GetFID()];
         papoFeatures[poFeature->GetFID()] = NULL;
         nFeatureCount--;
+
+        /* The entry of the replaced feature stays in the spatial index */
+        if( hSpatialIndex != NULL )
+            nSpatialIndexStaleEntries ++;
     }
 
     papoFeatures[poFeature->GetFID()] = poFeature->Clone();
@@ -225,6 +279,8 @@ OGRErr OGRMemLayer::SetFeature( OGRFeature *poFeature )
     }
     nFeatureCount++;
 
+    AddToSpatialIndex( papoFeatures[poFeature->GetFID()] );
+
     return OGRERR_NONE;
 }
 
@@ -260,7 +316,7 @@ OGRErr OGRMemLayer::CreateFeature( OGRFeature *poFeature )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRMemLayer::DeleteFeature( long nFID )
+OGRErr OGRMemLayer::DeleteFeature( GIntBig nFID )
 
 {
     if (!bUpdatable)
@@ -278,6 +334,14 @@ OGRErr OGRMemLayer::DeleteFeature( long nFID )
         delete papoFeatures[nFID];
         papoFeatures[nFID] = NULL;
         nFeatureCount--;
+
+        if( hSpatialIndex != NULL )
+        {
+            nSpatialIndexStaleEntries ++;
+            if( nSpatialIndexStaleEntries > nFeatureCount + 1000 )
+                InvalidateSpatialIndex();
+        }
+
         return OGRERR_NONE;
     }
 }
@@ -285,17 +349,31 @@ OGRErr OGRMemLayer::DeleteFeature( long nFID )
 /************************************************************************/
 /*                          GetFeatureCount()                           */
 /*                                                                      */
-/*      If a spatial filter is in effect, we turn control over to       */
-/*      the generic counter.  Otherwise we return the total count.      */
-/*      Eventually we should consider implementing a more efficient     */
-/*      way of counting features matching a spatial query.              */
+/*      If an attribute filter is in effect, we turn control over to    */
+/*      the generic counter. A spatial filter alone is evaluated on     */
+/*      the candidates of the spatial index, without cloning them.      */
 /************************************************************************/
 
-int OGRMemLayer::GetFeatureCount( int bForce )
+GIntBig OGRMemLayer::GetFeatureCount( int bForce )
 
 {
-    if( m_poFilterGeom != NULL || m_poAttrQuery != NULL )
+    if( m_poAttrQuery != NULL )
         return OGRLayer::GetFeatureCount( bForce );
+    else if( m_poFilterGeom != NULL )
+    {
+        GIntBig nCount = 0;
+        OGRFeature *poFeature;
+
+        ResetReading();
+        while( (poFeature = GetNextCandidateFeature()) != NULL )
+        {
+            if( FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
+                nCount ++;
+        }
+        ResetReading();
+
+        return nCount;
+    }
     else
         return nFeatureCount;
 }
@@ -318,7 +396,7 @@ int OGRMemLayer::TestCapability( const char * pszCap )
         return m_poFilterGeom == NULL && m_poAttrQuery == NULL;
 
     else if( EQUAL(pszCap,OLCFastSpatialFilter) )
-        return FALSE;
+        return TRUE;
 
     else if( EQUAL(pszCap,OLCDeleteFeature) )
         return bUpdatable;
@@ -380,10 +458,10 @@ OGRErr OGRMemLayer::CreateField( OGRFieldDefn *poField, int bApproxOK )
 /*      Remap all the internal features.  Hopefully there aren't any    */
 /*      external features referring to our OGRFeatureDefn!              */
 /* -------------------------------------------------------------------- */
-    for( i = 0; i < nMaxFeatureCount; i++ )
+    for( GIntBig iFeature = 0; iFeature < nMaxFeatureCount; iFeature++ )
     {
-        if( papoFeatures[i] != NULL )
-            papoFeatures[i]->RemapFields( NULL, panRemap );
+        if( papoFeatures[iFeature] != NULL )
+            papoFeatures[iFeature]->RemapFields( NULL, panRemap );
     }
 
     CPLFree( panRemap );
@@ -411,7 +489,7 @@ OGRErr OGRMemLayer::DeleteField( int iField )
 /*      Update all the internal features.  Hopefully there aren't any   */
 /*      external features referring to our OGRFeatureDefn!              */
 /* -------------------------------------------------------------------- */
-    for( int i = 0; i < nMaxFeatureCount; i++ )
+    for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
     {
         if( papoFeatures[i] == NULL )
             continue;
@@ -456,7 +534,7 @@ OGRErr OGRMemLayer::ReorderFields( int* panMap )
 /*      Remap all the internal features.  Hopefully there aren't any    */
 /*      external features referring to our OGRFeatureDefn!              */
 /* -------------------------------------------------------------------- */
-    for( int i = 0; i < nMaxFeatureCount; i++ )
+    for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
     {
         if( papoFeatures[i] != NULL )
             papoFeatures[i]->RemapFields( NULL, panMap );
@@ -502,7 +580,7 @@ OGRErr OGRMemLayer::AlterFieldDefn( int iField, OGRFieldDefn* poNewFieldDefn, in
     /*      Update all the internal features.  Hopefully there aren't any   */
     /*      external features referring to our OGRFeatureDefn!              */
     /* -------------------------------------------------------------------- */
-            for( int i = 0; i < nMaxFeatureCount; i++ )
+            for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
             {
                 if( papoFeatures[i] == NULL )
                     continue;
@@ -527,7 +605,7 @@ OGRErr OGRMemLayer::AlterFieldDefn( int iField, OGRFieldDefn* poNewFieldDefn, in
     /*      Update all the internal features.  Hopefully there aren't any   */
     /*      external features referring to our OGRFeatureDefn!              */
     /* -------------------------------------------------------------------- */
-            for( int i = 0; i < nMaxFeatureCount; i++ )
+            for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
             {
                 if( papoFeatures[i] == NULL )
                     continue;
@@ -604,13 +682,212 @@ OGRErr OGRMemLayer::CreateGeomField( OGRGeomFieldDefn *poGeomField,
 /*      Remap all the internal features.  Hopefully there aren't any    */
 /*      external features referring to our OGRFeatureDefn!              */
 /* -------------------------------------------------------------------- */
-    for( i = 0; i < nMaxFeatureCount; i++ )
+    for( GIntBig iFeature = 0; iFeature < nMaxFeatureCount; iFeature++ )
     {
-        if( papoFeatures[i] != NULL )
-            papoFeatures[i]->RemapGeomFields( NULL, panRemap );
+        if( papoFeatures[iFeature] != NULL )
+            papoFeatures[iFeature]->RemapGeomFields( NULL, panRemap );
     }
 
     CPLFree( panRemap );
 
     return OGRERR_NONE;
 }
+
+/************************************************************************/
+/*                         BuildSpatialIndex()                          */
+/*                                                                      */
+/*      Index the envelopes of the geometries of the field used by      */
+/*      the current spatial filter.                                     */
+/************************************************************************/
+
+void OGRMemLayer::BuildSpatialIndex()
+
+{
+    InvalidateSpatialIndex();
+
+    iSpatialIndexGeomField = m_iGeomFieldFilter;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the extent of the layer, that is the area covered by    */
+/*      the root node of the quad tree.                                 */
+/* -------------------------------------------------------------------- */
+    OGREnvelope sLayerEnvelope;
+    int         bHasGeometry = FALSE;
+
+    for( GIntBig i = 0; i < nMaxFeatureCount; i++ )
+    {
+        if( papoFeatures[i] == NULL )
+            continue;
+
+        OGRGeometry *poGeom =
+            papoFeatures[i]->GetGeomFieldRef(iSpatialIndexGeomField);
+        if( poGeom == NULL )
+            continue;
+
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope( &sEnvelope );
+        sLayerEnvelope.Merge( sEnvelope );
+        bHasGeometry = TRUE;
+    }
+
+    if( !bHasGeometry )
+        sLayerEnvelope.MinX = sLayerEnvelope.MinY =
+            sLayerEnvelope.MaxX = sLayerEnvelope.MaxY = 0;
+
+    sSpatialIndexBounds.minx = sLayerEnvelope.MinX;
+    sSpatialIndexBounds.miny = sLayerEnvelope.MinY;
+    sSpatialIndexBounds.maxx = sLayerEnvelope.MaxX;
+    sSpatialIndexBounds.maxy = sLayerEnvelope.MaxY;
+
+/* -------------------------------------------------------------------- */
+/*      Insert the features. The bounds are stored in the tree, so      */
+/*      that it can be searched without accessing the geometries.       */
+/* -------------------------------------------------------------------- */
+    hSpatialIndex = CPLQuadTreeCreate( &sSpatialIndexBounds, NULL );
+    CPLQuadTreeSetMaxDepth( hSpatialIndex,
+            CPLQuadTreeGetAdvisedMaxDepth( (int) MIN(nFeatureCount, INT_MAX) ) );
+    nSpatialIndexStaleEntries = 0;
+
+    for( GIntBig i = 0; i < nMaxFeatureCount && hSpatialIndex != NULL; i++ )
+    {
+        if( papoFeatures[i] != NULL )
+            AddToSpatialIndex( papoFeatures[i] );
+    }
+}
+
+/************************************************************************/
+/*                       InvalidateSpatialIndex()                       */
+/************************************************************************/
+
+void OGRMemLayer::InvalidateSpatialIndex()
+
+{
+    if( hSpatialIndex != NULL )
+    {
+        CPLQuadTreeDestroy( hSpatialIndex );
+        hSpatialIndex = NULL;
+    }
+    nSpatialIndexStaleEntries = 0;
+}
+
+/************************************************************************/
+/*                         AddToSpatialIndex()                          */
+/*                                                                      */
+/*      Keep the spatial index, if already built, up to date with a     */
+/*      new stored feature. The index is dropped, and will be rebuilt   */
+/*      on next spatial query, if the feature is out of its bounds,     */
+/*      or if too many of its entries refer to replaced or deleted      */
+/*      features.                                                       */
+/************************************************************************/
+
+void OGRMemLayer::AddToSpatialIndex( OGRFeature *poFeature )
+
+{
+    if( hSpatialIndex == NULL )
+        return;
+
+    if( nSpatialIndexStaleEntries > nFeatureCount + 1000 )
+    {
+        InvalidateSpatialIndex();
+        return;
+    }
+
+    OGRGeometry *poGeom = poFeature->GetGeomFieldRef(iSpatialIndexGeomField);
+    if( poGeom == NULL )
+        return;
+
+    OGREnvelope sEnvelope;
+    poGeom->getEnvelope( &sEnvelope );
+
+    if( sEnvelope.MinX < sSpatialIndexBounds.minx ||
+        sEnvelope.MinY < sSpatialIndexBounds.miny ||
+        sEnvelope.MaxX > sSpatialIndexBounds.maxx ||
+        sEnvelope.MaxY > sSpatialIndexBounds.maxy )
+    {
+        InvalidateSpatialIndex();
+        return;
+    }
+
+    CPLRectObj sBounds;
+    sBounds.minx = sEnvelope.MinX;
+    sBounds.miny = sEnvelope.MinY;
+    sBounds.maxx = sEnvelope.MaxX;
+    sBounds.maxy = sEnvelope.MaxY;
+
+    CPLQuadTreeInsertWithBounds( hSpatialIndex,
+                                 (void*)(size_t)poFeature->GetFID(),
+                                 &sBounds );
+}
+
+/************************************************************************/
+/*                          ScanSpatialIndex()                          */
+/*                                                                      */
+/*      Collect the FIDs of the features whose envelope intersects      */
+/*      the envelope of the spatial filter, in increasing order.        */
+/************************************************************************/
+
+void OGRMemLayer::ScanSpatialIndex()
+
+{
+    if( hSpatialIndex == NULL || iSpatialIndexGeomField != m_iGeomFieldFilter )
+        BuildSpatialIndex();
+
+    CPLRectObj sAoi;
+    sAoi.minx = m_sFilterEnvelope.MinX;
+    sAoi.miny = m_sFilterEnvelope.MinY;
+    sAoi.maxx = m_sFilterEnvelope.MaxX;
+    sAoi.maxy = m_sFilterEnvelope.MaxY;
+
+    int nCount = 0;
+    void **pahFIDs = CPLQuadTreeSearch( hSpatialIndex, &sAoi, &nCount );
+
+    CPLFree( panMatchingFIDs );
+    panMatchingFIDs = (GIntBig *) CPLMalloc( sizeof(GIntBig) * (nCount + 1) );
+    for( int i = 0; i < nCount; i++ )
+        panMatchingFIDs[i] = (GIntBig)(size_t)pahFIDs[i];
+    CPLFree( pahFIDs );
+
+    /* A replaced feature can have several entries */
+    std::sort( panMatchingFIDs, panMatchingFIDs + nCount );
+    nMatchingFIDs = (int)( std::unique( panMatchingFIDs,
+                                        panMatchingFIDs + nCount )
+                           - panMatchingFIDs );
+    iMatchingFID = 0;
+}
+
+/************************************************************************/
+/*                      GetNextCandidateFeature()                       */
+/*                                                                      */
+/*      Return the next stored feature (not a copy) that may match the  */
+/*      spatial filter, using the spatial index if there is a filter.   */
+/************************************************************************/
+
+OGRFeature *OGRMemLayer::GetNextCandidateFeature()
+
+{
+    if( m_poFilterGeom != NULL && panMatchingFIDs == NULL && iNextReadFID == 0 )
+        ScanSpatialIndex();
+
+    if( panMatchingFIDs != NULL )
+    {
+        while( iMatchingFID < nMatchingFIDs )
+        {
+            GIntBig nFID = panMatchingFIDs[iMatchingFID++];
+
+            if( nFID < nMaxFeatureCount && papoFeatures[nFID] != NULL )
+                return papoFeatures[nFID];
+        }
+
+        return NULL;
+    }
+
+    while( iNextReadFID < nMaxFeatureCount )
+    {
+        OGRFeature *poFeature = papoFeatures[iNextReadFID++];
+
+        if( poFeature != NULL )
+            return poFeature;
+    }
+
+    return NULL;
+}
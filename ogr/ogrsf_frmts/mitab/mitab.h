@@ -195,9 +195,9 @@ class IMapInfoFile : public OGRLayer
     ///////////////
     //  OGR methods for read support
     virtual void        ResetReading() = 0;
-    virtual int         GetFeatureCount (int bForce) = 0;
+    virtual GIntBig     GetFeatureCount (int bForce) = 0;
     virtual OGRFeature *GetNextFeature();
-    virtual OGRFeature *GetFeature(long nFeatureId);
+    virtual OGRFeature *GetFeature(GIntBig nFeatureId);
     virtual OGRErr      CreateFeature(OGRFeature *poFeature);
     virtual int         TestCapability( const char * pszCap ) =0;
     virtual int         GetExtent(OGREnvelope *psExtent, int bForce) =0;
@@ -284,7 +284,7 @@ class TABFile: public IMapInfoFile
 
     int         m_nLastFeatureId;
 
-    long        *m_panMatchingFIDs;
+    GIntBig     *m_panMatchingFIDs;
     int         m_iMatchingFID;
 
     ///////////////
@@ -315,7 +315,7 @@ class TABFile: public IMapInfoFile
 
     virtual void        ResetReading();
     virtual int         TestCapability( const char * pszCap );
-    virtual int         GetFeatureCount (int bForce);
+    virtual GIntBig     GetFeatureCount (int bForce);
     virtual int         GetExtent(OGREnvelope *psExtent, int bForce);
 
     /* Implement OGRLayer's SetFeature() for random write, only with TABFile */
@@ -448,7 +448,7 @@ class TABView: public IMapInfoFile
 
     virtual void        ResetReading();
     virtual int         TestCapability( const char * pszCap );
-    virtual int         GetFeatureCount (int bForce);
+    virtual GIntBig     GetFeatureCount (int bForce);
     virtual int         GetExtent(OGREnvelope *psExtent, int bForce);
     
     ///////////////
@@ -563,7 +563,7 @@ class TABSeamless: public IMapInfoFile
 
     virtual void        ResetReading();
     virtual int         TestCapability( const char * pszCap );
-    virtual int         GetFeatureCount (int bForce);
+    virtual GIntBig     GetFeatureCount (int bForce);
     virtual int         GetExtent(OGREnvelope *psExtent, int bForce);
     
     ///////////////
@@ -710,7 +710,7 @@ class MIFFile: public IMapInfoFile
                            {return m_poDefn?m_poDefn->GetName():"";};
 
     virtual int         TestCapability( const char * pszCap ) ;
-    virtual int         GetFeatureCount (int bForce);
+    virtual GIntBig     GetFeatureCount (int bForce);
     virtual void        ResetReading();
     virtual int         GetExtent(OGREnvelope *psExtent, int bForce);
 
@@ -153,7 +153,7 @@ TABFile::~TABFile()
 /************************************************************************/
 /*                          GetFeatureCount()                           */
 /************************************************************************/
-int TABFile::GetFeatureCount (int bForce)
+GIntBig TABFile::GetFeatureCount (int bForce)
 {
     
     if( m_poFilterGeom != NULL || m_poAttrQuery != NULL || bForce)
@@ -1229,7 +1229,7 @@ int TABFile::GetNextFeatureId(int nPrevId)
             if( m_panMatchingFIDs[m_iMatchingFID] == OGRNullFID )
                 return OGRNullFID;
 
-            return m_panMatchingFIDs[m_iMatchingFID++] + 1;
+            return (int) m_panMatchingFIDs[m_iMatchingFID++] + 1;
         }
     }
 
@@ -811,7 +811,7 @@ int TABSeamless::GetFeatureCountByType(int &numPoints, int &numLines,
     return -1;
 }
 
-int TABSeamless::GetFeatureCount(int bForce)
+GIntBig TABSeamless::GetFeatureCount(int bForce)
 {
     /*-----------------------------------------------------------------
      * __TODO__  This should be implemented to return -1 if force=false,
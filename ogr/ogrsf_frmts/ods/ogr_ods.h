@@ -67,9 +67,11 @@ class OGRODSLayer : public OGRMemLayer
 
     /* For external usage. Mess with FID */
     virtual OGRFeature *        GetNextFeature();
-    virtual OGRFeature         *GetFeature( long nFeatureId );
+    virtual int                 GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+    { return OGRLayer::GetNextFeatureBatch(poBatch); }
+    virtual OGRFeature         *GetFeature( GIntBig nFeatureId );
     virtual OGRErr              SetFeature( OGRFeature *poFeature );
-    virtual OGRErr              DeleteFeature( long nFID );
+    virtual OGRErr              DeleteFeature( GIntBig nFID );
 
     /* For internal usage, for cell resolver */
     OGRFeature *        GetNextFeatureWithoutFIDHack() { return OGRMemLayer::GetNextFeature(); }
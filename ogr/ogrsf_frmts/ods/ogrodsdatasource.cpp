@@ -113,7 +113,7 @@ OGRFeature* OGRODSLayer::GetNextFeature()
 /*                           GetFeature()                               */
 /************************************************************************/
 
-OGRFeature* OGRODSLayer::GetFeature( long nFeatureId )
+OGRFeature* OGRODSLayer::GetFeature( GIntBig nFeatureId )
 {
     OGRFeature* poFeature = OGRMemLayer::GetFeature(nFeatureId - (1 + bHasHeaderLine));
     if (poFeature)
@@ -143,7 +143,7 @@ OGRErr OGRODSLayer::SetFeature( OGRFeature *poFeature )
 /*                          DeleteFeature()                             */
 /************************************************************************/
 
-OGRErr OGRODSLayer::DeleteFeature( long nFID )
+OGRErr OGRODSLayer::DeleteFeature( GIntBig nFID )
 {
     SetUpdated();
     return OGRMemLayer::DeleteFeature(nFID - (1 + bHasHeaderLine));
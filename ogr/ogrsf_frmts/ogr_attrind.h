@@ -46,14 +46,26 @@ protected:
 public:
     virtual     ~OGRAttrIndex();
 
-    virtual long   GetFirstMatch( OGRField *psKey ) = 0;
-    virtual long  *GetAllMatches( OGRField *psKey ) = 0;
-    virtual long  *GetAllMatches( OGRField *psKey, long* panFIDList, int* nFIDCount, int* nLength ) = 0;
+    virtual GIntBig   GetFirstMatch( OGRField *psKey ) = 0;
+    virtual GIntBig  *GetAllMatches( OGRField *psKey ) = 0;
+    virtual GIntBig  *GetAllMatches( OGRField *psKey, GIntBig* panFIDList, int* nFIDCount, int* nLength ) = 0;
     
-    virtual OGRErr AddEntry( OGRField *psKey, long nFID ) = 0;
-    virtual OGRErr RemoveEntry( OGRField *psKey, long nFID ) = 0;
+    virtual OGRErr AddEntry( OGRField *psKey, GIntBig nFID ) = 0;
+    virtual OGRErr RemoveEntry( OGRField *psKey, GIntBig nFID ) = 0;
 
     virtual OGRErr Clear() = 0;
+
+    /* Range queries, only available if SupportsRangeQueries() returns */
+    /* TRUE. Numeric bounds are passed in the Real member of OGRField, */
+    /* even for integer fields. A NULL bound means no bound. Strings are */
+    /* compared case insensitively, as in OGR SQL. The returned lists */
+    /* are sorted and terminated by OGRNullFID. */
+    virtual int       SupportsRangeQueries();
+    virtual GIntBig  *GetRangeMatches( OGRField *psMin, int bMinIncluded,
+                                       OGRField *psMax, int bMaxIncluded,
+                                       int *pnFIDCount );
+    virtual GIntBig  *GetPrefixMatches( const char *pszPrefix,
+                                        int *pnFIDCount );
 };
 
 /************************************************************************/
@@ -87,6 +99,11 @@ public:
 };
 
 OGRLayerAttrIndex CPL_DLL *OGRCreateDefaultLayerIndex();
+OGRLayerAttrIndex CPL_DLL *OGRCreateBTreeLayerIndex();
+
+OGRErr CPL_DLL OGRInitializeSidecarIndexSupport( GDALDataset *poDS,
+                                                 OGRLayer *poLayer,
+                                                 int bCreate );
 
 
 #endif /* ndef _OGR_ATTRIND_H_INCLUDED */
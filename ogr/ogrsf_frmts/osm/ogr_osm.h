@@ -67,7 +67,7 @@ class OGROSMLayer : public OGRLayer
     int                  nIdxLayer;
     OGRFeatureDefn      *poFeatureDefn;
     OGRSpatialReference *poSRS;
-    long                 nFeatureCount;
+    GIntBig              nFeatureCount;
 
     std::vector<char*>   apszNames;
     std::map<const char*, int, ConstCharComp> oMapFieldNameToIndex;
@@ -126,7 +126,7 @@ class OGROSMLayer : public OGRLayer
     virtual int         TestCapability( const char * );
                                      
     virtual OGRFeature *GetNextFeature();
-    virtual int         GetFeatureCount( int bForce );
+    virtual GIntBig     GetFeatureCount( int bForce );
         
     virtual OGRErr      SetAttributeFilter( const char* pszAttrQuery );
 
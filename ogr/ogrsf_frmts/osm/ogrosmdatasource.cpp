@@ -3822,7 +3822,7 @@ class OGROSMSingleFeatureLayer : public OGRLayer
     int                 nVal;
     char               *pszVal;
     OGRFeatureDefn     *poFeatureDefn;
-    int                 iNextShapeId;
+    GIntBig             iNextShapeId;
 
   public:
                         OGROSMSingleFeatureLayer( const char* pszLayerName,
@@ -3917,7 +3917,7 @@ class OGROSMResultLayerDecorator : public OGRLayerDecorator
                                         osDSName(osDSName),
                                         osInterestLayers(osInterestLayers) {}
 
-        virtual int         GetFeatureCount( int bForce = TRUE )
+        virtual GIntBig     GetFeatureCount( int bForce = TRUE )
         {
             /* When we run GetFeatureCount() with SQLite SQL dialect, */
             /* the OSM dataset will be re-opened. Make sure that it is */
@@ -187,7 +187,7 @@ OGRErr OGROSMLayer::SetAttributeFilter( const char* pszAttrQuery )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGROSMLayer::GetFeatureCount( int bForce )
+GIntBig OGROSMLayer::GetFeatureCount( int bForce )
 {
     if( poDS->IsFeatureCountEnabled() )
         return OGRLayer::GetFeatureCount(bForce);
@@ -539,8 +539,7 @@ void OGROSMLayer::SetFieldsFromTags(OGRFeature* poFeature,
 {
     if( !bIsWayID )
     {
-        if( (long)nID == nID )
-            poFeature->SetFID( (long)nID ); /* Will not work with 32bit GDAL if id doesn't fit into 32 bits */
+        poFeature->SetFID( nID );
 
         if( bHasOSMId )
         {
@@ -551,8 +550,7 @@ void OGROSMLayer::SetFieldsFromTags(OGRFeature* poFeature,
     }
     else
     {
-        if( (long)nID == nID )
-            poFeature->SetFID( (long)nID ); /* Will not work with 32bit GDAL if id doesn't fit into 32 bits */
+        poFeature->SetFID( nID );
 
         if( nIndexOSMWayId >= 0 )
         {
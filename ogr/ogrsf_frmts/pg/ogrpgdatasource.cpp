@@ -2302,7 +2302,7 @@ OGRFeature *OGRPGNoResetResultLayer::GetNextFeature()
     {
         return NULL;
     }
-    return RecordToFeature(iNextShapeId ++);
+    return RecordToFeature((int) iNextShapeId ++);
 }
 
 /************************************************************************/
@@ -600,6 +600,14 @@ OGRFeature *OGRPGLayer::RecordToFeature( int iRecord )
                     CPL_MSBPTR32(&nVal);
                     poFeature->SetFID( nVal );
                 }
+                else if ( nTypeOID == INT8OID)
+                {
+                    GIntBig nVal;
+                    CPLAssert(PQgetlength(hCursorResult, iRecord, iField) == sizeof(GIntBig));
+                    memcpy( &nVal, PQgetvalue( hCursorResult, iRecord, iField ), sizeof(GIntBig) );
+                    CPL_MSBPTR64(&nVal);
+                    poFeature->SetFID( nVal );
+                }
                 else
                 {
                     CPLDebug("PG", "FID. Unhandled OID %d.", nTypeOID );
@@ -612,7 +620,7 @@ OGRFeature *OGRPGLayer::RecordToFeature( int iRecord )
                 char* pabyData = PQgetvalue(hCursorResult,iRecord,iField);
                 /* ogr_pg_20 may crash if PostGIS is unavailable and we don't test pabyData */
                 if (pabyData)
-                    poFeature->SetFID( atoi(pabyData) );
+                    poFeature->SetFID( CPLAtoGIntBig(pabyData) );
                 else
                     continue;
             }
@@ -641,15 +649,9 @@ OGRFeature *OGRPGLayer::RecordToFeature( int iRecord )
                 if (nLength == 0)
                     continue;
 
+                /* The geometry will be built when requested */
                 nLength = CPLBase64DecodeInPlace(pabyData);
-                OGRGeometry * poGeom = NULL;
-                OGRGeometryFactory::createFromWkb( pabyData, NULL, &poGeom, nLength );
-
-                if( poGeom != NULL )
-                {
-                    poGeom->assignSpatialReference( poGeomFieldDefn->GetSpatialRef() );
-                    poFeature->SetGeomFieldDirectly(iOGRGeomField,  poGeom );
-                }
+                poFeature->SetGeomFieldWKB( iOGRGeomField, pabyData, nLength );
 
                 continue;
             }
@@ -676,7 +678,11 @@ OGRFeature *OGRPGLayer::RecordToFeature( int iRecord )
                     poGeom = BYTEAToGeometry(pszVal);
                 }
                 else
-                    OGRGeometryFactory::createFromWkb( pabyVal, NULL, &poGeom, nLength );
+                {
+                    /* Raw WKB: the geometry will be built when requested */
+                    poFeature->SetGeomFieldWKB( iOGRGeomField, pabyVal, nLength );
+                    continue;
+                }
                 
                 if( poGeom != NULL )
                 {
@@ -1450,7 +1456,7 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
 /*                           SetNextByIndex()                           */
 /************************************************************************/
 
-OGRErr OGRPGLayer::SetNextByIndex( long nIndex )
+OGRErr OGRPGLayer::SetNextByIndex( GIntBig nIndex )
 
 {
     GetLayerDefn();
@@ -1485,14 +1491,14 @@ OGRErr OGRPGLayer::SetNextByIndex( long nIndex )
     
     OGRPGClearResult( hCursorResult );
     
-    osCommand.Printf( "FETCH ABSOLUTE %ld in %s", nIndex+1, pszCursorName );
+    osCommand.Printf( "FETCH ABSOLUTE " CPL_FRMT_GIB " in %s", nIndex+1, pszCursorName );
     hCursorResult = OGRPG_PQexec(hPGConn, osCommand );
 
     if (PQresultStatus(hCursorResult) != PGRES_TUPLES_OK ||
         PQntuples(hCursorResult) != 1)
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "Attempt to read feature at invalid index (%ld).", nIndex );
+                  "Attempt to read feature at invalid index (" CPL_FRMT_GIB ").", nIndex );
 
         CloseCursor();
 
@@ -149,7 +149,7 @@ void OGRPGResultLayer::ResetReading()
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRPGResultLayer::GetFeatureCount( int bForce )
+GIntBig OGRPGResultLayer::GetFeatureCount( int bForce )
 
 {
     if( TestCapability(OLCFastFeatureCount) == FALSE )
@@ -158,7 +158,7 @@ int OGRPGResultLayer::GetFeatureCount( int bForce )
     PGconn              *hPGConn = poDS->GetPGConn();
     PGresult            *hResult = NULL;
     CPLString           osCommand;
-    int                 nCount = 0;
+    GIntBig             nCount = 0;
 
     osCommand.Printf(
         "SELECT count(*) FROM (%s) AS ogrpgcount",
@@ -166,7 +166,7 @@ int OGRPGResultLayer::GetFeatureCount( int bForce )
 
     hResult = OGRPG_PQexec(hPGConn, osCommand);
     if( hResult != NULL && PQresultStatus(hResult) == PGRES_TUPLES_OK )
-        nCount = atoi(PQgetvalue(hResult,0,0));
+        nCount = CPLAtoGIntBig(PQgetvalue(hResult,0,0));
     else
         CPLDebug( "PG", "%s; failed.", osCommand.c_str() );
     OGRPGClearResult( hResult );
@@ -247,7 +247,7 @@ OGRFeature *OGRPGResultLayer::GetNextFeature()
             || poGeomFieldDefn == NULL
             || poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY
             || poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY
-            || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
+            || FilterGeometry( poFeature, m_iGeomFieldFilter ) )
             && (m_poAttrQuery == NULL
                 || m_poAttrQuery->Evaluate( poFeature )) )
             return poFeature;
@@ -880,7 +880,7 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
             || poGeomFieldDefn == NULL
             || poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOMETRY
             || poGeomFieldDefn->ePostgisType == GEOM_TYPE_GEOGRAPHY
-            || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) )  )
+            || FilterGeometry( poFeature, m_iGeomFieldFilter )  )
             return poFeature;
 
         delete poFeature;
@@ -1053,7 +1053,7 @@ OGRErr OGRPGTableLayer::SetAttributeFilter( const char *pszQuery )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRPGTableLayer::DeleteFeature( long nFID )
+OGRErr OGRPGTableLayer::DeleteFeature( GIntBig nFID )
 
 {
     PGconn      *hPGConn = poDS->GetPGConn();
@@ -1080,7 +1080,7 @@ OGRErr OGRPGTableLayer::DeleteFeature( long nFID )
     if( pszFIDColumn == NULL )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "DeleteFeature(%ld) failed.  Unable to delete features in tables without\n"
+                  "DeleteFeature(" CPL_FRMT_GIB ") failed.  Unable to delete features in tables without\n"
                   "a recognised FID column.",
                   nFID );
         return OGRERR_FAILURE;
@@ -1090,7 +1090,7 @@ OGRErr OGRPGTableLayer::DeleteFeature( long nFID )
 /* -------------------------------------------------------------------- */
 /*      Form the statement to drop the record.                          */
 /* -------------------------------------------------------------------- */
-    osCommand.Printf( "DELETE FROM %s WHERE %s = %ld",
+    osCommand.Printf( "DELETE FROM %s WHERE %s = " CPL_FRMT_GIB,
                       pszSqlTableName, OGRPGEscapeColumnName(pszFIDColumn).c_str(), nFID );
 
 /* -------------------------------------------------------------------- */
@@ -1461,7 +1461,7 @@ OGRErr OGRPGTableLayer::SetFeature( OGRFeature *poFeature )
     /* Add the WHERE clause */
     osCommand += " WHERE ";
     osCommand = osCommand + OGRPGEscapeColumnName(pszFIDColumn) + " = ";
-    osCommand += CPLString().Printf( "%ld ", poFeature->GetFID() );
+    osCommand += CPLString().Printf( CPL_FRMT_GIB " ", poFeature->GetFID() );
 
 /* -------------------------------------------------------------------- */
 /*      Execute the update.                                             */
@@ -1470,7 +1470,7 @@ OGRErr OGRPGTableLayer::SetFeature( OGRFeature *poFeature )
     if( PQresultStatus(hResult) != PGRES_COMMAND_OK )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "UPDATE command for feature %ld failed.\n%s\nCommand: %s",
+                  "UPDATE command for feature " CPL_FRMT_GIB " failed.\n%s\nCommand: %s",
                   poFeature->GetFID(), PQerrorMessage(hPGConn), osCommand.c_str() );
 
         OGRPGClearResult( hResult );
@@ -1857,7 +1857,7 @@ OGRErr OGRPGTableLayer::CreateFeatureViaInsert( OGRFeature *poFeature )
     {
         if( bNeedComma )
             osCommand += ", ";
-        osCommand += CPLString().Printf( "%ld ", poFeature->GetFID() );
+        osCommand += CPLString().Printf( CPL_FRMT_GIB " ", poFeature->GetFID() );
         bNeedComma = TRUE;
     }
 
@@ -1901,8 +1901,7 @@ OGRErr OGRPGTableLayer::CreateFeatureViaInsert( OGRFeature *poFeature )
         PQntuples(hResult) == 1 && PQnfields(hResult) == 1 )
     {
         const char* pszFID = PQgetvalue(hResult, 0, 0 );
-        long nFID = atol(pszFID);
-        poFeature->SetFID(nFID);
+        poFeature->SetFID(CPLAtoGIntBig(pszFID));
     }
     else if( bReturnRequested || PQresultStatus(hResult) != PGRES_COMMAND_OK )
     {
@@ -1990,7 +1989,7 @@ OGRErr OGRPGTableLayer::CreateFeatureViaCopy( OGRFeature *poFeature )
         /* Set the FID */
         if( poFeature->GetFID() != OGRNullFID )
         {
-            osCommand += CPLString().Printf("%ld ", poFeature->GetFID());
+            osCommand += CPLString().Printf(CPL_FRMT_GIB " ", poFeature->GetFID());
         }
         else
         {
@@ -2759,7 +2758,7 @@ OGRErr OGRPGTableLayer::AlterFieldDefn( int iField, OGRFieldDefn* poNewFieldDefn
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRPGTableLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRPGTableLayer::GetFeature( GIntBig nFeatureId )
 
 {
     GetLayerDefn()->GetFieldCount();
@@ -2786,7 +2785,7 @@ OGRFeature *OGRPGTableLayer::GetFeature( long nFeatureId )
 
     osCommand.Printf(
              "DECLARE getfeaturecursor %s for "
-             "SELECT %s FROM %s WHERE %s = %ld",
+             "SELECT %s FROM %s WHERE %s = " CPL_FRMT_GIB,
               ( poDS->bUseBinaryCursor ) ? "BINARY CURSOR" : "CURSOR",
              osFieldList.c_str(), pszSqlTableName, OGRPGEscapeColumnName(pszFIDColumn).c_str(),
              nFeatureId );
@@ -2812,14 +2811,14 @@ OGRFeature *OGRPGTableLayer::GetFeature( long nFeatureId )
                 if (nRows > 1)
                 {
                     CPLError(CE_Warning, CPLE_AppDefined,
-                             "%d rows in response to the WHERE %s = %ld clause !",
+                             "%d rows in response to the WHERE %s = " CPL_FRMT_GIB " clause !",
                              nRows, pszFIDColumn, nFeatureId );
                 }
             }
             else
             {
                  CPLError( CE_Failure, CPLE_AppDefined,
-                  "Attempt to read feature with unknown feature id (%ld).", nFeatureId );
+                  "Attempt to read feature with unknown feature id (" CPL_FRMT_GIB ").", nFeatureId );
             }
         }
     }
@@ -2846,7 +2845,7 @@ OGRFeature *OGRPGTableLayer::GetFeature( long nFeatureId )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRPGTableLayer::GetFeatureCount( int bForce )
+GIntBig OGRPGTableLayer::GetFeatureCount( int bForce )
 
 {
     if( bCopyActive ) EndCopy();
@@ -2863,7 +2862,7 @@ int OGRPGTableLayer::GetFeatureCount( int bForce )
     PGconn              *hPGConn = poDS->GetPGConn();
     PGresult            *hResult = NULL;
     CPLString           osCommand;
-    int                 nCount = 0;
+    GIntBig             nCount = 0;
 
     osCommand.Printf(
         "SELECT count(*) FROM %s %s",
@@ -2871,7 +2870,7 @@ int OGRPGTableLayer::GetFeatureCount( int bForce )
 
     hResult = OGRPG_PQexec(hPGConn, osCommand);
     if( hResult != NULL && PQresultStatus(hResult) == PGRES_TUPLES_OK )
-        nCount = atoi(PQgetvalue(hResult,0,0));
+        nCount = CPLAtoGIntBig(PQgetvalue(hResult,0,0));
     else
         CPLDebug( "PG", "%s; failed.", osCommand.c_str() );
     OGRPGClearResult( hResult );
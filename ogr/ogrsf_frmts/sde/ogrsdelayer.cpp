@@ -865,7 +865,7 @@ OGRErr OGRSDELayer::TranslateOGRRecord( OGRFeature *poFeature,
         }
         
         // Build WHERE clause
-        pszWhere = CPLSPrintf( "%s = %ld", osFIDColumnName.c_str(),
+        pszWhere = CPLSPrintf( "%s = " CPL_FRMT_GIB, osFIDColumnName.c_str(),
                                            poFeature->GetFID() );
         
         nSDEErr = SE_stream_update_table( hStream, poFeatureDefn->GetName(),
@@ -2064,7 +2064,7 @@ OGRFeature *OGRSDELayer::GetNextFeature()
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRSDELayer::GetFeature( long nFeatureId )
+OGRFeature *OGRSDELayer::GetFeature( GIntBig nFeatureId )
 
 {
     int nSDEErr;
@@ -2187,7 +2187,7 @@ OGRErr OGRSDELayer::ResetStream()
 /*      operator in the database.                                       */
 /************************************************************************/
 
-int OGRSDELayer::GetFeatureCount( int bForce )
+GIntBig OGRSDELayer::GetFeatureCount( int bForce )
 
 {
 /* -------------------------------------------------------------------- */
@@ -2504,7 +2504,7 @@ OGRErr OGRSDELayer::CreateFeature( OGRFeature *poFeature )
 /************************************************************************/
 /*                           DeleteFeature()                            */
 /************************************************************************/
-OGRErr OGRSDELayer::DeleteFeature( long nFID )
+OGRErr OGRSDELayer::DeleteFeature( GIntBig nFID )
 
 {
     LONG                nSDEErr;
@@ -2521,7 +2521,7 @@ OGRErr OGRSDELayer::DeleteFeature( long nFID )
     if( iFIDColumn == -1 )
     {
         CPLError( CE_Failure, CPLE_AppDefined, 
-                  "Layer \"%s\": cannot DeleteFeature(%ld): the layer has no "
+                  "Layer \"%s\": cannot DeleteFeature(" CPL_FRMT_GIB "): the layer has no "
                   "FID column detected.", poFeatureDefn->GetName(), nFID );
         return OGRERR_FAILURE;
     }
@@ -2529,7 +2529,7 @@ OGRErr OGRSDELayer::DeleteFeature( long nFID )
 /* -------------------------------------------------------------------- */
 /*      Perform the deletion                                            */
 /* -------------------------------------------------------------------- */
-    pszWhere = CPLSPrintf( "%s = %ld", osFIDColumnName.c_str(), nFID );
+    pszWhere = CPLSPrintf( "%s = " CPL_FRMT_GIB, osFIDColumnName.c_str(), nFID );
     
     nSDEErr = SE_stream_delete_from_table( hStream, poFeatureDefn->GetName(),
                                            pszWhere );
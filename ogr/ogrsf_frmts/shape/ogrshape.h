@@ -51,6 +51,9 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape, 
                                SHPObject *psShape, const char *pszSHPEncoding );
 OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape );
+void SHPReadOGRFieldsIntoBatch( DBFHandle hDBF, OGRFeatureDefn * poDefn,
+                                int iShape, const char *pszSHPEncoding,
+                                OGRFeatureBatch *poBatch );
 OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
                                        SHPHandle hSHP, DBFHandle hDBF,
                                        const char *pszSHPEncoding );
@@ -112,7 +115,7 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
 
     int                 ScanIndices();
 
-    long               *panMatchingFIDs;
+    GIntBig            *panMatchingFIDs;
     int                 iMatchingFID;
     void                ClearMatchingFIDs();
 
@@ -181,17 +184,18 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
-    virtual OGRErr      SetNextByIndex( long nIndex );
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch );
+    virtual OGRErr      SetNextByIndex( GIntBig nIndex );
 
-    OGRFeature         *GetFeature( long nFeatureId );
+    OGRFeature         *GetFeature( GIntBig nFeatureId );
     OGRErr              SetFeature( OGRFeature *poFeature );
-    OGRErr              DeleteFeature( long nFID );
+    OGRErr              DeleteFeature( GIntBig nFID );
     OGRErr              CreateFeature( OGRFeature *poFeature );
     OGRErr              SyncToDisk();
     
     OGRFeatureDefn *    GetLayerDefn() { return poFeatureDefn; }
 
-    int                 GetFeatureCount( int );
+    GIntBig             GetFeatureCount( int );
     OGRErr              GetExtent(OGREnvelope *psExtent, int bForce);
 
     virtual OGRErr      CreateField( OGRFieldDefn *poField,
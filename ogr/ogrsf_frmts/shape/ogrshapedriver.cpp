@@ -174,7 +174,7 @@ static CPLErr OGRShapeDriverDelete( const char *pszDataSource )
     VSIStatBufL sStatBuf;
     static const char *apszExtensions[] = 
         { "shp", "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind", 
-          "qix", "cpg", NULL };
+          "oim", "oix", "qix", "cpg", NULL };
 
     if( VSIStatL( pszDataSource, &sStatBuf ) != 0 )
     {
@@ -197,6 +197,32 @@ static CPLErr OGRShapeDriverDelete( const char *pszDataSource )
             if( VSIStatL( pszFile, &sStatBuf ) == 0 )
                 VSIUnlink( pszFile );
         }
+
+/* -------------------------------------------------------------------- */
+/*      Remove the generic attribute indexes, named <basename>_<n>.oix  */
+/* -------------------------------------------------------------------- */
+        CPLString osPath = CPLGetPath( pszDataSource );
+        CPLString osPrefix = CPLGetBasename( pszDataSource );
+        osPrefix += "_";
+
+        char **papszDirEntries = CPLReadDir( osPath );
+
+        for( int iFile = 0; 
+             papszDirEntries != NULL && papszDirEntries[iFile] != NULL;
+             iFile++ )
+        {
+            const char *pszEntry = papszDirEntries[iFile];
+
+            if( EQUAL(CPLGetExtension(pszEntry), "oix")
+                && strncmp(pszEntry, osPrefix, osPrefix.size()) == 0
+                && CPLGetValueType(CPLGetBasename(pszEntry) + osPrefix.size())
+                                                    == CPL_VALUE_INTEGER )
+            {
+                VSIUnlink( CPLFormFilename( osPath, pszEntry, NULL ) );
+            }
+        }
+
+        CSLDestroy( papszDirEntries );
     }
     else if( VSI_ISDIR(sStatBuf.st_mode) )
     {
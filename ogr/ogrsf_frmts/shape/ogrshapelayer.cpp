@@ -461,10 +461,10 @@ int OGRShapeLayer::ScanIndices()
         {
             int i;
 
-            panMatchingFIDs = (long *)
-                CPLMalloc(sizeof(long) * (nSpatialFIDCount+1) );
+            panMatchingFIDs = (GIntBig *)
+                CPLMalloc(sizeof(GIntBig) * (nSpatialFIDCount+1) );
             for( i = 0; i < nSpatialFIDCount; i++ )
-                panMatchingFIDs[i] = (long) panSpatialFIDs[i];
+                panMatchingFIDs[i] = (GIntBig) panSpatialFIDs[i];
             panMatchingFIDs[nSpatialFIDCount] = OGRNullFID;
         }
 
@@ -598,7 +598,7 @@ OGRErr OGRShapeLayer::SetAttributeFilter( const char * pszAttributeFilter )
 /*      ourselves in it.                                                */
 /************************************************************************/
 
-OGRErr OGRShapeLayer::SetNextByIndex( long nIndex )
+OGRErr OGRShapeLayer::SetNextByIndex( GIntBig nIndex )
 
 {
     if (!TouchLayer())
@@ -714,7 +714,7 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
             
             // Check the shape object's geometry, and if it matches
             // any spatial filter, return it.  
-            poFeature = FetchShape(panMatchingFIDs[iMatchingFID] /*, &oShapeExtent*/);
+            poFeature = FetchShape((int) panMatchingFIDs[iMatchingFID] /*, &oShapeExtent*/);
             
             iMatchingFID++;
 
@@ -762,19 +762,151 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/*                                                                      */
+/*      Same logic as GetNextFeature(), but the attributes are read     */
+/*      directly into the batch, without instanciating features.        */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    if (!TouchLayer())
+        return 0;
+
+/* -------------------------------------------------------------------- */
+/*      Features must be instanciated to be evaluated against an        */
+/*      attribute filter.                                               */
+/* -------------------------------------------------------------------- */
+    if( m_poAttrQuery != NULL
+        || (m_poFilterGeom != NULL && poFeatureDefn->IsGeometryIgnored())
+        || poBatch->GetDefnRef() != poFeatureDefn )
+    {
+        return OGRLayer::GetNextFeatureBatch( poBatch );
+    }
+
+    if( m_poFilterGeom != NULL && iNextShapeId == 0 && panMatchingFIDs == NULL )
+    {
+        ScanIndices();
+    }
+
+    poBatch->Reset();
+
+    while( !poBatch->IsFull() )
+    {
+        int iShape;
+
+        if( panMatchingFIDs != NULL )
+        {
+            if( panMatchingFIDs[iMatchingFID] == OGRNullFID )
+                break;
+
+            iShape = (int) panMatchingFIDs[iMatchingFID];
+            iMatchingFID++;
+
+            if( hDBF && DBFIsRecordDeleted( hDBF, iShape ) )
+                continue;
+        }
+        else
+        {
+            if( iNextShapeId >= nTotalShapeCount )
+                break;
+
+            if( hDBF )
+            {
+                if (DBFIsRecordDeleted( hDBF, iNextShapeId ))
+                {
+                    iNextShapeId++;
+                    continue;
+                }
+                else if( VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)) )
+                    break; /* There's an I/O error */
+            }
+
+            iShape = iNextShapeId;
+            iNextShapeId++;
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Read the geometry, and check it against the spatial filter,     */
+/*      using the shape bounds first as in FetchShape().                */
+/* -------------------------------------------------------------------- */
+        OGRGeometry *poGeom = NULL;
+
+        if( hSHP != NULL && !poFeatureDefn->IsGeometryIgnored() )
+        {
+            SHPObject *psShape = NULL;
+
+            if( m_poFilterGeom != NULL )
+            {
+                psShape = SHPReadObject( hSHP, iShape );
+
+                if( psShape != NULL
+                    && (psShape->nSHPType == SHPT_POINT
+                        || psShape->nSHPType == SHPT_POINTZ
+                        || psShape->nSHPType == SHPT_POINTM
+                        || (psShape->dfXMin != psShape->dfXMax
+                            && psShape->dfYMin != psShape->dfYMax))
+                    && psShape->nSHPType != SHPT_NULL
+                    && (m_sFilterEnvelope.MaxX < psShape->dfXMin 
+                        || m_sFilterEnvelope.MaxY < psShape->dfYMin
+                        || psShape->dfXMax  < m_sFilterEnvelope.MinX
+                        || psShape->dfYMax < m_sFilterEnvelope.MinY) )
+                {
+                    SHPDestroyObject( psShape );
+                    continue;
+                }
+            }
+
+            poGeom = SHPReadOGRObject( hSHP, iShape, psShape );
+        }
+
+        m_nFeaturesRead++;
+
+        if( m_poFilterGeom != NULL && !FilterGeometry( poGeom ) )
+        {
+            delete poGeom;
+            continue;
+        }
+
+        poBatch->BeginFeature( iShape );
+        if( poGeom != NULL )
+        {
+            poBatch->SetGeomField( 0, poGeom );
+            delete poGeom;
+        }
+
+        if( hDBF != NULL )
+            SHPReadOGRFieldsIntoBatch( hDBF, poFeatureDefn, iShape, osEncoding,
+                                       poBatch );
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRShapeLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRShapeLayer::GetFeature( GIntBig nFeatureId )
 
 {
     if (!TouchLayer())
         return NULL;
 
+    /* Shapefile record numbers are 32 bit */
+    if( nFeatureId < 0 || nFeatureId > INT_MAX )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined, 
+                  "Attempt to read shape with feature id (" CPL_FRMT_GIB ") out of available"
+                  " range.", nFeatureId );
+        return NULL;
+    }
+
     OGRFeature *poFeature = NULL;
-    poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn, nFeatureId, NULL,
-                                   osEncoding );
+    poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn, (int) nFeatureId,
+                                   NULL, osEncoding );
 
     if( poFeature != NULL )
     {
@@ -812,13 +944,13 @@ OGRErr OGRShapeLayer::SetFeature( OGRFeature *poFeature )
         return OGRERR_FAILURE;
     }
 
-    long nFID = poFeature->GetFID();
+    GIntBig nFID = poFeature->GetFID();
     if( nFID < 0
         || (hSHP != NULL && nFID >= hSHP->nRecords)
         || (hDBF != NULL && nFID >= hDBF->nRecords) )
     {
         CPLError( CE_Failure, CPLE_AppDefined,
-                  "Attempt to set shape with feature id (%ld) which does "
+                  "Attempt to set shape with feature id (" CPL_FRMT_GIB ") which does "
                   "not exist.", nFID );
         return OGRERR_FAILURE;
     }
@@ -835,7 +967,7 @@ OGRErr OGRShapeLayer::SetFeature( OGRFeature *poFeature )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRShapeLayer::DeleteFeature( long nFID )
+OGRErr OGRShapeLayer::DeleteFeature( GIntBig nFID )
 
 {
     if (!TouchLayer())
@@ -854,7 +986,7 @@ OGRErr OGRShapeLayer::DeleteFeature( long nFID )
         || (hDBF != NULL && nFID >= hDBF->nRecords) )
     {
         CPLError( CE_Failure, CPLE_AppDefined, 
-                  "Attempt to delete shape with feature id (%ld) which does "
+                  "Attempt to delete shape with feature id (" CPL_FRMT_GIB ") which does "
                   "not exist.", nFID );
         return OGRERR_FAILURE;
     }
@@ -868,15 +1000,15 @@ OGRErr OGRShapeLayer::DeleteFeature( long nFID )
         return OGRERR_FAILURE;
     }
 
-    if( DBFIsRecordDeleted( hDBF, nFID ) )
+    if( DBFIsRecordDeleted( hDBF, (int) nFID ) )
     {
         CPLError( CE_Failure, CPLE_AppDefined, 
-                  "Attempt to delete shape with feature id (%ld), but it is marked deleted already.",
+                  "Attempt to delete shape with feature id (" CPL_FRMT_GIB "), but it is marked deleted already.",
                   nFID );
         return OGRERR_FAILURE;
     }
 
-    if( !DBFMarkRecordDeleted( hDBF, nFID, TRUE ) )
+    if( !DBFMarkRecordDeleted( hDBF, (int) nFID, TRUE ) )
         return OGRERR_FAILURE;
 
     bHeaderDirty = TRUE;
@@ -1035,7 +1167,7 @@ int OGRShapeLayer::GetFeatureCountWithSpatialFilterOnly()
 
         if( panMatchingFIDs != NULL )
         {
-            iShape = panMatchingFIDs[iLocalMatchingFID];
+            iShape = (int) panMatchingFIDs[iLocalMatchingFID];
             if( iShape == OGRNullFID )
                 break;
             iLocalMatchingFID++;
@@ -1204,7 +1336,7 @@ int OGRShapeLayer::GetFeatureCountWithSpatialFilterOnly()
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRShapeLayer::GetFeatureCount( int bForce )
+GIntBig OGRShapeLayer::GetFeatureCount( int bForce )
 
 {
     /* Check if the spatial filter is non-trivial */
@@ -1251,7 +1383,7 @@ int OGRShapeLayer::GetFeatureCount( int bForce )
         if (!AttributeFilterEvaluationNeedsGeometry())
             poFeatureDefn->SetGeometryIgnored(TRUE);
 
-        int nRet = OGRLayer::GetFeatureCount( bForce );
+        GIntBig nRet = OGRLayer::GetFeatureCount( bForce );
 
         poFeatureDefn->SetGeometryIgnored(bSaveGeometryIgnored);
         return nRet;
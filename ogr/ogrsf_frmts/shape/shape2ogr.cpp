@@ -979,65 +979,19 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
 }
 
 /************************************************************************/
-/*                         SHPReadOGRFeature()                          */
+/*                          SHPReadOGRFields()                          */
+/*                                                                      */
+/*      Read the attributes of a record into an OGRFeature or an        */
+/*      OGRFeatureBatch.                                                */
 /************************************************************************/
 
-OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
-                               OGRFeatureDefn * poDefn, int iShape,
-                               SHPObject *psShape, const char *pszSHPEncoding )
+template<class T> static void SHPReadOGRFields( DBFHandle hDBF,
+                                                OGRFeatureDefn * poDefn,
+                                                int iShape,
+                                                const char *pszSHPEncoding,
+                                                T *poTarget )
 
 {
-    if( iShape < 0 
-        || (hSHP != NULL && iShape >= hSHP->nRecords)
-        || (hDBF != NULL && iShape >= hDBF->nRecords) )
-    {
-        CPLError( CE_Failure, CPLE_AppDefined, 
-                  "Attempt to read shape with feature id (%d) out of available"
-                  " range.", iShape );
-        return NULL;
-    }
-
-    if( hDBF && DBFIsRecordDeleted( hDBF, iShape ) )
-    {
-        CPLError( CE_Failure, CPLE_AppDefined, 
-                  "Attempt to read shape with feature id (%d), but it is marked deleted.",
-                  iShape );
-        return NULL;
-    }
-
-    OGRFeature  *poFeature = new OGRFeature( poDefn );
-
-/* -------------------------------------------------------------------- */
-/*      Fetch geometry from Shapefile to OGRFeature.                    */
-/* -------------------------------------------------------------------- */
-    if( hSHP != NULL )
-    {
-        if( !poDefn->IsGeometryIgnored() )
-        {
-            OGRGeometry* poGeometry = NULL;
-            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
-
-            /*
-            * NOTE - mloskot:
-            * Two possibilities are expected here (bot hare tested by GDAL Autotests):
-            * 1. Read valid geometry and assign it directly.
-            * 2. Read and assign null geometry if it can not be read correctly from a shapefile
-            *
-            * It's NOT required here to test poGeometry == NULL.
-            */
-
-            poFeature->SetGeometryDirectly( poGeometry );
-        }
-        else if( psShape != NULL )
-        {
-            SHPDestroyObject( psShape );
-        }
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Fetch feature attributes to OGRFeature fields.                  */
-/* -------------------------------------------------------------------- */
-
     for( int iField = 0; iField < poDefn->GetFieldCount(); iField++ )
     {
         OGRFieldDefn* poFieldDefn = poDefn->GetFieldDefn(iField);
@@ -1056,11 +1010,11 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                 {
                     char *pszUTF8Field = CPLRecode( pszFieldVal,
                                                     pszSHPEncoding, CPL_ENC_UTF8);
-                    poFeature->SetField( iField, pszUTF8Field );
+                    poTarget->SetField( iField, pszUTF8Field );
                     CPLFree( pszUTF8Field );
                 }
                 else
-                    poFeature->SetField( iField, pszFieldVal );
+                    poTarget->SetField( iField, pszFieldVal );
               }
           }
           break;
@@ -1068,14 +1022,14 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
           case OFTInteger:
 
             if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
-                poFeature->SetField( iField,
+                poTarget->SetField( iField,
                                     DBFReadIntegerAttribute( hDBF, iShape,
                                                              iField ) );
             break;
 
           case OFTReal:
             if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
-                poFeature->SetField( iField,
+                poTarget->SetField( iField,
                                     DBFReadDoubleAttribute( hDBF, iShape,
                                                             iField ) );
             break;
@@ -1112,7 +1066,7 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                   sFld.Date.Day = (GByte)(nFullDate % 100);
               }
               
-              poFeature->SetField( iField, &sFld );
+              poTarget->SetField( iField, &sFld );
           }
           break;
 
@@ -1120,6 +1074,68 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
             CPLAssert( FALSE );
         }
     }
+}
+
+/************************************************************************/
+/*                         SHPReadOGRFeature()                          */
+/************************************************************************/
+
+OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
+                               OGRFeatureDefn * poDefn, int iShape,
+                               SHPObject *psShape, const char *pszSHPEncoding )
+
+{
+    if( iShape < 0 
+        || (hSHP != NULL && iShape >= hSHP->nRecords)
+        || (hDBF != NULL && iShape >= hDBF->nRecords) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined, 
+                  "Attempt to read shape with feature id (%d) out of available"
+                  " range.", iShape );
+        return NULL;
+    }
+
+    if( hDBF && DBFIsRecordDeleted( hDBF, iShape ) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined, 
+                  "Attempt to read shape with feature id (%d), but it is marked deleted.",
+                  iShape );
+        return NULL;
+    }
+
+    OGRFeature  *poFeature = new OGRFeature( poDefn );
+
+/* -------------------------------------------------------------------- */
+/*      Fetch geometry from Shapefile to OGRFeature.                    */
+/* -------------------------------------------------------------------- */
+    if( hSHP != NULL )
+    {
+        if( !poDefn->IsGeometryIgnored() )
+        {
+            OGRGeometry* poGeometry = NULL;
+            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+
+            /*
+            * NOTE - mloskot:
+            * Two possibilities are expected here (bot hare tested by GDAL Autotests):
+            * 1. Read valid geometry and assign it directly.
+            * 2. Read and assign null geometry if it can not be read correctly from a shapefile
+            *
+            * It's NOT required here to test poGeometry == NULL.
+            */
+
+            poFeature->SetGeometryDirectly( poGeometry );
+        }
+        else if( psShape != NULL )
+        {
+            SHPDestroyObject( psShape );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Fetch feature attributes to OGRFeature fields.                  */
+/* -------------------------------------------------------------------- */
+    SHPReadOGRFields( hDBF, poDefn, iShape, pszSHPEncoding, poFeature );
 
     if( poFeature != NULL )
         poFeature->SetFID( iShape );
@@ -1127,6 +1143,21 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
     return( poFeature );
 }
 
+/************************************************************************/
+/*                     SHPReadOGRFieldsIntoBatch()                      */
+/*                                                                      */
+/*      Read the attributes of a record into the last feature of a      */
+/*      batch.                                                          */
+/************************************************************************/
+
+void SHPReadOGRFieldsIntoBatch( DBFHandle hDBF, OGRFeatureDefn * poDefn,
+                                int iShape, const char *pszSHPEncoding,
+                                OGRFeatureBatch *poBatch )
+
+{
+    SHPReadOGRFields( hDBF, poDefn, iShape, pszSHPEncoding, poBatch );
+}
+
 /************************************************************************/
 /*                             GrowField()                              */
 /************************************************************************/
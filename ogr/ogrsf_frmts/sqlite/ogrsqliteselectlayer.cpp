@@ -255,12 +255,12 @@ OGRErr OGRSQLiteSelectLayerCommonBehaviour::SetAttributeFilter( const char *pszQ
 /*                           GetNextFeature()                           */
 /************************************************************************/
 
-int OGRSQLiteSelectLayer::GetFeatureCount( int bForce )
+GIntBig OGRSQLiteSelectLayer::GetFeatureCount( int bForce )
 {
     return poBehaviour->GetFeatureCount(bForce);
 }
 
-int OGRSQLiteSelectLayerCommonBehaviour::GetFeatureCount( int bForce )
+GIntBig OGRSQLiteSelectLayerCommonBehaviour::GetFeatureCount( int bForce )
 {
     if( bEmptyLayer )
         return 0;
@@ -288,7 +288,7 @@ int OGRSQLiteSelectLayerCommonBehaviour::GetFeatureCount( int bForce )
     char *pszErrMsg = NULL;
     char **papszResult;
     int nRowCount, nColCount;
-    int nResult = -1;
+    GIntBig nResult = -1;
 
     if( sqlite3_get_table( poDS->GetDB(), osFeatureCountSQL, &papszResult, 
                            &nRowCount, &nColCount, &pszErrMsg ) != SQLITE_OK )
@@ -300,7 +300,7 @@ int OGRSQLiteSelectLayerCommonBehaviour::GetFeatureCount( int bForce )
 
     if( nRowCount == 1 && nColCount == 1 )
     {
-        nResult = atoi(papszResult[1]);
+        nResult = CPLAtoGIntBig(papszResult[1]);
     }
 
     sqlite3_free_table( papszResult );
@@ -461,7 +461,7 @@ OGRFeature *OGRSQLiteTableLayer::GetNextFeature()
 /*                             GetFeature()                             */
 /************************************************************************/
 
-OGRFeature *OGRSQLiteTableLayer::GetFeature( long nFeatureId )
+OGRFeature *OGRSQLiteTableLayer::GetFeature( GIntBig nFeatureId )
 
 {
     if (HasLayerDefnError())
@@ -484,7 +484,7 @@ OGRFeature *OGRSQLiteTableLayer::GetFeature( long nFeatureId )
 
     iNextShapeId = nFeatureId;
 
-    osSQL.Printf( "SELECT _rowid_, * FROM '%s' WHERE \"%s\" = %ld",
+    osSQL.Printf( "SELECT _rowid_, * FROM '%s' WHERE \"%s\" = " CPL_FRMT_GIB,
                   pszEscapedTableName, 
                   OGRSQLiteEscape(pszFIDColumn).c_str(), nFeatureId );
 
@@ -738,7 +738,7 @@ int OGRSQLiteTableLayer::TestCapability( const char * pszCap )
 /*                          GetFeatureCount()                           */
 /************************************************************************/
 
-int OGRSQLiteTableLayer::GetFeatureCount( int bForce )
+GIntBig OGRSQLiteTableLayer::GetFeatureCount( int bForce )
 
 {
     if (HasLayerDefnError())
@@ -783,7 +783,7 @@ int OGRSQLiteTableLayer::GetFeatureCount( int bForce )
 /* -------------------------------------------------------------------- */
     char **papszResult, *pszErrMsg;
     int nRowCount, nColCount;
-    int nResult = -1;
+    GIntBig nResult = -1;
 
     if( sqlite3_get_table( poDS->GetDB(), pszSQL, &papszResult, 
                            &nRowCount, &nColCount, &pszErrMsg ) != SQLITE_OK )
@@ -791,7 +791,7 @@ int OGRSQLiteTableLayer::GetFeatureCount( int bForce )
 
     if( nRowCount == 1 && nColCount == 1 )
     {
-        nResult = atoi(papszResult[1]);
+        nResult = CPLAtoGIntBig(papszResult[1]);
 
         if( m_poFilterGeom == NULL && osQuery.size() == 0 )
         {
@@ -1948,7 +1948,7 @@ OGRErr OGRSQLiteTableLayer::SetFeature( OGRFeature *poFeature )
 /* -------------------------------------------------------------------- */
     osCommand += " WHERE \"";
     osCommand += OGRSQLiteEscapeName(pszFIDColumn);
-    osCommand += CPLSPrintf("\" = %ld", poFeature->GetFID());
+    osCommand += CPLSPrintf("\" = " CPL_FRMT_GIB, poFeature->GetFID());
 
 /* -------------------------------------------------------------------- */
 /*      Prepare the statement.                                          */
@@ -2050,7 +2050,7 @@ OGRErr OGRSQLiteTableLayer::CreateFeature( OGRFeature *poFeature )
         osCommand += OGRSQLiteEscapeName(pszFIDColumn);
         osCommand += "\"";
 
-        osValues += CPLSPrintf( "%ld", poFeature->GetFID() );
+        osValues += CPLSPrintf( CPL_FRMT_GIB, poFeature->GetFID() );
         bNeedComma = TRUE;
     }
 
@@ -2176,7 +2176,7 @@ OGRErr OGRSQLiteTableLayer::CreateFeature( OGRFeature *poFeature )
     const sqlite_int64 nFID = sqlite3_last_insert_rowid( hDB );
     if(nFID > 0)
     {
-        poFeature->SetFID( (long)nFID ); /* Possible truncation if nFID is 64bit */
+        poFeature->SetFID( nFID );
     }
 
     sqlite3_reset( hInsertStmt );
@@ -2203,7 +2203,7 @@ OGRErr OGRSQLiteTableLayer::CreateFeature( OGRFeature *poFeature )
 /*                           DeleteFeature()                            */
 /************************************************************************/
 
-OGRErr OGRSQLiteTableLayer::DeleteFeature( long nFID )
+OGRErr OGRSQLiteTableLayer::DeleteFeature( GIntBig nFID )
 
 {
     CPLString      osSQL;
@@ -2230,7 +2230,7 @@ OGRErr OGRSQLiteTableLayer::DeleteFeature( long nFID )
 
     ResetReading();
 
-    osSQL.Printf( "DELETE FROM '%s' WHERE \"%s\" = %ld",
+    osSQL.Printf( "DELETE FROM '%s' WHERE \"%s\" = " CPL_FRMT_GIB,
                   pszEscapedTableName,
                   OGRSQLiteEscapeName(pszFIDColumn).c_str(), nFID );
 
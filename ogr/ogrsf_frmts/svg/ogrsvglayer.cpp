@@ -832,7 +832,7 @@ OGRwkbGeometryType OGRSVGLayer::GetGeomType()
 /*                           GetGeomType()                              */
 /************************************************************************/
 
-int OGRSVGLayer::GetFeatureCount( int bForce )
+GIntBig OGRSVGLayer::GetFeatureCount( int bForce )
 {
     if (m_poAttrQuery != NULL || m_poFilterGeom != NULL)
         return OGRLayer::GetFeatureCount(bForce);
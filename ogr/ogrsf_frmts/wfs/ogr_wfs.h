@@ -146,7 +146,7 @@ class OGRWFSLayer : public OGRLayer
 
     virtual void                ResetReading();
     virtual OGRFeature*         GetNextFeature();
-    virtual OGRFeature*         GetFeature(long nFID);
+    virtual OGRFeature*         GetFeature(GIntBig nFID);
 
     virtual OGRFeatureDefn *    GetLayerDefn();
 
@@ -156,14 +156,14 @@ class OGRWFSLayer : public OGRLayer
 
     virtual OGRErr      SetAttributeFilter( const char * );
 
-    virtual int         GetFeatureCount( int bForce = TRUE );
+    virtual GIntBig     GetFeatureCount( int bForce = TRUE );
 
     void                SetExtents(double dfMinX, double dfMinY, double dfMaxX, double dfMaxY);
     virtual OGRErr      GetExtent(OGREnvelope *psExtent, int bForce = TRUE);
 
     virtual OGRErr      CreateFeature( OGRFeature *poFeature );
     virtual OGRErr      SetFeature( OGRFeature *poFeature );
-    virtual OGRErr      DeleteFeature( long nFID );
+    virtual OGRErr      DeleteFeature( GIntBig nFID );
 
     virtual OGRErr      StartTransaction();
     virtual OGRErr      CommitTransaction();
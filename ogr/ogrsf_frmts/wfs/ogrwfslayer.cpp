@@ -1478,7 +1478,7 @@ int OGRWFSLayer::CanRunGetFeatureCountAndGetExtentTogether()
 /*                           GetFeatureCount()                          */
 /************************************************************************/
 
-int OGRWFSLayer::GetFeatureCount( int bForce )
+GIntBig OGRWFSLayer::GetFeatureCount( int bForce )
 {
     if (nFeatures >= 0)
         return nFeatures;
@@ -1879,7 +1879,7 @@ OGRErr OGRWFSLayer::CreateFeature( OGRFeature *poFeature )
             poFeature->SetFID(nFID);
     }
 
-    CPLDebug("WFS", "Got FID = %ld", poFeature->GetFID());
+    CPLDebug("WFS", "Got FID = " CPL_FRMT_GIB, poFeature->GetFID());
 
     CPLDestroyXMLNode( psXML );
     CPLHTTPDestroyResult(psResult);
@@ -2085,7 +2085,7 @@ OGRErr OGRWFSLayer::SetFeature( OGRFeature *poFeature )
 /*                               GetFeature()                           */
 /************************************************************************/
 
-OGRFeature* OGRWFSLayer::GetFeature(long nFID)
+OGRFeature* OGRWFSLayer::GetFeature(GIntBig nFID)
 {
     GetLayerDefn();
     if (poBaseLayer == NULL && poFeatureDefn->GetFieldIndex("gml_id") == 0)
@@ -2093,7 +2093,7 @@ OGRFeature* OGRWFSLayer::GetFeature(long nFID)
         /* This is lovely hackish. We assume that then gml_id will be */
         /* layer_name.number. This is actually what we can observe with */
         /* GeoServer and TinyOWS */
-        CPLString osVal = CPLSPrintf("gml_id = '%s.%ld'", GetShortName(), nFID);
+        CPLString osVal = CPLSPrintf("gml_id = '%s." CPL_FRMT_GIB "'", GetShortName(), nFID);
         CPLString osOldSQLWhere(osSQLWhere);
         SetAttributeFilter(osVal);
         OGRFeature* poFeature = GetNextFeature();
@@ -2222,7 +2222,7 @@ OGRErr OGRWFSLayer::DeleteFromFilter( CPLString osOGCFilter )
 /*                            DeleteFeature()                           */
 /************************************************************************/
 
-OGRErr OGRWFSLayer::DeleteFeature( long nFID )
+OGRErr OGRWFSLayer::DeleteFeature( GIntBig nFID )
 {
     if (!TestCapability(OLCDeleteFeature))
     {
@@ -2246,7 +2246,7 @@ OGRErr OGRWFSLayer::DeleteFeature( long nFID )
     if (poFeature == NULL)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
-                 "Cannot find feature %ld", nFID);
+                 "Cannot find feature " CPL_FRMT_GIB, nFID);
         return OGRERR_FAILURE;
     }
 
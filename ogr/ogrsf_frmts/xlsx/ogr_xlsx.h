@@ -75,11 +75,13 @@ class OGRXLSXLayer : public OGRMemLayer
 
     /* For external usage. Mess with FID */
     virtual OGRFeature *        GetNextFeature();
-    virtual OGRFeature         *GetFeature( long nFeatureId );
+    virtual int                 GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+    { return OGRLayer::GetNextFeatureBatch(poBatch); }
+    virtual OGRFeature         *GetFeature( GIntBig nFeatureId );
     virtual OGRErr              SetFeature( OGRFeature *poFeature );
-    virtual OGRErr              DeleteFeature( long nFID );
+    virtual OGRErr              DeleteFeature( GIntBig nFID );
 
-    virtual OGRErr      SetNextByIndex( long nIndex )
+    virtual OGRErr      SetNextByIndex( GIntBig nIndex )
     { Init(); return OGRMemLayer::SetNextByIndex(nIndex); }
 
     OGRErr              CreateFeature( OGRFeature *poFeature )
@@ -88,7 +90,7 @@ class OGRXLSXLayer : public OGRMemLayer
     OGRFeatureDefn *    GetLayerDefn()
     { Init(); return OGRMemLayer::GetLayerDefn(); }
 
-    int                 GetFeatureCount( int bForce )
+    GIntBig             GetFeatureCount( int bForce )
     { Init(); return OGRMemLayer::GetFeatureCount(bForce); }
 
     virtual OGRErr      CreateField( OGRFieldDefn *poField,
@@ -225,7 +225,7 @@ OGRFeature *OGRXPlaneLayer::GetNextFeature()
 /*                           GetFeature()                               */
 /************************************************************************/
 
-OGRFeature *  OGRXPlaneLayer::GetFeature( long nFID )
+OGRFeature *  OGRXPlaneLayer::GetFeature( GIntBig nFID )
 {
     if (poReader)
         return OGRLayer::GetFeature(nFID);
@@ -246,7 +246,7 @@ OGRFeature *  OGRXPlaneLayer::GetFeature( long nFID )
 /*                      GetFeatureCount()                               */
 /************************************************************************/
 
-int  OGRXPlaneLayer::GetFeatureCount( int bForce )
+GIntBig OGRXPlaneLayer::GetFeatureCount( int bForce )
 {
     if (poReader == NULL && m_poFilterGeom == NULL && m_poAttrQuery == NULL)
     {
@@ -262,7 +262,7 @@ int  OGRXPlaneLayer::GetFeatureCount( int bForce )
 /*                           SetNextByIndex()                           */
 /************************************************************************/
 
-OGRErr OGRXPlaneLayer::SetNextByIndex( long nIndex )
+OGRErr OGRXPlaneLayer::SetNextByIndex( GIntBig nIndex )
 {
     if (poReader == NULL && m_poFilterGeom == NULL && m_poAttrQuery == NULL)
     {
@@ -1240,3 +1240,212 @@ OGRErr OGRReadWKBGeometryType( unsigned char * pabyData, OGRwkbGeometryType *peG
     
     return OGRERR_NONE;
 }
+
+/************************************************************************/
+/*                        OGRWKBReadUInt32()                            */
+/************************************************************************/
+
+static GUInt32 OGRWKBReadUInt32( const GByte *pabyData, int bSwap )
+{
+    GUInt32 nVal;
+    memcpy( &nVal, pabyData, 4 );
+    if( bSwap )
+        CPL_SWAP32PTR( &nVal );
+    return nVal;
+}
+
+/************************************************************************/
+/*                       OGRWKBGetEnvelopeRec()                         */
+/************************************************************************/
+
+#define OGR_WKB_MAX_RECURSION 32
+
+static int OGRWKBGetEnvelopeRec( const GByte *pabyWKB, int nBytes,
+                                 int *pnConsumed, OGREnvelope *psEnvelope,
+                                 int *pbEnvelopeSet, int nRecLevel )
+{
+    if( nBytes < 5 || nRecLevel == OGR_WKB_MAX_RECURSION )
+        return FALSE;
+
+    OGRwkbByteOrder eByteOrder =
+        DB2_V72_FIX_BYTE_ORDER((OGRwkbByteOrder) *pabyWKB);
+    if( !( eByteOrder == wkbXDR || eByteOrder == wkbNDR ) )
+        return FALSE;
+    int bSwap = OGR_SWAP( eByteOrder );
+
+/* -------------------------------------------------------------------- */
+/*      Decode the geometry type, in the same way as                    */
+/*      OGRReadWKBGeometryType(), but without emitting errors.          */
+/* -------------------------------------------------------------------- */
+    GUInt32 nRawType = OGRWKBReadUInt32( pabyWKB + 1, bSwap );
+    int bIs3D = FALSE;
+
+    if( nRawType & wkb25DBit )
+    {
+        nRawType &= 0x000000FF;
+        bIs3D = TRUE;
+    }
+    if( nRawType >= 1001 && nRawType <= 1007 )
+    {
+        nRawType -= 1000;
+        bIs3D = TRUE;
+    }
+    if( nRawType & (wkb25DBit >> 16) )
+    {
+        nRawType &= 0x000000FF;
+        bIs3D = TRUE;
+    }
+
+    const int nPointSize = bIs3D ? 24 : 16;
+    const GByte *pabyCur = pabyWKB + 5;
+    int nRemaining = nBytes - 5;
+
+    if( nRawType == wkbPoint )
+    {
+        if( nRemaining < nPointSize )
+            return FALSE;
+        double dfX, dfY;
+        memcpy( &dfX, pabyCur, 8 );
+        memcpy( &dfY, pabyCur + 8, 8 );
+        if( bSwap )
+        {
+            CPL_SWAPDOUBLE( &dfX );
+            CPL_SWAPDOUBLE( &dfY );
+        }
+        /* Empty points are encoded with NaN coordinates */
+        if( !CPLIsNan(dfX) && !CPLIsNan(dfY) )
+        {
+            if( !*pbEnvelopeSet )
+            {
+                psEnvelope->MinX = psEnvelope->MaxX = dfX;
+                psEnvelope->MinY = psEnvelope->MaxY = dfY;
+                *pbEnvelopeSet = TRUE;
+            }
+            else
+            {
+                if( dfX < psEnvelope->MinX ) psEnvelope->MinX = dfX;
+                if( dfX > psEnvelope->MaxX ) psEnvelope->MaxX = dfX;
+                if( dfY < psEnvelope->MinY ) psEnvelope->MinY = dfY;
+                if( dfY > psEnvelope->MaxY ) psEnvelope->MaxY = dfY;
+            }
+        }
+        *pnConsumed = 5 + nPointSize;
+        return TRUE;
+    }
+
+    if( nRawType == wkbLineString || nRawType == wkbPolygon )
+    {
+        int nParts = 1;
+        if( nRawType == wkbPolygon )
+        {
+            if( nRemaining < 4 )
+                return FALSE;
+            nParts = (int) OGRWKBReadUInt32( pabyCur, bSwap );
+            pabyCur += 4;
+            nRemaining -= 4;
+            if( nParts < 0 || nParts > nRemaining / 4 )
+                return FALSE;
+        }
+
+        for( int iPart = 0; iPart < nParts; iPart++ )
+        {
+            if( nRemaining < 4 )
+                return FALSE;
+            int nPoints = (int) OGRWKBReadUInt32( pabyCur, bSwap );
+            pabyCur += 4;
+            nRemaining -= 4;
+            if( nPoints < 0 || nPoints > nRemaining / nPointSize )
+                return FALSE;
+
+            for( int i = 0; i < nPoints; i++ )
+            {
+                double dfX, dfY;
+                memcpy( &dfX, pabyCur, 8 );
+                memcpy( &dfY, pabyCur + 8, 8 );
+                if( bSwap )
+                {
+                    CPL_SWAPDOUBLE( &dfX );
+                    CPL_SWAPDOUBLE( &dfY );
+                }
+                if( !*pbEnvelopeSet )
+                {
+                    psEnvelope->MinX = psEnvelope->MaxX = dfX;
+                    psEnvelope->MinY = psEnvelope->MaxY = dfY;
+                    *pbEnvelopeSet = TRUE;
+                }
+                else
+                {
+                    if( dfX < psEnvelope->MinX ) psEnvelope->MinX = dfX;
+                    if( dfX > psEnvelope->MaxX ) psEnvelope->MaxX = dfX;
+                    if( dfY < psEnvelope->MinY ) psEnvelope->MinY = dfY;
+                    if( dfY > psEnvelope->MaxY ) psEnvelope->MaxY = dfY;
+                }
+                pabyCur += nPointSize;
+            }
+            nRemaining -= nPoints * nPointSize;
+        }
+
+        *pnConsumed = nBytes - nRemaining;
+        return TRUE;
+    }
+
+    if( nRawType == wkbMultiPoint || nRawType == wkbMultiLineString ||
+        nRawType == wkbMultiPolygon || nRawType == wkbGeometryCollection )
+    {
+        if( nRemaining < 4 )
+            return FALSE;
+        int nGeoms = (int) OGRWKBReadUInt32( pabyCur, bSwap );
+        pabyCur += 4;
+        nRemaining -= 4;
+        if( nGeoms < 0 || nGeoms > nRemaining / 5 )
+            return FALSE;
+
+        for( int i = 0; i < nGeoms; i++ )
+        {
+            int nSubConsumed = 0;
+            if( !OGRWKBGetEnvelopeRec( pabyCur, nRemaining, &nSubConsumed,
+                                       psEnvelope, pbEnvelopeSet,
+                                       nRecLevel + 1 ) )
+                return FALSE;
+            pabyCur += nSubConsumed;
+            nRemaining -= nSubConsumed;
+        }
+
+        *pnConsumed = nBytes - nRemaining;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/************************************************************************/
+/*                         OGRWKBGetEnvelope()                          */
+/************************************************************************/
+
+/**
+ * \brief Compute the 2D envelope of a WKB geometry without instantiating it.
+ *
+ * Both the OGC 2.5D and the ISO SQL/MM flavours of 3D geometries are
+ * accepted. Curve geometry types are not handled.
+ *
+ * @param pabyWKB the WKB blob.
+ * @param nBytes the size of the blob in bytes.
+ * @param psEnvelope the envelope to fill.
+ *
+ * @return OGRERR_NONE on success, OGRERR_FAILURE if the geometry is empty,
+ * or OGRERR_CORRUPT_DATA if the blob cannot be scanned (in which case the
+ * caller should fall back to OGRGeometryFactory::createFromWkb()).
+ */
+
+OGRErr OGRWKBGetEnvelope( const GByte *pabyWKB, int nBytes,
+                          OGREnvelope *psEnvelope )
+{
+    int nConsumed = 0;
+    int bEnvelopeSet = FALSE;
+
+    if( !OGRWKBGetEnvelopeRec( pabyWKB, nBytes, &nConsumed,
+                               psEnvelope, &bEnvelopeSet, 0 ) )
+        return OGRERR_CORRUPT_DATA;
+
+    return bEnvelopeSet ? OGRERR_NONE : OGRERR_FAILURE;
+}
@@ -281,6 +281,30 @@ int swqlex( YYSTYPE *ppNode, swq_parse_context *context )
     }
 }
 
+static int swq_compare_distinct_records( const GByte *pabyRecord1,
+                                         const GByte *pabyRecord2,
+                                         void *user_data );
+
+/************************************************************************/
+/*                      swq_add_distinct_record()                       */
+/*                                                                      */
+/*      Distinct values are passed to the external sort as a byte       */
+/*      telling if the value is NULL, followed by the value.            */
+/************************************************************************/
+
+static int swq_add_distinct_record( swq_summary *summary, const char *value )
+
+{
+    CPLString osRecord;
+
+    osRecord.assign( 1, (char) (value == NULL) );
+    if( value != NULL )
+        osRecord += value;
+
+    return summary->distinct_sorter->AddRecord( osRecord.c_str(),
+                                                osRecord.size() + 1 );
+}
+
 /************************************************************************/
 /*                        swq_select_summarize()                        */
 /************************************************************************/
@@ -335,36 +359,81 @@ swq_select_summarize( swq_select *select_info,
 /* -------------------------------------------------------------------- */
     summary = select_info->column_summary + dest_column;
     
-    if( def->distinct_flag )
+    if( def->distinct_flag && summary->distinct_sorter != NULL )
     {
-        int  i;
+        if( !swq_add_distinct_record( summary, value ) )
+            return "Failed to write the DISTINCT values in a temporary file.";
+    }
+    else if( def->distinct_flag )
+    {
+        int bFound;
+
+        if( summary->distinct_hash == NULL )
+            summary->distinct_hash = CPLHashSetNew( CPLHashSetHashStr,
+                                                    CPLHashSetEqualStr,
+                                                    NULL );
+
+        if( value == NULL )
+            bFound = summary->distinct_has_null;
+        else
+            bFound = CPLHashSetLookup( summary->distinct_hash, value ) != NULL;
 
-        /* This should be implemented with a much more complicated
-           data structure to achieve any sort of efficiency. */
-        for( i = 0; i < summary->count; i++ )
+        if( !bFound )
         {
-            if( value == NULL )
+            if( summary->count == summary->distinct_alloc )
             {
-                if (summary->distinct_list[i] == NULL)
-                    break;
+                summary->distinct_alloc = summary->distinct_alloc * 4 / 3 + 16;
+                summary->distinct_list = (char **) 
+                    CPLRealloc( summary->distinct_list,
+                                sizeof(char *) * summary->distinct_alloc );
+            }
+
+            char *new_value = (value != NULL) ? CPLStrdup( value ) : NULL;
+            summary->distinct_list[(summary->count)++] = new_value;
+
+            if( new_value == NULL )
+                summary->distinct_has_null = TRUE;
+            else
+            {
+                CPLHashSetInsert( summary->distinct_hash, new_value );
+                /* The string, its pointer in the list and its hash entry */
+                summary->distinct_memory += strlen(new_value) + 64;
             }
-            else if( summary->distinct_list[i] != NULL &&
-                     strcmp(value,summary->distinct_list[i]) == 0 )
-                break;
         }
-        
-        if( i == summary->count )
+
+/* -------------------------------------------------------------------- */
+/*      Past the memory budget, pass the values to an external sort     */
+/*      that drops the duplicates.                                      */
+/* -------------------------------------------------------------------- */
+        if( !bFound && summary->distinct_memory > swq_get_max_memory() )
         {
-            char  **old_list = summary->distinct_list;
-            
-            summary->distinct_list = (char **) 
-                CPLMalloc(sizeof(char *) * (summary->count+1));
-            memcpy( summary->distinct_list, old_list, 
-                    sizeof(char *) * summary->count );
-            summary->distinct_list[(summary->count)++] = 
-                (value != NULL) ? CPLStrdup( value ) : NULL;
-
-            CPLFree(old_list);
+            int i, bOK = TRUE;
+
+            CPLDebug( "OGR_SQL",
+                      "DISTINCT values of %s exceed the memory budget, "
+                      "using an external sort.", def->field_name );
+
+            summary->distinct_sorter =
+                new swq_external_sort( swq_compare_distinct_records, def,
+                                       swq_get_max_memory(), TRUE );
+
+            for( i = 0; i < summary->count; i++ )
+            {
+                if( bOK )
+                    bOK = swq_add_distinct_record( summary,
+                                                   summary->distinct_list[i] );
+                CPLFree( summary->distinct_list[i] );
+            }
+
+            CPLFree( summary->distinct_list );
+            summary->distinct_list = NULL;
+            summary->distinct_alloc = 0;
+            summary->count = 0;
+            CPLHashSetDestroy( summary->distinct_hash );
+            summary->distinct_hash = NULL;
+
+            if( !bOK )
+                return "Failed to write the DISTINCT values in a temporary file.";
         }
     }
 
@@ -524,6 +593,74 @@ static int FORCE_CDECL swq_compare_string( const void *item1, const void *item2
     return strcmp( pszStr1, pszStr2 );
 }
 
+/************************************************************************/
+/*                    swq_get_distinct_compare_func()                   */
+/************************************************************************/
+
+static int (FORCE_CDECL *swq_get_distinct_compare_func( swq_col_def *def ))
+                                                (const void *, const void *)
+{
+    if( def->field_type == SWQ_INTEGER )
+        return swq_compare_int;
+    else if( def->field_type == SWQ_FLOAT )
+        return swq_compare_real;
+    else
+        return swq_compare_string;
+}
+
+/************************************************************************/
+/*                    swq_compare_distinct_records()                    */
+/*                                                                      */
+/*      Order the values as the comparison function of their type,      */
+/*      and then as strings so that only identical values compare       */
+/*      equal.                                                          */
+/************************************************************************/
+
+static int swq_compare_distinct_records( const GByte *pabyRecord1,
+                                         const GByte *pabyRecord2,
+                                         void *user_data )
+{
+    const char *value1 = pabyRecord1[0] ? NULL : (const char *) pabyRecord1 + 1;
+    const char *value2 = pabyRecord2[0] ? NULL : (const char *) pabyRecord2 + 1;
+    int result;
+
+    result = swq_get_distinct_compare_func( (swq_col_def *) user_data )
+                                                        ( &value1, &value2 );
+    if( result == 0 && value1 != NULL && value2 != NULL )
+        result = strcmp( value1, value2 );
+
+    return result;
+}
+
+/************************************************************************/
+/*                   swq_select_get_distinct_value()                    */
+/*                                                                      */
+/*      Return the index-th value of the distinct list of a column,     */
+/*      which may be NULL, once the summary is finished.                */
+/************************************************************************/
+
+const char *swq_select_get_distinct_value( swq_select *select_info,
+                                           int dest_column, int index )
+
+{
+    swq_summary *summary = select_info->column_summary + dest_column;
+
+    if( index < 0 || index >= summary->count )
+        return NULL;
+
+    if( summary->distinct_sorter == NULL )
+        return summary->distinct_list[index];
+
+    if( summary->distinct_reversed )
+        index = summary->count - index - 1;
+
+    const GByte *record = summary->distinct_sorter->GetRecord( index );
+    if( record == NULL || record[0] )
+        return NULL;
+
+    return (const char *) record + 1;
+}
+
 /************************************************************************/
 /*                    swq_select_finish_summarize()                     */
 /*                                                                      */
@@ -537,6 +674,28 @@ const char *swq_select_finish_summarize( swq_select *select_info )
     int (FORCE_CDECL *compare_func)(const void *, const void*);
     int count = 0;
     char **distinct_list = NULL;
+    int i;
+
+/* -------------------------------------------------------------------- */
+/*      Merge the distinct values that were sent to an external sort.   */
+/*      They are then sorted.                                           */
+/* -------------------------------------------------------------------- */
+    for( i = 0;
+         select_info->column_summary != NULL && i < select_info->result_columns;
+         i++ )
+    {
+        swq_summary *summary = select_info->column_summary + i;
+
+        if( summary->distinct_sorter == NULL )
+            continue;
+
+        if( !summary->distinct_sorter->Finish() )
+            return "Failed to sort the DISTINCT values.";
+
+        if( summary->distinct_sorter->GetRecordCount() > INT_MAX )
+            return "Too many DISTINCT values.";
+        summary->count = (int) summary->distinct_sorter->GetRecordCount();
+    }
 
     if( select_info->query_mode != SWQM_DISTINCT_LIST 
         || select_info->order_specs == 0 )
@@ -552,12 +711,14 @@ const char *swq_select_finish_summarize( swq_select *select_info )
     if( select_info->column_summary == NULL )
         return NULL;
 
-    if( select_info->column_defs[0].field_type == SWQ_INTEGER )
-        compare_func = swq_compare_int;
-    else if( select_info->column_defs[0].field_type == SWQ_FLOAT )
-        compare_func = swq_compare_real;
-    else
-        compare_func = swq_compare_string;
+    if( select_info->column_summary[0].distinct_sorter != NULL )
+    {
+        select_info->column_summary[0].distinct_reversed =
+            !select_info->order_defs[0].ascending_flag;
+        return NULL;
+    }
+
+    compare_func = swq_get_distinct_compare_func( select_info->column_defs );
 
     distinct_list = select_info->column_summary[0].distinct_list;
     count = select_info->column_summary[0].count;
@@ -570,7 +731,6 @@ const char *swq_select_finish_summarize( swq_select *select_info )
     if( !select_info->order_defs[0].ascending_flag )
     {
         char *saved;
-        int i;
 
         for( i = 0; i < count/2; i++ )
         {
@@ -24,6 +24,8 @@
 #include "cpl_conv.h"
 #include "cpl_string.h"
 #include "ogr_core.h"
+#include "cpl_hash_set.h"
+#include <vector>
 
 #if defined(_WIN32) && !defined(_WIN32_WCE)
 #  define strcasecmp stricmp
@@ -206,7 +208,7 @@ CPLErr swq_expr_compile2( const char *where_clause,
 /*
 ** Evaluation related.
 */
-int swq_test_like( const char *input, const char *pattern );
+int swq_test_like( const char *input, const char *pattern, char chEscape );
 
 swq_expr_node *SWQGeneralEvaluator( swq_expr_node *, swq_expr_node **);
 swq_field_type SWQGeneralChecker( swq_expr_node *node );
@@ -214,6 +216,118 @@ swq_expr_node *SWQCastEvaluator( swq_expr_node *, swq_expr_node **);
 swq_field_type SWQCastChecker( swq_expr_node *node );
 const char*    SWQFieldTypeToString( swq_field_type field_type );
 
+/*
+** Compiled evaluation.
+**
+** A swq_compiled_expr is a flat program equivalent to an expression tree,
+** evaluated over a fixed set of value slots, so that evaluating it for a
+** record does not allocate anything. Column values are fetched through a
+** swq_value_fetcher, which must store a string that does not outlive the
+** call in the osStorage member of the value.
+*/
+class swq_value {
+public:
+    swq_value() : is_null(FALSE), int_value(0), float_value(0.0),
+                  string_value(NULL) {}
+
+    int         is_null;
+    int         int_value;
+    double      float_value;
+    const char *string_value;
+    CPLString   osStorage;
+};
+
+typedef void (*swq_value_fetcher)( swq_expr_node *op, void *record_handle,
+                                   swq_value *value );
+
+typedef struct {
+    int         nOpcode;
+    int         nSubOp;
+    int         iDst;
+    int         iArg0;
+    int         iArg1;
+    int         iArg2;
+} swq_instruction;
+
+class swq_compiled_expr {
+    std::vector<swq_instruction> aoInstructions;
+    std::vector<int>             anArgList;
+    std::vector<swq_value>       aoSlots;
+    std::vector<swq_expr_node*>  apoColumns;
+    int                          iResultSlot;
+
+                swq_compiled_expr();
+
+    int         NewSlot();
+    int         Emit( int nOpcode, int nSubOp, int iDst,
+                      int iArg0 = -1, int iArg1 = -1, int iArg2 = -1 );
+    int         CompileNode( swq_expr_node *poNode, int &nCategory,
+                             int &bIsConstant );
+    int         CompileOperation( swq_expr_node *poNode, int &nCategory );
+    int         ToFloat( int iSlot, int nCategory, int bIsConstant );
+
+public:
+               ~swq_compiled_expr();
+
+    static swq_compiled_expr *Compile( swq_expr_node *poExpr );
+
+    int         EvaluateBoolean( swq_value_fetcher pfnFetcher, void *record );
+};
+
+/*
+** External sort.
+**
+** Sorts variable size records with a bounded amount of memory: when the
+** records added exceed the memory budget, they are sorted and written as
+** a run in a temporary file, and the runs are merged at the end. The sort
+** is stable, and can optionally drop records comparing equal to the
+** previous one.
+*/
+typedef int (*swq_record_compare_func)( const GByte *pabyRecord1,
+                                        const GByte *pabyRecord2,
+                                        void *user_data );
+
+class swq_external_sort {
+    swq_record_compare_func pfnCompare;
+    void           *pUserData;
+    size_t          nMaxMemory;
+    int             bUnique;
+    int             bError;
+    int             bFinished;
+
+    std::vector<GByte>  abyBuffer;
+    std::vector<size_t> anOffsets;
+    std::vector<int>    anSorted;
+    std::vector<CPLString> aosRuns;
+
+    GIntBig         nRecordCount;
+    CPLString       osOutputFilename;
+    CPLString       osIndexFilename;
+    VSILFILE       *fpOutput;
+    VSILFILE       *fpIndex;
+    GIntBig         iNextRecord;
+    std::vector<GByte>  abyRecord;
+
+    void        SortBuffer();
+    int         WriteRun();
+    int         MergeRuns( int iFirstRun, int nRuns, const char *pszOutput,
+                           VSILFILE *fpIndexOut );
+
+public:
+                swq_external_sort( swq_record_compare_func pfnCompareIn,
+                                   void *pUserDataIn,
+                                   size_t nMaxMemoryIn, int bUniqueIn );
+               ~swq_external_sort();
+
+    int         AddRecord( const void *pData, size_t nSize );
+    int         Finish();
+
+    GIntBig     GetRecordCount() { return nRecordCount; }
+    const GByte *GetRecord( GIntBig iRecord, size_t *pnSize = NULL );
+};
+
+size_t swq_get_max_memory();
+
 /****************************************************************************/
 
 #define SWQP_ALLOW_UNDEFINED_COL_FUNCS 0x01
@@ -252,6 +366,13 @@ typedef struct {
     int         count;
     
     char        **distinct_list; /* items of the list can be NULL */
+    int         distinct_alloc;
+    int         distinct_has_null;
+    CPLHashSet  *distinct_hash;
+    size_t      distinct_memory;
+    /* used instead of the list when the values do not fit in memory */
+    swq_external_sort *distinct_sorter;
+    int         distinct_reversed;
     double      sum;
     double      min;
     double      max;
@@ -331,6 +452,8 @@ const char *swq_select_finish_summarize( swq_select *select_info );
 const char *swq_select_summarize( swq_select *select_info, 
                                   int dest_column, 
                                   const char *value );
+const char *swq_select_get_distinct_value( swq_select *select_info,
+                                           int dest_column, int index );
 
 int swq_is_reserved_keyword(const char* pszStr);
 
@@ -0,0 +1,669 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Component: OGR SQL Engine
+ * Purpose: Implementation of the swq_compiled_expr class, a flat program
+ *          equivalent to an expression tree that can be evaluated without
+ *          any memory allocation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "swq.h"
+
+CPL_CVSID("$Id$");
+
+/*
+** The program is a sequence of instructions, each one computing the value
+** of one node of the expression tree into its value slot from the slots of
+** its sub-expressions. Constants are stored in their slot once for all at
+** compilation time. The type of each slot (integer, float or string) is
+** known at compilation time, so that instructions are already specialized
+** for the type of their operands, and replicate the type dispatching and
+** null handling of SWQGeneralEvaluator().
+**
+** AND and OR are compiled with conditional jumps, so that the right
+** operand is not evaluated when the left one determines the result.
+**
+** Expressions using operations that would need memory allocations (string
+** concatenation, SUBSTR(), CAST(), ...) or geometries are not compiled, and
+** must be evaluated with swq_expr_node::Evaluate().
+*/
+
+typedef enum {
+    SWQI_FETCH,             /* iArg0: index in apoColumns */
+    SWQI_INT_TO_FLOAT,      /* iArg0 */
+    SWQI_CMP_INT,           /* nSubOp: comparison operator, iArg0, iArg1 */
+    SWQI_CMP_FLOAT,
+    SWQI_CMP_STRING,
+    SWQI_IN_INT,            /* iArg0, iArg1: offset in anArgList, iArg2: count */
+    SWQI_IN_FLOAT,
+    SWQI_IN_STRING,
+    SWQI_BETWEEN_INT,       /* iArg0, iArg1, iArg2 */
+    SWQI_BETWEEN_FLOAT,
+    SWQI_BETWEEN_STRING,
+    SWQI_LIKE,              /* iArg0, iArg1, iArg2: escape character or -1 */
+    SWQI_ISNULL,            /* iArg0 */
+    SWQI_NOT,               /* iArg0 */
+    SWQI_AND,               /* iArg0, iArg1 */
+    SWQI_OR,                /* iArg0, iArg1 */
+    SWQI_TO_BOOLEAN,        /* iArg0 */
+    SWQI_JUMP_IF_FALSE,     /* iArg0, iArg1: target instruction */
+    SWQI_JUMP_IF_NOT_FALSE, /* iArg0, iArg1: target instruction */
+    SWQI_ARITH_INT,         /* nSubOp: arithmetic operator, iArg0, iArg1 */
+    SWQI_ARITH_FLOAT
+} swq_opcode;
+
+/* Type of the value of a slot */
+#define SWQ_CAT_INTEGER  0
+#define SWQ_CAT_FLOAT    1
+#define SWQ_CAT_STRING   2
+
+/************************************************************************/
+/*                         swq_compiled_expr()                          */
+/************************************************************************/
+
+swq_compiled_expr::swq_compiled_expr() : iResultSlot(-1)
+
+{
+}
+
+/************************************************************************/
+/*                         ~swq_compiled_expr()                         */
+/************************************************************************/
+
+swq_compiled_expr::~swq_compiled_expr()
+
+{
+}
+
+/************************************************************************/
+/*                              NewSlot()                               */
+/************************************************************************/
+
+int swq_compiled_expr::NewSlot()
+
+{
+    aoSlots.push_back( swq_value() );
+    return (int) aoSlots.size() - 1;
+}
+
+/************************************************************************/
+/*                                Emit()                                */
+/************************************************************************/
+
+int swq_compiled_expr::Emit( int nOpcode, int nSubOp, int iDst,
+                             int iArg0, int iArg1, int iArg2 )
+
+{
+    swq_instruction sInstr;
+
+    sInstr.nOpcode = nOpcode;
+    sInstr.nSubOp = nSubOp;
+    sInstr.iDst = iDst;
+    sInstr.iArg0 = iArg0;
+    sInstr.iArg1 = iArg1;
+    sInstr.iArg2 = iArg2;
+    aoInstructions.push_back( sInstr );
+
+    return (int) aoInstructions.size() - 1;
+}
+
+/************************************************************************/
+/*                              ToFloat()                               */
+/*                                                                      */
+/*      Return a slot with the value of an integer slot as a float.     */
+/************************************************************************/
+
+int swq_compiled_expr::ToFloat( int iSlot, int nCategory, int bIsConstant )
+
+{
+    if( nCategory == SWQ_CAT_FLOAT )
+        return iSlot;
+
+    int iDst = NewSlot();
+    if( bIsConstant )
+    {
+        aoSlots[iDst].is_null = aoSlots[iSlot].is_null;
+        aoSlots[iDst].float_value = aoSlots[iSlot].int_value;
+    }
+    else
+        Emit( SWQI_INT_TO_FLOAT, 0, iDst, iSlot );
+
+    return iDst;
+}
+
+/************************************************************************/
+/*                            CompileNode()                             */
+/*                                                                      */
+/*      Emit the instructions computing the value of a node, and        */
+/*      return the slot of this value, or -1 if the node cannot be      */
+/*      compiled.                                                       */
+/************************************************************************/
+
+int swq_compiled_expr::CompileNode( swq_expr_node *poNode, int &nCategory,
+                                    int &bIsConstant )
+
+{
+    bIsConstant = FALSE;
+
+    if( poNode->eNodeType == SNT_OPERATION )
+        return CompileOperation( poNode, nCategory );
+
+    if( poNode->field_type == SWQ_INTEGER
+        || poNode->field_type == SWQ_BOOLEAN )
+        nCategory = SWQ_CAT_INTEGER;
+    else if( poNode->field_type == SWQ_FLOAT )
+        nCategory = SWQ_CAT_FLOAT;
+    else if( poNode->field_type == SWQ_GEOMETRY )
+        return -1;
+    else
+        nCategory = SWQ_CAT_STRING;
+
+    int iSlot = NewSlot();
+
+    if( poNode->eNodeType == SNT_COLUMN )
+    {
+        apoColumns.push_back( poNode );
+        Emit( SWQI_FETCH, 0, iSlot, (int) apoColumns.size() - 1 );
+    }
+    else
+    {
+        /* The string value remains owned by the expression tree */
+        swq_value &sValue = aoSlots[iSlot];
+        sValue.is_null = poNode->is_null;
+        sValue.int_value = poNode->int_value;
+        sValue.float_value = poNode->float_value;
+        sValue.string_value = poNode->string_value;
+        bIsConstant = TRUE;
+    }
+
+    return iSlot;
+}
+
+/************************************************************************/
+/*                          CompileOperation()                          */
+/************************************************************************/
+
+int swq_compiled_expr::CompileOperation( swq_expr_node *poNode,
+                                         int &nCategory )
+
+{
+    const int nArgs = poNode->nSubExprCount;
+    const swq_op eOp = (swq_op) poNode->nOperation;
+    int bIsConstant;
+    int i;
+
+    if( nArgs < 1 )
+        return -1;
+
+/* -------------------------------------------------------------------- */
+/*      AND and OR evaluate their right operand only if needed.         */
+/*      SWQGeneralEvaluator() returns FALSE as soon as one of the       */
+/*      operands is NULL, so OR can only be short-circuited when its    */
+/*      right operand cannot be NULL, that is when it is a boolean      */
+/*      expression.                                                     */
+/* -------------------------------------------------------------------- */
+    if( (eOp == SWQ_AND || eOp == SWQ_OR) && nArgs == 2 )
+    {
+        int nLeftCat, nRightCat;
+        int iDst = NewSlot();
+
+        int iLeft = CompileNode( poNode->papoSubExpr[0], nLeftCat,
+                                 bIsConstant );
+        if( iLeft < 0 || nLeftCat != SWQ_CAT_INTEGER )
+            return -1;
+
+        int bShortCircuit = (eOp == SWQ_AND ||
+            (poNode->papoSubExpr[1]->eNodeType == SNT_OPERATION &&
+             poNode->papoSubExpr[1]->field_type == SWQ_BOOLEAN));
+        int iJump = -1;
+        if( bShortCircuit )
+            iJump = Emit( eOp == SWQ_AND ? SWQI_JUMP_IF_FALSE :
+                                           SWQI_JUMP_IF_NOT_FALSE,
+                          0, iDst, iLeft );
+
+        int iRight = CompileNode( poNode->papoSubExpr[1], nRightCat,
+                                  bIsConstant );
+        if( iRight < 0 || nRightCat != SWQ_CAT_INTEGER )
+            return -1;
+
+        if( bShortCircuit )
+        {
+            Emit( SWQI_TO_BOOLEAN, 0, iDst, iRight );
+            aoInstructions[iJump].iArg1 = (int) aoInstructions.size();
+        }
+        else
+            Emit( eOp == SWQ_AND ? SWQI_AND : SWQI_OR, 0, iDst,
+                  iLeft, iRight );
+
+        nCategory = SWQ_CAT_INTEGER;
+        return iDst;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Compile the operands.                                           */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anSlots, anCategories, anIsConstant;
+
+    for( i = 0; i < nArgs; i++ )
+    {
+        int nArgCat;
+        int iSlot = CompileNode( poNode->papoSubExpr[i], nArgCat,
+                                 bIsConstant );
+        if( iSlot < 0 )
+            return -1;
+        anSlots.push_back( iSlot );
+        anCategories.push_back( nArgCat );
+        anIsConstant.push_back( bIsConstant );
+    }
+
+    int iDst = NewSlot();
+
+    if( eOp == SWQ_ISNULL )
+    {
+        Emit( SWQI_ISNULL, 0, iDst, anSlots[0] );
+        nCategory = SWQ_CAT_INTEGER;
+        return iDst;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Select the type of the operation as SWQGeneralEvaluator()       */
+/*      does, and check that all operands are of this type.             */
+/* -------------------------------------------------------------------- */
+    int nOpCat;
+    if( anCategories[0] == SWQ_CAT_FLOAT
+        || (nArgs > 1 && anCategories[1] == SWQ_CAT_FLOAT) )
+    {
+        nOpCat = SWQ_CAT_FLOAT;
+
+        /* Only the first two operands are promoted to float */
+        for( i = 0; i < nArgs; i++ )
+        {
+            if( i < 2 )
+                anSlots[i] = ToFloat( anSlots[i], anCategories[i],
+                                      anIsConstant[i] );
+            else if( anCategories[i] != SWQ_CAT_FLOAT )
+                return -1;
+        }
+    }
+    else
+    {
+        nOpCat = anCategories[0];
+        for( i = 1; i < nArgs; i++ )
+        {
+            if( anCategories[i] != nOpCat )
+                return -1;
+        }
+    }
+
+    const int bBooleanResult = (poNode->field_type == SWQ_BOOLEAN);
+
+    switch( eOp )
+    {
+      case SWQ_EQ:
+      case SWQ_NE:
+      case SWQ_GT:
+      case SWQ_LT:
+      case SWQ_GE:
+      case SWQ_LE:
+        if( nArgs != 2 || !bBooleanResult )
+            return -1;
+        Emit( nOpCat == SWQ_CAT_INTEGER ? SWQI_CMP_INT :
+              nOpCat == SWQ_CAT_FLOAT ? SWQI_CMP_FLOAT : SWQI_CMP_STRING,
+              eOp, iDst, anSlots[0], anSlots[1] );
+        break;
+
+      case SWQ_IN:
+      {
+        if( nArgs < 2 || !bBooleanResult )
+            return -1;
+        int iOffset = (int) anArgList.size();
+        for( i = 1; i < nArgs; i++ )
+            anArgList.push_back( anSlots[i] );
+        Emit( nOpCat == SWQ_CAT_INTEGER ? SWQI_IN_INT :
+              nOpCat == SWQ_CAT_FLOAT ? SWQI_IN_FLOAT : SWQI_IN_STRING,
+              0, iDst, anSlots[0], iOffset, nArgs - 1 );
+        break;
+      }
+
+      case SWQ_BETWEEN:
+        if( nArgs != 3 || !bBooleanResult )
+            return -1;
+        Emit( nOpCat == SWQ_CAT_INTEGER ? SWQI_BETWEEN_INT :
+              nOpCat == SWQ_CAT_FLOAT ? SWQI_BETWEEN_FLOAT :
+                                        SWQI_BETWEEN_STRING,
+              0, iDst, anSlots[0], anSlots[1], anSlots[2] );
+        break;
+
+      case SWQ_LIKE:
+        if( nOpCat != SWQ_CAT_STRING || nArgs < 2 || nArgs > 3 ||
+            !bBooleanResult )
+            return -1;
+        Emit( SWQI_LIKE, 0, iDst, anSlots[0], anSlots[1],
+              nArgs == 3 ? anSlots[2] : -1 );
+        break;
+
+      case SWQ_NOT:
+        if( nOpCat != SWQ_CAT_INTEGER || nArgs != 1 || !bBooleanResult )
+            return -1;
+        Emit( SWQI_NOT, 0, iDst, anSlots[0] );
+        break;
+
+      case SWQ_ADD:
+      case SWQ_SUBTRACT:
+      case SWQ_MULTIPLY:
+      case SWQ_DIVIDE:
+      case SWQ_MODULUS:
+      {
+        if( nArgs != 2 || nOpCat == SWQ_CAT_STRING )
+            return -1;
+
+        /* The modulus of floats is an integer */
+        swq_field_type eExpectedType = SWQ_INTEGER;
+        if( nOpCat == SWQ_CAT_FLOAT && eOp != SWQ_MODULUS )
+            eExpectedType = SWQ_FLOAT;
+        if( poNode->field_type != eExpectedType )
+            return -1;
+
+        Emit( nOpCat == SWQ_CAT_INTEGER ? SWQI_ARITH_INT : SWQI_ARITH_FLOAT,
+              eOp, iDst, anSlots[0], anSlots[1] );
+        nCategory = (eExpectedType == SWQ_FLOAT) ? SWQ_CAT_FLOAT :
+                                                   SWQ_CAT_INTEGER;
+        return iDst;
+      }
+
+      default:
+        return -1;
+    }
+
+    nCategory = SWQ_CAT_INTEGER;
+    return iDst;
+}
+
+/************************************************************************/
+/*                              Compile()                               */
+/*                                                                      */
+/*      Returns NULL if the expression cannot be compiled. The          */
+/*      expression must outlive the compiled program.                   */
+/************************************************************************/
+
+swq_compiled_expr *swq_compiled_expr::Compile( swq_expr_node *poExpr )
+
+{
+    if( poExpr == NULL || poExpr->eNodeType != SNT_OPERATION
+        || poExpr->field_type != SWQ_BOOLEAN )
+        return NULL;
+
+    swq_compiled_expr *poProgram = new swq_compiled_expr();
+    int nCategory, bIsConstant;
+
+    poProgram->iResultSlot = poProgram->CompileNode( poExpr, nCategory,
+                                                     bIsConstant );
+    if( poProgram->iResultSlot < 0 )
+    {
+        delete poProgram;
+        return NULL;
+    }
+
+    return poProgram;
+}
+
+/************************************************************************/
+/*                           CompareValues()                            */
+/************************************************************************/
+
+template<class T> static int CompareValues( int nOp, T a, T b )
+{
+    switch( nOp )
+    {
+      case SWQ_EQ: return a == b;
+      case SWQ_NE: return a != b;
+      case SWQ_GT: return a > b;
+      case SWQ_LT: return a < b;
+      case SWQ_GE: return a >= b;
+      default:     return a <= b;
+    }
+}
+
+/************************************************************************/
+/*                          EvaluateBoolean()                           */
+/************************************************************************/
+
+int swq_compiled_expr::EvaluateBoolean( swq_value_fetcher pfnFetcher,
+                                        void *pRecord )
+
+{
+    swq_value *pasSlots = &(aoSlots[0]);
+    const swq_instruction *pasInstr = &(aoInstructions[0]);
+    const int nInstructions = (int) aoInstructions.size();
+    int iPC = 0;
+
+    while( iPC < nInstructions )
+    {
+        const swq_instruction &sInstr = pasInstr[iPC++];
+        swq_value &sDst = pasSlots[sInstr.iDst];
+        const swq_value &sArg0 = pasSlots[sInstr.iArg0];
+
+        switch( sInstr.nOpcode )
+        {
+          case SWQI_FETCH:
+            pfnFetcher( apoColumns[sInstr.iArg0], pRecord, &sDst );
+            break;
+
+          case SWQI_INT_TO_FLOAT:
+            sDst.is_null = sArg0.is_null;
+            sDst.float_value = sArg0.int_value;
+            break;
+
+          case SWQI_CMP_INT:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            sDst.int_value = !sArg0.is_null && !sArg1.is_null &&
+                CompareValues( sInstr.nSubOp, sArg0.int_value,
+                               sArg1.int_value );
+            break;
+          }
+
+          case SWQI_CMP_FLOAT:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            sDst.int_value = !sArg0.is_null && !sArg1.is_null &&
+                CompareValues( sInstr.nSubOp, sArg0.float_value,
+                               sArg1.float_value );
+            break;
+          }
+
+          case SWQI_CMP_STRING:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            sDst.int_value = !sArg0.is_null && !sArg1.is_null &&
+                CompareValues( sInstr.nSubOp,
+                               strcasecmp( sArg0.string_value,
+                                           sArg1.string_value ), 0 );
+            break;
+          }
+
+          case SWQI_IN_INT:
+          case SWQI_IN_FLOAT:
+          case SWQI_IN_STRING:
+          {
+            const int *panArgs = &(anArgList[sInstr.iArg1]);
+            int i, bNull = sArg0.is_null, bFound = FALSE;
+
+            for( i = 0; i < sInstr.iArg2 && !bNull; i++ )
+            {
+                const swq_value &sArg = pasSlots[panArgs[i]];
+                if( sArg.is_null )
+                    bNull = TRUE;
+                else if( bFound )
+                    ;
+                else if( sInstr.nOpcode == SWQI_IN_INT )
+                    bFound = sArg0.int_value == sArg.int_value;
+                else if( sInstr.nOpcode == SWQI_IN_FLOAT )
+                    bFound = sArg0.float_value == sArg.float_value;
+                else
+                    bFound = strcasecmp( sArg0.string_value,
+                                         sArg.string_value ) == 0;
+            }
+            sDst.int_value = !bNull && bFound;
+            break;
+          }
+
+          case SWQI_BETWEEN_INT:
+          case SWQI_BETWEEN_FLOAT:
+          case SWQI_BETWEEN_STRING:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            const swq_value &sArg2 = pasSlots[sInstr.iArg2];
+            if( sArg0.is_null || sArg1.is_null || sArg2.is_null )
+                sDst.int_value = FALSE;
+            else if( sInstr.nOpcode == SWQI_BETWEEN_INT )
+                sDst.int_value = sArg0.int_value >= sArg1.int_value &&
+                                 sArg0.int_value <= sArg2.int_value;
+            else if( sInstr.nOpcode == SWQI_BETWEEN_FLOAT )
+                sDst.int_value = sArg0.float_value >= sArg1.float_value &&
+                                 sArg0.float_value <= sArg2.float_value;
+            else
+                sDst.int_value =
+                    strcasecmp( sArg0.string_value,
+                                sArg1.string_value ) >= 0 &&
+                    strcasecmp( sArg0.string_value,
+                                sArg2.string_value ) <= 0;
+            break;
+          }
+
+          case SWQI_LIKE:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            char chEscape = '\0';
+            int bNull = sArg0.is_null || sArg1.is_null;
+            if( sInstr.iArg2 >= 0 )
+            {
+                const swq_value &sArg2 = pasSlots[sInstr.iArg2];
+                if( sArg2.is_null )
+                    bNull = TRUE;
+                else
+                    chEscape = sArg2.string_value[0];
+            }
+            sDst.int_value = !bNull &&
+                swq_test_like( sArg0.string_value, sArg1.string_value,
+                               chEscape );
+            break;
+          }
+
+          case SWQI_ISNULL:
+            sDst.int_value = sArg0.is_null;
+            break;
+
+          case SWQI_NOT:
+            sDst.int_value = !sArg0.is_null && !sArg0.int_value;
+            break;
+
+          case SWQI_AND:
+          case SWQI_OR:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            if( sArg0.is_null || sArg1.is_null )
+                sDst.int_value = FALSE;
+            else if( sInstr.nOpcode == SWQI_AND )
+                sDst.int_value = sArg0.int_value && sArg1.int_value;
+            else
+                sDst.int_value = sArg0.int_value || sArg1.int_value;
+            break;
+          }
+
+          case SWQI_TO_BOOLEAN:
+            sDst.int_value = !sArg0.is_null && sArg0.int_value != 0;
+            break;
+
+          case SWQI_JUMP_IF_FALSE:
+            if( sArg0.is_null || !sArg0.int_value )
+            {
+                sDst.int_value = FALSE;
+                iPC = sInstr.iArg1;
+            }
+            break;
+
+          case SWQI_JUMP_IF_NOT_FALSE:
+            if( sArg0.is_null || sArg0.int_value )
+            {
+                sDst.int_value = !sArg0.is_null;
+                iPC = sInstr.iArg1;
+            }
+            break;
+
+          case SWQI_ARITH_INT:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            sDst.is_null = sArg0.is_null || sArg1.is_null;
+            if( sDst.is_null )
+            {
+                sDst.int_value = 0;
+                break;
+            }
+            const int a = sArg0.int_value, b = sArg1.int_value;
+            switch( sInstr.nSubOp )
+            {
+              case SWQ_ADD: sDst.int_value = a + b; break;
+              case SWQ_SUBTRACT: sDst.int_value = a - b; break;
+              case SWQ_MULTIPLY: sDst.int_value = a * b; break;
+              case SWQ_DIVIDE: sDst.int_value = b ? a / b : INT_MAX; break;
+              default: sDst.int_value = b ? a % b : INT_MAX; break;
+            }
+            break;
+          }
+
+          case SWQI_ARITH_FLOAT:
+          {
+            const swq_value &sArg1 = pasSlots[sInstr.iArg1];
+            sDst.is_null = sArg0.is_null || sArg1.is_null;
+            if( sDst.is_null )
+            {
+                sDst.int_value = 0;
+                sDst.float_value = 0;
+                break;
+            }
+            const double a = sArg0.float_value, b = sArg1.float_value;
+            switch( sInstr.nSubOp )
+            {
+              case SWQ_ADD: sDst.float_value = a + b; break;
+              case SWQ_SUBTRACT: sDst.float_value = a - b; break;
+              case SWQ_MULTIPLY: sDst.float_value = a * b; break;
+              case SWQ_DIVIDE:
+                sDst.float_value = (b == 0) ? INT_MAX : a / b;
+                break;
+              default:
+              {
+                int nRight = (int) b;
+                sDst.int_value = nRight ? ((int) a) % nRight : INT_MAX;
+                break;
+              }
+            }
+            break;
+          }
+        }
+    }
+
+    return pasSlots[iResultSlot].int_value;
+}
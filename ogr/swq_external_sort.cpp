@@ -0,0 +1,511 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Component: OGR SQL Engine
+ * Purpose: Implementation of the swq_external_sort class, used to sort
+ *          records that do not fit in memory.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "swq.h"
+#include "cpl_vsi.h"
+#include <algorithm>
+
+CPL_CVSID("$Id$");
+
+/* Maximum number of runs merged at once */
+#define MAX_MERGED_RUNS   64
+
+/* Records are stored in the buffer with their size, and aligned on 8 bytes */
+#define RECORD_ALIGN(n)   (((n) + 7) & ~((size_t)7))
+#define RECORD_HEADER     RECORD_ALIGN(sizeof(GUInt32))
+
+/************************************************************************/
+/*                        swq_get_max_memory()                          */
+/*                                                                      */
+/*      Memory budget of the operations of the SQL engine that can      */
+/*      work with temporary files, set in megabytes with the            */
+/*      OGR_SQL_MAX_MEMORY configuration option.                        */
+/************************************************************************/
+
+size_t swq_get_max_memory()
+
+{
+    double dfMaxMemory =
+        CPLAtof( CPLGetConfigOption( "OGR_SQL_MAX_MEMORY", "256" ) );
+    if( dfMaxMemory < 1 )
+        dfMaxMemory = 1;
+    if( dfMaxMemory * 1024 * 1024 > (double) (~((size_t)0) / 2) )
+        return ~((size_t)0) / 2;
+    return (size_t) (dfMaxMemory * 1024 * 1024);
+}
+
+/************************************************************************/
+/*                          swq_record_less                             */
+/*                                                                      */
+/*      Ordering of the records of the in-memory buffer.                */
+/************************************************************************/
+
+struct swq_record_less
+{
+    swq_record_compare_func pfnCompare;
+    void                   *pUserData;
+    const GByte            *pabyBuffer;
+    const size_t           *panOffsets;
+
+    bool operator()( int i, int j ) const
+    {
+        return pfnCompare( pabyBuffer + panOffsets[i] + RECORD_HEADER,
+                           pabyBuffer + panOffsets[j] + RECORD_HEADER,
+                           pUserData ) < 0;
+    }
+};
+
+/************************************************************************/
+/*                          swq_run_reader                              */
+/************************************************************************/
+
+struct swq_run_reader
+{
+    VSILFILE           *fp;
+    std::vector<GByte>  abyRecord;
+    GUInt32             nSize;
+
+    int ReadNext()
+    {
+        if( VSIFReadL( &nSize, sizeof(nSize), 1, fp ) != 1 )
+            return FALSE;
+        if( abyRecord.size() < nSize + 1 )
+            abyRecord.resize( nSize + 1 );
+        return nSize == 0 || VSIFReadL( &abyRecord[0], nSize, 1, fp ) == 1;
+    }
+};
+
+/************************************************************************/
+/*                          swq_run_greater                             */
+/*                                                                      */
+/*      Ordering of the runs in the merge heap: the run with the        */
+/*      smallest record, or the first run on ties, is at the top.       */
+/************************************************************************/
+
+struct swq_run_greater
+{
+    swq_record_compare_func pfnCompare;
+    void                   *pUserData;
+    swq_run_reader         *pasReaders;
+
+    bool operator()( int i, int j ) const
+    {
+        int nResult = pfnCompare( &(pasReaders[i].abyRecord[0]),
+                                  &(pasReaders[j].abyRecord[0]),
+                                  pUserData );
+        return nResult > 0 || (nResult == 0 && i > j);
+    }
+};
+
+/************************************************************************/
+/*                         swq_external_sort()                          */
+/************************************************************************/
+
+swq_external_sort::swq_external_sort( swq_record_compare_func pfnCompareIn,
+                                      void *pUserDataIn,
+                                      size_t nMaxMemoryIn, int bUniqueIn ) :
+    pfnCompare( pfnCompareIn ), pUserData( pUserDataIn ),
+    nMaxMemory( nMaxMemoryIn ), bUnique( bUniqueIn ),
+    bError( FALSE ), bFinished( FALSE ), nRecordCount( 0 ),
+    fpOutput( NULL ), fpIndex( NULL ), iNextRecord( 0 )
+
+{
+}
+
+/************************************************************************/
+/*                        ~swq_external_sort()                          */
+/************************************************************************/
+
+swq_external_sort::~swq_external_sort()
+
+{
+    for( size_t i = 0; i < aosRuns.size(); i++ )
+        VSIUnlink( aosRuns[i] );
+
+    if( fpOutput != NULL )
+    {
+        VSIFCloseL( fpOutput );
+        VSIUnlink( osOutputFilename );
+    }
+    if( fpIndex != NULL )
+    {
+        VSIFCloseL( fpIndex );
+        VSIUnlink( osIndexFilename );
+    }
+}
+
+/************************************************************************/
+/*                             AddRecord()                              */
+/************************************************************************/
+
+int swq_external_sort::AddRecord( const void *pData, size_t nSize )
+
+{
+    CPLAssert( !bFinished );
+
+    if( bError )
+        return FALSE;
+
+    if( nSize > 0xFFFFFFFFU - 1 )
+    {
+        CPLError( CE_Failure, CPLE_NotSupported, "Too large record" );
+        bError = TRUE;
+        return FALSE;
+    }
+
+    size_t nOffset = abyBuffer.size();
+    abyBuffer.resize( nOffset + RECORD_HEADER + RECORD_ALIGN(nSize) );
+
+    GUInt32 nRecordSize = (GUInt32) nSize;
+    memcpy( &abyBuffer[nOffset], &nRecordSize, sizeof(nRecordSize) );
+    memcpy( &abyBuffer[nOffset + RECORD_HEADER], pData, nSize );
+    anOffsets.push_back( nOffset );
+
+    if( abyBuffer.size() + anOffsets.size() * (sizeof(size_t) + sizeof(int))
+                                                                > nMaxMemory )
+        return WriteRun();
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             SortBuffer()                             */
+/*                                                                      */
+/*      Sort the records of the buffer in anSorted, dropping            */
+/*      duplicates if requested.                                        */
+/************************************************************************/
+
+void swq_external_sort::SortBuffer()
+
+{
+    anSorted.resize( anOffsets.size() );
+    for( size_t i = 0; i < anOffsets.size(); i++ )
+        anSorted[i] = (int) i;
+
+    if( anSorted.empty() )
+        return;
+
+    swq_record_less oLess;
+    oLess.pfnCompare = pfnCompare;
+    oLess.pUserData = pUserData;
+    oLess.pabyBuffer = &abyBuffer[0];
+    oLess.panOffsets = &anOffsets[0];
+
+    std::stable_sort( anSorted.begin(), anSorted.end(), oLess );
+
+    if( bUnique )
+    {
+        size_t nKept = 1;
+        for( size_t i = 1; i < anSorted.size(); i++ )
+        {
+            if( oLess( anSorted[nKept-1], anSorted[i] ) )
+                anSorted[nKept++] = anSorted[i];
+        }
+        anSorted.resize( nKept );
+    }
+}
+
+/************************************************************************/
+/*                              WriteRun()                              */
+/*                                                                      */
+/*      Sort the buffer and write it in a new temporary file.           */
+/************************************************************************/
+
+int swq_external_sort::WriteRun()
+
+{
+    SortBuffer();
+
+    CPLString osRun = CPLGenerateTempFilename( "ogr_sql_sort" );
+    VSILFILE *fp = VSIFOpenL( osRun, "wb" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s", osRun.c_str() );
+        bError = TRUE;
+        return FALSE;
+    }
+    aosRuns.push_back( osRun );
+
+    int bOK = TRUE;
+    for( size_t i = 0; bOK && i < anSorted.size(); i++ )
+    {
+        const GByte *pabyRecord = &abyBuffer[anOffsets[anSorted[i]]];
+        GUInt32 nSize;
+        memcpy( &nSize, pabyRecord, sizeof(nSize) );
+        bOK = VSIFWriteL( &nSize, sizeof(nSize), 1, fp ) == 1 &&
+              (nSize == 0 ||
+               VSIFWriteL( pabyRecord + RECORD_HEADER, nSize, 1, fp ) == 1);
+    }
+    if( VSIFCloseL( fp ) != 0 )
+        bOK = FALSE;
+
+    if( !bOK )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot write temporary file %s", osRun.c_str() );
+        bError = TRUE;
+    }
+
+    CPLDebug( "OGR_SQL", "Sorted run of %d records written in %s",
+              (int) anSorted.size(), osRun.c_str() );
+
+    /* Release the memory, and not only clear the vectors */
+    std::vector<GByte>().swap( abyBuffer );
+    std::vector<size_t>().swap( anOffsets );
+    std::vector<int>().swap( anSorted );
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                             MergeRuns()                              */
+/*                                                                      */
+/*      Merge nRuns runs from iFirstRun in a new file, and write the    */
+/*      offsets of the records in fpIndexOut if it is not NULL.         */
+/************************************************************************/
+
+int swq_external_sort::MergeRuns( int iFirstRun, int nRuns,
+                                  const char *pszOutput,
+                                  VSILFILE *fpIndexOut )
+
+{
+    std::vector<swq_run_reader> asReaders( nRuns );
+    std::vector<int> anHeap;
+    int bOK = TRUE;
+    int i;
+
+    for( i = 0; i < nRuns; i++ )
+    {
+        asReaders[i].fp = VSIFOpenL( aosRuns[iFirstRun + i], "rb" );
+        if( asReaders[i].fp == NULL )
+            bOK = FALSE;
+        else if( asReaders[i].ReadNext() )
+            anHeap.push_back( i );
+    }
+
+    VSILFILE *fpOut = VSIFOpenL( pszOutput, "wb" );
+    if( fpOut == NULL )
+        bOK = FALSE;
+
+    swq_run_greater oGreater;
+    oGreater.pfnCompare = pfnCompare;
+    oGreater.pUserData = pUserData;
+    oGreater.pasReaders = nRuns ? &asReaders[0] : NULL;
+    std::make_heap( anHeap.begin(), anHeap.end(), oGreater );
+
+    std::vector<GByte> abyLast;
+    int bHasLast = FALSE;
+    GUIntBig nOffset = 0;
+
+    nRecordCount = 0;
+    while( bOK && !anHeap.empty() )
+    {
+        std::pop_heap( anHeap.begin(), anHeap.end(), oGreater );
+        swq_run_reader &sReader = asReaders[anHeap.back()];
+
+        if( !bUnique || !bHasLast ||
+            pfnCompare( &abyLast[0], &sReader.abyRecord[0], pUserData ) != 0 )
+        {
+            GUInt32 nSize = sReader.nSize;
+            bOK = VSIFWriteL( &nSize, sizeof(nSize), 1, fpOut ) == 1 &&
+                  (nSize == 0 ||
+                   VSIFWriteL( &sReader.abyRecord[0], nSize, 1, fpOut ) == 1);
+            if( fpIndexOut != NULL )
+                bOK &= VSIFWriteL( &nOffset, sizeof(nOffset), 1,
+                                   fpIndexOut ) == 1;
+            nOffset += sizeof(nSize) + nSize;
+            nRecordCount ++;
+
+            if( bUnique )
+            {
+                abyLast = sReader.abyRecord;
+                bHasLast = TRUE;
+            }
+        }
+
+        if( sReader.ReadNext() )
+            std::push_heap( anHeap.begin(), anHeap.end(), oGreater );
+        else
+            anHeap.pop_back();
+    }
+
+    for( i = 0; i < nRuns; i++ )
+    {
+        if( asReaders[i].fp != NULL )
+            VSIFCloseL( asReaders[i].fp );
+    }
+    if( fpOut != NULL && VSIFCloseL( fpOut ) != 0 )
+        bOK = FALSE;
+
+    if( !bOK )
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Error while merging sorted runs in %s", pszOutput );
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                               Finish()                               */
+/*                                                                      */
+/*      Sort the records added. If they all fit in memory, they are     */
+/*      sorted in place, otherwise the runs are merged, in several      */
+/*      passes if needed, in a final file.                              */
+/************************************************************************/
+
+int swq_external_sort::Finish()
+
+{
+    if( bFinished )
+        return !bError;
+    bFinished = TRUE;
+
+    if( bError )
+        return FALSE;
+
+    if( aosRuns.empty() )
+    {
+        SortBuffer();
+        nRecordCount = (GIntBig) anSorted.size();
+        return TRUE;
+    }
+
+    if( !anOffsets.empty() && !WriteRun() )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Merge groups of consecutive runs, so that the order of          */
+/*      records comparing equal is kept, until few enough remain.       */
+/* -------------------------------------------------------------------- */
+    while( aosRuns.size() > MAX_MERGED_RUNS )
+    {
+        std::vector<CPLString> aosMerged;
+
+        for( int iRun = 0; iRun < (int) aosRuns.size();
+             iRun += MAX_MERGED_RUNS )
+        {
+            int nRuns = MIN( MAX_MERGED_RUNS, (int) aosRuns.size() - iRun );
+            CPLString osMerged = CPLGenerateTempFilename( "ogr_sql_sort" );
+
+            aosMerged.push_back( osMerged );
+            if( !MergeRuns( iRun, nRuns, osMerged, NULL ) )
+                bError = TRUE;
+
+            for( int i = 0; i < nRuns; i++ )
+                VSIUnlink( aosRuns[iRun + i] );
+        }
+
+        aosRuns = aosMerged;
+        if( bError )
+            return FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Final merge, with the index of the records.                     */
+/* -------------------------------------------------------------------- */
+    osOutputFilename = CPLGenerateTempFilename( "ogr_sql_sort" );
+    osIndexFilename = CPLGenerateTempFilename( "ogr_sql_sort" );
+
+    fpIndex = VSIFOpenL( osIndexFilename, "wb+" );
+    if( fpIndex == NULL ||
+        !MergeRuns( 0, (int) aosRuns.size(), osOutputFilename, fpIndex ) )
+    {
+        bError = TRUE;
+        return FALSE;
+    }
+
+    for( size_t i = 0; i < aosRuns.size(); i++ )
+        VSIUnlink( aosRuns[i] );
+    aosRuns.clear();
+
+    fpOutput = VSIFOpenL( osOutputFilename, "rb" );
+    if( fpOutput == NULL )
+    {
+        bError = TRUE;
+        return FALSE;
+    }
+
+    CPLDebug( "OGR_SQL", "External sort of " CPL_FRMT_GIB " records done",
+              nRecordCount );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             GetRecord()                              */
+/*                                                                      */
+/*      Return the iRecord-th sorted record, or NULL. The pointer       */
+/*      is valid until the next call. Reading the records in            */
+/*      sequence is faster than random access when the records did      */
+/*      not fit in memory.                                              */
+/************************************************************************/
+
+const GByte *swq_external_sort::GetRecord( GIntBig iRecord, size_t *pnSize )
+
+{
+    if( !bFinished || bError || iRecord < 0 || iRecord >= nRecordCount )
+        return NULL;
+
+    if( fpOutput == NULL )
+    {
+        const GByte *pabyRecord = &abyBuffer[anOffsets[anSorted[iRecord]]];
+        if( pnSize != NULL )
+        {
+            GUInt32 nSize;
+            memcpy( &nSize, pabyRecord, sizeof(nSize) );
+            *pnSize = nSize;
+        }
+        return pabyRecord + RECORD_HEADER;
+    }
+
+    if( iRecord != iNextRecord )
+    {
+        GUIntBig nOffset;
+        if( VSIFSeekL( fpIndex, iRecord * sizeof(nOffset), SEEK_SET ) != 0 ||
+            VSIFReadL( &nOffset, sizeof(nOffset), 1, fpIndex ) != 1 ||
+            VSIFSeekL( fpOutput, nOffset, SEEK_SET ) != 0 )
+            return NULL;
+    }
+
+    GUInt32 nSize;
+    if( VSIFReadL( &nSize, sizeof(nSize), 1, fpOutput ) != 1 )
+        return NULL;
+
+    /* One extra byte so that the pointer is valid for empty records */
+    if( abyRecord.size() < nSize + 1 )
+        abyRecord.resize( nSize + 1 );
+    if( nSize > 0 && VSIFReadL( &abyRecord[0], nSize, 1, fpOutput ) != 1 )
+        return NULL;
+
+    iNextRecord = iRecord + 1;
+    if( pnSize != NULL )
+        *pnSize = nSize;
+    return &abyRecord[0];
+}
@@ -99,6 +99,13 @@ swq_select::~swq_select()
 
             CPLFree( column_summary[i].distinct_list );
         }
+
+        if( column_summary != NULL )
+        {
+            if( column_summary[i].distinct_hash != NULL )
+                CPLHashSetDestroy( column_summary[i].distinct_hash );
+            delete column_summary[i].distinct_sorter;
+        }
     }
 
     CPLFree( column_defs );
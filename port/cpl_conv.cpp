@@ -927,6 +927,29 @@ GUIntBig CPLScanUIntBig( const char *pszString, int nMaxLength )
     return iValue;
 }
 
+/************************************************************************/
+/*                           CPLAtoGIntBig()                            */
+/************************************************************************/
+
+/**
+ * Convert a string to a 64 bit signed integer.
+ *
+ * @param pszString String containing 64 bit signed integer.
+ * @return 64 bit signed integer.
+ * @since GDAL 2.0
+ */
+
+GIntBig CPLAtoGIntBig( const char* pszString )
+{
+#if defined(__MSVCRT__) || (defined(WIN32) && defined(_MSC_VER))
+    return _atoi64( pszString );
+# elif HAVE_ATOLL
+    return atoll( pszString );
+#else
+    return atol( pszString );
+#endif
+}
+
 /************************************************************************/
 /*                           CPLScanPointer()                           */
 /************************************************************************/
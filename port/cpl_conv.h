@@ -102,6 +102,7 @@ double CPL_DLL CPLScanDouble( const char *, int );
 long CPL_DLL CPLScanLong( const char *, int );
 unsigned long CPL_DLL CPLScanULong( const char *, int );
 GUIntBig CPL_DLL CPLScanUIntBig( const char *, int );
+GIntBig CPL_DLL CPLAtoGIntBig( const char* pszString );
 void CPL_DLL *CPLScanPointer( const char *, int );
 
 /* -------------------------------------------------------------------- */
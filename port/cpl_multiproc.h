@@ -128,14 +128,16 @@ class CPL_DLL CPLMutexHolder
 #define CTLS_ERRORCONTEXT               5         /* cpl_error.cpp */
 #define CTLS_GDALDATASET_REC_PROTECT_MAP 6        /* gdaldataset.cpp */
 #define CTLS_PATHBUF                    7         /* cpl_path.cpp */
-#define CTLS_UNUSED3                    8
-#define CTLS_UNUSED4                    9
+#define CTLS_WORKERTHREADINDEX          8         /* cpl_worker_thread_pool.cpp */
+#define CTLS_PROJCONTEXTHOLDER          9         /* ogrct.cpp */
 #define CTLS_CPLSPRINTF                10         /* cpl_string.h */
 #define CTLS_RESPONSIBLEPID            11         /* gdaldataset.cpp */
 #define CTLS_VERSIONINFO               12         /* gdal_misc.cpp */
 #define CTLS_VERSIONINFO_LICENCE       13         /* gdal_misc.cpp */
 #define CTLS_CONFIGOPTIONS             14         /* cpl_conv.cpp */
 #define CTLS_FINDFILE                  15         /* cpl_findfile.cpp */
+#define CTLS_PROXYPOOL_DISABLEREFCOUNT 16         /* gdalproxypool.cpp */
+#define CTLS_GDALDATASET_DLMUTEX_DEPTH 17         /* gdaldataset.cpp */
 
 #define CTLS_MAX                       32         
 
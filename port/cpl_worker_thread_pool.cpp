@@ -0,0 +1,566 @@
+/**********************************************************************
+ * $Id$
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  CPL worker thread pool
+ * Author:   agent, <agent at local>
+ *
+ **********************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_worker_thread_pool.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_atomic_ops.h"
+#include <deque>
+
+CPL_CVSID("$Id$");
+
+#define MAX_WORKER_THREADS 128
+
+struct _CPLJobGroup
+{
+    void               *hMutex;
+    void               *hCond;
+    int                 nPendingJobs; /* protected by hMutex */
+};
+
+typedef struct
+{
+    CPLThreadFunc       pfnFunc;
+    void               *pData;
+    CPLJobGroup        *psGroup;
+} CPLWorkerJob;
+
+typedef struct
+{
+    void                     *hThread;
+    void                     *hMutex;  /* protects aoJobs */
+    std::deque<CPLWorkerJob>  aoJobs;
+} CPLWorkerQueue;
+
+static void *hPoolMutex = NULL;
+static volatile int bPoolInitialized = FALSE;
+static int nQueues = 0;
+static int nWorkers = 0;
+static CPLWorkerQueue *pasQueues = NULL;
+static volatile int nNextQueue = 0;
+
+/* Idle workers sleep on hSleepCond until nQueuedJobs becomes positive */
+static void *hSleepMutex = NULL;
+static void *hSleepCond = NULL;
+static volatile int nQueuedJobs = 0;
+static volatile int bStopPool = FALSE;
+
+/************************************************************************/
+/*                        CPLGetWorkerQueueIndex()                      */
+/*                                                                      */
+/*      Index of the queue of the current thread, or -1 if it is not    */
+/*      a worker thread.                                                */
+/************************************************************************/
+
+static int CPLGetWorkerQueueIndex()
+
+{
+    return ((int) (size_t) CPLGetTLS( CTLS_WORKERTHREADINDEX )) - 1;
+}
+
+/************************************************************************/
+/*                            CPLFetchJob()                             */
+/*                                                                      */
+/*      Take a job, starting with the queue iQueue (most recent job     */
+/*      first), and then stealing the oldest job of the other queues.   */
+/*      If psGroup is not NULL, only jobs of this group are taken.      */
+/************************************************************************/
+
+static int CPLFetchJob( int iQueue, CPLJobGroup *psGroup, CPLWorkerJob *psJob )
+
+{
+    int iStart = (iQueue >= 0) ? iQueue : 0;
+    int bFound = FALSE;
+
+    for( int i = 0; i < nQueues && !bFound; i++ )
+    {
+        CPLWorkerQueue *psQueue = pasQueues + (iStart + i) % nQueues;
+        CPLMutexHolderOptionalLockD( psQueue->hMutex );
+
+        if( psQueue->aoJobs.empty() )
+            continue;
+
+        if( i == 0 && iQueue >= 0 )
+        {
+            for( size_t j = psQueue->aoJobs.size(); j > 0; j-- )
+            {
+                if( psGroup == NULL || psQueue->aoJobs[j-1].psGroup == psGroup )
+                {
+                    *psJob = psQueue->aoJobs[j-1];
+                    psQueue->aoJobs.erase( psQueue->aoJobs.begin() + (j-1) );
+                    bFound = TRUE;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for( size_t j = 0; j < psQueue->aoJobs.size(); j++ )
+            {
+                if( psGroup == NULL || psQueue->aoJobs[j].psGroup == psGroup )
+                {
+                    *psJob = psQueue->aoJobs[j];
+                    psQueue->aoJobs.erase( psQueue->aoJobs.begin() + j );
+                    bFound = TRUE;
+                    break;
+                }
+            }
+        }
+    }
+
+    if( bFound )
+    {
+        CPLAcquireMutex( hSleepMutex, 1000.0 );
+        nQueuedJobs --;
+        CPLReleaseMutex( hSleepMutex );
+    }
+
+    return bFound;
+}
+
+/************************************************************************/
+/*                             CPLRunJob()                              */
+/************************************************************************/
+
+static void CPLRunJob( CPLWorkerJob *psJob )
+
+{
+    psJob->pfnFunc( psJob->pData );
+
+    /* The group may be destroyed as soon as its mutex is released */
+    CPLJobGroup *psGroup = psJob->psGroup;
+    CPLAcquireMutex( psGroup->hMutex, 1000.0 );
+    psGroup->nPendingJobs --;
+    if( psGroup->nPendingJobs == 0 )
+        CPLCondBroadcast( psGroup->hCond );
+    CPLReleaseMutex( psGroup->hMutex );
+}
+
+/************************************************************************/
+/*                        CPLWorkerThreadMain()                         */
+/************************************************************************/
+
+static void CPLWorkerThreadMain( void *pData )
+
+{
+    int iQueue = (int) (size_t) pData;
+
+    CPLSetTLS( CTLS_WORKERTHREADINDEX, (void*) (size_t) (iQueue + 1), FALSE );
+
+    while( TRUE )
+    {
+        CPLWorkerJob sJob;
+
+        if( CPLFetchJob( iQueue, NULL, &sJob ) )
+        {
+            CPLRunJob( &sJob );
+            continue;
+        }
+
+        CPLAcquireMutex( hSleepMutex, 1000.0 );
+        while( nQueuedJobs <= 0 && !bStopPool )
+            CPLCondWait( hSleepCond, hSleepMutex );
+        int bStop = (bStopPool && nQueuedJobs <= 0);
+        CPLReleaseMutex( hSleepMutex );
+
+        if( bStop )
+            break;
+    }
+}
+
+/************************************************************************/
+/*                      CPLInitWorkerThreadPool()                       */
+/************************************************************************/
+
+static int CPLInitWorkerThreadPool()
+
+{
+    if( bPoolInitialized )
+        return nWorkers > 0;
+
+    CPLMutexHolderD( &hPoolMutex );
+
+    if( bPoolInitialized )
+        return nWorkers > 0;
+
+    int nThreads = CPLGetNumCPUs();
+    const char* pszPoolSize = CPLGetConfigOption("GDAL_THREAD_POOL_SIZE", NULL);
+    if( pszPoolSize != NULL )
+        nThreads = atoi(pszPoolSize);
+    if( nThreads > MAX_WORKER_THREADS )
+        nThreads = MAX_WORKER_THREADS;
+
+    if( nThreads > 0 )
+    {
+        hSleepCond = CPLCreateCond();
+        if( hSleepCond == NULL )
+            nThreads = 0;
+    }
+
+    if( nThreads > 0 )
+    {
+        hSleepMutex = CPLCreateMutex();
+        CPLReleaseMutex( hSleepMutex );
+
+        bStopPool = FALSE;
+        nQueuedJobs = 0;
+        nQueues = nThreads;
+        pasQueues = new CPLWorkerQueue[nQueues];
+        for( int i = 0; i < nQueues; i++ )
+        {
+            pasQueues[i].hThread = NULL;
+            pasQueues[i].hMutex = CPLCreateMutex();
+            CPLReleaseMutex( pasQueues[i].hMutex );
+        }
+
+        /* Jobs queued for a thread that failed to start are stolen */
+        /* by the others */
+        for( int i = 0; i < nQueues; i++ )
+        {
+            pasQueues[i].hThread = CPLCreateJoinableThread(
+                CPLWorkerThreadMain, (void*) (size_t) i );
+            if( pasQueues[i].hThread == NULL )
+                break;
+            nWorkers ++;
+        }
+
+        CPLDebug( "CPL", "Worker thread pool started with %d threads",
+                  nWorkers );
+    }
+
+    bPoolInitialized = TRUE;
+
+    return nWorkers > 0;
+}
+
+/************************************************************************/
+/*                        CPLCreateJobGroup()                           */
+/************************************************************************/
+
+/**
+ * \brief Create a job group.
+ *
+ * Jobs are submitted to the worker thread pool within a job group with
+ * CPLSubmitJob(), and CPLWaitJobGroup() waits for the completion of all
+ * the jobs of the group.
+ *
+ * @return a new job group, to be destroyed with CPLDestroyJobGroup().
+ *
+ * @since GDAL 2.0
+ */
+
+CPLJobGroup *CPLCreateJobGroup()
+
+{
+    CPLJobGroup *psGroup = (CPLJobGroup *) CPLCalloc( 1, sizeof(CPLJobGroup) );
+
+    psGroup->hMutex = CPLCreateMutex();
+    if( psGroup->hMutex != NULL )
+        CPLReleaseMutex( psGroup->hMutex );
+    psGroup->hCond = CPLCreateCond();
+    psGroup->nPendingJobs = 0;
+
+    return psGroup;
+}
+
+/************************************************************************/
+/*                           CPLSubmitJob()                             */
+/************************************************************************/
+
+/**
+ * \brief Submit a job to the worker thread pool.
+ *
+ * The job will call pfnFunc(pData) in one of the worker threads, or in
+ * the thread calling CPLWaitJobGroup() if it has not been started before.
+ * If no worker thread is available, the job is run immediately in the
+ * calling thread.
+ *
+ * @param psGroup the group of the job.
+ * @param pfnFunc the function to run.
+ * @param pData the argument of the function.
+ *
+ * @return TRUE if the job was queued, FALSE if it was run synchronously.
+ *
+ * @since GDAL 2.0
+ */
+
+int CPLSubmitJob( CPLJobGroup *psGroup, CPLThreadFunc pfnFunc, void *pData )
+
+{
+    if( psGroup->hCond == NULL || !CPLInitWorkerThreadPool() )
+    {
+        pfnFunc( pData );
+        return FALSE;
+    }
+
+    CPLWorkerJob sJob;
+    sJob.pfnFunc = pfnFunc;
+    sJob.pData = pData;
+    sJob.psGroup = psGroup;
+
+    CPLAcquireMutex( psGroup->hMutex, 1000.0 );
+    psGroup->nPendingJobs ++;
+    CPLReleaseMutex( psGroup->hMutex );
+
+/* -------------------------------------------------------------------- */
+/*      Worker threads queue in their own queue, other threads          */
+/*      dispatch their jobs in a round robin way.                       */
+/* -------------------------------------------------------------------- */
+    int iQueue = CPLGetWorkerQueueIndex();
+    if( iQueue < 0 )
+        iQueue = (int) (((unsigned int) CPLAtomicInc( &nNextQueue ))
+                        % (unsigned int) nQueues);
+
+    {
+        CPLMutexHolderOptionalLockD( pasQueues[iQueue].hMutex );
+        pasQueues[iQueue].aoJobs.push_back( sJob );
+    }
+
+    CPLAcquireMutex( hSleepMutex, 1000.0 );
+    nQueuedJobs ++;
+    CPLCondSignal( hSleepCond );
+    CPLReleaseMutex( hSleepMutex );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          CPLWaitJobGroup()                           */
+/************************************************************************/
+
+/**
+ * \brief Wait for the completion of all the jobs of a group.
+ *
+ * The calling thread runs itself the jobs of the group that have not been
+ * started yet by a worker thread, before waiting for the running ones.
+ * It is thus safe to wait for a job group from a job.
+ *
+ * @param psGroup the job group.
+ *
+ * @since GDAL 2.0
+ */
+
+void CPLWaitJobGroup( CPLJobGroup *psGroup )
+
+{
+    if( !bPoolInitialized || nWorkers == 0 )
+        return;
+
+    CPLWorkerJob sJob;
+    int iQueue = CPLGetWorkerQueueIndex();
+
+    while( CPLFetchJob( iQueue, psGroup, &sJob ) )
+        CPLRunJob( &sJob );
+
+    CPLAcquireMutex( psGroup->hMutex, 1000.0 );
+    while( psGroup->nPendingJobs > 0 )
+        CPLCondWait( psGroup->hCond, psGroup->hMutex );
+    CPLReleaseMutex( psGroup->hMutex );
+}
+
+/************************************************************************/
+/*                         CPLDestroyJobGroup()                         */
+/************************************************************************/
+
+/**
+ * \brief Destroy a job group.
+ *
+ * Pending jobs of the group are waited for before the group is destroyed.
+ *
+ * @param psGroup the job group.
+ *
+ * @since GDAL 2.0
+ */
+
+void CPLDestroyJobGroup( CPLJobGroup *psGroup )
+
+{
+    if( psGroup == NULL )
+        return;
+
+    CPLWaitJobGroup( psGroup );
+
+    if( psGroup->hCond != NULL )
+        CPLDestroyCond( psGroup->hCond );
+    if( psGroup->hMutex != NULL )
+        CPLDestroyMutex( psGroup->hMutex );
+    CPLFree( psGroup );
+}
+
+/************************************************************************/
+/*                      CPLGetWorkerThreadCount()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the number of threads of the worker thread pool.
+ *
+ * The pool is started if it was not already.
+ *
+ * @return the number of worker threads, 0 if they cannot be used.
+ *
+ * @since GDAL 2.0
+ */
+
+int CPLGetWorkerThreadCount()
+
+{
+    CPLInitWorkerThreadPool();
+
+    return nWorkers;
+}
+
+/************************************************************************/
+/*                         CPLIsWorkerThread()                          */
+/************************************************************************/
+
+/**
+ * \brief Return whether the current thread is a worker thread of the pool.
+ *
+ * @since GDAL 2.0
+ */
+
+int CPLIsWorkerThread()
+
+{
+    return CPLGetWorkerQueueIndex() >= 0;
+}
+
+/************************************************************************/
+/*                         CPLParseNumThreads()                         */
+/************************************************************************/
+
+/**
+ * \brief Parse a number of threads.
+ *
+ * The value is either a number of threads, or ALL_CPUS for the number of
+ * CPUs. The result is capped to 128 threads.
+ *
+ * @param pszValue the value to parse, or NULL.
+ *
+ * @return the number of threads, 1 if pszValue is NULL. The result is not
+ * validated otherwise, and is 0 or negative for invalid values.
+ *
+ * @since GDAL 2.0
+ */
+
+int CPLParseNumThreads( const char *pszValue )
+
+{
+    if( pszValue == NULL )
+        return 1;
+
+    int nThreads;
+    if( EQUAL(pszValue, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszValue);
+    if( nThreads > MAX_WORKER_THREADS )
+        nThreads = MAX_WORKER_THREADS;
+    return nThreads;
+}
+
+/************************************************************************/
+/*                       CPLGetNumThreadsOption()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the number of threads requested by an option list.
+ *
+ * The NUM_THREADS option of the list is used if it is set, and the
+ * GDAL_NUM_THREADS configuration option otherwise. Both are parsed with
+ * CPLParseNumThreads().
+ *
+ * @param papszOptions the creation or open options, or NULL to only use
+ * the GDAL_NUM_THREADS configuration option.
+ *
+ * @return the number of threads, 1 if none is requested.
+ *
+ * @since GDAL 2.0
+ */
+
+int CPLGetNumThreadsOption( char **papszOptions )
+
+{
+    const char* pszValue = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
+    if( pszValue == NULL )
+        pszValue = CPLGetConfigOption( "GDAL_NUM_THREADS", NULL );
+    return CPLParseNumThreads( pszValue );
+}
+
+/************************************************************************/
+/*                     CPLCleanupWorkerThreadPool()                     */
+/************************************************************************/
+
+/**
+ * \brief Stop the worker threads.
+ *
+ * Should only be called at process termination, when no job is running
+ * any more. The pool will be restarted if jobs are submitted afterwards.
+ *
+ * @since GDAL 2.0
+ */
+
+void CPLCleanupWorkerThreadPool()
+
+{
+    if( !bPoolInitialized )
+        return;
+
+    if( nQueues > 0 )
+    {
+        CPLAcquireMutex( hSleepMutex, 1000.0 );
+        bStopPool = TRUE;
+        CPLCondBroadcast( hSleepCond );
+        CPLReleaseMutex( hSleepMutex );
+
+        for( int i = 0; i < nQueues; i++ )
+        {
+            if( pasQueues[i].hThread != NULL )
+                CPLJoinThread( pasQueues[i].hThread );
+            CPLDestroyMutex( pasQueues[i].hMutex );
+        }
+        delete[] pasQueues;
+        pasQueues = NULL;
+
+        CPLDestroyMutex( hSleepMutex );
+        hSleepMutex = NULL;
+    }
+
+    if( hSleepCond != NULL )
+        CPLDestroyCond( hSleepCond );
+    hSleepCond = NULL;
+
+    nQueues = 0;
+    nWorkers = 0;
+    bPoolInitialized = FALSE;
+
+    if( hPoolMutex != NULL )
+        CPLDestroyMutex( hPoolMutex );
+    hPoolMutex = NULL;
+}
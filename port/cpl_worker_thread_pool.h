@@ -0,0 +1,71 @@
+/**********************************************************************
+ * $Id$
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  CPL worker thread pool
+ * Author:   agent, <agent at local>
+ *
+ **********************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _CPL_WORKER_THREAD_POOL_H_INCLUDED_
+#define _CPL_WORKER_THREAD_POOL_H_INCLUDED_
+
+#include "cpl_multiproc.h"
+
+/**
+ * \file cpl_worker_thread_pool.h
+ *
+ * Process wide pool of worker threads.
+ *
+ * Jobs are submitted within a job group, whose completion can then be
+ * waited for. Each worker thread has its own job queue : jobs submitted
+ * from a worker thread go to its own queue, and idle workers steal jobs
+ * from the queues of the other workers. A thread waiting for a job group
+ * runs the jobs of that group that have not been started yet, so job groups
+ * can be nested.
+ *
+ * The number of worker threads is the number of CPUs, unless the
+ * GDAL_THREAD_POOL_SIZE configuration option is set. It bounds the total
+ * number of jobs running concurrently in the process.
+ */
+
+CPL_C_START
+
+typedef struct _CPLJobGroup CPLJobGroup;
+
+CPLJobGroup CPL_DLL *CPLCreateJobGroup( void );
+int          CPL_DLL CPLSubmitJob( CPLJobGroup *psGroup,
+                                   CPLThreadFunc pfnFunc, void *pData );
+void         CPL_DLL CPLWaitJobGroup( CPLJobGroup *psGroup );
+void         CPL_DLL CPLDestroyJobGroup( CPLJobGroup *psGroup );
+
+int          CPL_DLL CPLGetWorkerThreadCount( void );
+int          CPL_DLL CPLIsWorkerThread( void );
+void         CPL_DLL CPLCleanupWorkerThreadPool( void );
+
+int          CPL_DLL CPLParseNumThreads( const char *pszValue );
+int          CPL_DLL CPLGetNumThreadsOption( char **papszOptions );
+
+CPL_C_END
+
+#endif /* _CPL_WORKER_THREAD_POOL_H_INCLUDED_ */